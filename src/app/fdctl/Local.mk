@@ -8,6 +8,8 @@ $(call add-objs,main1 config caps utility topology keys ready mem spy help run/r
 $(call make-bin-rust,fdctl,main,fd_fdctl fd_disco fd_flamenco fd_quic fd_tls fd_ip fd_reedsol fd_ballet fd_tango fd_util solana_validator)
 $(call make-unit-test,test_tiles_verify,run/tiles/test_verify,fd_ballet fd_tango fd_util)
 $(call run-unit-test,test_tiles_verify)
+$(call make-unit-test,test_tiles_dedup,run/tiles/test_dedup,fd_tango fd_util)
+$(call run-unit-test,test_tiles_dedup)
 $(OBJDIR)/obj/app/fdctl/configure/xdp.o: src/tango/xdp/fd_xdp_redirect_prog.o
 $(OBJDIR)/obj/app/fdctl/config.o: src/app/fdctl/config/default.toml
 
@@ -2,6 +2,7 @@
 #include "fdctl.h"
 
 #include "run/run.h"
+#include "run/tiles/fd_verify.h"
 
 #include "../../util/net/fd_eth.h"
 #include "../../util/net/fd_ip4.h"
@@ -226,8 +227,10 @@ static int parse_key_value( config_t *   config,
 
   ENTRY_UINT  ( ., tiles.verify,        receive_buffer_size                                       );
   ENTRY_UINT  ( ., tiles.verify,        mtu                                                       );
+  ENTRY_UINT  ( ., tiles.verify,        batch_max_latency_micros                                  );
 
   ENTRY_UINT  ( ., tiles.dedup,         signature_cache_size                                      );
+  ENTRY_BOOL  ( ., tiles.dedup,         zero_copy                                                 );
 
   ENTRY_UINT  ( ., tiles.pack,          max_pending_transactions                                  );
 
@@ -522,7 +525,8 @@ topo_initialize( config_t * config ) {
                                                   .wksp_id = fd_topo_find_wksp( topo, wksp ), \
                                                   .depth   = depth1,                          \
                                                   .mtu     = mtu1,                            \
-                                                  .burst   = burst1 };                        \
+                                                  .burst   = burst1,                          \
+                                                  .fwd_wksp_id = ULONG_MAX };                 \
       link_cnt++;                                                                             \
     }                                                                                         \
   } while(0)
@@ -532,8 +536,11 @@ topo_initialize( config_t * config ) {
   LINK( config->layout.verify_tile_count, FD_TOPO_LINK_KIND_QUIC_TO_NETMUX,  FD_TOPO_WKSP_KIND_NETMUX_INOUT, config->tiles.net.send_buffer_size,       FD_NET_MTU,             1UL );
   LINK( 1,                                FD_TOPO_LINK_KIND_SHRED_TO_NETMUX, FD_TOPO_WKSP_KIND_NETMUX_INOUT, config->tiles.net.send_buffer_size,       FD_NET_MTU,             1UL );
   LINK( config->layout.verify_tile_count, FD_TOPO_LINK_KIND_QUIC_TO_VERIFY,  FD_TOPO_WKSP_KIND_QUIC_VERIFY,  config->tiles.verify.receive_buffer_size, 0UL,                    config->tiles.quic.txn_reassembly_count );
-  LINK( config->layout.verify_tile_count, FD_TOPO_LINK_KIND_VERIFY_TO_DEDUP, FD_TOPO_WKSP_KIND_VERIFY_DEDUP, config->tiles.verify.receive_buffer_size, FD_TPU_DCACHE_MTU,      1UL );
-  LINK( 1,                                FD_TOPO_LINK_KIND_DEDUP_TO_PACK,   FD_TOPO_WKSP_KIND_DEDUP_PACK,   config->tiles.verify.receive_buffer_size, FD_TPU_DCACHE_MTU,      1UL );
+  /* Verify tiles hold up to a batch of unpublished frags in their out dcache */
+  LINK( config->layout.verify_tile_count, FD_TOPO_LINK_KIND_VERIFY_TO_DEDUP, FD_TOPO_WKSP_KIND_VERIFY_DEDUP, config->tiles.verify.receive_buffer_size, FD_TPU_DCACHE_MTU,      VERIFY_BATCH_TXN_MAX );
+  /* With tiles.dedup.zero_copy, dedup republishes the frags in the verify dcaches as is, so the link to pack has no dcache of its own */
+  LINK( 1,                                FD_TOPO_LINK_KIND_DEDUP_TO_PACK,   FD_TOPO_WKSP_KIND_DEDUP_PACK,   config->tiles.verify.receive_buffer_size, config->tiles.dedup.zero_copy ? 0UL : FD_TPU_DCACHE_MTU, 1UL );
+  if( FD_UNLIKELY( config->tiles.dedup.zero_copy ) ) topo->links[ link_cnt-1UL ].fwd_wksp_id = fd_topo_find_wksp( topo, FD_TOPO_WKSP_KIND_VERIFY_DEDUP );
   /* FD_TOPO_LINK_KIND_GOSSIP_TO_PACK could be FD_TPU_MTU for now, since txns are not parsed, but better to just share one size for all the ins of pack */
   LINK( 1,                                FD_TOPO_LINK_KIND_GOSSIP_TO_PACK,  FD_TOPO_WKSP_KIND_DEDUP_PACK,   config->tiles.verify.receive_buffer_size, FD_TPU_DCACHE_MTU,      1UL );
   LINK( 1,                                FD_TOPO_LINK_KIND_STAKE_TO_OUT,    FD_TOPO_WKSP_KIND_STAKE_OUT,    128UL,                                    32UL + 40200UL * 40UL,  1UL );
@@ -1017,9 +1024,11 @@ config_parse( int *      pargc,
         strncpy( tile->quic.identity_key_path, config->consensus.identity_path, sizeof(tile->quic.identity_key_path) );
         break;
       case FD_TOPO_TILE_KIND_VERIFY:
+        tile->verify.batch_max_latency_micros = config->tiles.verify.batch_max_latency_micros;
         break;
       case FD_TOPO_TILE_KIND_DEDUP:
         tile->dedup.tcache_depth = config->tiles.dedup.signature_cache_size;
+        tile->dedup.zero_copy    = config->tiles.dedup.zero_copy;
         break;
       case FD_TOPO_TILE_KIND_PACK:
         tile->pack.max_pending_transactions = config->tiles.pack.max_pending_transactions;
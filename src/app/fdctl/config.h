@@ -178,10 +178,12 @@ typedef struct {
     struct {
       uint receive_buffer_size;
       uint mtu;
+      uint batch_max_latency_micros;
     } verify;
 
     struct {
       uint signature_cache_size;
+      int  zero_copy;
     } dedup;
 
     struct {
@@ -169,9 +169,12 @@ tile_main( void * _args ) {
   long lazy = 0L;
   if( FD_UNLIKELY( config->lazy ) ) lazy = config->lazy( scratch_mem );
 
+  ulong mux_flags = config->mux_flags;
+  if( FD_UNLIKELY( config->mux_flags_override ) ) mux_flags = config->mux_flags_override( tile );
+
   fd_rng_t rng[1];
   fd_mux_tile( tile->cnc,
-               config->mux_flags,
+               mux_flags,
                polled_in_cnt,
                in_mcache,
                in_fseq,
@@ -5,6 +5,10 @@
 #include "../../../../disco/bank/fd_bank_abi.h"
 #include "../../../../disco/metrics/generated/fd_metrics_bank.h"
 
+/* TransactionError::InsufficientFundsForFee, see the TransactionError
+   enum in metrics.xml. */
+#define FD_BANK_TXN_ERR_INSUFFICIENT_FUNDS_FOR_FEE (5)
+
 typedef struct {
   ulong kind_id;
 
@@ -19,6 +23,8 @@ typedef struct {
 
   ulong * bank_busy;
 
+  fd_pack_fee_cache_t * fee_cache;
+
   fd_wksp_t * pack_in_mem;
   ulong       pack_in_chunk0;
   ulong       pack_in_wmark;
@@ -35,7 +41,7 @@ typedef struct {
   struct {
     ulong slot_acquire[ 3 ];
 
-    ulong txn_load_address_lookup_tables[ 6 ];
+    ulong txn_load_address_lookup_tables[ 7 ];
     ulong txn_load[ 38 ];
     ulong txn_executing[ 38 ];
     ulong txn_executed[ 38 ];
@@ -197,7 +203,7 @@ after_frag( void *             _ctx,
     void * abi_txn = ctx->txn_abi_mem + (sanitized_txn_cnt*FD_BANK_ABI_TXN_FOOTPRINT);
     void * abi_txn_sidecar = ctx->txn_sidecar_mem + sidecar_footprint_bytes;
 
-    int result = fd_bank_abi_txn_init( abi_txn, abi_txn_sidecar, ctx->leader_bank, ctx->blake3, txn->payload, txn->payload_sz, TXN(txn), !!(txn->flags & FD_TXN_P_FLAGS_IS_SIMPLE_VOTE) );
+    int result = fd_bank_abi_txn_init( abi_txn, abi_txn_sidecar, ctx->leader_bank, ctx->blake3, txn->payload, txn->payload_sz, TXN(txn), !!(txn->flags & FD_TXN_P_FLAGS_IS_SIMPLE_VOTE), txn->alt_hash );
     ctx->metrics.txn_load_address_lookup_tables[ result ]++;
     if( FD_UNLIKELY( result!=FD_BANK_ABI_TXN_INIT_SUCCESS ) ) continue;
 
@@ -231,6 +237,18 @@ after_frag( void *             _ctx,
 
     sanitized_idx++;
     ctx->metrics.txn_load[ load_results[ sanitized_idx-1 ] ]++;
+
+    /* Tell pack about fee payers that can't afford their transactions,
+       and forget about the ones seen paying a fee, since they might
+       have been funded in the meantime.  The fee pack estimated is the
+       best we have here. */
+    fd_acct_addr_t const * payer = fd_txn_get_acct_addrs( TXN(txn), txn->payload );
+    if( FD_UNLIKELY( load_results[ sanitized_idx-1 ]==FD_BANK_TXN_ERR_INSUFFICIENT_FUNDS_FOR_FEE ) ) {
+      fd_pack_fee_cache_update( ctx->fee_cache, payer, fd_ulong_if( txn->fee>0U, (ulong)txn->fee-1UL, 0UL ), ctx->leader_bank_slot );
+    } else if( FD_LIKELY( !load_results[ sanitized_idx-1 ] ) ) {
+      if( FD_UNLIKELY( fd_pack_fee_cache_query( ctx->fee_cache, payer )!=ULONG_MAX ) ) fd_pack_fee_cache_remove( ctx->fee_cache, payer );
+    }
+
     if( FD_UNLIKELY( load_results[ sanitized_idx-1 ] ) ) continue;
 
     ctx->metrics.txn_executing[ executing_results[ sanitized_idx-1 ] ]++;
@@ -303,6 +321,8 @@ unprivileged_init( fd_topo_t *      topo,
   ctx->blake3 = NONNULL( fd_blake3_join( fd_blake3_new( blake3 ) ) );
   ctx->bank_busy = tile->extra[ 0 ];
   if( FD_UNLIKELY( !ctx->bank_busy ) ) FD_LOG_ERR(( "banking tile %lu has no busy flag", tile->kind_id ));
+  ctx->fee_cache = tile->extra[ 1 ];
+  if( FD_UNLIKELY( !ctx->fee_cache ) ) FD_LOG_ERR(( "banking tile %lu has no fee payer cache", tile->kind_id ));
 
   memset( &ctx->metrics, 0, sizeof( ctx->metrics ) );
 
@@ -2,6 +2,7 @@
 
 #include "generated/dedup_seccomp.h"
 #include <linux/unistd.h>
+#include <sys/random.h>
 
 /* fd_dedup provides services to deduplicate multiple streams of input
    fragments and present them to a mix of reliable and unreliable
@@ -10,7 +11,20 @@
 
    The dedup tile is simply a wrapper around the mux tile, that also
    checks the transaction signature field for duplicates and filters
-   them out. */
+   them out.
+
+   Transactions are deduplicated on the first 32 bytes (the R part) of
+   their first signature, which are compared in full by a fd_sigcache_t.
+   Only whoever holds the nonce behind R can produce a valid signature
+   with it, so unrelated transactions never collide, and the history
+   can be made deep enough to cover a blockhash lifetime (see
+   tiles.dedup.signature_cache_size).
+
+   With tiles.dedup.zero_copy, unique transactions are not copied but
+   republished as is, pointing into the verify dcaches, which pack then
+   maps read-only.  The mux then runs without FD_MUX_FLAG_COPY, so it
+   holds back flow control credits of the verify tiles until pack is
+   done with the frags (and accounts for the filtered duplicates). */
 
 /* fd_dedup_in_ctx_t is a context object for each in (producer) mcache
    connected to the dedup tile. */
@@ -25,11 +39,10 @@ typedef struct {
    mux tile, and contains all state needed to progress the tile. */
 
 typedef struct {
-  ulong   tcache_depth;   /* == fd_tcache_depth( tcache ), depth of this dedups's tcache (const) */
-  ulong   tcache_map_cnt; /* == fd_tcache_map_cnt( tcache ), number of slots to use for tcache map (const) */
-  ulong * tcache_sync;    /* == fd_tcache_oldest_laddr( tcache ), local join to the oldest key in the tcache */
-  ulong * tcache_ring;
-  ulong * tcache_map;
+  ulong           sigcache_seed; /* Random seed of the sigcache, from privileged_init */
+  fd_sigcache_t * sigcache;      /* History of the signatures seen by this dedup */
+
+  int zero_copy; /* Republish incoming frags instead of copying them to the out dcache */
 
   fd_dedup_in_ctx_t in[ 32 ];
 
@@ -41,7 +54,7 @@ typedef struct {
 
 FD_FN_CONST static inline ulong
 scratch_align( void ) {
-  return alignof( fd_dedup_ctx_t );
+  return fd_ulong_max( alignof( fd_dedup_ctx_t ), FD_SIGCACHE_ALIGN );
 }
 
 FD_FN_PURE static inline ulong
@@ -49,7 +62,7 @@ scratch_footprint( fd_topo_tile_t * tile ) {
   (void)tile;
   ulong l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND( l, alignof( fd_dedup_ctx_t ), sizeof( fd_dedup_ctx_t ) );
-  l = FD_LAYOUT_APPEND( l, fd_tcache_align(), fd_tcache_footprint( tile->dedup.tcache_depth, 0 ) );
+  l = FD_LAYOUT_APPEND( l, fd_sigcache_align(), fd_sigcache_footprint( tile->dedup.tcache_depth, 0UL ) );
   return FD_LAYOUT_FINI( l, scratch_align() );
 }
 
@@ -64,7 +77,9 @@ mux_ctx( void * scratch ) {
    downstream consumers could reuse the same chunk and workspace to
    improve performance.
 
-   The bounds checking and copying here are defensive measures,
+   The bounds checking and copying here are defensive measures (the
+   copy is skipped if tiles.dedup.zero_copy is enabled, trading the
+   second point below for memory bandwidth),
 
     * In a functioning system, the bounds checking should never fail,
       but we want to prevent an attacker with code execution on a producer
@@ -94,6 +109,8 @@ during_frag( void * _ctx,
   if( FD_UNLIKELY( chunk<ctx->in[ in_idx ].chunk0 || chunk>ctx->in[ in_idx ].wmark || sz > FD_TPU_DCACHE_MTU ) )
     FD_LOG_ERR(( "chunk %lu %lu corrupt, not in range [%lu,%lu]", chunk, sz, ctx->in[ in_idx ].chunk0, ctx->in[ in_idx ].wmark ));
 
+  if( ctx->zero_copy ) return;
+
   uchar * src = (uchar *)fd_chunk_to_laddr( ctx->in[in_idx].mem, chunk );
   uchar * dst = (uchar *)fd_chunk_to_laddr( ctx->out_mem, ctx->out_chunk );
 
@@ -114,37 +131,62 @@ after_frag( void *             _ctx,
             ulong *            opt_tsorig,
             int   *            opt_filter,
             fd_mux_context_t * mux ) {
-  (void)in_idx;
   (void)seq;
   (void)opt_tsorig;
   (void)mux;
 
   fd_dedup_ctx_t * ctx = (fd_dedup_ctx_t *)_ctx;
 
-  int is_dup;
-  FD_TCACHE_INSERT( is_dup, *ctx->tcache_sync, ctx->tcache_ring, ctx->tcache_depth, ctx->tcache_map, ctx->tcache_map_cnt, *opt_sig );
-  *opt_filter = is_dup;
+  /* The frag was produced by a verify tile, but validate the txn
+     layout anyway, see during_frag. */
+
+  if( FD_UNLIKELY( *opt_sz<sizeof(ushort) ) ) FD_LOG_ERR(( "invalid opt_sz(%lx)", *opt_sz ));
+
+  uchar const * udp_payload = ctx->zero_copy ? (uchar const *)fd_chunk_to_laddr_const( ctx->in[ in_idx ].mem, *opt_chunk )
+                                             : (uchar const *)fd_chunk_to_laddr_const( ctx->out_mem, ctx->out_chunk );
+  ushort        payload_sz  = FD_LOAD( ushort, udp_payload + *opt_sz - sizeof(ushort) );
+  if( FD_UNLIKELY( payload_sz>FD_TPU_DCACHE_MTU ) ) FD_LOG_ERR(( "invalid payload_sz(%x)", payload_sz ));
+
+  fd_txn_t const * txn = (fd_txn_t const *)fd_ulong_align_up( (ulong)udp_payload + payload_sz, 2UL );
+  ulong signature_off = txn->signature_off;
+  if( FD_UNLIKELY( signature_off+FD_TXN_SIGNATURE_SZ>payload_sz ) )
+    FD_LOG_ERR(( "txn is invalid: payload_sz = %x, signature_off = %lx", payload_sz, signature_off ));
+
+  *opt_filter = fd_sigcache_insert( ctx->sigcache, udp_payload + signature_off );
   if( FD_LIKELY( !*opt_filter ) ) {
+    *opt_sig = 0; /* indicate this txn is coming from dedup, and has already been parsed */
+    if( ctx->zero_copy ) return; /* republish the incoming chunk */
+
     *opt_chunk     = ctx->out_chunk;
-    *opt_sig       = 0; /* indicate this txn is coming from dedup, and has already been parsed */
     ctx->out_chunk = fd_dcache_compact_next( ctx->out_chunk, *opt_sz, ctx->out_chunk0, ctx->out_wmark );
   }
 }
 
+static void
+privileged_init( fd_topo_t *      topo,
+                 fd_topo_tile_t * tile,
+                 void *           scratch ) {
+  (void)topo;
+  (void)tile;
+
+  FD_SCRATCH_ALLOC_INIT( l, scratch );
+  fd_dedup_ctx_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_dedup_ctx_t ), sizeof( fd_dedup_ctx_t ) );
+
+  /* Signatures are chosen by whoever sends us transactions, so the
+     sigcache needs a seed they cannot guess. */
+  if( FD_UNLIKELY( sizeof(ulong)!=getrandom( &ctx->sigcache_seed, sizeof(ulong), 0 ) ) )
+    FD_LOG_ERR(( "getrandom failed" ));
+}
+
 static void
 unprivileged_init( fd_topo_t *      topo,
                    fd_topo_tile_t * tile,
                    void *           scratch ) {
   FD_SCRATCH_ALLOC_INIT( l, scratch );
   fd_dedup_ctx_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_dedup_ctx_t ), sizeof( fd_dedup_ctx_t ) );
-  fd_tcache_t * tcache = fd_tcache_join( fd_tcache_new( FD_SCRATCH_ALLOC_APPEND( l, FD_TCACHE_ALIGN, FD_TCACHE_FOOTPRINT( tile->dedup.tcache_depth, 0) ), tile->dedup.tcache_depth, 0 ) );
-  if( FD_UNLIKELY( !tcache ) ) FD_LOG_ERR(( "fd_tcache_new failed" ));
-
-  ctx->tcache_depth   = fd_tcache_depth       ( tcache );
-  ctx->tcache_map_cnt = fd_tcache_map_cnt     ( tcache );
-  ctx->tcache_sync    = fd_tcache_oldest_laddr( tcache );
-  ctx->tcache_ring    = fd_tcache_ring_laddr  ( tcache );
-  ctx->tcache_map     = fd_tcache_map_laddr   ( tcache );
+  void * _sigcache = FD_SCRATCH_ALLOC_APPEND( l, fd_sigcache_align(), fd_sigcache_footprint( tile->dedup.tcache_depth, 0UL ) );
+  ctx->sigcache = fd_sigcache_join( fd_sigcache_new( _sigcache, tile->dedup.tcache_depth, 0UL, ctx->sigcache_seed ) );
+  if( FD_UNLIKELY( !ctx->sigcache ) ) FD_LOG_ERR(( "fd_sigcache_new failed" ));
 
   for( ulong i=0; i<tile->in_cnt; i++ ) {
     fd_topo_link_t * link = &topo->links[ tile->in_link_id[ i ] ];
@@ -155,10 +197,21 @@ unprivileged_init( fd_topo_t *      topo,
     ctx->in[i].wmark  = fd_dcache_compact_wmark ( ctx->in[i].mem, link->dcache, link->mtu );
   }
 
-  ctx->out_mem    = topo->workspaces[ topo->links[ tile->out_link_id_primary ].wksp_id ].wksp;
-  ctx->out_chunk0 = fd_dcache_compact_chunk0( ctx->out_mem, topo->links[ tile->out_link_id_primary ].dcache );
-  ctx->out_wmark  = fd_dcache_compact_wmark ( ctx->out_mem, topo->links[ tile->out_link_id_primary ].dcache, topo->links[ tile->out_link_id_primary ].mtu );
-  ctx->out_chunk  = ctx->out_chunk0;
+  ctx->zero_copy = tile->dedup.zero_copy;
+  if( FD_LIKELY( !ctx->zero_copy ) ) {
+    ctx->out_mem    = topo->workspaces[ topo->links[ tile->out_link_id_primary ].wksp_id ].wksp;
+    ctx->out_chunk0 = fd_dcache_compact_chunk0( ctx->out_mem, topo->links[ tile->out_link_id_primary ].dcache );
+    ctx->out_wmark  = fd_dcache_compact_wmark ( ctx->out_mem, topo->links[ tile->out_link_id_primary ].dcache, topo->links[ tile->out_link_id_primary ].mtu );
+    ctx->out_chunk  = ctx->out_chunk0;
+  } else {
+    /* The out link has no dcache and downstream consumers resolve
+       chunks against the workspace of the ins, see config.c */
+    ulong fwd_wksp_id = topo->links[ tile->out_link_id_primary ].fwd_wksp_id;
+    for( ulong i=0; i<tile->in_cnt; i++ ) {
+      if( FD_UNLIKELY( topo->links[ tile->in_link_id[ i ] ].wksp_id!=fwd_wksp_id ) )
+        FD_LOG_ERR(( "zero copy out link does not forward from in link %lu", i ));
+    }
+  }
 
   ulong scratch_top = FD_SCRATCH_ALLOC_FINI( l, 1UL );
   if( FD_UNLIKELY( scratch_top > (ulong)scratch + scratch_footprint( tile ) ) )
@@ -188,8 +241,17 @@ populate_allowed_fds( void * scratch,
   return out_cnt;
 }
 
+/* In zero copy mode, the mux needs to track filtered frags for flow
+   control, see fd_mux.h. */
+
+static ulong
+mux_flags_override( fd_topo_tile_t * tile ) {
+  return tile->dedup.zero_copy ? FD_MUX_FLAG_DEFAULT : FD_MUX_FLAG_COPY;
+}
+
 fd_tile_config_t fd_tile_dedup = {
   .mux_flags                = FD_MUX_FLAG_COPY,
+  .mux_flags_override       = mux_flags_override,
   .burst                    = 1UL,
   .mux_ctx                  = mux_ctx,
   .mux_during_frag          = during_frag,
@@ -198,6 +260,6 @@ fd_tile_config_t fd_tile_dedup = {
   .populate_allowed_fds     = populate_allowed_fds,
   .scratch_align            = scratch_align,
   .scratch_footprint        = scratch_footprint,
-  .privileged_init          = NULL,
+  .privileged_init          = privileged_init,
   .unprivileged_init        = unprivileged_init,
 };
@@ -20,9 +20,11 @@ typedef struct {
   ulong round_robin_id;
 
   const fd_aio_t * tx;
-  const fd_aio_t * lo_tx;
 
-  uchar frame[ FD_NET_MTU ];
+  /* frame points to the UMEM TX frame reserved on frame_xsk_aio for
+     the fragment currently being processed. */
+  fd_xsk_aio_t * frame_xsk_aio;
+  uchar *        frame;
 
   fd_mux_context_t * mux;
 
@@ -225,16 +227,26 @@ during_frag( void * _ctx,
              int * opt_filter ) {
   (void)in_idx;
   (void)seq;
-  (void)sig;
-  (void)opt_filter;
 
   fd_net_ctx_t * ctx = (fd_net_ctx_t *)_ctx;
 
   if( FD_UNLIKELY( chunk<ctx->in_chunk0 || chunk>ctx->in_wmark || sz > FD_NET_MTU ) )
     FD_LOG_ERR(( "chunk %lu %lu corrupt, not in range [%lu,%lu]", chunk, sz, ctx->in_chunk0, ctx->in_wmark ));
 
-  uchar * src = (uchar *)fd_chunk_to_laddr( ctx->in_mem, chunk );
-  fd_memcpy( ctx->frame, src, sz ); // TODO: Change xsk_aio interface to eliminate this copy
+  /* Copy the packet straight into a UMEM TX frame of the XSK it will
+     leave on.  The frame is only handed to the kernel in after_frag, so
+     if we get overrun here or the packet cannot be routed, it is simply
+     reused for the next packet. */
+  ctx->frame_xsk_aio = ctx->xsk_aio[ route_loopback( ctx->src_ip_addr, sig ) ? 1 : 0 ];
+  ctx->frame         = fd_xsk_aio_tx_reserve( ctx->frame_xsk_aio );
+  if( FD_UNLIKELY( !ctx->frame ) ) {
+    /* All TX frames in flight, drop the packet */
+    *opt_filter = 1;
+    return;
+  }
+
+  uchar const * src = (uchar const *)fd_chunk_to_laddr_const( ctx->in_mem, chunk );
+  fd_memcpy( ctx->frame, src, sz );
 }
 
 static void
@@ -280,9 +292,8 @@ after_frag( void *             _ctx,
 
   fd_net_ctx_t * ctx = (fd_net_ctx_t *)_ctx;
 
-  fd_aio_pkt_info_t aio_buf = { .buf = ctx->frame, .buf_sz = (ushort)*opt_sz };
   if( FD_UNLIKELY( route_loopback( ctx->src_ip_addr, *opt_sig ) ) ) {
-    ctx->lo_tx->send_func( ctx->xsk_aio[ 1 ], &aio_buf, 1, NULL, 1 );
+    fd_xsk_aio_tx_commit( ctx->frame_xsk_aio, *opt_sz, 1 );
   } else {
     /* extract dst ip */
     uint dst_ip = fd_uint_bswap( fd_disco_netmux_sig_ip_addr( *opt_sig ) );
@@ -316,7 +327,8 @@ after_frag( void *             _ctx,
       case FD_IP_PROBE_RQD:
         /* TODO possibly buffer some data while waiting for ARPs to complete */
         /* TODO rate limit ARPs */
-        /* TODO add caching of ip_dst -> routing info */
+        /* Note that the probe may reuse the reserved frame, dropping the
+           packet */
         send_arp_probe( ctx, next_hop, if_idx );
 
         /* refresh tables */
@@ -333,7 +345,7 @@ after_frag( void *             _ctx,
         /* set source mac address */
         memcpy( ctx->frame + 6UL, ctx->src_mac_addr, 6UL );
 
-        ctx->tx->send_func( ctx->xsk_aio[ 0 ], &aio_buf, 1, NULL, 1 );
+        fd_xsk_aio_tx_commit( ctx->frame_xsk_aio, *opt_sz, 1 );
         break;
       case FD_IP_RETRY:
         /* refresh tables */
@@ -428,7 +440,6 @@ unprivileged_init( fd_topo_t *      topo,
     ctx->xsk_aio[ 1 ] = fd_xsk_aio_join( init_ctx->lo_xsk_aio, init_ctx->lo_xsk );
     if( FD_UNLIKELY( !ctx->xsk_aio[ 1 ] ) ) FD_LOG_ERR(( "fd_xsk_aio_join failed" ));
     fd_xsk_aio_set_rx( ctx->xsk_aio[ 1 ], net_rx_aio );
-    ctx->lo_tx = fd_xsk_aio_get_tx( init_ctx->lo_xsk_aio );
     ctx->xsk_aio_cnt = 2;
   }
 
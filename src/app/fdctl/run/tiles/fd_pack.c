@@ -30,6 +30,12 @@
 /* About 1.5 kB on the stack */
 #define FD_PACK_PACK_MAX_OUT (16UL)
 
+/* Nothing provides pack with a snapshot of address lookup table
+   contents yet, so transactions that use lookup tables are held but
+   never scheduled.  Don't reserve the 4 kB per pending transaction that
+   pack needs to resolve them until fd_pack_set_alt is called here. */
+#define PACK_ENABLE_ALT (0)
+
 /* Each block is limited to 32k parity shreds.  At worst, the shred tile
    generates 40 parity shreds per microblock (see #1 below).  We need to
    adjust the parity shred count to account for the empty tick
@@ -93,6 +99,10 @@ typedef struct {
   fd_pack_t *  pack;
   fd_txn_p_t * cur_spot;
 
+  /* The table of recent blockhashes written by PoH, which pack uses to
+     expire transactions. */
+  fd_pack_blockhash_tbl_t const * blockhash_tbl;
+
   fd_pubkey_t identity_pubkey __attribute__((aligned(32UL)));
 
   /* The leader slot we are currently packing for, or ULONG_MAX if we
@@ -139,7 +149,8 @@ scratch_footprint( fd_topo_tile_t * tile ) {
   l = FD_LAYOUT_APPEND( l, fd_rng_align(),           fd_rng_footprint() );
   l = FD_LAYOUT_APPEND( l, fd_pack_align(), fd_pack_footprint( tile->pack.max_pending_transactions,
                                                      tile->pack.bank_tile_count,
-                                                     MAX_TXN_PER_MICROBLOCK ) );
+                                                     MAX_TXN_PER_MICROBLOCK,
+                                                     PACK_ENABLE_ALT ) );
   return FD_LAYOUT_FINI( l, scratch_align() );
 }
 
@@ -172,6 +183,10 @@ before_credit( void * _ctx,
     ctx->cur_spot = NULL;
   }
 
+  /* Each time PoH is reset onto a new block, drop the transactions
+     whose blockhash just expired.  This is cheap when nothing changed. */
+  fd_pack_expire_before( ctx->pack, fd_pack_blockhash_tbl_height( ctx->blockhash_tbl ) );
+
   /* If we time out on our slot, then stop being leader. */
   long now = fd_log_wallclock();
   if( FD_UNLIKELY( now>=ctx->slot_end_ns && ctx->leader_slot!=ULONG_MAX ) ) {
@@ -379,7 +394,7 @@ unprivileged_init( fd_topo_t *      topo,
   if( FD_UNLIKELY( out_cnt>FD_PACK_PACK_MAX_OUT ) ) FD_LOG_ERR(( "pack tile connects to too many banking tiles" ));
   if( FD_UNLIKELY( out_cnt!=tile->pack.bank_tile_count ) ) FD_LOG_ERR(( "pack tile connects to %lu banking tiles, but tile->pack.bank_tile_count is %lu", out_cnt, tile->pack.bank_tile_count ));
 
-  ulong pack_footprint = fd_pack_footprint( tile->pack.max_pending_transactions, out_cnt, MAX_TXN_PER_MICROBLOCK );
+  ulong pack_footprint = fd_pack_footprint( tile->pack.max_pending_transactions, out_cnt, MAX_TXN_PER_MICROBLOCK, PACK_ENABLE_ALT );
 
   FD_SCRATCH_ALLOC_INIT( l, scratch );
   fd_pack_ctx_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_pack_ctx_t ), sizeof( fd_pack_ctx_t ) );
@@ -387,7 +402,7 @@ unprivileged_init( fd_topo_t *      topo,
   if( FD_UNLIKELY( !rng ) ) FD_LOG_ERR(( "fd_rng_new failed" ));
 
   ctx->pack = fd_pack_join( fd_pack_new( FD_SCRATCH_ALLOC_APPEND( l, fd_pack_align(), pack_footprint ),
-                                         tile->pack.max_pending_transactions, out_cnt, MAX_TXN_PER_MICROBLOCK, FD_PACK_MAX_MICROBLOCKS_PER_BLOCK, rng ) );
+                                         tile->pack.max_pending_transactions, out_cnt, MAX_TXN_PER_MICROBLOCK, PACK_ENABLE_ALT, FD_PACK_MAX_MICROBLOCKS_PER_BLOCK, rng ) );
   if( FD_UNLIKELY( !ctx->pack ) ) FD_LOG_ERR(( "fd_pack_new failed" ));
 
   ctx->cur_spot = NULL;
@@ -402,10 +417,33 @@ unprivileged_init( fd_topo_t *      topo,
     FD_TEST( ULONG_MAX==fd_fseq_query( ctx->out_current[ i ] ) );
   }
 
+  fd_pack_fee_cache_t const * fee_cache = tile->extra[ out_cnt ];
+  if( FD_UNLIKELY( !fee_cache ) ) FD_LOG_ERR(( "pack tile has no fee payer cache" ));
+  fd_pack_set_fee_cache( ctx->pack, fee_cache );
+
+  ctx->blockhash_tbl = tile->extra[ out_cnt+1UL ];
+  if( FD_UNLIKELY( !ctx->blockhash_tbl ) ) FD_LOG_ERR(( "pack tile has no blockhash table" ));
+  fd_pack_set_blockhash_tbl( ctx->pack, ctx->blockhash_tbl );
+
   for( ulong i=0; i<tile->in_cnt; i++ ) {
     fd_topo_link_t * link = &topo->links[ tile->in_link_id[ i ] ];
     fd_topo_wksp_t * link_wksp = &topo->workspaces[ link->wksp_id ];
 
+    if( FD_UNLIKELY( link->fwd_wksp_id!=ULONG_MAX ) ) {
+      /* Zero copy link (see tiles.dedup.zero_copy), frags point into
+         the dcaches of the links in the forwarded workspace. */
+      ctx->in[i].mem    = topo->workspaces[ link->fwd_wksp_id ].wksp;
+      ctx->in[i].chunk0 = ULONG_MAX;
+      ctx->in[i].wmark  = 0UL;
+      for( ulong j=0; j<topo->link_cnt; j++ ) {
+        fd_topo_link_t * fwd_link = &topo->links[ j ];
+        if( FD_LIKELY( fwd_link->wksp_id!=link->fwd_wksp_id || !fwd_link->mtu ) ) continue;
+        ctx->in[i].chunk0 = fd_ulong_min( ctx->in[i].chunk0, fd_dcache_compact_chunk0( ctx->in[i].mem, fwd_link->dcache ) );
+        ctx->in[i].wmark  = fd_ulong_max( ctx->in[i].wmark,  fd_dcache_compact_wmark ( ctx->in[i].mem, fwd_link->dcache, fwd_link->mtu ) );
+      }
+      continue;
+    }
+
     ctx->in[i].mem    = link_wksp->wksp;
     ctx->in[i].chunk0 = fd_dcache_compact_chunk0( ctx->in[i].mem, link->dcache );
     ctx->in[i].wmark  = fd_dcache_compact_wmark ( ctx->in[i].mem, link->dcache, link->mtu );
@@ -276,6 +276,7 @@
 
 #include "../../../../ballet/pack/fd_pack.h"
 #include "../../../../ballet/sha256/fd_sha256.h"
+#include "../../../../ballet/poh/fd_poh.h"
 #include "../../../../ballet/bmtree/fd_bmtree.h"
 #include "../../../../disco/shred/fd_shredder.h"
 #include "../../../../disco/shred/fd_stake_ci.h"
@@ -348,6 +349,11 @@ typedef struct {
 
   ulong bank_cnt;
 
+  /* The table of recent blockhashes that pack uses to expire
+     transactions.  The blockhash of each block we are reset onto is
+     inserted into it.  Inserts are serialized by the PoH lock. */
+  fd_pack_blockhash_tbl_t * blockhash_tbl;
+
   /* If we currently are the leader according the clock AND we have
      received the leader bank for the slot from the replay stage,
      this value will be non-NULL.
@@ -726,6 +732,7 @@ fd_ext_poh_reset( ulong         reset_bank_slot, /* The slot that successfully p
   int leader_before_reset = ctx->hashcnt>=ctx->next_leader_slot_hashcnt;
 
   fd_memcpy( ctx->hash, reset_blockhash, 32UL );
+  fd_pack_blockhash_tbl_insert( ctx->blockhash_tbl, reset_blockhash );
   ctx->hashcnt             = (reset_bank_slot+1UL)*ctx->hashcnt_per_slot;
   ctx->last_hashcnt        = ctx->hashcnt;
   ctx->reset_slot_hashcnt  = ctx->hashcnt;
@@ -873,8 +880,16 @@ after_credit( void *             _ctx,
      If hashcnt_per_tick is 1, then we are in low power mode and this
      does not apply, we can mix in transactions at any time. */
   while( ctx->hashcnt<target_hash_cnt || (ctx->hashcnt_per_tick!=1UL && (ctx->hashcnt_per_tick-1UL)==(ctx->hashcnt%ctx->hashcnt_per_tick)) ) {
-    fd_sha256_hash( ctx->hash, 32UL, ctx->hash );
-    ctx->hashcnt++;
+    /* Nothing below can happen except on a tick boundary (leader slots
+       start and end on one too), so rather than hashing one at a time,
+       hash up to the target or the next tick boundary, whichever comes
+       first, in one go.  Same as above, never stop one short of a tick. */
+    ulong next_tick_hashcnt = (ctx->hashcnt/ctx->hashcnt_per_tick+1UL)*ctx->hashcnt_per_tick;
+    ulong end_hashcnt       = fd_ulong_min( fd_ulong_max( target_hash_cnt, ctx->hashcnt+1UL ), next_tick_hashcnt );
+    if( FD_UNLIKELY( end_hashcnt==next_tick_hashcnt-1UL ) ) end_hashcnt = next_tick_hashcnt;
+
+    fd_poh_append( (fd_poh_state_t *)ctx->hash, end_hashcnt-ctx->hashcnt );
+    ctx->hashcnt = end_hashcnt;
 
     if( FD_UNLIKELY( is_leader && !(ctx->hashcnt%ctx->hashcnt_per_tick) ) ) {
       /* We ticked while leader... tell the leader bank. */
@@ -1181,6 +1196,10 @@ unprivileged_init( fd_topo_t *      topo,
   ctx->bank_cnt = tile->in_cnt-1UL;
   ctx->stake_in_idx = tile->in_cnt-1UL;
 
+  /* Must be set before Solana Labs can reset us. */
+  ctx->blockhash_tbl = tile->extra[ ctx->bank_cnt ];
+  if( FD_UNLIKELY( !ctx->blockhash_tbl ) ) FD_LOG_ERR(( "PoH tile has no blockhash table" ));
+
   FD_LOG_NOTICE(( "PoH waiting to be initialized by Solana Labs client... %lu %lu", fd_poh_waiting_lock, fd_poh_returned_lock ));
   FD_VOLATILE( fd_poh_global_ctx ) = ctx;
   FD_COMPILER_MFENCE();
@@ -9,11 +9,20 @@
 
 /* The verify tile is a wrapper around the mux tile, that also verifies
    incoming transaction signatures match the data being signed.
-   Non-matching transactions are filtered out of the frag stream. */
+   Non-matching transactions are filtered out of the frag stream.
+
+   Incoming transactions are accumulated into batches of up to
+   VERIFY_BATCH_TXN_MAX transactions, and the signatures of a batch are
+   verified together with fd_ed25519_verify_batch, which is cheaper per
+   signature than verifying them one at a time.  A batch is verified
+   and published once it is full, or once the oldest transaction in it
+   has waited for tiles.verify.batch_max_latency_micros, whichever comes
+   first, so batching adds bounded latency when the tile is lightly
+   loaded. */
 
 FD_FN_CONST static inline ulong
 scratch_align( void ) {
-  return FD_TCACHE_ALIGN;
+  return FD_SIGCACHE_ALIGN;
 }
 
 FD_FN_PURE static inline ulong
@@ -21,7 +30,7 @@ scratch_footprint( fd_topo_tile_t * tile ) {
   (void)tile;
   ulong l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND( l, alignof( fd_verify_ctx_t ), sizeof( fd_verify_ctx_t ) );
-  l = FD_LAYOUT_APPEND( l, fd_tcache_align(), fd_tcache_footprint( VERIFY_TCACHE_DEPTH, VERIFY_TCACHE_MAP_CNT ) );
+  l = FD_LAYOUT_APPEND( l, fd_sigcache_align(), fd_sigcache_footprint( VERIFY_SIGCACHE_DEPTH, VERIFY_SIGCACHE_BUCKET_CNT ) );
   for( ulong i=0; i<FD_TXN_ACTUAL_SIG_MAX; i++ ) {
     l = FD_LAYOUT_APPEND( l, fd_sha512_align(), fd_sha512_footprint() );
   }
@@ -60,6 +69,39 @@ during_frag( void * _ctx,
   fd_memcpy( dst, src, sz );
 }
 
+/* flush verifies the current batch and publishes the transactions
+   that passed.  Publishes at most VERIFY_BATCH_TXN_MAX frags, which is
+   the burst of the tile, so must only be called when credits for a
+   burst are available. */
+
+static inline void
+flush( fd_verify_ctx_t *  ctx,
+       fd_mux_context_t * mux ) {
+  fd_txn_verify_batch( ctx );
+
+  for( ulong i=0UL; i<ctx->batch_cnt; i++ ) {
+    fd_verify_pending_t const * pending = ctx->batch + i;
+    if( FD_UNLIKELY( pending->res!=FD_TXN_VERIFY_SUCCESS ) ) continue;
+
+    ulong tspub = (ulong)fd_frag_meta_ts_comp( fd_tickcount() );
+    fd_mux_publish( mux, pending->tag, pending->chunk, pending->sz, 0UL, pending->tsorig, tspub );
+  }
+
+  ctx->batch_cnt     = 0UL;
+  ctx->batch_sig_cnt = 0UL;
+}
+
+static inline void
+after_credit( void *             _ctx,
+              fd_mux_context_t * mux ) {
+  fd_verify_ctx_t * ctx = (fd_verify_ctx_t *)_ctx;
+
+  if( FD_LIKELY( !ctx->batch_cnt ) ) return;
+  if( FD_LIKELY( fd_tickcount()<ctx->batch_deadline ) ) return;
+
+  flush( ctx, mux );
+}
+
 static inline void
 after_frag( void *             _ctx,
             ulong              in_idx,
@@ -73,8 +115,7 @@ after_frag( void *             _ctx,
   (void)in_idx;
   (void)seq;
   (void)opt_sig;
-  (void)opt_tsorig;
-  (void)mux;
+  (void)opt_chunk;
 
   fd_verify_ctx_t * ctx = (fd_verify_ctx_t *)_ctx;
 
@@ -104,15 +145,25 @@ after_frag( void *             _ctx,
     FD_LOG_ERR( ("txn is invalid: payload_sz = %x, recent_blockhash_off = %x", payload_sz, recent_blockhash_off ) );
   }
 
-  int res = fd_txn_verify( ctx, udp_payload, payload_sz, txn, opt_sig );
+  int res = fd_txn_verify_batch_append( ctx, udp_payload, payload_sz, txn, ctx->out_chunk, *opt_sz, *opt_tsorig );
   if( FD_UNLIKELY( res != FD_TXN_VERIFY_SUCCESS ) ) {
     *opt_filter = 1;
     return;
   }
 
+  /* The frag stays in the out dcache, unpublished, until the batch is
+     verified.  The out link burst leaves room for a full batch of them. */
+
   *opt_filter = 0;
-  *opt_chunk = ctx->out_chunk;
   ctx->out_chunk = fd_dcache_compact_next( ctx->out_chunk, *opt_sz, ctx->out_chunk0, ctx->out_wmark );
+
+  if( FD_UNLIKELY( ctx->batch_cnt==1UL ) ) ctx->batch_deadline = fd_tickcount() + ctx->batch_max_latency_ticks;
+
+  /* No frags have been published since the mux checked for a burst
+     worth of credits this iteration, as after_credit only publishes
+     when it empties the batch. */
+
+  if( FD_UNLIKELY( ctx->batch_cnt==VERIFY_BATCH_TXN_MAX ) ) flush( ctx, mux );
 }
 
 static void
@@ -121,8 +172,9 @@ unprivileged_init( fd_topo_t *      topo,
                    void *           scratch ) {
   FD_SCRATCH_ALLOC_INIT( l, scratch );
   fd_verify_ctx_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_verify_ctx_t ), sizeof( fd_verify_ctx_t ) );
-  fd_tcache_t * tcache = fd_tcache_join( fd_tcache_new( FD_SCRATCH_ALLOC_APPEND( l, FD_TCACHE_ALIGN, FD_TCACHE_FOOTPRINT( VERIFY_TCACHE_DEPTH, VERIFY_TCACHE_MAP_CNT ) ), VERIFY_TCACHE_DEPTH, VERIFY_TCACHE_MAP_CNT ) );
-  if( FD_UNLIKELY( !tcache ) ) FD_LOG_ERR(( "fd_tcache_join failed" ));
+  void * _sigcache = FD_SCRATCH_ALLOC_APPEND( l, fd_sigcache_align(), fd_sigcache_footprint( VERIFY_SIGCACHE_DEPTH, VERIFY_SIGCACHE_BUCKET_CNT ) );
+  fd_sigcache_t * sigcache = fd_sigcache_join( fd_sigcache_new( _sigcache, VERIFY_SIGCACHE_DEPTH, VERIFY_SIGCACHE_BUCKET_CNT, (ulong)fd_tickcount() ) );
+  if( FD_UNLIKELY( !sigcache ) ) FD_LOG_ERR(( "fd_sigcache_join failed" ));
 
   for ( ulong i=0; i<FD_TXN_ACTUAL_SIG_MAX; i++ ) {
     fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_sha512_t ), sizeof( fd_sha512_t ) ) ) );
@@ -130,11 +182,7 @@ unprivileged_init( fd_topo_t *      topo,
     ctx->sha[i] = sha;
   }
 
-  ctx->tcache_depth   = fd_tcache_depth       ( tcache );
-  ctx->tcache_map_cnt = fd_tcache_map_cnt     ( tcache );
-  ctx->tcache_sync    = fd_tcache_oldest_laddr( tcache );
-  ctx->tcache_ring    = fd_tcache_ring_laddr  ( tcache );
-  ctx->tcache_map     = fd_tcache_map_laddr   ( tcache );
+  ctx->sigcache = sigcache;
 
   for( ulong i=0; i<tile->in_cnt; i++ ) {
     fd_topo_link_t * link = &topo->links[ tile->in_link_id[ i ] ];
@@ -155,6 +203,11 @@ unprivileged_init( fd_topo_t *      topo,
   ctx->out_wmark  = fd_dcache_compact_wmark ( ctx->out_mem, topo->links[ tile->out_link_id_primary ].dcache, topo->links[ tile->out_link_id_primary ].mtu );
   ctx->out_chunk  = ctx->out_chunk0;
 
+  ctx->batch_cnt               = 0UL;
+  ctx->batch_sig_cnt           = 0UL;
+  ctx->batch_deadline          = 0L;
+  ctx->batch_max_latency_ticks = (long)( (double)tile->verify.batch_max_latency_micros * 1000.0 * fd_tempo_tick_per_ns( NULL ) );
+
   ulong scratch_top = FD_SCRATCH_ALLOC_FINI( l, 1UL );
   if( FD_UNLIKELY( scratch_top > (ulong)scratch + scratch_footprint( tile ) ) )
     FD_LOG_ERR(( "scratch overflow %lu %lu %lu", scratch_top - (ulong)scratch - scratch_footprint( tile ), scratch_top, (ulong)scratch + scratch_footprint( tile ) ));
@@ -184,9 +237,10 @@ populate_allowed_fds( void * scratch,
 }
 
 fd_tile_config_t fd_tile_verify = {
-  .mux_flags                = FD_MUX_FLAG_COPY, /* must copy frags for tile isolation and security */
-  .burst                    = 1UL,
+  .mux_flags                = FD_MUX_FLAG_MANUAL_PUBLISH | FD_MUX_FLAG_COPY, /* must copy frags for tile isolation and security */
+  .burst                    = VERIFY_BATCH_TXN_MAX,
   .mux_ctx                  = mux_ctx,
+  .mux_after_credit         = after_credit,
   .mux_during_frag          = during_frag,
   .mux_after_frag           = after_frag,
   .populate_allowed_seccomp = populate_allowed_seccomp,
@@ -3,8 +3,21 @@
 
 #include "tiles.h"
 
-#define VERIFY_TCACHE_DEPTH   16UL
-#define VERIFY_TCACHE_MAP_CNT 64UL
+/* VERIFY_SIGCACHE_{DEPTH,BUCKET_CNT} size the sigcache the verify
+   tile uses to drop ha traffic (duplicates that arrive close together)
+   before spending time verifying them.  Deduplication over a long
+   window is done by the dedup tile. */
+
+#define VERIFY_SIGCACHE_DEPTH      16UL
+#define VERIFY_SIGCACHE_BUCKET_CNT  4UL
+
+/* VERIFY_BATCH_TXN_MAX is the maximum number of transactions the
+   verify tile accumulates before verifying their signatures together.
+   This is also the burst of the verify tile, as a full batch is
+   published at once. */
+
+#define VERIFY_BATCH_TXN_MAX  16UL
+#define VERIFY_BATCH_SIG_MAX  (VERIFY_BATCH_TXN_MAX*FD_TXN_ACTUAL_SIG_MAX)
 
 #define FD_TXN_VERIFY_SUCCESS  0
 #define FD_TXN_VERIFY_FAILED  -1
@@ -19,15 +32,46 @@ typedef struct {
   ulong       wmark;
 } fd_verify_in_ctx_t;
 
+/* fd_verify_pending_t describes a transaction that has been accepted
+   into the current batch but whose signatures have not been verified
+   yet.  The payload lives in the out dcache at chunk and is not
+   published until the batch is verified. */
+
+typedef struct {
+  ulong chunk;   /* Location of the frag in the out dcache */
+  ulong sz;      /* Size of the frag */
+  ulong tsorig;  /* tsorig of the incoming frag */
+  ulong tag;     /* Frag sig, the first 8 bytes of the first signature */
+  ulong sig_off; /* Index of the first signature of this txn in the batch signature arrays */
+  ulong sig_cnt; /* Number of signatures of this txn */
+  int   res;     /* FD_TXN_VERIFY_* result, valid after fd_txn_verify_batch */
+} fd_verify_pending_t;
+
 typedef struct {
-  /* TODO switch to fd_sha512_batch_t? */
+  /* fd_txn_verify_batch hashes the signatures of a batch across
+     transactions in fd_sha512_batch lanes.  sha[0] is only used for
+     signatures that need to be hashed serially (e.g. invalid ones). */
   fd_sha512_t * sha[ FD_TXN_ACTUAL_SIG_MAX ];
 
-  ulong   tcache_depth;
-  ulong   tcache_map_cnt;
-  ulong * tcache_sync;
-  ulong * tcache_ring;
-  ulong * tcache_map;
+  /* The current batch.  batch_cnt is the number of pending
+     transactions and batch_sig_cnt the total number of signatures
+     they carry.  batch_deadline is the tickcount by which the batch
+     must be verified and published, and batch_max_latency_ticks how
+     long the oldest pending transaction may wait in ticks. */
+
+  ulong               batch_cnt;
+  ulong               batch_sig_cnt;
+  long                batch_deadline;
+  long                batch_max_latency_ticks;
+  fd_verify_pending_t batch[ VERIFY_BATCH_TXN_MAX ];
+
+  void const *        batch_msg   [ VERIFY_BATCH_SIG_MAX ];
+  ulong               batch_msg_sz[ VERIFY_BATCH_SIG_MAX ];
+  void const *        batch_sig   [ VERIFY_BATCH_SIG_MAX ];
+  void const *        batch_pub   [ VERIFY_BATCH_SIG_MAX ];
+  int                 batch_err   [ VERIFY_BATCH_SIG_MAX ];
+
+  fd_sigcache_t * sigcache;
 
   fd_verify_in_ctx_t in[ 32 ];
 
@@ -56,14 +100,10 @@ fd_txn_verify( fd_verify_ctx_t * ctx,
   ulong msg_sz = (ulong)payload_sz - message_off;
 
   /* The first signature is the transaction id, i.e. a unique identifier.
-     So use this to do a quick dedup of ha traffic. */
-
-  /* TODO: use more than 64 bits to dedup. */
-  ulong ha_dedup_tag = *((ulong *)signatures);
-  int ha_dup;
-  FD_FN_UNUSED ulong tcache_map_idx = 0; /* ignored */
-  FD_TCACHE_QUERY( ha_dup, tcache_map_idx, ctx->tcache_map, ctx->tcache_map_cnt, ha_dedup_tag );
-  if( FD_UNLIKELY( ha_dup ) ) {
+     So use this to do a quick dedup of ha traffic.  The sigcache
+     compares the first 32 bytes of it in full. */
+
+  if( FD_UNLIKELY( fd_sigcache_query( ctx->sigcache, signatures ) ) ) {
     return FD_TXN_VERIFY_DEDUP;
   }
 
@@ -73,15 +113,95 @@ fd_txn_verify( fd_verify_ctx_t * ctx,
     return FD_TXN_VERIFY_FAILED;
   }
 
-  /* Insert into the tcache to dedup ha traffic.
+  /* Insert into the sigcache to dedup ha traffic.
      The dedup check is repeated to guard against duped txs verifying signatures at the same time */
-  FD_TCACHE_INSERT( ha_dup, *ctx->tcache_sync, ctx->tcache_ring, ctx->tcache_depth, ctx->tcache_map, ctx->tcache_map_cnt, ha_dedup_tag );
-  if( FD_UNLIKELY( ha_dup ) ) {
+  if( FD_UNLIKELY( fd_sigcache_insert( ctx->sigcache, signatures ) ) ) {
+    return FD_TXN_VERIFY_DEDUP;
+  }
+
+  *opt_sig = FD_LOAD( ulong, signatures );
+  return FD_TXN_VERIFY_SUCCESS;
+}
+
+/* fd_txn_verify_batch_append adds the transaction to the current
+   batch of ctx.  The transaction is deduplicated against the sigcache
+   like fd_txn_verify but its signatures are not verified until the
+   next call to fd_txn_verify_batch.  udp_payload must remain valid
+   until then.  chunk, sz and tsorig are stored for the caller to
+   publish the frag afterwards.  Returns FD_TXN_VERIFY_SUCCESS if the
+   transaction was added and FD_TXN_VERIFY_DEDUP if it was dropped as a
+   duplicate.  Assumes the batch is not full. */
+
+static inline int
+fd_txn_verify_batch_append( fd_verify_ctx_t * ctx,
+                            uchar const *     udp_payload,
+                            ushort const      payload_sz,
+                            fd_txn_t const *  txn,
+                            ulong             chunk,
+                            ulong             sz,
+                            ulong             tsorig ) {
+
+  uchar  signature_cnt = txn->signature_cnt;
+  ushort signature_off = txn->signature_off;
+  ushort acct_addr_off = txn->acct_addr_off;
+  ushort message_off   = txn->message_off;
+
+  uchar const * signatures = udp_payload + signature_off;
+  uchar const * pubkeys = udp_payload + acct_addr_off;
+  uchar const * msg = udp_payload + message_off;
+  ulong msg_sz = (ulong)payload_sz - message_off;
+
+  if( FD_UNLIKELY( fd_sigcache_query( ctx->sigcache, signatures ) ) ) {
     return FD_TXN_VERIFY_DEDUP;
   }
 
-  *opt_sig = ha_dedup_tag;
+  ulong sig_off = ctx->batch_sig_cnt;
+  for( ulong i=0UL; i<signature_cnt; i++ ) {
+    ctx->batch_msg   [ sig_off+i ] = msg;
+    ctx->batch_msg_sz[ sig_off+i ] = msg_sz;
+    ctx->batch_sig   [ sig_off+i ] = signatures + 64UL*i;
+    ctx->batch_pub   [ sig_off+i ] = pubkeys    + 32UL*i;
+  }
+  ctx->batch_sig_cnt = sig_off + signature_cnt;
+
+  fd_verify_pending_t * pending = ctx->batch + ctx->batch_cnt++;
+  pending->chunk   = chunk;
+  pending->sz      = sz;
+  pending->tsorig  = tsorig;
+  pending->tag     = FD_LOAD( ulong, signatures );
+  pending->sig_off = sig_off;
+  pending->sig_cnt = signature_cnt;
+  pending->res     = FD_TXN_VERIFY_FAILED;
   return FD_TXN_VERIFY_SUCCESS;
 }
 
+/* fd_txn_verify_batch verifies the signatures of all transactions in
+   the current batch of ctx at once and sets the res field of each
+   pending transaction to the result fd_txn_verify would have given for
+   it, in order.  The caller should publish the pending transactions
+   with res FD_TXN_VERIFY_SUCCESS and then reset the batch. */
+
+static inline void
+fd_txn_verify_batch( fd_verify_ctx_t * ctx ) {
+  if( FD_UNLIKELY( !ctx->batch_sig_cnt ) ) return;
+
+  fd_ed25519_verify_batch( ctx->batch_msg, ctx->batch_msg_sz, ctx->batch_sig, ctx->batch_pub, ctx->sha[0],
+                           ctx->batch_sig_cnt, ctx->batch_err );
+
+  for( ulong i=0UL; i<ctx->batch_cnt; i++ ) {
+    fd_verify_pending_t * pending = ctx->batch + i;
+
+    int ok = 1;
+    for( ulong j=0UL; j<pending->sig_cnt; j++ ) ok &= ctx->batch_err[ pending->sig_off+j ]==FD_ED25519_SUCCESS;
+    if( FD_UNLIKELY( !ok ) ) {
+      pending->res = FD_TXN_VERIFY_FAILED;
+      continue;
+    }
+
+    /* Duplicates within the same batch are caught here */
+    int ha_dup = fd_sigcache_insert( ctx->sigcache, ctx->batch_sig[ pending->sig_off ] );
+    pending->res = ha_dup ? FD_TXN_VERIFY_DEDUP : FD_TXN_VERIFY_SUCCESS;
+  }
+}
+
 #endif /* HEADER_fd_src_app_fdctl_run_tiles_verify_h */
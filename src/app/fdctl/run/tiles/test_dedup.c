@@ -0,0 +1,226 @@
+#include "fd_dedup.c"
+
+/* Topology of the test: two verify tiles feeding the dedup tile, which
+   publishes to pack.  Links and dcaches live in two separate
+   workspaces, such that a chunk resolved against the wrong one would
+   not point at the frag. */
+
+#define TEST_LINK_DEPTH (128UL)
+
+#define TEST_WKSP_VERIFY_DEDUP (0UL)
+#define TEST_WKSP_DEDUP_PACK   (1UL)
+
+#define TEST_LINK_DEDUP_PACK   (2UL)
+
+static fd_topo_t topo[1];
+
+static void *
+test_dcache_new( fd_wksp_t * wksp,
+                 ulong       mtu ) {
+  ulong data_sz = fd_dcache_req_data_sz( mtu, TEST_LINK_DEPTH, 1UL, 1 );
+  void * mem = fd_wksp_alloc_laddr( wksp, fd_dcache_align(), fd_dcache_footprint( data_sz, 0UL ), 1UL );
+  FD_TEST( mem );
+  uchar * dcache = fd_dcache_join( fd_dcache_new( mem, data_sz, 0UL ) );
+  FD_TEST( dcache );
+  return dcache;
+}
+
+/* setup_topo lays out the topology as config.c does, with or without
+   tiles.dedup.zero_copy, and returns the dedup tile. */
+
+static fd_topo_tile_t *
+setup_topo( fd_wksp_t * verify_wksp,
+            fd_wksp_t * pack_wksp,
+            int         zero_copy ) {
+  memset( topo, 0, sizeof(fd_topo_t) );
+
+  topo->wksp_cnt = 2UL;
+  topo->workspaces[ TEST_WKSP_VERIFY_DEDUP ] = (fd_topo_wksp_t){ .id = TEST_WKSP_VERIFY_DEDUP, .kind = FD_TOPO_WKSP_KIND_VERIFY_DEDUP };
+  topo->workspaces[ TEST_WKSP_DEDUP_PACK   ] = (fd_topo_wksp_t){ .id = TEST_WKSP_DEDUP_PACK,   .kind = FD_TOPO_WKSP_KIND_DEDUP_PACK   };
+  topo->workspaces[ TEST_WKSP_VERIFY_DEDUP ].wksp = verify_wksp;
+  topo->workspaces[ TEST_WKSP_DEDUP_PACK   ].wksp = pack_wksp;
+
+  topo->link_cnt = 3UL;
+  for( ulong i=0UL; i<2UL; i++ ) {
+    topo->links[ i ] = (fd_topo_link_t){ .id          = i,
+                                         .kind        = FD_TOPO_LINK_KIND_VERIFY_TO_DEDUP,
+                                         .kind_id     = i,
+                                         .wksp_id     = TEST_WKSP_VERIFY_DEDUP,
+                                         .depth       = TEST_LINK_DEPTH,
+                                         .mtu         = FD_TPU_DCACHE_MTU,
+                                         .burst       = 1UL,
+                                         .fwd_wksp_id = ULONG_MAX };
+    topo->links[ i ].dcache = test_dcache_new( verify_wksp, FD_TPU_DCACHE_MTU );
+  }
+  topo->links[ TEST_LINK_DEDUP_PACK ] = (fd_topo_link_t){ .id          = TEST_LINK_DEDUP_PACK,
+                                                          .kind        = FD_TOPO_LINK_KIND_DEDUP_TO_PACK,
+                                                          .wksp_id     = TEST_WKSP_DEDUP_PACK,
+                                                          .depth       = TEST_LINK_DEPTH,
+                                                          .mtu         = zero_copy ? 0UL : FD_TPU_DCACHE_MTU,
+                                                          .burst       = 1UL,
+                                                          .fwd_wksp_id = zero_copy ? fd_topo_find_wksp( topo, FD_TOPO_WKSP_KIND_VERIFY_DEDUP ) : ULONG_MAX };
+  if( !zero_copy ) topo->links[ TEST_LINK_DEDUP_PACK ].dcache = test_dcache_new( pack_wksp, FD_TPU_DCACHE_MTU );
+
+  topo->tile_cnt = 1UL;
+  fd_topo_tile_t * tile = &topo->tiles[ 0 ];
+  tile->kind                = FD_TOPO_TILE_KIND_DEDUP;
+  tile->in_cnt              = 2UL;
+  tile->in_link_id[ 0 ]     = 0UL;
+  tile->in_link_id[ 1 ]     = 1UL;
+  tile->out_link_id_primary = TEST_LINK_DEDUP_PACK;
+  tile->dedup.tcache_depth  = 1024UL;
+  tile->dedup.zero_copy     = zero_copy;
+  return tile;
+}
+
+/* write_txn writes a frag laid out like the ones published by the
+   verify tile (payload, parsed txn, payload size) to the dcache of in
+   link in_idx at chunk, with a first signature filled with sig_byte.
+   Returns the size of the frag. */
+
+static ulong
+write_txn( ulong in_idx,
+           ulong chunk,
+           uchar sig_byte ) {
+  uchar * frag = fd_chunk_to_laddr( topo->workspaces[ TEST_WKSP_VERIFY_DEDUP ].wksp, chunk );
+  FD_TEST( chunk>=fd_dcache_compact_chunk0( topo->workspaces[ TEST_WKSP_VERIFY_DEDUP ].wksp, topo->links[ in_idx ].dcache ) );
+
+  ushort payload_sz = 200;
+  for( ulong i=0UL; i<payload_sz; i++ ) frag[ i ] = (uchar)(i+chunk);
+  frag[ 0 ] = 1;
+  memset( frag+1UL, sig_byte, FD_TXN_SIGNATURE_SZ );
+
+  fd_txn_t * txn = (fd_txn_t *)fd_ulong_align_up( (ulong)frag + payload_sz, 2UL );
+  memset( txn, 0, sizeof(fd_txn_t) );
+  txn->signature_cnt = 1;
+  txn->signature_off = 1;
+
+  ulong sz = (ulong)(txn+1) - (ulong)frag + sizeof(ushort);
+  FD_STORE( ushort, frag + sz - sizeof(ushort), payload_sz );
+  return sz;
+}
+
+/* receive runs a frag through the mux callbacks of the dedup tile.
+   Returns the filter decision, and the frag as published in *chunk and
+   *sz. */
+
+static int
+receive( fd_dedup_ctx_t * ctx,
+         ulong            in_idx,
+         ulong *          chunk,
+         ulong *          sz ) {
+  ulong sig    = 1UL;
+  ulong tsorig = 0UL;
+  int   filter = 0;
+  during_frag( ctx, in_idx, 0UL, sig, *chunk, *sz, &filter );
+  FD_TEST( !filter );
+  after_frag( ctx, in_idx, 0UL, &sig, chunk, sz, &tsorig, &filter, NULL );
+  if( !filter ) FD_TEST( !sig );
+  return filter;
+}
+
+static void
+test_dedup( fd_wksp_t * verify_wksp,
+            fd_wksp_t * pack_wksp,
+            int         zero_copy ) {
+  FD_LOG_NOTICE(( "test_dedup (zero_copy %d)", zero_copy ));
+
+  fd_topo_tile_t * tile = setup_topo( verify_wksp, pack_wksp, zero_copy );
+
+  FD_TEST( fd_tile_dedup.mux_flags==FD_MUX_FLAG_COPY );
+  FD_TEST( fd_tile_dedup.mux_flags_override( tile )==( zero_copy ? FD_MUX_FLAG_DEFAULT : FD_MUX_FLAG_COPY ) );
+
+  void * scratch = aligned_alloc( scratch_align(), scratch_footprint( tile ) );
+  FD_TEST( scratch );
+  memset( scratch, 0, scratch_footprint( tile ) );
+  privileged_init  ( topo, tile, scratch );
+  unprivileged_init( topo, tile, scratch );
+  fd_dedup_ctx_t * ctx = mux_ctx( scratch );
+  FD_TEST( ctx->zero_copy==zero_copy );
+
+  /* Pack resolves chunks published by dedup against the workspace of
+     the link, or the forwarded workspace for a zero copy link, and
+     bounds checks them against the dcaches in there. */
+
+  fd_topo_link_t const * out = &topo->links[ TEST_LINK_DEDUP_PACK ];
+  ulong       pack_wksp_id = zero_copy ? out->fwd_wksp_id : out->wksp_id;
+  FD_TEST( pack_wksp_id==( zero_copy ? TEST_WKSP_VERIFY_DEDUP : TEST_WKSP_DEDUP_PACK ) );
+  fd_wksp_t * pack_mem     = topo->workspaces[ pack_wksp_id ].wksp;
+  ulong       pack_chunk0  = ULONG_MAX;
+  ulong       pack_wmark   = 0UL;
+  for( ulong j=0UL; j<topo->link_cnt; j++ ) {
+    fd_topo_link_t const * link = &topo->links[ j ];
+    if( link->wksp_id!=pack_wksp_id || !link->mtu ) continue;
+    pack_chunk0 = fd_ulong_min( pack_chunk0, fd_dcache_compact_chunk0( pack_mem, link->dcache ) );
+    pack_wmark  = fd_ulong_max( pack_wmark,  fd_dcache_compact_wmark ( pack_mem, link->dcache, link->mtu ) );
+  }
+
+  ulong out_chunk = zero_copy ? 0UL : fd_dcache_compact_chunk0( pack_wksp, out->dcache );
+
+  /* Unique txns from either verify tile are published, either as is
+     or copied to the out dcache in order */
+
+  for( ulong i=0UL; i<8UL; i++ ) {
+    ulong in_idx   = i&1UL;
+    ulong in_chunk = fd_dcache_compact_chunk0( verify_wksp, topo->links[ in_idx ].dcache ) + 16UL*i;
+    ulong sz       = write_txn( in_idx, in_chunk, (uchar)(0x10UL+i) );
+    ulong chunk    = in_chunk;
+    ulong pub_sz   = sz;
+    FD_TEST( !receive( ctx, in_idx, &chunk, &pub_sz ) );
+    FD_TEST( pub_sz==sz );
+
+    if( zero_copy ) {
+      FD_TEST( chunk==in_chunk );
+    } else {
+      FD_TEST( chunk==out_chunk );
+      out_chunk = fd_dcache_compact_next( out_chunk, sz, ctx->out_chunk0, ctx->out_wmark );
+    }
+
+    FD_TEST( chunk>=pack_chunk0 && chunk<=pack_wmark );
+    uchar const * src = fd_chunk_to_laddr_const( verify_wksp, in_chunk );
+    uchar const * dst = fd_chunk_to_laddr_const( pack_mem,    chunk    );
+    FD_TEST( (src==dst)==zero_copy );
+    FD_TEST( !memcmp( src, dst, sz ) );
+  }
+
+  /* Duplicates are filtered, whichever verify tile they come from, and
+     leave the out dcache alone */
+
+  for( ulong i=0UL; i<8UL; i++ ) {
+    ulong in_idx   = (i+1UL)&1UL;
+    ulong in_chunk = fd_dcache_compact_chunk0( verify_wksp, topo->links[ in_idx ].dcache ) + 16UL*(8UL+i);
+    ulong sz       = write_txn( in_idx, in_chunk, (uchar)(0x10UL+i) );
+    ulong chunk    = in_chunk;
+    FD_TEST( receive( ctx, in_idx, &chunk, &sz ) );
+    if( !zero_copy ) FD_TEST( ctx->out_chunk==out_chunk );
+  }
+
+  free( scratch );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz  = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL, "normal"                     );
+  ulong        page_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL, 4096UL                       );
+  ulong        numa_idx  = fd_env_strip_cmdline_ulong( &argc, &argv, "--numa-idx", NULL, fd_shmem_numa_idx( 0 )       );
+
+  ulong page_sz = fd_cstr_to_shmem_page_sz( _page_sz );
+  if( FD_UNLIKELY( !page_sz ) ) FD_LOG_ERR(( "unsupported --page-sz" ));
+
+  fd_wksp_t * verify_wksp = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( numa_idx ), "verify_dedup", 0UL );
+  fd_wksp_t * pack_wksp   = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( numa_idx ), "dedup_pack",   0UL );
+  FD_TEST( verify_wksp && pack_wksp );
+
+  test_dedup( verify_wksp, pack_wksp, 0 );
+  test_dedup( verify_wksp, pack_wksp, 1 );
+
+  fd_wksp_delete_anonymous( pack_wksp   );
+  fd_wksp_delete_anonymous( verify_wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
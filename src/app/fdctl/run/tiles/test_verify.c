@@ -110,21 +110,15 @@ load_test_txn( char * hex[], ulong hex_sz, ulong * tx_len ) {
 
 static void
 setup_verify_ctx( fd_verify_ctx_t * ctx, void ** mem ) {
-  /* tcache - note: using aligned_alloc for tests */
-  ulong depth     = VERIFY_TCACHE_DEPTH;
-  ulong map_cnt   = VERIFY_TCACHE_MAP_CNT;
-  ulong align     = fd_tcache_align();
-  ulong footprint = fd_tcache_footprint( depth, map_cnt );
-  if( FD_UNLIKELY( !footprint ) ) FD_LOG_ERR(( "bad depth / map_cnt" ));
+  /* sigcache - note: using aligned_alloc for tests */
+  ulong depth      = VERIFY_SIGCACHE_DEPTH;
+  ulong bucket_cnt = VERIFY_SIGCACHE_BUCKET_CNT;
+  ulong align      = fd_sigcache_align();
+  ulong footprint  = fd_sigcache_footprint( depth, bucket_cnt );
+  if( FD_UNLIKELY( !footprint ) ) FD_LOG_ERR(( "bad depth / bucket_cnt" ));
   *mem = aligned_alloc( align, footprint ); FD_TEST( *mem );
-  fd_tcache_t * tcache = fd_tcache_join( fd_tcache_new( *mem, VERIFY_TCACHE_DEPTH, VERIFY_TCACHE_MAP_CNT ) );
-  if( FD_UNLIKELY( !tcache ) ) FD_LOG_ERR(( "fd_tcache_join failed" ));
-  ctx->tcache_depth   = fd_tcache_depth       ( tcache );
-  ctx->tcache_map_cnt = fd_tcache_map_cnt     ( tcache );
-  ctx->tcache_sync    = fd_tcache_oldest_laddr( tcache );
-  ctx->tcache_ring    = fd_tcache_ring_laddr  ( tcache );
-  ctx->tcache_map     = fd_tcache_map_laddr   ( tcache );
-  fd_tcache_reset( ctx->tcache_ring, ctx->tcache_depth, ctx->tcache_map, ctx->tcache_map_cnt );
+  ctx->sigcache = fd_sigcache_join( fd_sigcache_new( *mem, depth, bucket_cnt, 0UL ) );
+  if( FD_UNLIKELY( !ctx->sigcache ) ) FD_LOG_ERR(( "fd_sigcache_join failed" ));
 
   /* ctx->sha */
   uchar * _sha = aligned_alloc( FD_SHA512_ALIGN, sizeof(fd_sha512_t)*FD_TXN_ACTUAL_SIG_MAX );
@@ -133,6 +127,9 @@ setup_verify_ctx( fd_verify_ctx_t * ctx, void ** mem ) {
     if( FD_UNLIKELY( !sha ) ) FD_LOG_ERR(( "fd_sha512_join failed" ));
     ctx->sha[i] = sha;
   }
+
+  ctx->batch_cnt     = 0UL;
+  ctx->batch_sig_cnt = 0UL;
 }
 
 static void
@@ -247,7 +244,7 @@ test_verify_invalid_dedup_success( void ) {
   FD_TEST( res==FD_TXN_VERIFY_SUCCESS );
 
   /* clear to test the other way */
-  fd_tcache_reset( ctx->tcache_ring, ctx->tcache_depth, ctx->tcache_map, ctx->tcache_map_cnt );
+  fd_sigcache_reset( ctx->sigcache );
 
   /* valid txn with 1 signature */
   res = fd_txn_verify( ctx, payload, (ushort)payload_sz, txn, &opt_sig );
@@ -265,6 +262,61 @@ test_verify_invalid_dedup_success( void ) {
   free_verify_ctx( ctx, mem );
 }
 
+static void
+test_verify_batch( void ) {
+  fd_verify_ctx_t ctx[1];
+  void *          mem = NULL;
+  uchar           out_buf[ 4 ][ FD_TXN_MAX_SZ ];
+  uchar *         payload[ 4 ];
+  ulong           payload_sz[ 4 ];
+  int             res = 0;
+
+  FD_LOG_NOTICE(( "test_verify_batch" ));
+  setup_verify_ctx( ctx, &mem );
+
+  payload[0] = load_test_txn( valid_txn_2sigs,       sizeof(valid_txn_2sigs),       &payload_sz[0] );
+  payload[1] = load_test_txn( invalid_txn_2sigs,     sizeof(invalid_txn_2sigs),     &payload_sz[1] );
+  payload[2] = load_test_txn( invalid_txn_same_1sig, sizeof(invalid_txn_same_1sig), &payload_sz[2] );
+  payload[3] = load_test_txn( valid_txn_1sig,        sizeof(valid_txn_1sig),        &payload_sz[3] );
+  for( ulong i=0UL; i<4UL; i++ ) FD_TEST( fd_txn_parse( payload[i], payload_sz[i], out_buf[i], NULL ) );
+
+  /* A batch of valid and invalid txns, where the valid txn with 2
+     signatures appears twice.  The duplicate is only detected when the
+     batch is verified. */
+
+  ulong order[ 5 ] = { 0UL, 1UL, 2UL, 3UL, 0UL };
+  for( ulong i=0UL; i<5UL; i++ ) {
+    ulong j = order[i];
+    res = fd_txn_verify_batch_append( ctx, payload[j], (ushort)payload_sz[j], (fd_txn_t *)out_buf[j], i, payload_sz[j], 0UL );
+    FD_TEST( res==FD_TXN_VERIFY_SUCCESS );
+  }
+  FD_TEST( ctx->batch_cnt==5UL );
+  FD_TEST( ctx->batch_sig_cnt==8UL );
+
+  fd_txn_verify_batch( ctx );
+  FD_TEST( ctx->batch[0].res==FD_TXN_VERIFY_SUCCESS );
+  FD_TEST( ctx->batch[1].res==FD_TXN_VERIFY_FAILED  );
+  FD_TEST( ctx->batch[2].res==FD_TXN_VERIFY_FAILED  );
+  FD_TEST( ctx->batch[3].res==FD_TXN_VERIFY_SUCCESS );
+  FD_TEST( ctx->batch[4].res==FD_TXN_VERIFY_DEDUP   );
+  for( ulong i=0UL; i<5UL; i++ ) FD_TEST( ctx->batch[i].chunk==i );
+
+  /* Txns verified in an earlier batch are deduped on append, as is
+     any txn with the same first signature, like fd_txn_verify (each
+     invalid txn shares its first signature with a valid one) */
+
+  ctx->batch_cnt     = 0UL;
+  ctx->batch_sig_cnt = 0UL;
+  for( ulong i=0UL; i<4UL; i++ ) {
+    res = fd_txn_verify_batch_append( ctx, payload[i], (ushort)payload_sz[i], (fd_txn_t *)out_buf[i], i, payload_sz[i], 0UL );
+    FD_TEST( res==FD_TXN_VERIFY_DEDUP );
+  }
+  FD_TEST( !ctx->batch_cnt );
+
+  for( ulong i=0UL; i<4UL; i++ ) free( payload[i] );
+  free_verify_ctx( ctx, mem );
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -273,6 +325,7 @@ main( int     argc,
   test_verify_success();
   test_verify_invalid_sigs_success();
   test_verify_invalid_dedup_success();
+  test_verify_batch();
 
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
@@ -3,6 +3,8 @@
 #include "run/tiles/tiles.h"
 #include "../../disco/fd_disco_base.h"
 #include "../../disco/quic/fd_tpu.h"
+#include "../../ballet/pack/fd_pack_fee_cache.h"
+#include "../../ballet/pack/fd_pack_blockhash_tbl.h"
 #include "../../util/wksp/fd_wksp_private.h"
 #include "../../util/shmem/fd_shmem_private.h"
 
@@ -60,10 +62,12 @@ tile_needs_wksp( fd_topo_t const * topo, fd_topo_tile_t * tile, ulong wksp_id )
   if( FD_UNLIKELY( topo->workspaces[ wksp_id ].kind==FD_TOPO_WKSP_KIND_METRIC_IN ) ) return FD_SHMEM_JOIN_MODE_READ_WRITE;
 
   /* Tiles only need readonly access to workspaces they consume links
-     from. */
+     from, and to the workspaces zero copy links forward data from. */
   for( ulong i=0UL; i<tile->in_cnt; i++ ) {
-    fd_topo_wksp_t const * link_wksp = &topo->workspaces[ topo->links[ tile->in_link_id[ i ] ].wksp_id ];
+    fd_topo_link_t const * link      = &topo->links[ tile->in_link_id[ i ] ];
+    fd_topo_wksp_t const * link_wksp = &topo->workspaces[ link->wksp_id ];
     if( FD_UNLIKELY( link_wksp->id==wksp_id ) ) return FD_SHMEM_JOIN_MODE_READ_ONLY;
+    if( FD_UNLIKELY( link->fwd_wksp_id==wksp_id ) ) return FD_SHMEM_JOIN_MODE_READ_ONLY;
   }
 
   return -1;
@@ -260,6 +264,41 @@ fd_topo_workspace_fill( fd_topo_t *      topo,
         }
       }
     }
+
+    /* The fee payer cache is written by the bank tiles and read by
+       pack, which finds it right after the busy fseqs.  64k entries is
+       4 MiB, and entries expire after 150 slots, about the lifetime of
+       a recent blockhash. */
+    void * _fee_cache = SCRATCH_ALLOC( fd_pack_fee_cache_align(), fd_pack_fee_cache_footprint( 65536UL ) );
+    if( FD_LIKELY( mode==FD_TOPO_FILL_MODE_NEW ) ) {
+      INSERT_POD( "fee_payer_cache", fd_pack_fee_cache_new( _fee_cache, 65536UL, 150UL ) );
+    } else if( FD_LIKELY( mode==FD_TOPO_FILL_MODE_JOIN ) ) {
+      fd_pack_fee_cache_t * fee_cache = fd_pack_fee_cache_join( _fee_cache );
+      if( FD_UNLIKELY( !fee_cache ) ) FD_LOG_ERR(( "fd_pack_fee_cache_join failed" ));
+      for( ulong j=0UL; j<topo->tile_cnt; j++ ) {
+        fd_topo_tile_t * tile = &topo->tiles[ j ];
+        if( FD_UNLIKELY( tile->kind==FD_TOPO_TILE_KIND_PACK ) ) tile->extra[ bank_cnt ] = fee_cache;
+        else if( FD_UNLIKELY( tile->kind==FD_TOPO_TILE_KIND_BANK ) ) tile->extra[ 1 ] = fee_cache;
+      }
+    }
+
+    /* The recent blockhash table is written by PoH whenever it is reset
+       onto a new block, and read by pack.  Both find it right after the
+       busy fseqs (and pack, the fee payer cache).  4k entries is
+       256 KiB, enough to remember blockhashes well past the point they
+       expire. */
+    void * _blockhash_tbl = SCRATCH_ALLOC( fd_pack_blockhash_tbl_align(), fd_pack_blockhash_tbl_footprint( 4096UL ) );
+    if( FD_LIKELY( mode==FD_TOPO_FILL_MODE_NEW ) ) {
+      INSERT_POD( "blockhash_tbl", fd_pack_blockhash_tbl_new( _blockhash_tbl, 4096UL ) );
+    } else if( FD_LIKELY( mode==FD_TOPO_FILL_MODE_JOIN ) ) {
+      fd_pack_blockhash_tbl_t * blockhash_tbl = fd_pack_blockhash_tbl_join( _blockhash_tbl );
+      if( FD_UNLIKELY( !blockhash_tbl ) ) FD_LOG_ERR(( "fd_pack_blockhash_tbl_join failed" ));
+      for( ulong j=0UL; j<topo->tile_cnt; j++ ) {
+        fd_topo_tile_t * tile = &topo->tiles[ j ];
+        if( FD_UNLIKELY( tile->kind==FD_TOPO_TILE_KIND_PACK ) ) tile->extra[ bank_cnt+1UL ] = blockhash_tbl;
+        else if( FD_UNLIKELY( tile->kind==FD_TOPO_TILE_KIND_POH ) ) tile->extra[ bank_cnt ] = blockhash_tbl;
+      }
+    }
   }
 
   for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
@@ -142,6 +142,10 @@ typedef struct {
   ulong mtu;     /* The MTU of data fragments in the mcache.  A value of 0 means there is no dcache. */
   ulong burst;   /* The max amount of MTU sized data fragments that might be bursted to the dcache. */
 
+  ulong fwd_wksp_id; /* If not ULONG_MAX, the link is zero copy: its producer republishes frags it received without copying them,
+                        so chunks are relative to workspace fwd_wksp_id and point into the dcaches of the upstream links there.
+                        A zero copy link has no dcache of its own (mtu is 0). */
+
   /* Computed fields.  These are not supplied as configuration but calculated as needed. */
   struct {
    fd_frag_meta_t * mcache; /* The mcache of this link. */
@@ -229,8 +233,13 @@ typedef struct {
       char  identity_key_path[ PATH_MAX ];
     } quic;
 
+    struct {
+      ulong batch_max_latency_micros;
+    } verify;
+
     struct {
       ulong tcache_depth;
+      int   zero_copy;
     } dedup;
 
     struct {
@@ -9,9 +9,9 @@
 
 /* TODO: Do we need to support ivlen other than 12? */
 
-static void
-fd_aes_gcm_setiv( fd_aes_gcm_t * gcm,
-                  uchar const    iv[ static 12 ] ) {
+void
+fd_aes_gcm_init_iv( fd_aes_gcm_t * gcm,
+                    uchar const    iv[ static 12 ] ) {
 
   uint ctr;
   gcm->len.u[ 0 ] = 0;  /* AAD length */
@@ -36,10 +36,9 @@ fd_aes_gcm_setiv( fd_aes_gcm_t * gcm,
 }
 
 void
-fd_aes_gcm_init( fd_aes_gcm_t * gcm,
-                 uchar const *  key,
-                 ulong          key_sz,
-                 uchar const    iv[ static 12 ] ) {
+fd_aes_gcm_init_key( fd_aes_gcm_t * gcm,
+                     uchar const *  key,
+                     ulong          key_sz ) {
 
   /* TODO: Check key size */
 
@@ -55,7 +54,15 @@ fd_aes_gcm_init( fd_aes_gcm_t * gcm,
   gcm->H.u[ 1 ] = fd_ulong_bswap( gcm->H.u[ 1 ] );
 
   fd_gcm_init( gcm->Htable, gcm->H.u );
-  fd_aes_gcm_setiv( gcm, iv );
+}
+
+void
+fd_aes_gcm_init( fd_aes_gcm_t * gcm,
+                 uchar const *  key,
+                 ulong          key_sz,
+                 uchar const    iv[ static 12 ] ) {
+  fd_aes_gcm_init_key( gcm, key, key_sz );
+  fd_aes_gcm_init_iv ( gcm, iv );
 }
 
 static int
@@ -21,6 +21,11 @@
    change in the future to support a batched 'multi block' API or
    streaming mode of operation.
 
+   Setting up a key (AES key expansion and GHASH table) costs about as
+   much as processing a small message.  Users that process many
+   messages with the same key should set up the key once with
+   fd_aes_gcm_init_key and only call fd_aes_gcm_init_iv per message.
+
    AES-GCM offers opportunity for processing of multiple AES blocks in
    parallel.  However, the computation of the auth tag is a sequential
    chain with depth of block count of message.  In QUIC, the max
@@ -44,6 +49,29 @@ fd_aes_gcm_init( fd_aes_gcm_t * aes_gcm,
                  ulong          key_len,
                  uchar const    iv[ static 12 ] );
 
+/* fd_aes_gcm_init_key initializes the key-dependent state of aes_gcm
+   (expanded AES key and GHASH table) from key (key_len bytes, in
+   {16,24,32}).  Zero-initialization of aes_gcm not required.
+   fd_aes_gcm_init_iv must be called before each encrypt or decrypt.
+
+   fd_aes_gcm_init_iv resets the per-message state of aes_gcm for a new
+   message with the 12 byte initialization vector iv.  The key-dependent
+   state is kept, such that an aes_gcm can be reused for any number of
+   messages after a single fd_aes_gcm_init_key.  (An aes_gcm is
+   modified by encrypt/decrypt and thus may not be used concurrently.)
+
+   fd_aes_gcm_init is equivalent to fd_aes_gcm_init_key followed by
+   fd_aes_gcm_init_iv. */
+
+void
+fd_aes_gcm_init_key( fd_aes_gcm_t * aes_gcm,
+                     uchar const *  key,
+                     ulong          key_len );
+
+void
+fd_aes_gcm_init_iv( fd_aes_gcm_t * aes_gcm,
+                    uchar const    iv[ static 12 ] );
+
 static inline void
 fd_aes_128_gcm_init( fd_aes_gcm_t * aes_gcm,
                      uchar const    key[ static 16 ],
@@ -437,9 +437,33 @@ test_aes_128_gcm( void ) {
     BITFLIP( corrupt_aad, i );
   }
 
+  FD_LOG_INFO(( "OK: AES-128-GCM auth (AES-NI)" ));
+
+  /* Test reuse of key schedule across messages (including after a
+     failed decrypt) */
+
+  fd_aes_gcm_init_key( gcm, key, 16UL );
+  for( ulong i=0UL; i<3UL; i++ ) {
+    fd_memset( actual_ciphertext, 0, sizeof(actual_ciphertext) );
+    fd_aes_gcm_init_iv( gcm, iv );
+    fd_aes_gcm_aead_encrypt( gcm, actual_ciphertext, plaintext, sizeof(plaintext), aad, sizeof(aad), actual_tag );
+    FD_TEST( 0==memcmp( actual_ciphertext, ciphertext, sizeof( ciphertext ) ) );
+    FD_TEST( 0==memcmp( actual_tag,        tag,        sizeof( tag        ) ) );
+
+    BITFLIP( corrupt_aad, i );
+    fd_aes_gcm_init_iv( gcm, iv );
+    FD_TEST( !fd_aes_gcm_aead_decrypt( gcm, ciphertext, actual_plaintext, sizeof(ciphertext), corrupt_aad, sizeof(corrupt_aad), tag ) );
+    BITFLIP( corrupt_aad, i );
+
+    fd_memset( actual_plaintext, 0, sizeof(actual_plaintext) );
+    fd_aes_gcm_init_iv( gcm, iv );
+    FD_TEST( fd_aes_gcm_aead_decrypt( gcm, ciphertext, actual_plaintext, sizeof(ciphertext), aad, sizeof(aad), tag ) );
+    FD_TEST( 0==memcmp( actual_plaintext, plaintext, sizeof( plaintext ) ) );
+  }
+
 # undef BITFLIP
 
-  FD_LOG_INFO(( "OK: AES-128-GCM auth (AES-NI)" ));
+  FD_LOG_INFO(( "OK: AES-128-GCM key reuse (AES-NI)" ));
 }
 
 /* AES-GCM unroll tests ***********************************************/
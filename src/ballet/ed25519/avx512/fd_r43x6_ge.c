@@ -274,6 +274,119 @@ failb:
 # endif
 }
 
+int
+fd_r43x6_ge_decode4( wwl_t * _Pa03, wwl_t * _Pa14, wwl_t * _Pa25,
+                     void const * _vsa,
+                     wwl_t * _Pb03, wwl_t * _Pb14, wwl_t * _Pb25,
+                     void const * _vsb,
+                     wwl_t * _Pc03, wwl_t * _Pc14, wwl_t * _Pc25,
+                     void const * _vsc,
+                     wwl_t * _Pd03, wwl_t * _Pd14, wwl_t * _Pd25,
+                     void const * _vsd ) {
+
+  /* This follows decode2 above step for step but runs the GF(p)
+     arithmetic for all four points in the FD_R43X6_QUAD representation.
+     A point that fails a check is not aborted early.  It just runs to
+     completion on garbage and has its failure recorded.  The (cheap)
+     per point decisions are done on unpacked values. */
+
+  fd_r43x6_t const one     = fd_r43x6_one();
+  fd_r43x6_t const d       = fd_r43x6_d();
+  fd_r43x6_t const sqrt_m1 = fd_r43x6_imag();
+
+# define MUL( Z, X, Y ) FD_R43X6_QUAD_DECL( Z ); FD_R43X6_QUAD_MUL_FAST( Z, X, Y ); FD_R43X6_QUAD_FOLD_UNSIGNED( Z, Z )
+# define SQR( Z, X    ) FD_R43X6_QUAD_DECL( Z ); FD_R43X6_QUAD_SQR_FAST( Z, X    ); FD_R43X6_QUAD_FOLD_UNSIGNED( Z, Z )
+
+  void const * _vs[4] = { _vsa, _vsb, _vsc, _vsd };
+
+  int        fail = 0;
+  int        x_0[4];
+  fd_r43x6_t y  [4];
+  for( int j=0; j<4; j++ ) {
+    ulong _s[4] __attribute__((aligned(32)));
+    memcpy( _s, _vs[j], 32UL );
+    x_0[j] = (int)(_s[3]>>63);
+    _s[3] &= ~(1UL<<63);
+    ulong c = 19UL;
+    ulong t;
+    t = _s[0] + c; c = (ulong)(t<c);
+    t = _s[1] + c; c = (ulong)(t<c);
+    t = _s[2] + c; c = (ulong)(t<c);
+    t = _s[3] + c;
+    fail |= ((int)(t>>63)) << j;
+    y[j] = fd_r43x6_unpack( wv_ld( _s ) );
+  }
+
+  FD_R43X6_QUAD_DECL( One ); FD_R43X6_QUAD_PACK( One, one, one, one, one );
+  FD_R43X6_QUAD_DECL( D   ); FD_R43X6_QUAD_PACK( D,   d,   d,   d,   d   );
+  FD_R43X6_QUAD_DECL( Y   ); FD_R43X6_QUAD_PACK( Y,   y[0],y[1],y[2],y[3] );
+
+  SQR( Ysq, Y );
+  FD_R43X6_QUAD_DECL( U ); FD_R43X6_QUAD_LANE_SUB_FAST( U, Ysq, 1,1,1,1, Ysq, One ); FD_R43X6_QUAD_FOLD_SIGNED( U, U );
+  MUL( V, D, Ysq );        FD_R43X6_QUAD_LANE_ADD_FAST( V, V,   1,1,1,1, V,   One );
+
+  SQR( V2,  V       );
+  SQR( V4,  V2      );
+  MUL( V3,  V,   V2 );
+  MUL( UV3, U,   V3 );
+  MUL( UV7, UV3, V4 );
+
+  fd_r43x6_t uv7[4]; FD_R43X6_QUAD_UNPACK( uv7[0], uv7[1], uv7[2], uv7[3], UV7 );
+  fd_r43x6_t t0 [4]; FD_R43X6_POW22523_4_INL( t0[0],uv7[0], t0[1],uv7[1], t0[2],uv7[2], t0[3],uv7[3] );
+  FD_R43X6_QUAD_DECL( T0 ); FD_R43X6_QUAD_PACK( T0, t0[0], t0[1], t0[2], t0[3] );
+
+  MUL( X,   UV3, T0 );
+  SQR( X2,  X       );
+  MUL( VX2, V,   X2 );
+  FD_R43X6_QUAD_DECL( T1 ); FD_R43X6_QUAD_LANE_SUB_FAST( T1, VX2, 1,1,1,1, VX2, U );
+  FD_R43X6_QUAD_DECL( T2 ); FD_R43X6_QUAD_LANE_ADD_FAST( T2, VX2, 1,1,1,1, VX2, U );
+
+  fd_r43x6_t t1[4]; FD_R43X6_QUAD_UNPACK( t1[0], t1[1], t1[2], t1[3], T1 );
+  fd_r43x6_t t2[4]; FD_R43X6_QUAD_UNPACK( t2[0], t2[1], t2[2], t2[3], T2 );
+  fd_r43x6_t t3[4];
+  for( int j=0; j<4; j++ ) {
+    int t1nz = fd_r43x6_is_nonzero( t1[j] );
+    int t2nz = fd_r43x6_is_nonzero( t2[j] );
+    fail |= (t1nz & t2nz) << j;
+    t3[j] = fd_r43x6_if( t1nz, sqrt_m1, one );
+  }
+  FD_R43X6_QUAD_DECL( T3 ); FD_R43X6_QUAD_PACK( T3, t3[0], t3[1], t3[2], t3[3] );
+
+  MUL( Xr, X, T3 );
+
+  fd_r43x6_t x[4]; FD_R43X6_QUAD_UNPACK( x[0], x[1], x[2], x[3], Xr );
+  for( int j=0; j<4; j++ ) {
+    int x_mod_2 = fd_r43x6_diagnose( x[j] );
+    fail |= ((x_mod_2==-1) & (x_0[j]==1)) << j;
+    x[j] = fd_r43x6_if( x_0[j]!=x_mod_2, fd_r43x6_neg( x[j] ), x[j] );
+  }
+  FD_R43X6_QUAD_DECL( Xs ); FD_R43X6_QUAD_PACK( Xs, x[0], x[1], x[2], x[3] );
+
+  MUL( XY, Xs, Y );
+
+  fd_r43x6_t xy[4]; FD_R43X6_QUAD_UNPACK( xy[0], xy[1], xy[2], xy[3], XY );
+
+# undef SQR
+# undef MUL
+
+  /* Failed points get zeroed like in decode2 */
+
+  fd_r43x6_t const zero = fd_r43x6_zero();
+  for( int j=0; j<4; j++ ) {
+    if( FD_UNLIKELY( (fail>>j) & 1 ) ) x[j] = y[j] = xy[j] = zero;
+  }
+  fd_r43x6_t onea = fd_r43x6_if( fail & 1, zero, one );
+  fd_r43x6_t oneb = fd_r43x6_if( fail & 2, zero, one );
+  fd_r43x6_t onec = fd_r43x6_if( fail & 4, zero, one );
+  fd_r43x6_t oned = fd_r43x6_if( fail & 8, zero, one );
+
+  FD_R43X6_QUAD_PACK( *_Pa, x[0],y[0],onea,xy[0] );
+  FD_R43X6_QUAD_PACK( *_Pb, x[1],y[1],oneb,xy[1] );
+  FD_R43X6_QUAD_PACK( *_Pc, x[2],y[2],onec,xy[2] );
+  FD_R43X6_QUAD_PACK( *_Pd, x[3],y[3],oned,xy[3] );
+  return fail;
+}
+
 void
 fd_r43x6_ge_smul_base_ref( wwl_t * _R03, wwl_t * _R14, wwl_t * _R25,
                            void const * _vs ) {
@@ -703,6 +816,11 @@ fd_r43x6_ge_sparsen( int *        _t,     /* 256-entry */
          2^shift>(2*max), ti +/- 2^shift*tj is _not_ in [-max,max] and
          we can't merge this j and any following into i. */
 
+      /* Note: j-i can be large here if there was a long run of zeros
+         after i (1<<(j-i) would overflow).  Any such j is too far
+         away to absorb for the supported range of max. */
+
+      if( (j-i)>30 ) break;
       int delta = 1 << (j-i); /* even */
       if( delta>(2*max) ) break;
 
@@ -923,3 +1041,65 @@ fd_r43x6_ge_dmul_sparse( wwl_t * _R03, wwl_t * _R14, wwl_t * _R25,
 # undef MAXK
 # undef MAXS
 }
+
+void
+fd_r43x6_ge_dmul_sparse2( wwl_t * _Ra03, wwl_t * _Ra14, wwl_t * _Ra25,
+                          void const * _vsa,
+                          void const * _vka,
+                          wwl_t    Aa03, wwl_t    Aa14, wwl_t    Aa25,
+                          wwl_t * _Rb03, wwl_t * _Rb14, wwl_t * _Rb25,
+                          void const * _vsb,
+                          void const * _vkb,
+                          wwl_t    Ab03, wwl_t    Ab14, wwl_t    Ab25 ) {
+
+  /* This is identical to dmul_sparse above but runs two independent
+     calculations in lockstep.  Each accumulation is a long chain of
+     dependent (and latency bound) doublings.  Interleaving two chains
+     lets the core overlap them.  The lockstep loop starts at the
+     highest non-zero index of either calculation.  The other
+     calculation doubles the neutral point until it reaches its own
+     highest non-zero index, which doesn't change its result. */
+
+# define MAXS (2047)
+# define MAXK (9)
+
+  wwl_t Atablea[3*(MAXK+1)]; fd_r43x6_ge_sparse_table( Atablea, Aa03, Aa14, Aa25, MAXK );
+  wwl_t Atableb[3*(MAXK+1)]; fd_r43x6_ge_sparse_table( Atableb, Ab03, Ab14, Ab25, MAXK );
+
+  int _wsa[256]; fd_r43x6_ge_sparsen( _wsa, _vsa, MAXS );       int _wsb[256]; fd_r43x6_ge_sparsen( _wsb, _vsb, MAXS );
+  int _wka[256]; fd_r43x6_ge_sparsen( _wka, _vka, MAXK );       int _wkb[256]; fd_r43x6_ge_sparsen( _wkb, _vkb, MAXK );
+
+  FD_R43X6_QUAD_DECL( Ra ); FD_R43X6_GE_ZERO( Ra );             FD_R43X6_QUAD_DECL( Rb ); FD_R43X6_GE_ZERO( Rb );
+
+  int i;
+
+  for( i=255; i>=0; i-- ) if( FD_UNLIKELY( _wka[i] | _wsa[i] | _wkb[i] | _wsb[i] ) ) break;
+
+# define ADD_TABLE( R, table, w, max ) do {                     \
+    int _l = 3*(((max)+(w))>>1);                                \
+    FD_R43X6_QUAD_DECL( _T );                                   \
+    _T03 = (table)[ _l + 0 ];                                   \
+    _T14 = (table)[ _l + 1 ];                                   \
+    _T25 = (table)[ _l + 2 ];                                   \
+    FD_R43X6_GE_ADD_TABLE( R, _T, R );                          \
+  } while(0)
+
+  for( ; i>=0; i-- ) {
+    int wsa = _wsa[i];                                          int wsb = _wsb[i];
+    int wka = _wka[i];                                          int wkb = _wkb[i];
+    if( FD_UNLIKELY( wsa ) ) ADD_TABLE( Ra, fd_r43x6_ge_dmul_sparse_table, wsa, MAXS );
+    /**/                                                        if( FD_UNLIKELY( wsb ) ) ADD_TABLE( Rb, fd_r43x6_ge_dmul_sparse_table, wsb, MAXS );
+    if( FD_UNLIKELY( wka ) ) ADD_TABLE( Ra, Atablea, wka, MAXK );
+    /**/                                                        if( FD_UNLIKELY( wkb ) ) ADD_TABLE( Rb, Atableb, wkb, MAXK );
+    if( FD_LIKELY( i ) ) {
+      FD_R43X6_GE_DBL( Ra, Ra );                                FD_R43X6_GE_DBL( Rb, Rb );
+    }
+  }
+
+# undef ADD_TABLE
+
+  FD_R43X6_QUAD_MOV( *_Ra, Ra );                                FD_R43X6_QUAD_MOV( *_Rb, Rb );
+
+# undef MAXK
+# undef MAXS
+}
@@ -309,6 +309,34 @@ fd_r43x6_ge_decode2( wwl_t * _Pa03, wwl_t * _Pa14, wwl_t * _Pa25,
                      wwl_t * _Pb03, wwl_t * _Pb14, wwl_t * _Pb25,
                      void const * _vsb );
 
+/* FD_R43X6_GE_DECODE4( Pa,sa, Pb,sb, Pc,sc, Pd,sd ) decodes four
+   encoded curve points independently.  Unlike DECODE2, a failure to
+   decode one point does not affect the others.  Returns a bit field
+   with bit j set if the j-th point (a,b,c,d -> 0,1,2,3) failed to
+   decode (0 if all succeeded).  Points that decoded successfully will
+   hold the same curve point as GE_DECODE would produce and failed
+   points will hold reduced 0 for X,Y,Z,T. */
+
+#define FD_R43X6_GE_DECODE4( Pa,sa, Pb,sb, Pc,sc, Pd,sd ) (__extension__({                         \
+    FD_R43X6_QUAD_DECL( _Pa ); FD_R43X6_QUAD_DECL( _Pb );                                          \
+    FD_R43X6_QUAD_DECL( _Pc ); FD_R43X6_QUAD_DECL( _Pd );                                          \
+    int _fail = fd_r43x6_ge_decode4( &_Pa03, &_Pa14, &_Pa25, (sa), &_Pb03, &_Pb14, &_Pb25, (sb),   \
+                                     &_Pc03, &_Pc14, &_Pc25, (sc), &_Pd03, &_Pd14, &_Pd25, (sd) ); \
+    FD_R43X6_QUAD_MOV( Pa, _Pa ); FD_R43X6_QUAD_MOV( Pb, _Pb );                                    \
+    FD_R43X6_QUAD_MOV( Pc, _Pc ); FD_R43X6_QUAD_MOV( Pd, _Pd );                                    \
+    _fail;                                                                                         \
+  }))
+
+int
+fd_r43x6_ge_decode4( wwl_t * _Pa03, wwl_t * _Pa14, wwl_t * _Pa25,
+                     void const * _vsa,
+                     wwl_t * _Pb03, wwl_t * _Pb14, wwl_t * _Pb25,
+                     void const * _vsb,
+                     wwl_t * _Pc03, wwl_t * _Pc14, wwl_t * _Pc25,
+                     void const * _vsc,
+                     wwl_t * _Pd03, wwl_t * _Pd14, wwl_t * _Pd25,
+                     void const * _vsd );
+
 /* FD_R43X6_GE_SMUL_BASE(R,s) computes R = [s]B where B is the base
    curve point.  s points to a 32-byte memory region holding a little
    endian uint256 scalar in [0,2^255).  In-place operation fine.  The
@@ -433,6 +461,30 @@ fd_r43x6_ge_dmul_sparse( wwl_t * _R03, wwl_t * _R14, wwl_t * _R25,
                          void const * _vk,
                          wwl_t    A03, wwl_t    A14, wwl_t    A25 ); /* vartime */
 
+/* FD_R43X6_GE_DMUL2_VARTIME(Ra,sa,ka,Aa, Rb,sb,kb,Ab) does:
+
+     FD_R43X6_GE_DMUL_VARTIME( Ra,sa,ka,Aa );
+     FD_R43X6_GE_DMUL_VARTIME( Rb,sb,kb,Ab );
+
+   but faster. */
+
+#define FD_R43X6_GE_DMUL2_VARTIME(Ra,sa,ka,Aa, Rb,sb,kb,Ab) do {                  \
+    FD_R43X6_QUAD_DECL( _Ra ); FD_R43X6_QUAD_DECL( _Rb );                         \
+    fd_r43x6_ge_dmul_sparse2( &_Ra03,&_Ra14,&_Ra25, (sa), (ka), Aa##03,Aa##14,Aa##25, \
+                              &_Rb03,&_Rb14,&_Rb25, (sb), (kb), Ab##03,Ab##14,Ab##25 ); \
+    FD_R43X6_QUAD_MOV( Ra, _Ra ); FD_R43X6_QUAD_MOV( Rb, _Rb );                   \
+  } while(0)
+
+void
+fd_r43x6_ge_dmul_sparse2( wwl_t * _Ra03, wwl_t * _Ra14, wwl_t * _Ra25,
+                          void const * _vsa,
+                          void const * _vka,
+                          wwl_t    Aa03, wwl_t    Aa14, wwl_t    Aa25,
+                          wwl_t * _Rb03, wwl_t * _Rb14, wwl_t * _Rb25,
+                          void const * _vsb,
+                          void const * _vkb,
+                          wwl_t    Ab03, wwl_t    Ab14, wwl_t    Ab25 ); /* vartime */
+
 /* fd_r43x6_ge_sparse_table computes a table of odd scalar multiples of
    P stores them in table.  Given a w in [-max,max], the 3 wwl_t's
    holding the FD_R43X6_QUAD for [w]P will start at table index:
@@ -100,6 +100,37 @@ fd_ed25519_verify( void const *  msg,
                    void const *  public_key,
                    fd_sha512_t * sha );
 
+/* fd_ed25519_verify_batch verifies a batch of batch_cnt independent
+   (message, signature, public key) triples according to the ED25519
+   standard.  msg[i], sz[i], sig[i] and public_key[i] have the same
+   meaning as the corresponding fd_ed25519_verify arguments for the i-th
+   triple.  A message may appear in more than one triple (e.g. all the
+   signatures of a transaction).
+
+   sha is a handle of a local join to a sha512 calculator.
+
+   On return, err[i] holds the result of verifying the i-th triple.
+   This is exactly what fd_ed25519_verify would return for that triple
+   (the batch does not relax or tighten any check).  Returns
+   FD_ED25519_SUCCESS if all triples verified successfully and the
+   err[i] with the lowest i that failed otherwise.  Implementations
+   interleave the work of multiple triples (including the SHA-512
+   hashing of the triples, see fd_sha512_batch) to verify them at a
+   higher throughput than individual fd_ed25519_verify calls.
+
+   Does no input argument checking.  The caller takes a write interest
+   in sha and err and a read interest in the other arguments and the
+   regions they point to for the duration of the call. */
+
+int
+fd_ed25519_verify_batch( void const * const * msg,
+                         ulong const *        sz,
+                         void const * const * sig,
+                         void const * const * public_key,
+                         fd_sha512_t *        sha,
+                         ulong                batch_cnt,
+                         int *                err );
+
 /* fd_ed25519_verify_batch_single_msg verifies a batch of signatures
    over a single message, according to the ED25519 standard.
 
@@ -119,7 +150,9 @@ fd_ed25519_verify( void const *  msg,
    batch_sz is the size of signatures, pubkeys and shas.
    batch_sz must be greater than zero.
 
-   See fd_ed25519_verify for more details. */
+   Returns FD_ED25519_SUCCESS if all signatures verified and the error
+   code of the first failing signature otherwise.  See
+   fd_ed25519_verify_batch for more details. */
 
 int
 fd_ed25519_verify_batch_single_msg( uchar const   msg[], /* msg_sz */
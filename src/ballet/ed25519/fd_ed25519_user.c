@@ -284,15 +284,21 @@ int fd_ed25519_verify_batch_single_msg( uchar const   msg[], /* msg_sz */
     return FD_ED25519_ERR_SIG;
   }
 
-  /* native */
-  for( uchar i=0; i<batch_sz; i++ ) {
-    int res = fd_ed25519_verify( msg, msg_sz, &signatures[ i*64 ], &pubkeys[ i*32 ], shas[i] );
-    if( FD_UNLIKELY( res != FD_ED25519_SUCCESS ) ) {
-      return res;
-    }
+  if( FD_LIKELY( batch_sz==1 ) ) return fd_ed25519_verify( msg, msg_sz, signatures, pubkeys, shas[0] );
+
+  void const * msgs[ UCHAR_MAX ];
+  ulong        szs [ UCHAR_MAX ];
+  void const * sigs[ UCHAR_MAX ];
+  void const * pks [ UCHAR_MAX ];
+  int          errs[ UCHAR_MAX ];
+  for( ulong i=0UL; i<batch_sz; i++ ) {
+    msgs[i] = msg;
+    szs [i] = msg_sz;
+    sigs[i] = &signatures[ i*64UL ];
+    pks [i] = &pubkeys   [ i*32UL ];
   }
 
-  return FD_ED25519_SUCCESS;
+  return fd_ed25519_verify_batch( msgs, szs, sigs, pks, shas[0], batch_sz, errs );
 }
 
 /**********************************************************************/
@@ -460,6 +466,22 @@ fd_ed25519_verify( void const *  msg,
 # endif
 }
 
+int
+fd_ed25519_verify_batch( void const * const * msg,
+                         ulong const *        sz,
+                         void const * const * sig,
+                         void const * const * public_key,
+                         fd_sha512_t *        sha,
+                         ulong                batch_cnt,
+                         int *                err ) {
+  int res = FD_ED25519_SUCCESS;
+  for( ulong i=0UL; i<batch_cnt; i++ ) {
+    err[i] = fd_ed25519_verify( msg[i], sz[i], sig[i], public_key[i], sha );
+    if( FD_UNLIKELY( err[i] ) && !res ) res = err[i];
+  }
+  return res;
+}
+
 #else /* AVX512 implementation */
 
 /* Note: direct quotes from RFC 8032 are indicated by '//' style
@@ -630,6 +652,27 @@ fd_ed25519_sign( void *        R,
   return R;
 }
 
+/* fd_ed25519_scalar_is_canonical returns 1 if the little endian
+   uint256 pointed to by s is in [0,L) and 0 otherwise.  Variable time.
+   (We probably could make it faster and constant time with some clever
+   vectorization.)
+
+   Section 5.1: L is 2^252 + 27742317777372353535851937790883648493
+
+   L is its little endian representation as 4 little endian ulongs. */
+
+static inline int
+fd_ed25519_scalar_is_canonical( uchar const * s ) {
+  static ulong const L[4] = { 6346243789798364141UL, 1503914060200516822UL, 0L, 1152921504606846976UL };
+  ulong S[4] __attribute__((aligned(32)));
+  memcpy( S, s, 32UL ); /* Guarantee S[*] is aligned (hopefully elided into an AVX copy) */
+  for( int i=3; i>=0; i-- ) {
+    if( FD_LIKELY  ( S[i]<L[i] ) ) return 1;
+    if( FD_UNLIKELY( S[i]>L[i] ) ) return 0;
+  }
+  return 0;
+}
+
 int
 fd_ed25519_verify( void const *  M,
                    ulong         sz,
@@ -654,22 +697,9 @@ fd_ed25519_verify( void const *  M,
   /* Since it's public, we can do the S check in variable time and we
      can also do it before the decodes.  This is useful because it is
      much cheaper to fail a bad S now than do (expensive and successful)
-     decodes of R and Aprime and fail L afterward.  (We probably could
-     make it faster and constant time with some clever vectorization.)
+     decodes of R and Aprime and fail L afterward. */
 
-     Section 5.1: L is 2^252 + 27742317777372353535851937790883648493
-
-     L is its little endian representation as 4 little endian ulongs. */
-
-  static ulong const L[4] = { 6346243789798364141UL, 1503914060200516822UL, 0L, 1152921504606846976UL };
-  ulong S[4] __attribute__((aligned(32)));
-  memcpy( S, s, 32UL ); /* Guarantee S[*] is aligned (hopefully elided into an AVX copy) */
-  int i;
-  for( i=3; i>=0; i-- ) {
-    if( FD_LIKELY  ( S[i]<L[i] ) ) break;
-    if( FD_UNLIKELY( S[i]>L[i] ) ) return FD_ED25519_ERR_SIG;
-  }
-  if( FD_UNLIKELY( i<0 ) ) return FD_ED25519_ERR_SIG;
+  if( FD_UNLIKELY( !fd_ed25519_scalar_is_canonical( s ) ) ) return FD_ED25519_ERR_SIG;
 
   FD_R43X6_QUAD_DECL( Aprime );
   FD_R43X6_QUAD_DECL( R      );
@@ -714,7 +744,7 @@ fd_ed25519_verify( void const *  M,
   FD_R43X6_QUAD_DECL( SBprime );
 
   /* TODO: run these in parallel for more ILP? */
-  FD_R43X6_GE_SMUL_BASE_VARTIME( SB,      S );                /* SB      = [S]B,                in u44|u44|u44|u44 */
+  FD_R43X6_GE_SMUL_BASE_VARTIME( SB,      s );                /* SB      = [S]B,                in u44|u44|u44|u44 */
   FD_R43X6_GE_FMA_VARTIME      ( SBprime, k,Aprime, R );      /* SBprime = R + [k]Aprime',      in u44|u44|u44|u44 */
 
   if( FD_UNLIKELY( !FD_R43X6_GE_IS_EQ( SBprime, SB ) ) ) return FD_ED25519_ERR_MSG;
@@ -732,7 +762,7 @@ fd_ed25519_verify( void const *  M,
   Z03 = wwl_zero(); Z14 = wwl_zero(); Z25 = wwl_zero();              /* Z      = 0  |0  |0  |0,   in u44|u44|u44|u44 */
   FD_R43X6_QUAD_LANE_SUB_FAST( Rprime, Aprime, 1,0,0,1, Z, Aprime ); /* Rprime = -A'              in s44|u44|u44|s44 */
   FD_R43X6_QUAD_FOLD_SIGNED  ( Rprime, Rprime );                     /* Rprime = -A'              in u44|u44|u44|u44 */
-  FD_R43X6_GE_DMUL_VARTIME   ( Rprime, S, k, Rprime );               /* Rprime = [S]B - [k]A',    in u44|u44|u44|u44 */
+  FD_R43X6_GE_DMUL_VARTIME   ( Rprime, s, k, Rprime );               /* Rprime = [S]B - [k]A',    in u44|u44|u44|u44 */
 
   if( FD_UNLIKELY( !FD_R43X6_GE_IS_EQ( Rprime, R ) ) ) return FD_ED25519_ERR_MSG;
 
@@ -741,6 +771,143 @@ fd_ed25519_verify( void const *  M,
   return FD_ED25519_SUCCESS;
 }
 
+/* FD_ED25519_PRIVATE_BATCH_{LANE_CNT,HASH_SZ_MAX} configure how
+   fd_ed25519_verify_batch computes k=SHA-512(R||A||M).  Signatures are
+   processed in groups of LANE_CNT (even) and the hashes of a group are
+   computed in parallel with the fd_sha512_batch API.  As that API takes
+   contiguous inputs, R||A||M is first assembled on the stack, which
+   limits the lane hashed inputs to HASH_SZ_MAX bytes (the preimages of
+   transaction signatures fit comfortably).  Larger inputs are hashed
+   serially with sha. */
+
+#define FD_ED25519_PRIVATE_BATCH_LANE_CNT    (8UL)
+#define FD_ED25519_PRIVATE_BATCH_HASH_SZ_MAX (2048UL)
+
+/* fd_ed25519_private_verify_pair verifies signatures a and b (see
+   fd_ed25519_verify_batch below).  ka and kb point to SHA-512(R||A||M)
+   of each signature and are clobbered. */
+
+static void
+fd_ed25519_private_verify_pair( void const *  Ma,
+                                ulong         sza,
+                                void const *  siga,
+                                void const *  Aa_,
+                                uchar *       ka,
+                                int *         erra,
+                                void const *  Mb,
+                                ulong         szb,
+                                void const *  sigb,
+                                void const *  Ab_,
+                                uchar *       kb,
+                                int *         errb,
+                                fd_sha512_t * sha ) {
+
+  uchar const * ra = (uchar const *)siga;                            uchar const * rb = (uchar const *)sigb;
+  uchar const * sa = ra + 32;                                        uchar const * sb = rb + 32;
+
+  int ok = fd_ed25519_scalar_is_canonical( sa ) & fd_ed25519_scalar_is_canonical( sb );
+
+  FD_R43X6_QUAD_DECL( Aa ); FD_R43X6_QUAD_DECL( Ra );                FD_R43X6_QUAD_DECL( Ab ); FD_R43X6_QUAD_DECL( Rb );
+  if( FD_LIKELY( ok ) ) {
+    ok = !FD_R43X6_GE_DECODE4( Aa,Aa_, Ra,ra, Ab,Ab_, Rb,rb );
+    ok = ok && !( FD_R43X6_GE_IS_SMALL_ORDER( Aa ) | FD_R43X6_GE_IS_SMALL_ORDER( Ra ) |
+                  FD_R43X6_GE_IS_SMALL_ORDER( Ab ) | FD_R43X6_GE_IS_SMALL_ORDER( Rb ) );
+  }
+
+  if( FD_UNLIKELY( !ok ) ) {
+    *erra = fd_ed25519_verify( Ma, sza, siga, Aa_, sha );
+    *errb = fd_ed25519_verify( Mb, szb, sigb, Ab_, sha );
+    return;
+  }
+
+  fd_ed25519_sc_reduce( ka, ka );                                    fd_ed25519_sc_reduce( kb, kb );
+
+  /* See fd_ed25519_verify above */
+
+  FD_R43X6_QUAD_DECL( Z ); Z03 = wwl_zero(); Z14 = wwl_zero(); Z25 = wwl_zero();
+  FD_R43X6_QUAD_DECL( Rpa );                                         FD_R43X6_QUAD_DECL( Rpb );
+  FD_R43X6_QUAD_LANE_SUB_FAST( Rpa, Aa, 1,0,0,1, Z, Aa );            FD_R43X6_QUAD_LANE_SUB_FAST( Rpb, Ab, 1,0,0,1, Z, Ab );
+  FD_R43X6_QUAD_FOLD_SIGNED  ( Rpa, Rpa );                           FD_R43X6_QUAD_FOLD_SIGNED  ( Rpb, Rpb );
+  FD_R43X6_GE_DMUL2_VARTIME  ( Rpa, sa, ka, Rpa,                     Rpb, sb, kb, Rpb );
+
+  *erra = FD_R43X6_GE_IS_EQ( Rpa, Ra ) ? FD_ED25519_SUCCESS : FD_ED25519_ERR_MSG;
+  *errb = FD_R43X6_GE_IS_EQ( Rpb, Rb ) ? FD_ED25519_SUCCESS : FD_ED25519_ERR_MSG;
+}
+
+int
+fd_ed25519_verify_batch( void const * const * M,
+                         ulong const *        sz,
+                         void const * const * sig,
+                         void const * const * A,
+                         fd_sha512_t *        sha,
+                         ulong                batch_cnt,
+                         int *                err ) {
+
+  /* Signatures are verified two at a time.  The four point decodes of
+     a pair run in the quad representation and the two double scalar
+     multiplications run in lockstep (these dominate the cost).  Each
+     signature is still checked on its own against exactly the same
+     cofactorless group equation as fd_ed25519_verify.  We don't use a
+     random linear combination of the group equations here: that only
+     gives the same answer as the individual checks when R and A' have
+     no small order component (a cofactored batch check accepts
+     signatures that fd_ed25519_verify rejects and a cofactorless batch
+     check can accept invalid signatures whose torsion components
+     cancel).
+
+     Any pair where either signature fails its S check, decode or small
+     order check (i.e. invalid signatures) is handed to
+     fd_ed25519_verify one signature at a time such that the error codes
+     match exactly. */
+
+# define LANE_CNT FD_ED25519_PRIVATE_BATCH_LANE_CNT
+# define PRE_MAX  FD_ED25519_PRIVATE_BATCH_HASH_SZ_MAX
+
+  uchar hash[ LANE_CNT ][ FD_SHA512_HASH_SZ ] __attribute__((aligned(64)));
+  uchar pre [ LANE_CNT ][ PRE_MAX           ] __attribute__((aligned(64)));
+  uchar _batch[ FD_SHA512_BATCH_FOOTPRINT ] __attribute__((aligned(FD_SHA512_BATCH_ALIGN)));
+
+  for( ulong i0=0UL; i0<batch_cnt; i0+=LANE_CNT ) {
+    ulong cnt = fd_ulong_min( batch_cnt-i0, LANE_CNT );
+
+    /* Compute k for the group */
+
+    fd_sha512_batch_t * batch = fd_sha512_batch_init( _batch );
+    for( ulong j=0UL; j<cnt; j++ ) {
+      ulong i = i0+j;
+      if( FD_LIKELY( sz[i]<=PRE_MAX-64UL ) ) {
+        fd_memcpy( pre[j],       sig[i], 32UL  );
+        fd_memcpy( pre[j]+32UL,  A  [i], 32UL  );
+        fd_memcpy( pre[j]+64UL,  M  [i], sz[i] );
+        fd_sha512_batch_add( batch, pre[j], 64UL+sz[i], hash[j] );
+      } else {
+        fd_sha512_fini( fd_sha512_append( fd_sha512_append( fd_sha512_append( fd_sha512_init( sha ),
+                        sig[i], 32UL ), A[i], 32UL ), M[i], sz[i] ), hash[j] );
+      }
+    }
+    fd_sha512_batch_fini( batch );
+
+    /* Verify the group pairwise */
+
+    ulong j = 0UL;
+    for( ; j+1UL<cnt; j+=2UL ) {
+      ulong ia = i0+j; ulong ib = ia+1UL;
+      fd_ed25519_private_verify_pair( M[ia], sz[ia], sig[ia], A[ia], hash[j    ], err+ia,
+                                      M[ib], sz[ib], sig[ib], A[ib], hash[j+1UL], err+ib, sha );
+    }
+    if( FD_UNLIKELY( j<cnt ) ) { /* Odd one out */
+      ulong i = i0+j;
+      err[i] = fd_ed25519_verify( M[i], sz[i], sig[i], A[i], sha );
+    }
+  }
+
+# undef PRE_MAX
+# undef LANE_CNT
+
+  for( ulong i=0UL; i<batch_cnt; i++ ) if( FD_UNLIKELY( err[i] ) ) return err[i];
+  return FD_ED25519_SUCCESS;
+}
+
 #endif
 
 char const *
@@ -778,6 +778,116 @@ test_verify( fd_rng_t *    rng,
   }
 }
 
+static void
+test_verify_batch( fd_rng_t *    rng,
+                   fd_sha512_t * sha ) {
+
+# define BATCH_MAX (64UL)
+# define MSG_MAX   (4096UL)
+
+  static uchar msg[ BATCH_MAX ][ MSG_MAX ];
+  uchar        pub[ BATCH_MAX ][  32 ];
+  uchar        sig[ BATCH_MAX ][  64 ];
+  uchar        prv[ 32 ];
+
+  void const * msgs[ BATCH_MAX ];
+  ulong        szs [ BATCH_MAX ];
+  void const * sigs[ BATCH_MAX ];
+  void const * pubs[ BATCH_MAX ];
+  int          errs[ BATCH_MAX ];
+
+  /* Encodings of the neutral point (small order), a y>=p (fails to
+     decode) and L (non-canonical S) */
+
+  static uchar const small_order[ 32 ] = { 1 };
+  static uchar const bad_y      [ 32 ] = { 0xee,0xff,0xff,0xff,0xff,0xff,0xff,0xff, 0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+                                           0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff, 0xff,0xff,0xff,0xff,0xff,0xff,0xff,0x7f };
+  static uchar const L          [ 32 ] = { 0xed,0xd3,0xf5,0x5c,0x1a,0x63,0x12,0x58, 0xd6,0x9c,0xf7,0xa2,0xde,0xf9,0xde,0x14,
+                                           0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x10 };
+
+  for( ulong iter=0UL; iter<2048UL; iter++ ) {
+    ulong batch_cnt = 1UL + fd_rng_ulong_roll( rng, BATCH_MAX );
+    for( ulong i=0UL; i<batch_cnt; i++ ) {
+      /* Mostly short messages, sometimes long enough to not be hashed
+         in the batch lanes */
+      ulong sz = fd_rng_ulong_roll( rng, (fd_rng_uint( rng ) & 7U) ? 257UL : (MSG_MAX+1UL) );
+      for( ulong b=0UL; b<sz; b++ ) msg[i][b] = fd_rng_uchar( rng );
+      fd_ed25519_public_from_private( pub[i], fd_rng_b256( rng, prv ), sha );
+      fd_ed25519_sign( sig[i], msg[i], sz, pub[i], prv, sha );
+
+      uint r = fd_rng_uint( rng );
+      switch( r & 15U ) {
+      case 0U: sig[i][ fd_rng_ulong_roll( rng, 64UL  ) ] ^= (uchar)(1U<<(r>>29)); break;
+      case 1U: if( sz ) msg[i][ fd_rng_ulong_roll( rng, sz ) ] ^= (uchar)(1U<<(r>>29)); break;
+      case 2U: pub[i][ fd_rng_ulong_roll( rng, 32UL  ) ] ^= (uchar)(1U<<(r>>29)); break;
+      case 3U: fd_memcpy( pub[i],      small_order, 32UL ); break;
+      case 4U: fd_memcpy( sig[i],      small_order, 32UL ); break;
+      case 5U: fd_memcpy( pub[i],      bad_y,       32UL ); break;
+      case 6U: fd_memcpy( sig[i],      bad_y,       32UL ); break;
+      case 7U: fd_memcpy( sig[i]+32UL, L,           32UL ); break;
+      default: break; /* Good signature */
+      }
+
+      msgs[i] = msg[i]; szs[i] = sz; sigs[i] = sig[i]; pubs[i] = pub[i];
+      errs[i] = 1; /* Not a valid error code */
+    }
+
+    int res = fd_ed25519_verify_batch( msgs, szs, sigs, pubs, sha, batch_cnt, errs );
+
+    int exp_res = FD_ED25519_SUCCESS;
+    for( ulong i=0UL; i<batch_cnt; i++ ) {
+      int exp_err = fd_ed25519_verify( msgs[i], szs[i], sigs[i], pubs[i], sha );
+      FD_TEST( errs[i]==exp_err );
+      if( exp_err && !exp_res ) exp_res = exp_err;
+    }
+    FD_TEST( res==exp_res );
+  }
+
+  /* Signatures over a single message */
+
+  for( ulong iter=0UL; iter<256UL; iter++ ) {
+    ulong sz = fd_rng_ulong_roll( rng, 257UL );
+    for( ulong b=0UL; b<sz; b++ ) msg[0][b] = fd_rng_uchar( rng );
+    uchar batch_sz = (uchar)(1UL + fd_rng_ulong_roll( rng, 12UL ));
+    uchar sig_cat[ 12*64 ];
+    uchar pub_cat[ 12*32 ];
+    fd_sha512_t * shas[ 12 ];
+    for( ulong i=0UL; i<batch_sz; i++ ) {
+      fd_ed25519_public_from_private( pub_cat + i*32UL, fd_rng_b256( rng, prv ), sha );
+      fd_ed25519_sign( sig_cat + i*64UL, msg[0], sz, pub_cat + i*32UL, prv, sha );
+      shas[i] = sha;
+    }
+    FD_TEST( fd_ed25519_verify_batch_single_msg( msg[0], sz, sig_cat, pub_cat, shas, batch_sz )==FD_ED25519_SUCCESS );
+    ulong bad = fd_rng_ulong_roll( rng, batch_sz );
+    sig_cat[ bad*64UL + 63UL ] ^= (uchar)0x80; /* S >= 2^255 */
+    FD_TEST( fd_ed25519_verify_batch_single_msg( msg[0], sz, sig_cat, pub_cat, shas, batch_sz )==FD_ED25519_ERR_SIG );
+  }
+
+  /* Benchmark good signatures */
+
+  for( ulong i=0UL; i<BATCH_MAX; i++ ) {
+    for( ulong b=0UL; b<128UL; b++ ) msg[i][b] = fd_rng_uchar( rng );
+    fd_ed25519_public_from_private( pub[i], fd_rng_b256( rng, prv ), sha );
+    fd_ed25519_sign( sig[i], msg[i], 128UL, pub[i], prv, sha );
+    msgs[i] = msg[i]; szs[i] = 128UL; sigs[i] = sig[i]; pubs[i] = pub[i];
+  }
+
+  for( ulong batch_cnt=1UL; batch_cnt<=BATCH_MAX; batch_cnt<<=1 ) {
+    ulong iter = 65536UL / batch_cnt;
+    long dt = fd_log_wallclock();
+    for( ulong rem=iter; rem; rem-- ) {
+      FD_COMPILER_MFENCE(); FD_COMPILER_FORGET( sha );
+      FD_TEST( !fd_ed25519_verify_batch( msgs, szs, sigs, pubs, sha, batch_cnt, errs ) );
+    }
+    dt = fd_log_wallclock() - dt;
+    char cstr[128];
+    log_bench( fd_cstr_printf( cstr, 128UL, NULL, "fd_ed25519_verify_batch(%lu)", batch_cnt ), iter*batch_cnt, dt );
+  }
+
+# undef MSG_MAX
+# undef BATCH_MAX
+}
+
 /**********************************************************************/
 
 int
@@ -810,6 +920,7 @@ main( int     argc,
   test_public_from_private( rng, sha );
   test_sign               ( rng, sha );
   test_verify             ( rng, sha );
+  test_verify_batch       ( rng, sha );
 
   fd_sha512_delete( fd_sha512_leave( sha ) );
   fd_rng_delete( fd_rng_leave( rng ) );
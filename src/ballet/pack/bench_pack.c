@@ -0,0 +1,435 @@
+#include "../fd_ballet.h"
+#include "fd_pack.h"
+#include "fd_pack_cost.h"
+#include "fd_compute_budget_program.h"
+#include "../txn/fd_txn.h"
+#include "../../disco/metrics/fd_metrics.h"
+#include "../../util/net/fd_pcap.h"
+
+#if FD_HAS_HOSTED
+
+#include <stdio.h>
+
+/* bench_pack measures the scheduling performance and the scheduling
+   quality of fd_pack offline, without the rest of the validator.  It
+   replays a stream of transactions through fd_pack_insert_txn_fini and
+   fd_pack_schedule_next_microblock against a set of simulated bank
+   tiles, and reports how long pack took per transaction along with what
+   it managed to pack into each block.
+
+   The stream either comes from a pcap (--pcap) of UDP packets whose
+   payloads are serialized transactions, e.g. a capture of the TPU port,
+   or is generated synthetically.  Synthetic transactions arrive at a
+   constant rate (--tps), write 1-3 accounts and read 0-3 accounts drawn
+   from --acct-cnt accounts, except that each writable account is one of
+   --hot-acct-cnt hot accounts with probability --hot-frac, which is
+   what makes scheduling interesting.  They request an exponentially
+   distributed number of compute units and pay an exponentially
+   distributed compute unit price.
+
+   The benchmark runs a simulated clock.  Transactions are inserted when
+   the clock reaches their arrival time (the time relative to the first
+   packet for a pcap).  Whenever a simulated bank tile is idle, pack is
+   asked for a microblock for it, and the bank stays busy for
+   --ns-per-txn per transaction plus --ns-per-cu per compute unit in the
+   microblock before the microblock is reported complete.  Every 400ms
+   of simulated time the block ends (this node is assumed to be leader
+   for every slot) and the bank tiles finish what they have.  The
+   simulated clock is independent of how long the calls into pack
+   actually take, which is measured separately with the tickcounter, so
+   the results are reproducible for a given seed.
+
+   Addresses lookup tables, fee payer balances and blockhash expiry are
+   not simulated.  Like the pack tile, the benchmark gives pack no
+   lookup table snapshot, so transactions that load accounts from lookup
+   tables are accepted but never scheduled.  They are counted, and stay
+   pending until pack replaces them with higher priority transactions. */
+
+#define BLOCK_DURATION_NS (400L*1000L*1000L)
+
+#define BANK_MAX FD_PACK_MAX_BANK_TILES
+
+uchar metrics_scratch[ FD_METRICS_FOOTPRINT( 0, 0 ) ] __attribute__((aligned(FD_METRICS_ALIGN)));
+
+static char const * insert_result_name[ FD_PACK_INSERT_RETVAL_CNT ] = {
+  "reject_duplicate_acct",
+  "reject_expired",
+  "reject_addr_lut",
+  "reject_full",
+  "reject_writes_sysvar",
+  "reject_estimation_fail",
+  "reject_too_large",
+  "reject_unaffordable",
+  "reject_duplicate",
+  "reject_priority",
+  "accept_nonvote_add",
+  "accept_vote_add",
+  "accept_nonvote_replace",
+  "accept_vote_replace",
+};
+
+FD_STATIC_ASSERT( FD_PACK_INSERT_RETVAL_CNT==14UL, update_insert_result_name );
+
+/* A source of transactions, either a pcap or the synthetic generator. */
+
+struct txn_src {
+  fd_pcap_iter_t * pcap;
+  long             pcap_ts0;
+
+  fd_rng_t *       rng;
+  ulong            txn_idx;
+  long             ns_per_txn;   /* synthetic inter-arrival time */
+  ulong            acct_cnt;
+  ulong            hot_acct_cnt;
+  float            hot_frac;
+  float            cu_avg;
+  float            price_avg;    /* micro-lamports per compute unit */
+
+  /* The next transaction to arrive */
+  long             ts;
+  uchar            payload[ FD_TPU_MTU ];
+  ulong            payload_sz;
+};
+typedef struct txn_src txn_src_t;
+
+/* synth_acct writes the address of account idx in namespace tag to
+   out.  Account addresses only need to be distinct and must not be
+   mistaken for a sysvar or a builtin program, but pack hashes addresses
+   by their first bytes, so those need to look random. */
+
+static void
+synth_acct( uchar * out,
+            ulong   tag,
+            ulong   idx ) {
+  memset( out, 0xB7, FD_TXN_ACCT_ADDR_SZ );
+  FD_STORE( ulong, out,     fd_ulong_hash( (tag<<48) ^ idx ) );
+  FD_STORE( ulong, out+8UL,  idx                             );
+  FD_STORE( ulong, out+16UL, tag                             );
+}
+
+static int
+synth_next( txn_src_t * src ) {
+  fd_rng_t * rng = src->rng;
+  ulong      i   = src->txn_idx++;
+
+  ulong w_cnt = 1UL + fd_rng_ulong_roll( rng, 3UL );
+  ulong r_cnt =       fd_rng_ulong_roll( rng, 4UL );
+  ulong accts[ 6 ];
+  for( ulong j=0UL; j<w_cnt+r_cnt; j++ ) {
+    /* Draw distinct accounts, since a transaction that references an
+       account twice is invalid.  Redraws are always cold so that this
+       terminates even with very few hot accounts. */
+    int hot = (j<w_cnt) && (fd_rng_float_c( rng )<src->hot_frac);
+    for(;;) {
+      accts[ j ] = hot ? fd_rng_ulong_roll( rng, src->hot_acct_cnt ) : src->hot_acct_cnt + fd_rng_ulong_roll( rng, src->acct_cnt );
+      int dup = 0;
+      for( ulong k=0UL; k<j; k++ ) dup |= accts[ k ]==accts[ j ];
+      if( FD_LIKELY( !dup ) ) break;
+      hot = 0;
+    }
+  }
+
+  uint  cu    = (uint)fd_ulong_min( 1400000UL, 300UL + (ulong)(src->cu_avg   *fd_rng_float_exp( rng )) );
+  ulong price = (ulong)(src->price_avg*fd_rng_float_exp( rng ));
+
+  uchar * p = src->payload;
+  *(p++) = (uchar)1;                                                           /* signature cnt */
+  memset( p, 0, FD_TXN_SIGNATURE_SZ ); FD_STORE( ulong, p, i ); FD_STORE( ulong, p+8UL, FD_LOAD( ulong, p ) ^ 0x9e3779b97f4a7c15UL );
+  p += FD_TXN_SIGNATURE_SZ;
+  *(p++) = (uchar)1;                                                           /* signer cnt */
+  *(p++) = (uchar)0;                                                           /* readonly signed cnt */
+  *(p++) = (uchar)(r_cnt+2UL);                                                 /* readonly unsigned cnt */
+  *(p++) = (uchar)(1UL+w_cnt+r_cnt+2UL);                                       /* acct cnt */
+  synth_acct( p, 1UL, i );                                  p += FD_TXN_ACCT_ADDR_SZ; /* unique fee payer */
+  for( ulong j=0UL;     j<w_cnt;       j++ ) { synth_acct( p, 2UL, accts[ j ] ); p += FD_TXN_ACCT_ADDR_SZ; }
+  for( ulong j=w_cnt;   j<w_cnt+r_cnt; j++ ) { synth_acct( p, 2UL, accts[ j ] ); p += FD_TXN_ACCT_ADDR_SZ; }
+  fd_memcpy( p, FD_COMPUTE_BUDGET_PROGRAM_ID, FD_TXN_ACCT_ADDR_SZ ); p += FD_TXN_ACCT_ADDR_SZ;
+  synth_acct( p, 3UL, 0UL );                                p += FD_TXN_ACCT_ADDR_SZ; /* work program */
+  memset( p, 0x42, FD_TXN_ACCT_ADDR_SZ );                   p += FD_TXN_ACCT_ADDR_SZ; /* recent blockhash */
+
+  uchar cbp_idx  = (uchar)(1UL+w_cnt+r_cnt);
+  uchar work_idx = (uchar)(cbp_idx+1);
+  *(p++) = (uchar)3;                                                           /* instr cnt */
+  *(p++) = cbp_idx;  *(p++) = (uchar)0; *(p++) = (uchar)5; *(p++) = (uchar)2;  /* SetComputeUnitLimit */
+  FD_STORE( uint,  p, cu    ); p += sizeof(uint);
+  *(p++) = cbp_idx;  *(p++) = (uchar)0; *(p++) = (uchar)9; *(p++) = (uchar)3;  /* SetComputeUnitPrice */
+  FD_STORE( ulong, p, price ); p += sizeof(ulong);
+  *(p++) = work_idx; *(p++) = (uchar)w_cnt;                                    /* Work instruction */
+  for( ulong j=0UL; j<w_cnt; j++ ) *(p++) = (uchar)(1UL+j);
+  *(p++) = (uchar)0;
+
+  src->payload_sz = (ulong)(p-src->payload);
+  src->ts         = (long)i*src->ns_per_txn;
+  return 1;
+}
+
+static int
+pcap_next( txn_src_t * src ) {
+  uchar hdr[ 128 ];
+  for(;;) {
+    ulong hdr_sz = sizeof(hdr);
+    ulong pld_sz = sizeof(src->payload);
+    long  ts;
+    if( FD_UNLIKELY( !fd_pcap_iter_next_split( src->pcap, hdr, &hdr_sz, src->payload, &pld_sz, &ts ) ) ) return 0;
+    if( FD_UNLIKELY( !pld_sz ) ) continue;
+    if( FD_UNLIKELY( src->pcap_ts0==LONG_MAX ) ) src->pcap_ts0 = ts;
+    src->payload_sz = pld_sz;
+    src->ts         = ts - src->pcap_ts0;
+    return 1;
+  }
+}
+
+static inline int
+src_next( txn_src_t * src ) {
+  return src->pcap ? pcap_next( src ) : synth_next( src );
+}
+
+struct block_stats {
+  ulong txn_cnt;
+  ulong microblock_cnt;
+  ulong cus;
+  ulong fees;
+};
+typedef struct block_stats block_stats_t;
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz     = fd_env_strip_cmdline_cstr  ( &argc, &argv, "--page-sz",      NULL, "gigantic"                 );
+  ulong        page_cnt     = fd_env_strip_cmdline_ulong ( &argc, &argv, "--page-cnt",     NULL, 1UL                        );
+  ulong        numa_idx     = fd_env_strip_cmdline_ulong ( &argc, &argv, "--numa-idx",     NULL, fd_shmem_numa_idx( 0 )     );
+  char const * _pcap        = fd_env_strip_cmdline_cstr  ( &argc, &argv, "--pcap",         NULL, NULL                       );
+  ulong        pack_depth   = fd_env_strip_cmdline_ulong ( &argc, &argv, "--pack-depth",   NULL, 4096UL                     );
+  ulong        bank_cnt     = fd_env_strip_cmdline_ulong ( &argc, &argv, "--bank-cnt",     NULL, 4UL                        );
+  ulong        slot_cnt     = fd_env_strip_cmdline_ulong ( &argc, &argv, "--slot-cnt",     NULL, _pcap ? ULONG_MAX : 32UL   );
+  ulong        txn_per_mb   = fd_env_strip_cmdline_ulong ( &argc, &argv, "--txn-per-mb",   NULL, MAX_TXN_PER_MICROBLOCK     );
+  ulong        mb_per_block = fd_env_strip_cmdline_ulong ( &argc, &argv, "--mb-per-block", NULL, 817UL                      );
+  ulong        cus_per_mb   = fd_env_strip_cmdline_ulong ( &argc, &argv, "--cus-per-mb",   NULL, 1500000UL                  );
+  float        vote_frac    = fd_env_strip_cmdline_float ( &argc, &argv, "--vote-frac",    NULL, 0.75f                      );
+  float        ns_per_cu    = fd_env_strip_cmdline_float ( &argc, &argv, "--ns-per-cu",    NULL, 4.f                        );
+  long         ns_per_txn   = fd_env_strip_cmdline_long  ( &argc, &argv, "--ns-per-txn",   NULL, 20000L                     );
+  double       tps          = fd_env_strip_cmdline_double( &argc, &argv, "--tps",          NULL, 20000.                     );
+  ulong        acct_cnt     = fd_env_strip_cmdline_ulong ( &argc, &argv, "--acct-cnt",     NULL, 1000000UL                  );
+  ulong        hot_acct_cnt = fd_env_strip_cmdline_ulong ( &argc, &argv, "--hot-acct-cnt", NULL, 16UL                       );
+  float        hot_frac     = fd_env_strip_cmdline_float ( &argc, &argv, "--hot-frac",     NULL, 0.2f                       );
+  float        cu_avg       = fd_env_strip_cmdline_float ( &argc, &argv, "--cu-avg",       NULL, 20000.f                    );
+  float        price_avg    = fd_env_strip_cmdline_float ( &argc, &argv, "--price-avg",    NULL, 10000.f                    );
+  uint         seed         = fd_env_strip_cmdline_uint  ( &argc, &argv, "--seed",         NULL, 0U                         );
+
+  ulong page_sz = fd_cstr_to_shmem_page_sz( _page_sz );
+  if( FD_UNLIKELY( !page_sz                                ) ) FD_LOG_ERR(( "unsupported --page-sz" ));
+  if( FD_UNLIKELY( !bank_cnt || bank_cnt>BANK_MAX          ) ) FD_LOG_ERR(( "--bank-cnt must be in [1,%lu]", BANK_MAX ));
+  if( FD_UNLIKELY( !txn_per_mb || txn_per_mb>MAX_TXN_PER_MICROBLOCK ) ) FD_LOG_ERR(( "--txn-per-mb must be in [1,%lu]", MAX_TXN_PER_MICROBLOCK ));
+  if( FD_UNLIKELY( !(tps>0.) || !acct_cnt || !hot_acct_cnt ) ) FD_LOG_ERR(( "--tps, --acct-cnt and --hot-acct-cnt must be positive" ));
+
+  FD_LOG_NOTICE(( "Creating workspace with --page-cnt %lu --page-sz %s pages on --numa-idx %lu", page_cnt, _page_sz, numa_idx ));
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  fd_rng_t _rng[1];
+  fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, seed, 0UL ) );
+
+  fd_metrics_register( (ulong *)fd_metrics_new( metrics_scratch, 0UL, 0UL ) );
+
+  ulong footprint = fd_pack_footprint( pack_depth, bank_cnt, txn_per_mb, 0 );
+  if( FD_UNLIKELY( !footprint ) ) FD_LOG_ERR(( "invalid --pack-depth" ));
+  void * mem = fd_wksp_alloc_laddr( wksp, fd_pack_align(), footprint, 1UL );
+  if( FD_UNLIKELY( !mem ) ) FD_LOG_ERR(( "pack needs %lu bytes; increase --page-cnt", footprint ));
+  fd_pack_t * pack = fd_pack_join( fd_pack_new( mem, pack_depth, bank_cnt, txn_per_mb, 0, mb_per_block, rng ) );
+  FD_TEST( pack );
+
+  fd_txn_p_t * out = fd_wksp_alloc_laddr( wksp, alignof(fd_txn_p_t), txn_per_mb*sizeof(fd_txn_p_t), 1UL );
+  FD_TEST( out );
+
+  txn_src_t src[1];
+  memset( src, 0, sizeof(txn_src_t) );
+  FILE * file = NULL;
+  if( _pcap ) {
+    FD_LOG_NOTICE(( "Replaying --pcap %s", _pcap ));
+    file = fopen( _pcap, "r" );
+    if( FD_UNLIKELY( !file ) ) FD_LOG_ERR(( "fopen( %s ) failed", _pcap ));
+    src->pcap     = fd_pcap_iter_new( file );
+    src->pcap_ts0 = LONG_MAX;
+    if( FD_UNLIKELY( !src->pcap ) ) FD_LOG_ERR(( "fd_pcap_iter_new failed" ));
+  } else {
+    FD_LOG_NOTICE(( "Generating --tps %.0f --acct-cnt %lu --hot-acct-cnt %lu --hot-frac %.3f --cu-avg %.0f --price-avg %.0f",
+                    tps, acct_cnt, hot_acct_cnt, (double)hot_frac, (double)cu_avg, (double)price_avg ));
+    src->rng          = rng;
+    src->ns_per_txn   = fd_long_max( 1L, (long)(1e9/tps) );
+    src->acct_cnt     = acct_cnt;
+    src->hot_acct_cnt = hot_acct_cnt;
+    src->hot_frac     = hot_frac;
+    src->cu_avg       = cu_avg;
+    src->price_avg    = price_avg;
+  }
+  FD_LOG_NOTICE(( "Simulating --bank-cnt %lu --pack-depth %lu --slot-cnt %lu --ns-per-txn %li --ns-per-cu %.2f",
+                  bank_cnt, pack_depth, slot_cnt, ns_per_txn, (double)ns_per_cu ));
+
+  ulong insert_cnt[ FD_PACK_INSERT_RETVAL_CNT ] = { 0UL };
+  ulong parse_fail_cnt  = 0UL;
+  ulong alt_held_cnt    = 0UL; /* accepted, but load from lookup tables */
+  ulong insert_tot      = 0UL;
+  long  insert_ticks    = 0L;
+  ulong schedule_call   = 0UL; /* calls that returned a microblock */
+  long  schedule_ticks  = 0L;
+  ulong empty_call      = 0UL; /* calls that returned nothing */
+  long  empty_ticks     = 0L;
+
+  long  bank_busy_until[ BANK_MAX ];
+  int   bank_outstanding[ BANK_MAX ];
+  for( ulong i=0UL; i<bank_cnt; i++ ) { bank_busy_until[ i ] = 0L; bank_outstanding[ i ] = 0; }
+
+  block_stats_t tot[1]   = {{ 0UL }};
+  block_stats_t block[1] = {{ 0UL }};
+  ulong block_cnt      = 0UL;
+  ulong block_cus_min  = ULONG_MAX;
+  ulong block_cus_max  = 0UL;
+
+  long  wall0 = fd_log_wallclock();
+  long  tick0 = fd_tickcount();
+
+  long now       = 0L;
+  long block_end = BLOCK_DURATION_NS;
+  int  have_next = src_next( src );
+
+  while( block_cnt<slot_cnt ) {
+
+    /* Insert everything that has arrived */
+
+    while( have_next && src->ts<=now ) {
+      fd_txn_p_t * slot = fd_pack_insert_txn_init( pack );
+      fd_memcpy( slot->payload, src->payload, src->payload_sz );
+      slot->payload_sz = src->payload_sz;
+      if( FD_UNLIKELY( !fd_txn_parse( slot->payload, slot->payload_sz, TXN(slot), NULL ) ) ) {
+        fd_pack_insert_txn_cancel( pack, slot );
+        parse_fail_cnt++;
+      } else {
+        int  uses_alt = TXN(slot)->addr_table_adtl_cnt>0;
+        long t0 = fd_tickcount();
+        int  result = fd_pack_insert_txn_fini( pack, slot );
+        insert_ticks += fd_tickcount() - t0;
+        insert_cnt[ result + FD_PACK_INSERT_RETVAL_OFF ]++;
+        insert_tot++;
+        alt_held_cnt += (ulong)( uses_alt & (result>=0) );
+      }
+      have_next = src_next( src );
+    }
+
+    /* Hand a microblock to every idle bank */
+
+    for( ulong i=0UL; i<bank_cnt; i++ ) {
+      if( bank_busy_until[ i ]>now ) continue;
+      if( bank_outstanding[ i ] ) {
+        fd_pack_microblock_complete( pack, i );
+        bank_outstanding[ i ] = 0;
+      }
+
+      long  t0  = fd_tickcount();
+      ulong cnt = fd_pack_schedule_next_microblock( pack, cus_per_mb, vote_frac, i, out );
+      long  dt  = fd_tickcount() - t0;
+      if( !cnt ) { empty_ticks += dt; empty_call++; continue; }
+      schedule_ticks += dt;
+      schedule_call++;
+
+      ulong cus  = 0UL;
+      ulong fees = 0UL;
+      for( ulong j=0UL; j<cnt; j++ ) {
+        uint flags;
+        cus  += fd_pack_compute_cost( out+j, &flags );
+        fees += (ulong)out[ j ].fee;
+      }
+      block->txn_cnt        += cnt;
+      block->microblock_cnt += 1UL;
+      block->cus            += cus;
+      block->fees           += fees;
+
+      bank_busy_until[ i ]  = now + ns_per_txn*(long)cnt + (long)(ns_per_cu*(float)cus);
+      bank_outstanding[ i ] = 1;
+    }
+
+    /* Advance the clock to the next event */
+
+    long next = block_end;
+    if( have_next ) next = fd_long_min( next, src->ts );
+    for( ulong i=0UL; i<bank_cnt; i++ ) if( bank_outstanding[ i ] ) next = fd_long_min( next, bank_busy_until[ i ] );
+    now = fd_long_max( next, now+1L );
+
+    if( FD_UNLIKELY( now>=block_end ) ) {
+      for( ulong i=0UL; i<bank_cnt; i++ ) {
+        if( bank_outstanding[ i ] ) fd_pack_microblock_complete( pack, i );
+        bank_outstanding[ i ] = 0;
+        bank_busy_until[ i ]  = block_end;
+      }
+      fd_pack_end_block( pack );
+
+      tot->txn_cnt        += block->txn_cnt;
+      tot->microblock_cnt += block->microblock_cnt;
+      tot->cus            += block->cus;
+      tot->fees           += block->fees;
+      block_cus_min = fd_ulong_min( block_cus_min, block->cus );
+      block_cus_max = fd_ulong_max( block_cus_max, block->cus );
+      block_cnt++;
+
+      /* Once the input is exhausted, stop as soon as pack can't make
+         any more progress */
+      int done = !have_next && !block->txn_cnt;
+      memset( block, 0, sizeof(block_stats_t) );
+      if( done ) break;
+
+      now       = block_end;
+      block_end = block_end + BLOCK_DURATION_NS;
+    }
+  }
+
+  long tick1 = fd_tickcount();
+  long wall1 = fd_log_wallclock();
+  double ns_per_tick = (double)(wall1-wall0) / (double)fd_long_max( 1L, tick1-tick0 );
+
+  FD_LOG_NOTICE(( "simulated %lu blocks (%.3f s) in %.3f s of wallclock", block_cnt, 1e-9*(double)block_cnt*(double)BLOCK_DURATION_NS, 1e-9*(double)(wall1-wall0) ));
+
+  FD_LOG_NOTICE(( "inserted %lu transactions (%lu more failed to parse), %.1f ns/insert",
+                  insert_tot, parse_fail_cnt, ns_per_tick*(double)insert_ticks/(double)fd_ulong_max( 1UL, insert_tot ) ));
+  for( ulong i=0UL; i<FD_PACK_INSERT_RETVAL_CNT; i++ ) {
+    if( insert_cnt[ i ] ) FD_LOG_NOTICE(( "  %-24s %10lu", insert_result_name[ i ], insert_cnt[ i ] ));
+  }
+  if( alt_held_cnt ) FD_LOG_NOTICE(( "%lu accepted transactions load accounts from lookup tables and can't be scheduled", alt_held_cnt ));
+
+  ulong denom = fd_ulong_max( 1UL, block_cnt );
+  FD_LOG_NOTICE(( "scheduled %lu transactions in %lu microblocks, %.1f ns/scheduled txn, %.1f ns/microblock",
+                  tot->txn_cnt, schedule_call,
+                  ns_per_tick*(double)schedule_ticks/(double)fd_ulong_max( 1UL, tot->txn_cnt ),
+                  ns_per_tick*(double)schedule_ticks/(double)fd_ulong_max( 1UL, schedule_call ) ));
+  FD_LOG_NOTICE(( "%lu schedule calls returned nothing, %.1f ns/call",
+                  empty_call, ns_per_tick*(double)empty_ticks/(double)fd_ulong_max( 1UL, empty_call ) ));
+  FD_LOG_NOTICE(( "per block: %.1f txns, %.1f microblocks, %.0f CUs (min %lu, max %lu, limit %lu), %.0f lamports in fees",
+                  (double)tot->txn_cnt/(double)denom, (double)tot->microblock_cnt/(double)denom,
+                  (double)tot->cus/(double)denom, block_cnt ? block_cus_min : 0UL, block_cus_max, FD_PACK_MAX_COST_PER_BLOCK,
+                  (double)tot->fees/(double)denom ));
+  FD_LOG_NOTICE(( "skipped %lu times due to conflicts, hit the microblock limit %lu times, %lu transactions left pending",
+                  FD_MCNT_GET( PACK, TRANSACTION_SKIPPED ), FD_MCNT_GET( PACK, MICROBLOCK_PER_BLOCK_LIMIT ), fd_pack_avail_txn_cnt( pack ) ));
+
+  if( src->pcap ) fclose( fd_pcap_iter_delete( src->pcap ) );
+  fd_wksp_free_laddr( out );
+  fd_wksp_free_laddr( fd_pack_delete( fd_pack_leave( pack ) ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
@@ -53,6 +53,10 @@ struct fd_txn_p {
   ulong payload_sz;
   ulong meta;
   uint  flags; /* Populated by pack.  A combination of the bitfields FD_TXN_P_FLAGS_* defined above */
+  uint  alt_hash; /* Populated by pack.  For transactions that load accounts from address lookup tables, the
+                     fd_pack_alt_hash of the accounts pack resolved and checked for conflicts.  The bank must not
+                     execute the transaction if the accounts it loads hash differently.  0 otherwise. */
+  uint  fee; /* Populated by pack.  The fee in lamports pack expects the fee payer to pay for the transaction. */
   /* union {
     This would be ideal but doesn't work because of the flexible array member
     uchar _[FD_TXN_MAX_SZ];
@@ -39,6 +39,29 @@ struct fd_pack_private_ord_txn {
      store which tree.  This should be one of the FD_ORD_TXN_ROOT_*
      values. */
   int root;
+
+  /* acct_cat: The accounts pack tracks for this txn, FD_TXN_ACCT_CAT_ALL
+     normally.  If this txn loads accounts from address lookup tables
+     but pack has no snapshot to resolve them with, this is
+     FD_TXN_ACCT_CAT_IMM and the txn is never scheduled. */
+  int acct_cat;
+
+  /* expires_at: The height of the blockhash table at which this txn's
+     recent blockhash expires (see fd_pack_set_blockhash_tbl), or
+     ULONG_MAX if it never expires.  expq_{prev,next} are the pool
+     indices of the neighbors of this txn in the list of txns that
+     expire at the same height, or ULONG_MAX at the ends of the list. */
+  ulong expires_at;
+  ulong expq_prev;
+  ulong expq_next;
+
+  /* alt_accts: The accounts this txn loads from address lookup tables,
+     as resolved when it was inserted.  Indexed [0, addr_table_adtl_cnt),
+     where alt_accts[ i ] is the address of account acct_addr_cnt+i.
+     Points into the pack's alt_accts region, and is only valid if
+     acct_cat is FD_TXN_ACCT_CAT_ALL and the txn loads from lookup
+     tables. */
+  fd_acct_addr_t * alt_accts;
 };
 typedef struct fd_pack_private_ord_txn fd_pack_ord_txn_t;
 
@@ -53,6 +76,17 @@ FD_STATIC_ASSERT( offsetof( fd_txn_p_t,             payload )==0UL, fd_pack_ord_
 FD_STATIC_ASSERT( offsetof( fd_pack_ord_txn_t, txn->payload )==0UL, fd_pack_ord_txn_t );
 #endif
 
+/* fd_pack_ord_acct returns a pointer to the address of the account
+   with index idx in ord, which may come from an address lookup table.
+   imm points to the account addresses stored in the payload. */
+static inline fd_acct_addr_t const *
+fd_pack_ord_acct( fd_pack_ord_txn_t const * ord,
+                  fd_acct_addr_t const *    imm,
+                  ulong                     idx ) {
+  ulong imm_cnt = (ulong)TXN( ord->txn )->acct_addr_cnt;
+  return FD_LIKELY( idx<imm_cnt ) ? imm+idx : ord->alt_accts+(idx-imm_cnt);
+}
+
 #define FD_ORD_TXN_ROOT_FREE            0
 #define FD_ORD_TXN_ROOT_PENDING         1
 #define FD_ORD_TXN_ROOT_PENDING_VOTE    2
@@ -61,14 +95,34 @@ FD_STATIC_ASSERT( offsetof( fd_pack_ord_txn_t, txn->payload )==0UL, fd_pack_ord_
 
 #define FD_PACK_IN_USE_WRITABLE (0x8000000000000000UL)
 
-/* fd_pack_addr_use_t: Used for two distinct purposes:
+/* FD_PACK_EXPQ_CNT: The number of buckets in the ring of buckets that
+   hold pending transactions by the height at which they expire.  A
+   transaction expires at most FD_PACK_MAX_BLOCKHASH_AGE+1 heights after
+   the current height, so each bucket holds transactions that expire at
+   the same height.  Must be a power of 2. */
+#define FD_PACK_EXPQ_CNT (256UL)
+
+/* FD_PACK_UNKNOWN_BLOCKHASH_AGE: The number of heights after which a
+   transaction whose recent blockhash isn't in the blockhash table
+   expires.  The table only learns about the blocks PoH is reset onto,
+   so a valid blockhash might be missing from it, e.g. because it is
+   from a block that hasn't been replayed yet or from a block PoH was
+   never reset onto.  We can't tell how old such a blockhash is, so we
+   conservatively treat it as the most recent one, which keeps the
+   transaction around at least as long as the runtime could accept it. */
+#define FD_PACK_UNKNOWN_BLOCKHASH_AGE (FD_PACK_MAX_BLOCKHASH_AGE+1UL)
+
+FD_STATIC_ASSERT( FD_PACK_MAX_BLOCKHASH_AGE+1UL<FD_PACK_EXPQ_CNT, expq_cnt );
+
+/* fd_pack_addr_use_t: Used for three distinct purposes:
     -  to record that an address is in use and can't be used again until
          certain microblocks finish execution
     -  to keep track of the cost of all transactions that write to the
          specified account.
+    -  to keep track of the fees paid by the specified fee payer.
    Making these separate structs might make it more clear, but then
-   they'd have identical shape and result in two fd_map_dynamic sets of
-   functions with identical code.  It doesn't seem like the compiler is
+   they'd have identical shape and result in several fd_map_dynamic sets
+   of functions with identical code.  It doesn't seem like the compiler is
    very good at merging code like that, so in order to reduce code
    bloat, we'll just combine them. */
 struct fd_pack_private_addr_use_record {
@@ -76,6 +130,7 @@ struct fd_pack_private_addr_use_record {
   union{
     ulong          in_use_by;  /* Bitmask indicating which banks */
     ulong          total_cost; /* In cost units/CUs */
+    ulong          fees_paid;  /* In lamports */
   };
 };
 typedef struct fd_pack_private_addr_use_record fd_pack_addr_use_t;
@@ -247,6 +302,7 @@ struct fd_pack_private {
   ulong      bank_tile_cnt;
   ulong      max_txn_per_microblock;
   ulong      max_microblocks_per_block;
+  int        enable_alt;
 
   ulong      pending_txn_cnt;
   ulong      microblock_cnt; /* How many microblocks have we
@@ -308,6 +364,36 @@ struct fd_pack_private {
   fd_pack_addr_use_t   * writer_costs;
   fd_pack_sig_to_txn_t * signature_map; /* Stores pointers into pool for deleting by signature */
 
+  /* alt: The address lookup table snapshot used to resolve accounts
+     loaded from lookup tables when transactions are inserted.  Set by
+     the user with fd_pack_set_alt.  May be NULL.  alt_accts holds
+     FD_TXN_ACCT_ADDR_MAX resolved accounts per pool element, or is NULL
+     if the pack was created without enable_alt, in which case alt is
+     always NULL. */
+  fd_pack_alt_t const  * alt;
+  fd_acct_addr_t       * alt_accts;
+
+  /* fee_cache: Upper bounds on the balances of fee payers, used to
+     reject transactions the fee payer can't afford.  Set by the user
+     with fd_pack_set_fee_cache.  May be NULL.  fees_paid tracks the
+     fees paid in the current block by the fee payers that fee_cache
+     knows about, so that a fee payer can't use the same balance to pay
+     for several transactions. */
+  fd_pack_fee_cache_t const * fee_cache;
+  fd_pack_addr_use_t        * fees_paid;
+
+  /* blockhash_tbl: The table of recent blockhashes used to determine
+     when pending transactions expire.  Set by the user with
+     fd_pack_set_blockhash_tbl.  May be NULL.  All transactions that
+     expire at or before expire_height have been deleted.  The remaining
+     transactions that expire are in the bucket
+     expq_head[ expires_at%FD_PACK_EXPQ_CNT ], a doubly linked list
+     threaded through the pool, where expires_at is in
+     (expire_height, expire_height+FD_PACK_EXPQ_CNT). */
+  fd_pack_blockhash_tbl_t const * blockhash_tbl;
+  ulong                           expire_height;
+  ulong                           expq_head[ FD_PACK_EXPQ_CNT ];
+
   /* use_by_bank: An array of size (max_txn_per_microblock *
      FD_TXN_ACCT_ADDR_MAX) for each banking tile.  Only the MSB of
      in_use_by is relevant.  Addressed use_by_bank[i][j] where i is in
@@ -333,10 +419,19 @@ struct fd_pack_private {
 
 typedef struct fd_pack_private fd_pack_t;
 
+/* fd_pack_alt_accts_footprint returns the size of the alt_accts region,
+   one set of resolved accounts for each element of the pool. */
+FD_FN_CONST static inline ulong
+fd_pack_alt_accts_footprint( ulong pack_depth,
+                             int   enable_alt ) {
+  return enable_alt ? (pack_depth+1UL)*FD_TXN_ACCT_ADDR_MAX*sizeof(fd_acct_addr_t) : 0UL;
+}
+
 ulong
 fd_pack_footprint( ulong pack_depth,
                    ulong bank_tile_cnt,
-                   ulong max_txn_per_microblock ) {
+                   ulong max_txn_per_microblock,
+                   int   enable_alt ) {
   if( FD_UNLIKELY( (bank_tile_cnt==0) | (bank_tile_cnt>FD_PACK_MAX_BANK_TILES) ) ) return 0UL;
 
   ulong l;
@@ -355,9 +450,11 @@ fd_pack_footprint( ulong pack_depth,
   l = FD_LAYOUT_APPEND( l, trp_pool_align (),  trp_pool_footprint ( pack_depth+1UL           ) ); /* pool           */
   l = FD_LAYOUT_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_uses_tbl_sz           ) ); /* acct_in_use    */
   l = FD_LAYOUT_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_max_txn               ) ); /* writer_costs   */
+  l = FD_LAYOUT_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_max_txn               ) ); /* fees_paid      */
   l = FD_LAYOUT_APPEND( l, sig2txn_align  (),  sig2txn_footprint  ( lg_depth                 ) ); /* signature_map  */
   l = FD_LAYOUT_APPEND( l, 32UL,               sizeof(fd_pack_addr_use_t)*max_acct_in_flight   ); /* use_by_bank    */
   l = FD_LAYOUT_APPEND( l, bitset_map_align(), bitset_map_footprint( lg_acct_in_trp          ) ); /* acct_to_bitset */
+  l = FD_LAYOUT_APPEND( l, 32UL,               fd_pack_alt_accts_footprint( pack_depth, enable_alt ) ); /* alt_accts */
   return FD_LAYOUT_FINI( l, FD_PACK_ALIGN );
 }
 
@@ -366,6 +463,7 @@ fd_pack_new( void *     mem,
              ulong      pack_depth,
              ulong      bank_tile_cnt,
              ulong      max_txn_per_microblock,
+             int        enable_alt,
              ulong      max_microblocks_per_block,
              fd_rng_t * rng                       ) {
 
@@ -386,20 +484,28 @@ fd_pack_new( void *     mem,
   void * _pool        = FD_SCRATCH_ALLOC_APPEND( l,  trp_pool_align(),    trp_pool_footprint ( pack_depth+1UL         ) );
   void * _uses        = FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(),   acct_uses_footprint( lg_uses_tbl_sz         ) );
   void * _writer_cost = FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(),   acct_uses_footprint( lg_max_txn             ) );
+  void * _fees_paid   = FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(),   acct_uses_footprint( lg_max_txn             ) );
   void * _sig_map     = FD_SCRATCH_ALLOC_APPEND( l,  sig2txn_align(),     sig2txn_footprint  ( lg_depth               ) );
   void * _use_by_bank = FD_SCRATCH_ALLOC_APPEND( l,  32UL,                sizeof(fd_pack_addr_use_t)*max_acct_in_flight );
   void * _acct_bitset = FD_SCRATCH_ALLOC_APPEND( l,  bitset_map_align(),  bitset_map_footprint( lg_acct_in_trp        ) );
+  /* */                 FD_SCRATCH_ALLOC_APPEND( l,  32UL,                fd_pack_alt_accts_footprint( pack_depth, enable_alt ) );
 
   pack->pack_depth                  = pack_depth;
   pack->bank_tile_cnt               = bank_tile_cnt;
   pack->max_txn_per_microblock      = max_txn_per_microblock;
   pack->max_microblocks_per_block   = max_microblocks_per_block;
+  pack->enable_alt                  = !!enable_alt;
   pack->pending_txn_cnt             = 0UL;
   pack->microblock_cnt              = 0UL;
   pack->rng                         = rng;
   pack->cumulative_block_cost       = 0UL;
   pack->cumulative_vote_cost        = 0UL;
   pack->outstanding_microblock_mask = 0UL;
+  pack->alt                         = NULL;
+  pack->fee_cache                   = NULL;
+  pack->blockhash_tbl               = NULL;
+  pack->expire_height               = 0UL;
+  for( ulong i=0UL; i<FD_PACK_EXPQ_CNT; i++ ) pack->expq_head[ i ] = ULONG_MAX;
 
 
   trp_pool_new(  _pool,        pack_depth+1UL );
@@ -419,6 +525,7 @@ fd_pack_new( void *     mem,
 
   acct_uses_new( _uses,        lg_uses_tbl_sz );
   acct_uses_new( _writer_cost, lg_max_txn     );
+  acct_uses_new( _fees_paid,   lg_max_txn     );
   sig2txn_new(   _sig_map,     lg_depth       );
 
   fd_pack_addr_use_t * use_by_bank = (fd_pack_addr_use_t *)_use_by_bank;
@@ -460,9 +567,11 @@ fd_pack_join( void * mem ) {
   pack->pool          = trp_pool_join(   FD_SCRATCH_ALLOC_APPEND( l, trp_pool_align(),   trp_pool_footprint ( pack_depth+1UL ) ) );
   pack->acct_in_use   = acct_uses_join(  FD_SCRATCH_ALLOC_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_uses_tbl_sz ) ) );
   pack->writer_costs  = acct_uses_join(  FD_SCRATCH_ALLOC_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_max_txn     ) ) );
+  pack->fees_paid     = acct_uses_join(  FD_SCRATCH_ALLOC_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_max_txn     ) ) );
   pack->signature_map = sig2txn_join(    FD_SCRATCH_ALLOC_APPEND( l, sig2txn_align(),    sig2txn_footprint  ( lg_depth       ) ) );
   /* */                                  FD_SCRATCH_ALLOC_APPEND( l, 32UL,               sizeof(fd_pack_addr_use_t)*max_acct_in_flight );
   pack->acct_to_bitset= bitset_map_join( FD_SCRATCH_ALLOC_APPEND( l, bitset_map_align(), bitset_map_footprint( lg_acct_in_trp) ) );
+  pack->alt_accts     = pack->enable_alt ? FD_SCRATCH_ALLOC_APPEND( l, 32UL, fd_pack_alt_accts_footprint( pack_depth, 1 ) ) : NULL;
 
   FD_MGAUGE_SET( PACK, PENDING_TRANSACTIONS_HEAP_SIZE, pack_depth );
   return pack;
@@ -511,24 +620,100 @@ fd_pack_estimate_rewards_and_compute( fd_txn_p_t        * txnp,
   return 1;
 }
 
+/* fd_pack_live_fee_cache returns the fee cache of pack, or NULL if
+   there is none or it doesn't know about any fee payer, in which case
+   querying it would be a waste of a cache miss into a large table. */
+static inline fd_pack_fee_cache_t const *
+fd_pack_live_fee_cache( fd_pack_t const * pack ) {
+  fd_pack_fee_cache_t const * fee_cache = pack->fee_cache;
+  return ( fee_cache && !fd_pack_fee_cache_is_empty( fee_cache ) ) ? fee_cache : NULL;
+}
+
 /* Can the fee payer afford to pay a transaction with the specified
-   price?  Returns 1 if so, 0 otherwise.  This is just a stub that
-   always returns 1 for now.  In general, this function can't be totally
-   accurate, because the transactions immediately prior to this one can
-   affect the balance of this fee payer, but a simple check here may be
-   helpful for reducing spam. */
+   price, given its balance according to the fee cache and the fees it
+   has already paid for transactions scheduled in this block?  Returns
+   1 if so, 0 otherwise.  Fee payers the fee cache knows nothing about
+   are assumed to be able to afford anything.  In general, this function
+   can't be totally accurate, because the transactions immediately prior
+   to this one can affect the balance of this fee payer, but a simple
+   check here may be helpful for reducing spam.  fee_cache is the fee
+   cache to query, or NULL to skip the query (see
+   fd_pack_live_fee_cache).  If balance is non-NULL, stores the balance
+   according to the fee cache (or ULONG_MAX) there. */
 static int
-fd_pack_can_fee_payer_afford( fd_acct_addr_t const * acct_addr,
-                              ulong                  price /* in lamports */) {
-  (void)acct_addr;
-  (void)price;
-  return 1;
+fd_pack_can_fee_payer_afford( fd_pack_t const *           pack,
+                              fd_pack_fee_cache_t const * fee_cache,
+                              fd_acct_addr_t const *      acct_addr,
+                              ulong                       price, /* in lamports */
+                              ulong *                     balance ) {
+  ulong bal = fee_cache ? fd_pack_fee_cache_query( fee_cache, acct_addr ) : ULONG_MAX;
+  if( balance ) *balance = bal;
+  if( FD_LIKELY( bal==ULONG_MAX ) ) return 1;
+
+  fd_pack_addr_use_t * paid = acct_uses_query( pack->fees_paid, *acct_addr, NULL );
+  ulong spent = paid ? paid->fees_paid : 0UL;
+  return (spent<=bal) && (price<=bal-spent);
 }
 
+/* fd_pack_expq_{insert,remove} add ord to and remove it from the bucket
+   of transactions that expire at the same height, if it expires. */
+static inline void
+fd_pack_expq_insert( fd_pack_t         * pack,
+                     fd_pack_ord_txn_t * ord ) {
+  if( FD_LIKELY( ord->expires_at==ULONG_MAX ) ) return;
+  ulong * head = pack->expq_head + (ord->expires_at & (FD_PACK_EXPQ_CNT-1UL));
+  ulong   idx  = trp_pool_idx( pack->pool, ord );
+  ord->expq_prev = ULONG_MAX;
+  ord->expq_next = *head;
+  if( FD_LIKELY( *head!=ULONG_MAX ) ) pack->pool[ *head ].expq_prev = idx;
+  *head = idx;
+}
 
+static inline void
+fd_pack_expq_remove( fd_pack_t         * pack,
+                     fd_pack_ord_txn_t * ord ) {
+  if( FD_LIKELY( ord->expires_at==ULONG_MAX ) ) return;
+  ulong * head = pack->expq_head + (ord->expires_at & (FD_PACK_EXPQ_CNT-1UL));
+  if( FD_LIKELY( ord->expq_prev!=ULONG_MAX ) ) pack->pool[ ord->expq_prev ].expq_next = ord->expq_next;
+  else                                         *head                                  = ord->expq_next;
+  if( FD_LIKELY( ord->expq_next!=ULONG_MAX ) ) pack->pool[ ord->expq_next ].expq_prev = ord->expq_prev;
+}
 
 
 
+
+
+/* fd_pack_has_duplicate_acct returns 1 if ord references the same
+   account more than once among the accounts in its acct_cat category
+   and 0 otherwise.  The runtime fails such transactions with
+   AccountLoadedTwice, and pack's per-microblock account tracking
+   assumes each account appears at most once per transaction.  imm
+   points to the account addresses stored in the payload. */
+static int
+fd_pack_has_duplicate_acct( fd_pack_ord_txn_t const * ord,
+                            fd_acct_addr_t const *    imm ) {
+  /* Open addressing hash set of account indices+1, keyed by the first
+     8 bytes of the address, which are uniformly distributed for real
+     accounts.  Twice FD_TXN_ACCT_ADDR_MAX slots so it never fills. */
+# define SLOT_CNT (2UL*FD_TXN_ACCT_ADDR_MAX)
+  uchar slot[ SLOT_CNT ];
+  memset( slot, 0, SLOT_CNT );
+
+  fd_txn_t * txn = TXN( ord->txn );
+  fd_txn_acct_iter_t ctrl[1];
+  for( ulong i=fd_txn_acct_iter_init( txn, ord->acct_cat, ctrl ); i<fd_txn_acct_iter_end();
+      i=fd_txn_acct_iter_next( i, ctrl ) ) {
+    fd_acct_addr_t const * acct = fd_pack_ord_acct( ord, imm, i );
+    ulong j = FD_LOAD( ulong, acct->b ) & (SLOT_CNT-1UL);
+    for( ; slot[ j ]; j=(j+1UL) & (SLOT_CNT-1UL) ) {
+      if( FD_UNLIKELY( !memcmp( fd_pack_ord_acct( ord, imm, slot[ j ]-1UL ), acct, sizeof(fd_acct_addr_t) ) ) ) return 1;
+    }
+    slot[ j ] = (uchar)(i+1UL);
+  }
+  return 0;
+# undef SLOT_CNT
+}
+
 fd_txn_p_t * fd_pack_insert_txn_init(   fd_pack_t * pack                   ) { return trp_pool_ele_acquire( pack->pool )->txn; }
 void         fd_pack_insert_txn_cancel( fd_pack_t * pack, fd_txn_p_t * txn ) { trp_pool_ele_release( pack->pool, (fd_pack_ord_txn_t*)txn ); }
 
@@ -550,19 +735,38 @@ fd_pack_insert_txn_fini( fd_pack_t  * pack,
 
   if( FD_UNLIKELY( !fd_pack_estimate_rewards_and_compute( txnp, ord ) ) ) REJECT( ESTIMATION_FAIL );
 
+  /* Resolve the accounts loaded from address lookup tables so that
+     they are checked for conflicts like any other account.  Without a
+     snapshot, accept the transaction but only track its static
+     accounts, and never schedule it. */
+  txnp->alt_hash = 0U;
+  ord->acct_cat  = FD_TXN_ACCT_CAT_ALL;
+  if( FD_UNLIKELY( txn->addr_table_adtl_cnt>0UL ) ) {
+    if( FD_UNLIKELY( !pack->alt ) ) {
+      ord->acct_cat = FD_TXN_ACCT_CAT_IMM;
+    } else {
+      ord->alt_accts = pack->alt_accts + trp_pool_idx( pack->pool, ord )*FD_TXN_ACCT_ADDR_MAX;
+      if( FD_UNLIKELY( !fd_pack_alt_resolve( pack->alt, txn, payload, ord->alt_accts ) ) ) REJECT( ADDR_LUT );
+      ulong w_cnt = (ulong)txn->addr_table_adtl_writable_cnt;
+      txnp->alt_hash = fd_pack_alt_hash( ord->alt_accts,       w_cnt,
+                                         ord->alt_accts+w_cnt, (ulong)txn->addr_table_adtl_cnt-w_cnt );
+    }
+  }
+
+  if( FD_UNLIKELY( fd_pack_has_duplicate_acct( ord, accts ) ) ) REJECT( DUPLICATE_ACCT );
 
   fd_txn_acct_iter_t ctrl[1];
   int writes_to_sysvar = 0;
-  for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
+  for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & ord->acct_cat, ctrl ); i<fd_txn_acct_iter_end();
       i=fd_txn_acct_iter_next( i, ctrl ) ) {
-    writes_to_sysvar |= fd_pack_unwritable_contains( accts+i );
+    writes_to_sysvar |= fd_pack_unwritable_contains( fd_pack_ord_acct( ord, accts, i ) );
   }
 
   fd_ed25519_sig_t const * sig = fd_txn_get_signatures( txn, payload );
 
   /* Throw out transactions ... */
   /*           ... that are unfunded */
-  if( FD_UNLIKELY( !fd_pack_can_fee_payer_afford( accts, ord->rewards ) ) ) REJECT( UNAFFORDABLE  );
+  if( FD_UNLIKELY( !fd_pack_can_fee_payer_afford( pack, fd_pack_live_fee_cache( pack ), accts, ord->rewards, NULL ) ) ) REJECT( UNAFFORDABLE );
   /*           ... that are so big they'll never run */
   if( FD_UNLIKELY( ord->compute_est >= FD_PACK_MAX_COST_PER_BLOCK       ) ) REJECT( TOO_LARGE     );
   /*           ... that try to write to a sysvar */
@@ -570,7 +774,18 @@ fd_pack_insert_txn_fini( fd_pack_t  * pack,
   /*           ... that we already know about */
   if( FD_UNLIKELY( sig2txn_query( pack->signature_map, sig, NULL )      ) ) REJECT( DUPLICATE     );
 
-  /* TODO: Add recent blockhash based expiry here */
+  /*           ... whose recent blockhash has expired */
+  ord->expires_at = ULONG_MAX;
+  ulong height = pack->blockhash_tbl ? fd_pack_blockhash_tbl_height( pack->blockhash_tbl ) : 0UL;
+  if( FD_LIKELY( height ) ) {
+    /* Drop everything that expired before making room for this one, so
+       that expires_at lands in the range of live buckets. */
+    if( FD_UNLIKELY( height>pack->expire_height ) ) fd_pack_expire_before( pack, height );
+    ulong blockhash_height = fd_pack_blockhash_tbl_query( pack->blockhash_tbl, payload+txn->recent_blockhash_off );
+    ord->expires_at = fd_ulong_if( !!blockhash_height, blockhash_height+FD_PACK_MAX_BLOCKHASH_AGE+1UL,
+                                                       height          +FD_PACK_UNKNOWN_BLOCKHASH_AGE );
+    if( FD_UNLIKELY( ord->expires_at<=pack->expire_height ) ) REJECT( EXPIRED );
+  }
 
   int replaces = 0;
   if( FD_UNLIKELY( pack->pending_txn_cnt == pack->pack_depth ) ) {
@@ -600,11 +815,12 @@ fd_pack_insert_txn_fini( fd_pack_t  * pack,
   FD_PACK_BITSET_CLEAR( ord->rw_bitset );
   FD_PACK_BITSET_CLEAR( ord->w_bitset  );
 
-  for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
+  for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & ord->acct_cat, ctrl ); i<fd_txn_acct_iter_end();
       i=fd_txn_acct_iter_next( i, ctrl ) ) {
-    fd_pack_bitset_acct_mapping_t * q = bitset_map_query( pack->acct_to_bitset, accts[i], NULL );
+    fd_acct_addr_t const * acct = fd_pack_ord_acct( ord, accts, i );
+    fd_pack_bitset_acct_mapping_t * q = bitset_map_query( pack->acct_to_bitset, *acct, NULL );
     if( FD_UNLIKELY( q==NULL ) ) {
-      q = bitset_map_insert( pack->acct_to_bitset, accts[i] );
+      q = bitset_map_insert( pack->acct_to_bitset, *acct );
       q->ref_cnt                  = 0UL;
       q->first_instance           = ord;
       q->first_instance_was_write = 1;
@@ -622,13 +838,14 @@ fd_pack_insert_txn_fini( fd_pack_t  * pack,
     FD_PACK_BITSET_SETN( ord->w_bitset , q->bit );
   }
 
-  for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
+  for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY & ord->acct_cat, ctrl ); i<fd_txn_acct_iter_end();
       i=fd_txn_acct_iter_next( i, ctrl ) ) {
-    if( FD_UNLIKELY( fd_pack_unwritable_contains( accts+i ) ) ) continue;
+    fd_acct_addr_t const * acct = fd_pack_ord_acct( ord, accts, i );
+    if( FD_UNLIKELY( fd_pack_unwritable_contains( acct ) ) ) continue;
 
-    fd_pack_bitset_acct_mapping_t * q = bitset_map_query( pack->acct_to_bitset, accts[i], NULL );
+    fd_pack_bitset_acct_mapping_t * q = bitset_map_query( pack->acct_to_bitset, *acct, NULL );
     if( FD_UNLIKELY( q==NULL ) ) {
-      q = bitset_map_insert( pack->acct_to_bitset, accts[i] );
+      q = bitset_map_insert( pack->acct_to_bitset, *acct );
       q->ref_cnt                  = 0UL;
       q->first_instance           = ord;
       q->first_instance_was_write = 0;
@@ -648,6 +865,7 @@ fd_pack_insert_txn_fini( fd_pack_t  * pack,
   pack->pending_txn_cnt++;
 
   sig2txn_insert( pack->signature_map, fd_txn_get_signatures( txn, payload ) );
+  fd_pack_expq_insert( pack, ord );
 
   if( FD_LIKELY( ord->root == FD_ORD_TXN_ROOT_PENDING_VOTE ) ) {
     treap_ele_insert( pack->pending_votes, ord, pack->pool );
@@ -695,6 +913,10 @@ fd_pack_schedule_microblock_impl( fd_pack_t  * pack,
 
   ulong bank_tile_mask = 1UL << bank_tile;
 
+  /* Checked once per microblock.  Fee payers that enter the cache while
+     this microblock is scheduled are only considered by the next one. */
+  fd_pack_fee_cache_t const * fee_cache = fd_pack_live_fee_cache( pack );
+
   ulong fast_path = 0UL;
   ulong slow_path = 0UL;
   ulong cu_limit_c = 0UL;
@@ -714,6 +936,10 @@ fd_pack_schedule_microblock_impl( fd_pack_t  * pack,
     ulong conflicts = 0UL;
     int   delay_end_block = 0;
 
+    /* Its address lookup tables weren't resolved, so we don't know all
+       the accounts it uses. */
+    if( FD_UNLIKELY( cur->acct_cat!=FD_TXN_ACCT_CAT_ALL ) ) continue;
+
     if( FD_UNLIKELY( cur->compute_est>cu_limit ) ) {
       /* Too big to be scheduled at the moment, but might be okay for
          the next microblock, so we don't want to delay it. */
@@ -721,15 +947,11 @@ fd_pack_schedule_microblock_impl( fd_pack_t  * pack,
       continue;
     }
 
-    if( FD_UNLIKELY( txn->addr_table_adtl_cnt>0UL ) ) {
-      /* This transaction reads or writes to additional accounts from
-         an address lookup table.  We don't yet know what they are
-         so we can't check for conflicts and instead just never schedule
-         the transaction. 
-         
-         TODO: We should load the accounts here and check them for
-         conflicts properly.  The accounts can change with the bank so
-         it's non-trivial. */
+    ulong payer_balance;
+    if( FD_UNLIKELY( !fd_pack_can_fee_payer_afford( pack, fee_cache, acct, cur->rewards, &payer_balance ) ) ) {
+      /* The fee payer already spent its balance on other transactions
+         in this block.  It might get more lamports in the future, so
+         leave the transaction alone. */
       continue;
     }
 
@@ -737,10 +959,11 @@ fd_pack_schedule_microblock_impl( fd_pack_t  * pack,
       fd_txn_acct_iter_t ctrl[1];
       /* Check conflicts between this transaction's writable accounts and
          current readers */
-      for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
+      for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE, ctrl ); i<fd_txn_acct_iter_end();
           i=fd_txn_acct_iter_next( i, ctrl ) ) {
+        fd_acct_addr_t acct_addr = *fd_pack_ord_acct( cur, acct, i );
 
-        fd_pack_addr_use_t * in_wcost_table = acct_uses_query( writer_costs, acct[i], NULL );
+        fd_pack_addr_use_t * in_wcost_table = acct_uses_query( writer_costs, acct_addr, NULL );
         if( in_wcost_table && in_wcost_table->total_cost+cur->compute_est > FD_PACK_MAX_WRITE_COST_PER_ACCT ) {
           /* Can't be scheduled until the next block */
           conflicts = ULONG_MAX;
@@ -748,17 +971,18 @@ fd_pack_schedule_microblock_impl( fd_pack_t  * pack,
           break;
         }
 
-        fd_pack_addr_use_t * use = acct_uses_query( acct_in_use, acct[i], NULL );
+        fd_pack_addr_use_t * use = acct_uses_query( acct_in_use, acct_addr, NULL );
         if( use ) conflicts |= use->in_use_by; /* break? */
       }
 
       /* Check conflicts between this transaction's readonly accounts and
          current writers */
-      for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
+      for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY, ctrl ); i<fd_txn_acct_iter_end();
           i=fd_txn_acct_iter_next( i, ctrl ) ) {
-        if( fd_pack_unwritable_contains( acct+i ) ) continue; /* No need to track sysvars because they can't be writable */
+        fd_acct_addr_t const * acct_addr = fd_pack_ord_acct( cur, acct, i );
+        if( fd_pack_unwritable_contains( acct_addr ) ) continue; /* No need to track sysvars because they can't be writable */
 
-        fd_pack_addr_use_t * use = acct_uses_query( acct_in_use,  acct[i], NULL );
+        fd_pack_addr_use_t * use = acct_uses_query( acct_in_use, *acct_addr, NULL );
         if( use ) conflicts |= (use->in_use_by & FD_PACK_IN_USE_WRITABLE) ? use->in_use_by : 0UL;
       }
       slow_path++;
@@ -782,12 +1006,20 @@ fd_pack_schedule_microblock_impl( fd_pack_t  * pack,
       out->payload_sz = cur->txn->payload_sz;
       out->meta       = cur->txn->meta;
       out->flags      = cur->txn->flags;
+      out->alt_hash   = cur->txn->alt_hash;
+      out->fee        = cur->rewards;
       out++;
 
+      if( FD_UNLIKELY( payer_balance!=ULONG_MAX ) ) {
+        fd_pack_addr_use_t * paid = acct_uses_query( pack->fees_paid, acct[0], NULL );
+        if( !paid ) { paid = acct_uses_insert( pack->fees_paid, acct[0] );   paid->fees_paid = 0UL; }
+        paid->fees_paid += cur->rewards;
+      }
+
       fd_txn_acct_iter_t ctrl[1];
-      for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
+      for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE, ctrl ); i<fd_txn_acct_iter_end();
           i=fd_txn_acct_iter_next( i, ctrl ) ) {
-        fd_acct_addr_t acct_addr = acct[i];
+        fd_acct_addr_t acct_addr = *fd_pack_ord_acct( cur, acct, i );
 
         fd_pack_addr_use_t * in_wcost_table = acct_uses_query( writer_costs, acct_addr, NULL );
         if( !in_wcost_table ) { in_wcost_table = acct_uses_insert( writer_costs, acct_addr );   in_wcost_table->total_cost = 0UL; }
@@ -798,7 +1030,7 @@ fd_pack_schedule_microblock_impl( fd_pack_t  * pack,
 
         use_by_bank[use_by_bank_cnt++] = *use;
 
-        fd_pack_bitset_acct_mapping_t * q = bitset_map_query( pack->acct_to_bitset, acct[i], NULL );
+        fd_pack_bitset_acct_mapping_t * q = bitset_map_query( pack->acct_to_bitset, acct_addr, NULL );
         if( FD_UNLIKELY( !(--q->ref_cnt) ) ) {
           ushort bit = q->bit;
           bitset_map_remove( pack->acct_to_bitset, q );
@@ -812,11 +1044,11 @@ fd_pack_schedule_microblock_impl( fd_pack_t  * pack,
           if( FD_LIKELY( bit<FD_PACK_BITSET_MAX ) ) pack->bitset_avail[ ++(pack->bitset_avail_cnt) ] = bit;
         }
       }
-      for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
+      for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY, ctrl ); i<fd_txn_acct_iter_end();
           i=fd_txn_acct_iter_next( i, ctrl ) ) {
-        fd_acct_addr_t acct_addr = acct[i];
+        fd_acct_addr_t acct_addr = *fd_pack_ord_acct( cur, acct, i );
 
-        if( fd_pack_unwritable_contains( acct+i ) ) continue; /* No need to track sysvars because they can't be writable */
+        if( fd_pack_unwritable_contains( &acct_addr ) ) continue; /* No need to track sysvars because they can't be writable */
 
         fd_pack_addr_use_t * use = acct_uses_query( acct_in_use,  acct_addr, NULL );
         if( !use ) { use = acct_uses_insert( acct_in_use, acct_addr ); use->in_use_by = 0UL; }
@@ -824,7 +1056,7 @@ fd_pack_schedule_microblock_impl( fd_pack_t  * pack,
         if( !(use->in_use_by & bank_tile_mask) ) use_by_bank[use_by_bank_cnt++] = *use;
         use->in_use_by |= bank_tile_mask;
 
-        fd_pack_bitset_acct_mapping_t * q = bitset_map_query( pack->acct_to_bitset, acct[i], NULL );
+        fd_pack_bitset_acct_mapping_t * q = bitset_map_query( pack->acct_to_bitset, acct_addr, NULL );
         if( FD_UNLIKELY( !(--q->ref_cnt) ) ) {
           ushort bit = q->bit;
           bitset_map_remove( pack->acct_to_bitset, q );
@@ -839,6 +1071,7 @@ fd_pack_schedule_microblock_impl( fd_pack_t  * pack,
       fd_pack_sig_to_txn_t * in_tbl = sig2txn_query( pack->signature_map, sig0, NULL );
       sig2txn_remove( pack->signature_map, in_tbl );
 
+      fd_pack_expq_remove( pack, cur );
       treap_ele_remove( sched_from, cur, pool );
       trp_pool_ele_release( pool, cur );
       pack->pending_txn_cnt--;
@@ -976,6 +1209,19 @@ fd_pack_schedule_next_microblock( fd_pack_t *  pack,
   return scheduled;
 }
 
+void
+fd_pack_set_alt( fd_pack_t           * pack,
+                 fd_pack_alt_t const * alt ) {
+  if( FD_UNLIKELY( alt && !pack->alt_accts ) ) {
+    FD_LOG_WARNING(( "pack was created without enable_alt, ignoring address lookup table snapshot" ));
+    return;
+  }
+  pack->alt = alt;
+}
+
+void fd_pack_set_fee_cache( fd_pack_t * pack, fd_pack_fee_cache_t const * cache ) { pack->fee_cache = cache; }
+void fd_pack_set_blockhash_tbl( fd_pack_t * pack, fd_pack_blockhash_tbl_t const * tbl ) { pack->blockhash_tbl = tbl; }
+
 ulong fd_pack_avail_txn_cnt( fd_pack_t * pack ) { return pack->pending_txn_cnt; }
 ulong fd_pack_bank_tile_cnt( fd_pack_t * pack ) { return pack->bank_tile_cnt;   }
 
@@ -991,6 +1237,7 @@ fd_pack_end_block( fd_pack_t * pack ) {
 
   acct_uses_clear( pack->acct_in_use  );
   acct_uses_clear( pack->writer_costs );
+  acct_uses_clear( pack->fees_paid    );
 
   for( ulong i=0UL; i<pack->bank_tile_cnt; i++ ) pack->use_by_bank_cnt[i] = 0UL;
 
@@ -1029,9 +1276,12 @@ fd_pack_clear_all( fd_pack_t * pack ) {
 
   acct_uses_clear( pack->acct_in_use  );
   acct_uses_clear( pack->writer_costs );
+  acct_uses_clear( pack->fees_paid    );
 
   sig2txn_clear( pack->signature_map );
 
+  for( ulong i=0UL; i<FD_PACK_EXPQ_CNT; i++ ) pack->expq_head[ i ] = ULONG_MAX;
+
   FD_PACK_BITSET_CLEAR( pack->bitset_rw_in_use );
   FD_PACK_BITSET_CLEAR( pack->bitset_w_in_use  );
   bitset_map_clear( pack->acct_to_bitset );
@@ -1067,11 +1317,12 @@ fd_pack_delete_transaction( fd_pack_t              * pack,
   fd_txn_t * _txn = TXN( containing->txn );
   fd_acct_addr_t const * accts = fd_txn_get_acct_addrs( _txn, containing->txn->payload );
   fd_txn_acct_iter_t ctrl[1];
-  for( ulong i=fd_txn_acct_iter_init( _txn, FD_TXN_ACCT_CAT_READONLY & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
+  for( ulong i=fd_txn_acct_iter_init( _txn, containing->acct_cat, ctrl ); i<fd_txn_acct_iter_end();
       i=fd_txn_acct_iter_next( i, ctrl ) ) {
-    if( FD_UNLIKELY( fd_pack_unwritable_contains( accts+i ) ) ) continue;
+    fd_acct_addr_t const * acct = fd_pack_ord_acct( containing, accts, i );
+    if( FD_UNLIKELY( fd_pack_unwritable_contains( acct ) ) ) continue;
 
-    fd_pack_bitset_acct_mapping_t * q = bitset_map_query( pack->acct_to_bitset, accts[i], NULL );
+    fd_pack_bitset_acct_mapping_t * q = bitset_map_query( pack->acct_to_bitset, *acct, NULL );
     FD_TEST( q ); /* q==NULL not be possible */
 
     q->ref_cnt--;
@@ -1083,6 +1334,7 @@ fd_pack_delete_transaction( fd_pack_t              * pack,
       if( FD_LIKELY( bit<FD_PACK_BITSET_MAX ) ) pack->bitset_avail[ ++(pack->bitset_avail_cnt) ] = bit;
     }
   }
+  fd_pack_expq_remove( pack, containing );
   treap_ele_remove( root, containing, pack->pool );
   trp_pool_ele_release( pack->pool, containing );
   sig2txn_remove( pack->signature_map, in_tbl );
@@ -1091,6 +1343,31 @@ fd_pack_delete_transaction( fd_pack_t              * pack,
   return 1;
 }
 
+ulong
+fd_pack_expire_before( fd_pack_t * pack,
+                       ulong       height ) {
+  if( FD_UNLIKELY( height<=pack->expire_height ) ) return 0UL;
+
+  /* Every bucket holds transactions that expire at a single height in
+     (expire_height, expire_height+FD_PACK_EXPQ_CNT), so there's no need
+     to look at more than FD_PACK_EXPQ_CNT buckets. */
+  ulong end         = fd_ulong_min( height, pack->expire_height+FD_PACK_EXPQ_CNT-1UL );
+  ulong deleted_cnt = 0UL;
+  for( ulong h=pack->expire_height+1UL; h<=end; h++ ) {
+    ulong * head = pack->expq_head + (h & (FD_PACK_EXPQ_CNT-1UL));
+    while( *head!=ULONG_MAX ) {
+      fd_pack_ord_txn_t * ord = pack->pool + *head;
+      /* fd_pack_delete_transaction unlinks ord from the bucket */
+      FD_TEST( fd_pack_delete_transaction( pack, fd_txn_get_signatures( TXN( ord->txn ), ord->txn->payload ) ) );
+      deleted_cnt++;
+    }
+  }
+  pack->expire_height = height;
+
+  FD_MCNT_INC( PACK, TRANSACTION_EXPIRED, deleted_cnt );
+  return deleted_cnt;
+}
+
 
 void * fd_pack_leave ( fd_pack_t * pack ) { FD_COMPILER_MFENCE(); return (void *)pack; }
 void * fd_pack_delete( void      * mem  ) { FD_COMPILER_MFENCE(); return mem;          }
@@ -9,6 +9,9 @@
 #include "../txn/fd_txn.h"
 #include "fd_est_tbl.h"
 #include "fd_microblock.h"
+#include "fd_pack_alt.h"
+#include "fd_pack_fee_cache.h"
+#include "fd_pack_blockhash_tbl.h"
 
 #define FD_PACK_ALIGN     (128UL)
 
@@ -43,20 +46,28 @@ typedef struct fd_pack_private fd_pack_t;
    FD_PACK_MAX_BANK_TILES].
 
    max_txn_per_microblock sets the maximum number of transactions that
-   pack will schedule in a single microblock. */
+   pack will schedule in a single microblock.
+
+   enable_alt reserves room for the accounts that each pending
+   transaction loads from address lookup tables (FD_TXN_ACCT_ADDR_MAX
+   addresses, 4 KiB per transaction), which pack needs to schedule such
+   transactions.  It should only be set if the user will provide a
+   lookup table snapshot with fd_pack_set_alt. */
 
 FD_FN_CONST static inline ulong fd_pack_align       ( void ) { return FD_PACK_ALIGN; }
 
 FD_FN_CONST ulong
 fd_pack_footprint( ulong pack_depth,
                    ulong bank_tile_cnt,
-                   ulong max_txn_per_microblock );
+                   ulong max_txn_per_microblock,
+                   int   enable_alt );
 
 
 /* fd_pack_new formats a region of memory to be suitable for use as a
    pack object.  mem is a non-NULL pointer to a region of memory in the
    local address space with the required alignment and footprint.
-   pack_depth, bank_tile_cnt, and max_txn_per_microblock are as above.
+   pack_depth, bank_tile_cnt, max_txn_per_microblock, and enable_alt
+   are as above.
    The pack object will produce at most max_microblocks_per_block
    non-empty microblocks in a block.  rng is a local join to a random
    number generator used to perturb estimates.
@@ -66,7 +77,7 @@ fd_pack_footprint( ulong pack_depth,
    will not be joined to the pack object when this function returns. */
 void * fd_pack_new( void * mem,
     ulong pack_depth, ulong bank_tile_cnt, ulong max_txn_per_microblock,
-    ulong max_microblocks_per_block, fd_rng_t * rng );
+    int enable_alt, ulong max_microblocks_per_block, fd_rng_t * rng );
 
 /* fd_pack_join joins the caller to the pack object.  Every successful
    join should have a matching leave.  Returns mem. */
@@ -109,8 +120,10 @@ FD_FN_PURE ulong fd_pack_bank_tile_cnt( fd_pack_t * pack );
       lower than the worst currently accepted transaction.
     * DUPLICATE: the transaction is a duplicate of a currently accepted
       transaction.
-    * UNAFFORDABLE: the fee payer could not afford the transaction fee
-      (not yet implemented).
+    * UNAFFORDABLE: according to the fee cache set with
+      fd_pack_set_fee_cache, the fee payer could not afford the
+      transaction fee after paying for the transactions already
+      scheduled in this block.
     * TOO_LARGE: the transaction requested too many CUs and would never
       be scheduled if it had been accepted.
     * ESTIMATION_FAIL: estimation of the transaction's compute cost and
@@ -124,6 +137,15 @@ FD_FN_PURE ulong fd_pack_bank_tile_cnt( fd_pack_t * pack );
       able to accept a transaction regardless of its priority because a
       transaction cannot be found to be replaced.  This mostly can
       happen if the whole heap is full of votes.
+    * ADDR_LUT: the transaction loads accounts from an address lookup
+      table, and the table or the referenced index is not in the lookup
+      table snapshot set with fd_pack_set_alt.
+    * EXPIRED: according to the blockhash table set with
+      fd_pack_set_blockhash_tbl, the transaction's recent blockhash is
+      too old for the transaction to be executed.
+    * DUPLICATE_ACCT: the transaction references the same account more
+      than once, possibly via an address lookup table.  It would fail
+      with AccountLoadedTwice if executed.
 
     NOTE: The corresponding enum in metrics.xml must be kept in sync
     with any changes to these return values. */
@@ -138,12 +160,61 @@ FD_FN_PURE ulong fd_pack_bank_tile_cnt( fd_pack_t * pack );
 #define FD_PACK_INSERT_REJECT_ESTIMATION_FAIL (-5)
 #define FD_PACK_INSERT_REJECT_WRITES_SYSVAR   (-6)
 #define FD_PACK_INSERT_REJECT_FULL            (-7)
+#define FD_PACK_INSERT_REJECT_ADDR_LUT        (-8)
+#define FD_PACK_INSERT_REJECT_EXPIRED         (-9)
+#define FD_PACK_INSERT_REJECT_DUPLICATE_ACCT  (-10)
 
 /* The FD_PACK_INSERT_{ACCEPT, REJECT}_* values defined above are in the
    range [-FD_PACK_INSERT_RETVAL_OFF,
    -FD_PACK_INSERT_RETVAL_OFF+FD_PACK_INSERT_RETVAL_CNT ) */
-#define FD_PACK_INSERT_RETVAL_OFF  7
-#define FD_PACK_INSERT_RETVAL_CNT 11
+#define FD_PACK_INSERT_RETVAL_OFF 10
+#define FD_PACK_INSERT_RETVAL_CNT 14
+
+/* fd_pack_set_alt sets the address lookup table snapshot that pack
+   uses to resolve the accounts that inserted transactions load from
+   lookup tables.  alt must be a local join of an ALT snapshot (or NULL)
+   that remains valid until the next call to fd_pack_set_alt.  The user
+   may modify the contents of the snapshot between calls to
+   fd_pack_insert_txn_fini, e.g. at the start of each leader slot.
+   Transactions are resolved once when they are inserted, and pack only
+   checks the accounts they resolved to for conflicts, even if the
+   snapshot changes later.  The alt_hash field of scheduled transactions
+   identifies the accounts pack resolved (see fd_pack_alt_hash), and the
+   bank must not execute transactions that load different accounts.
+   Transactions that load from lookup tables while no snapshot is set
+   are accepted but never scheduled, since pack can't tell which
+   accounts they use.  A snapshot is ignored (with a warning) if pack
+   was created without enable_alt. */
+void fd_pack_set_alt( fd_pack_t * pack, fd_pack_alt_t const * alt );
+
+/* fd_pack_set_fee_cache sets the fee payer cache that pack consults to
+   reject transactions whose fee payer can't afford the fee.  cache must
+   be a local join of a fee payer cache (or NULL to accept transactions
+   regardless of the balance of the fee payer) that remains valid until
+   the next call to fd_pack_set_fee_cache.  The cache is typically
+   written concurrently by the banking tiles.  Pack doesn't modify the
+   cache, but tracks the fees that fee payers in the cache pay for the
+   transactions scheduled in the current block, and considers that
+   amount already spent until fd_pack_end_block.  Scheduling skips
+   transactions whose fee payer can no longer afford them, but leaves
+   them in pack. */
+void fd_pack_set_fee_cache( fd_pack_t * pack, fd_pack_fee_cache_t const * cache );
+
+/* fd_pack_set_blockhash_tbl sets the table of recent blockhashes that
+   pack consults to work out when each inserted transaction expires.
+   tbl must be a local join of a blockhash table (or NULL to never
+   expire transactions) that remains valid until the next call to
+   fd_pack_set_blockhash_tbl.  The table is typically written
+   concurrently by the PoH tile.  A transaction inserted while the table
+   is at height h (see fd_pack_blockhash_tbl_height) whose blockhash has
+   height b expires once the table reaches height
+   b+FD_PACK_MAX_BLOCKHASH_AGE+1, and is rejected right away if that is
+   not greater than h.  A transaction whose blockhash the table doesn't
+   know about might reference a block that hasn't been inserted into the
+   table, so it is accepted and treated as if its blockhash had height
+   h, i.e. it expires at height h+FD_PACK_MAX_BLOCKHASH_AGE+1.
+   Transactions inserted while the table is empty never expire. */
+void fd_pack_set_blockhash_tbl( fd_pack_t * pack, fd_pack_blockhash_tbl_t const * tbl );
 
 /* fd_pack_insert_txn_{init,fini,cancel} execute the process of
    inserting a new transaction into the pool of available transactions
@@ -206,6 +277,17 @@ void fd_pack_microblock_complete( fd_pack_t * pack, ulong bank_tile );
    transaction was found (and then removed) and 0 if not. */
 int fd_pack_delete_transaction( fd_pack_t * pack, fd_ed25519_sig_t const * sig0 );
 
+/* fd_pack_expire_before deletes all pending transactions that expire
+   at or before height (see fd_pack_set_blockhash_tbl), and returns the
+   number of transactions deleted.  Transactions are kept in buckets by
+   the height at which they expire, so this takes time proportional to
+   the number of transactions deleted plus the number of heights since
+   the previous call.  Pack calls this itself as needed when inserting a
+   transaction, but the user should also call it at each slot boundary
+   with the current height of the blockhash table, so that expired
+   transactions don't take up space in pack or get scheduled. */
+ulong fd_pack_expire_before( fd_pack_t * pack, ulong height );
+
 /* fd_pack_end_block resets some state to prepare for the next block.
    Specifically, the per-block limits are cleared and transactions in
    the microblocks scheduled after the call to this function are allowed
@@ -0,0 +1,169 @@
+#include "fd_pack_alt.h"
+
+/* fd_pack_alt_tbl_t: An element of an fd_map_dynamic that maps the
+   address of a lookup table to the range [off, off+cnt) of the address
+   array where its contents are stored. */
+struct fd_pack_alt_tbl {
+  fd_acct_addr_t key; /* address of the lookup table */
+  uint           off;
+  uint           cnt;
+};
+typedef struct fd_pack_alt_tbl fd_pack_alt_tbl_t;
+
+static const fd_acct_addr_t null_addr = { 0 };
+
+#define MAP_NAME              alt_map
+#define MAP_T                 fd_pack_alt_tbl_t
+#define MAP_KEY_T             fd_acct_addr_t
+#define MAP_KEY_NULL          null_addr
+#define MAP_KEY_INVAL(k)      MAP_KEY_EQUAL(k, null_addr)
+#define MAP_KEY_EQUAL(k0,k1)  (!memcmp((k0).b,(k1).b, FD_TXN_ACCT_ADDR_SZ))
+#define MAP_KEY_EQUAL_IS_SLOW 1
+#define MAP_MEMOIZE           0
+#define MAP_KEY_HASH(key)     ((uint)fd_ulong_hash( fd_ulong_load_8( (key).b ) ))
+#include "../../util/tmpl/fd_map_dynamic.c"
+
+struct __attribute__((aligned(FD_PACK_ALT_ALIGN))) fd_pack_alt_private {
+  ulong tbl_max;
+  ulong acct_max;
+  ulong tbl_cnt;
+  ulong acct_cnt;
+
+  /* The map and the address array are allocated in that order
+     immediately following the struct.  These pointers are set on join. */
+  fd_pack_alt_tbl_t * map;
+  fd_acct_addr_t    * accts;
+};
+
+/* log base 2, but with a 2* so that the hash table stays sparse */
+static inline int
+fd_pack_alt_lg_tbl_sz( ulong tbl_max ) {
+  return fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*tbl_max ) );
+}
+
+ulong
+fd_pack_alt_footprint( ulong tbl_max,
+                       ulong acct_max ) {
+  if( FD_UNLIKELY( (!tbl_max) | (!acct_max) | (acct_max>UINT_MAX) | (tbl_max>UINT_MAX) ) ) return 0UL;
+
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, FD_PACK_ALT_ALIGN, sizeof(fd_pack_alt_t)                                );
+  l = FD_LAYOUT_APPEND( l, alt_map_align(),   alt_map_footprint( fd_pack_alt_lg_tbl_sz( tbl_max ) ) );
+  l = FD_LAYOUT_APPEND( l, 32UL,              acct_max*sizeof(fd_acct_addr_t)                      );
+  return FD_LAYOUT_FINI( l, FD_PACK_ALT_ALIGN );
+}
+
+void *
+fd_pack_alt_new( void * mem,
+                 ulong  tbl_max,
+                 ulong  acct_max ) {
+  if( FD_UNLIKELY( !mem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)mem, FD_PACK_ALT_ALIGN ) ) ) {
+    FD_LOG_WARNING(( "misaligned mem" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !fd_pack_alt_footprint( tbl_max, acct_max ) ) ) {
+    FD_LOG_WARNING(( "invalid tbl_max (%lu) or acct_max (%lu)", tbl_max, acct_max ));
+    return NULL;
+  }
+
+  FD_SCRATCH_ALLOC_INIT( l, mem );
+  fd_pack_alt_t * alt = FD_SCRATCH_ALLOC_APPEND( l, FD_PACK_ALT_ALIGN, sizeof(fd_pack_alt_t)                                );
+  void *         _map = FD_SCRATCH_ALLOC_APPEND( l, alt_map_align(),   alt_map_footprint( fd_pack_alt_lg_tbl_sz( tbl_max ) ) );
+
+  alt->tbl_max  = tbl_max;
+  alt->acct_max = acct_max;
+  alt->tbl_cnt  = 0UL;
+  alt->acct_cnt = 0UL;
+
+  alt_map_new( _map, fd_pack_alt_lg_tbl_sz( tbl_max ) );
+
+  return mem;
+}
+
+fd_pack_alt_t *
+fd_pack_alt_join( void * mem ) {
+  FD_SCRATCH_ALLOC_INIT( l, mem );
+  fd_pack_alt_t * alt = FD_SCRATCH_ALLOC_APPEND( l, FD_PACK_ALT_ALIGN, sizeof(fd_pack_alt_t) );
+
+  int lg_tbl_sz = fd_pack_alt_lg_tbl_sz( alt->tbl_max );
+  alt->map   = alt_map_join( FD_SCRATCH_ALLOC_APPEND( l, alt_map_align(), alt_map_footprint( lg_tbl_sz ) ) );
+  alt->accts = (fd_acct_addr_t *)FD_SCRATCH_ALLOC_APPEND( l, 32UL, alt->acct_max*sizeof(fd_acct_addr_t) );
+
+  return alt;
+}
+
+void * fd_pack_alt_leave ( fd_pack_alt_t * alt ) { FD_COMPILER_MFENCE(); return (void *)alt; }
+void * fd_pack_alt_delete( void          * mem ) { FD_COMPILER_MFENCE(); return mem;         }
+
+void
+fd_pack_alt_clear( fd_pack_alt_t * alt ) {
+  alt_map_clear( alt->map );
+  alt->tbl_cnt  = 0UL;
+  alt->acct_cnt = 0UL;
+}
+
+int
+fd_pack_alt_insert( fd_pack_alt_t *        alt,
+                    fd_acct_addr_t const * tbl,
+                    fd_acct_addr_t const * accts,
+                    ulong                  acct_cnt ) {
+  if( FD_UNLIKELY( acct_cnt>FD_PACK_ALT_ACCT_MAX                   ) ) return 0;
+  if( FD_UNLIKELY( acct_cnt>alt->acct_max-alt->acct_cnt            ) ) return 0;
+  if( FD_UNLIKELY( alt->tbl_cnt>=alt->tbl_max                      ) ) return 0;
+  if( FD_UNLIKELY( alt_map_key_inval( *tbl )                       ) ) return 0;
+  if( FD_UNLIKELY( alt_map_query( alt->map, *tbl, NULL )           ) ) return 0;
+
+  fd_pack_alt_tbl_t * e = alt_map_insert( alt->map, *tbl );
+  e->off = (uint)alt->acct_cnt;
+  e->cnt = (uint)acct_cnt;
+  fd_memcpy( alt->accts+alt->acct_cnt, accts, acct_cnt*sizeof(fd_acct_addr_t) );
+
+  alt->tbl_cnt++;
+  alt->acct_cnt += acct_cnt;
+  return 1;
+}
+
+fd_acct_addr_t const *
+fd_pack_alt_query( fd_pack_alt_t const *  alt,
+                   fd_acct_addr_t const * tbl,
+                   ulong *                acct_cnt ) {
+  fd_pack_alt_tbl_t const * e = alt_map_query( alt->map, *tbl, NULL );
+  if( FD_UNLIKELY( !e ) ) return NULL;
+  *acct_cnt = (ulong)e->cnt;
+  return alt->accts + e->off;
+}
+
+int
+fd_pack_alt_resolve( fd_pack_alt_t const * alt,
+                     fd_txn_t *            txn,
+                     uchar const *         payload,
+                     fd_acct_addr_t *      out ) {
+  fd_txn_acct_addr_lut_t const * luts = fd_txn_get_address_tables( txn );
+
+  fd_acct_addr_t * out_w = out;
+  fd_acct_addr_t * out_r = out + txn->addr_table_adtl_writable_cnt;
+
+  for( ulong i=0UL; i<(ulong)txn->addr_table_lookup_cnt; i++ ) {
+    fd_txn_acct_addr_lut_t const * lut = luts+i;
+
+    ulong                  tbl_cnt = 0UL;
+    fd_acct_addr_t const * tbl     = fd_pack_alt_query( alt, (fd_acct_addr_t const *)(payload+lut->addr_off), &tbl_cnt );
+    if( FD_UNLIKELY( !tbl ) ) return 0;
+
+    uchar const * w_idx = payload + lut->writable_off;
+    for( ulong j=0UL; j<(ulong)lut->writable_cnt; j++ ) {
+      if( FD_UNLIKELY( (ulong)w_idx[ j ]>=tbl_cnt ) ) return 0;
+      *(out_w++) = tbl[ w_idx[ j ] ];
+    }
+    uchar const * r_idx = payload + lut->readonly_off;
+    for( ulong j=0UL; j<(ulong)lut->readonly_cnt; j++ ) {
+      if( FD_UNLIKELY( (ulong)r_idx[ j ]>=tbl_cnt ) ) return 0;
+      *(out_r++) = tbl[ r_idx[ j ] ];
+    }
+  }
+  return 1;
+}
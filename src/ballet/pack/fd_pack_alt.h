@@ -0,0 +1,128 @@
+#ifndef HEADER_fd_src_ballet_pack_fd_pack_alt_h
+#define HEADER_fd_src_ballet_pack_fd_pack_alt_h
+
+/* fd_pack_alt defines a snapshot of the contents of on-chain address
+   lookup tables (ALTs), which pack uses to resolve the accounts that v0
+   transactions load from lookup tables.  Without knowing these
+   accounts, pack can't check such transactions for conflicts.
+
+   The snapshot is owned by the user of pack, who is responsible for
+   refreshing it from the accounts database, typically at the start of
+   each leader slot.  The user should only insert tables that are active
+   in that slot, and for each table only the addresses that a
+   transaction executing in that slot may load (i.e. excluding any
+   addresses appended in that slot).  Since the snapshot can go stale
+   after a transaction has been resolved against it, the bank must check
+   that the accounts it actually loads match what pack resolved (see
+   fd_pack_alt_hash). */
+
+#include "../fd_ballet_base.h"
+#include "../txn/fd_txn.h"
+
+#define FD_PACK_ALT_ALIGN (64UL)
+
+/* FD_PACK_ALT_ACCT_MAX: The maximum number of addresses that an address
+   lookup table can hold. */
+#define FD_PACK_ALT_ACCT_MAX (256UL)
+
+/* Forward declare opaque handle */
+struct fd_pack_alt_private;
+typedef struct fd_pack_alt_private fd_pack_alt_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_pack_alt_{align,footprint} return the required alignment and
+   footprint in bytes for a region of memory to be used as an ALT
+   snapshot.  tbl_max is the maximum number of lookup tables the
+   snapshot can hold and acct_max is the maximum number of addresses
+   summed over all tables.  Returns 0 if tbl_max or acct_max is 0 or
+   acct_max>=2^32. */
+
+FD_FN_CONST static inline ulong fd_pack_alt_align( void ) { return FD_PACK_ALT_ALIGN; }
+
+FD_FN_CONST ulong
+fd_pack_alt_footprint( ulong tbl_max,
+                       ulong acct_max );
+
+/* fd_pack_alt_new formats a region of memory with the required
+   alignment and footprint to be used as an empty ALT snapshot.  Returns
+   mem on success and NULL on failure (logs details).  The caller will
+   not be joined to the snapshot when this function returns.
+
+   fd_pack_alt_join joins the caller to the snapshot.  Every successful
+   join should have a matching leave.  fd_pack_alt_leave leaves a local
+   join and returns a pointer to the underlying memory region.
+   fd_pack_alt_delete unformats the memory region and returns ownership
+   of it to the caller. */
+
+void *          fd_pack_alt_new   ( void * mem, ulong tbl_max, ulong acct_max );
+fd_pack_alt_t * fd_pack_alt_join  ( void * mem );
+void *          fd_pack_alt_leave ( fd_pack_alt_t * alt );
+void *          fd_pack_alt_delete( void * mem );
+
+/* fd_pack_alt_clear removes all tables from the snapshot. */
+
+void fd_pack_alt_clear( fd_pack_alt_t * alt );
+
+/* fd_pack_alt_insert adds the lookup table stored at address tbl to the
+   snapshot.  accts points to the acct_cnt addresses of the table (in
+   table order).  The addresses are copied, and the caller retains no
+   interest in accts on return.  Returns 1 on success and 0 if the table
+   is already present, acct_cnt>FD_PACK_ALT_ACCT_MAX, tbl is the zero
+   address, or the snapshot is out of space. */
+
+int
+fd_pack_alt_insert( fd_pack_alt_t *        alt,
+                    fd_acct_addr_t const * tbl,
+                    fd_acct_addr_t const * accts,
+                    ulong                  acct_cnt );
+
+/* fd_pack_alt_query returns a pointer to the addresses of the lookup
+   table stored at address tbl, and stores the number of addresses in
+   *acct_cnt.  Returns NULL (and leaves *acct_cnt untouched) if the
+   table is not in the snapshot.  The returned pointer is valid until
+   the next call to fd_pack_alt_clear. */
+
+fd_acct_addr_t const *
+fd_pack_alt_query( fd_pack_alt_t const *  alt,
+                   fd_acct_addr_t const * tbl,
+                   ulong *                acct_cnt );
+
+/* fd_pack_alt_resolve resolves the accounts that txn (with the given
+   payload) loads from address lookup tables against the snapshot.  On
+   success, returns 1 and stores the
+   fd_txn_account_cnt( txn, FD_TXN_ACCT_CAT_ALT ) addresses to out, in
+   account index order (i.e. out[ i ] is the address of account
+   txn->acct_addr_cnt+i): the writable accounts of each table in table
+   order, followed by the readonly accounts of each table in table
+   order.  This matches the order used by the Solana runtime.  Returns 0
+   if the transaction references a table that is not in the snapshot or
+   an index past the end of a table, in which case the contents of out
+   are unspecified. */
+
+int
+fd_pack_alt_resolve( fd_pack_alt_t const * alt,
+                     fd_txn_t *            txn,
+                     uchar const *         payload,
+                     fd_acct_addr_t *      out );
+
+/* fd_pack_alt_hash returns a 32-bit hash of the accounts a transaction
+   loaded from address lookup tables, given as the w_cnt writable
+   accounts pointed to by w followed by the r_cnt readonly accounts
+   pointed to by r.  Pack stores the hash of the accounts it resolved in
+   the alt_hash field of fd_txn_p_t so that the bank can detect whether
+   the accounts it loads differ. */
+
+static inline uint
+fd_pack_alt_hash( fd_acct_addr_t const * w,
+                  ulong                  w_cnt,
+                  fd_acct_addr_t const * r,
+                  ulong                  r_cnt ) {
+  ulong h = fd_hash( 0x2ab9a1c0ffee4a17UL, w, w_cnt*FD_TXN_ACCT_ADDR_SZ );
+  h       = fd_hash( h,                    r, r_cnt*FD_TXN_ACCT_ADDR_SZ );
+  return (uint)(h ^ (h>>32));
+}
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_pack_fd_pack_alt_h */
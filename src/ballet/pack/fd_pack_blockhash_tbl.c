@@ -0,0 +1,157 @@
+#include "fd_pack_blockhash_tbl.h"
+
+#define FD_PACK_BLOCKHASH_TBL_MAGIC (0xF17EDA2CEB1C4A50UL) /* FIREDANCER BLOCKHASH TBL V0 */
+
+/* FD_PACK_BLOCKHASH_TBL_PROBE_CNT: The number of consecutive entries,
+   starting at the one the blockhash hashes to, where a blockhash may be
+   stored. */
+#define FD_PACK_BLOCKHASH_TBL_PROBE_CNT (4UL)
+
+/* fd_pack_blockhash_tbl_ent_t: An entry of the table.  ver is the
+   sequence lock: it is odd while the writer is modifying the entry, and
+   is bumped by 2 every time the entry is modified.  An entry that has
+   never been written has height 0. */
+struct __attribute__((aligned(64))) fd_pack_blockhash_tbl_ent {
+  ulong ver;
+  uchar hash[ 32 ];
+  ulong height;
+};
+typedef struct fd_pack_blockhash_tbl_ent fd_pack_blockhash_tbl_ent_t;
+
+struct __attribute__((aligned(FD_PACK_BLOCKHASH_TBL_ALIGN))) fd_pack_blockhash_tbl_private {
+  ulong magic;
+  ulong ent_cnt;
+  ulong height; /* height of the most recently inserted blockhash */
+
+  /* ent_cnt fd_pack_blockhash_tbl_ent_t follow the struct */
+};
+
+FD_STATIC_ASSERT( sizeof(fd_pack_blockhash_tbl_ent_t)==64UL,                    blockhash_tbl_ent_sz );
+FD_STATIC_ASSERT( sizeof(fd_pack_blockhash_tbl_t)==FD_PACK_BLOCKHASH_TBL_ALIGN, blockhash_tbl_hdr_sz );
+
+static inline fd_pack_blockhash_tbl_ent_t *
+fd_pack_blockhash_tbl_private_ent( fd_pack_blockhash_tbl_t const * tbl,
+                                   uchar const *                   hash,
+                                   ulong                           probe ) {
+  ulong idx = (fd_ulong_hash( fd_ulong_load_8( hash ) )+probe) & (tbl->ent_cnt-1UL);
+  return (fd_pack_blockhash_tbl_ent_t *)(tbl+1) + idx;
+}
+
+ulong
+fd_pack_blockhash_tbl_footprint( ulong ent_cnt ) {
+  if( FD_UNLIKELY( !fd_ulong_is_pow2( ent_cnt ) || ent_cnt<FD_PACK_BLOCKHASH_TBL_PROBE_CNT || ent_cnt>(1UL<<32) ) ) return 0UL;
+  return sizeof(fd_pack_blockhash_tbl_t) + ent_cnt*sizeof(fd_pack_blockhash_tbl_ent_t);
+}
+
+void *
+fd_pack_blockhash_tbl_new( void * mem,
+                           ulong  ent_cnt ) {
+  if( FD_UNLIKELY( !mem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)mem, FD_PACK_BLOCKHASH_TBL_ALIGN ) ) ) {
+    FD_LOG_WARNING(( "misaligned mem" ));
+    return NULL;
+  }
+  ulong footprint = fd_pack_blockhash_tbl_footprint( ent_cnt );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "invalid ent_cnt (%lu)", ent_cnt ));
+    return NULL;
+  }
+
+  fd_memset( mem, 0, footprint );
+
+  fd_pack_blockhash_tbl_t * tbl = (fd_pack_blockhash_tbl_t *)mem;
+  tbl->ent_cnt = ent_cnt;
+  tbl->height  = 0UL;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( tbl->magic ) = FD_PACK_BLOCKHASH_TBL_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return mem;
+}
+
+fd_pack_blockhash_tbl_t *
+fd_pack_blockhash_tbl_join( void * mem ) {
+  if( FD_UNLIKELY( !mem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+  fd_pack_blockhash_tbl_t * tbl = (fd_pack_blockhash_tbl_t *)mem;
+  if( FD_UNLIKELY( tbl->magic!=FD_PACK_BLOCKHASH_TBL_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+  return tbl;
+}
+
+void * fd_pack_blockhash_tbl_leave( fd_pack_blockhash_tbl_t * tbl ) { return (void *)tbl; }
+
+void *
+fd_pack_blockhash_tbl_delete( void * mem ) {
+  if( FD_UNLIKELY( !mem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+  fd_pack_blockhash_tbl_t * tbl = (fd_pack_blockhash_tbl_t *)mem;
+  if( FD_UNLIKELY( tbl->magic!=FD_PACK_BLOCKHASH_TBL_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( tbl->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return mem;
+}
+
+void
+fd_pack_blockhash_tbl_insert( fd_pack_blockhash_tbl_t * tbl,
+                              uchar const *             hash ) {
+  /* There is only one writer, so the entries can't change under us
+     while we look for the blockhash and pick an entry to evict. */
+  fd_pack_blockhash_tbl_ent_t * victim = NULL;
+  for( ulong k=0UL; k<FD_PACK_BLOCKHASH_TBL_PROBE_CNT; k++ ) {
+    fd_pack_blockhash_tbl_ent_t * e = fd_pack_blockhash_tbl_private_ent( tbl, hash, k );
+    if( FD_UNLIKELY( e->height && !memcmp( e->hash, hash, 32UL ) ) ) return;
+    if( !victim || e->height<victim->height ) victim = e;
+  }
+
+  ulong height = tbl->height+1UL;
+  ulong ver    = victim->ver;
+
+  FD_VOLATILE( victim->ver ) = ver+1UL;
+  FD_COMPILER_MFENCE();
+  fd_memcpy( victim->hash, hash, 32UL );
+  victim->height = height;
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( victim->ver ) = ver+2UL;
+
+  FD_VOLATILE( tbl->height ) = height;
+}
+
+ulong
+fd_pack_blockhash_tbl_query( fd_pack_blockhash_tbl_t const * tbl,
+                             uchar const *                   hash ) {
+  for( ulong k=0UL; k<FD_PACK_BLOCKHASH_TBL_PROBE_CNT; k++ ) {
+    fd_pack_blockhash_tbl_ent_t const * e = fd_pack_blockhash_tbl_private_ent( tbl, hash, k );
+
+    ulong ver0 = FD_VOLATILE_CONST( e->ver );
+    FD_COMPILER_MFENCE();
+    int   match  = !memcmp( e->hash, hash, 32UL );
+    ulong height = e->height;
+    FD_COMPILER_MFENCE();
+    ulong ver1 = FD_VOLATILE_CONST( e->ver );
+
+    if( FD_LIKELY( !(ver0 & 1UL) & (ver0==ver1) & match & (height>0UL) ) ) return height;
+  }
+  return 0UL;
+}
+
+ulong
+fd_pack_blockhash_tbl_height( fd_pack_blockhash_tbl_t const * tbl ) {
+  return FD_VOLATILE_CONST( tbl->height );
+}
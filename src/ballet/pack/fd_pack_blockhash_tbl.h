@@ -0,0 +1,101 @@
+#ifndef HEADER_fd_src_ballet_pack_fd_pack_blockhash_tbl_h
+#define HEADER_fd_src_ballet_pack_fd_pack_blockhash_tbl_h
+
+/* fd_pack_blockhash_tbl is a compact table of recent blockhashes,
+   meant to be placed in a workspace shared between the PoH tile, which
+   writes it every time it is reset onto a new block, and pack, which
+   reads it.  Pack uses it to work out when the recent blockhash of each
+   pending transaction expires, so that it can drop transactions that
+   would only fail with BlockhashNotFound.
+
+   Each blockhash is stamped with a height, which counts the distinct
+   blockhashes inserted into the table, starting at 1.  The age of a
+   blockhash is the difference between the height of the table and the
+   height of the blockhash, which approximates the age the Solana
+   runtime computes from its blockhash queue.  Ages are counted in
+   blocks rather than slots, so skipped slots don't age a blockhash.
+   Note that the height counts the blocks PoH was reset onto, not the
+   block height of any one fork: blocks PoH never gets reset onto (e.g.
+   while catching up) are missing from the table, and the blocks of an
+   abandoned fork stay counted after a fork switch.  Users should treat
+   blockhashes missing from the table conservatively.
+
+   The table is a small open addressed hash table with a bounded probe
+   sequence: an insert overwrites the oldest entry in the probe
+   sequence of the blockhash, so with a table several times larger than
+   the number of blockhashes that can still be referenced, only very
+   old blockhashes are ever forgotten.  Each entry is protected by a
+   sequence lock.  There must be a single writer (or the writers must be
+   serialized externally), but any number of readers may query the
+   table concurrently without blocking.  A query that races with a write
+   of the same entry just reports the blockhash as missing. */
+
+#include "../fd_ballet_base.h"
+
+#define FD_PACK_BLOCKHASH_TBL_ALIGN (64UL)
+
+/* FD_PACK_MAX_BLOCKHASH_AGE: The oldest age at which a blockhash may
+   still be used, matching MAX_PROCESSING_AGE in Solana Labs. */
+#define FD_PACK_MAX_BLOCKHASH_AGE (150UL)
+
+/* Forward declare opaque handle */
+struct fd_pack_blockhash_tbl_private;
+typedef struct fd_pack_blockhash_tbl_private fd_pack_blockhash_tbl_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_pack_blockhash_tbl_{align,footprint} return the required alignment
+   and footprint in bytes for a region of memory to be used as a
+   blockhash table with ent_cnt entries.  ent_cnt must be a power of 2
+   and at least 4.  footprint returns 0 if ent_cnt is not valid. */
+
+FD_FN_CONST static inline ulong fd_pack_blockhash_tbl_align( void ) { return FD_PACK_BLOCKHASH_TBL_ALIGN; }
+
+FD_FN_CONST ulong
+fd_pack_blockhash_tbl_footprint( ulong ent_cnt );
+
+/* fd_pack_blockhash_tbl_new formats a region of memory with the
+   required alignment and footprint as an empty blockhash table with
+   ent_cnt entries.  Returns mem on success and NULL on failure (logs
+   details).
+
+   fd_pack_blockhash_tbl_join joins the caller to the table.  The join
+   is position independent, so the table can be joined from several
+   address spaces at once, and only needs a read-only mapping for
+   fd_pack_blockhash_tbl_{query,height}.  fd_pack_blockhash_tbl_leave
+   leaves a local join and fd_pack_blockhash_tbl_delete unformats the
+   memory region. */
+
+void *                    fd_pack_blockhash_tbl_new   ( void * mem, ulong ent_cnt );
+fd_pack_blockhash_tbl_t * fd_pack_blockhash_tbl_join  ( void * mem );
+void *                    fd_pack_blockhash_tbl_leave ( fd_pack_blockhash_tbl_t * tbl );
+void *                    fd_pack_blockhash_tbl_delete( void * mem );
+
+/* fd_pack_blockhash_tbl_insert records that hash (which points to the
+   first byte of a 32 byte blockhash) is the blockhash of a block that
+   was just produced or replayed, making it the most recent blockhash
+   and aging every other blockhash in the table by one.  Inserting a
+   blockhash that is already in the table (e.g. because PoH was reset
+   onto the same block twice) has no effect.  Must not be called
+   concurrently with another insert into the same table. */
+
+void
+fd_pack_blockhash_tbl_insert( fd_pack_blockhash_tbl_t * tbl,
+                              uchar const *             hash );
+
+/* fd_pack_blockhash_tbl_query returns the height of the blockhash
+   pointed to by hash, or 0 if the table doesn't know about it. */
+
+ulong
+fd_pack_blockhash_tbl_query( fd_pack_blockhash_tbl_t const * tbl,
+                             uchar const *                   hash );
+
+/* fd_pack_blockhash_tbl_height returns the height of the most recently
+   inserted blockhash, or 0 if the table is empty. */
+
+ulong
+fd_pack_blockhash_tbl_height( fd_pack_blockhash_tbl_t const * tbl );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_pack_fd_pack_blockhash_tbl_h */
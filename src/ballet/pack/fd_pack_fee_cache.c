@@ -0,0 +1,219 @@
+#include "fd_pack_fee_cache.h"
+
+#define FD_PACK_FEE_CACHE_MAGIC (0xF17EDA2CEFEEC4C0UL) /* FIREDANCER FEE CACHE V0 */
+
+/* fd_pack_fee_cache_ent_t: An entry of the table.  ver is the sequence
+   lock: it is odd while a writer is modifying the entry, and is bumped
+   by 2 every time the entry is modified.  An entry that has never been
+   written has the all zero payer, which can't be a fee payer since it
+   is the system program. */
+struct __attribute__((aligned(64))) fd_pack_fee_cache_ent {
+  ulong          ver;
+  fd_acct_addr_t payer;
+  ulong          balance; /* in lamports */
+  ulong          slot;
+};
+typedef struct fd_pack_fee_cache_ent fd_pack_fee_cache_ent_t;
+
+struct __attribute__((aligned(FD_PACK_FEE_CACHE_ALIGN))) fd_pack_fee_cache_private {
+  ulong magic;
+  ulong ent_cnt;
+  ulong ttl;
+  ulong slot;     /* highest slot reported by any writer */
+  ulong used_cnt; /* number of entries that hold a fee payer (including expired ones) */
+
+  /* ent_cnt fd_pack_fee_cache_ent_t follow the struct */
+};
+
+FD_STATIC_ASSERT( sizeof(fd_pack_fee_cache_ent_t)==64UL,                     fee_cache_ent_sz );
+FD_STATIC_ASSERT( sizeof(fd_pack_fee_cache_t)==FD_PACK_FEE_CACHE_ALIGN,       fee_cache_hdr_sz );
+
+static inline fd_pack_fee_cache_ent_t *
+fd_pack_fee_cache_private_ent( fd_pack_fee_cache_t const * cache,
+                               fd_acct_addr_t const *      payer ) {
+  ulong idx = fd_ulong_hash( fd_ulong_load_8( payer->b ) ) & (cache->ent_cnt-1UL);
+  return (fd_pack_fee_cache_ent_t *)(cache+1) + idx;
+}
+
+static inline int
+fd_pack_fee_cache_private_ent_is_free( fd_pack_fee_cache_ent_t const * e ) {
+  fd_acct_addr_t const null_payer[1] = {{{ 0 }}};
+  return !memcmp( e->payer.b, null_payer->b, FD_TXN_ACCT_ADDR_SZ );
+}
+
+/* fd_pack_fee_cache_private_used_cnt_add adds delta (1 or -1) to the
+   number of entries in use.  Called with the lock of the entry that
+   became used or free held. */
+static inline void
+fd_pack_fee_cache_private_used_cnt_add( fd_pack_fee_cache_t * cache,
+                                        ulong                 delta ) {
+# if FD_HAS_ATOMIC
+  FD_ATOMIC_FETCH_AND_ADD( &cache->used_cnt, delta );
+# else
+  FD_VOLATILE( cache->used_cnt ) = cache->used_cnt + delta;
+# endif
+}
+
+/* fd_pack_fee_cache_private_lock tries to acquire the sequence lock of
+   e for writing.  Returns the (even) version the entry had before it
+   was locked on success, and ULONG_MAX if another writer holds it. */
+static inline ulong
+fd_pack_fee_cache_private_lock( fd_pack_fee_cache_ent_t * e ) {
+  ulong ver = FD_VOLATILE_CONST( e->ver );
+  if( FD_UNLIKELY( ver & 1UL ) ) return ULONG_MAX;
+# if FD_HAS_ATOMIC
+  if( FD_UNLIKELY( FD_ATOMIC_CAS( &e->ver, ver, ver+1UL )!=ver ) ) return ULONG_MAX;
+# else
+  FD_VOLATILE( e->ver ) = ver+1UL;
+# endif
+  FD_COMPILER_MFENCE();
+  return ver;
+}
+
+static inline void
+fd_pack_fee_cache_private_unlock( fd_pack_fee_cache_ent_t * e,
+                                  ulong                     ver ) {
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( e->ver ) = ver+2UL;
+}
+
+ulong
+fd_pack_fee_cache_footprint( ulong ent_cnt ) {
+  if( FD_UNLIKELY( !fd_ulong_is_pow2( ent_cnt ) || ent_cnt>(1UL<<32) ) ) return 0UL;
+  return sizeof(fd_pack_fee_cache_t) + ent_cnt*sizeof(fd_pack_fee_cache_ent_t);
+}
+
+void *
+fd_pack_fee_cache_new( void * mem,
+                       ulong  ent_cnt,
+                       ulong  ttl ) {
+  if( FD_UNLIKELY( !mem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)mem, FD_PACK_FEE_CACHE_ALIGN ) ) ) {
+    FD_LOG_WARNING(( "misaligned mem" ));
+    return NULL;
+  }
+  ulong footprint = fd_pack_fee_cache_footprint( ent_cnt );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "invalid ent_cnt (%lu)", ent_cnt ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !ttl || ttl>(1UL<<32) ) ) {
+    FD_LOG_WARNING(( "invalid ttl (%lu)", ttl ));
+    return NULL;
+  }
+
+  fd_memset( mem, 0, footprint );
+
+  fd_pack_fee_cache_t * cache = (fd_pack_fee_cache_t *)mem;
+  cache->ent_cnt = ent_cnt;
+  cache->ttl     = ttl;
+  cache->slot     = 0UL;
+  cache->used_cnt = 0UL;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = FD_PACK_FEE_CACHE_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return mem;
+}
+
+fd_pack_fee_cache_t *
+fd_pack_fee_cache_join( void * mem ) {
+  if( FD_UNLIKELY( !mem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+  fd_pack_fee_cache_t * cache = (fd_pack_fee_cache_t *)mem;
+  if( FD_UNLIKELY( cache->magic!=FD_PACK_FEE_CACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+  return cache;
+}
+
+void * fd_pack_fee_cache_leave( fd_pack_fee_cache_t * cache ) { return (void *)cache; }
+
+void *
+fd_pack_fee_cache_delete( void * mem ) {
+  if( FD_UNLIKELY( !mem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+  fd_pack_fee_cache_t * cache = (fd_pack_fee_cache_t *)mem;
+  if( FD_UNLIKELY( cache->magic!=FD_PACK_FEE_CACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return mem;
+}
+
+void
+fd_pack_fee_cache_update( fd_pack_fee_cache_t *  cache,
+                          fd_acct_addr_t const * payer,
+                          ulong                  balance,
+                          ulong                  slot ) {
+  ulong cur = FD_VOLATILE_CONST( cache->slot );
+  while( FD_UNLIKELY( slot>cur ) ) {
+# if FD_HAS_ATOMIC
+    ulong old = FD_ATOMIC_CAS( &cache->slot, cur, slot );
+    if( FD_LIKELY( old==cur ) ) break;
+    cur = old;
+# else
+    FD_VOLATILE( cache->slot ) = slot;
+    break;
+# endif
+  }
+
+  fd_pack_fee_cache_ent_t * e = fd_pack_fee_cache_private_ent( cache, payer );
+  ulong ver = fd_pack_fee_cache_private_lock( e );
+  if( FD_UNLIKELY( ver==ULONG_MAX ) ) return;
+  if( FD_UNLIKELY( fd_pack_fee_cache_private_ent_is_free( e ) ) ) fd_pack_fee_cache_private_used_cnt_add( cache, 1UL );
+  e->payer   = *payer;
+  e->balance = balance;
+  e->slot    = slot;
+  fd_pack_fee_cache_private_unlock( e, ver );
+}
+
+void
+fd_pack_fee_cache_remove( fd_pack_fee_cache_t *  cache,
+                          fd_acct_addr_t const * payer ) {
+  fd_pack_fee_cache_ent_t * e = fd_pack_fee_cache_private_ent( cache, payer );
+  ulong ver = fd_pack_fee_cache_private_lock( e );
+  if( FD_UNLIKELY( ver==ULONG_MAX ) ) return;
+  if( FD_LIKELY( !memcmp( e->payer.b, payer->b, FD_TXN_ACCT_ADDR_SZ ) ) ) {
+    memset( e->payer.b, 0, FD_TXN_ACCT_ADDR_SZ );
+    fd_pack_fee_cache_private_used_cnt_add( cache, (ulong)-1L );
+  }
+  fd_pack_fee_cache_private_unlock( e, ver );
+}
+
+int
+fd_pack_fee_cache_is_empty( fd_pack_fee_cache_t const * cache ) {
+  return !FD_VOLATILE_CONST( cache->used_cnt );
+}
+
+ulong
+fd_pack_fee_cache_query( fd_pack_fee_cache_t const * cache,
+                         fd_acct_addr_t const *      payer ) {
+  fd_pack_fee_cache_ent_t const * e = fd_pack_fee_cache_private_ent( cache, payer );
+
+  ulong ver0 = FD_VOLATILE_CONST( e->ver );
+  FD_COMPILER_MFENCE();
+  int   match   = !memcmp( e->payer.b, payer->b, FD_TXN_ACCT_ADDR_SZ );
+  ulong balance = e->balance;
+  ulong slot    = e->slot;
+  FD_COMPILER_MFENCE();
+  ulong ver1 = FD_VOLATILE_CONST( e->ver );
+
+  if( FD_UNLIKELY( (ver0 & 1UL) | (ver0!=ver1) | !match ) ) return ULONG_MAX;
+  if( FD_UNLIKELY( slot+cache->ttl<=FD_VOLATILE_CONST( cache->slot ) ) ) return ULONG_MAX;
+  return balance;
+}
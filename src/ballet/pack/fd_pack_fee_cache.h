@@ -0,0 +1,103 @@
+#ifndef HEADER_fd_src_ballet_pack_fd_pack_fee_cache_h
+#define HEADER_fd_src_ballet_pack_fd_pack_fee_cache_h
+
+/* fd_pack_fee_cache is a compact, lossy table of upper bounds on the
+   lamport balances of fee payers, meant to be placed in a workspace
+   shared between the banking tiles, which write it, and pack, which
+   reads it.  Pack uses it to reject transactions from fee payers that
+   have been drained, which would otherwise occupy space in pack and
+   waste bank tile time only to fail with InsufficientFundsForFee.
+
+   The table is direct mapped: each fee payer hashes to exactly one
+   entry, and a later update for a different fee payer that hashes to
+   the same entry evicts it.  Because it's a cache, a missing entry just
+   means nothing is known about the fee payer.  Each entry is protected
+   by a sequence lock, so any number of writers can update the table
+   concurrently with any number of readers without blocking.  An update
+   that finds the entry locked by another writer is dropped, and a read
+   that races with a write reports the entry as missing.
+
+   Each entry is stamped with the slot in which it was written, and the
+   table tracks the highest slot any writer has reported.  Entries older
+   than ttl slots are treated as missing, which bounds how long a fee
+   payer that receives lamports from elsewhere can be wrongly
+   rejected. */
+
+#include "../fd_ballet_base.h"
+#include "../txn/fd_txn.h"
+
+#define FD_PACK_FEE_CACHE_ALIGN (64UL)
+
+/* Forward declare opaque handle */
+struct fd_pack_fee_cache_private;
+typedef struct fd_pack_fee_cache_private fd_pack_fee_cache_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_pack_fee_cache_{align,footprint} return the required alignment
+   and footprint in bytes for a region of memory to be used as a fee
+   payer cache with ent_cnt entries.  ent_cnt must be a power of 2.
+   footprint returns 0 if ent_cnt is not a power of two or is too
+   large. */
+
+FD_FN_CONST static inline ulong fd_pack_fee_cache_align( void ) { return FD_PACK_FEE_CACHE_ALIGN; }
+
+FD_FN_CONST ulong
+fd_pack_fee_cache_footprint( ulong ent_cnt );
+
+/* fd_pack_fee_cache_new formats a region of memory with the required
+   alignment and footprint as an empty fee payer cache with ent_cnt
+   entries whose entries expire after ttl slots.  Returns mem on success
+   and NULL on failure (logs details).
+
+   fd_pack_fee_cache_join joins the caller to the cache.  The join is
+   position independent, so the cache can be joined from several address
+   spaces at once, and only needs a read-only mapping for
+   fd_pack_fee_cache_query.  fd_pack_fee_cache_leave leaves a local
+   join and fd_pack_fee_cache_delete unformats the memory region. */
+
+void *                fd_pack_fee_cache_new   ( void * mem, ulong ent_cnt, ulong ttl );
+fd_pack_fee_cache_t * fd_pack_fee_cache_join  ( void * mem );
+void *                fd_pack_fee_cache_leave ( fd_pack_fee_cache_t * cache );
+void *                fd_pack_fee_cache_delete( void * mem );
+
+/* fd_pack_fee_cache_update records that as of slot, the balance of the
+   fee payer with address payer is at most balance lamports.  May evict
+   another fee payer.  Best effort: the update is silently dropped if
+   another writer is concurrently updating the same entry. */
+
+void
+fd_pack_fee_cache_update( fd_pack_fee_cache_t *  cache,
+                          fd_acct_addr_t const * payer,
+                          ulong                  balance,
+                          ulong                  slot );
+
+/* fd_pack_fee_cache_remove forgets anything known about the fee payer
+   with address payer, e.g. because it was just seen paying a fee.  Best
+   effort in the same way as fd_pack_fee_cache_update. */
+
+void
+fd_pack_fee_cache_remove( fd_pack_fee_cache_t *  cache,
+                          fd_acct_addr_t const * payer );
+
+/* fd_pack_fee_cache_query returns the upper bound on the balance of the
+   fee payer with address payer, or ULONG_MAX if the cache knows nothing
+   (current) about it. */
+
+ulong
+fd_pack_fee_cache_query( fd_pack_fee_cache_t const * cache,
+                         fd_acct_addr_t const *      payer );
+
+/* fd_pack_fee_cache_is_empty returns 1 if no entry of the cache holds a
+   fee payer, in which case fd_pack_fee_cache_query returns ULONG_MAX for
+   any payer, and 0 otherwise.  Only reads the cache header, so callers
+   querying many fee payers can check it once up front and skip the
+   queries while the cache is empty.  Like a query, the result may be
+   stale by the time it is returned. */
+
+int
+fd_pack_fee_cache_is_empty( fd_pack_fee_cache_t const * cache );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_pack_fd_pack_fee_cache_h */
@@ -15,7 +15,7 @@ uchar txn_scratch[ MAX_TEST_TXNS ][ FD_TXN_MAX_SZ ];
 uchar payload_scratch[ MAX_TEST_TXNS ][ DUMMY_PAYLOAD_MAX_SZ ];
 ulong payload_sz[ MAX_TEST_TXNS ];
 
-#define PACK_SCRATCH_SZ (272UL*1024UL*1024UL)
+#define PACK_SCRATCH_SZ (320UL*1024UL*1024UL)
 uchar pack_scratch[ PACK_SCRATCH_SZ ] __attribute__((aligned(128)));
 
 uchar metrics_scratch[ FD_METRICS_FOOTPRINT( 0, 0 ) ] __attribute__((aligned(FD_METRICS_ALIGN)));
@@ -44,15 +44,16 @@ static fd_pack_t *
 init_all( ulong pack_depth,
           ulong gap,
           ulong max_txn_per_microblock,
+          int   enable_alt,
           pack_outcome_t * outcome     ) {
-  ulong footprint = fd_pack_footprint( pack_depth, gap, max_txn_per_microblock );
+  ulong footprint = fd_pack_footprint( pack_depth, gap, max_txn_per_microblock, enable_alt );
 
   if( footprint>PACK_SCRATCH_SZ ) FD_LOG_ERR(( "Test required %lu bytes, but scratch was only %lu", footprint, PACK_SCRATCH_SZ ));
 #if DETAILED_STATUS_MESSAGES
   else                         FD_LOG_NOTICE(( "Test required %lu bytes of %lu available bytes",    footprint, PACK_SCRATCH_SZ ));
 #endif
 
-  fd_pack_t * pack = fd_pack_join( fd_pack_new( pack_scratch, pack_depth, gap, max_txn_per_microblock, MAX_TEST_TXNS, rng ) );
+  fd_pack_t * pack = fd_pack_join( fd_pack_new( pack_scratch, pack_depth, gap, max_txn_per_microblock, enable_alt, MAX_TEST_TXNS, rng ) );
 #define MAX_BANKING_THREADS 64
 
   outcome->microblock_cnt = 0UL;
@@ -171,7 +172,42 @@ make_vote_transaction( ulong i ) {
   FD_TEST( fd_txn_parse( p, sample_vote_sz, txn_scratch[i], NULL ) );
 }
 
+/* Makes transaction i (as created by make_transaction) a v0 transaction
+   that additionally loads accounts from the address lookup table whose
+   address is tbl repeated 32 times.  Each character in writes (resp.
+   reads) selects the table entry with index c-'0' as writable (resp.
+   readonly).  Can be called multiple times for the same transaction to
+   load from several tables. */
 static void
+add_address_lookup( ulong        i,
+                    char         tbl,
+                    char const * writes,
+                    char const * reads ) {
+  uchar *    p_base = payload_scratch[ i ];
+  uchar *    p      = p_base + payload_sz[ i ];
+  fd_txn_t * t      = (fd_txn_t*) txn_scratch[ i ];
+
+  fd_txn_acct_addr_lut_t * lut = fd_txn_get_address_tables( t ) + t->addr_table_lookup_cnt;
+
+  t->transaction_version = FD_TXN_V0;
+  lut->addr_off     = (ushort)(p - p_base);
+  lut->writable_cnt = (uchar)strlen( writes );
+  lut->readonly_cnt = (uchar)strlen( reads  );
+  memset( p, tbl, FD_TXN_ACCT_ADDR_SZ ); p += FD_TXN_ACCT_ADDR_SZ;
+
+  lut->writable_off = (ushort)(p - p_base);
+  for( ulong j=0UL; writes[j] != '\0'; j++ ) *(p++) = (uchar)(writes[j]-'0');
+  lut->readonly_off = (ushort)(p - p_base);
+  for( ulong j=0UL; reads[j]  != '\0'; j++ ) *(p++) = (uchar)(reads[j]-'0');
+
+  t->addr_table_lookup_cnt++;
+  t->addr_table_adtl_writable_cnt = (uchar)(t->addr_table_adtl_writable_cnt + lut->writable_cnt);
+  t->addr_table_adtl_cnt          = (uchar)(t->addr_table_adtl_cnt + lut->writable_cnt + lut->readonly_cnt);
+
+  payload_sz[ i ] = (ulong)(p-p_base);
+}
+
+static int
 insert( ulong i,
         fd_pack_t * pack ) {
   fd_txn_p_t * slot       = fd_pack_insert_txn_init( pack );
@@ -180,7 +216,7 @@ insert( ulong i,
   fd_memcpy( slot->payload, payload_scratch[ i ], payload_sz[ i ] );
   fd_memcpy( TXN(slot),     txn,     fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
 
-  fd_pack_insert_txn_fini( pack, slot );
+  return fd_pack_insert_txn_fini( pack, slot );
 }
 
 static void
@@ -264,7 +300,7 @@ schedule_validate_microblock( fd_pack_t * pack,
 
 void test0( void ) {
   FD_LOG_NOTICE(( "TEST 0" ));
-  fd_pack_t * pack = init_all( 128UL, 3UL, 128UL, &outcome );
+  fd_pack_t * pack = init_all( 128UL, 3UL, 128UL, 0, &outcome );
   ulong i = 0UL;
   ulong rewards = 0UL;
   rewards += make_transaction( i,  500U, 11.0, "A",    "B" ); insert( i++, pack );
@@ -281,7 +317,7 @@ void test0( void ) {
 /* The original two that broke my first algorithm */
 void test1( void ) {
   FD_LOG_NOTICE(( "TEST 1" ));
-  fd_pack_t * pack = init_all( 128UL, 1UL, 128UL, &outcome );
+  fd_pack_t * pack = init_all( 128UL, 1UL, 128UL, 0, &outcome );
   ulong i = 0;
   ulong reward1 = make_transaction( i,  500U, 11.0, "A", "B" ); insert( i++, pack );
   ulong reward2 = make_transaction( i,  500U, 10.0, "B", "A" ); insert( i++, pack );
@@ -291,7 +327,7 @@ void test1( void ) {
 
 void test2( void ) {
   FD_LOG_NOTICE(( "TEST 2" ));
-  fd_pack_t * pack = init_all( 128UL, 1UL, 128UL, &outcome );
+  fd_pack_t * pack = init_all( 128UL, 1UL, 128UL, 0, &outcome );
   ulong i = 0;
   double j = 13.0;
   ulong r0 = make_transaction( i,  500U, j--, "B", "A" ); insert( i++, pack );
@@ -307,7 +343,7 @@ void test2( void ) {
 
 void test_vote( void ) {
   FD_LOG_NOTICE(( "TEST VOTE" ));
-  fd_pack_t * pack = init_all( 128UL, 1UL, 4UL, &outcome );
+  fd_pack_t * pack = init_all( 128UL, 1UL, 4UL, 0, &outcome );
   ulong i = 0;
 
   make_vote_transaction( i ); insert( i++, pack );
@@ -332,7 +368,7 @@ static void
 test_delete( void ) {
   ulong i = 0UL;
   FD_LOG_NOTICE(( "TEST DELETE" ));
-  fd_pack_t * pack = init_all( 10240UL, 4UL, 128UL, &outcome );
+  fd_pack_t * pack = init_all( 10240UL, 4UL, 128UL, 0, &outcome );
 
   make_transaction( i, 800U, 12.0, "A", "B" ); insert( i++, pack );
   make_transaction( i, 700U, 11.0, "C", "D" ); insert( i++, pack );
@@ -397,6 +433,341 @@ test_delete( void ) {
   FD_TEST( fd_pack_avail_txn_cnt( pack ) == 0UL );
 }
 
+#define ALT_TBL_MAX  (4UL)
+#define ALT_ACCT_MAX (64UL)
+uchar alt_scratch[ 4096UL ] __attribute__((aligned(FD_PACK_ALT_ALIGN)));
+
+static void
+test_address_lookup_tables( void ) {
+  FD_LOG_NOTICE(( "TEST ADDRESS LOOKUP TABLES" ));
+  fd_pack_t * pack = init_all( 1024UL, 1UL, 128UL, 1, &outcome );
+
+  FD_TEST( fd_pack_alt_footprint( ALT_TBL_MAX, ALT_ACCT_MAX )<=sizeof(alt_scratch) );
+  fd_pack_alt_t * alt = fd_pack_alt_join( fd_pack_alt_new( alt_scratch, ALT_TBL_MAX, ALT_ACCT_MAX ) );
+  FD_TEST( alt );
+
+  /* Table x holds accounts ABCD, table y holds accounts EF */
+  fd_acct_addr_t tbl_x;      memset( tbl_x.b, 'x', FD_TXN_ACCT_ADDR_SZ );
+  fd_acct_addr_t tbl_y;      memset( tbl_y.b, 'y', FD_TXN_ACCT_ADDR_SZ );
+  fd_acct_addr_t accts[ 4 ];
+  for( ulong j=0UL; j<4UL; j++ ) memset( accts[ j ].b, (int)('A'+j), FD_TXN_ACCT_ADDR_SZ );
+  FD_TEST(  fd_pack_alt_insert( alt, &tbl_x, accts,      4UL ) );
+  FD_TEST( !fd_pack_alt_insert( alt, &tbl_x, accts,      4UL ) );
+  memset( accts[ 0 ].b, 'E', FD_TXN_ACCT_ADDR_SZ );
+  memset( accts[ 1 ].b, 'F', FD_TXN_ACCT_ADDR_SZ );
+  FD_TEST(  fd_pack_alt_insert( alt, &tbl_y, accts,      2UL ) );
+
+  ulong cnt = 0UL;
+  FD_TEST( fd_pack_alt_query( alt, &tbl_y, &cnt ) && cnt==2UL );
+
+  ulong i = 0UL;
+
+  /* Without a snapshot, transactions that use lookup tables can't be
+     checked for conflicts, so they are accepted but never scheduled. */
+  make_transaction( i, 800U, 12.0, "G", "" ); add_address_lookup( i, 'x', "0", "" );
+  FD_TEST( insert( i, pack )>=0 );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+  FD_TEST( fd_pack_schedule_next_microblock( pack, 300000UL, 0.0f, 0UL, outcome.results )==0UL );
+  FD_TEST( fd_pack_delete_transaction( pack, fd_txn_get_signatures( (fd_txn_t *)txn_scratch[i], payload_scratch[i] ) ) );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+  /* Only the static accounts are checked for duplicates then */
+  make_transaction( i, 800U, 12.0, "GG", "" ); add_address_lookup( i, 'x', "0", "" );
+  FD_TEST( insert( i, pack )==FD_PACK_INSERT_REJECT_DUPLICATE_ACCT );
+
+  fd_pack_set_alt( pack, alt );
+
+  /* Accounts loaded twice, statically, within a table, across tables,
+     or both statically and from a table */
+  fd_acct_addr_t tbl_v;      memset( tbl_v.b, 'v', FD_TXN_ACCT_ADDR_SZ );
+  fd_acct_addr_t acct_g;     memset( acct_g.b, 'G', FD_TXN_ACCT_ADDR_SZ );
+  FD_TEST( fd_pack_alt_insert( alt, &tbl_v, &acct_g, 1UL ) );
+  make_transaction( i, 800U, 12.0, "GH", "G" );
+  FD_TEST( insert( i, pack )==FD_PACK_INSERT_REJECT_DUPLICATE_ACCT );
+  make_transaction( i, 800U, 12.0, "H", "" ); add_address_lookup( i, 'x', "0", "0" );
+  FD_TEST( insert( i, pack )==FD_PACK_INSERT_REJECT_DUPLICATE_ACCT );
+  make_transaction( i, 800U, 12.0, "H", "" ); add_address_lookup( i, 'x', "1", "" );
+  /*                                    */    add_address_lookup( i, 'x', "", "1" );
+  FD_TEST( insert( i, pack )==FD_PACK_INSERT_REJECT_DUPLICATE_ACCT );
+  make_transaction( i, 800U, 12.0, "G", "" ); add_address_lookup( i, 'v', "", "0" );
+  FD_TEST( insert( i, pack )==FD_PACK_INSERT_REJECT_DUPLICATE_ACCT );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+  /* Unknown table or index past the end of the table */
+  make_transaction( i, 800U, 12.0, "G", "" ); add_address_lookup( i, 'z', "0", "" );
+  FD_TEST( insert( i, pack )==FD_PACK_INSERT_REJECT_ADDR_LUT );
+  make_transaction( i, 800U, 12.0, "G", "" ); add_address_lookup( i, 'y', "", "2" );
+  FD_TEST( insert( i, pack )==FD_PACK_INSERT_REJECT_ADDR_LUT );
+
+  /* Writes to a sysvar through a lookup table */
+  fd_acct_addr_t sysvar;
+  fd_base58_decode_32( "SysvarC1ock11111111111111111111111111111111", sysvar.b );
+  fd_acct_addr_t tbl_w;      memset( tbl_w.b, 'w', FD_TXN_ACCT_ADDR_SZ );
+  FD_TEST( fd_pack_alt_insert( alt, &tbl_w, &sysvar, 1UL ) );
+  make_transaction( i, 800U, 12.0, "G", "" ); add_address_lookup( i, 'w', "0", "" );
+  FD_TEST( insert( i, pack )==FD_PACK_INSERT_REJECT_WRITES_SYSVAR );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+  /* 0 writes A from x, 1 reads A from x, 2 reads F from y and writes B
+     from x, and 3 writes F directly.  1 conflicts with 0 and 3 with 2. */
+  make_transaction( i, 800U, 12.0, "G", "" ); add_address_lookup( i, 'x', "0", "" );   FD_TEST( insert( i++, pack )>=0 );
+  make_transaction( i, 700U, 11.0, "H", "" ); add_address_lookup( i, 'x', "", "0" );   FD_TEST( insert( i++, pack )>=0 );
+  make_transaction( i, 600U, 10.0, "I", "" ); add_address_lookup( i, 'y', "", "1" );
+  /*                                    */    add_address_lookup( i, 'x', "1", "" );   FD_TEST( insert( i++, pack )>=0 );
+  make_transaction( i, 500U,  9.0, "F", "" );                                          FD_TEST( insert( i++, pack )>=0 );
+
+  /* Deleting a transaction that uses lookup tables releases all its
+     accounts. */
+  make_transaction( i, 900U, 13.0, "J", "" ); add_address_lookup( i, 'x', "3", "2" );  FD_TEST( insert( i,   pack )>=0 );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==5UL );
+  FD_TEST( fd_pack_delete_transaction( pack, fd_txn_get_signatures( (fd_txn_t *)txn_scratch[i], payload_scratch[i] ) ) );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==4UL );
+
+  ulong txn_cnt = fd_pack_schedule_next_microblock( pack, 300000UL, 0.0f, 0UL, outcome.results );
+  FD_TEST( txn_cnt==2UL );
+
+  fd_acct_addr_t expected[ 2 ];
+  memset( expected[ 0 ].b, 'A', FD_TXN_ACCT_ADDR_SZ );
+  FD_TEST( !memcmp( outcome.results[ 0 ].payload, payload_scratch[ 0 ], payload_sz[ 0 ] ) );
+  FD_TEST( outcome.results[ 0 ].alt_hash==fd_pack_alt_hash( expected, 1UL, NULL, 0UL ) );
+
+  /* Writable accounts come first regardless of the table order */
+  memset( expected[ 0 ].b, 'B', FD_TXN_ACCT_ADDR_SZ );
+  memset( expected[ 1 ].b, 'F', FD_TXN_ACCT_ADDR_SZ );
+  FD_TEST( !memcmp( outcome.results[ 1 ].payload, payload_scratch[ 2 ], payload_sz[ 2 ] ) );
+  FD_TEST( outcome.results[ 1 ].alt_hash==fd_pack_alt_hash( expected, 1UL, expected+1, 1UL ) );
+  FD_TEST( outcome.results[ 1 ].alt_hash!=fd_pack_alt_hash( expected, 2UL, NULL,       0UL ) );
+
+  fd_pack_microblock_complete( pack, 0UL );
+  txn_cnt = fd_pack_schedule_next_microblock( pack, 300000UL, 0.0f, 0UL, outcome.results );
+  FD_TEST( txn_cnt==2UL );
+  FD_TEST( outcome.results[ 0 ].alt_hash!=0U );
+  FD_TEST( outcome.results[ 1 ].alt_hash==0U );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+  fd_pack_set_alt( pack, NULL );
+
+  /* A pack created without enable_alt has no room for resolved
+     accounts, ignores the snapshot and treats transactions that use
+     lookup tables as if no snapshot was set. */
+  FD_TEST( fd_pack_footprint( 1024UL, 1UL, 128UL, 0 )+1025UL*FD_TXN_ACCT_ADDR_MAX*FD_TXN_ACCT_ADDR_SZ<=fd_pack_footprint( 1024UL, 1UL, 128UL, 1 ) );
+  pack = init_all( 1024UL, 1UL, 128UL, 0, &outcome );
+  fd_pack_set_alt( pack, alt );
+  i = 0UL;
+  make_transaction( i, 800U, 12.0, "G", "" ); add_address_lookup( i, 'x', "0", "" );
+  FD_TEST( insert( i, pack )>=0 );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+  FD_TEST( fd_pack_schedule_next_microblock( pack, 300000UL, 0.0f, 0UL, outcome.results )==0UL );
+
+  fd_pack_alt_delete( fd_pack_alt_leave( alt ) );
+}
+
+uchar fee_cache_scratch[ 4096UL ] __attribute__((aligned(FD_PACK_FEE_CACHE_ALIGN)));
+uchar empty_fee_cache_scratch[ 4096UL ] __attribute__((aligned(FD_PACK_FEE_CACHE_ALIGN)));
+
+/* Makes transaction i use the fee payer of transaction j */
+static void
+copy_fee_payer( ulong i,
+                ulong j ) {
+  fd_txn_t * t = (fd_txn_t*) txn_scratch[ i ];
+  fd_memcpy( payload_scratch[ i ]+t->acct_addr_off, payload_scratch[ j ]+t->acct_addr_off, FD_TXN_ACCT_ADDR_SZ );
+}
+
+static void
+test_fee_cache( void ) {
+  FD_LOG_NOTICE(( "TEST FEE CACHE" ));
+  fd_pack_t * pack = init_all( 1024UL, 1UL, 128UL, 0, &outcome );
+
+  FD_TEST( fd_pack_fee_cache_footprint( 32UL )<=sizeof(fee_cache_scratch) );
+  FD_TEST( !fd_pack_fee_cache_footprint( 33UL ) );
+  fd_pack_fee_cache_t * cache = fd_pack_fee_cache_join( fd_pack_fee_cache_new( fee_cache_scratch, 32UL, 10UL ) );
+  FD_TEST( cache );
+
+  ulong i = 0UL;
+  ulong fee0 = FD_PACK_FEE_PER_SIGNATURE + make_transaction( i, 500U, 10.0, "A", "B" );                          i++;
+  ulong fee1 = FD_PACK_FEE_PER_SIGNATURE + make_transaction( i, 500U,  9.0, "C", "D" ); copy_fee_payer( i, 0UL ); i++;
+  /*        */                             make_transaction( i, 500U,  8.0, "E", "F" ); copy_fee_payer( i, 0UL ); i++;
+  fd_acct_addr_t const * payer = (fd_acct_addr_t const *)(payload_scratch[ 0 ]+((fd_txn_t *)txn_scratch[ 0 ])->acct_addr_off);
+
+  /* Entries expire, and can be removed */
+  FD_TEST( fd_pack_fee_cache_is_empty( cache ) );
+  FD_TEST( fd_pack_fee_cache_query( cache, payer )==ULONG_MAX );
+  fd_pack_fee_cache_update( cache, payer, 1234UL, 5UL );
+  FD_TEST( !fd_pack_fee_cache_is_empty( cache ) );
+  FD_TEST( fd_pack_fee_cache_query( cache, payer )==1234UL );
+  fd_pack_fee_cache_update( cache, payer, 1000UL, 5UL );
+  fd_pack_fee_cache_remove( cache, payer );
+  FD_TEST( fd_pack_fee_cache_query( cache, payer )==ULONG_MAX );
+  FD_TEST( fd_pack_fee_cache_is_empty( cache ) );
+  fd_pack_fee_cache_remove( cache, payer );
+  FD_TEST( fd_pack_fee_cache_is_empty( cache ) );
+  fd_pack_fee_cache_update( cache, payer, 1234UL, 5UL );
+  fd_acct_addr_t other; memset( other.b, 'O', FD_TXN_ACCT_ADDR_SZ );
+  fd_pack_fee_cache_remove( cache, &other );
+  FD_TEST( !fd_pack_fee_cache_is_empty( cache ) );
+  fd_pack_fee_cache_update( cache, &other, 0UL, 14UL );
+  FD_TEST( fd_pack_fee_cache_query( cache, payer )==1234UL );
+  fd_pack_fee_cache_update( cache, &other, 0UL, 15UL );
+  FD_TEST( fd_pack_fee_cache_query( cache, payer )==ULONG_MAX );
+  FD_TEST( fd_pack_fee_cache_query( cache, &other )==0UL );
+
+  /* The fee payer can afford the first two transactions, but not all
+     three. */
+  fd_pack_fee_cache_update( cache, payer, fee0+fee1, 16UL );
+
+  /* Without a cache, pack doesn't check */
+  make_transaction( i, 500U, 13.0, "G", "H" ); copy_fee_payer( i, 0UL );
+  FD_TEST( insert( i, pack )>=0 );
+  FD_TEST( fd_pack_delete_transaction( pack, fd_txn_get_signatures( (fd_txn_t *)txn_scratch[i], payload_scratch[i] ) ) );
+
+  /* Nor with a cache that knows no fee payer */
+  fd_pack_fee_cache_t * empty = fd_pack_fee_cache_join( fd_pack_fee_cache_new( empty_fee_cache_scratch, 32UL, 10UL ) );
+  FD_TEST( empty && fd_pack_fee_cache_is_empty( empty ) );
+  fd_pack_set_fee_cache( pack, empty );
+  FD_TEST( insert( i, pack )>=0 );
+  FD_TEST( fd_pack_delete_transaction( pack, fd_txn_get_signatures( (fd_txn_t *)txn_scratch[i], payload_scratch[i] ) ) );
+  fd_pack_fee_cache_delete( fd_pack_fee_cache_leave( empty ) );
+
+  fd_pack_set_fee_cache( pack, cache );
+  FD_TEST( insert( i, pack )==FD_PACK_INSERT_REJECT_UNAFFORDABLE );
+
+  for( ulong j=0UL; j<3UL; j++ ) FD_TEST( insert( j, pack )>=0 );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==3UL );
+
+  /* They all write the fee payer, so they go in separate microblocks */
+  FD_TEST( fd_pack_schedule_next_microblock( pack, 300000UL, 0.0f, 0UL, outcome.results )==1UL );
+  FD_TEST( outcome.results[ 0 ].fee==fee0 );
+  fd_pack_microblock_complete( pack, 0UL );
+  FD_TEST( fd_pack_schedule_next_microblock( pack, 300000UL, 0.0f, 0UL, outcome.results )==1UL );
+  FD_TEST( outcome.results[ 0 ].fee==fee1 );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+
+  /* The balance is spent for the rest of the block */
+  make_transaction( i, 500U, 1.0, "I", "J" ); copy_fee_payer( i, 0UL );
+  FD_TEST( insert( i, pack )==FD_PACK_INSERT_REJECT_UNAFFORDABLE );
+  fd_pack_microblock_complete( pack, 0UL );
+  FD_TEST( fd_pack_schedule_next_microblock( pack, 300000UL, 0.0f, 0UL, outcome.results )==0UL );
+
+  fd_pack_end_block( pack );
+  FD_TEST( fd_pack_schedule_next_microblock( pack, 300000UL, 0.0f, 0UL, outcome.results )==1UL );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+  fd_pack_set_fee_cache( pack, NULL );
+  fd_pack_fee_cache_delete( fd_pack_fee_cache_leave( cache ) );
+}
+
+uchar blockhash_tbl_scratch[ 72UL<<10 ] __attribute__((aligned(FD_PACK_BLOCKHASH_TBL_ALIGN)));
+
+/* Sets the recent blockhash of transaction i (as created by
+   make_transaction) to the 32 byte hash pointed to by hash. */
+static void
+set_recent_blockhash( ulong         i,
+                      uchar const * hash ) {
+  fd_txn_t * t = (fd_txn_t*) txn_scratch[ i ];
+  t->recent_blockhash_off = (ushort)payload_sz[ i ];
+  fd_memcpy( payload_scratch[ i ]+payload_sz[ i ], hash, 32UL );
+  payload_sz[ i ] += 32UL;
+}
+
+/* Advances tbl to height by inserting made up blockhashes */
+static void
+advance_blockhash_tbl( fd_pack_blockhash_tbl_t * tbl,
+                       ulong                     height ) {
+  while( fd_pack_blockhash_tbl_height( tbl )<height ) {
+    uchar hash[ 32 ]; memset( hash, 'Z', 32UL );
+    ulong h = fd_pack_blockhash_tbl_height( tbl );
+    fd_memcpy( hash, &h, sizeof(ulong) );
+    fd_pack_blockhash_tbl_insert( tbl, hash );
+  }
+}
+
+static void
+test_expiry( void ) {
+  FD_LOG_NOTICE(( "TEST EXPIRY" ));
+  fd_pack_t * pack = init_all( 1024UL, 1UL, 128UL, 0, &outcome );
+
+  FD_TEST( fd_pack_blockhash_tbl_footprint( 1024UL )<=sizeof(blockhash_tbl_scratch) );
+  FD_TEST( !fd_pack_blockhash_tbl_footprint( 1023UL ) );
+  FD_TEST( !fd_pack_blockhash_tbl_footprint(    2UL ) );
+  fd_pack_blockhash_tbl_t * tbl = fd_pack_blockhash_tbl_join( fd_pack_blockhash_tbl_new( blockhash_tbl_scratch, 1024UL ) );
+  FD_TEST( tbl );
+
+  uchar hash_a[ 32 ]; memset( hash_a, 'a', 32UL );
+  uchar hash_b[ 32 ]; memset( hash_b, 'b', 32UL );
+  uchar hash_c[ 32 ]; memset( hash_c, 'c', 32UL );
+
+  FD_TEST( fd_pack_blockhash_tbl_height( tbl )==0UL );
+  fd_pack_blockhash_tbl_insert( tbl, hash_a );
+  fd_pack_blockhash_tbl_insert( tbl, hash_c );
+  fd_pack_blockhash_tbl_insert( tbl, hash_a ); /* no effect */
+  FD_TEST( fd_pack_blockhash_tbl_height( tbl )==2UL );
+  FD_TEST( fd_pack_blockhash_tbl_query( tbl, hash_a )==1UL );
+  FD_TEST( fd_pack_blockhash_tbl_query( tbl, hash_b )==0UL );
+  FD_TEST( fd_pack_blockhash_tbl_query( tbl, hash_c )==2UL );
+
+  ulong i = 0UL;
+  make_transaction( i, 500U, 10.0, "A", "B" ); set_recent_blockhash( i, hash_a ); i++;
+  make_transaction( i, 500U,  9.0, "C", "D" ); set_recent_blockhash( i, hash_b ); i++;
+  make_transaction( i, 500U,  8.0, "E", "F" ); set_recent_blockhash( i, hash_c ); i++;
+
+  /* Without a table, transactions never expire */
+  FD_TEST( insert( 0UL, pack )>=0 );
+  FD_TEST( fd_pack_expire_before( pack, 1UL )==0UL );
+  FD_TEST( fd_pack_delete_transaction( pack, fd_txn_get_signatures( (fd_txn_t *)txn_scratch[0], payload_scratch[0] ) ) );
+
+  fd_pack_set_blockhash_tbl( pack, tbl );
+  for( ulong j=0UL; j<3UL; j++ ) FD_TEST( insert( j, pack )>=0 );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==3UL );
+
+  /* Blockhash a can be used until height 151 */
+  advance_blockhash_tbl( tbl, 151UL );
+  FD_TEST( fd_pack_expire_before( pack, 151UL )==0UL );
+  advance_blockhash_tbl( tbl, 152UL );
+  FD_TEST( fd_pack_expire_before( pack, 152UL )==1UL );
+  FD_TEST( fd_pack_expire_before( pack, 152UL )==0UL );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==2UL );
+
+  make_transaction( i, 500U, 10.0, "G", "H" ); set_recent_blockhash( i, hash_a );
+  FD_TEST( insert( i, pack )==FD_PACK_INSERT_REJECT_EXPIRED );
+  i++;
+
+  /* The unknown blockhash gets the longest possible lifetime, as if it
+     were the most recent blockhash when the transaction was inserted,
+     so it expires together with blockhash c. */
+  advance_blockhash_tbl( tbl, 153UL );
+  FD_TEST( fd_pack_expire_before( pack, 153UL )==2UL );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+  uchar hash_d[ 32 ]; memset( hash_d, 'd', 32UL );
+  fd_pack_blockhash_tbl_insert( tbl, hash_d );
+  FD_TEST( fd_pack_blockhash_tbl_query( tbl, hash_d )==154UL );
+
+  /* Scheduled transactions don't expire */
+  make_transaction( i, 500U, 10.0, "O", "P" ); set_recent_blockhash( i, hash_d );
+  FD_TEST( insert( i, pack )>=0 );
+  i++;
+  FD_TEST( fd_pack_schedule_next_microblock( pack, 300000UL, 0.0f, 0UL, outcome.results )==1UL );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+  fd_pack_microblock_complete( pack, 0UL );
+
+  /* Insert catches up with the table, even if expire_before isn't
+     called. */
+  make_transaction( i, 500U, 10.0, "I", "J" ); set_recent_blockhash( i, hash_b );
+  FD_TEST( insert( i, pack )>=0 );
+  i++;
+  make_transaction( i, 500U, 10.0, "K", "L" ); set_recent_blockhash( i, hash_d );
+  FD_TEST( insert( i, pack )>=0 );
+  i++;
+  advance_blockhash_tbl( tbl, 305UL );
+  make_transaction( i, 500U, 10.0, "M", "N" ); set_recent_blockhash( i, hash_d );
+  FD_TEST( insert( i, pack )==FD_PACK_INSERT_REJECT_EXPIRED );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+  FD_TEST( fd_pack_expire_before( pack, 305UL )==0UL );
+
+  fd_pack_set_blockhash_tbl( pack, NULL );
+  fd_pack_blockhash_tbl_delete( fd_pack_blockhash_tbl_leave( tbl ) );
+}
+
 void performance_test( int extra_bench ) {
   ulong i = 0UL;
   FD_LOG_NOTICE(( "TEST PERFORMANCE" ));
@@ -417,7 +788,7 @@ void performance_test( int extra_bench ) {
 #define ITER_CNT 10UL
 #define WARMUP    2UL
   for( ulong heap_sz=16UL; heap_sz<=max_heap_sz; heap_sz = fd_ulong_min( heap_sz*2UL, heap_sz+linear_inc ) ) {
-    ulong footprint = fd_pack_footprint( heap_sz, 1UL, 3UL );
+    ulong footprint = fd_pack_footprint( heap_sz, 1UL, 3UL, 0 );
     void * _mem;
     if( FD_LIKELY( wksp ) ) _mem = fd_wksp_alloc_laddr( wksp, fd_pack_align(), footprint, 4UL );
     else                    { FD_TEST( footprint<PACK_SCRATCH_SZ ); _mem = pack_scratch; }
@@ -431,7 +802,7 @@ void performance_test( int extra_bench ) {
     long schedule  = 0L;
 
     for( ulong iter=0UL; iter<ITER_CNT; iter++ ) {
-      fd_pack_t * pack = fd_pack_join( fd_pack_new( _mem, heap_sz, 1UL, 3UL, heap_sz, rng ) );
+      fd_pack_t * pack = fd_pack_join( fd_pack_new( _mem, heap_sz, 1UL, 3UL, 0, heap_sz, rng ) );
 
       FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
 
@@ -565,7 +936,7 @@ void performance_test( int extra_bench ) {
 
 void heap_overflow_test( void ) {
   FD_LOG_NOTICE(( "TEST HEAP OVERFLOW" ));
-  fd_pack_t * pack = init_all( 1024UL, 1UL, 2UL, &outcome );
+  fd_pack_t * pack = init_all( 1024UL, 1UL, 2UL, 0, &outcome );
   /* Insert a bunch of low-paying transactions */
   for( ulong j=0UL; j<1024UL; j++ ) {
     make_transaction( j, 800U, 4.0, "ABC", "DEF" );
@@ -607,7 +978,7 @@ test_gap( void ) {
   FD_LOG_NOTICE(( "TEST GAP" ));
 
   for( ulong gap=1UL; gap<=FD_PACK_MAX_BANK_TILES; gap++ ) {
-    fd_pack_t * pack = init_all( 10240UL, gap, 2UL, &outcome );
+    fd_pack_t * pack = init_all( 10240UL, gap, 2UL, 0, &outcome );
 
     ulong i=0UL;
     ulong reward1 = make_transaction( i,  500U, 11.0, "A", "B" );      insert( i++, pack );
@@ -629,7 +1000,7 @@ test_limits( void ) {
 
   /* Test the max txn per microblock limit */
   for( ulong max=1UL; max<=15UL; max++ ) {
-    fd_pack_t * pack = init_all( 1024UL, 1UL, max, &outcome );
+    fd_pack_t * pack = init_all( 1024UL, 1UL, max, 0, &outcome );
 
     for( ulong i=0UL; i<max*2UL; i++ ) {
       /* The votes are all non-conflicting */
@@ -644,7 +1015,7 @@ test_limits( void ) {
 
   /* Test the CU limit */
   if( 1 ) {
-    fd_pack_t * pack = init_all( 1024UL, 1UL, 1024UL, &outcome );
+    fd_pack_t * pack = init_all( 1024UL, 1UL, 1024UL, 0, &outcome );
 
     for( ulong i=0UL; i<1024UL; i++ ) {
       /* The votes are all non-conflicting */
@@ -663,7 +1034,7 @@ test_limits( void ) {
 
   /* Test the block vote limit */
   if( 1 ) {
-    fd_pack_t * pack = init_all( 1024UL, 1UL, 1024UL, &outcome );
+    fd_pack_t * pack = init_all( 1024UL, 1UL, 1024UL, 0, &outcome );
 
     for( ulong j=0UL; j<FD_PACK_MAX_VOTE_COST_PER_BLOCK/(1024UL*SAMPLE_VOTE_COST); j++ ) {
       for( ulong i=0UL; i<1024UL; i++ ) { make_vote_transaction( i ); insert( i, pack ); }
@@ -684,7 +1055,7 @@ test_limits( void ) {
 
   /* Test the block writer limit */
   if( 1 ) {
-    fd_pack_t * pack = init_all( 1024UL, 1UL, 1024UL, &outcome );
+    fd_pack_t * pack = init_all( 1024UL, 1UL, 1024UL, 0, &outcome );
     /* The limit is based on cost units, and make_transaction takes just
        compute CUs.  Add the +1 to force the rounding to make these
        close enough. */
@@ -706,7 +1077,7 @@ test_limits( void ) {
 
   /* Test the total cost block limit */
   if( 1 ) {
-    fd_pack_t * pack = init_all( 1024UL, 1UL, 1024UL, &outcome );
+    fd_pack_t * pack = init_all( 1024UL, 1UL, 1024UL, 0, &outcome );
     /* The limit is based on cost units, and make_transaction takes just
        compute CUs.  Add the +1 to force the rounding to make these
        close enough. */
@@ -734,7 +1105,7 @@ test_limits( void ) {
 static inline void
 test_reject_writes_to_sysvars( void ) {
   FD_LOG_NOTICE(( "TEST SYSVARS" ));
-  fd_pack_t * pack = init_all( 1024UL, 1UL, 128UL, &outcome );
+  fd_pack_t * pack = init_all( 1024UL, 1UL, 128UL, 0, &outcome );
   /* First part of list generated with:
         for id in ALL_IDS.iter() {
             println!("{}", id.to_string());
@@ -803,6 +1174,9 @@ main( int     argc,
   test_gap();
   test_limits();
   test_reject_writes_to_sysvars();
+  test_address_lookup_tables();
+  test_fee_cache();
+  test_expiry();
   performance_test( extra_benchmark );
 
   fd_rng_delete( fd_rng_leave( rng ) );
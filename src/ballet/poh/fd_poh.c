@@ -1,17 +1,218 @@
 #include "fd_poh.h"
 
+/* Every hash in the PoH chain is SHA-256 of the 32 byte previous hash,
+   so each one is exactly one compression of a block whose first half
+   is the previous hash and whose second half is the same fixed padding
+   (0x80, zeros and the 256 bit message length).  Moreover, the message
+   words of that block are the big endian words of the previous hash,
+   which are just the state words the previous compression produced.
+   fd_poh_append exploits this by keeping the chain in state words in
+   registers for all n iterations, only converting from and to bytes at
+   either end, and never running the generic SHA-256 init / append /
+   fini buffer management. */
+
+static uint const fd_poh_private_k[64] __attribute__((aligned(16))) = {
+  0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U, 0x923f82a4U, 0xab1c5ed5U,
+  0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U, 0x72be5d74U, 0x80deb1feU, 0x9bdc06a7U, 0xc19bf174U,
+  0xe49b69c1U, 0xefbe4786U, 0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU, 0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU,
+  0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U, 0xc6e00bf3U, 0xd5a79147U, 0x06ca6351U, 0x14292967U,
+  0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU, 0x53380d13U, 0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U,
+  0xa2bfe8a1U, 0xa81a664bU, 0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U,
+  0x19a4c116U, 0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU, 0x5b9cca4fU, 0x682e6ff3U,
+  0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U, 0x90befffaU, 0xa4506cebU, 0xbef9a3f7U, 0xc67178f2U,
+};
+
+#ifndef FD_POH_APPEND_IMPL
+#if FD_HAS_SHANI
+#define FD_POH_APPEND_IMPL 1
+#else
+#define FD_POH_APPEND_IMPL 0
+#endif
+#endif
+
+#if FD_POH_APPEND_IMPL==0
+
+/* fd_poh_append_ref is a portable implementation.  It is the reference
+   SHA-256 compression from fd_sha256 with the padding words of the
+   block folded in as constants. */
+
+static void
+fd_poh_append_ref( uint * state,
+                   ulong  n ) {
+
+# define ROTATE     fd_uint_rotate_left
+# define Sigma0(x)  (ROTATE((x),30) ^ ROTATE((x),19) ^ ROTATE((x),10))
+# define Sigma1(x)  (ROTATE((x),26) ^ ROTATE((x),21) ^ ROTATE((x),7))
+# define sigma0(x)  (ROTATE((x),25) ^ ROTATE((x),14) ^ ((x)>>3))
+# define sigma1(x)  (ROTATE((x),15) ^ ROTATE((x),13) ^ ((x)>>10))
+# define Ch(x,y,z)  (((x) & (y)) ^ ((~(x)) & (z)))
+# define Maj(x,y,z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+
+  uint s0 = state[0]; uint s1 = state[1]; uint s2 = state[2]; uint s3 = state[3];
+  uint s4 = state[4]; uint s5 = state[5]; uint s6 = state[6]; uint s7 = state[7];
+
+  while( n-- ) {
+    uint X[16] = { s0, s1, s2, s3, s4, s5, s6, s7, 0x80000000U, 0U, 0U, 0U, 0U, 0U, 0U, 256U };
+
+    uint a = 0x6a09e667U;
+    uint b = 0xbb67ae85U;
+    uint c = 0x3c6ef372U;
+    uint d = 0xa54ff53aU;
+    uint e = 0x510e527fU;
+    uint f = 0x9b05688cU;
+    uint g = 0x1f83d9abU;
+    uint h = 0x5be0cd19U;
+
+    ulong i;
+    for( i=0UL; i<16UL; i++ ) {
+      uint T1 = X[i] + h + Sigma1(e) + Ch(e, f, g) + fd_poh_private_k[i];
+      uint T2 = Sigma0(a) + Maj(a, b, c);
+      h = g;
+      g = f;
+      f = e;
+      e = d + T1;
+      d = c;
+      c = b;
+      b = a;
+      a = T1 + T2;
+    }
+    for( ; i<64UL; i++ ) {
+      X[i & 0xfUL] += sigma0( X[(i+1UL) & 0xfUL] ) + sigma1( X[(i+14UL) & 0xfUL] ) + X[(i+9UL) & 0xfUL];
+      uint T1 = X[i & 0xfUL] + h + Sigma1(e) + Ch(e, f, g) + fd_poh_private_k[i];
+      uint T2 = Sigma0(a) + Maj(a, b, c);
+      h = g;
+      g = f;
+      f = e;
+      e = d + T1;
+      d = c;
+      c = b;
+      b = a;
+      a = T1 + T2;
+    }
+
+    s0 = 0x6a09e667U + a;
+    s1 = 0xbb67ae85U + b;
+    s2 = 0x3c6ef372U + c;
+    s3 = 0xa54ff53aU + d;
+    s4 = 0x510e527fU + e;
+    s5 = 0x9b05688cU + f;
+    s6 = 0x1f83d9abU + g;
+    s7 = 0x5be0cd19U + h;
+  }
+
+  state[0] = s0; state[1] = s1; state[2] = s2; state[3] = s3;
+  state[4] = s4; state[5] = s5; state[6] = s6; state[7] = s7;
+
+# undef ROTATE
+# undef Sigma0
+# undef Sigma1
+# undef sigma0
+# undef sigma1
+# undef Ch
+# undef Maj
+
+}
+
 fd_poh_state_t *
 fd_poh_append( fd_poh_state_t * poh,
                ulong            n ) {
-  fd_sha256_t sha;
+  uint state[8];
+  for( ulong i=0UL; i<8UL; i++ ) state[i] = fd_uint_bswap( FD_LOAD( uint, poh->state+4UL*i ) );
+  fd_poh_append_ref( state, n );
+  for( ulong i=0UL; i<8UL; i++ ) FD_STORE( uint, poh->state+4UL*i, fd_uint_bswap( state[i] ) );
+  return poh;
+}
+
+#elif FD_POH_APPEND_IMPL==1
+
+/* The SHA extensions implementation follows the same round structure
+   as fd_sha256_core_shaext.  sha256rnds2 wants the working variables
+   packed as [F E B A] and [H G D C] (lane 0 first) rather than in the
+   natural order, so the IV is stored that way, and the natural order
+   message words for the next iteration are unpacked from the packed
+   state with two shuffles each. */
+
+#include "../../util/simd/fd_sse.h"
+
+static uint const fd_poh_private_iv[8] __attribute__((aligned(16))) = {
+  0x9b05688cU, 0x510e527fU, 0xbb67ae85U, 0x6a09e667U, /* F E B A */
+  0x5be0cd19U, 0x1f83d9abU, 0xa54ff53aU, 0x3c6ef372U  /* H G D C */
+};
+
+static uint const fd_poh_private_pad[8] __attribute__((aligned(16))) = {
+  0x80000000U, 0U, 0U, 0U,
+  0U,          0U, 0U, 256U
+};
+
+/* FD_POH_QUAD does 4 rounds using message words cur.  If msg2, it
+   finishes the schedule of the message words nxt, using the previous
+   message words prev.  If msg1, it starts the schedule of the message
+   words that will follow nxt, which live in prev. */
+
+#define FD_POH_QUAD( k, cur, prev, nxt, msg2, msg1 ) do {                                    \
+    vu_t _m = vu_add( (cur), vu_ld( fd_poh_private_k+(k) ) );                                \
+    st1 = _mm_sha256rnds2_epu32( st1, st0, _m );                                             \
+    if( msg2 ) (nxt) = _mm_sha256msg2_epu32( vu_add( (nxt), _mm_alignr_epi8( (cur), (prev), 4 ) ), (cur) ); \
+    st0 = _mm_sha256rnds2_epu32( st0, st1, vu_permute( _m, 2,3,0,0 ) );                      \
+    if( msg1 ) (prev) = _mm_sha256msg1_epu32( (prev), (cur) );                               \
+  } while(0)
+
+fd_poh_state_t *
+fd_poh_append( fd_poh_state_t * poh,
+               ulong            n ) {
+  vu_t iv0  = vu_ld( fd_poh_private_iv      );
+  vu_t iv1  = vu_ld( fd_poh_private_iv +4UL );
+  vu_t pad0 = vu_ld( fd_poh_private_pad     );
+  vu_t pad1 = vu_ld( fd_poh_private_pad+4UL );
+
+  /* w0 and w1 are the first 8 message words of the next block, i.e.
+     the current hash as state words in natural order. */
+  vu_t w0 = vu_bswap( vu_ldu( poh->state      ) );
+  vu_t w1 = vu_bswap( vu_ldu( poh->state+16UL ) );
+
   while( n-- ) {
-    fd_sha256_init( &sha );
-    fd_sha256_append( &sha, poh->state, FD_SHA256_HASH_SZ );
-    fd_sha256_fini( &sha, poh->state );
+    vu_t m0 = w0;
+    vu_t m1 = w1;
+    vu_t m2 = pad0;
+    vu_t m3 = pad1;
+    vu_t st0 = iv0;
+    vu_t st1 = iv1;
+
+    FD_POH_QUAD(  0UL, m0, m3, m1, 0, 0 );
+    FD_POH_QUAD(  4UL, m1, m0, m2, 0, 1 );
+    FD_POH_QUAD(  8UL, m2, m1, m3, 0, 1 );
+    FD_POH_QUAD( 12UL, m3, m2, m0, 1, 1 );
+    FD_POH_QUAD( 16UL, m0, m3, m1, 1, 1 );
+    FD_POH_QUAD( 20UL, m1, m0, m2, 1, 1 );
+    FD_POH_QUAD( 24UL, m2, m1, m3, 1, 1 );
+    FD_POH_QUAD( 28UL, m3, m2, m0, 1, 1 );
+    FD_POH_QUAD( 32UL, m0, m3, m1, 1, 1 );
+    FD_POH_QUAD( 36UL, m1, m0, m2, 1, 1 );
+    FD_POH_QUAD( 40UL, m2, m1, m3, 1, 1 );
+    FD_POH_QUAD( 44UL, m3, m2, m0, 1, 1 );
+    FD_POH_QUAD( 48UL, m0, m3, m1, 1, 1 );
+    FD_POH_QUAD( 52UL, m1, m0, m2, 1, 0 );
+    FD_POH_QUAD( 56UL, m2, m1, m3, 1, 0 );
+    FD_POH_QUAD( 60UL, m3, m2, m0, 0, 0 );
+
+    st0 = vu_add( st0, iv0 ); /* [F E B A] */
+    st1 = vu_add( st1, iv1 ); /* [H G D C] */
+
+    w0 = vu_permute( _mm_unpackhi_epi64( st1, st0 ), 3,2,1,0 ); /* [D C B A] -> [A B C D] */
+    w1 = vu_permute( _mm_unpacklo_epi64( st1, st0 ), 3,2,1,0 ); /* [H G F E] -> [E F G H] */
   }
+
+  vu_stu( poh->state,      vu_bswap( w0 ) );
+  vu_stu( poh->state+16UL, vu_bswap( w1 ) );
   return poh;
 }
 
+#undef FD_POH_QUAD
+
+#else
+#error "Unsupported FD_POH_APPEND_IMPL"
+#endif
+
 fd_poh_state_t *
 fd_poh_mixin( fd_poh_state_t * FD_RESTRICT poh,
               uchar const *    FD_RESTRICT mixin ) {
@@ -47,6 +47,24 @@ test_poh_append_one( void ) {
   }
 }
 
+/* Ensure that fd_poh_append with n iterations matches hashing n times
+   with the simple hashing API, and that splitting the iterations across
+   several calls doesn't matter. */
+static void
+test_poh_append_many( void ) {
+  uchar expected[FD_SHA256_HASH_SZ];
+  for( ulong i=0UL; i<FD_SHA256_HASH_SZ; i++ ) expected[i] = (uchar)(0x40UL+i);
+
+  fd_poh_state_t poh = {0};
+  fd_memcpy( poh.state, expected, FD_SHA256_HASH_SZ );
+
+  for( ulong n=1UL; n<=64UL; n++ ) {
+    for( ulong i=0UL; i<n; i++ ) fd_sha256_hash( expected, FD_SHA256_HASH_SZ, expected );
+    fd_poh_append( &poh, n );
+    FD_TEST( !memcmp( poh.state, expected, FD_SHA256_HASH_SZ ) );
+  }
+}
+
 /* Ensure that fd_poh_mixin matches the simple hashing API. */
 static void
 test_poh_mixin( void ) {
@@ -195,6 +213,7 @@ int main( int argc,
 
   test_poh_append_nop();
   test_poh_append_one();
+  test_poh_append_many();
 
   test_poh_mixin();
 
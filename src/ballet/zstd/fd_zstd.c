@@ -25,6 +25,14 @@ fd_zstd_peek( fd_zstd_peek_t * peek,
   return peek;
 }
 
+ulong
+fd_zstd_frame_sz( void const * buf,
+                  ulong        bufsz ) {
+  ulong const sz = ZSTD_findFrameCompressedSize( buf, bufsz );
+  if( FD_UNLIKELY( ZSTD_isError( sz ) ) ) return ULONG_MAX;
+  return sz;
+}
+
 ulong
 fd_zstd_dstream_align( void ) {
   return FD_ZSTD_DSTREAM_ALIGN;
@@ -132,3 +140,110 @@ fd_zstd_dstream_read( fd_zstd_dstream_t *     dstream,
   *out_p = (void *      )((ulong)out_start + out_buf.pos);
   return rc==0UL ? -1 /* frame complete */ : 0 /* still working */;
 }
+
+ulong
+fd_zstd_cstream_align( void ) {
+  return FD_ZSTD_CSTREAM_ALIGN;
+}
+
+ulong
+fd_zstd_cstream_footprint( int level ) {
+  return offsetof(fd_zstd_cstream_t, mem) + ZSTD_estimateCStreamSize( level );
+}
+
+fd_zstd_cstream_t *
+fd_zstd_cstream_new( void * mem,
+                     int    level ) {
+  fd_zstd_cstream_t * cstream = mem;
+  cstream->mem_sz = ZSTD_estimateCStreamSize( level );
+
+  ZSTD_CCtx * ctx = ZSTD_initStaticCStream( cstream->mem, cstream->mem_sz );
+  if( FD_UNLIKELY( !ctx ) ) {
+    /* should never happen */
+    FD_LOG_WARNING(( "ZSTD_initStaticCStream failed (level=%d)", level ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( (ulong)ctx != (ulong)cstream->mem ) )
+    FD_LOG_CRIT(( "ZSTD_initStaticCStream returned unexpected pointer (ctx=%p, mem=%p)",
+                  (void *)ctx, (void *)cstream->mem ));
+
+  ulong const rc = ZSTD_CCtx_setParameter( ctx, ZSTD_c_compressionLevel, level );
+  if( FD_UNLIKELY( ZSTD_isError( rc ) ) ) {
+    FD_LOG_WARNING(( "ZSTD_CCtx_setParameter(level=%d) failed: %s", level, ZSTD_getErrorName( rc ) ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  cstream->magic = FD_ZSTD_CSTREAM_MAGIC;
+  FD_COMPILER_MFENCE();
+  return cstream;
+}
+
+static ZSTD_CCtx *
+fd_zstd_cstream_ctx( fd_zstd_cstream_t * cstream ) {
+  if( FD_UNLIKELY( cstream->magic != FD_ZSTD_CSTREAM_MAGIC ) )
+    FD_LOG_CRIT(( "fd_zstd_cstream_t at %p has invalid magic (memory corruption?)", (void *)cstream ));
+  return (ZSTD_CCtx *)fd_type_pun( cstream->mem );
+}
+
+void *
+fd_zstd_cstream_delete( fd_zstd_cstream_t * cstream ) {
+
+  if( FD_UNLIKELY( !cstream ) ) return NULL;
+  fd_zstd_cstream_ctx( cstream );
+
+  /* No need to inform libzstd */
+
+  FD_COMPILER_MFENCE();
+  cstream->magic  = 0UL;
+  cstream->mem_sz = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return (void *)cstream;
+}
+
+void
+fd_zstd_cstream_reset( fd_zstd_cstream_t * cstream ) {
+  ZSTD_CCtx_reset( fd_zstd_cstream_ctx( cstream ), ZSTD_reset_session_only );
+}
+
+int
+fd_zstd_cstream_compress( fd_zstd_cstream_t *     cstream,
+                          uchar const ** restrict in_p,
+                          uchar const *           in_end,
+                          uchar ** restrict       out_p,
+                          uchar *                 out_end,
+                          int                     end,
+                          ulong *                 opt_errcode ) {
+
+  ulong _opt_errcode[1];
+  opt_errcode = opt_errcode ? opt_errcode : _opt_errcode;
+
+  uchar const * in_start  = *in_p;
+  uchar *       out_start = *out_p;
+
+  if( FD_UNLIKELY( ( in_start  > in_end  ) |
+                   ( out_start > out_end ) ) )
+    return EINVAL;
+
+  ZSTD_inBuffer in_buf =
+    { .src  = in_start,
+      .size = (ulong)in_end - (ulong)in_start,
+      .pos  = 0UL };
+  ZSTD_outBuffer out_buf =
+    { .dst  = out_start,
+      .size = (ulong)out_end - (ulong)out_start,
+      .pos  = 0UL };
+
+  ZSTD_CCtx * ctx = fd_zstd_cstream_ctx( cstream );
+  ulong const rc = ZSTD_compressStream2( ctx, &out_buf, &in_buf, end ? ZSTD_e_end : ZSTD_e_continue );
+  if( FD_UNLIKELY( ZSTD_isError( rc ) ) ) {
+    FD_LOG_WARNING(( "err: %s", ZSTD_getErrorName( rc ) ));
+    *opt_errcode = rc;
+    return EPROTO;
+  }
+
+  *in_p  = (void const *)((ulong)in_start  + in_buf.pos );
+  *out_p = (void *      )((ulong)out_start + out_buf.pos);
+  return (end && rc==0UL) ? -1 /* frame complete */ : 0 /* still working */;
+}
@@ -86,6 +86,18 @@ fd_zstd_peek( fd_zstd_peek_t * peek,
               void const *     buf,
               ulong            bufsz );
 
+/* fd_zstd_frame_sz returns the compressed size of the frame (regular
+   or skippable) starting at buf, including its header and checksum.
+   [buf,buf+bufsz) is a fragment containing the frame (and possibly
+   more data beyond).  Only walks block headers, so this is much cheaper
+   than decompressing the frame and can be used to split a stream of
+   frames.  Returns ULONG_MAX if the fragment does not contain an entire
+   frame or if the frame is invalid. */
+
+ulong
+fd_zstd_frame_sz( void const * buf,
+                  ulong        bufsz );
+
 /* fd_zstd_dstream_{align,footprint} return the parameters of the
    memory region backing a fd_zstd_dstream_t.  max_window_sz is the
    largest window size that this object is able to handle. */
@@ -152,6 +164,73 @@ fd_zstd_dstream_read( fd_zstd_dstream_t *     dstream,
                       uchar *                 out_end,
                       ulong *                 opt_errcode );
 
+/* Compress API *******************************************************/
+
+/* fd_zstd_cstream_t provides streaming compression into Zstandard
+   frames.  Handles one frame at a time. */
+
+struct fd_zstd_cstream;
+typedef struct fd_zstd_cstream fd_zstd_cstream_t;
+
+/* fd_zstd_cstream_{align,footprint} return the parameters of the
+   memory region backing a fd_zstd_cstream_t.  level is the compression
+   level (higher levels require a larger footprint). */
+
+FD_FN_CONST ulong
+fd_zstd_cstream_align( void );
+
+FD_FN_CONST ulong
+fd_zstd_cstream_footprint( int level );
+
+/* fd_zstd_cstream_new creates a new cstream object backed by the memory
+   region at mem.  mem matches align/footprint requirements for the
+   given level.  Returns a handle to the newly created cstream object on
+   success (not just a simple cast of mem).  The cstream starts a new
+   frame on return.  On failure, returns NULL. */
+
+fd_zstd_cstream_t *
+fd_zstd_cstream_new( void * mem,
+                     int    level );
+
+/* fd_zstd_cstream_delete destroys the cstream object and releases its
+   memory region back to the caller.  Returns pointer to memory region
+   on success (same as provided in call to new).  Acts as a no-op if
+   cstream==NULL. */
+
+void *
+fd_zstd_cstream_delete( fd_zstd_cstream_t * cstream );
+
+/* fd_zstd_cstream_reset resets the state of a cstream object, such that
+   it discards the current frame and starts a new one. */
+
+void
+fd_zstd_cstream_reset( fd_zstd_cstream_t * cstream );
+
+/* fd_zstd_cstream_compress compresses a fragment of data into the
+   current frame.  The in/out pointer semantics are those of
+   fd_zstd_dstream_read (with the data flowing the other way).
+
+   If end is zero, libzstd may buffer some of the consumed data
+   internally.  If end is non-zero, the current frame is ended after
+   consuming all input.  The caller should retry with more output space
+   until the frame was fully flushed.
+
+   Returns fd_io compatible error code.  Returns 0 if the compressor has
+   made progress and is expecting more data (or output space).  Returns
+   -1 if end is non-zero and the frame was fully flushed, in which case
+   the next call starts a new frame.  Returns EPROTO on error.  The
+   caller should reset the cstream in this case.  If opt_errcode!=NULL
+   and an error occured, *opt_errcode is set accordingly. */
+
+int
+fd_zstd_cstream_compress( fd_zstd_cstream_t *     cstream,
+                          uchar const ** restrict in_p,
+                          uchar const *           in_end,
+                          uchar ** restrict       out_p,
+                          uchar *                 out_end,
+                          int                     end,
+                          ulong *                 opt_errcode );
+
 FD_PROTOTYPES_END
 
 #endif /* FD_HAS_ZSTD */
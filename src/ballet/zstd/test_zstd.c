@@ -3,6 +3,7 @@
 #include "../../util/fd_util.h"
 #include <stdalign.h>
 #include <stddef.h>
+#include <stdlib.h>
 
 #if !FD_HAS_ZSTD
 #error "fd_compress requires Zstandard"
@@ -12,6 +13,8 @@
 
 FD_STATIC_ASSERT( alignof ( fd_zstd_dstream_t      )==FD_ZSTD_DSTREAM_ALIGN, layout );
 FD_STATIC_ASSERT( offsetof( fd_zstd_dstream_t, mem )==FD_ZSTD_DSTREAM_ALIGN, layout );
+FD_STATIC_ASSERT( alignof ( fd_zstd_cstream_t      )==FD_ZSTD_CSTREAM_ALIGN, layout );
+FD_STATIC_ASSERT( offsetof( fd_zstd_cstream_t, mem )==FD_ZSTD_CSTREAM_ALIGN, layout );
 
 /* Test vectors */
 
@@ -130,6 +133,90 @@ test_decompress( void ) {
   FD_TEST( dstream->magic==0UL );
 }
 
+static void
+test_compress( void ) {
+  FD_TEST( fd_zstd_cstream_align()==FD_ZSTD_CSTREAM_ALIGN );
+
+  int   level  = 3;
+  ulong mem_sz = fd_zstd_cstream_footprint( level );
+  uchar * mem  = aligned_alloc( FD_ZSTD_CSTREAM_ALIGN, fd_ulong_align_up( mem_sz, FD_ZSTD_CSTREAM_ALIGN ) );
+  FD_TEST( mem );
+
+  fd_zstd_cstream_t * cstream = fd_zstd_cstream_new( mem, level );
+  FD_TEST( cstream );
+  FD_TEST( cstream->magic==FD_ZSTD_CSTREAM_MAGIC );
+  FD_TEST( cstream->mem_sz + sizeof(fd_zstd_cstream_t) == mem_sz );
+
+  ulong window_sz = 1UL<<21;
+  ulong dmem_sz   = fd_zstd_dstream_footprint( window_sz );
+  uchar dmem[dmem_sz];
+  fd_zstd_dstream_t * dstream = fd_zstd_dstream_new( dmem, window_sz );
+  FD_TEST( dstream );
+
+  /* Compress a few messages as independent frames, with output space
+     provided byte by byte for the last one, then decompress the
+     concatenation */
+
+  static uchar msg[ 4096 ];
+  for( ulong j=0UL; j<sizeof(msg); j++ ) msg[j] = (uchar)( (j*j)>>5 );
+
+  uchar   comp[ 16384 ];
+  uchar * comp_cur = comp;
+  for( ulong k=0UL; k<3UL; k++ ) {
+    uchar const * in_cur = msg;
+    int rc = fd_zstd_cstream_compress( cstream, &in_cur, msg+sizeof(msg), &comp_cur, comp+sizeof(comp), 0, NULL );
+    FD_TEST( rc==0 );
+    FD_TEST( in_cur==msg+sizeof(msg) );
+    for( ulong j=0UL; j<sizeof(comp); j++ ) {
+      uchar * out_end = k==2UL ? comp_cur+1 : comp+sizeof(comp);
+      rc = fd_zstd_cstream_compress( cstream, &in_cur, in_cur, &comp_cur, out_end, 1, NULL );
+      FD_TEST( rc<=0 );
+      if( rc==-1 ) break;
+    }
+    FD_TEST( rc==-1 );
+  }
+  FD_TEST( comp_cur<comp+sizeof(comp) );
+
+  uchar         out[ 4096 ];
+  uchar const * in_cur = comp;
+  for( ulong k=0UL; k<3UL; k++ ) {
+    uchar * out_cur = out;
+    int rc = fd_zstd_dstream_read( dstream, &in_cur, comp_cur, &out_cur, out+sizeof(out), NULL );
+    FD_TEST( rc==-1 );
+    FD_TEST( out_cur==out+sizeof(out) );
+    FD_TEST( 0==memcmp( out, msg, sizeof(msg) ) );
+  }
+  FD_TEST( in_cur==comp_cur );
+
+  /* Abort partial compress */
+
+  do {
+    uchar const * msg_cur = msg;
+    comp_cur = comp;
+    int rc = fd_zstd_cstream_compress( cstream, &msg_cur, msg+17, &comp_cur, comp+sizeof(comp), 0, NULL );
+    FD_TEST( rc==0 );
+
+    fd_zstd_cstream_reset( cstream );
+    comp_cur = comp;
+
+    msg_cur = msg;
+    rc = fd_zstd_cstream_compress( cstream, &msg_cur, msg+4, &comp_cur, comp+sizeof(comp), 1, NULL );
+    FD_TEST( rc==-1 );
+
+    in_cur = comp;
+    uchar * out_cur = out;
+    rc = fd_zstd_dstream_read( dstream, &in_cur, comp_cur, &out_cur, out+sizeof(out), NULL );
+    FD_TEST( rc==-1 );
+    FD_TEST( out_cur==out+4 );
+    FD_TEST( 0==memcmp( out, msg, 4 ) );
+  } while(0);
+
+  FD_TEST( fd_zstd_dstream_delete( dstream )==dmem );
+  FD_TEST( fd_zstd_cstream_delete( cstream )==mem );
+  FD_TEST( cstream->magic==0UL );
+  free( mem );
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -147,7 +234,20 @@ main( int     argc,
              ( _peek->frame_content_sz   == ULONG_MAX  ) );
   }
 
+  FD_TEST( fd_zstd_frame_sz( test_zstd_comp_0, 0UL )==ULONG_MAX );
+  for( ulong j=1UL; j<sizeof(test_zstd_comp_0); j++ )
+    FD_TEST( fd_zstd_frame_sz( test_zstd_comp_0, j )==ULONG_MAX );
+  FD_TEST( fd_zstd_frame_sz( test_zstd_comp_0, sizeof(test_zstd_comp_0) )==sizeof(test_zstd_comp_0) );
+  do {
+    uchar two[ sizeof(test_zstd_comp_0)+sizeof(test_zstd_comp_1) ];
+    fd_memcpy( two,                          test_zstd_comp_0, sizeof(test_zstd_comp_0) );
+    fd_memcpy( two+sizeof(test_zstd_comp_0), test_zstd_comp_1, sizeof(test_zstd_comp_1) );
+    FD_TEST( fd_zstd_frame_sz( two, sizeof(two) )==sizeof(test_zstd_comp_0) );
+    FD_TEST( fd_zstd_frame_sz( two+sizeof(test_zstd_comp_0), sizeof(test_zstd_comp_1) )==sizeof(test_zstd_comp_1) );
+  } while(0);
+
   test_decompress();
+  test_compress();
 
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
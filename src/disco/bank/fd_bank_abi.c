@@ -274,7 +274,8 @@ fd_bank_abi_txn_init( fd_bank_abi_txn_t * out_txn,
                       uchar *             payload,
                       ulong               payload_sz,
                       fd_txn_t *          txn,
-                      int                 is_simple_vote ) {
+                      int                 is_simple_vote,
+                      uint                alt_hash ) {
   out_txn->signatures_cnt = txn->signature_cnt;
   out_txn->signatures_cap = txn->signature_cnt;
   out_txn->signatures     = (void*)(payload + txn->signature_off);
@@ -356,6 +357,13 @@ fd_bank_abi_txn_init( fd_bank_abi_txn_t * out_txn,
     loaded_addresses->readable     = (sanitized_txn_abi_pubkey_t*)out_sidecar;
     out_sidecar += 32UL*lut_readonly_acct_cnt;
 
+    /* Pack only checked the transaction for conflicts against the
+       accounts it resolved from its own snapshot of the lookup tables,
+       which may have gone stale since. */
+    uint loaded_hash = fd_pack_alt_hash( (fd_acct_addr_t const *)loaded_addresses->writable, lut_writable_acct_cnt,
+                                         (fd_acct_addr_t const *)loaded_addresses->readable, lut_readonly_acct_cnt );
+    if( FD_UNLIKELY( loaded_hash!=alt_hash ) ) return FD_BANK_ABI_TXN_INIT_ERR_PACK_MISMATCH;
+
     ulong total_acct_cnt = fd_txn_account_cnt( txn, FD_TXN_ACCT_CAT_ALL );
     v0->is_writable_account_cache_cnt = total_acct_cnt;
     v0->is_writable_account_cache_cap = total_acct_cnt;
@@ -54,6 +54,7 @@
 #define FD_BANK_ABI_TXN_INIT_ERR_INVALID_ACCOUNT_OWNER        (3)
 #define FD_BANK_ABI_TXN_INIT_ERR_INVALID_ACCOUNT_DATA         (4)
 #define FD_BANK_ABI_TXN_INIT_ERR_INVALID_INDEX                (5)
+#define FD_BANK_ABI_TXN_INIT_ERR_PACK_MISMATCH                (6)
 
 /* fd_bank_abi_txn_t is a struct that is ABI compatible with
    `solana_sdk::transaction::sanitized::SanitizedTransaction`.  It is an
@@ -96,7 +97,10 @@ FD_PROTOTYPES_BEGIN
    load the addresses used by the transaction, which requires locking
    the "sysvar_cache" of the bank, and might contend with other bank
    threads.  It also goes and fetches the address from the related
-   address lookup program in the accounts database. */
+   address lookup program in the accounts database.  If the loaded
+   addresses don't hash to alt_hash, the alt_hash pack computed from the
+   addresses it checked for conflicts, the transaction must not be
+   executed and FD_BANK_ABI_TXN_INIT_ERR_PACK_MISMATCH is returned. */
 
 int
 fd_bank_abi_txn_init( fd_bank_abi_txn_t * out_txn,       /* Memory to place the result in, must be at least FD_BANK_ABI_TXN_FOOTPRINT bytes. */
@@ -106,7 +110,8 @@ fd_bank_abi_txn_init( fd_bank_abi_txn_t * out_txn,       /* Memory to place the
                       uchar *             payload,       /* Transaction raw wire payload. */
                       ulong               payload_sz,    /* Transaction raw wire size. */
                       fd_txn_t *          txn,           /* The Firedancer parsed transaction representation. */
-                      int                 is_simple_vote /* If the transaction is a "simple vote" or not. */ );
+                      int                 is_simple_vote,/* If the transaction is a "simple vote" or not. */
+                      uint                alt_hash       /* The alt_hash of the transaction, as populated by pack. */ );
 
 FD_PROTOTYPES_END
 
@@ -13,6 +13,7 @@ const fd_metrics_meta_t FD_METRICS_BANK[FD_METRICS_BANK_TOTAL] = {
     DECLARE_METRIC_COUNTER( BANK_TILE, TRANSACTION_LOAD_ADDRESS_TABLES_INVALID_ACCOUNT_OWNER ),
     DECLARE_METRIC_COUNTER( BANK_TILE, TRANSACTION_LOAD_ADDRESS_TABLES_INVALID_ACCOUNT_DATA ),
     DECLARE_METRIC_COUNTER( BANK_TILE, TRANSACTION_LOAD_ADDRESS_TABLES_INVALID_INDEX ),
+    DECLARE_METRIC_COUNTER( BANK_TILE, TRANSACTION_LOAD_ADDRESS_TABLES_PACK_MISMATCH ),
     DECLARE_METRIC_COUNTER( BANK_TILE, TRANSACTION_LOAD_SUCCESS ),
     DECLARE_METRIC_COUNTER( BANK_TILE, TRANSACTION_LOAD_ACCOUNT_IN_USE ),
     DECLARE_METRIC_COUNTER( BANK_TILE, TRANSACTION_LOAD_ACCOUNT_LOADED_TWICE ),
@@ -31,7 +31,7 @@
 #define FD_METRICS_COUNTER_BANK_TILE_SLOT_ACQUIRE_TOO_LOW_DESC "Result of acquiring a slot. (Too low)"
 
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ADDRESS_TABLES_OFF  (178UL)
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ADDRESS_TABLES_CNT  (6UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ADDRESS_TABLES_CNT  (7UL)
 
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ADDRESS_TABLES_SUCCESS_OFF  (178UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ADDRESS_TABLES_SUCCESS_NAME "bank_tile_transaction_load_address_tables_success"
@@ -63,585 +63,590 @@
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ADDRESS_TABLES_INVALID_INDEX_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ADDRESS_TABLES_INVALID_INDEX_DESC "Result of loading address lookup tables for a transaction. If there are multiple errors for the transaction, only the first one is reported. (The referenced index in the address lookup table does not exist.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_OFF  (184UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ADDRESS_TABLES_PACK_MISMATCH_OFF  (184UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ADDRESS_TABLES_PACK_MISMATCH_NAME "bank_tile_transaction_load_address_tables_pack_mismatch"
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ADDRESS_TABLES_PACK_MISMATCH_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ADDRESS_TABLES_PACK_MISMATCH_DESC "Result of loading address lookup tables for a transaction. If there are multiple errors for the transaction, only the first one is reported. (The accounts loaded from address lookup tables differ from the ones pack checked for conflicts.)"
+
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_OFF  (185UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_CNT  (38UL)
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_SUCCESS_OFF  (184UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_SUCCESS_OFF  (185UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_SUCCESS_NAME "bank_tile_transaction_load_success"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_SUCCESS_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_SUCCESS_DESC "Result of loading a transaction. (Success)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_IN_USE_OFF  (185UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_IN_USE_OFF  (186UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_IN_USE_NAME "bank_tile_transaction_load_account_in_use"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_IN_USE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_IN_USE_DESC "Result of loading a transaction. (An account is already being processed in another transaction in a way that does not support parallelism.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_LOADED_TWICE_OFF  (186UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_LOADED_TWICE_OFF  (187UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_LOADED_TWICE_NAME "bank_tile_transaction_load_account_loaded_twice"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_LOADED_TWICE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_LOADED_TWICE_DESC "Result of loading a transaction. (A `Pubkey` appears twice in the transaction's `account_keys`.  Instructions can reference `Pubkey`s more than once but the message must contain a list with no duplicate keys.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_NOT_FOUND_OFF  (187UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_NOT_FOUND_OFF  (188UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_NOT_FOUND_NAME "bank_tile_transaction_load_account_not_found"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_NOT_FOUND_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_NOT_FOUND_DESC "Result of loading a transaction. (Attempt to debit an account but found no record of a prior credit.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_PROGRAM_ACCOUNT_NOT_FOUND_OFF  (188UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_PROGRAM_ACCOUNT_NOT_FOUND_OFF  (189UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_PROGRAM_ACCOUNT_NOT_FOUND_NAME "bank_tile_transaction_load_program_account_not_found"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_PROGRAM_ACCOUNT_NOT_FOUND_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_PROGRAM_ACCOUNT_NOT_FOUND_DESC "Result of loading a transaction. (Attempt to load a program that does not exist.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INSUFFICIENT_FUNDS_FOR_FEE_OFF  (189UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INSUFFICIENT_FUNDS_FOR_FEE_OFF  (190UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INSUFFICIENT_FUNDS_FOR_FEE_NAME "bank_tile_transaction_load_insufficient_funds_for_fee"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INSUFFICIENT_FUNDS_FOR_FEE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INSUFFICIENT_FUNDS_FOR_FEE_DESC "Result of loading a transaction. (The fee payer `Pubkey` does not have sufficient balance to pay the fee to schedule the transaction.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ACCOUNT_FOR_FEE_OFF  (190UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ACCOUNT_FOR_FEE_OFF  (191UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ACCOUNT_FOR_FEE_NAME "bank_tile_transaction_load_invalid_account_for_fee"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ACCOUNT_FOR_FEE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ACCOUNT_FOR_FEE_DESC "Result of loading a transaction. (This account may not be used to pay transaction fees.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ALREADY_PROCESSED_OFF  (191UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ALREADY_PROCESSED_OFF  (192UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ALREADY_PROCESSED_NAME "bank_tile_transaction_load_already_processed"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ALREADY_PROCESSED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ALREADY_PROCESSED_DESC "Result of loading a transaction. (The bank has seen this transaction before. This can occur under normal operation when a UDP packet is duplicated, as a user error from a client not updating its `recent_blockhash`, or as a double-spend attack.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_BLOCKHASH_NOT_FOUND_OFF  (192UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_BLOCKHASH_NOT_FOUND_OFF  (193UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_BLOCKHASH_NOT_FOUND_NAME "bank_tile_transaction_load_blockhash_not_found"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_BLOCKHASH_NOT_FOUND_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_BLOCKHASH_NOT_FOUND_DESC "Result of loading a transaction. (The bank has not seen the given `recent_blockhash` or the transaction is too old and the `recent_blockhash` has been discarded.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INSTRUCTION_ERROR_OFF  (193UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INSTRUCTION_ERROR_OFF  (194UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INSTRUCTION_ERROR_NAME "bank_tile_transaction_load_instruction_error"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INSTRUCTION_ERROR_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INSTRUCTION_ERROR_DESC "Result of loading a transaction. (An error occurred while processing an instruction.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_CALL_CHAIN_TOO_DEEP_OFF  (194UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_CALL_CHAIN_TOO_DEEP_OFF  (195UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_CALL_CHAIN_TOO_DEEP_NAME "bank_tile_transaction_load_call_chain_too_deep"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_CALL_CHAIN_TOO_DEEP_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_CALL_CHAIN_TOO_DEEP_DESC "Result of loading a transaction. (Loader call chain is too deep.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_MISSING_SIGNATURE_FOR_FEE_OFF  (195UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_MISSING_SIGNATURE_FOR_FEE_OFF  (196UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_MISSING_SIGNATURE_FOR_FEE_NAME "bank_tile_transaction_load_missing_signature_for_fee"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_MISSING_SIGNATURE_FOR_FEE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_MISSING_SIGNATURE_FOR_FEE_DESC "Result of loading a transaction. (Transaction requires a fee but has no signature present.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ACCOUNT_INDEX_OFF  (196UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ACCOUNT_INDEX_OFF  (197UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ACCOUNT_INDEX_NAME "bank_tile_transaction_load_invalid_account_index"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ACCOUNT_INDEX_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ACCOUNT_INDEX_DESC "Result of loading a transaction. (Transaction contains an invalid account reference.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_SIGNATURE_FAILURE_OFF  (197UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_SIGNATURE_FAILURE_OFF  (198UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_SIGNATURE_FAILURE_NAME "bank_tile_transaction_load_signature_failure"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_SIGNATURE_FAILURE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_SIGNATURE_FAILURE_DESC "Result of loading a transaction. (Transaction did not pass signature verification.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_PROGRAM_FOR_EXECUTION_OFF  (198UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_PROGRAM_FOR_EXECUTION_OFF  (199UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_PROGRAM_FOR_EXECUTION_NAME "bank_tile_transaction_load_invalid_program_for_execution"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_PROGRAM_FOR_EXECUTION_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_PROGRAM_FOR_EXECUTION_DESC "Result of loading a transaction. (This program may not be used for executing instructions.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_SANITIZE_FAILURE_OFF  (199UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_SANITIZE_FAILURE_OFF  (200UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_SANITIZE_FAILURE_NAME "bank_tile_transaction_load_sanitize_failure"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_SANITIZE_FAILURE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_SANITIZE_FAILURE_DESC "Result of loading a transaction. (Transaction failed to sanitize accounts offsets correctly implies that account locks are not taken for this TX, and should not be unlocked.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_CLUSTER_MAINTENANCE_OFF  (200UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_CLUSTER_MAINTENANCE_OFF  (201UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_CLUSTER_MAINTENANCE_NAME "bank_tile_transaction_load_cluster_maintenance"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_CLUSTER_MAINTENANCE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_CLUSTER_MAINTENANCE_DESC "Result of loading a transaction. (Transactions are currently disabled due to cluster maintenance.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_BORROW_OUTSTANDING_OFF  (201UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_BORROW_OUTSTANDING_OFF  (202UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_BORROW_OUTSTANDING_NAME "bank_tile_transaction_load_account_borrow_outstanding"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_BORROW_OUTSTANDING_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ACCOUNT_BORROW_OUTSTANDING_DESC "Result of loading a transaction. (Transaction processing left an account with an outstanding borrowed reference.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_MAX_BLOCK_COST_LIMIT_OFF  (202UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_MAX_BLOCK_COST_LIMIT_OFF  (203UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_MAX_BLOCK_COST_LIMIT_NAME "bank_tile_transaction_load_would_exceed_max_block_cost_limit"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_MAX_BLOCK_COST_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_MAX_BLOCK_COST_LIMIT_DESC "Result of loading a transaction. (Transaction would exceed max Block Cost Limit.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_UNSUPPORTED_VERSION_OFF  (203UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_UNSUPPORTED_VERSION_OFF  (204UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_UNSUPPORTED_VERSION_NAME "bank_tile_transaction_load_unsupported_version"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_UNSUPPORTED_VERSION_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_UNSUPPORTED_VERSION_DESC "Result of loading a transaction. (Transaction version is unsupported.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_WRITABLE_ACCOUNT_OFF  (204UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_WRITABLE_ACCOUNT_OFF  (205UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_WRITABLE_ACCOUNT_NAME "bank_tile_transaction_load_invalid_writable_account"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_WRITABLE_ACCOUNT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_WRITABLE_ACCOUNT_DESC "Result of loading a transaction. (Transaction loads a writable account that cannot be written.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_MAX_ACCOUNT_COST_LIMIT_OFF  (205UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_MAX_ACCOUNT_COST_LIMIT_OFF  (206UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_MAX_ACCOUNT_COST_LIMIT_NAME "bank_tile_transaction_load_would_exceed_max_account_cost_limit"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_MAX_ACCOUNT_COST_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_MAX_ACCOUNT_COST_LIMIT_DESC "Result of loading a transaction. (Transaction would exceed max account limit within the block.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_ACCOUNT_DATA_BLOCK_LIMIT_OFF  (206UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_ACCOUNT_DATA_BLOCK_LIMIT_OFF  (207UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_ACCOUNT_DATA_BLOCK_LIMIT_NAME "bank_tile_transaction_load_would_exceed_account_data_block_limit"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_ACCOUNT_DATA_BLOCK_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_ACCOUNT_DATA_BLOCK_LIMIT_DESC "Result of loading a transaction. (Transaction would exceed account data limit within the block.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_TOO_MANY_ACCOUNT_LOCKS_OFF  (207UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_TOO_MANY_ACCOUNT_LOCKS_OFF  (208UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_TOO_MANY_ACCOUNT_LOCKS_NAME "bank_tile_transaction_load_too_many_account_locks"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_TOO_MANY_ACCOUNT_LOCKS_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_TOO_MANY_ACCOUNT_LOCKS_DESC "Result of loading a transaction. (Transaction locked too many accounts.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ADDRESS_LOOKUP_TABLE_NOT_FOUND_OFF  (208UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ADDRESS_LOOKUP_TABLE_NOT_FOUND_OFF  (209UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ADDRESS_LOOKUP_TABLE_NOT_FOUND_NAME "bank_tile_transaction_load_address_lookup_table_not_found"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ADDRESS_LOOKUP_TABLE_NOT_FOUND_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_ADDRESS_LOOKUP_TABLE_NOT_FOUND_DESC "Result of loading a transaction. (Address lookup table not found.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ADDRESS_LOOKUP_TABLE_OWNER_OFF  (209UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ADDRESS_LOOKUP_TABLE_OWNER_OFF  (210UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ADDRESS_LOOKUP_TABLE_OWNER_NAME "bank_tile_transaction_load_invalid_address_lookup_table_owner"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ADDRESS_LOOKUP_TABLE_OWNER_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ADDRESS_LOOKUP_TABLE_OWNER_DESC "Result of loading a transaction. (Attempted to lookup addresses from an account owned by the wrong program.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ADDRESS_LOOKUP_TABLE_DATA_OFF  (210UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ADDRESS_LOOKUP_TABLE_DATA_OFF  (211UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ADDRESS_LOOKUP_TABLE_DATA_NAME "bank_tile_transaction_load_invalid_address_lookup_table_data"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ADDRESS_LOOKUP_TABLE_DATA_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ADDRESS_LOOKUP_TABLE_DATA_DESC "Result of loading a transaction. (Attempted to lookup addresses from an invalid account.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ADDRESS_LOOKUP_TABLE_INDEX_OFF  (211UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ADDRESS_LOOKUP_TABLE_INDEX_OFF  (212UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ADDRESS_LOOKUP_TABLE_INDEX_NAME "bank_tile_transaction_load_invalid_address_lookup_table_index"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ADDRESS_LOOKUP_TABLE_INDEX_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_ADDRESS_LOOKUP_TABLE_INDEX_DESC "Result of loading a transaction. (Address table lookup uses an invalid index.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_RENT_PAYING_ACCOUNT_OFF  (212UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_RENT_PAYING_ACCOUNT_OFF  (213UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_RENT_PAYING_ACCOUNT_NAME "bank_tile_transaction_load_invalid_rent_paying_account"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_RENT_PAYING_ACCOUNT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_RENT_PAYING_ACCOUNT_DESC "Result of loading a transaction. (Transaction leaves an account with a lower balance than rent-exempt minimum.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_MAX_VOTE_COST_LIMIT_OFF  (213UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_MAX_VOTE_COST_LIMIT_OFF  (214UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_MAX_VOTE_COST_LIMIT_NAME "bank_tile_transaction_load_would_exceed_max_vote_cost_limit"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_MAX_VOTE_COST_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_MAX_VOTE_COST_LIMIT_DESC "Result of loading a transaction. (Transaction would exceed max Vote Cost Limit.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_ACCOUNT_DATA_TOTAL_LIMIT_OFF  (214UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_ACCOUNT_DATA_TOTAL_LIMIT_OFF  (215UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_ACCOUNT_DATA_TOTAL_LIMIT_NAME "bank_tile_transaction_load_would_exceed_account_data_total_limit"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_ACCOUNT_DATA_TOTAL_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_WOULD_EXCEED_ACCOUNT_DATA_TOTAL_LIMIT_DESC "Result of loading a transaction. (Transaction would exceed total account data limit.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_DUPLICATE_INSTRUCTION_OFF  (215UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_DUPLICATE_INSTRUCTION_OFF  (216UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_DUPLICATE_INSTRUCTION_NAME "bank_tile_transaction_load_duplicate_instruction"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_DUPLICATE_INSTRUCTION_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_DUPLICATE_INSTRUCTION_DESC "Result of loading a transaction. (Transaction contains a duplicate instruction that is not allowed.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INSUFFICIENT_FUNDS_FOR_RENT_OFF  (216UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INSUFFICIENT_FUNDS_FOR_RENT_OFF  (217UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INSUFFICIENT_FUNDS_FOR_RENT_NAME "bank_tile_transaction_load_insufficient_funds_for_rent"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INSUFFICIENT_FUNDS_FOR_RENT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INSUFFICIENT_FUNDS_FOR_RENT_DESC "Result of loading a transaction. (Transaction results in an account with insufficient funds for rent.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_MAX_LOADED_ACCOUNTS_DATA_SIZE_EXCEEDED_OFF  (217UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_MAX_LOADED_ACCOUNTS_DATA_SIZE_EXCEEDED_OFF  (218UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_MAX_LOADED_ACCOUNTS_DATA_SIZE_EXCEEDED_NAME "bank_tile_transaction_load_max_loaded_accounts_data_size_exceeded"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_MAX_LOADED_ACCOUNTS_DATA_SIZE_EXCEEDED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_MAX_LOADED_ACCOUNTS_DATA_SIZE_EXCEEDED_DESC "Result of loading a transaction. (Transaction exceeded max loaded accounts data size cap.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_LOADED_ACCOUNTS_DATA_SIZE_LIMIT_OFF  (218UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_LOADED_ACCOUNTS_DATA_SIZE_LIMIT_OFF  (219UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_LOADED_ACCOUNTS_DATA_SIZE_LIMIT_NAME "bank_tile_transaction_load_invalid_loaded_accounts_data_size_limit"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_LOADED_ACCOUNTS_DATA_SIZE_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_INVALID_LOADED_ACCOUNTS_DATA_SIZE_LIMIT_DESC "Result of loading a transaction. (LoadedAccountsDataSizeLimit set for transaction must be greater than 0.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_RESANITIZATION_NEEDED_OFF  (219UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_RESANITIZATION_NEEDED_OFF  (220UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_RESANITIZATION_NEEDED_NAME "bank_tile_transaction_load_resanitization_needed"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_RESANITIZATION_NEEDED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_RESANITIZATION_NEEDED_DESC "Result of loading a transaction. (Sanitized transaction differed before/after feature activiation. Needs to be resanitized.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_PROGRAM_EXECUTION_TEMPORARILY_RESTRICTED_OFF  (220UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_PROGRAM_EXECUTION_TEMPORARILY_RESTRICTED_OFF  (221UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_PROGRAM_EXECUTION_TEMPORARILY_RESTRICTED_NAME "bank_tile_transaction_load_program_execution_temporarily_restricted"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_PROGRAM_EXECUTION_TEMPORARILY_RESTRICTED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_PROGRAM_EXECUTION_TEMPORARILY_RESTRICTED_DESC "Result of loading a transaction. (Program execution is temporarily restricted on an account.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_UNBALANCED_TRANSACTION_OFF  (221UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_UNBALANCED_TRANSACTION_OFF  (222UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_UNBALANCED_TRANSACTION_NAME "bank_tile_transaction_load_unbalanced_transaction"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_UNBALANCED_TRANSACTION_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_LOAD_UNBALANCED_TRANSACTION_DESC "Result of loading a transaction. (The total balance before the transaction does not equal the total balance after the transaction.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_OFF  (222UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_OFF  (223UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_CNT  (38UL)
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_SUCCESS_OFF  (222UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_SUCCESS_OFF  (223UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_SUCCESS_NAME "bank_tile_transaction_executing_success"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_SUCCESS_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_SUCCESS_DESC "Result of executing a transaction. Could be a failure or success. (Success)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_IN_USE_OFF  (223UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_IN_USE_OFF  (224UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_IN_USE_NAME "bank_tile_transaction_executing_account_in_use"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_IN_USE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_IN_USE_DESC "Result of executing a transaction. Could be a failure or success. (An account is already being processed in another transaction in a way that does not support parallelism.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_LOADED_TWICE_OFF  (224UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_LOADED_TWICE_OFF  (225UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_LOADED_TWICE_NAME "bank_tile_transaction_executing_account_loaded_twice"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_LOADED_TWICE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_LOADED_TWICE_DESC "Result of executing a transaction. Could be a failure or success. (A `Pubkey` appears twice in the transaction's `account_keys`.  Instructions can reference `Pubkey`s more than once but the message must contain a list with no duplicate keys.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_NOT_FOUND_OFF  (225UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_NOT_FOUND_OFF  (226UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_NOT_FOUND_NAME "bank_tile_transaction_executing_account_not_found"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_NOT_FOUND_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_NOT_FOUND_DESC "Result of executing a transaction. Could be a failure or success. (Attempt to debit an account but found no record of a prior credit.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_PROGRAM_ACCOUNT_NOT_FOUND_OFF  (226UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_PROGRAM_ACCOUNT_NOT_FOUND_OFF  (227UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_PROGRAM_ACCOUNT_NOT_FOUND_NAME "bank_tile_transaction_executing_program_account_not_found"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_PROGRAM_ACCOUNT_NOT_FOUND_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_PROGRAM_ACCOUNT_NOT_FOUND_DESC "Result of executing a transaction. Could be a failure or success. (Attempt to load a program that does not exist.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INSUFFICIENT_FUNDS_FOR_FEE_OFF  (227UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INSUFFICIENT_FUNDS_FOR_FEE_OFF  (228UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INSUFFICIENT_FUNDS_FOR_FEE_NAME "bank_tile_transaction_executing_insufficient_funds_for_fee"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INSUFFICIENT_FUNDS_FOR_FEE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INSUFFICIENT_FUNDS_FOR_FEE_DESC "Result of executing a transaction. Could be a failure or success. (The fee payer `Pubkey` does not have sufficient balance to pay the fee to schedule the transaction.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ACCOUNT_FOR_FEE_OFF  (228UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ACCOUNT_FOR_FEE_OFF  (229UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ACCOUNT_FOR_FEE_NAME "bank_tile_transaction_executing_invalid_account_for_fee"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ACCOUNT_FOR_FEE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ACCOUNT_FOR_FEE_DESC "Result of executing a transaction. Could be a failure or success. (This account may not be used to pay transaction fees.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ALREADY_PROCESSED_OFF  (229UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ALREADY_PROCESSED_OFF  (230UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ALREADY_PROCESSED_NAME "bank_tile_transaction_executing_already_processed"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ALREADY_PROCESSED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ALREADY_PROCESSED_DESC "Result of executing a transaction. Could be a failure or success. (The bank has seen this transaction before. This can occur under normal operation when a UDP packet is duplicated, as a user error from a client not updating its `recent_blockhash`, or as a double-spend attack.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_BLOCKHASH_NOT_FOUND_OFF  (230UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_BLOCKHASH_NOT_FOUND_OFF  (231UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_BLOCKHASH_NOT_FOUND_NAME "bank_tile_transaction_executing_blockhash_not_found"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_BLOCKHASH_NOT_FOUND_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_BLOCKHASH_NOT_FOUND_DESC "Result of executing a transaction. Could be a failure or success. (The bank has not seen the given `recent_blockhash` or the transaction is too old and the `recent_blockhash` has been discarded.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INSTRUCTION_ERROR_OFF  (231UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INSTRUCTION_ERROR_OFF  (232UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INSTRUCTION_ERROR_NAME "bank_tile_transaction_executing_instruction_error"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INSTRUCTION_ERROR_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INSTRUCTION_ERROR_DESC "Result of executing a transaction. Could be a failure or success. (An error occurred while processing an instruction.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_CALL_CHAIN_TOO_DEEP_OFF  (232UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_CALL_CHAIN_TOO_DEEP_OFF  (233UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_CALL_CHAIN_TOO_DEEP_NAME "bank_tile_transaction_executing_call_chain_too_deep"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_CALL_CHAIN_TOO_DEEP_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_CALL_CHAIN_TOO_DEEP_DESC "Result of executing a transaction. Could be a failure or success. (Loader call chain is too deep.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_MISSING_SIGNATURE_FOR_FEE_OFF  (233UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_MISSING_SIGNATURE_FOR_FEE_OFF  (234UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_MISSING_SIGNATURE_FOR_FEE_NAME "bank_tile_transaction_executing_missing_signature_for_fee"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_MISSING_SIGNATURE_FOR_FEE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_MISSING_SIGNATURE_FOR_FEE_DESC "Result of executing a transaction. Could be a failure or success. (Transaction requires a fee but has no signature present.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ACCOUNT_INDEX_OFF  (234UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ACCOUNT_INDEX_OFF  (235UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ACCOUNT_INDEX_NAME "bank_tile_transaction_executing_invalid_account_index"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ACCOUNT_INDEX_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ACCOUNT_INDEX_DESC "Result of executing a transaction. Could be a failure or success. (Transaction contains an invalid account reference.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_SIGNATURE_FAILURE_OFF  (235UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_SIGNATURE_FAILURE_OFF  (236UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_SIGNATURE_FAILURE_NAME "bank_tile_transaction_executing_signature_failure"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_SIGNATURE_FAILURE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_SIGNATURE_FAILURE_DESC "Result of executing a transaction. Could be a failure or success. (Transaction did not pass signature verification.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_PROGRAM_FOR_EXECUTION_OFF  (236UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_PROGRAM_FOR_EXECUTION_OFF  (237UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_PROGRAM_FOR_EXECUTION_NAME "bank_tile_transaction_executing_invalid_program_for_execution"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_PROGRAM_FOR_EXECUTION_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_PROGRAM_FOR_EXECUTION_DESC "Result of executing a transaction. Could be a failure or success. (This program may not be used for executing instructions.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_SANITIZE_FAILURE_OFF  (237UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_SANITIZE_FAILURE_OFF  (238UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_SANITIZE_FAILURE_NAME "bank_tile_transaction_executing_sanitize_failure"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_SANITIZE_FAILURE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_SANITIZE_FAILURE_DESC "Result of executing a transaction. Could be a failure or success. (Transaction failed to sanitize accounts offsets correctly implies that account locks are not taken for this TX, and should not be unlocked.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_CLUSTER_MAINTENANCE_OFF  (238UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_CLUSTER_MAINTENANCE_OFF  (239UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_CLUSTER_MAINTENANCE_NAME "bank_tile_transaction_executing_cluster_maintenance"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_CLUSTER_MAINTENANCE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_CLUSTER_MAINTENANCE_DESC "Result of executing a transaction. Could be a failure or success. (Transactions are currently disabled due to cluster maintenance.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_BORROW_OUTSTANDING_OFF  (239UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_BORROW_OUTSTANDING_OFF  (240UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_BORROW_OUTSTANDING_NAME "bank_tile_transaction_executing_account_borrow_outstanding"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_BORROW_OUTSTANDING_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ACCOUNT_BORROW_OUTSTANDING_DESC "Result of executing a transaction. Could be a failure or success. (Transaction processing left an account with an outstanding borrowed reference.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_MAX_BLOCK_COST_LIMIT_OFF  (240UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_MAX_BLOCK_COST_LIMIT_OFF  (241UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_MAX_BLOCK_COST_LIMIT_NAME "bank_tile_transaction_executing_would_exceed_max_block_cost_limit"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_MAX_BLOCK_COST_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_MAX_BLOCK_COST_LIMIT_DESC "Result of executing a transaction. Could be a failure or success. (Transaction would exceed max Block Cost Limit.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_UNSUPPORTED_VERSION_OFF  (241UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_UNSUPPORTED_VERSION_OFF  (242UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_UNSUPPORTED_VERSION_NAME "bank_tile_transaction_executing_unsupported_version"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_UNSUPPORTED_VERSION_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_UNSUPPORTED_VERSION_DESC "Result of executing a transaction. Could be a failure or success. (Transaction version is unsupported.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_WRITABLE_ACCOUNT_OFF  (242UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_WRITABLE_ACCOUNT_OFF  (243UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_WRITABLE_ACCOUNT_NAME "bank_tile_transaction_executing_invalid_writable_account"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_WRITABLE_ACCOUNT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_WRITABLE_ACCOUNT_DESC "Result of executing a transaction. Could be a failure or success. (Transaction loads a writable account that cannot be written.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_MAX_ACCOUNT_COST_LIMIT_OFF  (243UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_MAX_ACCOUNT_COST_LIMIT_OFF  (244UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_MAX_ACCOUNT_COST_LIMIT_NAME "bank_tile_transaction_executing_would_exceed_max_account_cost_limit"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_MAX_ACCOUNT_COST_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_MAX_ACCOUNT_COST_LIMIT_DESC "Result of executing a transaction. Could be a failure or success. (Transaction would exceed max account limit within the block.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_ACCOUNT_DATA_BLOCK_LIMIT_OFF  (244UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_ACCOUNT_DATA_BLOCK_LIMIT_OFF  (245UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_ACCOUNT_DATA_BLOCK_LIMIT_NAME "bank_tile_transaction_executing_would_exceed_account_data_block_limit"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_ACCOUNT_DATA_BLOCK_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_ACCOUNT_DATA_BLOCK_LIMIT_DESC "Result of executing a transaction. Could be a failure or success. (Transaction would exceed account data limit within the block.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_TOO_MANY_ACCOUNT_LOCKS_OFF  (245UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_TOO_MANY_ACCOUNT_LOCKS_OFF  (246UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_TOO_MANY_ACCOUNT_LOCKS_NAME "bank_tile_transaction_executing_too_many_account_locks"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_TOO_MANY_ACCOUNT_LOCKS_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_TOO_MANY_ACCOUNT_LOCKS_DESC "Result of executing a transaction. Could be a failure or success. (Transaction locked too many accounts.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ADDRESS_LOOKUP_TABLE_NOT_FOUND_OFF  (246UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ADDRESS_LOOKUP_TABLE_NOT_FOUND_OFF  (247UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ADDRESS_LOOKUP_TABLE_NOT_FOUND_NAME "bank_tile_transaction_executing_address_lookup_table_not_found"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ADDRESS_LOOKUP_TABLE_NOT_FOUND_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_ADDRESS_LOOKUP_TABLE_NOT_FOUND_DESC "Result of executing a transaction. Could be a failure or success. (Address lookup table not found.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ADDRESS_LOOKUP_TABLE_OWNER_OFF  (247UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ADDRESS_LOOKUP_TABLE_OWNER_OFF  (248UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ADDRESS_LOOKUP_TABLE_OWNER_NAME "bank_tile_transaction_executing_invalid_address_lookup_table_owner"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ADDRESS_LOOKUP_TABLE_OWNER_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ADDRESS_LOOKUP_TABLE_OWNER_DESC "Result of executing a transaction. Could be a failure or success. (Attempted to lookup addresses from an account owned by the wrong program.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ADDRESS_LOOKUP_TABLE_DATA_OFF  (248UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ADDRESS_LOOKUP_TABLE_DATA_OFF  (249UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ADDRESS_LOOKUP_TABLE_DATA_NAME "bank_tile_transaction_executing_invalid_address_lookup_table_data"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ADDRESS_LOOKUP_TABLE_DATA_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ADDRESS_LOOKUP_TABLE_DATA_DESC "Result of executing a transaction. Could be a failure or success. (Attempted to lookup addresses from an invalid account.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ADDRESS_LOOKUP_TABLE_INDEX_OFF  (249UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ADDRESS_LOOKUP_TABLE_INDEX_OFF  (250UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ADDRESS_LOOKUP_TABLE_INDEX_NAME "bank_tile_transaction_executing_invalid_address_lookup_table_index"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ADDRESS_LOOKUP_TABLE_INDEX_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_ADDRESS_LOOKUP_TABLE_INDEX_DESC "Result of executing a transaction. Could be a failure or success. (Address table lookup uses an invalid index.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_RENT_PAYING_ACCOUNT_OFF  (250UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_RENT_PAYING_ACCOUNT_OFF  (251UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_RENT_PAYING_ACCOUNT_NAME "bank_tile_transaction_executing_invalid_rent_paying_account"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_RENT_PAYING_ACCOUNT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_RENT_PAYING_ACCOUNT_DESC "Result of executing a transaction. Could be a failure or success. (Transaction leaves an account with a lower balance than rent-exempt minimum.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_MAX_VOTE_COST_LIMIT_OFF  (251UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_MAX_VOTE_COST_LIMIT_OFF  (252UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_MAX_VOTE_COST_LIMIT_NAME "bank_tile_transaction_executing_would_exceed_max_vote_cost_limit"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_MAX_VOTE_COST_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_MAX_VOTE_COST_LIMIT_DESC "Result of executing a transaction. Could be a failure or success. (Transaction would exceed max Vote Cost Limit.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_ACCOUNT_DATA_TOTAL_LIMIT_OFF  (252UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_ACCOUNT_DATA_TOTAL_LIMIT_OFF  (253UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_ACCOUNT_DATA_TOTAL_LIMIT_NAME "bank_tile_transaction_executing_would_exceed_account_data_total_limit"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_ACCOUNT_DATA_TOTAL_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_WOULD_EXCEED_ACCOUNT_DATA_TOTAL_LIMIT_DESC "Result of executing a transaction. Could be a failure or success. (Transaction would exceed total account data limit.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_DUPLICATE_INSTRUCTION_OFF  (253UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_DUPLICATE_INSTRUCTION_OFF  (254UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_DUPLICATE_INSTRUCTION_NAME "bank_tile_transaction_executing_duplicate_instruction"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_DUPLICATE_INSTRUCTION_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_DUPLICATE_INSTRUCTION_DESC "Result of executing a transaction. Could be a failure or success. (Transaction contains a duplicate instruction that is not allowed.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INSUFFICIENT_FUNDS_FOR_RENT_OFF  (254UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INSUFFICIENT_FUNDS_FOR_RENT_OFF  (255UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INSUFFICIENT_FUNDS_FOR_RENT_NAME "bank_tile_transaction_executing_insufficient_funds_for_rent"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INSUFFICIENT_FUNDS_FOR_RENT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INSUFFICIENT_FUNDS_FOR_RENT_DESC "Result of executing a transaction. Could be a failure or success. (Transaction results in an account with insufficient funds for rent.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_MAX_LOADED_ACCOUNTS_DATA_SIZE_EXCEEDED_OFF  (255UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_MAX_LOADED_ACCOUNTS_DATA_SIZE_EXCEEDED_OFF  (256UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_MAX_LOADED_ACCOUNTS_DATA_SIZE_EXCEEDED_NAME "bank_tile_transaction_executing_max_loaded_accounts_data_size_exceeded"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_MAX_LOADED_ACCOUNTS_DATA_SIZE_EXCEEDED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_MAX_LOADED_ACCOUNTS_DATA_SIZE_EXCEEDED_DESC "Result of executing a transaction. Could be a failure or success. (Transaction exceeded max loaded accounts data size cap.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_LOADED_ACCOUNTS_DATA_SIZE_LIMIT_OFF  (256UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_LOADED_ACCOUNTS_DATA_SIZE_LIMIT_OFF  (257UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_LOADED_ACCOUNTS_DATA_SIZE_LIMIT_NAME "bank_tile_transaction_executing_invalid_loaded_accounts_data_size_limit"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_LOADED_ACCOUNTS_DATA_SIZE_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_INVALID_LOADED_ACCOUNTS_DATA_SIZE_LIMIT_DESC "Result of executing a transaction. Could be a failure or success. (LoadedAccountsDataSizeLimit set for transaction must be greater than 0.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_RESANITIZATION_NEEDED_OFF  (257UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_RESANITIZATION_NEEDED_OFF  (258UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_RESANITIZATION_NEEDED_NAME "bank_tile_transaction_executing_resanitization_needed"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_RESANITIZATION_NEEDED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_RESANITIZATION_NEEDED_DESC "Result of executing a transaction. Could be a failure or success. (Sanitized transaction differed before/after feature activiation. Needs to be resanitized.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_PROGRAM_EXECUTION_TEMPORARILY_RESTRICTED_OFF  (258UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_PROGRAM_EXECUTION_TEMPORARILY_RESTRICTED_OFF  (259UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_PROGRAM_EXECUTION_TEMPORARILY_RESTRICTED_NAME "bank_tile_transaction_executing_program_execution_temporarily_restricted"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_PROGRAM_EXECUTION_TEMPORARILY_RESTRICTED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_PROGRAM_EXECUTION_TEMPORARILY_RESTRICTED_DESC "Result of executing a transaction. Could be a failure or success. (Program execution is temporarily restricted on an account.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_UNBALANCED_TRANSACTION_OFF  (259UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_UNBALANCED_TRANSACTION_OFF  (260UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_UNBALANCED_TRANSACTION_NAME "bank_tile_transaction_executing_unbalanced_transaction"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_UNBALANCED_TRANSACTION_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTING_UNBALANCED_TRANSACTION_DESC "Result of executing a transaction. Could be a failure or success. (The total balance before the transaction does not equal the total balance after the transaction.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_OFF  (260UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_OFF  (261UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_CNT  (38UL)
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_SUCCESS_OFF  (260UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_SUCCESS_OFF  (261UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_SUCCESS_NAME "bank_tile_transaction_executed_success"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_SUCCESS_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_SUCCESS_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Success)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_IN_USE_OFF  (261UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_IN_USE_OFF  (262UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_IN_USE_NAME "bank_tile_transaction_executed_account_in_use"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_IN_USE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_IN_USE_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (An account is already being processed in another transaction in a way that does not support parallelism.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_LOADED_TWICE_OFF  (262UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_LOADED_TWICE_OFF  (263UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_LOADED_TWICE_NAME "bank_tile_transaction_executed_account_loaded_twice"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_LOADED_TWICE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_LOADED_TWICE_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (A `Pubkey` appears twice in the transaction's `account_keys`.  Instructions can reference `Pubkey`s more than once but the message must contain a list with no duplicate keys.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_NOT_FOUND_OFF  (263UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_NOT_FOUND_OFF  (264UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_NOT_FOUND_NAME "bank_tile_transaction_executed_account_not_found"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_NOT_FOUND_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_NOT_FOUND_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Attempt to debit an account but found no record of a prior credit.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_PROGRAM_ACCOUNT_NOT_FOUND_OFF  (264UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_PROGRAM_ACCOUNT_NOT_FOUND_OFF  (265UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_PROGRAM_ACCOUNT_NOT_FOUND_NAME "bank_tile_transaction_executed_program_account_not_found"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_PROGRAM_ACCOUNT_NOT_FOUND_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_PROGRAM_ACCOUNT_NOT_FOUND_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Attempt to load a program that does not exist.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INSUFFICIENT_FUNDS_FOR_FEE_OFF  (265UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INSUFFICIENT_FUNDS_FOR_FEE_OFF  (266UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INSUFFICIENT_FUNDS_FOR_FEE_NAME "bank_tile_transaction_executed_insufficient_funds_for_fee"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INSUFFICIENT_FUNDS_FOR_FEE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INSUFFICIENT_FUNDS_FOR_FEE_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (The fee payer `Pubkey` does not have sufficient balance to pay the fee to schedule the transaction.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ACCOUNT_FOR_FEE_OFF  (266UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ACCOUNT_FOR_FEE_OFF  (267UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ACCOUNT_FOR_FEE_NAME "bank_tile_transaction_executed_invalid_account_for_fee"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ACCOUNT_FOR_FEE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ACCOUNT_FOR_FEE_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (This account may not be used to pay transaction fees.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ALREADY_PROCESSED_OFF  (267UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ALREADY_PROCESSED_OFF  (268UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ALREADY_PROCESSED_NAME "bank_tile_transaction_executed_already_processed"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ALREADY_PROCESSED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ALREADY_PROCESSED_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (The bank has seen this transaction before. This can occur under normal operation when a UDP packet is duplicated, as a user error from a client not updating its `recent_blockhash`, or as a double-spend attack.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_BLOCKHASH_NOT_FOUND_OFF  (268UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_BLOCKHASH_NOT_FOUND_OFF  (269UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_BLOCKHASH_NOT_FOUND_NAME "bank_tile_transaction_executed_blockhash_not_found"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_BLOCKHASH_NOT_FOUND_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_BLOCKHASH_NOT_FOUND_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (The bank has not seen the given `recent_blockhash` or the transaction is too old and the `recent_blockhash` has been discarded.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INSTRUCTION_ERROR_OFF  (269UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INSTRUCTION_ERROR_OFF  (270UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INSTRUCTION_ERROR_NAME "bank_tile_transaction_executed_instruction_error"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INSTRUCTION_ERROR_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INSTRUCTION_ERROR_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (An error occurred while processing an instruction.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_CALL_CHAIN_TOO_DEEP_OFF  (270UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_CALL_CHAIN_TOO_DEEP_OFF  (271UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_CALL_CHAIN_TOO_DEEP_NAME "bank_tile_transaction_executed_call_chain_too_deep"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_CALL_CHAIN_TOO_DEEP_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_CALL_CHAIN_TOO_DEEP_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Loader call chain is too deep.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_MISSING_SIGNATURE_FOR_FEE_OFF  (271UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_MISSING_SIGNATURE_FOR_FEE_OFF  (272UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_MISSING_SIGNATURE_FOR_FEE_NAME "bank_tile_transaction_executed_missing_signature_for_fee"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_MISSING_SIGNATURE_FOR_FEE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_MISSING_SIGNATURE_FOR_FEE_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Transaction requires a fee but has no signature present.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ACCOUNT_INDEX_OFF  (272UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ACCOUNT_INDEX_OFF  (273UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ACCOUNT_INDEX_NAME "bank_tile_transaction_executed_invalid_account_index"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ACCOUNT_INDEX_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ACCOUNT_INDEX_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Transaction contains an invalid account reference.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_SIGNATURE_FAILURE_OFF  (273UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_SIGNATURE_FAILURE_OFF  (274UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_SIGNATURE_FAILURE_NAME "bank_tile_transaction_executed_signature_failure"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_SIGNATURE_FAILURE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_SIGNATURE_FAILURE_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Transaction did not pass signature verification.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_PROGRAM_FOR_EXECUTION_OFF  (274UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_PROGRAM_FOR_EXECUTION_OFF  (275UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_PROGRAM_FOR_EXECUTION_NAME "bank_tile_transaction_executed_invalid_program_for_execution"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_PROGRAM_FOR_EXECUTION_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_PROGRAM_FOR_EXECUTION_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (This program may not be used for executing instructions.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_SANITIZE_FAILURE_OFF  (275UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_SANITIZE_FAILURE_OFF  (276UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_SANITIZE_FAILURE_NAME "bank_tile_transaction_executed_sanitize_failure"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_SANITIZE_FAILURE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_SANITIZE_FAILURE_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Transaction failed to sanitize accounts offsets correctly implies that account locks are not taken for this TX, and should not be unlocked.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_CLUSTER_MAINTENANCE_OFF  (276UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_CLUSTER_MAINTENANCE_OFF  (277UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_CLUSTER_MAINTENANCE_NAME "bank_tile_transaction_executed_cluster_maintenance"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_CLUSTER_MAINTENANCE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_CLUSTER_MAINTENANCE_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Transactions are currently disabled due to cluster maintenance.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_BORROW_OUTSTANDING_OFF  (277UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_BORROW_OUTSTANDING_OFF  (278UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_BORROW_OUTSTANDING_NAME "bank_tile_transaction_executed_account_borrow_outstanding"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_BORROW_OUTSTANDING_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ACCOUNT_BORROW_OUTSTANDING_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Transaction processing left an account with an outstanding borrowed reference.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_MAX_BLOCK_COST_LIMIT_OFF  (278UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_MAX_BLOCK_COST_LIMIT_OFF  (279UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_MAX_BLOCK_COST_LIMIT_NAME "bank_tile_transaction_executed_would_exceed_max_block_cost_limit"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_MAX_BLOCK_COST_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_MAX_BLOCK_COST_LIMIT_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Transaction would exceed max Block Cost Limit.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_UNSUPPORTED_VERSION_OFF  (279UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_UNSUPPORTED_VERSION_OFF  (280UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_UNSUPPORTED_VERSION_NAME "bank_tile_transaction_executed_unsupported_version"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_UNSUPPORTED_VERSION_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_UNSUPPORTED_VERSION_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Transaction version is unsupported.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_WRITABLE_ACCOUNT_OFF  (280UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_WRITABLE_ACCOUNT_OFF  (281UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_WRITABLE_ACCOUNT_NAME "bank_tile_transaction_executed_invalid_writable_account"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_WRITABLE_ACCOUNT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_WRITABLE_ACCOUNT_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Transaction loads a writable account that cannot be written.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_MAX_ACCOUNT_COST_LIMIT_OFF  (281UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_MAX_ACCOUNT_COST_LIMIT_OFF  (282UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_MAX_ACCOUNT_COST_LIMIT_NAME "bank_tile_transaction_executed_would_exceed_max_account_cost_limit"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_MAX_ACCOUNT_COST_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_MAX_ACCOUNT_COST_LIMIT_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Transaction would exceed max account limit within the block.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_ACCOUNT_DATA_BLOCK_LIMIT_OFF  (282UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_ACCOUNT_DATA_BLOCK_LIMIT_OFF  (283UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_ACCOUNT_DATA_BLOCK_LIMIT_NAME "bank_tile_transaction_executed_would_exceed_account_data_block_limit"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_ACCOUNT_DATA_BLOCK_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_ACCOUNT_DATA_BLOCK_LIMIT_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Transaction would exceed account data limit within the block.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_TOO_MANY_ACCOUNT_LOCKS_OFF  (283UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_TOO_MANY_ACCOUNT_LOCKS_OFF  (284UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_TOO_MANY_ACCOUNT_LOCKS_NAME "bank_tile_transaction_executed_too_many_account_locks"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_TOO_MANY_ACCOUNT_LOCKS_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_TOO_MANY_ACCOUNT_LOCKS_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Transaction locked too many accounts.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ADDRESS_LOOKUP_TABLE_NOT_FOUND_OFF  (284UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ADDRESS_LOOKUP_TABLE_NOT_FOUND_OFF  (285UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ADDRESS_LOOKUP_TABLE_NOT_FOUND_NAME "bank_tile_transaction_executed_address_lookup_table_not_found"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ADDRESS_LOOKUP_TABLE_NOT_FOUND_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_ADDRESS_LOOKUP_TABLE_NOT_FOUND_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Address lookup table not found.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ADDRESS_LOOKUP_TABLE_OWNER_OFF  (285UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ADDRESS_LOOKUP_TABLE_OWNER_OFF  (286UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ADDRESS_LOOKUP_TABLE_OWNER_NAME "bank_tile_transaction_executed_invalid_address_lookup_table_owner"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ADDRESS_LOOKUP_TABLE_OWNER_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ADDRESS_LOOKUP_TABLE_OWNER_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Attempted to lookup addresses from an account owned by the wrong program.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ADDRESS_LOOKUP_TABLE_DATA_OFF  (286UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ADDRESS_LOOKUP_TABLE_DATA_OFF  (287UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ADDRESS_LOOKUP_TABLE_DATA_NAME "bank_tile_transaction_executed_invalid_address_lookup_table_data"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ADDRESS_LOOKUP_TABLE_DATA_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ADDRESS_LOOKUP_TABLE_DATA_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Attempted to lookup addresses from an invalid account.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ADDRESS_LOOKUP_TABLE_INDEX_OFF  (287UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ADDRESS_LOOKUP_TABLE_INDEX_OFF  (288UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ADDRESS_LOOKUP_TABLE_INDEX_NAME "bank_tile_transaction_executed_invalid_address_lookup_table_index"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ADDRESS_LOOKUP_TABLE_INDEX_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_ADDRESS_LOOKUP_TABLE_INDEX_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Address table lookup uses an invalid index.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_RENT_PAYING_ACCOUNT_OFF  (288UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_RENT_PAYING_ACCOUNT_OFF  (289UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_RENT_PAYING_ACCOUNT_NAME "bank_tile_transaction_executed_invalid_rent_paying_account"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_RENT_PAYING_ACCOUNT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_RENT_PAYING_ACCOUNT_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Transaction leaves an account with a lower balance than rent-exempt minimum.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_MAX_VOTE_COST_LIMIT_OFF  (289UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_MAX_VOTE_COST_LIMIT_OFF  (290UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_MAX_VOTE_COST_LIMIT_NAME "bank_tile_transaction_executed_would_exceed_max_vote_cost_limit"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_MAX_VOTE_COST_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_MAX_VOTE_COST_LIMIT_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Transaction would exceed max Vote Cost Limit.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_ACCOUNT_DATA_TOTAL_LIMIT_OFF  (290UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_ACCOUNT_DATA_TOTAL_LIMIT_OFF  (291UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_ACCOUNT_DATA_TOTAL_LIMIT_NAME "bank_tile_transaction_executed_would_exceed_account_data_total_limit"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_ACCOUNT_DATA_TOTAL_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_WOULD_EXCEED_ACCOUNT_DATA_TOTAL_LIMIT_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Transaction would exceed total account data limit.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_DUPLICATE_INSTRUCTION_OFF  (291UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_DUPLICATE_INSTRUCTION_OFF  (292UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_DUPLICATE_INSTRUCTION_NAME "bank_tile_transaction_executed_duplicate_instruction"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_DUPLICATE_INSTRUCTION_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_DUPLICATE_INSTRUCTION_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Transaction contains a duplicate instruction that is not allowed.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INSUFFICIENT_FUNDS_FOR_RENT_OFF  (292UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INSUFFICIENT_FUNDS_FOR_RENT_OFF  (293UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INSUFFICIENT_FUNDS_FOR_RENT_NAME "bank_tile_transaction_executed_insufficient_funds_for_rent"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INSUFFICIENT_FUNDS_FOR_RENT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INSUFFICIENT_FUNDS_FOR_RENT_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Transaction results in an account with insufficient funds for rent.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_MAX_LOADED_ACCOUNTS_DATA_SIZE_EXCEEDED_OFF  (293UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_MAX_LOADED_ACCOUNTS_DATA_SIZE_EXCEEDED_OFF  (294UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_MAX_LOADED_ACCOUNTS_DATA_SIZE_EXCEEDED_NAME "bank_tile_transaction_executed_max_loaded_accounts_data_size_exceeded"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_MAX_LOADED_ACCOUNTS_DATA_SIZE_EXCEEDED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_MAX_LOADED_ACCOUNTS_DATA_SIZE_EXCEEDED_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Transaction exceeded max loaded accounts data size cap.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_LOADED_ACCOUNTS_DATA_SIZE_LIMIT_OFF  (294UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_LOADED_ACCOUNTS_DATA_SIZE_LIMIT_OFF  (295UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_LOADED_ACCOUNTS_DATA_SIZE_LIMIT_NAME "bank_tile_transaction_executed_invalid_loaded_accounts_data_size_limit"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_LOADED_ACCOUNTS_DATA_SIZE_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_INVALID_LOADED_ACCOUNTS_DATA_SIZE_LIMIT_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (LoadedAccountsDataSizeLimit set for transaction must be greater than 0.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_RESANITIZATION_NEEDED_OFF  (295UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_RESANITIZATION_NEEDED_OFF  (296UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_RESANITIZATION_NEEDED_NAME "bank_tile_transaction_executed_resanitization_needed"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_RESANITIZATION_NEEDED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_RESANITIZATION_NEEDED_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Sanitized transaction differed before/after feature activiation. Needs to be resanitized.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_PROGRAM_EXECUTION_TEMPORARILY_RESTRICTED_OFF  (296UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_PROGRAM_EXECUTION_TEMPORARILY_RESTRICTED_OFF  (297UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_PROGRAM_EXECUTION_TEMPORARILY_RESTRICTED_NAME "bank_tile_transaction_executed_program_execution_temporarily_restricted"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_PROGRAM_EXECUTION_TEMPORARILY_RESTRICTED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_PROGRAM_EXECUTION_TEMPORARILY_RESTRICTED_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (Program execution is temporarily restricted on an account.)"
 
-#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_UNBALANCED_TRANSACTION_OFF  (297UL)
+#define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_UNBALANCED_TRANSACTION_OFF  (298UL)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_UNBALANCED_TRANSACTION_NAME "bank_tile_transaction_executed_unbalanced_transaction"
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_UNBALANCED_TRANSACTION_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BANK_TILE_TRANSACTION_EXECUTED_UNBALANCED_TRANSACTION_DESC "When a transaction executes (makes it onto the chain), result of executing a transaction. The transaction can still fail. (The total balance before the transaction does not equal the total balance after the transaction.)"
 
 
-#define FD_METRICS_BANK_TOTAL (125UL)
+#define FD_METRICS_BANK_TOTAL (126UL)
 extern const fd_metrics_meta_t FD_METRICS_BANK[FD_METRICS_BANK_TOTAL];
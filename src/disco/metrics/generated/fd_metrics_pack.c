@@ -8,6 +8,9 @@ const fd_metrics_meta_t FD_METRICS_PACK[FD_METRICS_PACK_TOTAL] = {
     DECLARE_METRIC_HISTOGRAM_NONE( PACK, VOTES_PER_MICROBLOCK_COUNT ),
     DECLARE_METRIC_COUNTER( PACK, GOSSIPED_VOTES_RECEIVED ),
     DECLARE_METRIC_COUNTER( PACK, NORMAL_TRANSACTION_RECEIVED ),
+    DECLARE_METRIC_COUNTER( PACK, TRANSACTION_INSERTED_DUPLICATE_ACCT ),
+    DECLARE_METRIC_COUNTER( PACK, TRANSACTION_INSERTED_EXPIRED ),
+    DECLARE_METRIC_COUNTER( PACK, TRANSACTION_INSERTED_ADDR_LUT ),
     DECLARE_METRIC_COUNTER( PACK, TRANSACTION_INSERTED_FULL ),
     DECLARE_METRIC_COUNTER( PACK, TRANSACTION_INSERTED_WRITE_SYSVAR ),
     DECLARE_METRIC_COUNTER( PACK, TRANSACTION_INSERTED_ESTIMATION_FAIL ),
@@ -24,6 +27,7 @@ const fd_metrics_meta_t FD_METRICS_PACK[FD_METRICS_PACK_TOTAL] = {
     DECLARE_METRIC_GAUGE( PACK, PENDING_TRANSACTIONS_HEAP_SIZE ),
     DECLARE_METRIC_COUNTER( PACK, MICROBLOCK_PER_BLOCK_LIMIT ),
     DECLARE_METRIC_COUNTER( PACK, TRANSACTION_SKIPPED ),
+    DECLARE_METRIC_COUNTER( PACK, TRANSACTION_EXPIRED ),
     DECLARE_METRIC_COUNTER( PACK, DELETE_MISSED ),
     DECLARE_METRIC_COUNTER( PACK, DELETE_HIT ),
 };
@@ -45,98 +45,118 @@
 #define FD_METRICS_COUNTER_PACK_NORMAL_TRANSACTION_RECEIVED_DESC "Count of transactions received via the normal TPU path"
 
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_OFF  (243UL)
-#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_CNT  (11UL)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_CNT  (14UL)
 
-#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_FULL_OFF  (243UL)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_DUPLICATE_ACCT_OFF  (243UL)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_DUPLICATE_ACCT_NAME "pack_transaction_inserted_duplicate_acct"
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_DUPLICATE_ACCT_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_DUPLICATE_ACCT_DESC "Result of inserting a transaction into the pack object (Transaction references the same account more than once)"
+
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_EXPIRED_OFF  (244UL)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_EXPIRED_NAME "pack_transaction_inserted_expired"
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_EXPIRED_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_EXPIRED_DESC "Result of inserting a transaction into the pack object (Transaction's recent blockhash is too old)"
+
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_ADDR_LUT_OFF  (245UL)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_ADDR_LUT_NAME "pack_transaction_inserted_addr_lut"
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_ADDR_LUT_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_ADDR_LUT_DESC "Result of inserting a transaction into the pack object (Transaction loads accounts from an address lookup table that is not in pack's snapshot)"
+
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_FULL_OFF  (246UL)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_FULL_NAME "pack_transaction_inserted_full"
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_FULL_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_FULL_DESC "Result of inserting a transaction into the pack object (Pack couldn't find a transaction that the new transaction could potentially replace)"
 
-#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_WRITE_SYSVAR_OFF  (244UL)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_WRITE_SYSVAR_OFF  (247UL)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_WRITE_SYSVAR_NAME "pack_transaction_inserted_write_sysvar"
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_WRITE_SYSVAR_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_WRITE_SYSVAR_DESC "Result of inserting a transaction into the pack object (Transaction tries to write to a sysvar)"
 
-#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_ESTIMATION_FAIL_OFF  (245UL)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_ESTIMATION_FAIL_OFF  (248UL)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_ESTIMATION_FAIL_NAME "pack_transaction_inserted_estimation_fail"
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_ESTIMATION_FAIL_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_ESTIMATION_FAIL_DESC "Result of inserting a transaction into the pack object (Estimating compute cost and/or fee failed)"
 
-#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_TOO_LARGE_OFF  (246UL)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_TOO_LARGE_OFF  (249UL)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_TOO_LARGE_NAME "pack_transaction_inserted_too_large"
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_TOO_LARGE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_TOO_LARGE_DESC "Result of inserting a transaction into the pack object (Transaction requests too many CUs)"
 
-#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_UNAFFORDABLE_OFF  (247UL)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_UNAFFORDABLE_OFF  (250UL)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_UNAFFORDABLE_NAME "pack_transaction_inserted_unaffordable"
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_UNAFFORDABLE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_UNAFFORDABLE_DESC "Result of inserting a transaction into the pack object (Fee payer's balance below transaction fee)"
 
-#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_DUPLICATE_OFF  (248UL)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_DUPLICATE_OFF  (251UL)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_DUPLICATE_NAME "pack_transaction_inserted_duplicate"
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_DUPLICATE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_DUPLICATE_DESC "Result of inserting a transaction into the pack object (Pack aware of transaction with same signature)"
 
-#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_PRIORITY_OFF  (249UL)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_PRIORITY_OFF  (252UL)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_PRIORITY_NAME "pack_transaction_inserted_priority"
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_PRIORITY_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_PRIORITY_DESC "Result of inserting a transaction into the pack object (Transaction's fee was too low given it's compute unit requirement and other competing transactions)"
 
-#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_NONVOTE_ADD_OFF  (250UL)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_NONVOTE_ADD_OFF  (253UL)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_NONVOTE_ADD_NAME "pack_transaction_inserted_nonvote_add"
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_NONVOTE_ADD_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_NONVOTE_ADD_DESC "Result of inserting a transaction into the pack object (Transaction that was not a simple vote added to pending transactions)"
 
-#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_VOTE_ADD_OFF  (251UL)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_VOTE_ADD_OFF  (254UL)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_VOTE_ADD_NAME "pack_transaction_inserted_vote_add"
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_VOTE_ADD_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_VOTE_ADD_DESC "Result of inserting a transaction into the pack object (Simple vote transaction was added to pending transactions)"
 
-#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_NONVOTE_REPLACE_OFF  (252UL)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_NONVOTE_REPLACE_OFF  (255UL)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_NONVOTE_REPLACE_NAME "pack_transaction_inserted_nonvote_replace"
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_NONVOTE_REPLACE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_NONVOTE_REPLACE_DESC "Result of inserting a transaction into the pack object (Transaction that was not a simple vote replaced a lower priority transaction)"
 
-#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_VOTE_REPLACE_OFF  (253UL)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_VOTE_REPLACE_OFF  (256UL)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_VOTE_REPLACE_NAME "pack_transaction_inserted_vote_replace"
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_VOTE_REPLACE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_VOTE_REPLACE_DESC "Result of inserting a transaction into the pack object (Simple vote transaction replaced a lower priority transaction)"
 
-#define FD_METRICS_GAUGE_PACK_AVAILABLE_TRANSACTIONS_OFF  (254UL)
+#define FD_METRICS_GAUGE_PACK_AVAILABLE_TRANSACTIONS_OFF  (257UL)
 #define FD_METRICS_GAUGE_PACK_AVAILABLE_TRANSACTIONS_NAME "pack_available_transactions"
 #define FD_METRICS_GAUGE_PACK_AVAILABLE_TRANSACTIONS_TYPE (FD_METRICS_TYPE_GAUGE)
 #define FD_METRICS_GAUGE_PACK_AVAILABLE_TRANSACTIONS_DESC "The total number of pending transactions in pack's pool that are available to be scheduled"
 
-#define FD_METRICS_GAUGE_PACK_AVAILABLE_VOTE_TRANSACTIONS_OFF  (255UL)
+#define FD_METRICS_GAUGE_PACK_AVAILABLE_VOTE_TRANSACTIONS_OFF  (258UL)
 #define FD_METRICS_GAUGE_PACK_AVAILABLE_VOTE_TRANSACTIONS_NAME "pack_available_vote_transactions"
 #define FD_METRICS_GAUGE_PACK_AVAILABLE_VOTE_TRANSACTIONS_TYPE (FD_METRICS_TYPE_GAUGE)
 #define FD_METRICS_GAUGE_PACK_AVAILABLE_VOTE_TRANSACTIONS_DESC "The number of pending simple vote transactions in pack's pool that are available to be scheduled"
 
-#define FD_METRICS_GAUGE_PACK_PENDING_TRANSACTIONS_HEAP_SIZE_OFF  (256UL)
+#define FD_METRICS_GAUGE_PACK_PENDING_TRANSACTIONS_HEAP_SIZE_OFF  (259UL)
 #define FD_METRICS_GAUGE_PACK_PENDING_TRANSACTIONS_HEAP_SIZE_NAME "pack_pending_transactions_heap_size"
 #define FD_METRICS_GAUGE_PACK_PENDING_TRANSACTIONS_HEAP_SIZE_TYPE (FD_METRICS_TYPE_GAUGE)
 #define FD_METRICS_GAUGE_PACK_PENDING_TRANSACTIONS_HEAP_SIZE_DESC "The maximum number of pending transactions that pack can consider.  This value is fixed at Firedancer startup but is a useful reference for AvailableTransactions and AvailableVoteTransactions."
 
-#define FD_METRICS_COUNTER_PACK_MICROBLOCK_PER_BLOCK_LIMIT_OFF  (257UL)
+#define FD_METRICS_COUNTER_PACK_MICROBLOCK_PER_BLOCK_LIMIT_OFF  (260UL)
 #define FD_METRICS_COUNTER_PACK_MICROBLOCK_PER_BLOCK_LIMIT_NAME "pack_microblock_per_block_limit"
 #define FD_METRICS_COUNTER_PACK_MICROBLOCK_PER_BLOCK_LIMIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_PACK_MICROBLOCK_PER_BLOCK_LIMIT_DESC "The number of times pack did not pack a microblock because the limit on microblocks/block had been reached"
 
-#define FD_METRICS_COUNTER_PACK_TRANSACTION_SKIPPED_OFF  (258UL)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_SKIPPED_OFF  (261UL)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_SKIPPED_NAME "pack_transaction_skipped"
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_SKIPPED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_PACK_TRANSACTION_SKIPPED_DESC "The number of times pack considered a transaction but skipped it due to account conflicts"
 
-#define FD_METRICS_COUNTER_PACK_DELETE_MISSED_OFF  (259UL)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_EXPIRED_OFF  (262UL)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_EXPIRED_NAME "pack_transaction_expired"
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_EXPIRED_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_PACK_TRANSACTION_EXPIRED_DESC "The number of pending transactions that pack dropped because their recent blockhash expired"
+
+#define FD_METRICS_COUNTER_PACK_DELETE_MISSED_OFF  (263UL)
 #define FD_METRICS_COUNTER_PACK_DELETE_MISSED_NAME "pack_delete_missed"
 #define FD_METRICS_COUNTER_PACK_DELETE_MISSED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_PACK_DELETE_MISSED_DESC "Count of attempts to delete a transaction that wasn't found"
 
-#define FD_METRICS_COUNTER_PACK_DELETE_HIT_OFF  (260UL)
+#define FD_METRICS_COUNTER_PACK_DELETE_HIT_OFF  (264UL)
 #define FD_METRICS_COUNTER_PACK_DELETE_HIT_NAME "pack_delete_hit"
 #define FD_METRICS_COUNTER_PACK_DELETE_HIT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_PACK_DELETE_HIT_DESC "Count of attempts to delete a transaction that was found and deleted"
 
 
-#define FD_METRICS_PACK_TOTAL (24UL)
+#define FD_METRICS_PACK_TOTAL (28UL)
 extern const fd_metrics_meta_t FD_METRICS_PACK[FD_METRICS_PACK_TOTAL];
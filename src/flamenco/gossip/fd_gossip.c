@@ -24,12 +24,17 @@
 #define FD_ACTIVE_KEY_MAX (1<<8)
 /* Max number of values that can be remembered */
 #define FD_VALUE_KEY_MAX (1<<16)
+/* Number of high hash bits used to shard the values for pull requests */
+#define FD_VALUE_SHARD_LG 10U
+#define FD_VALUE_SHARD_CNT (1U<<FD_VALUE_SHARD_LG)
 /* Max number of pending timed events */
 #define FD_PENDING_MAX (1<<9)
 /* Number of bloom filter bits in an outgoing pull request packet */
 #define FD_BLOOM_NUM_BITS (512U*8U) /* 0.5 Kbyte */
 /* Max number of bloom filter keys in an outgoing pull request packet */
 #define FD_BLOOM_MAX_KEYS 32U
+/* Number of bloom filter keys hashed together when probing a filter */
+#define FD_BLOOM_LANES 8U
 /* Max number of packets in an outgoing pull request batch */
 #define FD_BLOOM_MAX_PACKETS 32U
 /* Number of bloom bits in a push prune filter */
@@ -44,6 +49,10 @@
 #define FD_NEED_PUSH_MAX (1<<12)
 /* Max size of receive statistics table */
 #define FD_STATS_KEY_MAX (1<<8)
+/* Max number of crds values whose signatures are verified together */
+#define FD_VERIFY_BATCH_MAX 32U
+/* Size of the buffer holding the encoded crds values being verified */
+#define FD_VERIFY_BUF_SZ (1U<<16)
 
 #define FD_NANOSEC_TO_MILLI(_ts_) ((ulong)(_ts_/1000000))
 
@@ -141,6 +150,8 @@ struct fd_value_elem {
     ulong wallclock; /* Original timestamp of value in millis */
     uchar * data;    /* Serialized form of value (bincode) including signature */
     ulong datalen;
+    uint shard_prev; /* Neighbors in the list of values of the same shard */
+    uint shard_next;
 };
 /* Value table */
 typedef struct fd_value_elem fd_value_elem_t;
@@ -152,6 +163,13 @@ typedef struct fd_value_elem fd_value_elem_t;
 #define MAP_T        fd_value_elem_t
 #include "../../util/tmpl/fd_map_giant.c"
 
+/* Shard of a value, which is given by the high bits of its hash (the
+   same bits used by the mask in a pull request filter) */
+static inline ulong
+fd_value_shard( const fd_hash_t * key ) {
+  return key->ul[0] >> (64U - FD_VALUE_SHARD_LG);
+}
+
 /* Queue of pending timed events, stored as a priority heap */
 union fd_pending_event_arg {
     fd_gossip_peer_addr_t key;
@@ -211,6 +229,16 @@ typedef struct fd_stats_elem fd_stats_elem_t;
 #define MAP_T        fd_stats_elem_t
 #include "../../util/tmpl/fd_map_giant.c"
 
+/* A received crds value waiting for its signature to be verified */
+struct fd_crds_stage {
+    fd_crds_value_t * crd;
+    fd_pubkey_t * pubkey;  /* Signer of the value */
+    ulong wallclock;       /* Timestamp of value in millis */
+    uchar * data;          /* Encoded value (signature followed by the signed data) */
+    ulong datalen;
+};
+typedef struct fd_crds_stage fd_crds_stage_t;
+
 /* Global data for gossip service */
 struct fd_gossip {
     /* Current time in nanosecs */
@@ -237,6 +265,9 @@ struct fd_gossip {
 #define INACTIVES_MAX 1024U
     /* Table of crds values that we have received in the last 5 minutes, keys by hash */
     fd_value_elem_t * values;
+    /* Heads of the lists of values sharing the same high hash bits
+       (indexed into values) */
+    uint value_shards[FD_VALUE_SHARD_CNT];
     /* Array of push destinations currently in use */
     fd_push_state_t * push_states[FD_PUSH_LIST_MAX];
     ulong push_states_cnt;
@@ -263,6 +294,11 @@ struct fd_gossip {
     ulong not_push_cnt;
     /* Heap allocator */
     fd_valloc_t valloc;
+    /* Staging area of received crds values pending signature verification */
+    fd_crds_stage_t stage[FD_VERIFY_BATCH_MAX];
+    ulong stage_cnt;
+    ulong stage_buf_sz;
+    uchar stage_buf[FD_VERIFY_BUF_SZ];
 };
 
 ulong
@@ -285,6 +321,8 @@ fd_gossip_new ( void * shmem, ulong seed, fd_valloc_t valloc ) {
   glob->need_push = (fd_hash_t*)fd_valloc_malloc(valloc, alignof(fd_hash_t), FD_NEED_PUSH_MAX*sizeof(fd_hash_t));
   shm = fd_valloc_malloc(valloc, fd_value_table_align(), fd_value_table_footprint(FD_VALUE_KEY_MAX));
   glob->values = fd_value_table_join(fd_value_table_new(shm, FD_VALUE_KEY_MAX, seed));
+  for (ulong i = 0; i < FD_VALUE_SHARD_CNT; ++i)
+    glob->value_shards[i] = UINT_MAX;
   shm = fd_valloc_malloc(valloc, fd_pending_pool_align(), fd_pending_pool_footprint(FD_PENDING_MAX));
   glob->event_pool = fd_pending_pool_join(fd_pending_pool_new(shm, FD_PENDING_MAX));
   shm = fd_valloc_malloc(valloc, fd_pending_heap_align(), fd_pending_heap_footprint(FD_PENDING_MAX));
@@ -323,6 +361,30 @@ fd_gossip_delete ( void * shmap, fd_valloc_t valloc ) {
   return glob;
 }
 
+/* Add a newly inserted value to the list of its shard */
+static void
+fd_gossip_value_link( fd_gossip_t * glob, fd_value_elem_t * ele ) {
+  uint * head = glob->value_shards + fd_value_shard( &ele->key );
+  uint idx = (uint)(ele - glob->values);
+  ele->shard_prev = UINT_MAX;
+  ele->shard_next = *head;
+  if (*head != UINT_MAX)
+    glob->values[*head].shard_prev = idx;
+  *head = idx;
+}
+
+/* Remove a value from the list of its shard before removing it from
+   the value table */
+static void
+fd_gossip_value_unlink( fd_gossip_t * glob, fd_value_elem_t * ele ) {
+  if (ele->shard_prev == UINT_MAX)
+    glob->value_shards[fd_value_shard( &ele->key )] = ele->shard_next;
+  else
+    glob->values[ele->shard_prev].shard_next = ele->shard_next;
+  if (ele->shard_next != UINT_MAX)
+    glob->values[ele->shard_next].shard_prev = ele->shard_prev;
+}
+
 /* Convert my style of address to solana style */
 int
 fd_gossip_to_soladdr( fd_gossip_socket_addr_t * dst, fd_gossip_peer_addr_t const * src ) {
@@ -593,6 +655,30 @@ fd_gossip_bloom_pos( fd_hash_t * hash, ulong key, ulong nbits) {
   return key % nbits;
 }
 
+/* Test whether a hash is missing from a bloom filter. The key hashes
+   are computed FD_BLOOM_LANES at a time so that the independent
+   multiply chains can be interleaved or vectorized. */
+static int
+fd_gossip_bloom_miss( fd_hash_t const * hash, ulong const * keys, ulong nkeys, ulong const * bits, ulong nbits ) {
+  for ( ulong i = 0; i < nkeys; i += FD_BLOOM_LANES ) {
+    ulong n = fd_ulong_min( nkeys - i, FD_BLOOM_LANES );
+    ulong h[FD_BLOOM_LANES];
+    for ( ulong l = 0; l < FD_BLOOM_LANES; ++l)
+      h[l] = keys[i + (l < n ? l : 0U)];
+    for ( ulong j = 0; j < 32U; ++j) {
+      ulong c = (ulong)(hash->uc[j]);
+      for ( ulong l = 0; l < FD_BLOOM_LANES; ++l)
+        h[l] = (h[l] ^ c) * 1099511628211UL;
+    }
+    for ( ulong l = 0; l < n; ++l) {
+      ulong pos = h[l] % nbits;
+      if (!(bits[pos>>6U] & (1UL<<(pos & 63U))))
+        return 1;
+    }
+  }
+  return 0;
+}
+
 /* Choose a random active peer with good ping count */
 fd_active_elem_t *
 fd_gossip_random_active( fd_gossip_t * glob ) {
@@ -684,6 +770,7 @@ fd_gossip_random_pull( fd_gossip_t * glob, fd_pending_event_arg_t * arg ) {
     /* Purge expired values */
     if (ele->wallclock < expire) {
       fd_valloc_free( glob->valloc, ele->data );
+      fd_gossip_value_unlink( glob, ele );
       fd_value_table_remove( glob->values, hash );
       continue;
     }
@@ -825,92 +912,15 @@ fd_gossip_random_ping( fd_gossip_t * glob, fd_pending_event_arg_t * arg ) {
   fd_gossip_make_ping(glob, &arg2);
 }
 
-/* Process an incoming crds value */
-void
-fd_gossip_recv_crds_value(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_pubkey_t * pubkey, fd_crds_value_t* crd) {
-  /* Verify the signature */
-  ulong wallclock;
-  switch (crd->data.discriminant) {
-  case fd_crds_data_enum_contact_info_v1:
-    pubkey = &crd->data.inner.contact_info_v1.id;
-    wallclock = crd->data.inner.contact_info_v1.wallclock;
-    break;
-  case fd_crds_data_enum_vote:
-    pubkey = &crd->data.inner.vote.from;
-    wallclock = crd->data.inner.vote.wallclock;
-    break;
-  case fd_crds_data_enum_lowest_slot:
-    pubkey = &crd->data.inner.lowest_slot.from;
-    wallclock = crd->data.inner.lowest_slot.wallclock;
-    break;
-  case fd_crds_data_enum_snapshot_hashes:
-    pubkey = &crd->data.inner.snapshot_hashes.from;
-    wallclock = crd->data.inner.snapshot_hashes.wallclock;
-    break;
-  case fd_crds_data_enum_accounts_hashes:
-    pubkey = &crd->data.inner.accounts_hashes.from;
-    wallclock = crd->data.inner.accounts_hashes.wallclock;
-    break;
-  case fd_crds_data_enum_epoch_slots:
-    pubkey = &crd->data.inner.epoch_slots.from;
-    wallclock = crd->data.inner.epoch_slots.wallclock;
-    break;
-  case fd_crds_data_enum_version_v1:
-    pubkey = &crd->data.inner.version_v1.from;
-    wallclock = crd->data.inner.version_v1.wallclock;
-    break;
-  case fd_crds_data_enum_version_v2:
-    pubkey = &crd->data.inner.version_v2.from;
-    wallclock = crd->data.inner.version_v2.wallclock;
-    break;
-  case fd_crds_data_enum_node_instance:
-    pubkey = &crd->data.inner.node_instance.from;
-    wallclock = crd->data.inner.node_instance.wallclock;
-    break;
-  case fd_crds_data_enum_duplicate_shred:
-    pubkey = &crd->data.inner.duplicate_shred.from;
-    wallclock = crd->data.inner.duplicate_shred.wallclock;
-    break;
-  case fd_crds_data_enum_incremental_snapshot_hashes:
-    pubkey = &crd->data.inner.incremental_snapshot_hashes.from;
-    wallclock = crd->data.inner.incremental_snapshot_hashes.wallclock;
-    break;
-  default:
-    wallclock = FD_NANOSEC_TO_MILLI(glob->now); /* In millisecs */
-    break;
-  }
-  if (memcmp(pubkey->uc, glob->public_key->uc, 32U) == 0)
-    /* Ignore my own messages */
-    return;
-  uchar buf[FD_ETH_PAYLOAD_MAX];
-  fd_bincode_encode_ctx_t ctx;
-  ctx.data = buf;
-  ctx.dataend = buf + FD_ETH_PAYLOAD_MAX;
-  if ( fd_crds_data_encode( &crd->data, &ctx ) ) {
-    FD_LOG_ERR(("fd_crds_data_encode failed"));
-    return;
-  }
-  fd_sha512_t sha[1];
-  if (fd_ed25519_verify( /* msg */ buf,
-                         /* sz  */ (ulong)((uchar*)ctx.data - buf),
-                         /* sig */ crd->signature.uc,
-                         /* public_key */ pubkey->uc,
-                         sha )) {
-    FD_LOG_WARNING(("received crds_value with invalid signature"));
-    return;
-  }
-
+/* Insert an incoming crds value whose signature has been verified. data
+   is the encoded value. */
+static void
+fd_gossip_insert_crds_value(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_pubkey_t * pubkey, ulong wallclock,
+                            fd_crds_value_t * crd, uchar const * data, ulong datalen) {
   /* Perform the value hash to get the value table key */
-  ctx.data = buf;
-  ctx.dataend = buf + FD_ETH_PAYLOAD_MAX;
-  if ( fd_crds_value_encode( crd, &ctx ) ) {
-    FD_LOG_ERR(("fd_crds_value_encode failed"));
-    return;
-  }
   fd_sha256_t sha2[1];
   fd_sha256_init( sha2 );
-  ulong datalen = (ulong)((uchar*)ctx.data - buf);
-  fd_sha256_append( sha2, buf, datalen );
+  fd_sha256_append( sha2, data, datalen );
   fd_hash_t key;
   fd_sha256_fini( sha2, key.uc );
 
@@ -952,11 +962,12 @@ fd_gossip_recv_crds_value(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from
     return;
   }
   msg = fd_value_table_insert(glob->values, &key);
+  fd_gossip_value_link(glob, msg);
   msg->wallclock = wallclock;
   fd_hash_copy(&msg->origin, pubkey);
   /* We store the serialized form for convenience */
   msg->data = fd_valloc_malloc(glob->valloc, 1U, datalen);
-  fd_memcpy(msg->data, buf, datalen);
+  fd_memcpy(msg->data, data, datalen);
   msg->datalen = datalen;
 
   if (glob->need_push_cnt < FD_NEED_PUSH_MAX) {
@@ -997,6 +1008,121 @@ fd_gossip_recv_crds_value(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from
   (*glob->deliver_fun)(&crd->data, glob->fun_arg);
 }
 
+/* Verify the signatures of the staged crds values as a batch and
+   insert the valid ones */
+static void
+fd_gossip_flush_crds_values(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from) {
+  ulong cnt = glob->stage_cnt;
+  if (cnt == 0)
+    return;
+  void const * msgs[FD_VERIFY_BATCH_MAX];
+  ulong        szs [FD_VERIFY_BATCH_MAX];
+  void const * sigs[FD_VERIFY_BATCH_MAX];
+  void const * pubs[FD_VERIFY_BATCH_MAX];
+  int          errs[FD_VERIFY_BATCH_MAX];
+  for (ulong i = 0; i < cnt; ++i) {
+    fd_crds_stage_t * st = glob->stage + i;
+    msgs[i] = st->data + 64U;
+    szs[i]  = st->datalen - 64U;
+    sigs[i] = st->data;
+    pubs[i] = st->pubkey->uc;
+  }
+  fd_sha512_t sha[1];
+  fd_ed25519_verify_batch( msgs, szs, sigs, pubs, sha, cnt, errs );
+  for (ulong i = 0; i < cnt; ++i) {
+    fd_crds_stage_t * st = glob->stage + i;
+    if (errs[i]) {
+      FD_LOG_WARNING(("received crds_value with invalid signature"));
+      continue;
+    }
+    fd_gossip_insert_crds_value(glob, from, st->pubkey, st->wallclock, st->crd, st->data, st->datalen);
+  }
+  glob->stage_cnt = 0;
+  glob->stage_buf_sz = 0;
+}
+
+/* Process incoming crds values. The values are encoded into a staging
+   area and their signatures are verified in batches. */
+void
+fd_gossip_recv_crds_values(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_pubkey_t * sender, fd_crds_value_t * crds, ulong crds_len) {
+  for (ulong j = 0; j < crds_len; ++j) {
+    fd_crds_value_t * crd = crds + j;
+    fd_pubkey_t * pubkey = sender;
+    ulong wallclock;
+    switch (crd->data.discriminant) {
+    case fd_crds_data_enum_contact_info_v1:
+      pubkey = &crd->data.inner.contact_info_v1.id;
+      wallclock = crd->data.inner.contact_info_v1.wallclock;
+      break;
+    case fd_crds_data_enum_vote:
+      pubkey = &crd->data.inner.vote.from;
+      wallclock = crd->data.inner.vote.wallclock;
+      break;
+    case fd_crds_data_enum_lowest_slot:
+      pubkey = &crd->data.inner.lowest_slot.from;
+      wallclock = crd->data.inner.lowest_slot.wallclock;
+      break;
+    case fd_crds_data_enum_snapshot_hashes:
+      pubkey = &crd->data.inner.snapshot_hashes.from;
+      wallclock = crd->data.inner.snapshot_hashes.wallclock;
+      break;
+    case fd_crds_data_enum_accounts_hashes:
+      pubkey = &crd->data.inner.accounts_hashes.from;
+      wallclock = crd->data.inner.accounts_hashes.wallclock;
+      break;
+    case fd_crds_data_enum_epoch_slots:
+      pubkey = &crd->data.inner.epoch_slots.from;
+      wallclock = crd->data.inner.epoch_slots.wallclock;
+      break;
+    case fd_crds_data_enum_version_v1:
+      pubkey = &crd->data.inner.version_v1.from;
+      wallclock = crd->data.inner.version_v1.wallclock;
+      break;
+    case fd_crds_data_enum_version_v2:
+      pubkey = &crd->data.inner.version_v2.from;
+      wallclock = crd->data.inner.version_v2.wallclock;
+      break;
+    case fd_crds_data_enum_node_instance:
+      pubkey = &crd->data.inner.node_instance.from;
+      wallclock = crd->data.inner.node_instance.wallclock;
+      break;
+    case fd_crds_data_enum_duplicate_shred:
+      pubkey = &crd->data.inner.duplicate_shred.from;
+      wallclock = crd->data.inner.duplicate_shred.wallclock;
+      break;
+    case fd_crds_data_enum_incremental_snapshot_hashes:
+      pubkey = &crd->data.inner.incremental_snapshot_hashes.from;
+      wallclock = crd->data.inner.incremental_snapshot_hashes.wallclock;
+      break;
+    default:
+      wallclock = FD_NANOSEC_TO_MILLI(glob->now); /* In millisecs */
+      break;
+    }
+    if (memcmp(pubkey->uc, glob->public_key->uc, 32U) == 0)
+      /* Ignore my own messages */
+      continue;
+
+    if (glob->stage_cnt == FD_VERIFY_BATCH_MAX || FD_VERIFY_BUF_SZ - glob->stage_buf_sz < FD_ETH_PAYLOAD_MAX)
+      fd_gossip_flush_crds_values(glob, from);
+    uchar * buf = glob->stage_buf + glob->stage_buf_sz;
+    fd_bincode_encode_ctx_t ctx;
+    ctx.data = buf;
+    ctx.dataend = buf + FD_ETH_PAYLOAD_MAX;
+    if ( fd_crds_value_encode( crd, &ctx ) ) {
+      FD_LOG_ERR(("fd_crds_value_encode failed"));
+      return;
+    }
+    fd_crds_stage_t * st = glob->stage + (glob->stage_cnt++);
+    st->crd = crd;
+    st->pubkey = pubkey;
+    st->wallclock = wallclock;
+    st->data = buf;
+    st->datalen = (ulong)((uchar*)ctx.data - buf);
+    glob->stage_buf_sz += st->datalen;
+  }
+  fd_gossip_flush_crds_values(glob, from);
+}
+
 /* Handle a prune request from somebody else */
 void
 fd_gossip_handle_prune(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_gossip_prune_msg_t * msg) {
@@ -1094,34 +1220,42 @@ fd_gossip_handle_pull_req(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from
   ulong * keys = filter->filter.keys;
   fd_gossip_bitvec_u64_t * bitvec = &filter->filter.bits;
   ulong * bitvec2 = bitvec->bits.vec;
+  if (nkeys > 0 && (!bitvec->has_bits || bitvec->len == 0 || bitvec->len > bitvec->bits.vec_len*64U)) {
+    FD_LOG_WARNING(("invalid bloom filter in pull request"));
+    return;
+  }
+  if (filter->mask_bits > 64U) {
+    FD_LOG_WARNING(("invalid mask bits in pull request"));
+    return;
+  }
+  /* Only visit the shards matching the mask. If the mask is longer than
+     the shard index, the remaining bits are checked per value. */
+  uint mask_bits = filter->mask_bits;
+  ulong m = (mask_bits == 64U ? 0UL : (~0UL >> mask_bits));
+  ulong shard_lo = 0;
+  ulong shard_cnt = FD_VALUE_SHARD_CNT;
+  if (mask_bits >= FD_VALUE_SHARD_LG) {
+    shard_lo = filter->mask >> (64U - FD_VALUE_SHARD_LG);
+    shard_cnt = 1;
+  } else if (mask_bits != 0U) {
+    shard_lo = (filter->mask >> (64U - mask_bits)) << (FD_VALUE_SHARD_LG - mask_bits);
+    shard_cnt = 1UL << (FD_VALUE_SHARD_LG - mask_bits);
+  }
   ulong expire = FD_NANOSEC_TO_MILLI(glob->now) - FD_GOSSIP_PULL_TIMEOUT;
   ulong hits = 0;
   ulong misses = 0;
   uint npackets = 0;
-  for( fd_value_table_iter_t iter = fd_value_table_iter_init( glob->values );
-       !fd_value_table_iter_done( glob->values, iter );
-       iter = fd_value_table_iter_next( glob->values, iter ) ) {
-    fd_value_elem_t * ele = fd_value_table_iter_ele( glob->values, iter );
+  for (ulong shard = shard_lo; shard < shard_lo + shard_cnt; ++shard)
+  for (uint idx = glob->value_shards[shard]; idx != UINT_MAX; ) {
+    fd_value_elem_t * ele = glob->values + idx;
+    idx = ele->shard_next;
     fd_hash_t * hash = &(ele->key);
     if (ele->wallclock < expire)
       continue;
     /* Execute the bloom filter */
-    if (filter->mask_bits != 0U) {
-      ulong m = (~0UL >> filter->mask_bits);
-      if ((hash->ul[0] | m) != filter->mask)
-        continue;
-    }
-    int miss = 0;
-    for (ulong i = 0; i < nkeys; ++i) {
-      ulong pos = fd_gossip_bloom_pos(hash, keys[i], bitvec->len);
-      ulong * j = bitvec2 + (pos>>6U); /* divide by 64 */
-      ulong bit = 1UL<<(pos & 63U);
-      if (!((*j) & bit)) {
-        miss = 1;
-        break;
-      }
-    }
-    if (!miss) {
+    if (mask_bits != 0U && (hash->ul[0] | m) != filter->mask)
+      continue;
+    if (!fd_gossip_bloom_miss(hash, keys, nkeys, bitvec2, bitvec->len)) {
       hits++;
       continue;
     }
@@ -1164,14 +1298,12 @@ fd_gossip_recv(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_gossip
     break;
   case fd_gossip_msg_enum_pull_resp: {
     fd_gossip_pull_resp_t * pull_resp = &gmsg->inner.pull_resp;
-    for (ulong i = 0; i < pull_resp->crds_len; ++i)
-      fd_gossip_recv_crds_value(glob, NULL, &pull_resp->pubkey, pull_resp->crds + i);
+    fd_gossip_recv_crds_values(glob, NULL, &pull_resp->pubkey, pull_resp->crds, pull_resp->crds_len);
     break;
   }
   case fd_gossip_msg_enum_push_msg: {
     fd_gossip_push_msg_t * push_msg = &gmsg->inner.push_msg;
-    for (ulong i = 0; i < push_msg->crds_len; ++i)
-      fd_gossip_recv_crds_value(glob, from, &push_msg->pubkey, push_msg->crds + i);
+    fd_gossip_recv_crds_values(glob, from, &push_msg->pubkey, push_msg->crds, push_msg->crds_len);
     break;
   }
   case fd_gossip_msg_enum_prune_msg:
@@ -1398,6 +1530,7 @@ fd_gossip_push_value( fd_gossip_t * glob, fd_crds_data_t * data ) {
     return -1;
   }
   msg = fd_value_table_insert(glob->values, &key);
+  fd_gossip_value_link(glob, msg);
   msg->wallclock = FD_NANOSEC_TO_MILLI(glob->now); /* convert to ms */
   fd_hash_copy(&msg->origin, glob->public_key);
   /* We store the serialized form for convenience */
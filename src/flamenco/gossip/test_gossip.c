@@ -0,0 +1,265 @@
+#include "fd_gossip.c"
+
+/* Values of the test table.  The high 64 bits of the hash (which pull
+   request masks and the value shards are based on) are given below,
+   the rest of the hash is filled from the index. */
+
+#define TEST_VALUE_CNT (9UL)
+
+static ulong const test_value_hi[ TEST_VALUE_CNT ] = {
+  0x0000000000000000UL, /* shard 0x000 */
+  0x003fffffffffffffUL, /* shard 0x000 */
+  0x0040000000000000UL, /* shard 0x001 */
+  0x8000000000000000UL, /* shard 0x200 */
+  0x8020000000000000UL, /* shard 0x200 */
+  0xabcdef0123456789UL, /* shard 0x2af */
+  0xffffffffffffffffUL, /* shard 0x3ff */
+  0xabcdef0000000000UL, /* shard 0x2af */
+  0x8000000000000001UL, /* shard 0x200, expired */
+};
+
+static ulong const test_value_shard[ TEST_VALUE_CNT ] = {
+  0x000UL, 0x000UL, 0x001UL, 0x200UL, 0x200UL, 0x2afUL, 0x3ffUL, 0x2afUL, 0x200UL
+};
+
+#define TEST_VALUE_EXPIRED (8UL)
+#define TEST_VALUE_SZ      (16UL)
+
+static void
+test_hash( fd_hash_t * hash,
+           ulong       i ) {
+  hash->ul[0] = test_value_hi[ i ];
+  hash->ul[1] = i;
+  hash->ul[2] = 0x0123456789abcdefUL;
+  hash->ul[3] = 0xfedcba9876543210UL;
+}
+
+/* Values found in the pull responses sent by the test, as a bit set of
+   their indices */
+
+static ulong resp_set;
+
+static void
+test_send_fun( uchar const *                 msg,
+               size_t                        msglen,
+               fd_gossip_peer_addr_t const * addr,
+               void *                        arg ) {
+  (void)addr; (void)arg;
+
+  /* Pull response: discriminant, pubkey, value count, then the values
+     as they were encoded */
+  ulong hdr_sz = sizeof(uint) + sizeof(fd_pubkey_t) + sizeof(ulong);
+  FD_TEST( msglen>hdr_sz );
+  FD_TEST( FD_LOAD( uint, msg )==fd_gossip_msg_enum_pull_resp );
+  ulong crds_len = FD_LOAD( ulong, msg + hdr_sz - sizeof(ulong) );
+  FD_TEST( msglen==hdr_sz + crds_len*TEST_VALUE_SZ );
+  for( ulong i=0UL; i<crds_len; i++ ) {
+    uchar idx = msg[ hdr_sz + i*TEST_VALUE_SZ ];
+    FD_TEST( idx<TEST_VALUE_CNT );
+    FD_TEST( !(resp_set & (1UL<<idx)) );
+    resp_set |= 1UL<<idx;
+  }
+}
+
+static void
+test_value_shards( void ) {
+  fd_hash_t hash;
+  for( ulong i=0UL; i<TEST_VALUE_CNT; i++ ) {
+    test_hash( &hash, i );
+    FD_TEST( fd_value_shard( &hash )==test_value_shard[ i ] );
+  }
+}
+
+static void
+test_bloom( void ) {
+  fd_hash_t hash;
+  for( ulong i=0UL; i<32UL; i++ ) hash.uc[i] = (uchar)i;
+
+  FD_TEST( fd_gossip_bloom_pos( &hash, 0x0000000000000000UL, 4096UL )==2304UL );
+  FD_TEST( fd_gossip_bloom_pos( &hash, 0x0000000000000001UL, 4096UL )==2401UL );
+  FD_TEST( fd_gossip_bloom_pos( &hash, 0x0123456789abcdefUL, 4096UL )== 367UL );
+  FD_TEST( fd_gossip_bloom_pos( &hash, 0xcbf29ce484222325UL, 1000UL )== 869UL );
+  FD_TEST( fd_gossip_bloom_pos( &hash, 42UL,                    1UL )==   0UL );
+
+  memset( hash.uc, 0xff, 32UL );
+  FD_TEST( fd_gossip_bloom_pos( &hash, 0UL, 4096UL )==992UL );
+  FD_TEST( fd_gossip_bloom_pos( &hash, 7UL,   64UL )== 39UL );
+
+  /* More keys than FD_BLOOM_LANES, such that the probe runs a partial
+     second batch */
+
+  ulong keys[ 11 ];
+  for( ulong i=0UL; i<11UL; i++ ) keys[i] = 0x9e3779b97f4a7c15UL*(i+1UL);
+  ulong bits[ 4096UL/64UL ];
+  memset( bits, 0, sizeof(bits) );
+
+  FD_TEST( !fd_gossip_bloom_miss( &hash, keys, 0UL, bits, 4096UL ) );
+  FD_TEST(  fd_gossip_bloom_miss( &hash, keys, 1UL, bits, 4096UL ) );
+
+  for( ulong i=0UL; i<11UL; i++ ) {
+    ulong pos = fd_gossip_bloom_pos( &hash, keys[i], 4096UL );
+    bits[ pos>>6 ] |= 1UL<<(pos&63UL);
+  }
+  FD_TEST( !fd_gossip_bloom_miss( &hash, keys, 11UL, bits, 4096UL ) );
+
+  for( ulong i=0UL; i<11UL; i++ ) {
+    ulong pos = fd_gossip_bloom_pos( &hash, keys[i], 4096UL );
+    bits[ pos>>6 ] &= ~(1UL<<(pos&63UL));
+    FD_TEST( fd_gossip_bloom_miss( &hash, keys, 11UL, bits, 4096UL ) );
+    FD_TEST( fd_gossip_bloom_miss( &hash, keys, i+1UL, bits, 4096UL ) );
+    FD_TEST( !fd_gossip_bloom_miss( &hash, keys, i, bits, 4096UL ) );
+    bits[ pos>>6 ] |= 1UL<<(pos&63UL);
+  }
+}
+
+/* pull_req sends a pull request with the given mask to glob, with a
+   bloom filter of keys_len keys over bloom (4096 bits).  Returns the
+   values in the response, see resp_set. */
+
+static ulong
+pull_req( fd_gossip_t *                 glob,
+          fd_gossip_peer_addr_t const * from,
+          ulong                         mask,
+          uint                          mask_bits,
+          ulong *                       keys,
+          ulong                         keys_len,
+          ulong *                       bloom ) {
+  fd_gossip_pull_req_t req;
+  memset( &req, 0, sizeof(req) );
+  req.filter.mask                      = mask;
+  req.filter.mask_bits                 = mask_bits;
+  req.filter.filter.keys               = keys;
+  req.filter.filter.keys_len           = keys_len;
+  req.filter.filter.bits.has_bits      = 1;
+  req.filter.filter.bits.len           = 4096UL;
+  req.filter.filter.bits.bits.vec      = bloom;
+  req.filter.filter.bits.bits.vec_len  = 4096UL/64UL;
+
+  resp_set = 0UL;
+  fd_gossip_handle_pull_req( glob, from, &req );
+  return resp_set;
+}
+
+static void
+test_pull_resp( void ) {
+  fd_valloc_t valloc = fd_libc_alloc_virtual();
+  void * mem = aligned_alloc( fd_gossip_align(), fd_ulong_align_up( fd_gossip_footprint(), fd_gossip_align() ) );
+  FD_TEST( mem );
+  fd_gossip_t * glob = fd_gossip_join( fd_gossip_new( mem, 42UL, valloc ) );
+  FD_TEST( glob );
+
+  static fd_pubkey_t public_key;
+  glob->public_key = &public_key;
+  glob->send_fun   = test_send_fun;
+  glob->now        = (long)1e15;
+
+  /* Only peers that answered a ping get a response */
+
+  fd_gossip_peer_addr_t from = { .l = 77UL };
+  fd_active_elem_t * active = fd_active_table_insert( glob->actives, &from );
+  fd_active_new_value( active );
+  active->pongtime = 1L;
+
+  ulong now_ms = FD_NANOSEC_TO_MILLI( glob->now );
+  for( ulong i=0UL; i<TEST_VALUE_CNT; i++ ) {
+    fd_hash_t hash;
+    test_hash( &hash, i );
+    fd_value_elem_t * ele = fd_value_table_insert( glob->values, &hash );
+    FD_TEST( ele );
+    fd_gossip_value_link( glob, ele );
+    ele->data      = fd_valloc_malloc( valloc, 1UL, TEST_VALUE_SZ );
+    FD_TEST( ele->data );
+    memset( ele->data, 0, TEST_VALUE_SZ );
+    ele->data[0]   = (uchar)i;
+    ele->datalen   = TEST_VALUE_SZ;
+    ele->wallclock = i==TEST_VALUE_EXPIRED ? now_ms - FD_GOSSIP_PULL_TIMEOUT - 1UL : now_ms;
+  }
+
+  /* Every value sits in the list of its shard */
+
+  for( ulong s=0UL; s<FD_VALUE_SHARD_CNT; s++ ) {
+    ulong exp_set = 0UL;
+    for( ulong i=0UL; i<TEST_VALUE_CNT; i++ ) if( test_value_shard[ i ]==s ) exp_set |= 1UL<<i;
+    ulong set = 0UL;
+    for( uint idx=glob->value_shards[ s ]; idx!=UINT_MAX; idx=glob->values[ idx ].shard_next )
+      set |= 1UL<<glob->values[ idx ].key.ul[1];
+    FD_TEST( set==exp_set );
+  }
+
+  /* Masks shorter than, as long as and longer than the shard index,
+     with an empty bloom filter */
+
+  ulong bloom[ 4096UL/64UL ];
+  memset( bloom, 0, sizeof(bloom) );
+  ulong keys[ 2 ] = { 0x1111UL, 0x2222UL };
+
+  FD_TEST( pull_req( glob, &from, 0UL,                   0U,  keys, 2UL, bloom )==0x0ffUL );
+  FD_TEST( pull_req( glob, &from, 0x7fffffffffffffffUL,  1U,  keys, 2UL, bloom )==0x007UL );
+  FD_TEST( pull_req( glob, &from, 0xffffffffffffffffUL,  1U,  keys, 2UL, bloom )==0x0f8UL );
+  FD_TEST( pull_req( glob, &from, 0x003fffffffffffffUL, 10U,  keys, 2UL, bloom )==0x003UL );
+  FD_TEST( pull_req( glob, &from, 0x803fffffffffffffUL, 10U,  keys, 2UL, bloom )==0x018UL );
+  FD_TEST( pull_req( glob, &from, 0x801fffffffffffffUL, 11U,  keys, 2UL, bloom )==0x008UL );
+  FD_TEST( pull_req( glob, &from, 0x803fffffffffffffUL, 11U,  keys, 2UL, bloom )==0x010UL );
+  FD_TEST( pull_req( glob, &from, 0xabcdefffffffffffUL, 24U,  keys, 2UL, bloom )==0x0a0UL );
+  FD_TEST( pull_req( glob, &from, 0xabcdef0123456789UL, 64U,  keys, 2UL, bloom )==0x020UL );
+  FD_TEST( pull_req( glob, &from, 0x5fffffffffffffffUL,  3U,  keys, 2UL, bloom )==0x000UL );
+
+  /* A filter without keys matches everything, such that the requester
+     is sent nothing */
+
+  FD_TEST( pull_req( glob, &from, 0UL, 0U, keys, 0UL, bloom )==0x000UL );
+
+  /* With both bits of value 5 (at 3012 and 2503 for these keys) set in
+     the bloom filter, the requester already has it */
+
+  bloom[ 3012UL>>6 ] |= 1UL<<(3012UL&63UL);
+  FD_TEST( pull_req( glob, &from, 0UL, 0U, keys, 2UL, bloom )==0x0ffUL );
+  bloom[ 2503UL>>6 ] |= 1UL<<(2503UL&63UL);
+  FD_TEST( pull_req( glob, &from, 0UL,                   0U, keys, 2UL, bloom )==0x0dfUL );
+  FD_TEST( pull_req( glob, &from, 0xabcdefffffffffffUL, 24U, keys, 2UL, bloom )==0x080UL );
+  FD_TEST( pull_req( glob, &from, 0xabcdefffffffffffUL, 24U, keys, 1UL, bloom )==0x080UL );
+
+  /* Invalid filters get no response */
+
+  FD_TEST( pull_req( glob, &from, 0UL, 65U, keys, 2UL, bloom )==0UL );
+  fd_gossip_pull_req_t req;
+  memset( &req, 0, sizeof(req) );
+  req.filter.filter.keys     = keys;
+  req.filter.filter.keys_len = 2UL;
+  resp_set = 0UL;
+  fd_gossip_handle_pull_req( glob, &from, &req );
+  FD_TEST( !resp_set );
+
+  /* Unlinking keeps the shard lists consistent */
+
+  memset( bloom, 0, sizeof(bloom) );
+
+  for( ulong i=0UL; i<TEST_VALUE_CNT; i+=2UL ) {
+    fd_hash_t hash;
+    test_hash( &hash, i );
+    fd_value_elem_t * ele = fd_value_table_query( glob->values, &hash, NULL );
+    FD_TEST( ele );
+    fd_valloc_free( valloc, ele->data );
+    fd_gossip_value_unlink( glob, ele );
+    fd_value_table_remove( glob->values, &hash );
+  }
+  FD_TEST( pull_req( glob, &from, 0UL,                   0U,  keys, 2UL, bloom )==0x0aaUL );
+  FD_TEST( pull_req( glob, &from, 0xabcdefffffffffffUL, 24U,  keys, 2UL, bloom )==0x0a0UL );
+  FD_TEST( pull_req( glob, &from, 0x803fffffffffffffUL, 10U,  keys, 2UL, bloom )==0x008UL );
+
+  free( fd_gossip_delete( fd_gossip_leave( glob ), valloc ) );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  test_value_shards();
+  test_bloom();
+  test_pull_resp();
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
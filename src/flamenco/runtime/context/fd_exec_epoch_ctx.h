@@ -4,6 +4,7 @@
 #include "../fd_runtime.h"
 #include "../../features/fd_features.h"
 #include "../../leaders/fd_leaders.h"
+#include "../program/fd_bpf_program_cache.h"
 
 /* fd_exec_epoch_ctx_t is the context that stays constant throughout
    an entire epoch. */
@@ -17,6 +18,12 @@ struct __attribute__((aligned(8UL))) fd_exec_epoch_ctx {
   fd_epoch_leaders_t * leaders;  /* Current epoch only */
   fd_features_t        features;
   fd_epoch_bank_t      epoch_bank;
+
+  /* Cache of loaded sBPF programs, shared by all slots of the epoch.
+     NULL if program caching is disabled.  Loader v4 keeps it coherent
+     with program accounts but does not execute programs yet, so
+     nothing loads programs through it. */
+  fd_bpf_program_cache_t * program_cache;
 };
 
 #define FD_EXEC_EPOCH_CTX_ALIGN     (alignof(fd_exec_epoch_ctx_t))
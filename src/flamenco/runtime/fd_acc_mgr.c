@@ -56,7 +56,7 @@ fd_rent_lists_cb( fd_funk_rec_t * rec,
   fd_acc_mgr_t *       acc_mgr  = slot_ctx->acc_mgr;
 
   if( fd_funk_key_is_acc( rec->pair.key ) ) {
-    if( acc_mgr->skip_rent_rewrites ) {
+    if( acc_mgr->skip_rent_rewrites && !fd_funk_rec_is_cold( rec ) ) { /* Cold accounts are conservatively kept in the rent lists */
       void const * data = fd_funk_val( rec, fd_funk_wksp(acc_mgr->funk) );
       fd_account_meta_t const * metadata = fd_type_pun_const( data );
 
@@ -102,7 +102,14 @@ fd_acc_mgr_view_raw( fd_acc_mgr_t *         acc_mgr,
   fd_funk_rec_key_t id   = fd_acc_funk_key( pubkey );
   fd_funk_t *       funk = acc_mgr->funk;
 
-  fd_funk_rec_t const * rec = fd_funk_rec_query_global( funk, txn, &id );
+  int funk_err = FD_FUNK_SUCCESS;
+  fd_funk_rec_t const * rec = fd_funk_rec_query_warm( funk, txn, &id, &funk_err );
+
+  if( FD_UNLIKELY( !rec && funk_err!=FD_FUNK_ERR_KEY ) ) {
+    /* The value was evicted to the cold file and could not be loaded */
+    fd_int_store_if( !!opt_err, opt_err, FD_ACC_MGR_ERR_READ_FAILED );
+    return NULL;
+  }
 
   if( FD_UNLIKELY( !rec || !!( rec->flags & FD_FUNK_REC_FLAG_ERASE ) ) )  {
     fd_int_store_if( !!opt_err, opt_err, FD_ACC_MGR_ERR_UNKNOWN_ACCOUNT );
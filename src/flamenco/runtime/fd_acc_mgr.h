@@ -144,7 +144,8 @@ fd_acc_exists( fd_account_meta_t const * m ) {
    transaction to query.  pubkey is the account key to query.
 
    On success:
-   - loads the account data into in-memory cache
+   - loads the account data into in-memory cache (reading it back from
+     the funk cold file if it was evicted, see fd_funk_cold.h)
    - returns a pointer to it in the caller's local address space
    - if out_rec!=NULL, sets *out_rec to a pointer to the funk rec.
      This handle is suitable as opt_con_rec for fd_acc_mgr_modify_raw.
@@ -158,7 +159,9 @@ fd_acc_exists( fd_account_meta_t const * m ) {
 
    On failure, returns NULL, and sets *opt_err if opt_err!=NULL.
    Reasons for error include
-   - account not found
+   - account not found (FD_ACC_MGR_ERR_UNKNOWN_ACCOUNT)
+   - account evicted to the funk cold file and could not be loaded
+     (FD_ACC_MGR_ERR_READ_FAILED)
    - internal database or user error (out of memory, attempting to view
      record which has an active modify_data handle, etc.)
 
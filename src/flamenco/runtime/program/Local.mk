@@ -5,6 +5,11 @@ $(call add-objs,fd_bpf_loader_v1_program,fd_flamenco)
 $(call add-hdrs,fd_bpf_loader_v4_program.h)
 $(call add-objs,fd_bpf_loader_v4_program,fd_flamenco)
 
+$(call add-hdrs,fd_bpf_program_cache.h)
+$(call add-objs,fd_bpf_program_cache,fd_flamenco)
+$(call make-unit-test,test_bpf_program_cache,test_bpf_program_cache,fd_flamenco fd_funk fd_ballet fd_util)
+$(call run-unit-test,test_bpf_program_cache)
+
 $(call add-hdrs,fd_config_program.h)
 $(call add-objs,fd_config_program,fd_flamenco)
 
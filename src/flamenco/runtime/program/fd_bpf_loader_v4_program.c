@@ -7,6 +7,8 @@
 #include "../sysvar/fd_sysvar_rent.h"
 #include "../../types/fd_types.h"
 #include "../../../util/bits/fd_sat.h"
+#include "../context/fd_exec_epoch_ctx.h"
+#include "../context/fd_exec_slot_ctx.h"
 
 #define DEPLOYMENT_COOLDOWN_IN_SLOTS (750)
 
@@ -20,6 +22,17 @@ static int _process_deploy            ( fd_exec_instr_ctx_t );
 static int _process_retract           ( fd_exec_instr_ctx_t );
 static int _process_transfer_authority( fd_exec_instr_ctx_t );
 
+/* invalidate_program_cache drops cached images of program_id from the
+   epoch's program cache (if any).  Called whenever an instruction
+   modifies the program data of a program account. */
+
+static void
+invalidate_program_cache( fd_exec_instr_ctx_t ctx,
+                          fd_pubkey_t const * program_id ) {
+  fd_bpf_program_cache_t * cache = ctx.slot_ctx->epoch_ctx->program_cache;
+  if( cache ) fd_bpf_program_cache_invalidate( cache, program_id );
+}
+
 /* check_program_account runs a sequence of checks on an account owned
    by the BPF Loader v4 program.  Used by most instruction handlers.
 
@@ -226,6 +239,8 @@ _process_write( fd_exec_instr_ctx_t                                  ctx,
   uchar * write_ptr = program_rec->data + write_off;
   fd_memcpy( write_ptr, bytes, bytes_len );
 
+  invalidate_program_cache( ctx, program_id );
+
   return 0;
 }
 
@@ -341,6 +356,8 @@ _process_truncate( fd_exec_instr_ctx_t ctx,
     fd_memset( program->data + program->meta->dlen, 0, raw_new_sz - program->meta->dlen );
   program->meta->dlen = raw_new_sz;
 
+  invalidate_program_cache( ctx, program->pubkey );
+
   if( new_sz!=0U ) {
     /* https://github.com/solana-labs/solana/blob/fb80288f885a62bcd923f4c9579fd0edeafaff9b/programs/loader-v4/src/lib.rs#L339-L344 */
     if( is_init ) {
@@ -423,7 +440,28 @@ _process_deploy( fd_exec_instr_ctx_t ctx ) {
     buffer_data = program_acc_rec->data;
   }
 
-  FD_LOG_WARNING(("TODO: load program"));
+  /* Verify the program.  Cached images of the superseded deployment
+     are dropped.  The program cache is not populated here: it is only
+     useful to the program execution path, which loads the program on
+     first invocation. */
+
+  invalidate_program_cache( ctx, program_acc );
+  if( source_program ) invalidate_program_cache( ctx, source_program );
+
+  if( FD_UNLIKELY( buffer_metadata->dlen < sizeof(fd_bpf_loader_v4_state_t) ) )
+    return FD_EXECUTOR_INSTR_ERR_INVALID_ACC_DATA;
+  uchar const * elf    = buffer_data           + sizeof(fd_bpf_loader_v4_state_t);
+  ulong         elf_sz = buffer_metadata->dlen - sizeof(fd_bpf_loader_v4_state_t);
+
+  int load_err = fd_bpf_program_verify( elf, elf_sz, ctx.slot_ctx->valloc );
+  if( FD_UNLIKELY( load_err==FD_BPF_PROGRAM_CACHE_ERR_NOMEM ) ) {
+    FD_LOG_WARNING(( "out of memory verifying program" ));
+    return FD_EXECUTOR_INSTR_ERR_PROGRAM_ENVIRONMENT_SETUP_FAILURE;
+  }
+  if( FD_UNLIKELY( load_err!=FD_BPF_PROGRAM_CACHE_SUCCESS ) ) {
+    /* TODO Log: "Failed to load program" */
+    return FD_EXECUTOR_INSTR_ERR_INVALID_ACC_DATA;
+  }
 
   if( source_program ) {
     ulong required_lamports = fd_rent_exempt_minimum_balance(ctx.slot_ctx, program_acc_rec->meta->dlen);
@@ -440,8 +478,6 @@ _process_deploy( fd_exec_instr_ctx_t ctx ) {
   mut_state->slot   = current_slot;
   mut_state->status = FD_BPF_LOADER_V4_STATUS_DEPLOYED;
 
-  (void) buffer_data;
-  (void) buffer_metadata;
   (void) authority_address;
   return FD_EXECUTOR_INSTR_SUCCESS;
 }
@@ -503,6 +539,8 @@ _process_retract( fd_exec_instr_ctx_t ctx ) {
   /* https://github.com/solana-labs/solana/blob/d90e1582869d8ef8d386a1c156eda987404c43be/programs/loader-v4/src/lib.rs#L517 */
   state_rw->status = FD_BPF_LOADER_V4_STATUS_RETRACTED;
 
+  invalidate_program_cache( ctx, program_id );
+
   return 0;
 }
 
@@ -0,0 +1,396 @@
+#include "fd_bpf_program_cache.h"
+#include "../../vm/fd_vm_context.h"
+#include "../../vm/fd_vm_syscalls.h"
+
+/* Map of cached program images ***************************************/
+
+static const fd_bpf_program_cache_key_t
+fd_bpf_program_cache_key_null = {0};
+
+static inline int
+fd_bpf_program_cache_key_inval( fd_bpf_program_cache_key_t const * key ) {
+  return 0==memcmp( key, &fd_bpf_program_cache_key_null, sizeof(fd_bpf_program_cache_key_t) );
+}
+
+static inline uint
+fd_bpf_program_cache_key_hash( fd_bpf_program_cache_key_t const * key ) {
+  return (uint)fd_hash( 0x5e3d1a2b9c8f7064UL, key, sizeof(fd_bpf_program_cache_key_t) );
+}
+
+#define MAP_NAME              fd_bpf_program_cache_map
+#define MAP_T                 fd_bpf_program_cache_entry_t
+#define MAP_LG_SLOT_CNT       FD_BPF_PROGRAM_CACHE_LG_SLOT_CNT
+#define MAP_KEY_T             fd_bpf_program_cache_key_t
+#define MAP_KEY_NULL          fd_bpf_program_cache_key_null
+#define MAP_KEY_INVAL(k)      fd_bpf_program_cache_key_inval( &(k) )
+#define MAP_KEY_EQUAL(k0,k1)  (0==memcmp( &(k0), &(k1), sizeof(fd_bpf_program_cache_key_t) ))
+#define MAP_KEY_EQUAL_IS_SLOW 1
+#define MAP_KEY_HASH(k)       fd_bpf_program_cache_key_hash( &(k) )
+#include "../../../util/tmpl/fd_map.c"
+
+/* Cache object *******************************************************/
+
+struct __attribute__((aligned(64UL))) fd_bpf_program_cache {
+  ulong magic;  /* ==FD_BPF_PROGRAM_CACHE_MAGIC */
+
+  fd_valloc_t valloc;     /* of current join */
+  ulong       clock;      /* LRU clock, incremented on every load */
+  ulong       entry_cnt;  /* number of map entries */
+
+  fd_bpf_program_cache_stats_t stats;
+
+  ulong map_off;       /* offset to fd_bpf_program_cache_map */
+  ulong syscalls_off;  /* offset to fd_sbpf_syscalls */
+};
+
+FD_FN_CONST ulong
+fd_bpf_program_cache_align( void ) {
+  return fd_ulong_max( alignof(fd_bpf_program_cache_t),
+         fd_ulong_max( fd_bpf_program_cache_map_align(),
+                       fd_sbpf_syscalls_align() ) );
+}
+
+FD_FN_CONST ulong
+fd_bpf_program_cache_footprint( void ) {
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, alignof(fd_bpf_program_cache_t),  sizeof(fd_bpf_program_cache_t)        );
+  l = FD_LAYOUT_APPEND( l, fd_bpf_program_cache_map_align(), fd_bpf_program_cache_map_footprint() );
+  l = FD_LAYOUT_APPEND( l, fd_sbpf_syscalls_align(),         fd_sbpf_syscalls_footprint()         );
+  return FD_LAYOUT_FINI( l, fd_bpf_program_cache_align() );
+}
+
+void *
+fd_bpf_program_cache_new( void * mem ) {
+
+  if( FD_UNLIKELY( !mem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)mem, fd_bpf_program_cache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned mem" ));
+    return NULL;
+  }
+
+  FD_SCRATCH_ALLOC_INIT( l, mem );
+  fd_bpf_program_cache_t * cache   = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_bpf_program_cache_t),  sizeof(fd_bpf_program_cache_t)        );
+  void *                 map_mem   = FD_SCRATCH_ALLOC_APPEND( l, fd_bpf_program_cache_map_align(), fd_bpf_program_cache_map_footprint() );
+  void *                 sys_mem   = FD_SCRATCH_ALLOC_APPEND( l, fd_sbpf_syscalls_align(),         fd_sbpf_syscalls_footprint()         );
+  FD_SCRATCH_ALLOC_FINI( l, fd_bpf_program_cache_align() );
+
+  fd_memset( cache, 0, sizeof(fd_bpf_program_cache_t) );
+
+  fd_bpf_program_cache_entry_t * map = fd_bpf_program_cache_map_join( fd_bpf_program_cache_map_new( map_mem ) );
+  fd_sbpf_syscalls_t *           syscalls = fd_sbpf_syscalls_join( fd_sbpf_syscalls_new( sys_mem ) );
+  if( FD_UNLIKELY( !map || !syscalls ) ) {
+    FD_LOG_WARNING(( "failed to create program cache" ));
+    return NULL;
+  }
+  fd_vm_syscall_register_all( syscalls );
+
+  cache->map_off      = (ulong)map      - (ulong)cache;
+  cache->syscalls_off = (ulong)syscalls - (ulong)cache;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = FD_BPF_PROGRAM_CACHE_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return mem;
+}
+
+fd_bpf_program_cache_t *
+fd_bpf_program_cache_join( void *      mem,
+                           fd_valloc_t valloc ) {
+
+  if( FD_UNLIKELY( !mem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+
+  fd_bpf_program_cache_t * cache = (fd_bpf_program_cache_t *)mem;
+  if( FD_UNLIKELY( cache->magic!=FD_BPF_PROGRAM_CACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  cache->valloc = valloc;
+  return cache;
+}
+
+void *
+fd_bpf_program_cache_leave( fd_bpf_program_cache_t * cache ) {
+
+  if( FD_UNLIKELY( !cache ) ) {
+    FD_LOG_WARNING(( "NULL cache" ));
+    return NULL;
+  }
+
+  return (void *)cache;
+}
+
+static inline fd_bpf_program_cache_entry_t *
+fd_bpf_program_cache_get_map( fd_bpf_program_cache_t const * cache ) {
+  return (fd_bpf_program_cache_entry_t *)( (ulong)cache + cache->map_off );
+}
+
+FD_FN_PURE fd_sbpf_syscalls_t *
+fd_bpf_program_cache_syscalls( fd_bpf_program_cache_t * cache ) {
+  return (fd_sbpf_syscalls_t *)( (ulong)cache + cache->syscalls_off );
+}
+
+FD_FN_PURE ulong
+fd_bpf_program_cache_entry_cnt( fd_bpf_program_cache_t const * cache ) {
+  return cache->entry_cnt;
+}
+
+FD_FN_PURE fd_bpf_program_cache_stats_t const *
+fd_bpf_program_cache_stats( fd_bpf_program_cache_t const * cache ) {
+  return &cache->stats;
+}
+
+/* fd_bpf_program_cache_entry_remove releases the program image of
+   entry and removes it from the map.  entry may be clobbered. */
+
+static void
+fd_bpf_program_cache_entry_remove( fd_bpf_program_cache_t *       cache,
+                                   fd_bpf_program_cache_entry_t * entry ) {
+  if( entry->prog ) {
+    /* Program object and rodata share a single allocation starting at
+       the program object (see fd_bpf_program_cache_prepare). */
+    fd_valloc_free( cache->valloc, fd_sbpf_program_delete( entry->prog ) );
+    entry->prog = NULL;
+  }
+  fd_bpf_program_cache_map_remove( fd_bpf_program_cache_get_map( cache ), entry );
+  cache->entry_cnt--;
+}
+
+/* fd_bpf_program_cache_evict removes the least recently used entry.
+   Returns 1 if an entry was removed and 0 if the cache was empty.  The
+   linear scan is cheap compared to the program load that caused it. */
+
+static int
+fd_bpf_program_cache_evict( fd_bpf_program_cache_t * cache ) {
+  fd_bpf_program_cache_entry_t * map = fd_bpf_program_cache_get_map( cache );
+  fd_bpf_program_cache_entry_t * lru = NULL;
+  ulong slot_cnt = fd_bpf_program_cache_map_slot_cnt();
+  for( ulong i=0UL; i<slot_cnt; i++ ) {
+    fd_bpf_program_cache_entry_t * entry = map + i;
+    if( fd_bpf_program_cache_key_inval( &entry->key ) ) continue;
+    if( !lru || entry->last_used < lru->last_used ) lru = entry;
+  }
+  if( FD_UNLIKELY( !lru ) ) return 0;
+  fd_bpf_program_cache_entry_remove( cache, lru );
+  cache->stats.evict_cnt++;
+  return 1;
+}
+
+/* fd_bpf_program_cache_malloc allocates from valloc.  If cache is
+   non-NULL, valloc is the cache's and entries are evicted until the
+   allocation succeeds or the cache is empty. */
+
+static void *
+fd_bpf_program_cache_malloc( fd_bpf_program_cache_t * cache,
+                             fd_valloc_t              valloc,
+                             ulong                    align,
+                             ulong                    sz ) {
+  for(;;) {
+    void * mem = fd_valloc_malloc( valloc, align, sz );
+    if( FD_LIKELY( mem ) ) return mem;
+    if( !cache || !fd_bpf_program_cache_evict( cache ) ) return NULL;
+  }
+}
+
+/* fd_bpf_program_prepare loads and validates the given ELF against the
+   given syscall table, allocating from valloc (see
+   fd_bpf_program_cache_malloc for cache).  Returns the loaded program
+   on success, which the caller frees with
+   fd_valloc_free( valloc, fd_sbpf_program_delete( prog ) ).  On
+   failure, returns NULL and writes the reason to *err. */
+
+static fd_sbpf_program_t *
+fd_bpf_program_prepare( fd_bpf_program_cache_t * cache,
+                        fd_valloc_t              valloc,
+                        fd_sbpf_syscalls_t *     syscalls,
+                        uchar const *            elf,
+                        ulong                    elf_sz,
+                        int *                    err ) {
+
+  fd_sbpf_elf_info_t info[1];
+  if( FD_UNLIKELY( !fd_sbpf_elf_peek( info, elf, elf_sz ) ) ) {
+    *err = FD_BPF_PROGRAM_CACHE_ERR_ELF;
+    return NULL;
+  }
+
+  /* Allocate the program object and its rodata buffer together */
+
+  ulong prog_footprint = fd_ulong_align_up( fd_sbpf_program_footprint( info ), 8UL );
+  ulong alloc_sz       = prog_footprint + (ulong)info->rodata_footprint;
+  uchar * mem = fd_bpf_program_cache_malloc( cache, valloc, fd_sbpf_program_align(), alloc_sz );
+  if( FD_UNLIKELY( !mem ) ) {
+    *err = FD_BPF_PROGRAM_CACHE_ERR_NOMEM;
+    return NULL;
+  }
+
+  fd_sbpf_program_t * prog = fd_sbpf_program_new( mem, info, mem + prog_footprint );
+  if( FD_UNLIKELY( !prog ) ) {
+    fd_valloc_free( valloc, mem );
+    *err = FD_BPF_PROGRAM_CACHE_ERR_ELF;
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( 0!=fd_sbpf_program_load( prog, elf, elf_sz, syscalls ) ) ) {
+    FD_LOG_DEBUG(( "fd_sbpf_program_load() failed: %s", fd_sbpf_strerror() ));
+    fd_valloc_free( valloc, fd_sbpf_program_delete( prog ) );
+    *err = FD_BPF_PROGRAM_CACHE_ERR_ELF;
+    return NULL;
+  }
+
+  /* fd_vm_context_validate only reads the program fields of the
+     execution context, but the context is too large for the stack. */
+
+  fd_vm_exec_context_t * vm_ctx = fd_bpf_program_cache_malloc( cache, valloc, alignof(fd_vm_exec_context_t), sizeof(fd_vm_exec_context_t) );
+  if( FD_UNLIKELY( !vm_ctx ) ) {
+    fd_valloc_free( valloc, fd_sbpf_program_delete( prog ) );
+    *err = FD_BPF_PROGRAM_CACHE_ERR_NOMEM;
+    return NULL;
+  }
+  fd_memset( vm_ctx, 0, sizeof(fd_vm_exec_context_t) );
+  vm_ctx->entrypoint    = (long)prog->entry_pc;
+  vm_ctx->syscall_map   = syscalls;
+  vm_ctx->calldests     = prog->calldests;
+  vm_ctx->instrs        = (fd_sbpf_instr_t const *)fd_type_pun_const( prog->text );
+  vm_ctx->instrs_sz     = prog->text_cnt;
+  vm_ctx->instrs_offset = (ulong)prog->text - (ulong)prog->rodata;
+
+  ulong validate_result = fd_vm_context_validate( vm_ctx );
+  fd_valloc_free( valloc, vm_ctx );
+
+  if( FD_UNLIKELY( validate_result!=FD_VM_SBPF_VALIDATE_SUCCESS ) ) {
+    FD_LOG_DEBUG(( "fd_vm_context_validate() failed: %lu", validate_result ));
+    fd_valloc_free( valloc, fd_sbpf_program_delete( prog ) );
+    *err = FD_BPF_PROGRAM_CACHE_ERR_VALIDATE;
+    return NULL;
+  }
+
+  *err = FD_BPF_PROGRAM_CACHE_SUCCESS;
+  return prog;
+}
+
+fd_sbpf_program_t const *
+fd_bpf_program_cache_load( fd_bpf_program_cache_t * cache,
+                           fd_pubkey_t const *      program_id,
+                           ulong                    deploy_slot,
+                           uchar const *            elf,
+                           ulong                    elf_sz,
+                           int *                    opt_err ) {
+
+  int _err[1];
+  int * err = opt_err ? opt_err : _err;
+
+  fd_bpf_program_cache_key_t key;
+  fd_memset( &key, 0, sizeof(fd_bpf_program_cache_key_t) );
+  fd_memcpy( &key.program_id, program_id, sizeof(fd_pubkey_t) );
+  key.deploy_slot = deploy_slot;
+
+  ulong clock = ++cache->clock;
+
+  /* Hit? */
+
+  fd_bpf_program_cache_entry_t * map   = fd_bpf_program_cache_get_map( cache );
+  fd_bpf_program_cache_entry_t * entry = fd_bpf_program_cache_map_query( map, key, NULL );
+  if( FD_LIKELY( entry ) ) {
+    cache->stats.hit_cnt++;
+    entry->last_used = clock;
+    *err = entry->err;
+    return entry->prog;
+  }
+
+  /* Miss: load and validate the program (may evict entries) */
+
+  cache->stats.miss_cnt++;
+
+  fd_sbpf_program_t * prog = fd_bpf_program_prepare( cache, cache->valloc, fd_bpf_program_cache_syscalls( cache ), elf, elf_sz, err );
+
+  /* Allocation failures are transient and are not cached */
+
+  if( FD_UNLIKELY( *err==FD_BPF_PROGRAM_CACHE_ERR_NOMEM ) ) return NULL;
+
+  if( cache->entry_cnt >= FD_BPF_PROGRAM_CACHE_ENTRY_MAX ) fd_bpf_program_cache_evict( cache );
+
+  entry = fd_bpf_program_cache_map_insert( map, key );
+  if( FD_UNLIKELY( !entry ) ) FD_LOG_CRIT(( "program cache corrupt" ));
+  cache->entry_cnt++;
+
+  entry->err       = *err;
+  entry->prog      = prog;
+  entry->last_used = clock;
+  return prog;
+}
+
+int
+fd_bpf_program_verify( uchar const * elf,
+                       ulong         elf_sz,
+                       fd_valloc_t   valloc ) {
+
+  void * syscalls_mem = fd_valloc_malloc( valloc, fd_sbpf_syscalls_align(), fd_sbpf_syscalls_footprint() );
+  if( FD_UNLIKELY( !syscalls_mem ) ) return FD_BPF_PROGRAM_CACHE_ERR_NOMEM;
+  fd_sbpf_syscalls_t * syscalls = fd_sbpf_syscalls_join( fd_sbpf_syscalls_new( syscalls_mem ) );
+  fd_vm_syscall_register_all( syscalls );
+
+  int err;
+  fd_sbpf_program_t * prog = fd_bpf_program_prepare( NULL, valloc, syscalls, elf, elf_sz, &err );
+  if( prog ) fd_valloc_free( valloc, fd_sbpf_program_delete( prog ) );
+
+  fd_valloc_free( valloc, fd_sbpf_syscalls_delete( fd_sbpf_syscalls_leave( syscalls ) ) );
+  return err;
+}
+
+ulong
+fd_bpf_program_cache_invalidate( fd_bpf_program_cache_t * cache,
+                                 fd_pubkey_t const *      program_id ) {
+
+  fd_bpf_program_cache_entry_t * map = fd_bpf_program_cache_get_map( cache );
+  ulong slot_cnt = fd_bpf_program_cache_map_slot_cnt();
+  ulong cnt      = 0UL;
+
+  /* Removal may move a later entry into the freed slot, so re-check a
+     slot after removing from it.  Entries that wrap around into
+     already visited slots have been checked before. */
+
+  for( ulong i=0UL; i<slot_cnt; i++ ) {
+    fd_bpf_program_cache_entry_t * entry = map + i;
+    while( !fd_bpf_program_cache_key_inval( &entry->key ) &&
+           0==memcmp( &entry->key.program_id, program_id, sizeof(fd_pubkey_t) ) ) {
+      fd_bpf_program_cache_entry_remove( cache, entry );
+      cnt++;
+    }
+  }
+
+  cache->stats.invalidate_cnt += cnt;
+  return cnt;
+}
+
+void *
+fd_bpf_program_cache_delete( fd_bpf_program_cache_t * cache ) {
+
+  if( FD_UNLIKELY( !cache ) ) {
+    FD_LOG_WARNING(( "NULL cache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( cache->magic!=FD_BPF_PROGRAM_CACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  while( fd_bpf_program_cache_evict( cache ) ) {}
+
+  fd_sbpf_syscalls_delete( fd_sbpf_syscalls_leave( fd_bpf_program_cache_syscalls( cache ) ) );
+  fd_bpf_program_cache_map_delete( fd_bpf_program_cache_map_leave( fd_bpf_program_cache_get_map( cache ) ) );
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return (void *)cache;
+}
@@ -0,0 +1,166 @@
+#ifndef HEADER_fd_src_flamenco_runtime_program_fd_bpf_program_cache_h
+#define HEADER_fd_src_flamenco_runtime_program_fd_bpf_program_cache_h
+
+/* fd_bpf_program_cache_t caches loaded and validated sBPF programs.
+
+   Loading a program (fd_sbpf_elf_peek, fd_sbpf_program_load with its
+   relocation pass and fd_vm_context_validate) is pure overhead when
+   the same program account is invoked repeatedly.  The cache keeps the
+   resulting fd_sbpf_program_t image (rodata, text and calldests)
+   together with one shared syscall table, keyed by program pubkey and
+   the slot the program was deployed in.
+
+   A deployment is identified by its slot because loaders record the
+   deploy slot in the program account and refuse to redeploy within a
+   cooldown period, so the ELF of a given (program, deploy slot) pair
+   never changes.  Looking up a key does not require hashing the ELF.
+   Loaders additionally call fd_bpf_program_cache_invalidate when they
+   modify a program account, which also drops images of deployments
+   whose transaction later failed.  ELFs that fail to load or validate
+   are cached too (negative entries) so broken programs do not get
+   re-parsed on every invocation.
+
+   The cache object lives in caller provided (typically wksp) memory,
+   program images are allocated from the valloc given to join.  Images
+   contain pointers in the local address space of the joining process.
+   Not thread safe.  A program returned by fd_bpf_program_cache_load
+   remains valid until the next call that modifies the cache (load,
+   invalidate, delete). */
+
+#include "../../fd_flamenco_base.h"
+#include "../../../ballet/sbpf/fd_sbpf_loader.h"
+
+/* FD_BPF_PROGRAM_CACHE_LG_SLOT_CNT is the log2 of the number of map
+   slots.  FD_BPF_PROGRAM_CACHE_ENTRY_MAX is the max number of cached
+   programs (kept well below the slot count to keep probe chains
+   short). */
+
+#define FD_BPF_PROGRAM_CACHE_LG_SLOT_CNT (10)
+#define FD_BPF_PROGRAM_CACHE_ENTRY_MAX   (768UL)
+
+/* FD_BPF_PROGRAM_CACHE_ERR_{...} are error codes returned by
+   fd_bpf_program_cache_load. */
+
+#define FD_BPF_PROGRAM_CACHE_SUCCESS       (0)
+#define FD_BPF_PROGRAM_CACHE_ERR_ELF       (1)  /* ELF parse or relocation failed */
+#define FD_BPF_PROGRAM_CACHE_ERR_VALIDATE  (2)  /* bytecode failed validation */
+#define FD_BPF_PROGRAM_CACHE_ERR_NOMEM     (3)  /* out of memory */
+
+#define FD_BPF_PROGRAM_CACHE_MAGIC (0xf17eda2ce7b9ca40UL) /* random */
+
+struct fd_bpf_program_cache_key {
+  fd_pubkey_t program_id;
+  ulong       deploy_slot;
+};
+
+typedef struct fd_bpf_program_cache_key fd_bpf_program_cache_key_t;
+
+struct fd_bpf_program_cache_entry {
+  fd_bpf_program_cache_key_t key;
+  uint                       hash;       /* internal use by map */
+  int                        err;        /* FD_BPF_PROGRAM_CACHE_{SUCCESS,ERR_*} */
+  fd_sbpf_program_t *        prog;       /* NULL if err */
+  ulong                      last_used;  /* LRU stamp */
+};
+
+typedef struct fd_bpf_program_cache_entry fd_bpf_program_cache_entry_t;
+
+struct fd_bpf_program_cache;
+typedef struct fd_bpf_program_cache fd_bpf_program_cache_t;
+
+/* fd_bpf_program_cache_stats_t reports cache effectiveness. */
+
+struct fd_bpf_program_cache_stats {
+  ulong hit_cnt;
+  ulong miss_cnt;
+  ulong evict_cnt;
+  ulong invalidate_cnt;
+};
+
+typedef struct fd_bpf_program_cache_stats fd_bpf_program_cache_stats_t;
+
+FD_PROTOTYPES_BEGIN
+
+FD_FN_CONST ulong
+fd_bpf_program_cache_align( void );
+
+FD_FN_CONST ulong
+fd_bpf_program_cache_footprint( void );
+
+/* fd_bpf_program_cache_new formats an unused memory region for use as
+   a program cache.  Returns mem on success and NULL on failure (logs
+   details). */
+
+void *
+fd_bpf_program_cache_new( void * mem );
+
+/* fd_bpf_program_cache_join joins the caller to a program cache.
+   Program images are allocated from valloc, which must remain valid
+   for the lifetime of the join.  All joins to a cache must use
+   equivalent vallocs. */
+
+fd_bpf_program_cache_t *
+fd_bpf_program_cache_join( void *      mem,
+                           fd_valloc_t valloc );
+
+void *
+fd_bpf_program_cache_leave( fd_bpf_program_cache_t * cache );
+
+/* fd_bpf_program_cache_delete unformats a program cache, releasing all
+   program images.  Requires a join (for the valloc). */
+
+void *
+fd_bpf_program_cache_delete( fd_bpf_program_cache_t * cache );
+
+/* fd_bpf_program_cache_syscalls returns the syscall table that cached
+   programs were loaded against. */
+
+FD_FN_PURE fd_sbpf_syscalls_t *
+fd_bpf_program_cache_syscalls( fd_bpf_program_cache_t * cache );
+
+/* fd_bpf_program_cache_load returns the loaded and validated program
+   for the ELF [elf,elf+elf_sz) of program account program_id deployed
+   in slot deploy_slot, loading and inserting it on a miss.  The ELF is
+   only read on a miss.  On success returns the program and sets
+   *opt_err to FD_BPF_PROGRAM_CACHE_SUCCESS.  On failure returns NULL and
+   sets *opt_err to an FD_BPF_PROGRAM_CACHE_ERR_* code.  opt_err may be
+   NULL. */
+
+fd_sbpf_program_t const *
+fd_bpf_program_cache_load( fd_bpf_program_cache_t * cache,
+                           fd_pubkey_t const *      program_id,
+                           ulong                    deploy_slot,
+                           uchar const *            elf,
+                           ulong                    elf_sz,
+                           int *                    opt_err );
+
+/* fd_bpf_program_verify loads and validates the ELF [elf,elf+elf_sz)
+   like fd_bpf_program_cache_load would, but without a cache.  Scratch
+   memory is allocated from valloc and freed before returning.  Returns
+   FD_BPF_PROGRAM_CACHE_SUCCESS if the ELF is a valid program and an
+   FD_BPF_PROGRAM_CACHE_ERR_* code otherwise. */
+
+int
+fd_bpf_program_verify( uchar const * elf,
+                       ulong         elf_sz,
+                       fd_valloc_t   valloc );
+
+/* fd_bpf_program_cache_invalidate removes all cached images of the
+   given program.  Returns the number of entries removed. */
+
+ulong
+fd_bpf_program_cache_invalidate( fd_bpf_program_cache_t * cache,
+                                 fd_pubkey_t const *      program_id );
+
+/* fd_bpf_program_cache_entry_cnt returns the number of cached
+   entries (including negative entries). */
+
+FD_FN_PURE ulong
+fd_bpf_program_cache_entry_cnt( fd_bpf_program_cache_t const * cache );
+
+FD_FN_PURE fd_bpf_program_cache_stats_t const *
+fd_bpf_program_cache_stats( fd_bpf_program_cache_t const * cache );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_flamenco_runtime_program_fd_bpf_program_cache_h */
@@ -0,0 +1,104 @@
+#include "fd_bpf_program_cache.h"
+
+FD_IMPORT_BINARY( valid_elf,   "corpus/fuzz_sbpf_loader/noop.so"                     );
+FD_IMPORT_BINARY( invalid_elf, "corpus/fuzz_sbpf_loader/program_headers_overflow.so" );
+
+static uchar cache_mem[ 1UL<<20 ] __attribute__((aligned(64)));
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  FD_TEST( fd_bpf_program_cache_footprint()<=sizeof(cache_mem) );
+  FD_TEST( fd_ulong_is_aligned( (ulong)cache_mem, fd_bpf_program_cache_align() ) );
+
+  fd_valloc_t valloc = fd_libc_alloc_virtual();
+
+  /* Verification without a cache */
+
+  FD_TEST( fd_bpf_program_verify( valid_elf,   valid_elf_sz,   valloc )==FD_BPF_PROGRAM_CACHE_SUCCESS );
+  FD_TEST( fd_bpf_program_verify( invalid_elf, invalid_elf_sz, valloc )==FD_BPF_PROGRAM_CACHE_ERR_ELF );
+  FD_TEST( fd_bpf_program_verify( valid_elf,   16UL,           valloc )==FD_BPF_PROGRAM_CACHE_ERR_ELF );
+
+  FD_TEST( !fd_bpf_program_cache_new( NULL          ) );
+  FD_TEST( !fd_bpf_program_cache_new( cache_mem+1UL ) );
+  fd_bpf_program_cache_t * cache = fd_bpf_program_cache_join( fd_bpf_program_cache_new( cache_mem ), valloc );
+  FD_TEST( cache );
+  FD_TEST( fd_bpf_program_cache_syscalls( cache ) );
+  FD_TEST( fd_bpf_program_cache_entry_cnt( cache )==0UL );
+
+  fd_bpf_program_cache_stats_t const * stats = fd_bpf_program_cache_stats( cache );
+
+  fd_pubkey_t prog_a; memset( prog_a.key, 'a', sizeof(fd_pubkey_t) );
+  fd_pubkey_t prog_b; memset( prog_b.key, 'b', sizeof(fd_pubkey_t) );
+
+  /* Miss, then hit on the same deployment */
+
+  int err = -1;
+  fd_sbpf_program_t const * p0 = fd_bpf_program_cache_load( cache, &prog_a, 10UL, valid_elf, valid_elf_sz, &err );
+  FD_TEST( p0 && err==FD_BPF_PROGRAM_CACHE_SUCCESS );
+  FD_TEST( p0->text_cnt>0UL );
+  FD_TEST( stats->miss_cnt==1UL && stats->hit_cnt==0UL );
+
+  /* The ELF is not looked at on a hit */
+
+  err = -1;
+  FD_TEST( fd_bpf_program_cache_load( cache, &prog_a, 10UL, invalid_elf, invalid_elf_sz, &err )==p0 );
+  FD_TEST( err==FD_BPF_PROGRAM_CACHE_SUCCESS );
+  FD_TEST( stats->miss_cnt==1UL && stats->hit_cnt==1UL );
+  FD_TEST( fd_bpf_program_cache_load( cache, &prog_a, 10UL, valid_elf, valid_elf_sz, NULL )==p0 );
+  FD_TEST( stats->hit_cnt==2UL );
+
+  /* A redeployment is a different entry */
+
+  fd_sbpf_program_t const * p1 = fd_bpf_program_cache_load( cache, &prog_a, 20UL, valid_elf, valid_elf_sz, &err );
+  FD_TEST( p1 && p1!=p0 && err==FD_BPF_PROGRAM_CACHE_SUCCESS );
+  FD_TEST( fd_bpf_program_cache_entry_cnt( cache )==2UL );
+
+  /* Invalid ELFs are cached as negative entries */
+
+  err = -1;
+  FD_TEST( !fd_bpf_program_cache_load( cache, &prog_b, 10UL, invalid_elf, invalid_elf_sz, &err ) );
+  FD_TEST( err==FD_BPF_PROGRAM_CACHE_ERR_ELF );
+  FD_TEST( stats->miss_cnt==3UL );
+  err = -1;
+  FD_TEST( !fd_bpf_program_cache_load( cache, &prog_b, 10UL, invalid_elf, invalid_elf_sz, &err ) );
+  FD_TEST( err==FD_BPF_PROGRAM_CACHE_ERR_ELF );
+  FD_TEST( stats->miss_cnt==3UL );
+  FD_TEST( fd_bpf_program_cache_entry_cnt( cache )==3UL );
+
+  /* Invalidation drops all deployments of a program only */
+
+  FD_TEST( fd_bpf_program_cache_invalidate( cache, &prog_a )==2UL );
+  FD_TEST( fd_bpf_program_cache_invalidate( cache, &prog_a )==0UL );
+  FD_TEST( stats->invalidate_cnt==2UL );
+  FD_TEST( fd_bpf_program_cache_entry_cnt( cache )==1UL );
+  FD_TEST( !fd_bpf_program_cache_load( cache, &prog_b, 10UL, invalid_elf, invalid_elf_sz, &err ) );
+  FD_TEST( stats->miss_cnt==3UL );
+  FD_TEST( fd_bpf_program_cache_load( cache, &prog_a, 10UL, valid_elf, valid_elf_sz, &err ) );
+  FD_TEST( stats->miss_cnt==4UL );
+
+  /* The least recently used entry is evicted once the cache is full */
+
+  for( ulong slot=1000UL; fd_bpf_program_cache_entry_cnt( cache )<FD_BPF_PROGRAM_CACHE_ENTRY_MAX; slot++ ) {
+    FD_TEST( fd_bpf_program_cache_load( cache, &prog_a, slot, valid_elf, valid_elf_sz, &err ) );
+  }
+  FD_TEST( stats->evict_cnt==0UL );
+  FD_TEST( fd_bpf_program_cache_load( cache, &prog_a, 10UL, valid_elf, valid_elf_sz, &err ) ); /* touch */
+  FD_TEST( fd_bpf_program_cache_load( cache, &prog_a, 99UL, valid_elf, valid_elf_sz, &err ) );
+  FD_TEST( stats->evict_cnt==1UL );
+  FD_TEST( fd_bpf_program_cache_entry_cnt( cache )==FD_BPF_PROGRAM_CACHE_ENTRY_MAX );
+  ulong miss_cnt = stats->miss_cnt;
+  FD_TEST( fd_bpf_program_cache_load( cache, &prog_a, 10UL, valid_elf, valid_elf_sz, &err ) );
+  FD_TEST( stats->miss_cnt==miss_cnt );
+  FD_TEST( !fd_bpf_program_cache_load( cache, &prog_b, 10UL, invalid_elf, invalid_elf_sz, &err ) );
+  FD_TEST( stats->miss_cnt==miss_cnt+1UL );
+
+  FD_TEST( fd_bpf_program_cache_delete( fd_bpf_program_cache_leave( cache ) )==cache_mem );
+  FD_TEST( !fd_bpf_program_cache_join( cache_mem, valloc ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -40,7 +40,8 @@ static FD_TL char _report_prefix[65] = {0};
 #include "../../../util/tmpl/fd_sort.c"
 
 struct __attribute__((aligned(32UL))) fd_exec_instr_test_runner_private {
-  fd_funk_t * funk;
+  fd_funk_t *              funk;
+  fd_bpf_program_cache_t * program_cache;
 };
 
 ulong
@@ -53,6 +54,7 @@ fd_exec_instr_test_runner_footprint( void ) {
   ulong l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND( l, alignof(fd_exec_instr_test_runner_t), sizeof(fd_exec_instr_test_runner_t) );
   l = FD_LAYOUT_APPEND( l, fd_funk_align(),                      fd_funk_footprint()                 );
+  l = FD_LAYOUT_APPEND( l, fd_bpf_program_cache_align(),         fd_bpf_program_cache_footprint()    );
   return l;
 }
 
@@ -62,6 +64,7 @@ fd_exec_instr_test_runner_new( void * mem,
   FD_SCRATCH_ALLOC_INIT( l, mem );
   void * runner_mem = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_exec_instr_test_runner_t), sizeof(fd_exec_instr_test_runner_t) );
   void * funk_mem   = FD_SCRATCH_ALLOC_APPEND( l, fd_funk_align(),                      fd_funk_footprint()                 );
+  void * cache_mem  = FD_SCRATCH_ALLOC_APPEND( l, fd_bpf_program_cache_align(),         fd_bpf_program_cache_footprint()    );
   FD_SCRATCH_ALLOC_FINI( l, alignof(fd_exec_instr_test_runner_t) );
 
   ulong txn_max = 4+fd_tile_cnt();
@@ -72,8 +75,18 @@ fd_exec_instr_test_runner_new( void * mem,
     return NULL;
   }
 
+  /* Program images are allocated from the heap because they contain
+     pointers in the local address space. */
+  fd_bpf_program_cache_t * program_cache = fd_bpf_program_cache_join( fd_bpf_program_cache_new( cache_mem ), fd_libc_alloc_virtual() );
+  if( FD_UNLIKELY( !program_cache ) ) {
+    FD_LOG_WARNING(( "fd_bpf_program_cache_new() failed" ));
+    fd_funk_delete( fd_funk_leave( funk ) );
+    return NULL;
+  }
+
   fd_exec_instr_test_runner_t * runner = runner_mem;
-  runner->funk = funk;
+  runner->funk          = funk;
+  runner->program_cache = program_cache;
   return runner;
 }
 
@@ -82,6 +95,8 @@ fd_exec_instr_test_runner_delete( fd_exec_instr_test_runner_t * runner ) {
   if( FD_UNLIKELY( !runner ) ) return NULL;
   fd_funk_delete( fd_funk_leave( runner->funk ) );
   runner->funk = NULL;
+  fd_bpf_program_cache_delete( fd_bpf_program_cache_leave( runner->program_cache ) );
+  runner->program_cache = NULL;
   return runner;
 }
 
@@ -145,7 +160,8 @@ _context_create( fd_exec_instr_test_runner_t *        runner,
   fd_exec_slot_ctx_t *  slot_ctx      = fd_exec_slot_ctx_join ( fd_exec_slot_ctx_new ( slot_ctx_mem  ) );
   fd_exec_txn_ctx_t *   txn_ctx       = fd_exec_txn_ctx_join  ( fd_exec_txn_ctx_new  ( txn_ctx_mem   ) );
 
-  epoch_ctx->valloc = fd_scratch_virtual();
+  epoch_ctx->valloc        = fd_scratch_virtual();
+  epoch_ctx->program_cache = runner->program_cache;
 
   assert( epoch_ctx );
   assert( slot_ctx  );
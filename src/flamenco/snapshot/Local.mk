@@ -1,6 +1,8 @@
 ifdef FD_HAS_ZSTD
 $(call add-hdrs,fd_snapshot_restore.h)
 $(call add-objs,fd_snapshot_restore,fd_flamenco)
+$(call make-unit-test,test_snapshot_restore,test_snapshot_restore,fd_flamenco fd_funk fd_ballet fd_util)
+$(call run-unit-test,test_snapshot_restore)
 
 $(call add-hdrs,fd_snapshot_http.h)
 $(call add-objs,fd_snapshot_http,fd_flamenco)
@@ -11,5 +13,13 @@ $(call make-fuzz-test,fuzz_snapshot_http,fuzz_snapshot_http,fd_flamenco fd_funk
 $(call add-hdrs,fd_snapshot_load.h)
 $(call add-objs,fd_snapshot_load,fd_flamenco)
 
+$(call add-hdrs,fd_snapshot_load_par.h)
+$(call add-objs,fd_snapshot_load_par,fd_flamenco)
+
+$(call add-hdrs,fd_snapshot_base.h fd_snapshot_create.h)
+$(call add-objs,fd_snapshot_create,fd_flamenco)
+$(call make-unit-test,test_snapshot_create,test_snapshot_create,fd_flamenco fd_funk fd_ballet fd_util)
+$(call run-unit-test,test_snapshot_create)
+
 $(call make-bin,fd_snapshot,fd_snapshot_main,fd_flamenco fd_funk fd_ballet fd_util)
 endif
@@ -8,6 +8,11 @@
 
 #define FD_SNAPSHOT_CREATE_ALIGN (32UL)
 
+/* FD_SNAPSHOT_LOAD_PAR_ALIGN is the alignment of the memory region
+   backing a fd_snapshot_load_par_t object. */
+
+#define FD_SNAPSHOT_LOAD_PAR_ALIGN (32UL)
+
 /* FD_SNAPSHOT_ACC_ALIGN is the alignment of an account header in an
    account vec / "AppendVec". */
 
@@ -0,0 +1,937 @@
+#include "fd_snapshot_create.h"
+#include "../../ballet/zstd/fd_zstd.h"
+#include "../../util/archive/fd_tar.h"
+#include "../types/fd_types.h"
+#include "../runtime/fd_acc_mgr.h"
+#include "../runtime/context/fd_exec_epoch_ctx.h"
+#include "../runtime/sysvar/fd_sysvar_epoch_schedule.h"
+
+#include <errno.h>
+#include <fcntl.h>       /* open */
+#include <limits.h>      /* PATH_MAX */
+#include <stdio.h>       /* snprintf, rename */
+#include <string.h>      /* strlen */
+#include <unistd.h>      /* close, unlink, lseek */
+
+/* A snapshot is written as follows:
+
+   - The version file, the status cache and the manifest are written
+     first as one Zstandard frame.
+   - Each account vec file (tar header, accounts, tar padding) is
+     written as its own Zstandard frame(s).  Account vecs are dealt
+     round-robin to the workers.  Each worker compresses its account
+     vecs into its own temporary file.
+   - The temporary files are concatenated in worker order and the tar
+     end-of-archive marker is appended as a final frame.
+
+   Since frames never span account vec files, the concatenation of the
+   workers' output is a valid .tar.zst stream regardless of how account
+   vecs were dealt.  The manifest lists every account vec up front, so
+   the order in which the account vecs appear in the archive does not
+   matter to readers. */
+
+#define FD_SNAPSHOT_CREATE_MAGIC (0xf17eda2ce75c7ea0UL) /* firedancer snapshot create version 0 */
+
+/* FD_SNAPSHOT_CREATE_TAR_ALIGN is the TAR block size */
+
+#define FD_SNAPSHOT_CREATE_TAR_ALIGN (512UL)
+
+/* fd_snapshot_create_worker_t holds the state of a compression
+   worker. */
+
+struct fd_snapshot_create_worker {
+  fd_zstd_cstream_t * cstream;
+
+  uchar * in_buf;   /* staging buffer for uncompressed TAR stream, compress_bufsz bytes */
+  ulong   in_sz;    /* number of bytes staged */
+  uchar * out_buf;  /* compressed bytes pending write, compress_bufsz bytes */
+  ulong   out_sz;   /* number of bytes pending write */
+
+  int     fd;       /* temporary file, -1 if not open */
+  int     ok;       /* 0 if an error occurred */
+  ulong   raw_sz;   /* number of uncompressed bytes */
+  ulong   comp_sz;  /* number of compressed bytes written */
+
+  char    path[ PATH_MAX ];
+};
+
+typedef struct fd_snapshot_create_worker fd_snapshot_create_worker_t;
+
+struct __attribute__((aligned(FD_SNAPSHOT_CREATE_ALIGN))) fd_snapshot_create_private {
+  ulong magic;  /* ==FD_SNAPSHOT_CREATE_MAGIC */
+
+  ulong worker_cnt;
+  int   compress_lvl;
+  ulong compress_bufsz;
+  ulong funk_rec_cnt;
+  ulong batch_acc_cnt;
+  ulong max_accv_sz;
+
+  fd_snapshot_create_worker_t * worker;     /* indexed [0,worker_cnt) */
+  fd_funk_rec_t const **        rec;        /* indexed [0,funk_rec_cnt) */
+  ulong *                       accv_rec0;  /* indexed [0,funk_rec_cnt], accv i holds rec[ accv_rec0[i], accv_rec0[i+1] ) */
+  fd_snapshot_acc_vec_t *       accv;       /* indexed [0,funk_rec_cnt) */
+
+  /* Current snapshot */
+
+  fd_funk_t * funk;
+  ulong       slot;
+  ulong       rec_cnt;
+  ulong       accv_cnt;
+  ulong       data_sz;  /* sum of account data sizes */
+
+  char snap_path[ PATH_MAX ];
+};
+
+static inline ulong
+fd_snapshot_create_acc_sz( fd_account_meta_t const * meta ) {
+  return sizeof(fd_solana_account_hdr_t) + fd_ulong_align_up( meta->dlen, FD_SNAPSHOT_ACC_ALIGN );
+}
+
+ulong
+fd_snapshot_create_align( void ) {
+  return FD_SNAPSHOT_CREATE_ALIGN;
+}
+
+ulong
+fd_snapshot_create_footprint( ulong worker_cnt,
+                              int   compress_lvl,
+                              ulong compress_bufsz,
+                              ulong funk_rec_cnt,
+                              ulong batch_acc_cnt ) {
+
+  if( FD_UNLIKELY( (!worker_cnt) | (worker_cnt>FD_TILE_MAX) ) ) return 0UL;
+  if( FD_UNLIKELY( (!compress_bufsz) | (compress_bufsz>(1UL<<40)) ) ) return 0UL;
+  if( FD_UNLIKELY( (!funk_rec_cnt) | (funk_rec_cnt>(1UL<<40)) ) ) return 0UL;
+  if( FD_UNLIKELY( !batch_acc_cnt ) ) return 0UL;
+
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, alignof(fd_snapshot_create_t),        sizeof(fd_snapshot_create_t) );
+  l = FD_LAYOUT_APPEND( l, alignof(fd_snapshot_create_worker_t), worker_cnt*sizeof(fd_snapshot_create_worker_t) );
+  l = FD_LAYOUT_APPEND( l, alignof(fd_funk_rec_t const *),       funk_rec_cnt*sizeof(fd_funk_rec_t const *) );
+  l = FD_LAYOUT_APPEND( l, alignof(ulong),                       (funk_rec_cnt+1UL)*sizeof(ulong) );
+  l = FD_LAYOUT_APPEND( l, alignof(fd_snapshot_acc_vec_t),       funk_rec_cnt*sizeof(fd_snapshot_acc_vec_t) );
+  for( ulong j=0UL; j<worker_cnt; j++ ) {
+    l = FD_LAYOUT_APPEND( l, fd_zstd_cstream_align(), fd_zstd_cstream_footprint( compress_lvl ) );
+    l = FD_LAYOUT_APPEND( l, FD_SNAPSHOT_CREATE_ALIGN, 2UL*compress_bufsz );
+  }
+  return FD_LAYOUT_FINI( l, fd_snapshot_create_align() );
+}
+
+fd_snapshot_create_t *
+fd_snapshot_create_new( void *               mem,
+                        fd_exec_slot_ctx_t * slot_ctx,
+                        const char *         snap_path,
+                        ulong                worker_cnt,
+                        int                  compress_lvl,
+                        ulong                compress_bufsz,
+                        ulong                funk_rec_cnt,
+                        ulong                batch_acc_cnt,
+                        ulong                max_accv_sz,
+                        fd_rng_t *           rng ) {
+
+  if( FD_UNLIKELY( !mem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)mem, fd_snapshot_create_align() ) ) ) {
+    FD_LOG_WARNING(( "unaligned mem" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( (!slot_ctx) || (!slot_ctx->acc_mgr) || (!slot_ctx->acc_mgr->funk) ) ) {
+    FD_LOG_WARNING(( "slot_ctx has no funk" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( (!slot_ctx->valloc.vt->malloc)
+                 | (!slot_ctx->valloc.vt->free  ) ) ) {
+    FD_LOG_WARNING(( "NULL valloc" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !snap_path ) ) {
+    FD_LOG_WARNING(( "NULL snap_path" ));
+    return NULL;
+  }
+  /* Leave room for the temporary file suffix */
+  if( FD_UNLIKELY( strlen( snap_path )+64UL > PATH_MAX ) ) {
+    FD_LOG_WARNING(( "snap_path too long" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !rng ) ) {
+    FD_LOG_WARNING(( "NULL rng" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !max_accv_sz ) ) {
+    FD_LOG_WARNING(( "zero max_accv_sz" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !fd_snapshot_create_footprint( worker_cnt, compress_lvl, compress_bufsz, funk_rec_cnt, batch_acc_cnt ) ) ) {
+    FD_LOG_WARNING(( "invalid parameters (worker_cnt=%lu compress_bufsz=%lu funk_rec_cnt=%lu batch_acc_cnt=%lu)",
+                     worker_cnt, compress_bufsz, funk_rec_cnt, batch_acc_cnt ));
+    return NULL;
+  }
+
+  FD_SCRATCH_ALLOC_INIT( l, mem );
+  fd_snapshot_create_t * create = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_snapshot_create_t), sizeof(fd_snapshot_create_t) );
+  fd_memset( create, 0, sizeof(fd_snapshot_create_t) );
+  create->worker_cnt     = worker_cnt;
+  create->compress_lvl   = compress_lvl;
+  create->compress_bufsz = compress_bufsz;
+  create->funk_rec_cnt   = funk_rec_cnt;
+  create->batch_acc_cnt  = batch_acc_cnt;
+  create->max_accv_sz    = max_accv_sz;
+  create->funk           = slot_ctx->acc_mgr->funk;
+
+  create->worker    = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_snapshot_create_worker_t), worker_cnt*sizeof(fd_snapshot_create_worker_t) );
+  create->rec       = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_funk_rec_t const *),       funk_rec_cnt*sizeof(fd_funk_rec_t const *) );
+  create->accv_rec0 = FD_SCRATCH_ALLOC_APPEND( l, alignof(ulong),                       (funk_rec_cnt+1UL)*sizeof(ulong) );
+  create->accv      = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_snapshot_acc_vec_t),       funk_rec_cnt*sizeof(fd_snapshot_acc_vec_t) );
+
+  strcpy( create->snap_path, snap_path );
+  ulong seed = fd_rng_ulong( rng );
+
+  for( ulong j=0UL; j<worker_cnt; j++ ) {
+    fd_snapshot_create_worker_t * w = &create->worker[ j ];
+    fd_memset( w, 0, sizeof(fd_snapshot_create_worker_t) );
+    w->fd = -1;
+
+    void * cstream_mem = FD_SCRATCH_ALLOC_APPEND( l, fd_zstd_cstream_align(), fd_zstd_cstream_footprint( compress_lvl ) );
+    w->cstream = fd_zstd_cstream_new( cstream_mem, compress_lvl );
+    if( FD_UNLIKELY( !w->cstream ) ) {
+      FD_LOG_WARNING(( "fd_zstd_cstream_new(%d) failed", compress_lvl ));
+      for( ulong k=0UL; k<j; k++ ) fd_zstd_cstream_delete( create->worker[ k ].cstream );
+      return NULL;
+    }
+
+    w->in_buf  = FD_SCRATCH_ALLOC_APPEND( l, FD_SNAPSHOT_CREATE_ALIGN, 2UL*compress_bufsz );
+    w->out_buf = w->in_buf + compress_bufsz;
+
+    snprintf( w->path, PATH_MAX, "%s.%016lx.%lu.tmp", snap_path, seed, j );
+  }
+
+  FD_COMPILER_MFENCE();
+  create->magic = FD_SNAPSHOT_CREATE_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return create;
+}
+
+void *
+fd_snapshot_create_delete( fd_snapshot_create_t * create ) {
+
+  if( FD_UNLIKELY( !create ) ) return NULL;
+
+  if( FD_UNLIKELY( create->magic!=FD_SNAPSHOT_CREATE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  for( ulong j=0UL; j<create->worker_cnt; j++ ) {
+    fd_snapshot_create_worker_t * w = &create->worker[ j ];
+    if( FD_UNLIKELY( w->fd>=0 ) ) {
+      close( w->fd );
+      unlink( w->path );
+    }
+    fd_zstd_cstream_delete( w->cstream );
+  }
+
+  FD_COMPILER_MFENCE();
+  create->magic = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return (void *)create;
+}
+
+/* Compressed output **************************************************/
+
+/* fd_snapshot_create_worker_flush writes out the compressed bytes
+   pending in w.  Returns 1 on success and 0 on failure (logs details). */
+
+static int
+fd_snapshot_create_worker_flush( fd_snapshot_create_worker_t * w ) {
+  if( !w->out_sz ) return 1;
+  ulong wsz;
+  int err = fd_io_write( w->fd, w->out_buf, w->out_sz, w->out_sz, &wsz );
+  if( FD_UNLIKELY( err ) ) {
+    FD_LOG_WARNING(( "write to %s failed (%d-%s)", w->path, err, fd_io_strerror( err ) ));
+    return 0;
+  }
+  w->comp_sz += w->out_sz;
+  w->out_sz   = 0UL;
+  return 1;
+}
+
+/* fd_snapshot_create_worker_compress compresses the bytes staged in w.
+   If end is non-zero, also ends the current frame.  Returns 1 on
+   success and 0 on failure (logs details). */
+
+static int
+fd_snapshot_create_worker_compress( fd_snapshot_create_worker_t * w,
+                                    ulong                         bufsz,
+                                    int                           end ) {
+
+  uchar const * in_cur  = w->in_buf;
+  uchar const * in_end  = w->in_buf + w->in_sz;
+  uchar *       out_end = w->out_buf + bufsz;
+
+  for(;;) {
+    uchar * out_cur = w->out_buf + w->out_sz;
+    int err = fd_zstd_cstream_compress( w->cstream, &in_cur, in_end, &out_cur, out_end, end, NULL );
+    if( FD_UNLIKELY( err>0 ) ) {
+      FD_LOG_WARNING(( "fd_zstd_cstream_compress failed (%d-%s)", err, fd_io_strerror( err ) ));
+      fd_zstd_cstream_reset( w->cstream );
+      return 0;
+    }
+    w->out_sz = (ulong)out_cur - (ulong)w->out_buf;
+
+    if( err<0 ) break;                        /* frame done */
+    if( (!end) & (in_cur==in_end) ) break;    /* all input consumed */
+    if( out_cur==out_end )                    /* need more output space */
+      if( FD_UNLIKELY( !fd_snapshot_create_worker_flush( w ) ) ) return 0;
+  }
+
+  w->raw_sz += w->in_sz;
+  w->in_sz   = 0UL;
+  return 1;
+}
+
+/* fd_snapshot_create_worker_write appends sz bytes at data to the TAR
+   stream of w.  If data is NULL, appends sz zero bytes.  Returns 1 on
+   success and 0 on failure. */
+
+static int
+fd_snapshot_create_worker_write( fd_snapshot_create_worker_t * w,
+                                 ulong                         bufsz,
+                                 void const *                  data,
+                                 ulong                         sz ) {
+  uchar const * cur = data;
+  while( sz ) {
+    ulong chunk_sz = fd_ulong_min( sz, bufsz - w->in_sz );
+    if( cur ) { fd_memcpy( w->in_buf + w->in_sz, cur, chunk_sz ); cur += chunk_sz; }
+    else        fd_memset( w->in_buf + w->in_sz, 0,   chunk_sz );
+    w->in_sz += chunk_sz;
+    sz       -= chunk_sz;
+    if( w->in_sz==bufsz )
+      if( FD_UNLIKELY( !fd_snapshot_create_worker_compress( w, bufsz, 0 ) ) ) return 0;
+  }
+  return 1;
+}
+
+/* fd_snapshot_create_worker_pad pads the TAR stream of w to the next
+   TAR block boundary. */
+
+static int
+fd_snapshot_create_worker_pad( fd_snapshot_create_worker_t * w,
+                               ulong                         bufsz ) {
+  ulong off = w->raw_sz + w->in_sz;
+  return fd_snapshot_create_worker_write( w, bufsz, NULL, fd_ulong_align_up( off, FD_SNAPSHOT_CREATE_TAR_ALIGN ) - off );
+}
+
+/* TAR output *********************************************************/
+
+/* fd_snapshot_create_tar_octal writes val as a zero-padded octal
+   number of sz-1 digits followed by a NUL to buf. */
+
+static void
+fd_snapshot_create_tar_octal( char * buf,
+                              ulong  sz,
+                              ulong  val ) {
+  buf[ sz-1UL ] = '\0';
+  for( ulong j=sz-1UL; j>0UL; j-- ) {
+    buf[ j-1UL ] = (char)( '0' + (char)( val&7UL ) );
+    val>>=3;
+  }
+}
+
+/* fd_snapshot_create_tar_file writes the OLDGNU TAR header of a regular
+   file to w.  Returns 1 on success and 0 on failure. */
+
+static int
+fd_snapshot_create_tar_file( fd_snapshot_create_worker_t * w,
+                             ulong                         bufsz,
+                             char const *                  name,
+                             ulong                         sz ) {
+
+  fd_tar_meta_t meta[1];
+  fd_memset( meta, 0, sizeof(fd_tar_meta_t) );
+
+  ulong name_len = strlen( name );
+  if( FD_UNLIKELY( name_len>=FD_TAR_NAME_SZ ) ) {
+    FD_LOG_WARNING(( "TAR file name too long: %s", name ));
+    return 0;
+  }
+  fd_memcpy( meta->name, name, name_len );
+
+  fd_snapshot_create_tar_octal( meta->mode, sizeof(meta->mode), 0644UL );
+  fd_snapshot_create_tar_octal( meta->uid,  sizeof(meta->uid),  0UL    );
+  fd_snapshot_create_tar_octal( meta->gid,  sizeof(meta->gid),  0UL    );
+  if( FD_UNLIKELY( !fd_tar_meta_set_size( meta, sz ) ) ) {
+    FD_LOG_WARNING(( "TAR file %s too large (%lu bytes)", name, sz ));
+    return 0;
+  }
+  fd_tar_meta_set_mtime( meta, 0UL );
+  meta->typeflag = FD_TAR_TYPE_REGULAR;
+  fd_memcpy( meta->magic,   "ustar ", 6UL );  /* OLDGNU */
+  fd_memcpy( meta->version, " ",      2UL );
+
+  /* Checksum is the sum of all header bytes, with the checksum field
+     itself taken as spaces */
+
+  fd_memset( meta->chksum, ' ', sizeof(meta->chksum) );
+  ulong chksum = 0UL;
+  uchar const * hdr = (uchar const *)meta;
+  for( ulong j=0UL; j<sizeof(fd_tar_meta_t); j++ ) chksum += hdr[ j ];
+  fd_snapshot_create_tar_octal( meta->chksum, 7UL, chksum );
+
+  return fd_snapshot_create_worker_write( w, bufsz, meta, sizeof(fd_tar_meta_t) );
+}
+
+/* Account gathering **************************************************/
+
+/* fd_snapshot_create_read_meta copies the account meta at the start of
+   the value of rec to meta.  Cold values are read straight from the
+   funk cold file instead of being loaded back into the wksp.  Returns
+   1 on success, 0 if the value is too small to hold an account meta
+   (an empty record) and -1 on failure (logs details). */
+
+static int
+fd_snapshot_create_read_meta( fd_funk_t *           funk,
+                              fd_funk_rec_t const * rec,
+                              fd_account_meta_t *   meta ) {
+  if( FD_UNLIKELY( fd_funk_val_sz( rec )<sizeof(fd_account_meta_t) ) ) return 0;
+  if( FD_UNLIKELY( fd_funk_rec_is_cold( rec ) ) ) {
+    int err = fd_funk_cold_read( funk, rec, 0UL, meta, sizeof(fd_account_meta_t) );
+    if( FD_UNLIKELY( err ) ) {
+      FD_LOG_WARNING(( "fd_funk_cold_read failed (%i-%s)", err, fd_funk_strerror( err ) ));
+      return -1;
+    }
+  } else {
+    fd_account_meta_t const * val = fd_funk_val_const( rec, fd_funk_wksp( funk ) );
+    if( FD_UNLIKELY( !val ) ) return 0;
+    *meta = *val;
+  }
+  return 1;
+}
+
+/* fd_snapshot_create_shadowed returns 1 if a transaction on the path
+   from txn up to (but excluding) anc has a record of key, i.e. the
+   version of key in anc is not visible from txn, and 0 otherwise.
+   Transactions without records are skipped without a query. */
+
+static int
+fd_snapshot_create_shadowed( fd_funk_t *               funk,
+                             fd_funk_txn_t *           txn_map,
+                             fd_funk_txn_t const *     txn,
+                             fd_funk_txn_t const *     anc,
+                             fd_funk_rec_key_t const * key ) {
+  for( fd_funk_txn_t const * cur=txn; cur!=anc; cur=fd_funk_txn_parent( (fd_funk_txn_t *)cur, txn_map ) ) {
+    if( fd_funk_txn_first_rec( funk, cur ) && fd_funk_rec_query_const( funk, cur, key ) ) return 1;
+  }
+  return 0;
+}
+
+/* fd_snapshot_create_gather collects the records of all accounts
+   visible from txn into create->rec and splits them into account
+   vecs.  Returns 1 on success and 0 on failure (logs details). */
+
+static int
+fd_snapshot_create_gather( fd_snapshot_create_t * create,
+                           fd_funk_txn_t const *  txn ) {
+
+  fd_funk_t *     funk    = create->funk;
+  fd_wksp_t *     wksp    = fd_funk_wksp( funk );
+  fd_funk_txn_t * txn_map = fd_funk_txn_map( funk, wksp );
+
+  ulong rec_cnt  = 0UL;
+  ulong data_sz  = 0UL;
+  ulong accv_cnt = 0UL;
+  ulong accv_sz  = 0UL;
+
+  /* Walk from txn to the root.  The records of txn are all visible.
+     The record of an ancestor is visible unless a younger transaction
+     on the path has a record of the same key (possibly an erase).  In
+     particular, a snapshot of the last published transaction (the
+     usual case) needs no queries at all.
+
+     Account vec ids start at 1 as (slot 0,id 0) is reserved by the
+     restore side accv index. */
+
+  int                   shadow = 0;  /* 1 if a transaction walked so far has records */
+  fd_funk_txn_t const * cur    = txn;
+  for(;;) {
+    for( fd_funk_rec_t const * rec = fd_funk_txn_first_rec( funk, cur );
+         rec;
+         rec = fd_funk_txn_next_rec( funk, rec ) ) {
+
+      if( !fd_funk_key_is_acc( rec->pair.key ) ) continue;
+      if( rec->flags & FD_FUNK_REC_FLAG_ERASE  ) continue;
+      if( shadow && fd_snapshot_create_shadowed( funk, txn_map, txn, cur, rec->pair.key ) ) continue;
+
+      fd_account_meta_t meta[1];
+      int rc = fd_snapshot_create_read_meta( funk, rec, meta );
+      if( FD_UNLIKELY( rc<0 ) ) return 0;
+      if( FD_UNLIKELY( !rc  ) ) continue;  /* empty record */
+      if( FD_UNLIKELY( (meta->magic!=FD_ACCOUNT_META_MAGIC) |
+                       (meta->hlen <sizeof(fd_account_meta_t)) |
+                       ((ulong)meta->hlen+meta->dlen > fd_funk_val_sz( rec )) ) ) {
+        char key_cstr[ FD_BASE58_ENCODED_32_SZ ];
+        FD_LOG_WARNING(( "corrupt account %s", fd_acct_addr_cstr( key_cstr, fd_funk_key_to_acc( rec->pair.key )->uc ) ));
+        return 0;
+      }
+      if( !meta->info.lamports ) continue;  /* deleted account */
+
+      if( FD_UNLIKELY( rec_cnt>=create->funk_rec_cnt ) ) {
+        FD_LOG_WARNING(( "too many accounts (funk_rec_cnt=%lu)", create->funk_rec_cnt ));
+        return 0;
+      }
+
+      ulong acc_sz = fd_snapshot_create_acc_sz( meta );
+      int   split  = (!accv_cnt) ||
+                     (rec_cnt-create->accv_rec0[ accv_cnt-1UL ] >= create->batch_acc_cnt) ||
+                     (accv_sz+acc_sz > create->max_accv_sz);
+      if( split ) {
+        create->accv_rec0[ accv_cnt ] = rec_cnt;
+        create->accv     [ accv_cnt ] = (fd_snapshot_acc_vec_t){ .id = accv_cnt+1UL, .file_sz = 0UL };
+        accv_cnt++;
+        accv_sz = 0UL;
+      }
+      accv_sz += acc_sz;
+      create->accv[ accv_cnt-1UL ].file_sz = accv_sz;
+
+      create->rec[ rec_cnt++ ] = rec;
+      data_sz += meta->dlen;
+    }
+
+    if( !cur ) break;
+    shadow |= !!fd_funk_txn_first_rec( funk, cur );
+    cur = fd_funk_txn_parent( (fd_funk_txn_t *)cur, txn_map );
+  }
+  create->accv_rec0[ accv_cnt ] = rec_cnt;
+
+  create->rec_cnt  = rec_cnt;
+  create->accv_cnt = accv_cnt;
+  create->data_sz  = data_sz;
+  return 1;
+}
+
+/* fd_snapshot_create_worker_write_cold appends the sz bytes at offset
+   off of the cold value of rec to the TAR stream of w.  The bytes are
+   read from the funk cold file straight into the staging buffer.
+   Returns 1 on success and 0 on failure. */
+
+static int
+fd_snapshot_create_worker_write_cold( fd_snapshot_create_worker_t * w,
+                                      ulong                         bufsz,
+                                      fd_funk_t *                   funk,
+                                      fd_funk_rec_t const *         rec,
+                                      ulong                         off,
+                                      ulong                         sz ) {
+  while( sz ) {
+    ulong chunk_sz = fd_ulong_min( sz, bufsz - w->in_sz );
+    int err = fd_funk_cold_read( funk, rec, off, w->in_buf + w->in_sz, chunk_sz );
+    if( FD_UNLIKELY( err ) ) {
+      FD_LOG_WARNING(( "fd_funk_cold_read failed (%i-%s)", err, fd_funk_strerror( err ) ));
+      return 0;
+    }
+    w->in_sz += chunk_sz;
+    off      += chunk_sz;
+    sz       -= chunk_sz;
+    if( w->in_sz==bufsz )
+      if( FD_UNLIKELY( !fd_snapshot_create_worker_compress( w, bufsz, 0 ) ) ) return 0;
+  }
+  return 1;
+}
+
+/* fd_snapshot_create_accv writes account vec accv_idx to w as its own
+   Zstandard frame.  Returns 1 on success and 0 on failure. */
+
+static int
+fd_snapshot_create_accv( fd_snapshot_create_t const *  create,
+                         fd_snapshot_create_worker_t * w,
+                         ulong                         accv_idx ) {
+
+  ulong       bufsz = create->compress_bufsz;
+  fd_funk_t * funk  = create->funk;
+  fd_wksp_t * wksp  = fd_funk_wksp( funk );
+
+  char name[ FD_TAR_NAME_SZ ];
+  snprintf( name, sizeof(name), "accounts/%lu.%lu", create->slot, create->accv[ accv_idx ].id );
+  if( FD_UNLIKELY( !fd_snapshot_create_tar_file( w, bufsz, name, create->accv[ accv_idx ].file_sz ) ) ) return 0;
+
+  for( ulong i=create->accv_rec0[ accv_idx ]; i<create->accv_rec0[ accv_idx+1UL ]; i++ ) {
+    fd_funk_rec_t const * rec = create->rec[ i ];
+
+    fd_account_meta_t meta[1];
+    if( FD_UNLIKELY( fd_snapshot_create_read_meta( funk, rec, meta )!=1 ) ) return 0;
+
+    fd_solana_account_hdr_t hdr[1];
+    fd_memset( hdr, 0, sizeof(fd_solana_account_hdr_t) );
+    hdr->meta.data_len = meta->dlen;
+    fd_memcpy( hdr->meta.pubkey, fd_funk_key_to_acc( rec->pair.key ), sizeof(fd_pubkey_t) );
+    fd_memcpy( &hdr->info,       &meta->info, sizeof(fd_solana_account_meta_t) );
+    fd_memcpy( hdr->hash.value,  meta->hash,  32UL );
+
+    ulong pad_sz = fd_ulong_align_up( meta->dlen, FD_SNAPSHOT_ACC_ALIGN ) - meta->dlen;
+    if( FD_UNLIKELY( !fd_snapshot_create_worker_write( w, bufsz, hdr, sizeof(fd_solana_account_hdr_t) ) ) ) return 0;
+    if( FD_UNLIKELY( fd_funk_rec_is_cold( rec ) ) ) {
+      if( FD_UNLIKELY( !fd_snapshot_create_worker_write_cold( w, bufsz, funk, rec, meta->hlen, meta->dlen ) ) ) return 0;
+    } else {
+      uchar const * data = (uchar const *)fd_funk_val_const( rec, wksp ) + meta->hlen;
+      if( FD_UNLIKELY( !fd_snapshot_create_worker_write( w, bufsz, data, meta->dlen ) ) ) return 0;
+    }
+    if( FD_UNLIKELY( !fd_snapshot_create_worker_write( w, bufsz, NULL, pad_sz ) ) ) return 0;
+  }
+
+  if( FD_UNLIKELY( !fd_snapshot_create_worker_pad( w, bufsz ) ) ) return 0;
+  return fd_snapshot_create_worker_compress( w, bufsz, 1 );
+}
+
+static void
+fd_snapshot_create_task( void * tpool,
+                         ulong  t0,      ulong t1,
+                         void * _create,
+                         void * reduce,  ulong stride,
+                         ulong  l0,      ulong l1,
+                         ulong  m0,      ulong m1,
+                         ulong  n0,      ulong n1 ) {
+  (void)tpool; (void)reduce; (void)stride; (void)l0; (void)l1; (void)m0; (void)m1; (void)n1;
+
+  fd_snapshot_create_t const *  create = (fd_snapshot_create_t const *)_create;
+  ulong                         w_idx  = n0-t0;
+  ulong                         w_cnt  = t1-t0;
+  fd_snapshot_create_worker_t * w      = &create->worker[ w_idx ];
+
+  for( ulong i=w_idx; i<create->accv_cnt; i+=w_cnt ) {
+    if( FD_UNLIKELY( !fd_snapshot_create_accv( create, w, i ) ) ) { w->ok = 0; return; }
+  }
+  if( FD_UNLIKELY( !fd_snapshot_create_worker_flush( w ) ) ) w->ok = 0;
+}
+
+/* Manifest ***********************************************************/
+
+static ulong
+fd_snapshot_create_total_stake( fd_vote_accounts_t const * vote_accounts ) {
+  ulong total = 0UL;
+  for( fd_vote_accounts_pair_t_mapnode_t * n = fd_vote_accounts_pair_t_map_minimum( vote_accounts->vote_accounts_pool, vote_accounts->vote_accounts_root );
+       n;
+       n = fd_vote_accounts_pair_t_map_successor( vote_accounts->vote_accounts_pool, n ) )
+    total += n->elem.stake;
+  return total;
+}
+
+/* fd_snapshot_create_manifest serializes the manifest of the current
+   snapshot to w as a TAR file.  This is the inverse of
+   fd_exec_slot_ctx_recover.  Firedancer does not track all of the bank
+   state of a Solana Labs bank, which leaves the following known gaps:
+
+   - The blockhash queue only holds the recent blockhashes of the slot
+     bank (newest first), numbered by block height, without timestamps.
+   - The hard forks only hold the last restart slot (if any), with a
+     count of 1.  Earlier hard forks are not tracked.
+   - The ancestors only hold the snapshot slot itself.  This covers
+     every account vec in the snapshot, as they are all stored at the
+     snapshot slot, but not the ancestry of the bank.
+   - Fields that Firedancer does not track at all are left empty.
+
+   Returns 1 on success and 0 on failure. */
+
+static int
+fd_snapshot_create_manifest( fd_snapshot_create_t *        create,
+                             fd_snapshot_create_worker_t * w,
+                             fd_exec_slot_ctx_t const *    slot_ctx ) {
+
+  fd_slot_bank_t const *  slot_bank  = &slot_ctx->slot_bank;
+  fd_epoch_bank_t const * epoch_bank = &slot_ctx->epoch_ctx->epoch_bank;
+  ulong                   slot       = slot_bank->slot;
+  ulong                   epoch      = fd_slot_to_epoch( &epoch_bank->epoch_schedule, slot, NULL );
+
+  /* The manifest borrows slot_ctx objects and is never destroyed */
+
+  fd_solana_manifest_t manifest[1];
+  fd_memset( manifest, 0, sizeof(fd_solana_manifest_t) );
+  fd_deserializable_versioned_bank_t * bank = &manifest->bank;
+
+  /* Blockhash queue.  Solana Labs stamps the n-th blockhash it registers
+     with hash index n, i.e. ages go by blocks. */
+
+  fd_hash_t poh = slot_bank->poh;
+  fd_block_hash_queue_t * bhq = &bank->blockhash_queue;
+  bhq->last_hash_index = slot_bank->block_height;
+  bhq->last_hash       = &poh;
+  bhq->max_age         = FD_SNAPSHOT_CREATE_BLOCKHASH_MAX_AGE;
+
+  fd_block_block_hash_entry_t const * recent = slot_bank->recent_block_hashes.hashes;
+  ulong recent_cnt = recent ? deq_fd_block_block_hash_entry_t_cnt( recent ) : 0UL;
+  recent_cnt = fd_ulong_min( recent_cnt, fd_ulong_min( FD_SNAPSHOT_CREATE_BLOCKHASH_MAX_AGE+1UL, bhq->last_hash_index+1UL ) );
+  fd_hash_hash_age_pair_t * ages = NULL;
+  if( recent_cnt ) {
+    ages = fd_valloc_malloc( slot_ctx->valloc, alignof(fd_hash_hash_age_pair_t), recent_cnt*sizeof(fd_hash_hash_age_pair_t) );
+    if( FD_UNLIKELY( !ages ) ) {
+      FD_LOG_WARNING(( "failed to allocate %lu blockhash queue entries", recent_cnt ));
+      return 0;
+    }
+    ulong i = 0UL;
+    for( deq_fd_block_block_hash_entry_t_iter_t iter = deq_fd_block_block_hash_entry_t_iter_init( recent );
+         i<recent_cnt;
+         iter = deq_fd_block_block_hash_entry_t_iter_next( recent, iter ), i++ ) {
+      fd_block_block_hash_entry_t const * e = deq_fd_block_block_hash_entry_t_iter_ele_const( recent, iter );
+      ages[ i ] = (fd_hash_hash_age_pair_t){
+        .key = e->blockhash,
+        .val = { .fee_calculator = e->fee_calculator, .hash_index = bhq->last_hash_index-i, .timestamp = 0UL }
+      };
+    }
+    bhq->ages_len = recent_cnt;
+    bhq->ages     = ages;
+  }
+
+  fd_slot_pair_t ancestor = { .slot = slot, .val = 0UL };
+  bank->ancestors_len = 1UL;
+  bank->ancestors     = &ancestor;
+
+  fd_slot_pair_t hard_fork = { .slot = slot_bank->last_restart_slot.slot, .val = 1UL };
+  if( hard_fork.slot ) {
+    bank->hard_forks.hard_forks_len = 1UL;
+    bank->hard_forks.hard_forks     = &hard_fork;
+  }
+
+  ulong hashes_per_tick = epoch_bank->hashes_per_tick;
+  bank->hash                  = slot_bank->banks_hash;
+  bank->parent_hash           = slot_ctx->prev_banks_hash;
+  bank->parent_slot           = slot_bank->prev_slot;
+  bank->transaction_count     = slot_bank->transaction_count;
+  bank->tick_height           = slot_bank->max_tick_height;
+  bank->signature_count       = slot_ctx->signature_cnt;
+  bank->capitalization        = slot_bank->capitalization;
+  bank->max_tick_height       = slot_bank->max_tick_height;
+  bank->hashes_per_tick       = hashes_per_tick ? &hashes_per_tick : NULL;
+  bank->ticks_per_slot        = epoch_bank->ticks_per_slot;
+  bank->ns_per_slot           = epoch_bank->ns_per_slot;
+  bank->genesis_creation_time = epoch_bank->genesis_creation_time;
+  bank->slots_per_year        = epoch_bank->slots_per_year;
+  bank->accounts_data_len     = create->data_sz;
+  bank->slot                  = slot;
+  bank->epoch                 = epoch;
+  bank->block_height          = slot_bank->block_height;
+  if( slot_ctx->leader ) bank->collector_id = *slot_ctx->leader;
+  bank->collector_fees        = slot_bank->collected_fees;
+  bank->fee_calculator.lamports_per_signature = slot_bank->lamports_per_signature;
+  bank->fee_rate_governor     = slot_bank->fee_rate_governor;
+  bank->collected_rent        = slot_bank->collected_rent;
+  bank->rent_collector.epoch          = epoch;
+  bank->rent_collector.epoch_schedule = epoch_bank->epoch_schedule;
+  bank->rent_collector.slots_per_year = epoch_bank->slots_per_year;
+  bank->rent_collector.rent           = epoch_bank->rent;
+  bank->epoch_schedule        = epoch_bank->epoch_schedule;
+  bank->inflation             = epoch_bank->inflation;
+  bank->stakes                = epoch_bank->stakes;
+
+  fd_epoch_epoch_stakes_pair_t epoch_stakes[2];
+  fd_memset( epoch_stakes, 0, sizeof(epoch_stakes) );
+  epoch_stakes[0].key                        = epoch;
+  epoch_stakes[0].value.stakes.vote_accounts = slot_bank->epoch_stakes;
+  epoch_stakes[0].value.stakes.epoch         = epoch;
+  epoch_stakes[0].value.total_stake          = fd_snapshot_create_total_stake( &slot_bank->epoch_stakes );
+  epoch_stakes[1].key                        = epoch+1UL;
+  epoch_stakes[1].value.stakes.vote_accounts = epoch_bank->next_epoch_stakes;
+  epoch_stakes[1].value.stakes.epoch         = epoch+1UL;
+  epoch_stakes[1].value.total_stake          = fd_snapshot_create_total_stake( &epoch_bank->next_epoch_stakes );
+  bank->epoch_stakes_len = 2UL;
+  bank->epoch_stakes     = epoch_stakes;
+
+  fd_snapshot_slot_acc_vecs_t storage = {
+    .slot             = slot,
+    .account_vecs_len = create->accv_cnt,
+    .account_vecs     = create->accv
+  };
+  manifest->accounts_db.storages_len        = 1UL;
+  manifest->accounts_db.storages            = &storage;
+  manifest->accounts_db.slot                = slot;
+  manifest->accounts_db.bank_hash_info.hash = slot_bank->banks_hash;
+
+  manifest->lamports_per_signature = slot_bank->lamports_per_signature;
+
+  fd_hash_t epoch_account_hash = slot_bank->epoch_account_hash;
+  static fd_hash_t const hash_null = {0};
+  if( 0!=memcmp( &epoch_account_hash, &hash_null, sizeof(fd_hash_t) ) )
+    manifest->epoch_account_hash = &epoch_account_hash;
+
+  /* Serialize */
+
+  ulong   manifest_sz  = fd_solana_manifest_size( manifest );
+  uchar * manifest_buf = fd_valloc_malloc( slot_ctx->valloc, 8UL, manifest_sz );
+  if( FD_UNLIKELY( !manifest_buf ) ) {
+    FD_LOG_WARNING(( "failed to allocate %lu bytes for manifest", manifest_sz ));
+    if( ages ) fd_valloc_free( slot_ctx->valloc, ages );
+    return 0;
+  }
+
+  fd_bincode_encode_ctx_t encode = { .data = manifest_buf, .dataend = manifest_buf + manifest_sz };
+  int ok = fd_solana_manifest_encode( manifest, &encode )==FD_BINCODE_SUCCESS;
+  if( FD_UNLIKELY( !ok ) ) FD_LOG_WARNING(( "fd_solana_manifest_encode failed" ));
+
+  char name[ FD_TAR_NAME_SZ ];
+  snprintf( name, sizeof(name), "snapshots/%lu/%lu", slot, slot );
+  ok = ok &&
+       fd_snapshot_create_tar_file  ( w, create->compress_bufsz, name, manifest_sz ) &&
+       fd_snapshot_create_worker_write( w, create->compress_bufsz, manifest_buf, manifest_sz ) &&
+       fd_snapshot_create_worker_pad  ( w, create->compress_bufsz );
+
+  fd_valloc_free( slot_ctx->valloc, manifest_buf );
+  if( ages ) fd_valloc_free( slot_ctx->valloc, ages );
+  return ok;
+}
+
+/* Main snapshot create ***********************************************/
+
+/* fd_snapshot_create_append appends the contents of the temporary file
+   of src to the temporary file of dst.  Uses the staging buffer of dst
+   (which should be empty). */
+
+static int
+fd_snapshot_create_append( fd_snapshot_create_t const *  create,
+                           fd_snapshot_create_worker_t * dst,
+                           fd_snapshot_create_worker_t * src ) {
+
+  if( FD_UNLIKELY( lseek( src->fd, 0L, SEEK_SET )!=0L ) ) {
+    FD_LOG_WARNING(( "lseek(%s) failed (%i-%s)", src->path, errno, fd_io_strerror( errno ) ));
+    return 0;
+  }
+
+  ulong rem = src->comp_sz;
+  while( rem ) {
+    ulong sz = fd_ulong_min( rem, create->compress_bufsz );
+    ulong rsz;
+    int err = fd_io_read( src->fd, dst->in_buf, sz, sz, &rsz );
+    if( FD_UNLIKELY( err ) ) {
+      FD_LOG_WARNING(( "read from %s failed (%d-%s)", src->path, err, err<0 ? "unexpected EOF" : fd_io_strerror( err ) ));
+      return 0;
+    }
+    ulong wsz;
+    err = fd_io_write( dst->fd, dst->in_buf, sz, sz, &wsz );
+    if( FD_UNLIKELY( err ) ) {
+      FD_LOG_WARNING(( "write to %s failed (%d-%s)", dst->path, err, fd_io_strerror( err ) ));
+      return 0;
+    }
+    rem -= sz;
+  }
+  dst->comp_sz += src->comp_sz;
+  dst->raw_sz  += src->raw_sz;
+  return 1;
+}
+
+int
+fd_snapshot_create( fd_snapshot_create_t * create,
+                    fd_exec_slot_ctx_t *   slot_ctx,
+                    fd_tpool_t *           tpool,
+                    ulong                  t0,
+                    ulong                  t1 ) {
+
+  if( FD_UNLIKELY( (!create) || create->magic!=FD_SNAPSHOT_CREATE_MAGIC ) ) {
+    FD_LOG_WARNING(( "invalid create object" ));
+    return 0;
+  }
+  if( FD_UNLIKELY( (!slot_ctx) || (!slot_ctx->acc_mgr) || slot_ctx->acc_mgr->funk!=create->funk ) ) {
+    FD_LOG_WARNING(( "slot_ctx does not match create object" ));
+    return 0;
+  }
+
+  ulong w_cnt = 1UL;
+  if( tpool ) {
+    if( FD_UNLIKELY( (t0>=t1) | (t1>fd_tpool_worker_cnt( tpool )) | (t1-t0>create->worker_cnt) ) ) {
+      FD_LOG_WARNING(( "bad thread range [%lu,%lu)", t0, t1 ));
+      return 0;
+    }
+    w_cnt = t1-t0;
+  }
+
+  long dt = -fd_log_wallclock();
+
+  create->slot = slot_ctx->slot_bank.slot;
+  if( FD_UNLIKELY( !fd_snapshot_create_gather( create, slot_ctx->funk_txn ) ) ) return 0;
+
+  FD_LOG_NOTICE(( "Creating snapshot at slot %lu (%lu accounts in %lu account vecs, %lu workers)",
+                  create->slot, create->rec_cnt, create->accv_cnt, w_cnt ));
+
+  /* Open temporary files */
+
+  int ok = 1;
+  for( ulong j=0UL; j<w_cnt; j++ ) {
+    fd_snapshot_create_worker_t * w = &create->worker[ j ];
+    w->in_sz = 0UL; w->out_sz = 0UL; w->raw_sz = 0UL; w->comp_sz = 0UL;
+    w->ok    = 1;
+    fd_zstd_cstream_reset( w->cstream );
+    w->fd = open( w->path, O_CREAT|O_TRUNC|O_RDWR|O_CLOEXEC, 0644 );
+    if( FD_UNLIKELY( w->fd<0 ) ) {
+      FD_LOG_WARNING(( "open(%s) failed (%i-%s)", w->path, errno, fd_io_strerror( errno ) ));
+      ok = 0;
+      break;
+    }
+  }
+
+  /* Version file, status cache and manifest go first */
+
+  fd_snapshot_create_worker_t * w0 = &create->worker[ 0 ];
+  ulong bufsz = create->compress_bufsz;
+  if( FD_LIKELY( ok ) ) {
+    /* Firedancer does not keep a status cache, so the status cache is
+       an empty Vec<BankSlotDelta>.  A Solana Labs node loading this
+       snapshot can thus not detect duplicates of transactions that
+       were processed before the snapshot slot. */
+    static uchar const status_cache[ 8 ] = {0};
+    ok = fd_snapshot_create_tar_file     ( w0, bufsz, "version", 5UL )                                       &&
+         fd_snapshot_create_worker_write ( w0, bufsz, "1.2.0", 5UL )                                         &&
+         fd_snapshot_create_worker_pad   ( w0, bufsz )                                                       &&
+         fd_snapshot_create_tar_file     ( w0, bufsz, "snapshots/status_cache", sizeof(status_cache) )       &&
+         fd_snapshot_create_worker_write ( w0, bufsz, status_cache, sizeof(status_cache) )                   &&
+         fd_snapshot_create_worker_pad   ( w0, bufsz )                                                       &&
+         fd_snapshot_create_manifest     ( create, w0, slot_ctx )                                            &&
+         fd_snapshot_create_worker_compress( w0, bufsz, 1 );
+  }
+
+  /* Account vecs */
+
+  if( FD_LIKELY( ok ) ) {
+    if( w_cnt>1UL ) fd_tpool_exec_all_raw( tpool, t0, t1, fd_snapshot_create_task, tpool, create, NULL, 0UL, 0UL, 0UL );
+    else            fd_snapshot_create_task( tpool, 0UL, 1UL, create, NULL, 0UL, 0UL, 0UL, 0UL, 0UL, 0UL, 1UL );
+    for( ulong j=0UL; j<w_cnt; j++ ) ok &= create->worker[ j ].ok;
+  }
+
+  /* Concatenate and end the archive */
+
+  for( ulong j=1UL; ok && j<w_cnt; j++ )
+    ok = fd_snapshot_create_append( create, w0, &create->worker[ j ] );
+
+  if( FD_LIKELY( ok ) ) {
+    ok = fd_snapshot_create_worker_write   ( w0, bufsz, NULL, 2UL*FD_SNAPSHOT_CREATE_TAR_ALIGN ) &&
+         fd_snapshot_create_worker_compress( w0, bufsz, 1 ) &&
+         fd_snapshot_create_worker_flush   ( w0 );
+  }
+
+  if( FD_LIKELY( ok ) ) {
+    if( FD_UNLIKELY( fsync( w0->fd ) ) ) {
+      FD_LOG_WARNING(( "fsync(%s) failed (%i-%s)", w0->path, errno, fd_io_strerror( errno ) ));
+      ok = 0;
+    }
+  }
+  if( FD_LIKELY( ok ) ) {
+    if( FD_UNLIKELY( rename( w0->path, create->snap_path ) ) ) {
+      FD_LOG_WARNING(( "rename(%s,%s) failed (%i-%s)", w0->path, create->snap_path, errno, fd_io_strerror( errno ) ));
+      ok = 0;
+    }
+  }
+
+  /* Clean up temporary files */
+
+  for( ulong j=0UL; j<w_cnt; j++ ) {
+    fd_snapshot_create_worker_t * w = &create->worker[ j ];
+    if( w->fd<0 ) continue;
+    close( w->fd );
+    w->fd = -1;
+    if( !ok || j>0UL ) unlink( w->path );
+  }
+
+  dt += fd_log_wallclock();
+  if( FD_LIKELY( ok ) )
+    FD_LOG_NOTICE(( "Created snapshot %s (%lu bytes, %lu bytes uncompressed) in %.3f s",
+                    create->snap_path, w0->comp_sz, w0->raw_sz, (double)dt*1e-9 ));
+  return ok;
+}
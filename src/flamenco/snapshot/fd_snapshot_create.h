@@ -1,11 +1,22 @@
 #ifndef HEADER_fd_src_flamenco_snapshot_fd_snapshot_create_h
 #define HEADER_fd_src_flamenco_snapshot_fd_snapshot_create_h
 
-/* fd_snapshot_create.h provides APIs for creating a Labs-compatible
-   snapshot from a slot execution context. */
-
-#include "../fd_flamenco_base.h"
+/* fd_snapshot_create.h provides APIs for creating a snapshot in the
+   Solana Labs format from a slot execution context.  The snapshot
+   holds all accounts, but only the bank state that Firedancer tracks.
+   In particular, the status cache is empty and the blockhash queue,
+   hard forks and ancestors are incomplete (see fd_snapshot_create.c
+   for details). */
+
+#include "fd_snapshot_base.h"
 #include "../runtime/context/fd_exec_slot_ctx.h"
+#include "../../util/tpool/fd_tpool.h"
+
+/* FD_SNAPSHOT_CREATE_BLOCKHASH_MAX_AGE is the max_age of the blockhash
+   queue in created snapshots (MAX_RECENT_BLOCKHASHES in Solana Labs).
+   The queue holds at most max_age+1 blockhashes. */
+
+#define FD_SNAPSHOT_CREATE_BLOCKHASH_MAX_AGE (300UL)
 
 struct fd_snapshot_create_private;
 typedef struct fd_snapshot_create_private fd_snapshot_create_t;
@@ -15,16 +26,19 @@ FD_PROTOTYPES_BEGIN
 /* fd_snapshot_create_{align,footprint} return required memory region
    parameters for the fd_snapshot_create_t object.
 
-   worker_cnt is the number of workers for parallel snapshot create
-   (treated as 1UL parallel mode not available). compress_lvl is the
-   Zstandard compression level.  compress_bufsz is the in-memory buffer
-   for writes (larger buffers results in less frequent but larger write
-   ops).  funk_rec_cnt is the number of slots in the funk rec hashmap.
+   worker_cnt is the max number of workers for parallel snapshot create
+   (in [1,FD_TILE_MAX]).  compress_lvl is the Zstandard compression
+   level.  compress_bufsz is the in-memory buffer for writes (larger
+   buffers results in less frequent but larger write ops).  Each worker
+   uses two such buffers.  funk_rec_cnt is the number of slots in the
+   funk rec hashmap (bounds the number of accounts in the snapshot).
    batch_acc_cnt is the max number of accounts per account vec.
 
    Resulting footprint approximates
 
-     O( funk_rec_cnt + (worker_cnt * (compress_lvl + compress_bufsz + batch_acc_cnt)) ) */
+     O( funk_rec_cnt + (worker_cnt * (compress_lvl + compress_bufsz)) )
+
+   Returns 0 if any of the parameters is invalid. */
 
 FD_FN_CONST ulong
 fd_snapshot_create_align( void );
@@ -43,9 +57,12 @@ fd_snapshot_create_footprint( ulong worker_cnt,
    the final snapshot path.  May create temporary files adject to
    snap_path.  {worker_cnt,compress_lvl,compress_bufsz,funk_rec_cnt,
    batch_acc_cnt} must match arguments to footprint when mem was
-   created.  On failure, returns NULL. Reasons for failure include
-   invalid memory region or invalid file descriptor.  Logs reasons for
-   failure. */
+   created.  max_accv_sz is the target size of an account vec file (an
+   account vec is split before it would grow past max_accv_sz bytes).
+   rng is used to pick names for temporary files.  On failure, returns
+   NULL. Reasons for failure include invalid memory region, invalid
+   parameters or a failure to create a zstd compressor.  Logs reasons
+   for failure. */
 
 fd_snapshot_create_t *
 fd_snapshot_create_new( void *               mem,
@@ -66,13 +83,30 @@ void *
 fd_snapshot_create_delete( fd_snapshot_create_t * create );
 
 /* fd_snapshot_create exports the 'snapshot manifest' and a copy of all
-   accounts from the slot ctx that the create object is attached to.
-   Writes a .tar.zst stream out to the fd.  Returns 1 on success, and
-   0 on failure.  Reason for failure is logged. */
+   accounts visible from the current funk transaction of slot_ctx.
+   Writes a .tar.zst stream out to the snapshot path.  Returns 1 on
+   success, and 0 on failure.  Reason for failure is logged.  On
+   failure, no file is left at the snapshot path or any temporary path.
+
+   Account vecs are compressed in parallel by the tpool threads
+   [t0,t1) (t1-t0 should be at most the worker_cnt of create).  The
+   caller should be thread t0 and threads (t0,t1) should be available.
+   If tpool is NULL, runs on the caller alone.  Each account vec file
+   is compressed as independent Zstandard frames such that the
+   resulting snapshot can be decompressed in parallel.
+
+   Accounts are read directly from funk.  Cold account values are read
+   from the funk cold file as they are written out, without loading
+   them back into the funk wksp.  The caller should ensure
+   that neither slot_ctx nor the funk transactions visible from it are
+   modified while this is running. */
 
 int
 fd_snapshot_create( fd_snapshot_create_t * create,
-                    fd_exec_slot_ctx_t *   slot_ctx );
+                    fd_exec_slot_ctx_t *   slot_ctx,
+                    fd_tpool_t *           tpool,
+                    ulong                  t0,
+                    ulong                  t1 );
 
 FD_PROTOTYPES_END
 
@@ -5,7 +5,8 @@
 #include "../../ballet/zstd/fd_zstd.h"
 
 /* fd_snapshot_load.h manages a single-threaded streaming pipeline for
-   loading snapshots.
+   loading snapshots.  See fd_snapshot_load_par.h for a loader that
+   decompresses and restores on a thread pool.
 
    TODO: The indirect call architecture used here is suboptimal.
          In the future, we'd want to use a fd_tango based message
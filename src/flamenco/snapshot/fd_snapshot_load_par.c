@@ -0,0 +1,538 @@
+#define _DEFAULT_SOURCE
+#include "fd_snapshot_load_par.h"
+#include "../../ballet/zstd/fd_zstd.h"
+#include "../../util/archive/fd_tar.h"
+
+#include <errno.h>
+#include <sys/mman.h>  /* mmap, madvise */
+#include <sys/stat.h>  /* fstat */
+
+#define FD_SNAPSHOT_LOAD_PAR_MAGIC (0xf17eda2ce7510ad0UL) /* firedancer snapshot load par version 0 */
+
+/* FD_SNAPSHOT_LOAD_PAR_BUF_MIN is the initial size of a decompression
+   buffer.  Buffers grow as needed up to frame_buf_max and are kept
+   across rounds. */
+
+#define FD_SNAPSHOT_LOAD_PAR_BUF_MIN (1UL<<20)  /* 1 MiB */
+
+/* fd_snapshot_load_par_frame_t holds a Zstandard frame being
+   decompressed by a worker during the current round. */
+
+struct fd_snapshot_load_par_frame {
+  fd_zstd_dstream_t * dstream;
+
+  uchar const * in_cur;   /* next compressed byte of frame */
+  uchar const * in_end;   /* points one past last compressed byte of frame */
+
+  uchar *       out;      /* decompression buffer (from valloc) */
+  ulong         out_max;  /* size of decompression buffer */
+  ulong         out_sz;   /* number of bytes decompressed this round */
+
+  int           open;     /* 1 if frame did not fit in buffer and continues next round */
+  int           ok;       /* 0 if decompression failed */
+};
+
+typedef struct fd_snapshot_load_par_frame fd_snapshot_load_par_frame_t;
+
+struct __attribute__((aligned(FD_SNAPSHOT_LOAD_PAR_ALIGN))) fd_snapshot_load_par_private {
+  ulong magic;  /* ==FD_SNAPSHOT_LOAD_PAR_MAGIC */
+
+  ulong       worker_cnt;
+  ulong       zstd_window_sz;
+  ulong       frame_buf_max;
+  fd_valloc_t valloc;
+
+  fd_snapshot_load_par_frame_t * frame;      /* indexed [0,worker_cnt) */
+  ulong                          frame_cnt;  /* number of frames in current round */
+
+  /* Current load */
+
+  fd_snapshot_restore_t * restore;
+  fd_tar_reader_t         tar[1];
+
+  int                          fwd;       /* 1 if current TAR file is passed to restore */
+  fd_snapshot_restore_accv_t   cur;       /* account vec being read */
+  ulong                        cur_ctr;   /* number of bytes of cur read */
+  uchar *                      cur_own;   /* copy of cur content if it spans chunks, NULL otherwise */
+
+  fd_snapshot_restore_accv_t * accv;      /* account vecs of current round */
+  uchar **                     accv_own;  /* corresponding cur_own (freed after each round) */
+  ulong                        accv_cnt;
+  ulong                        accv_max;
+};
+
+ulong
+fd_snapshot_load_par_align( void ) {
+  return FD_SNAPSHOT_LOAD_PAR_ALIGN;
+}
+
+ulong
+fd_snapshot_load_par_footprint( ulong worker_cnt,
+                                ulong zstd_window_sz ) {
+
+  if( FD_UNLIKELY( (!worker_cnt) | (worker_cnt>FD_TILE_MAX) ) ) return 0UL;
+  if( FD_UNLIKELY( (!zstd_window_sz) | (zstd_window_sz>(1UL<<31)) ) ) return 0UL;
+
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, alignof(fd_snapshot_load_par_t),       sizeof(fd_snapshot_load_par_t) );
+  l = FD_LAYOUT_APPEND( l, alignof(fd_snapshot_load_par_frame_t), worker_cnt*sizeof(fd_snapshot_load_par_frame_t) );
+  for( ulong j=0UL; j<worker_cnt; j++ )
+    l = FD_LAYOUT_APPEND( l, fd_zstd_dstream_align(), fd_zstd_dstream_footprint( zstd_window_sz ) );
+  return FD_LAYOUT_FINI( l, fd_snapshot_load_par_align() );
+}
+
+fd_snapshot_load_par_t *
+fd_snapshot_load_par_new( void *      mem,
+                          ulong       worker_cnt,
+                          ulong       zstd_window_sz,
+                          ulong       frame_buf_max,
+                          fd_valloc_t valloc ) {
+
+  if( FD_UNLIKELY( !mem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)mem, fd_snapshot_load_par_align() ) ) ) {
+    FD_LOG_WARNING(( "unaligned mem" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( (!valloc.vt) || (!valloc.vt->malloc) || (!valloc.vt->free) ) ) {
+    FD_LOG_WARNING(( "NULL valloc" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !frame_buf_max ) ) {
+    FD_LOG_WARNING(( "zero frame_buf_max" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !fd_snapshot_load_par_footprint( worker_cnt, zstd_window_sz ) ) ) {
+    FD_LOG_WARNING(( "invalid parameters (worker_cnt=%lu zstd_window_sz=%lu)", worker_cnt, zstd_window_sz ));
+    return NULL;
+  }
+
+  FD_SCRATCH_ALLOC_INIT( l, mem );
+  fd_snapshot_load_par_t * load = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_snapshot_load_par_t), sizeof(fd_snapshot_load_par_t) );
+  fd_memset( load, 0, sizeof(fd_snapshot_load_par_t) );
+  load->worker_cnt     = worker_cnt;
+  load->zstd_window_sz = zstd_window_sz;
+  load->frame_buf_max  = frame_buf_max;
+  load->valloc         = valloc;
+
+  load->frame = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_snapshot_load_par_frame_t), worker_cnt*sizeof(fd_snapshot_load_par_frame_t) );
+  for( ulong j=0UL; j<worker_cnt; j++ ) {
+    fd_snapshot_load_par_frame_t * frame = &load->frame[ j ];
+    fd_memset( frame, 0, sizeof(fd_snapshot_load_par_frame_t) );
+
+    void * dstream_mem = FD_SCRATCH_ALLOC_APPEND( l, fd_zstd_dstream_align(), fd_zstd_dstream_footprint( zstd_window_sz ) );
+    frame->dstream = fd_zstd_dstream_new( dstream_mem, zstd_window_sz );
+    if( FD_UNLIKELY( !frame->dstream ) ) {
+      FD_LOG_WARNING(( "fd_zstd_dstream_new(%lu) failed", zstd_window_sz ));
+      for( ulong k=0UL; k<j; k++ ) fd_zstd_dstream_delete( load->frame[ k ].dstream );
+      return NULL;
+    }
+  }
+
+  FD_COMPILER_MFENCE();
+  load->magic = FD_SNAPSHOT_LOAD_PAR_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return load;
+}
+
+void *
+fd_snapshot_load_par_delete( fd_snapshot_load_par_t * load ) {
+
+  if( FD_UNLIKELY( !load ) ) return NULL;
+
+  if( FD_UNLIKELY( load->magic!=FD_SNAPSHOT_LOAD_PAR_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  for( ulong j=0UL; j<load->worker_cnt; j++ ) {
+    fd_snapshot_load_par_frame_t * frame = &load->frame[ j ];
+    if( frame->out ) fd_valloc_free( load->valloc, frame->out );
+    fd_zstd_dstream_delete( frame->dstream );
+  }
+  if( load->accv     ) fd_valloc_free( load->valloc, load->accv     );
+  if( load->accv_own ) fd_valloc_free( load->valloc, load->accv_own );
+
+  FD_COMPILER_MFENCE();
+  load->magic = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return (void *)load;
+}
+
+/* Decompression ******************************************************/
+
+/* fd_snapshot_load_par_decompress decompresses as much of a frame as
+   fits into frame_buf_max bytes.  Grows the frame's buffer as needed.
+   Returns 1 on success and 0 on failure. */
+
+static int
+fd_snapshot_load_par_decompress( fd_snapshot_load_par_t const * load,
+                                 fd_snapshot_load_par_frame_t * frame ) {
+
+  for(;;) {
+    if( frame->out_sz==frame->out_max ) {
+      if( frame->out_max>=load->frame_buf_max ) {
+        frame->open = 1;  /* continue next round */
+        return 1;
+      }
+
+      ulong   out_max = fd_ulong_min( fd_ulong_max( 2UL*frame->out_max, FD_SNAPSHOT_LOAD_PAR_BUF_MIN ), load->frame_buf_max );
+      uchar * out     = fd_valloc_malloc( load->valloc, 64UL, out_max );
+      if( FD_UNLIKELY( !out ) ) {
+        FD_LOG_WARNING(( "failed to allocate %lu byte decompression buffer", out_max ));
+        return 0;
+      }
+      if( frame->out ) {
+        fd_memcpy( out, frame->out, frame->out_sz );
+        fd_valloc_free( load->valloc, frame->out );
+      }
+      frame->out     = out;
+      frame->out_max = out_max;
+    }
+
+    uchar * out     = frame->out + frame->out_sz;
+    uchar * out_end = frame->out + frame->out_max;
+    int err = fd_zstd_dstream_read( frame->dstream, &frame->in_cur, frame->in_end, &out, out_end, NULL );
+    frame->out_sz = (ulong)( out - frame->out );
+    if( err==-1 ) {
+      frame->open = 0;
+      return 1;
+    }
+    if( FD_UNLIKELY( err ) ) {
+      FD_LOG_WARNING(( "fd_zstd_dstream_read failed" ));
+      return 0;
+    }
+    if( FD_UNLIKELY( (frame->in_cur==frame->in_end) & (out!=out_end) ) ) {
+      FD_LOG_WARNING(( "unexpected end of zstd frame" ));
+      return 0;
+    }
+  }
+}
+
+static void
+fd_snapshot_load_par_decompress_task( void * tpool,
+                                      ulong  t0,      ulong t1,
+                                      void * _load,
+                                      void * reduce,  ulong stride,
+                                      ulong  l0,      ulong l1,
+                                      ulong  m0,      ulong m1,
+                                      ulong  n0,      ulong n1 ) {
+  (void)tpool; (void)t1; (void)reduce; (void)stride; (void)l0; (void)l1; (void)m0; (void)m1; (void)n1;
+
+  fd_snapshot_load_par_t const * load  = (fd_snapshot_load_par_t const *)_load;
+  ulong                          w_idx = n0-t0;
+  if( w_idx>=load->frame_cnt ) return;
+
+  fd_snapshot_load_par_frame_t * frame = &load->frame[ w_idx ];
+  frame->ok = fd_snapshot_load_par_decompress( load, frame );
+}
+
+/* TAR stream *********************************************************/
+
+/* fd_snapshot_load_par_accv_push appends the account vec that was just
+   read to the account vecs of the current round.  Returns 0 on success
+   and -1 on failure. */
+
+static int
+fd_snapshot_load_par_accv_push( fd_snapshot_load_par_t * load ) {
+
+  if( load->accv_cnt==load->accv_max ) {
+    ulong accv_max = fd_ulong_max( 2UL*load->accv_max, 1024UL );
+    fd_snapshot_restore_accv_t * accv     = fd_valloc_malloc( load->valloc, alignof(fd_snapshot_restore_accv_t), accv_max*sizeof(fd_snapshot_restore_accv_t) );
+    uchar **                     accv_own = fd_valloc_malloc( load->valloc, alignof(uchar *), accv_max*sizeof(uchar *) );
+    if( FD_UNLIKELY( (!accv) | (!accv_own) ) ) {
+      FD_LOG_WARNING(( "failed to allocate room for %lu account vecs", accv_max ));
+      if( accv     ) fd_valloc_free( load->valloc, accv     );
+      if( accv_own ) fd_valloc_free( load->valloc, accv_own );
+      return -1;
+    }
+    if( load->accv ) {
+      fd_memcpy( accv,     load->accv,     load->accv_cnt*sizeof(fd_snapshot_restore_accv_t) );
+      fd_memcpy( accv_own, load->accv_own, load->accv_cnt*sizeof(uchar *) );
+      fd_valloc_free( load->valloc, load->accv     );
+      fd_valloc_free( load->valloc, load->accv_own );
+    }
+    load->accv     = accv;
+    load->accv_own = accv_own;
+    load->accv_max = accv_max;
+  }
+
+  load->accv    [ load->accv_cnt ] = load->cur;
+  load->accv_own[ load->accv_cnt ] = load->cur_own;
+  load->accv_cnt++;
+  load->cur_own = NULL;
+  return 0;
+}
+
+/* fd_snapshot_load_par_file gets called by fd_tar for each new file.
+   Account vecs are collected.  Any other file is passed to restore. */
+
+static int
+fd_snapshot_load_par_file( void *                _load,
+                           fd_tar_meta_t const * meta,
+                           ulong                 sz ) {
+
+  fd_snapshot_load_par_t * load = _load;
+
+  load->cur_ctr = 0UL;
+  load->fwd     = 0;
+  int is_accv = fd_snapshot_restore_accv_init( load->restore, &load->cur, meta, sz );
+  if( FD_UNLIKELY( is_accv<0 ) ) return -1;
+  if( !is_accv ) {
+    load->fwd = 1;
+    return fd_snapshot_restore_file( load->restore, meta, sz );
+  }
+  return 0;
+}
+
+/* fd_snapshot_load_par_read gets called by fd_tar with file content.
+   Account vec content gets referenced in place if it arrives in a
+   single chunk (i.e. the file does not span multiple frames or
+   rounds).  Otherwise, it is copied. */
+
+static int
+fd_snapshot_load_par_read( void *       _load,
+                           void const * buf,
+                           ulong        bufsz ) {
+
+  fd_snapshot_load_par_t * load = _load;
+  if( load->fwd ) return fd_snapshot_restore_chunk( load->restore, buf, bufsz );
+
+  /* Ignore content past the account vec size */
+  ulong sz = fd_ulong_min( bufsz, load->cur.sz - load->cur_ctr );
+  if( !sz ) return 0;
+
+  if( (!load->cur_ctr) & (sz==load->cur.sz) ) {
+    load->cur.data = buf;
+  } else {
+    if( !load->cur_own ) {
+      load->cur_own = fd_valloc_malloc( load->valloc, 8UL, load->cur.sz );
+      if( FD_UNLIKELY( !load->cur_own ) ) {
+        FD_LOG_WARNING(( "failed to allocate %lu bytes for account vec", load->cur.sz ));
+        return -1;
+      }
+      load->cur.data = load->cur_own;
+    }
+    fd_memcpy( load->cur_own + load->cur_ctr, buf, sz );
+  }
+  load->cur_ctr += sz;
+
+  if( load->cur_ctr==load->cur.sz ) return fd_snapshot_load_par_accv_push( load );
+  return 0;
+}
+
+static fd_tar_read_vtable_t const fd_snapshot_load_par_tar_vt =
+  { .file = fd_snapshot_load_par_file,
+    .read = fd_snapshot_load_par_read };
+
+/* fd_snapshot_load_par_accv_flush restores and releases the account
+   vecs collected this round.  Returns 1 on success and 0 on failure. */
+
+static int
+fd_snapshot_load_par_accv_flush( fd_snapshot_load_par_t * load,
+                                 fd_tpool_t *             tpool,
+                                 ulong                    t0,
+                                 ulong                    t1,
+                                 int                      ok ) {
+
+  if( ok ) ok = 0==fd_snapshot_restore_accv_par( load->restore, load->accv, load->accv_cnt, load->valloc, tpool, t0, t1 );
+  for( ulong j=0UL; j<load->accv_cnt; j++ )
+    if( load->accv_own[ j ] ) fd_valloc_free( load->valloc, load->accv_own[ j ] );
+  load->accv_cnt = 0UL;
+  return ok;
+}
+
+/* Main loader ********************************************************/
+
+/* fd_snapshot_load_par_scan populates the frames of the next round,
+   starting at *pcur.  Skips skippable frames.  If frame 0 is still
+   open, the next round only continues frame 0 (other frames could not
+   be consumed until it completes).  On return, *pcur points past the
+   last frame of the round.  Returns 1 on success and 0 on failure. */
+
+static int
+fd_snapshot_load_par_scan( fd_snapshot_load_par_t * load,
+                           uchar const *            file,
+                           uchar const **           pcur,
+                           uchar const *            end,
+                           ulong                    w_cnt ) {
+
+  if( load->frame[ 0 ].open ) {
+    load->frame_cnt = 1UL;
+    return 1;
+  }
+
+  uchar const * cur = *pcur;
+  ulong         cnt = 0UL;
+
+  while( (cnt<w_cnt) & (cur<end) ) {
+    ulong rem = (ulong)( end-cur );
+
+    fd_zstd_peek_t peek[1] = {0};
+    if( FD_UNLIKELY( !fd_zstd_peek( peek, cur, fd_ulong_min( rem, FD_ZSTD_MAX_HDR_SZ ) ) ) ) {
+      FD_LOG_WARNING(( "invalid zstd frame header at offset %lu", (ulong)( cur-file ) ));
+      return 0;
+    }
+    ulong frame_sz = fd_zstd_frame_sz( cur, rem );
+    if( FD_UNLIKELY( frame_sz==ULONG_MAX ) ) {
+      FD_LOG_WARNING(( "invalid or truncated zstd frame at offset %lu", (ulong)( cur-file ) ));
+      return 0;
+    }
+    if( peek->frame_is_skippable ) {
+      cur += frame_sz;
+      continue;
+    }
+    if( FD_UNLIKELY( peek->window_sz > load->zstd_window_sz ) ) {
+      FD_LOG_WARNING(( "zstd frame at offset %lu has window size %lu exceeding max %lu",
+                       (ulong)( cur-file ), peek->window_sz, load->zstd_window_sz ));
+      return 0;
+    }
+
+    fd_snapshot_load_par_frame_t * frame = &load->frame[ cnt++ ];
+    fd_zstd_dstream_reset( frame->dstream );
+    frame->in_cur = cur;
+    frame->in_end = cur + frame_sz;
+    frame->open   = 0;
+    cur += frame_sz;
+  }
+
+  load->frame_cnt = cnt;
+  *pcur = cur;
+  return 1;
+}
+
+int
+fd_snapshot_load_par( fd_snapshot_load_par_t * load,
+                      fd_snapshot_restore_t *  restore,
+                      int                      fd,
+                      fd_tpool_t *             tpool,
+                      ulong                    t0,
+                      ulong                    t1 ) {
+
+  if( FD_UNLIKELY( (!load) || load->magic!=FD_SNAPSHOT_LOAD_PAR_MAGIC ) ) {
+    FD_LOG_WARNING(( "invalid load object" ));
+    return 0;
+  }
+  if( FD_UNLIKELY( !restore ) ) {
+    FD_LOG_WARNING(( "NULL restore" ));
+    return 0;
+  }
+
+  ulong w_cnt = 1UL;
+  if( tpool ) {
+    if( FD_UNLIKELY( (t0>=t1) | (t1>fd_tpool_worker_cnt( tpool )) | (t1-t0>load->worker_cnt) ) ) {
+      FD_LOG_WARNING(( "bad thread range [%lu,%lu)", t0, t1 ));
+      return 0;
+    }
+    w_cnt = t1-t0;
+  }
+
+  struct stat st;
+  if( FD_UNLIKELY( fstat( fd, &st ) ) ) {
+    FD_LOG_WARNING(( "fstat(%d) failed (%i-%s)", fd, errno, fd_io_strerror( errno ) ));
+    return 0;
+  }
+  ulong file_sz = (ulong)st.st_size;
+  if( FD_UNLIKELY( !file_sz ) ) {
+    FD_LOG_WARNING(( "empty snapshot file" ));
+    return 0;
+  }
+  uchar const * file = mmap( NULL, file_sz, PROT_READ, MAP_PRIVATE, fd, 0L );
+  if( FD_UNLIKELY( file==MAP_FAILED ) ) {
+    FD_LOG_WARNING(( "mmap(%d,%lu) failed (%i-%s)", fd, file_sz, errno, fd_io_strerror( errno ) ));
+    return 0;
+  }
+  if( FD_UNLIKELY( madvise( (void *)file, file_sz, MADV_SEQUENTIAL ) ) )
+    FD_LOG_WARNING(( "madvise(MADV_SEQUENTIAL) failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+
+  long dt = -fd_log_wallclock();
+
+  load->restore  = restore;
+  load->fwd      = 0;
+  load->cur_ctr  = 0UL;
+  load->cur_own  = NULL;
+  load->accv_cnt = 0UL;
+  for( ulong j=0UL; j<load->worker_cnt; j++ ) load->frame[ j ].open = 0;
+  FD_TEST( fd_tar_reader_new( load->tar, &fd_snapshot_load_par_tar_vt, load ) );
+
+  uchar const * cur       = file;
+  uchar const * end       = file + file_sz;
+  int           ok        = 1;
+  int           eof       = 0;
+  ulong         round_cnt = 0UL;
+
+  while( ok & !eof ) {
+
+    /* Find frames */
+
+    ok = fd_snapshot_load_par_scan( load, file, &cur, end, w_cnt );
+    if( FD_UNLIKELY( !ok ) ) break;
+    ulong frame_cnt = load->frame_cnt;
+    if( FD_UNLIKELY( !frame_cnt ) ) {
+      FD_LOG_WARNING(( "unexpected end of snapshot (missing TAR end-of-archive marker)" ));
+      ok = 0;
+      break;
+    }
+    round_cnt++;
+
+    /* Decompress frames */
+
+    for( ulong j=0UL; j<frame_cnt; j++ ) load->frame[ j ].out_sz = 0UL;
+    if( w_cnt>1UL ) fd_tpool_exec_all_raw( tpool, t0, t1, fd_snapshot_load_par_decompress_task, tpool, load, NULL, 0UL, 0UL, 0UL );
+    else            fd_snapshot_load_par_decompress_task( tpool, 0UL, 1UL, load, NULL, 0UL, 0UL, 0UL, 0UL, 0UL, 0UL, 1UL );
+    for( ulong j=0UL; j<frame_cnt; j++ ) ok &= load->frame[ j ].ok;
+    if( FD_UNLIKELY( !ok ) ) break;
+
+    /* Walk the TAR stream in frame order.  Frames following a frame
+       that is still open are discarded and decompressed again once it
+       completes. */
+
+    ulong open_idx = frame_cnt;
+    for( ulong j=0UL; j<frame_cnt; j++ ) {
+      fd_snapshot_load_par_frame_t * frame = &load->frame[ j ];
+      int tar_err = fd_tar_read( load->tar, frame->out, frame->out_sz );
+      if( tar_err<0 ) { eof = 1; break; }
+      if( FD_UNLIKELY( tar_err>0 ) ) {
+        FD_LOG_WARNING(( "snapshot tar stream failed (%d-%s)", tar_err, fd_io_strerror( tar_err ) ));
+        ok = 0;
+        break;
+      }
+      if( frame->open ) { open_idx = j; break; }
+    }
+
+    /* Restore account vecs.  Has to happen before the decompression
+       buffers get reused. */
+
+    ok = fd_snapshot_load_par_accv_flush( load, tpool, t0, t1, ok );
+
+    /* Carry over open frame as frame 0 of the next round */
+
+    if( (!eof) & (open_idx<frame_cnt) ) {
+      fd_snapshot_load_par_frame_t tmp = load->frame[ 0 ];
+      load->frame[ 0 ]        = load->frame[ open_idx ];
+      load->frame[ open_idx ] = tmp;
+      cur = load->frame[ 0 ].in_end;
+    }
+    load->frame[ 0 ].open &= !eof;
+  }
+
+  if( load->cur_own ) {
+    fd_valloc_free( load->valloc, load->cur_own );
+    load->cur_own = NULL;
+  }
+  fd_tar_reader_delete( load->tar );
+  load->restore = NULL;
+
+  if( FD_UNLIKELY( munmap( (void *)file, file_sz ) ) )
+    FD_LOG_WARNING(( "munmap failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+
+  dt += fd_log_wallclock();
+  if( FD_LIKELY( ok ) )
+    FD_LOG_NOTICE(( "Loaded snapshot (%lu bytes, %lu rounds, %lu workers) in %.3f s",
+                    file_sz, round_cnt, w_cnt, (double)dt*1e-9 ));
+  return ok;
+}
@@ -0,0 +1,99 @@
+#ifndef HEADER_fd_src_flamenco_snapshot_fd_snapshot_load_par_h
+#define HEADER_fd_src_flamenco_snapshot_fd_snapshot_load_par_h
+
+/* fd_snapshot_load_par.h provides a multi-threaded loader for snapshot
+   files.
+
+   The streaming pipeline in fd_snapshot_load.h decompresses, untars and
+   restores accounts on a single core.  The parallel loader instead
+   splits the compressed snapshot at Zstandard frame boundaries and then
+   loads it in rounds:
+
+   - Serial:   Find the next frames (fd_zstd_frame_sz and fd_zstd_peek).
+               This only reads block headers.
+   - Parallel: Decompress each frame into its own buffer.
+   - Serial:   Walk the TAR stream.  The manifest and any other files
+               are passed to fd_snapshot_restore as usual.  Account vecs
+               are collected, without copying if they are contained in
+               a single frame.
+   - Parallel: Parse account vecs and insert accounts into funk (see
+               fd_snapshot_restore_accv_par).
+
+   Snapshots created by fd_snapshot_create compress each account vec as
+   a separate frame and thus decompress in parallel.  A snapshot that
+   consists of a single frame (e.g. as created by Solana Labs) gets
+   decompressed serially in chunks of frame_buf_max bytes, but accounts
+   are still inserted in parallel. */
+
+#include "fd_snapshot_restore.h"
+#include "../../util/tpool/fd_tpool.h"
+
+#if FD_HAS_ZSTD
+
+struct fd_snapshot_load_par_private;
+typedef struct fd_snapshot_load_par_private fd_snapshot_load_par_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_snapshot_load_par_{align,footprint} return required memory region
+   parameters for the fd_snapshot_load_par_t object.  worker_cnt is the
+   max number of threads for a parallel load (in [1,FD_TILE_MAX]).
+   zstd_window_sz is the largest Zstandard window size supported (each
+   worker has a decompressor of roughly that size).  Returns 0 if any of
+   the parameters is invalid. */
+
+FD_FN_CONST ulong
+fd_snapshot_load_par_align( void );
+
+FD_FN_CONST ulong
+fd_snapshot_load_par_footprint( ulong worker_cnt,
+                                ulong zstd_window_sz );
+
+/* fd_snapshot_load_par_new creates a new parallel loader in the given
+   mem region, which adheres to above alignment/footprint requirements.
+   {worker_cnt,zstd_window_sz} must match arguments to footprint when
+   mem was created.  frame_buf_max is the max number of decompressed
+   bytes that each worker buffers per round (larger frames are
+   decompressed in multiple rounds).  valloc is used to allocate
+   decompression buffers and temporary memory.  valloc must be safe for
+   concurrent use by the worker threads.  Peak memory use approximates
+   O( worker_cnt * frame_buf_max ).  Returns qualified handle to loader
+   on success.  On failure, returns NULL.  Logs reasons for failure. */
+
+fd_snapshot_load_par_t *
+fd_snapshot_load_par_new( void *      mem,
+                          ulong       worker_cnt,
+                          ulong       zstd_window_sz,
+                          ulong       frame_buf_max,
+                          fd_valloc_t valloc );
+
+/* fd_snapshot_load_par_delete destroys the given loader and frees any
+   buffers.  Returns memory region back to caller. */
+
+void *
+fd_snapshot_load_par_delete( fd_snapshot_load_par_t * load );
+
+/* fd_snapshot_load_par loads the .tar.zst snapshot file open at fd into
+   restore.  fd should be a regular file (it is memory mapped).  The
+   restore object should be freshly created (the manifest callback, if
+   any, is called as usual).  Returns 1 on success, and 0 on failure.
+   Logs reason for failure.
+
+   Frames are decompressed and accounts are restored by tpool threads
+   [t0,t1) (t1-t0 should be at most the worker_cnt of load).  The
+   caller should be thread t0 and threads (t0,t1) should be available.
+   If tpool is NULL, runs on the caller alone. */
+
+int
+fd_snapshot_load_par( fd_snapshot_load_par_t * load,
+                      fd_snapshot_restore_t *  restore,
+                      int                      fd,
+                      fd_tpool_t *             tpool,
+                      ulong                    t0,
+                      ulong                    t1 );
+
+FD_PROTOTYPES_END
+
+#endif /* FD_HAS_ZSTD */
+
+#endif /* HEADER_fd_src_flamenco_snapshot_fd_snapshot_load_par_h */
@@ -213,7 +213,12 @@ fd_snapshot_restore_account_hdr( fd_snapshot_restore_t * restore ) {
   int is_dupe = 0;
 
   /* Check if account exists */
-  rec->const_meta = fd_acc_mgr_view_raw( acc_mgr, funk_txn, key, &rec->const_rec, NULL );
+  int view_err = FD_ACC_MGR_SUCCESS;
+  rec->const_meta = fd_acc_mgr_view_raw( acc_mgr, funk_txn, key, &rec->const_rec, &view_err );
+  if( FD_UNLIKELY( view_err==FD_ACC_MGR_ERR_READ_FAILED ) ) {
+    FD_LOG_WARNING(( "fd_acc_mgr_view_raw(%s) failed", fd_acct_addr_cstr( key_cstr, key->uc ) ));
+    return 0;
+  }
   if( rec->const_meta )
     if( rec->const_meta->slot > restore->accv_slot )
       is_dupe = 1;
@@ -331,21 +336,20 @@ fd_snapshot_restore_manifest( fd_snapshot_restore_t * restore ) {
 
 /* Streaming state machine ********************************************/
 
-/* fd_snapshot_restore_accv_prepare prepares for consumption of an
-   account vec file. */
+/* fd_snapshot_restore_accv_lookup parses the slot number of an account
+   vec file and looks up its size in the accv index.  Returns 1 on
+   success and 0 if the file name is invalid. */
 
 static int
-fd_snapshot_restore_accv_prepare( fd_snapshot_restore_t * restore,
-                                  fd_tar_meta_t const *   meta,
-                                  ulong                   sz ) {
+fd_snapshot_restore_accv_lookup( fd_snapshot_restore_t * restore,
+                                 fd_tar_meta_t const *   meta,
+                                 ulong                   sz,
+                                 ulong *                 out_slot,
+                                 ulong *                 out_sz ) {
 
   ulong id, slot;
-  if( FD_UNLIKELY( sscanf( meta->name, "accounts/%lu.%lu", &slot, &id)!=2 ) ) {
-    /* ignore if file name invalid */
-    restore->state  = STATE_DONE;
-    restore->buf_sz = 0UL;
+  if( FD_UNLIKELY( sscanf( meta->name, "accounts/%lu.%lu", &slot, &id)!=2 ) )
     return 0;
-  }
 
   /* Lookup account vec file size */
   fd_snapshot_accv_key_t key = { .slot = slot, .id = id };
@@ -355,8 +359,25 @@ fd_snapshot_restore_accv_prepare( fd_snapshot_restore_t * restore,
   } else {
     sz = rec->sz;
   }
-  restore->accv_sz   = sz;
-  restore->accv_slot = slot;
+  *out_slot = slot;
+  *out_sz   = sz;
+  return 1;
+}
+
+/* fd_snapshot_restore_accv_prepare prepares for consumption of an
+   account vec file. */
+
+static int
+fd_snapshot_restore_accv_prepare( fd_snapshot_restore_t * restore,
+                                  fd_tar_meta_t const *   meta,
+                                  ulong                   sz ) {
+
+  if( FD_UNLIKELY( !fd_snapshot_restore_accv_lookup( restore, meta, sz, &restore->accv_slot, &restore->accv_sz ) ) ) {
+    /* ignore if file name invalid */
+    restore->state  = STATE_DONE;
+    restore->buf_sz = 0UL;
+    return 0;
+  }
 
   /* Prepare read of account header */
   restore->state     = STATE_READ_ACCOUNT_HDR;
@@ -593,3 +614,357 @@ fd_snapshot_restore_chunk( void *       restore_,
 fd_tar_read_vtable_t const fd_snapshot_restore_tar_vt =
   { .file = fd_snapshot_restore_file,
     .read = fd_snapshot_restore_chunk };
+
+/* Parallel account vec restore ***************************************/
+
+/* fd_snapshot_restore_par_acc_t is an account found in a buffered
+   account vec.  rec is the funk record that the account gets copied
+   into (NULL if the account was superseded by another account). */
+
+struct fd_snapshot_restore_par_acc {
+  fd_solana_account_hdr_t const * hdr;
+  ulong                           slot;
+  fd_funk_rec_t *                 rec;
+};
+
+typedef struct fd_snapshot_restore_par_acc fd_snapshot_restore_par_acc_t;
+
+/* fd_snapshot_restore_par_job_t holds the parse result of an account
+   vec.  acc points to the accounts found, which are stored in a range
+   of the shared account array reserved for this account vec. */
+
+struct fd_snapshot_restore_par_job {
+  fd_snapshot_restore_accv_t const * accv;
+  fd_snapshot_restore_par_acc_t *    acc;
+  ulong                              acc_cnt;
+  int                                ok;
+};
+
+typedef struct fd_snapshot_restore_par_job fd_snapshot_restore_par_job_t;
+
+/* The below map tracks records created or updated by the current batch.
+   It maps the record address to the index of the account that
+   currently owns the record.  Accounts of the batch only get copied
+   into funk after all records were resolved, so the account metadata
+   in funk cannot be used to dedup accounts within a batch. */
+
+struct fd_snapshot_restore_par_owner {
+  ulong key;      /* fd_funk_rec_t laddr */
+  ulong acc_idx;  /* index into account array */
+};
+
+typedef struct fd_snapshot_restore_par_owner fd_snapshot_restore_par_owner_t;
+
+#define MAP_NAME    fd_snapshot_restore_par_owner
+#define MAP_T       fd_snapshot_restore_par_owner_t
+#define MAP_MEMOIZE 0
+#include "../../util/tmpl/fd_map_dynamic.c"
+
+struct fd_snapshot_restore_par {
+  fd_snapshot_restore_par_job_t * job;
+  ulong                           job_cnt;
+  fd_snapshot_restore_par_acc_t * acc;
+  ulong                           acc_cnt;
+
+  fd_wksp_t *  wksp;
+  fd_alloc_t * alloc;
+  int          ok[ FD_TILE_MAX ];  /* indexed by worker */
+};
+
+typedef struct fd_snapshot_restore_par fd_snapshot_restore_par_t;
+
+/* fd_snapshot_restore_par_parse finds the accounts in an account vec.
+   Follows the same rules as the streaming state machine above (padding
+   is skipped, an incomplete trailing header is ignored).  Returns 1 on
+   success and 0 on failure. */
+
+static int
+fd_snapshot_restore_par_parse( fd_snapshot_restore_par_job_t * job ) {
+
+  uchar const * cur = job->accv->data;
+  ulong         rem = job->accv->sz;
+  ulong         pad = 0UL;
+  char key_cstr[ FD_BASE58_ENCODED_32_SZ ];
+
+  for(;;) {
+    ulong pad_sz = fd_ulong_min( pad, rem );
+    cur += pad_sz;
+    rem -= pad_sz;
+    if( rem < sizeof(fd_solana_account_hdr_t) ) break;  /* end of account vec */
+
+    fd_solana_account_hdr_t const * hdr = fd_type_pun_const( cur );
+    ulong data_len = hdr->meta.data_len;
+    cur += sizeof(fd_solana_account_hdr_t);
+    rem -= sizeof(fd_solana_account_hdr_t);
+
+    if( FD_UNLIKELY( data_len > FD_ACC_SZ_MAX ) ) {
+      FD_LOG_WARNING(( "account %s too large: data_len=%lu",
+                       fd_acct_addr_cstr( key_cstr, hdr->meta.pubkey ), data_len ));
+      FD_LOG_HEXDUMP_WARNING(( "account header", hdr, sizeof(fd_solana_account_hdr_t) ));
+      return 0;
+    }
+    if( FD_UNLIKELY( rem < data_len ) ) {
+      FD_LOG_WARNING(( "account %s data past end of account vec (acc_sz=%lu accv_sz=%lu)",
+                       fd_acct_addr_cstr( key_cstr, hdr->meta.pubkey ), data_len, rem ));
+      FD_LOG_HEXDUMP_WARNING(( "account header", hdr, sizeof(fd_solana_account_hdr_t) ));
+      return 0;
+    }
+
+    job->acc[ job->acc_cnt++ ] = (fd_snapshot_restore_par_acc_t) {
+      .hdr  = hdr,
+      .slot = job->accv->slot,
+      .rec  = NULL
+    };
+
+    cur += data_len;
+    rem -= data_len;
+    pad  = fd_ulong_align_up( data_len, FD_SNAPSHOT_ACC_ALIGN ) - data_len;
+  }
+
+  return 1;
+}
+
+static void
+fd_snapshot_restore_par_parse_task( void * tpool,
+                                    ulong  t0,      ulong t1,
+                                    void * _par,
+                                    void * reduce,  ulong stride,
+                                    ulong  l0,      ulong l1,
+                                    ulong  m0,      ulong m1,
+                                    ulong  n0,      ulong n1 ) {
+  (void)tpool; (void)reduce; (void)stride; (void)l0; (void)l1; (void)m0; (void)m1; (void)n1;
+
+  fd_snapshot_restore_par_t * par   = (fd_snapshot_restore_par_t *)_par;
+  ulong                       w_idx = n0-t0;
+  ulong                       w_cnt = t1-t0;
+
+  /* Account vecs are dealt out round robin as their sizes vary */
+  for( ulong i=w_idx; i<par->job_cnt; i+=w_cnt ) {
+    fd_snapshot_restore_par_job_t * job = &par->job[ i ];
+    job->ok = fd_snapshot_restore_par_parse( job );
+  }
+}
+
+/* fd_snapshot_restore_par_copy_task copies the surviving accounts into
+   the funk records resolved by fd_snapshot_restore_par_resolve.  Each
+   record is owned by at most one account, so workers never write to the
+   same record. */
+
+static void
+fd_snapshot_restore_par_copy_task( void * tpool,
+                                   ulong  t0,      ulong t1,
+                                   void * _par,
+                                   void * reduce,  ulong stride,
+                                   ulong  l0,      ulong l1,
+                                   ulong  m0,      ulong m1,
+                                   ulong  n0,      ulong n1 ) {
+  (void)tpool; (void)reduce; (void)stride; (void)l0; (void)l1; (void)m0; (void)m1; (void)n1;
+
+  fd_snapshot_restore_par_t * par   = (fd_snapshot_restore_par_t *)_par;
+  ulong                       w_idx = n0-t0;
+  fd_wksp_t *                 wksp  = par->wksp;
+  fd_alloc_t *                alloc = fd_alloc_join_cgroup_hint_set( par->alloc, w_idx );
+
+  ulong acc0; ulong acc1;
+  FD_TPOOL_PARTITION( 0UL, par->acc_cnt, 1UL, w_idx, t1-t0, acc0, acc1 );
+
+  for( ulong i=acc0; i<acc1; i++ ) {
+    fd_snapshot_restore_par_acc_t const * acc = &par->acc[ i ];
+    fd_funk_rec_t * rec = acc->rec;
+    if( !rec ) continue;
+
+    fd_solana_account_hdr_t const * hdr      = acc->hdr;
+    ulong                           data_len = hdr->meta.data_len;
+
+    ulong val_sz = sizeof(fd_account_meta_t) + data_len;
+    if( fd_funk_val_sz( rec ) < val_sz ) {
+      int err;
+      if( FD_UNLIKELY( !fd_funk_val_truncate( rec, val_sz, alloc, wksp, &err ) ) ) {
+        FD_LOG_WARNING(( "fd_funk_val_truncate(%lu) failed (%i-%s)", val_sz, err, fd_funk_strerror( err ) ));
+        par->ok[ w_idx ] = 0;
+        return;
+      }
+    }
+
+    fd_account_meta_t * meta = fd_funk_val( rec, wksp );
+    meta->dlen = data_len;
+    meta->slot = acc->slot;
+    memcpy( &meta->hash, hdr->hash.value, 32UL );
+    memcpy( &meta->info, &hdr->info, sizeof(fd_solana_account_meta_t) );
+    fd_memcpy( (uchar *)meta + meta->hlen, hdr+1, data_len );
+  }
+}
+
+/* fd_snapshot_restore_par_resolve picks the funk record of each account
+   in account vec order.  Superseded accounts are dropped.  Compacts the
+   accounts that remain into the front of the account array.  Returns 1
+   on success and 0 on failure. */
+
+static int
+fd_snapshot_restore_par_resolve( fd_snapshot_restore_t *           restore,
+                                 fd_snapshot_restore_par_t *       par,
+                                 fd_snapshot_restore_par_owner_t * owner_map ) {
+
+  fd_acc_mgr_t *  acc_mgr  = restore->slot_ctx->acc_mgr;
+  fd_funk_txn_t * funk_txn = restore->slot_ctx->funk_txn;
+  fd_snapshot_restore_par_acc_t * acc = par->acc;
+  ulong acc_cnt = 0UL;
+
+  for( ulong j=0UL; j<par->job_cnt; j++ ) {
+    fd_snapshot_restore_par_job_t const * job = &par->job[ j ];
+    for( ulong k=0UL; k<job->acc_cnt; k++ ) {
+      fd_snapshot_restore_par_acc_t cur = job->acc[ k ];
+      fd_pubkey_t const * key = fd_type_pun_const( cur.hdr->meta.pubkey );
+
+      fd_funk_rec_t const *     rec_con  = NULL;
+      int                       view_err = FD_ACC_MGR_SUCCESS;
+      fd_account_meta_t const * meta     = fd_acc_mgr_view_raw( acc_mgr, funk_txn, key, &rec_con, &view_err );
+      if( FD_UNLIKELY( view_err==FD_ACC_MGR_ERR_READ_FAILED ) ) {
+        char key_cstr[ FD_BASE58_ENCODED_32_SZ ];
+        FD_LOG_WARNING(( "fd_acc_mgr_view_raw(%s) failed", fd_acct_addr_cstr( key_cstr, key->uc ) ));
+        return 0;
+      }
+
+      /* Record already claimed by an earlier account of this batch */
+      fd_snapshot_restore_par_owner_t * owner =
+          rec_con ? fd_snapshot_restore_par_owner_query( owner_map, (ulong)rec_con, NULL ) : NULL;
+      if( owner ) {
+        fd_snapshot_restore_par_acc_t * prev = &acc[ owner->acc_idx ];
+        if( prev->slot > cur.slot ) continue;  /* is dupe */
+        cur.rec        = prev->rec;
+        prev->rec      = NULL;
+        owner->acc_idx = acc_cnt;
+        acc[ acc_cnt++ ] = cur;
+        continue;
+      }
+
+      if( meta && meta->slot > cur.slot ) continue;  /* is dupe */
+
+      int err = FD_ACC_MGR_SUCCESS;
+      if( FD_UNLIKELY( !fd_acc_mgr_modify_raw( acc_mgr, funk_txn, key, /* do_create */ 1, 0UL, rec_con, &cur.rec, &err ) ) ) {
+        char key_cstr[ FD_BASE58_ENCODED_32_SZ ];
+        FD_LOG_WARNING(( "fd_acc_mgr_modify_raw(%s) failed (%d)", fd_acct_addr_cstr( key_cstr, key->uc ), err ));
+        return 0;
+      }
+      owner = fd_snapshot_restore_par_owner_insert( owner_map, (ulong)cur.rec );
+      if( FD_UNLIKELY( !owner ) ) FD_LOG_CRIT(( "owner map full" ));  /* unreachable */
+      owner->acc_idx = acc_cnt;
+      acc[ acc_cnt++ ] = cur;
+    }
+  }
+
+  par->acc_cnt = acc_cnt;
+  return 1;
+}
+
+int
+fd_snapshot_restore_accv_init( fd_snapshot_restore_t *      restore,
+                               fd_snapshot_restore_accv_t * accv,
+                               fd_tar_meta_t const *        meta,
+                               ulong                        sz ) {
+
+  if( (sz==0UL) | (!fd_tar_meta_is_reg( meta )) ) return 0;
+  if( 0!=strncmp( meta->name, "accounts/", sizeof("accounts/")-1 ) ) return 0;
+  if( FD_UNLIKELY( !restore->manifest_done ) ) {
+    FD_LOG_WARNING(( "Unsupported snapshot: encountered AppendVec before manifest" ));
+    return -1;
+  }
+
+  ulong slot, accv_sz;
+  if( FD_UNLIKELY( !fd_snapshot_restore_accv_lookup( restore, meta, sz, &slot, &accv_sz ) ) )
+    return 0;  /* handled by the streaming path */
+
+  accv->slot = slot;
+  accv->sz   = fd_ulong_min( accv_sz, sz );
+  accv->data = NULL;
+  return 1;
+}
+
+int
+fd_snapshot_restore_accv_par( fd_snapshot_restore_t *            restore,
+                              fd_snapshot_restore_accv_t const * accv,
+                              ulong                              accv_cnt,
+                              fd_valloc_t                        valloc,
+                              fd_tpool_t *                       tpool,
+                              ulong                              t0,
+                              ulong                              t1 ) {
+
+  ulong w_cnt = 1UL;
+  if( tpool ) {
+    if( FD_UNLIKELY( (t0>=t1) | (t1>fd_tpool_worker_cnt( tpool )) ) ) {
+      FD_LOG_WARNING(( "bad thread range [%lu,%lu)", t0, t1 ));
+      return -1;
+    }
+    w_cnt = t1-t0;
+  }
+  if( !accv_cnt ) return 0;
+
+  /* Reserve room for the max number of accounts of each account vec */
+
+  ulong acc_max = 0UL;
+  for( ulong j=0UL; j<accv_cnt; j++ ) acc_max += accv[ j ].sz / sizeof(fd_solana_account_hdr_t);
+
+  fd_snapshot_restore_par_t par[1];
+  fd_memset( par, 0, sizeof(fd_snapshot_restore_par_t) );
+  fd_funk_t * funk = restore->slot_ctx->acc_mgr->funk;
+  par->wksp    = fd_funk_wksp( funk );
+  par->alloc   = fd_funk_alloc( funk, par->wksp );
+  par->job_cnt = accv_cnt;
+  par->job     = fd_valloc_malloc( valloc, alignof(fd_snapshot_restore_par_job_t), accv_cnt*sizeof(fd_snapshot_restore_par_job_t) );
+  par->acc     = fd_valloc_malloc( valloc, alignof(fd_snapshot_restore_par_acc_t), fd_ulong_max( acc_max, 1UL )*sizeof(fd_snapshot_restore_par_acc_t) );
+  if( FD_UNLIKELY( (!par->job) | (!par->acc) ) ) {
+    FD_LOG_WARNING(( "failed to allocate restore state for %lu account vecs", accv_cnt ));
+    if( par->job ) fd_valloc_free( valloc, par->job );
+    if( par->acc ) fd_valloc_free( valloc, par->acc );
+    return -1;
+  }
+
+  ulong acc_off = 0UL;
+  for( ulong j=0UL; j<accv_cnt; j++ ) {
+    par->job[ j ] = (fd_snapshot_restore_par_job_t) { .accv = &accv[ j ], .acc = par->acc + acc_off };
+    acc_off += accv[ j ].sz / sizeof(fd_solana_account_hdr_t);
+  }
+
+  /* Parse account vecs */
+
+  if( w_cnt>1UL ) fd_tpool_exec_all_raw( tpool, t0, t1, fd_snapshot_restore_par_parse_task, tpool, par, NULL, 0UL, 0UL, 0UL );
+  else            fd_snapshot_restore_par_parse_task( tpool, 0UL, 1UL, par, NULL, 0UL, 0UL, 0UL, 0UL, 0UL, 0UL, 1UL );
+
+  int ok = 1;
+  ulong acc_cnt = 0UL;
+  for( ulong j=0UL; j<accv_cnt; j++ ) {
+    ok &= par->job[ j ].ok;
+    acc_cnt += par->job[ j ].acc_cnt;
+  }
+
+  /* Resolve funk records */
+
+  void * owner_mem = NULL;
+  if( FD_LIKELY( ok ) ) {
+    int lg_slot_cnt = fd_ulong_find_msb( fd_ulong_pow2_up( fd_ulong_max( 2UL*acc_cnt, 2UL ) ) );
+    owner_mem = fd_valloc_malloc( valloc, fd_snapshot_restore_par_owner_align(), fd_snapshot_restore_par_owner_footprint( lg_slot_cnt ) );
+    if( FD_UNLIKELY( !owner_mem ) ) {
+      FD_LOG_WARNING(( "failed to allocate owner map for %lu accounts", acc_cnt ));
+      ok = 0;
+    } else {
+      fd_snapshot_restore_par_owner_t * owner_map =
+          fd_snapshot_restore_par_owner_join( fd_snapshot_restore_par_owner_new( owner_mem, lg_slot_cnt ) );
+      ok = fd_snapshot_restore_par_resolve( restore, par, owner_map );
+      fd_snapshot_restore_par_owner_delete( fd_snapshot_restore_par_owner_leave( owner_map ) );
+    }
+  }
+
+  /* Copy account data */
+
+  if( FD_LIKELY( ok ) ) {
+    for( ulong j=0UL; j<w_cnt; j++ ) par->ok[ j ] = 1;
+    if( w_cnt>1UL ) fd_tpool_exec_all_raw( tpool, t0, t1, fd_snapshot_restore_par_copy_task, tpool, par, NULL, 0UL, 0UL, 0UL );
+    else            fd_snapshot_restore_par_copy_task( tpool, 0UL, 1UL, par, NULL, 0UL, 0UL, 0UL, 0UL, 0UL, 0UL, 1UL );
+    for( ulong j=0UL; j<w_cnt; j++ ) ok &= par->ok[ j ];
+  }
+
+  if( owner_mem ) fd_valloc_free( valloc, owner_mem );
+  fd_valloc_free( valloc, par->acc );
+  fd_valloc_free( valloc, par->job );
+  return ok ? 0 : -1;
+}
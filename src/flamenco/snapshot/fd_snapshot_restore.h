@@ -9,10 +9,23 @@
 #include "fd_snapshot_base.h"
 #include "../../util/archive/fd_tar.h"
 #include "../runtime/context/fd_exec_slot_ctx.h"
+#include "../../util/tpool/fd_tpool.h"
 
 struct fd_snapshot_restore;
 typedef struct fd_snapshot_restore fd_snapshot_restore_t;
 
+/* fd_snapshot_restore_accv_t describes an account vec file that was
+   entirely read into memory.  Used to restore many account vecs at
+   once (see fd_snapshot_restore_accv_par). */
+
+struct fd_snapshot_restore_accv {
+  ulong         slot;  /* slot number of the account vec */
+  ulong         sz;    /* number of bytes containing accounts */
+  uchar const * data;  /* points to first byte of file content */
+};
+
+typedef struct fd_snapshot_restore_accv fd_snapshot_restore_accv_t;
+
 /* fd_snapshot_restore_cb_manifest_fn_t is a callback that provides the
    user of snapshot restore with the deserialized manifest.  The
    manifest is borrowed to the callee until it returns.  ctx is the
@@ -86,6 +99,49 @@ fd_snapshot_restore_chunk( void *       restore,
                            void const * buf,
                            ulong        bufsz );
 
+/* fd_snapshot_restore_accv_init checks whether the file with TAR
+   header meta and size sz is an account vec.  If so, populates accv
+   slot and sz (data is left to the caller) and returns 1.  The caller
+   should then buffer the file content and restore it via
+   fd_snapshot_restore_accv_par instead of fd_snapshot_restore_chunk.
+   Returns 0 if the file is not an account vec (the caller should
+   forward it to fd_snapshot_restore_file and fd_snapshot_restore_chunk
+   as usual).  Returns -1 on failure (account vec before the manifest),
+   logs reason for failure. */
+
+int
+fd_snapshot_restore_accv_init( fd_snapshot_restore_t *      restore,
+                               fd_snapshot_restore_accv_t * accv,
+                               fd_tar_meta_t const *        meta,
+                               ulong                        sz );
+
+/* fd_snapshot_restore_accv_par restores the accounts of accv_cnt
+   buffered account vecs accv[i] into funk.  The result is the same as
+   streaming the account vecs in order through fd_snapshot_restore_chunk
+   (an account is only overwritten by an account from the same or a
+   newer slot).
+
+   Account vecs are parsed and account data is copied in parallel over
+   tpool threads [t0,t1).  Records are created serially in between, as
+   the funk record map does not support concurrent inserts.  The caller
+   should be thread t0 and threads (t0,t1) should be available.  If
+   tpool is NULL, runs on the caller alone.  valloc is used for
+   temporary memory (~40 bytes per account).  The funk alloc of slot_ctx
+   is used concurrently.
+
+   Returns 0 on success and -1 on failure.  Logs reason for failure.
+   Reasons for failure include bad thread range, out of memory and
+   malformed account vecs. */
+
+int
+fd_snapshot_restore_accv_par( fd_snapshot_restore_t *            restore,
+                              fd_snapshot_restore_accv_t const * accv,
+                              ulong                              accv_cnt,
+                              fd_valloc_t                        valloc,
+                              fd_tpool_t *                       tpool,
+                              ulong                              t0,
+                              ulong                              t1 );
+
 /* fd_snapshot_restore is a convenience wrapper.  Returns 1 on success,
    and 0 on failure.  Logs reason for failure.  slot_ctx is the context
    into which snapshot should be restored.  path is file path of
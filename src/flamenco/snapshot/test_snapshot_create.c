@@ -0,0 +1,372 @@
+#include "fd_snapshot_create.h"
+#include "fd_snapshot_load_par.h"
+#include "../runtime/fd_acc_mgr.h"
+#include "../runtime/context/fd_exec_epoch_ctx.h"
+#include "../../funk/fd_funk_cold.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* test_snapshot_create creates snapshots from a funk with accounts
+   spread over published, cold and in-preparation records, loads them
+   back with fd_snapshot_load_par and checks that the accounts and the
+   bank state that fd_snapshot_create serializes survive the round
+   trip. */
+
+#define ACC_CNT    (3000UL)
+#define SLOT       (1234UL)
+#define BLOCK_H    (1000UL)
+#define RESTART    (1200UL)
+#define RECENT_CNT ( 320UL)  /* more than the blockhash queue holds */
+
+FD_STATIC_ASSERT( RECENT_CNT>FD_SNAPSHOT_CREATE_BLOCKHASH_MAX_AGE+1UL, recent_cnt );
+
+static uchar tpool_mem[ FD_TPOOL_FOOTPRINT(FD_TILE_MAX) ] __attribute__((aligned(FD_TPOOL_ALIGN)));
+
+/* exp_{lamports,dlen} are the expected accounts visible from the
+   snapshot (exp_lamports 0 means not in the snapshot). */
+
+static ulong exp_lamports[ ACC_CNT ];
+static ulong exp_dlen    [ ACC_CNT ];
+
+static fd_pubkey_t
+acc_key( ulong i ) {
+  fd_pubkey_t key = {0};
+  key.ul[0] = i;
+  key.ul[1] = 0x5eedUL;
+  return key;
+}
+
+static fd_hash_t
+test_hash( ulong i ) {
+  fd_hash_t hash;
+  for( ulong j=0UL; j<sizeof(fd_hash_t); j++ ) hash.uc[j] = (uchar)(i+j);
+  return hash;
+}
+
+static void
+acc_put( fd_funk_t *     funk,
+         fd_funk_txn_t * txn,
+         ulong           i,
+         ulong           lamports,
+         ulong           dlen ) {
+  fd_wksp_t *       wksp = fd_funk_wksp( funk );
+  fd_pubkey_t       pk   = acc_key( i );
+  fd_funk_rec_key_t key  = fd_acc_funk_key( &pk );
+
+  fd_funk_rec_t * rec = fd_funk_rec_write_prepare( funk, txn, &key, sizeof(fd_account_meta_t)+dlen, 1, NULL, NULL );
+  FD_TEST( rec );
+  rec = fd_funk_val_truncate( rec, sizeof(fd_account_meta_t)+dlen, fd_funk_alloc( funk, wksp ), wksp, NULL );
+  FD_TEST( rec );
+
+  fd_account_meta_t * meta = fd_funk_val( rec, wksp );
+  fd_account_meta_init( meta );
+  meta->dlen            = dlen;
+  meta->info.lamports   = lamports;
+  meta->info.rent_epoch = i;
+  meta->hash[0]         = (uchar)i;
+  uchar * data = (uchar *)meta + meta->hlen;
+  for( ulong j=0UL; j<dlen; j++ ) data[j] = (uchar)(i+j);
+
+  exp_lamports[ i ] = lamports;
+  exp_dlen    [ i ] = dlen;
+}
+
+static void
+acc_erase( fd_funk_t *     funk,
+           fd_funk_txn_t * txn,
+           ulong           i ) {
+  fd_pubkey_t       pk  = acc_key( i );
+  fd_funk_rec_key_t key = fd_acc_funk_key( &pk );
+
+  fd_funk_rec_t * rec = fd_funk_rec_write_prepare( funk, txn, &key, 0UL, 0, NULL, NULL );
+  FD_TEST( rec );
+  FD_TEST( !fd_funk_rec_remove( funk, rec, 1 ) );
+
+  exp_lamports[ i ] = 0UL;
+}
+
+static ulong
+cold_cnt( fd_funk_t * funk ) {
+  fd_wksp_t *     wksp    = fd_funk_wksp( funk );
+  fd_funk_rec_t * rec_map = fd_funk_rec_map( funk, wksp );
+  ulong cnt = 0UL;
+  for( fd_funk_rec_map_iter_t iter = fd_funk_rec_map_iter_init( rec_map );
+       !fd_funk_rec_map_iter_done( rec_map, iter );
+       iter = fd_funk_rec_map_iter_next( rec_map, iter ) ) {
+    cnt += (ulong)fd_funk_rec_is_cold( fd_funk_rec_map_iter_ele( rec_map, iter ) );
+  }
+  return cnt;
+}
+
+/* test_on_manifest checks the bank state that fd_snapshot_create
+   serializes before it gets recovered into the slot context. */
+
+static ulong manifest_cnt;
+
+static void
+test_on_manifest( void *                 ctx,
+                  fd_solana_manifest_t * manifest ) {
+  (void)ctx;
+  fd_deserializable_versioned_bank_t const * bank = &manifest->bank;
+  FD_TEST( bank->slot==SLOT );
+  FD_TEST( bank->block_height==BLOCK_H );
+
+  fd_block_hash_queue_t const * bhq = &bank->blockhash_queue;
+  fd_hash_t poh = test_hash( 0x80UL );
+  FD_TEST( bhq->last_hash && !memcmp( bhq->last_hash, &poh, sizeof(fd_hash_t) ) );
+  FD_TEST( bhq->last_hash_index==BLOCK_H );
+  FD_TEST( bhq->max_age==FD_SNAPSHOT_CREATE_BLOCKHASH_MAX_AGE );
+  FD_TEST( bhq->ages_len==FD_SNAPSHOT_CREATE_BLOCKHASH_MAX_AGE+1UL );
+  for( ulong i=0UL; i<bhq->ages_len; i++ ) {
+    fd_hash_t hash = test_hash( i );
+    FD_TEST( !memcmp( &bhq->ages[i].key, &hash, sizeof(fd_hash_t) ) );
+    FD_TEST( bhq->ages[i].val.hash_index==BLOCK_H-i );
+    FD_TEST( bhq->ages[i].val.fee_calculator.lamports_per_signature==5000UL );
+  }
+
+  FD_TEST( bank->hard_forks.hard_forks_len==1UL );
+  FD_TEST( bank->hard_forks.hard_forks[0].slot==RESTART );
+  FD_TEST( bank->hard_forks.hard_forks[0].val ==1UL     );
+
+  FD_TEST( bank->ancestors_len==1UL );
+  FD_TEST( bank->ancestors[0].slot==SLOT );
+
+  FD_TEST( manifest->accounts_db.slot==SLOT );
+  FD_TEST( manifest->accounts_db.storages_len==1UL );
+  FD_TEST( manifest->accounts_db.storages[0].slot==SLOT );
+  FD_TEST( manifest->accounts_db.storages[0].account_vecs_len>1UL );
+
+  manifest_cnt++;
+}
+
+/* test_load loads the snapshot at path into a fresh funk and slot
+   context using tpool threads [t0,t1) and checks the result. */
+
+static void
+test_load( fd_wksp_t *           wksp,
+           fd_valloc_t           valloc,
+           char const *          path,
+           fd_exec_epoch_ctx_t * epoch_ctx,
+           fd_tpool_t *          tpool,
+           ulong                 t0,
+           ulong                 t1 ) {
+
+  ulong tag = 2UL;
+  fd_funk_t * funk = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), tag ),
+                                                tag, 9UL, 16UL, 2UL*ACC_CNT ) );
+  FD_TEST( funk );
+
+  fd_acc_mgr_t * acc_mgr = fd_acc_mgr_new( fd_wksp_alloc_laddr( wksp, FD_ACC_MGR_ALIGN, FD_ACC_MGR_FOOTPRINT, tag ), funk );
+  FD_TEST( acc_mgr );
+
+  fd_exec_slot_ctx_t * slot_ctx = fd_exec_slot_ctx_join( fd_exec_slot_ctx_new(
+      fd_wksp_alloc_laddr( wksp, FD_EXEC_SLOT_CTX_ALIGN, FD_EXEC_SLOT_CTX_FOOTPRINT, tag ) ) );
+  FD_TEST( slot_ctx );
+  slot_ctx->valloc    = valloc;
+  slot_ctx->acc_mgr   = acc_mgr;
+  slot_ctx->epoch_ctx = epoch_ctx;
+
+  ulong   manifest_max = 1UL<<24;
+  uchar * manifest_buf = fd_wksp_alloc_laddr( wksp, 1UL, manifest_max, tag );
+  fd_snapshot_restore_t * restore = fd_snapshot_restore_new(
+      fd_wksp_alloc_laddr( wksp, fd_snapshot_restore_align(), fd_snapshot_restore_footprint(), tag ),
+      slot_ctx, manifest_buf, manifest_max );
+  FD_TEST( restore );
+  fd_snapshot_restore_set_cb_manifest( restore, test_on_manifest, NULL );
+
+  ulong worker_cnt = tpool ? t1-t0 : 1UL;
+  ulong window_sz  = 1UL<<23;
+  void * load_mem  = fd_wksp_alloc_laddr( wksp, fd_snapshot_load_par_align(), fd_snapshot_load_par_footprint( worker_cnt, window_sz ), tag );
+  fd_snapshot_load_par_t * load = fd_snapshot_load_par_new( load_mem, worker_cnt, window_sz, 1UL<<20, valloc );
+  FD_TEST( load );
+
+  int fd = open( path, O_RDONLY );
+  FD_TEST( fd>=0 );
+  ulong manifest_cnt0 = manifest_cnt;
+  FD_TEST( fd_snapshot_load_par( load, restore, fd, tpool, t0, t1 ) );
+  FD_TEST( !close( fd ) );
+  FD_TEST( manifest_cnt==manifest_cnt0+1UL );
+
+  /* Recovered bank */
+
+  fd_hash_t poh = test_hash( 0x80UL );
+  FD_TEST( slot_ctx->slot_bank.slot==SLOT );
+  FD_TEST( slot_ctx->slot_bank.block_height==BLOCK_H );
+  FD_TEST( slot_ctx->slot_bank.last_restart_slot.slot==RESTART );
+  FD_TEST( !memcmp( &slot_ctx->slot_bank.poh, &poh, sizeof(fd_hash_t) ) );
+
+  /* Accounts */
+
+  ulong acc_cnt = 0UL;
+  for( ulong i=0UL; i<ACC_CNT; i++ ) {
+    fd_pubkey_t           pk  = acc_key( i );
+    fd_funk_rec_t const * rec = NULL;
+    fd_account_meta_t const * meta = fd_acc_mgr_view_raw( acc_mgr, NULL, &pk, &rec, NULL );
+    if( !exp_lamports[ i ] ) { FD_TEST( !meta ); continue; }
+    FD_TEST( meta );
+    FD_TEST( meta->info.lamports  ==exp_lamports[ i ] );
+    FD_TEST( meta->dlen           ==exp_dlen    [ i ] );
+    FD_TEST( meta->info.rent_epoch==i         );
+    FD_TEST( meta->hash[0]        ==(uchar)i  );
+    FD_TEST( meta->slot           ==SLOT      );
+    uchar const * data = (uchar const *)meta + meta->hlen;
+    for( ulong j=0UL; j<exp_dlen[ i ]; j++ ) FD_TEST( data[j]==(uchar)(i+j) );
+    acc_cnt++;
+  }
+  FD_TEST( fd_funk_rec_cnt( fd_funk_rec_map( funk, wksp ) )==acc_cnt );
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  fd_wksp_free_laddr( fd_snapshot_load_par_delete( load ) );
+  fd_wksp_free_laddr( fd_snapshot_restore_delete( restore ) );
+  fd_wksp_free_laddr( manifest_buf );
+  fd_wksp_free_laddr( fd_exec_slot_ctx_delete( fd_exec_slot_ctx_leave( slot_ctx ) ) );
+  fd_wksp_free_laddr( fd_acc_mgr_delete( acc_mgr ) );
+  fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( funk ) ) );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL, "gigantic"                   );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL, 1UL                          );
+  ulong        near_cpu = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu", NULL, fd_log_cpu_id()             );
+
+  FD_LOG_NOTICE(( "Testing with --page-sz %s --page-cnt %lu --near-cpu %lu", _page_sz, page_cnt, near_cpu ));
+
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  if( FD_UNLIKELY( !wksp ) ) FD_LOG_ERR(( "Unable to attach to wksp" ));
+
+  fd_alloc_t * alloc = fd_alloc_join( fd_alloc_new( fd_wksp_alloc_laddr( wksp, fd_alloc_align(), fd_alloc_footprint(), 1UL ), 1UL ), 0UL );
+  FD_TEST( alloc );
+  fd_valloc_t valloc = fd_alloc_virtual( alloc );
+
+  ulong        tile_cnt = fd_ulong_min( fd_tile_cnt(), 4UL );
+  fd_tpool_t * tpool    = NULL;
+  if( tile_cnt>1UL ) {
+    tpool = fd_tpool_init( tpool_mem, tile_cnt );
+    FD_TEST( tpool );
+    for( ulong t=1UL; t<tile_cnt; t++ ) FD_TEST( fd_tpool_worker_push( tpool, t, NULL, 0UL ) );
+  }
+
+  ulong tag = 1UL;
+  fd_funk_t * funk = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), tag ),
+                                                tag, 7UL, 16UL, 4UL*ACC_CNT ) );
+  FD_TEST( funk );
+
+  char cold_path[] = "/tmp/test_snapshot_create.XXXXXX";
+  int cold_fd = mkstemp( cold_path );
+  if( FD_UNLIKELY( cold_fd<0 ) ) FD_LOG_ERR(( "mkstemp failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  FD_TEST( !unlink( cold_path ) );
+  FD_TEST( fd_funk_cold_attach( funk, cold_fd )==FD_FUNK_SUCCESS );
+
+  /* Publish all accounts and evict half of them to the cold file.  Then
+     modify, zero out and erase some in a chain of in-preparation
+     transactions. */
+
+  fd_funk_txn_xid_t xid = { .ul = { 1UL } };
+  fd_funk_txn_t * txn = fd_funk_txn_prepare( funk, NULL, &xid, 1 );
+  FD_TEST( txn );
+  for( ulong i=0UL; i<ACC_CNT; i++ ) acc_put( funk, txn, i, 1000UL+i, (i*37UL)%700UL );
+  FD_TEST( fd_funk_txn_publish( funk, txn, 1 )==1UL );
+
+  int err;
+  FD_TEST( fd_funk_cold_evict( funk, 1UL, 0UL, ACC_CNT/2UL, &err )==ACC_CNT/2UL );
+  FD_TEST( err==FD_FUNK_SUCCESS );
+
+  xid.ul[0] = 2UL;
+  fd_funk_txn_t * parent = fd_funk_txn_prepare( funk, NULL, &xid, 1 );
+  FD_TEST( parent );
+  for( ulong i=0UL; i<ACC_CNT; i+=7UL ) acc_put( funk, parent, i, 5000UL+i, (i*11UL)%300UL );
+  xid.ul[0] = 3UL;
+  txn = fd_funk_txn_prepare( funk, parent, &xid, 1 );
+  FD_TEST( txn );
+  for( ulong i=0UL; i<ACC_CNT; i+=13UL ) acc_put( funk, txn, i, 9000UL+i, (i*5UL)%900UL );
+  for( ulong i=1UL; i<ACC_CNT; i+=17UL ) acc_put( funk, txn, i, 0UL, 0UL );
+  for( ulong i=2UL; i<ACC_CNT; i+=19UL ) acc_erase( funk, txn, i );
+
+  /* Writing an account in a transaction loads its cold value, the
+     rest stay cold */
+
+  ulong cold_cnt0 = cold_cnt( funk );
+  FD_TEST( cold_cnt0>0UL && cold_cnt0<ACC_CNT/2UL );
+
+  /* Bank state */
+
+  fd_acc_mgr_t * acc_mgr = fd_acc_mgr_new( fd_wksp_alloc_laddr( wksp, FD_ACC_MGR_ALIGN, FD_ACC_MGR_FOOTPRINT, tag ), funk );
+  FD_TEST( acc_mgr );
+
+  fd_exec_epoch_ctx_t * epoch_ctx = fd_exec_epoch_ctx_join( fd_exec_epoch_ctx_new(
+      fd_wksp_alloc_laddr( wksp, FD_EXEC_EPOCH_CTX_ALIGN, FD_EXEC_EPOCH_CTX_FOOTPRINT, tag ) ) );
+  FD_TEST( epoch_ctx );
+  epoch_ctx->valloc = valloc;
+  epoch_ctx->epoch_bank.epoch_schedule.slots_per_epoch             = 432000UL;
+  epoch_ctx->epoch_bank.epoch_schedule.leader_schedule_slot_offset = 432000UL;
+
+  fd_exec_slot_ctx_t * slot_ctx = fd_exec_slot_ctx_join( fd_exec_slot_ctx_new(
+      fd_wksp_alloc_laddr( wksp, FD_EXEC_SLOT_CTX_ALIGN, FD_EXEC_SLOT_CTX_FOOTPRINT, tag ) ) );
+  FD_TEST( slot_ctx );
+  slot_ctx->valloc    = valloc;
+  slot_ctx->acc_mgr   = acc_mgr;
+  slot_ctx->epoch_ctx = epoch_ctx;
+  slot_ctx->funk_txn  = txn;
+
+  fd_slot_bank_t * slot_bank = &slot_ctx->slot_bank;
+  slot_bank->slot                   = SLOT;
+  slot_bank->block_height           = BLOCK_H;
+  slot_bank->last_restart_slot.slot = RESTART;
+  slot_bank->poh                    = test_hash( 0x80UL );
+
+  /* Newest blockhash first */
+  slot_bank->recent_block_hashes.hashes = deq_fd_block_block_hash_entry_t_alloc( valloc );
+  FD_TEST( slot_bank->recent_block_hashes.hashes );
+  for( ulong i=0UL; i<RECENT_CNT; i++ ) {
+    fd_block_block_hash_entry_t entry = { .blockhash = test_hash( i ), .fee_calculator = { .lamports_per_signature = 5000UL } };
+    deq_fd_block_block_hash_entry_t_push_tail( slot_bank->recent_block_hashes.hashes, entry );
+  }
+
+  /* Create and load back serially, then in parallel */
+
+  char dir[] = "/tmp/test_snapshot_create.XXXXXX";
+  FD_TEST( mkdtemp( dir ) );
+  char path[ PATH_MAX ];
+  FD_TEST( fd_cstr_printf( path, sizeof(path), NULL, "%s/snapshot.tar.zst", dir ) );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  ulong  bufsz      = 1UL<<16;
+  ulong  batch_max  = 100UL;
+  ulong  create_fp  = fd_snapshot_create_footprint( tile_cnt, 3, bufsz, 4UL*ACC_CNT, batch_max );
+  FD_TEST( create_fp );
+  void * create_mem = fd_wksp_alloc_laddr( wksp, fd_snapshot_create_align(), create_fp, tag );
+  fd_snapshot_create_t * create = fd_snapshot_create_new( create_mem, slot_ctx, path, tile_cnt, 3, bufsz, 4UL*ACC_CNT, batch_max, 1UL<<16, rng );
+  FD_TEST( create );
+
+  FD_TEST( fd_snapshot_create( create, slot_ctx, NULL, 0UL, 0UL ) );
+  FD_TEST( cold_cnt( funk )==cold_cnt0 );
+  test_load( wksp, valloc, path, epoch_ctx, NULL, 0UL, 0UL );
+
+  if( tpool ) {
+    FD_TEST( fd_snapshot_create( create, slot_ctx, tpool, 0UL, tile_cnt ) );
+    FD_TEST( cold_cnt( funk )==cold_cnt0 );
+    test_load( wksp, valloc, path, epoch_ctx, tpool, 0UL, tile_cnt );
+  }
+
+  FD_TEST( fd_snapshot_create_delete( create )==create_mem );
+  FD_TEST( !unlink( path ) );
+  FD_TEST( !rmdir( dir ) );
+
+  FD_TEST( fd_funk_cold_detach( funk )==cold_fd );
+  FD_TEST( !close( cold_fd ) );
+
+  if( tpool ) fd_tpool_fini( tpool );
+  fd_wksp_delete_anonymous( wksp );
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
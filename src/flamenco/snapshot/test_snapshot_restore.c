@@ -0,0 +1,361 @@
+#include "fd_snapshot_restore.h"
+#include "../runtime/fd_acc_mgr.h"
+#include "../runtime/context/fd_exec_epoch_ctx.h"
+
+#include <stdio.h>
+
+/* test_snapshot_restore restores the same account vecs with the
+   streaming state machine (fd_snapshot_restore_chunk) and with
+   fd_snapshot_restore_accv_par, serially and in parallel, and checks
+   that all of them result in the same funk state.  The account vecs
+   contain duplicate accounts within an account vec and across slots,
+   in which case the account of the newest slot wins (the last one if
+   several accounts of that slot match). */
+
+#define KEY_CNT  (256UL)
+#define ACCV_CNT ( 24UL)
+#define ACCV_MAX (1UL<<15)
+#define SLOT_MIN ( 10UL)
+#define SLOT_CNT (  8UL)
+
+static uchar tpool_mem[ FD_TPOOL_FOOTPRINT(FD_TILE_MAX) ] __attribute__((aligned(FD_TPOOL_ALIGN)));
+
+static uchar                      accv_mem[ ACCV_CNT ][ ACCV_MAX ] __attribute__((aligned(8)));
+static fd_snapshot_restore_accv_t accv    [ ACCV_CNT ];
+static fd_snapshot_acc_vec_t      accv_id [ ACCV_CNT ];
+
+/* exp_hdr[k] is the account header that should end up in funk for
+   key k and exp_slot[k] its slot (NULL if the key does not occur). */
+
+static fd_solana_account_hdr_t const * exp_hdr [ KEY_CNT ];
+static ulong                           exp_slot[ KEY_CNT ];
+
+/* stale_cnt is the number of accounts superseded by an account of a
+   newer slot that comes earlier */
+
+static ulong stale_cnt;
+
+static fd_pubkey_t
+test_key( ulong k ) {
+  fd_pubkey_t key = {0};
+  key.ul[0] = k;
+  key.ul[3] = 0x5eedUL;
+  return key;
+}
+
+/* accv_gen fills the account vecs with random accounts and updates the
+   expected result as the streaming path would. */
+
+static void
+accv_gen( fd_rng_t * rng ) {
+  for( ulong j=0UL; j<ACCV_CNT; j++ ) {
+    ulong   slot = SLOT_MIN + fd_rng_ulong_roll( rng, SLOT_CNT );
+    uchar * cur  = accv_mem[ j ];
+    ulong   cnt  = 20UL + fd_rng_ulong_roll( rng, 40UL );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      ulong k        = fd_rng_ulong_roll( rng, KEY_CNT );
+      ulong data_len = fd_rng_ulong_roll( rng, 300UL );
+
+      fd_solana_account_hdr_t * hdr = (fd_solana_account_hdr_t *)cur;
+      fd_memset( hdr, 0, sizeof(fd_solana_account_hdr_t) );
+      fd_pubkey_t key = test_key( k );
+      hdr->meta.write_version_obsolete = fd_rng_ulong( rng );
+      hdr->meta.data_len               = data_len;
+      memcpy( hdr->meta.pubkey, key.uc, sizeof(fd_pubkey_t) );
+      hdr->info.lamports               = fd_rng_ulong( rng );
+      hdr->info.rent_epoch             = fd_rng_ulong( rng );
+      hdr->info.executable             = (char)fd_rng_uint_roll( rng, 2U );
+      for( ulong b=0UL; b<32UL; b++ ) hdr->info.owner [b] = fd_rng_uchar( rng );
+      for( ulong b=0UL; b<32UL; b++ ) hdr->hash.value[b] = fd_rng_uchar( rng );
+
+      uchar * data = (uchar *)( hdr+1 );
+      for( ulong b=0UL; b<data_len; b++ ) data[b] = fd_rng_uchar( rng );
+
+      cur = data + fd_ulong_align_up( data_len, FD_SNAPSHOT_ACC_ALIGN );
+      FD_TEST( cur<=accv_mem[ j ]+ACCV_MAX );
+
+      if( !exp_hdr[ k ] || slot>=exp_slot[ k ] ) {
+        exp_hdr [ k ] = hdr;
+        exp_slot[ k ] = slot;
+      } else {
+        stale_cnt++;
+      }
+    }
+
+    accv   [ j ] = (fd_snapshot_restore_accv_t){ .slot = slot, .sz = (ulong)( cur-accv_mem[ j ] ), .data = accv_mem[ j ] };
+    accv_id[ j ] = (fd_snapshot_acc_vec_t){ .id = j, .file_sz = accv[ j ].sz };
+  }
+}
+
+/* test_env_t is a fresh funk and slot context to restore into.  The
+   restore object is placed into restore_mem, which is allocated once
+   up front as it is large (holds the account vec index). */
+
+struct test_env {
+  fd_funk_t *             funk;
+  fd_acc_mgr_t *          acc_mgr;
+  fd_exec_slot_ctx_t *    slot_ctx;
+  uchar *                 manifest_buf;
+  fd_snapshot_restore_t * restore;
+};
+
+typedef struct test_env test_env_t;
+
+#define MANIFEST_MAX (1UL<<16)
+
+static test_env_t *
+test_env_new( test_env_t *          env,
+              fd_wksp_t *           wksp,
+              fd_valloc_t           valloc,
+              fd_exec_epoch_ctx_t * epoch_ctx,
+              void *                restore_mem,
+              ulong                 tag ) {
+  env->funk = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), tag ),
+                                         tag, tag, 4UL, 2UL*KEY_CNT ) );
+  FD_TEST( env->funk );
+  env->acc_mgr = fd_acc_mgr_new( fd_wksp_alloc_laddr( wksp, FD_ACC_MGR_ALIGN, FD_ACC_MGR_FOOTPRINT, tag ), env->funk );
+  FD_TEST( env->acc_mgr );
+  env->slot_ctx = fd_exec_slot_ctx_join( fd_exec_slot_ctx_new(
+      fd_wksp_alloc_laddr( wksp, FD_EXEC_SLOT_CTX_ALIGN, FD_EXEC_SLOT_CTX_FOOTPRINT, tag ) ) );
+  FD_TEST( env->slot_ctx );
+  env->slot_ctx->valloc    = valloc;
+  env->slot_ctx->acc_mgr   = env->acc_mgr;
+  env->slot_ctx->epoch_ctx = epoch_ctx;
+  env->manifest_buf = fd_wksp_alloc_laddr( wksp, 1UL, MANIFEST_MAX, tag );
+  FD_TEST( env->manifest_buf );
+  env->restore = fd_snapshot_restore_new( restore_mem, env->slot_ctx, env->manifest_buf, MANIFEST_MAX );
+  FD_TEST( env->restore );
+  return env;
+}
+
+static void
+test_env_delete( test_env_t * env ) {
+  fd_snapshot_restore_delete( env->restore );
+  fd_wksp_free_laddr( env->manifest_buf );
+  fd_wksp_free_laddr( fd_exec_slot_ctx_delete( fd_exec_slot_ctx_leave( env->slot_ctx ) ) );
+  fd_wksp_free_laddr( fd_acc_mgr_delete( env->acc_mgr ) );
+  fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( env->funk ) ) );
+}
+
+/* restore_file feeds a file through the streaming state machine in
+   random sized chunks. */
+
+static void
+restore_file( fd_snapshot_restore_t * restore,
+              char const *            name,
+              uchar const *           data,
+              ulong                   sz,
+              fd_rng_t *              rng ) {
+  fd_tar_meta_t meta[1];
+  fd_memset( meta, 0, sizeof(fd_tar_meta_t) );
+  FD_TEST( fd_cstr_printf( meta->name, sizeof(meta->name), NULL, "%s", name ) );
+  meta->typeflag = FD_TAR_TYPE_REGULAR;
+
+  FD_TEST( !fd_snapshot_restore_file( restore, meta, sz ) );
+  while( sz ) {
+    ulong chunk_sz = fd_ulong_min( sz, 1UL+fd_rng_ulong_roll( rng, 1024UL ) );
+    FD_TEST( !fd_snapshot_restore_chunk( restore, data, chunk_sz ) );
+    data += chunk_sz;
+    sz   -= chunk_sz;
+  }
+}
+
+/* restore_stream restores the manifest listing all account vecs and
+   then the account vecs in order. */
+
+static void
+restore_stream( test_env_t * env,
+                fd_valloc_t  valloc,
+                fd_rng_t *   rng ) {
+  fd_snapshot_slot_acc_vecs_t storages[ ACCV_CNT ];
+  for( ulong j=0UL; j<ACCV_CNT; j++ ) {
+    storages[ j ] = (fd_snapshot_slot_acc_vecs_t){ .slot = accv[ j ].slot, .account_vecs_len = 1UL, .account_vecs = &accv_id[ j ] };
+  }
+
+  fd_epoch_epoch_stakes_pair_t epoch_stakes[2];
+  fd_memset( epoch_stakes, 0, sizeof(epoch_stakes) );
+  epoch_stakes[0].key = 0UL;
+  epoch_stakes[1].key = 1UL;
+
+  fd_solana_manifest_t manifest[1];
+  fd_memset( manifest, 0, sizeof(fd_solana_manifest_t) );
+  manifest->bank.slot = SLOT_MIN+SLOT_CNT;
+  manifest->bank.rent_collector.epoch_schedule.slots_per_epoch             = 432000UL;
+  manifest->bank.rent_collector.epoch_schedule.leader_schedule_slot_offset = 432000UL;
+  manifest->bank.epoch_stakes_len          = 2UL;
+  manifest->bank.epoch_stakes              = epoch_stakes;
+  manifest->accounts_db.storages_len       = ACCV_CNT;
+  manifest->accounts_db.storages           = storages;
+  manifest->accounts_db.slot               = SLOT_MIN+SLOT_CNT;
+
+  ulong   manifest_sz  = fd_solana_manifest_size( manifest );
+  uchar * manifest_buf = fd_valloc_malloc( valloc, 8UL, manifest_sz );
+  FD_TEST( manifest_buf );
+  fd_bincode_encode_ctx_t encode = { .data = manifest_buf, .dataend = manifest_buf+manifest_sz };
+  FD_TEST( fd_solana_manifest_encode( manifest, &encode )==FD_BINCODE_SUCCESS );
+
+  char name[ FD_TAR_NAME_SZ ];
+  FD_TEST( fd_cstr_printf( name, sizeof(name), NULL, "snapshots/%lu/%lu", SLOT_MIN+SLOT_CNT, SLOT_MIN+SLOT_CNT ) );
+  restore_file( env->restore, name, manifest_buf, manifest_sz, rng );
+  fd_valloc_free( valloc, manifest_buf );
+
+  for( ulong j=0UL; j<ACCV_CNT; j++ ) {
+    FD_TEST( fd_cstr_printf( name, sizeof(name), NULL, "accounts/%lu.%lu", accv[ j ].slot, accv_id[ j ].id ) );
+    restore_file( env->restore, name, accv[ j ].data, accv[ j ].sz, rng );
+  }
+}
+
+/* restore_par restores the account vecs in batch_cnt batches with
+   fd_snapshot_restore_accv_par. */
+
+static void
+restore_par( test_env_t * env,
+             fd_valloc_t  valloc,
+             fd_tpool_t * tpool,
+             ulong        t0,
+             ulong        t1,
+             ulong        batch_cnt ) {
+  for( ulong b=0UL; b<batch_cnt; b++ ) {
+    ulong j0; ulong j1;
+    FD_TPOOL_PARTITION( 0UL, ACCV_CNT, 1UL, b, batch_cnt, j0, j1 );
+    FD_TEST( !fd_snapshot_restore_accv_par( env->restore, accv+j0, j1-j0, valloc, tpool, t0, t1 ) );
+  }
+}
+
+/* check_funk checks the accounts in funk against the expected result
+   and, if ref is non-NULL, against the accounts in ref. */
+
+static void
+check_funk( test_env_t const * env,
+            test_env_t const * ref ) {
+  ulong acc_cnt = 0UL;
+  for( ulong k=0UL; k<KEY_CNT; k++ ) {
+    fd_pubkey_t               key  = test_key( k );
+    fd_account_meta_t const * meta = fd_acc_mgr_view_raw( env->acc_mgr, NULL, &key, NULL, NULL );
+    fd_solana_account_hdr_t const * hdr = exp_hdr[ k ];
+    if( !hdr ) { FD_TEST( !meta ); continue; }
+    acc_cnt++;
+
+    FD_TEST( meta );
+    FD_TEST( meta->slot==exp_slot[ k ] );
+    FD_TEST( meta->dlen==hdr->meta.data_len );
+    FD_TEST( !memcmp( meta->hash, hdr->hash.value, 32UL ) );
+    FD_TEST( !memcmp( &meta->info, &hdr->info, sizeof(fd_solana_account_meta_t) ) );
+    FD_TEST( !memcmp( (uchar const *)meta + meta->hlen, hdr+1, meta->dlen ) );
+
+    if( ref ) {
+      fd_account_meta_t const * ref_meta = fd_acc_mgr_view_raw( ref->acc_mgr, NULL, &key, NULL, NULL );
+      FD_TEST( ref_meta );
+      FD_TEST( meta->hlen==ref_meta->hlen );
+      FD_TEST( !memcmp( meta, ref_meta, meta->hlen+meta->dlen ) );
+    }
+  }
+  fd_wksp_t * wksp = fd_funk_wksp( env->funk );
+  FD_TEST( fd_funk_rec_cnt( fd_funk_rec_map( env->funk, wksp ) )==acc_cnt );
+  FD_TEST( !fd_funk_verify( env->funk ) );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL, "gigantic"       );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL, 1UL              );
+  ulong        near_cpu = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu", NULL, fd_log_cpu_id() );
+  uint         seed     = fd_env_strip_cmdline_uint ( &argc, &argv, "--seed",     NULL, 0U               );
+
+  FD_LOG_NOTICE(( "Testing with --page-sz %s --page-cnt %lu --near-cpu %lu --seed %u", _page_sz, page_cnt, near_cpu, seed ));
+
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  if( FD_UNLIKELY( !wksp ) ) FD_LOG_ERR(( "Unable to attach to wksp" ));
+
+  fd_alloc_t * alloc = fd_alloc_join( fd_alloc_new( fd_wksp_alloc_laddr( wksp, fd_alloc_align(), fd_alloc_footprint(), 1UL ), 1UL ), 0UL );
+  FD_TEST( alloc );
+  fd_valloc_t valloc = fd_alloc_virtual( alloc );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, seed, 0UL ) );
+
+  ulong        tile_cnt = fd_tile_cnt();
+  fd_tpool_t * tpool    = NULL;
+  if( tile_cnt>1UL ) {
+    tpool = fd_tpool_init( tpool_mem, tile_cnt );
+    FD_TEST( tpool );
+    for( ulong t=1UL; t<tile_cnt; t++ ) FD_TEST( fd_tpool_worker_push( tpool, t, NULL, 0UL ) );
+  }
+
+  fd_exec_epoch_ctx_t * epoch_ctx = fd_exec_epoch_ctx_join( fd_exec_epoch_ctx_new(
+      fd_wksp_alloc_laddr( wksp, FD_EXEC_EPOCH_CTX_ALIGN, FD_EXEC_EPOCH_CTX_FOOTPRINT, 1UL ) ) );
+  FD_TEST( epoch_ctx );
+  epoch_ctx->valloc = valloc;
+
+  void * ref_restore_mem = fd_wksp_alloc_laddr( wksp, fd_snapshot_restore_align(), fd_snapshot_restore_footprint(), 1UL );
+  void * env_restore_mem = fd_wksp_alloc_laddr( wksp, fd_snapshot_restore_align(), fd_snapshot_restore_footprint(), 1UL );
+  FD_TEST( ref_restore_mem && env_restore_mem );
+
+  accv_gen( rng );
+  FD_TEST( stale_cnt>0UL );
+
+  /* Reference: streaming restore */
+
+  test_env_t ref[1];
+  test_env_new( ref, wksp, valloc, epoch_ctx, ref_restore_mem, 2UL );
+  restore_stream( ref, valloc, rng );
+  check_funk( ref, NULL );
+
+  /* Serial restore in one batch and in several batches (duplicates
+     then resolve against records created by an earlier batch) */
+
+  for( ulong batch_cnt=1UL; batch_cnt<=5UL; batch_cnt+=2UL ) {
+    test_env_t env[1];
+    test_env_new( env, wksp, valloc, epoch_ctx, env_restore_mem, 3UL );
+    restore_par( env, valloc, NULL, 0UL, 0UL, batch_cnt );
+    check_funk( env, ref );
+    test_env_delete( env );
+  }
+
+  /* Parallel restore */
+
+  if( tpool ) {
+    for( ulong batch_cnt=1UL; batch_cnt<=5UL; batch_cnt+=2UL ) {
+      test_env_t env[1];
+      test_env_new( env, wksp, valloc, epoch_ctx, env_restore_mem, 3UL );
+      restore_par( env, valloc, tpool, 0UL, tile_cnt, batch_cnt );
+      check_funk( env, ref );
+      test_env_delete( env );
+    }
+  } else {
+    FD_LOG_WARNING(( "skip: parallel restore (run with --tile-cpus for more than one tile)" ));
+  }
+
+  /* Failures */
+
+  test_env_t env[1];
+  test_env_new( env, wksp, valloc, epoch_ctx, env_restore_mem, 3UL );
+  if( tpool ) {
+    FD_TEST( fd_snapshot_restore_accv_par( env->restore, accv, ACCV_CNT, valloc, tpool, 1UL, 1UL        )==-1 );
+    FD_TEST( fd_snapshot_restore_accv_par( env->restore, accv, ACCV_CNT, valloc, tpool, 0UL, tile_cnt+1 )==-1 );
+  }
+  FD_TEST( !fd_snapshot_restore_accv_par( env->restore, accv, 0UL, valloc, NULL, 0UL, 0UL ) );
+
+  /* Account data cut off by the end of the account vec */
+  fd_snapshot_restore_accv_t trunc = accv[0];
+  trunc.sz = sizeof(fd_solana_account_hdr_t) + ((fd_solana_account_hdr_t const *)trunc.data)->meta.data_len - 1UL;
+  if( ((fd_solana_account_hdr_t const *)trunc.data)->meta.data_len ) {
+    FD_TEST( fd_snapshot_restore_accv_par( env->restore, &trunc, 1UL, valloc, NULL, 0UL, 0UL )==-1 );
+    FD_TEST( fd_funk_rec_cnt( fd_funk_rec_map( env->funk, wksp ) )==0UL );
+  }
+  test_env_delete( env );
+
+  test_env_delete( ref );
+  fd_wksp_free_laddr( env_restore_mem );
+  fd_wksp_free_laddr( ref_restore_mem );
+  fd_wksp_free_laddr( fd_exec_epoch_ctx_delete( fd_exec_epoch_ctx_leave( epoch_ctx ) ) );
+  if( tpool ) fd_tpool_fini( tpool );
+  fd_rng_delete( fd_rng_leave( rng ) );
+  fd_wksp_free_laddr( fd_alloc_delete( fd_alloc_leave( alloc ) ) );
+  fd_wksp_delete_anonymous( wksp );
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
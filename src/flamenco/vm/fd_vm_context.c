@@ -153,48 +153,17 @@ fd_vm_context_validate( fd_vm_exec_context_t const * ctx ) {
   return FD_VM_SBPF_VALIDATE_SUCCESS;
 }
 
-ulong
-fd_vm_translate_vm_to_host_private( fd_vm_exec_context_t *  ctx,
-                                    ulong                   vm_addr,
-                                    ulong                   sz,
-                                    int                     write ) {
-  ulong mem_region = vm_addr & FD_VM_MEM_MAP_REGION_MASK;
-  ulong start_addr = vm_addr & FD_VM_MEM_MAP_REGION_SZ;
-  ulong end_addr = start_addr + sz;
-
-  ulong host_addr = 0UL;
-  switch( mem_region ) {
-    case FD_VM_MEM_MAP_PROGRAM_REGION_START:
-      /* Read-only program binary blob memory region */
-      if( FD_UNLIKELY( ( write                        )
-                     | ( end_addr > ctx->read_only_sz ) ) )
-        return 0UL;
+FD_STATIC_ASSERT( (FD_VM_MEM_MAP_PROGRAM_REGION_START>>FD_VM_MEM_MAP_REGION_VIRT_ADDR_BITS)==1UL, region_idx );
+FD_STATIC_ASSERT( (FD_VM_MEM_MAP_STACK_REGION_START  >>FD_VM_MEM_MAP_REGION_VIRT_ADDR_BITS)==2UL, region_idx );
+FD_STATIC_ASSERT( (FD_VM_MEM_MAP_HEAP_REGION_START   >>FD_VM_MEM_MAP_REGION_VIRT_ADDR_BITS)==3UL, region_idx );
+FD_STATIC_ASSERT( (FD_VM_MEM_MAP_INPUT_REGION_START  >>FD_VM_MEM_MAP_REGION_VIRT_ADDR_BITS)==4UL, region_idx );
 
-      host_addr = (ulong)ctx->read_only + start_addr;
-      break;
-    case FD_VM_MEM_MAP_STACK_REGION_START:
-      /* Stack memory region */
-      /* TODO: needs more of the runtime to actually implement */
-      /* FIXME: check that we are in the current or previous stack frame! */
-      if( FD_UNLIKELY( end_addr > (FD_VM_STACK_MAX_DEPTH * FD_VM_STACK_FRAME_WITH_GUARD_SZ ) ) ) {
-        return 0UL;
-      }
-      host_addr = (ulong)ctx->stack.data + start_addr;
-      break;
-    case FD_VM_MEM_MAP_HEAP_REGION_START:
-      /* Heap memory region */
-      if( FD_UNLIKELY( end_addr > ctx->heap_sz ) )
-        return 0UL;
-      host_addr = (ulong)ctx->heap + start_addr;
-      break;
-    case FD_VM_MEM_MAP_INPUT_REGION_START:
-      /* Program input memory region */
-      if( FD_UNLIKELY( end_addr > ctx->input_sz ) )
-        return 0UL;
-      host_addr = (ulong)ctx->input + start_addr;
-      break;
-    default:
-      return 0UL;
-  }
-  return host_addr;
+void
+fd_vm_context_region_init( fd_vm_exec_context_t * ctx ) {
+  ulong stack_sz = FD_VM_STACK_MAX_DEPTH * FD_VM_STACK_FRAME_WITH_GUARD_SZ;
+  ctx->region[0] = (fd_vm_mem_region_t){ 0UL,                   0UL,               0UL           };
+  ctx->region[1] = (fd_vm_mem_region_t){ (ulong)ctx->read_only,  ctx->read_only_sz, 0UL           };
+  ctx->region[2] = (fd_vm_mem_region_t){ (ulong)ctx->stack.data, stack_sz,          stack_sz      };
+  ctx->region[3] = (fd_vm_mem_region_t){ (ulong)ctx->heap,       ctx->heap_sz,      ctx->heap_sz  };
+  ctx->region[4] = (fd_vm_mem_region_t){ (ulong)ctx->input,      ctx->input_sz,     ctx->input_sz };
 }
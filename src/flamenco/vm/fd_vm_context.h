@@ -46,10 +46,33 @@
 #define FD_VM_MEM_MAP_SUCCESS       (0)
 #define FD_VM_MEM_MAP_ERR_ACC_VIO   (1)
 
+/* FD_VM_MEM_MAP_REGION_CNT is the number of entries in the region table
+   of an execution context.  The table is indexed by the high bits of a
+   VM address (vm_addr>>FD_VM_MEM_MAP_REGION_VIRT_ADDR_BITS).  Entry 0
+   is unmapped, entries 1-4 are the program, stack, heap and input
+   regions. */
+
+#define FD_VM_MEM_MAP_REGION_CNT (5UL)
+
+/* fd_vm_mem_region_t describes the host mapping of a VM memory region.
+   A VM access of sz bytes at region offset off is valid if off+sz does
+   not exceed rd_sz (loads) or wr_sz (stores). */
+
+struct fd_vm_mem_region {
+  ulong haddr;  /* host address of first byte of region */
+  ulong rd_sz;  /* number of readable bytes */
+  ulong wr_sz;  /* number of writable bytes (0 if read-only) */
+};
+
+typedef struct fd_vm_mem_region fd_vm_mem_region_t;
+
 /* Forward definition of fd_vm_sbpf_exec_context_t. */
 struct fd_vm_exec_context;
 typedef struct fd_vm_exec_context fd_vm_exec_context_t;
 
+/* Forward definition of fd_vm_jit_prog_t (see fd_vm_jit.h). */
+struct fd_vm_jit_prog;
+
 /* Syscall function type for all sBPF syscall/external function calls. They take a context from
    the VM and VM registers 1-5 as input, and return a value to VM register 0. The syscall return
    value is a status code for the syscall. */
@@ -197,6 +220,7 @@ struct fd_vm_exec_context {
   ulong                       instrs_offset;  /* This is the relocation offset we must apply to indirect calls (callx/CALL_REGs) */
   uint                        check_align;    /* If non-zero, VM does alignment checks where necessary (syscalls) */
   uint                        check_size;     /* If non-zero, VM does size checks where necessary (syscalls) */
+  struct fd_vm_jit_prog const * jit;          /* If non-NULL, native translation of instrs used by fd_vm_exec_instrs */
 
   /* Writable VM parameters: */
   ulong                 register_file[11];           /* The sBPF register file */
@@ -217,6 +241,10 @@ struct fd_vm_exec_context {
   ulong         heap_sz;                  /* The configured size of the heap */
   uchar         heap[FD_VM_MAX_HEAP_SZ];  /* The heap memory allocated by the bump allocator syscall */
 
+  /* Region table derived from the memory regions above by
+     fd_vm_context_region_init, used for address translation */
+  fd_vm_mem_region_t region[ FD_VM_MEM_MAP_REGION_CNT ];
+
   /* Runtime context */
   fd_exec_instr_ctx_t * instr_ctx;
 
@@ -259,11 +287,38 @@ fd_vm_context_validate( fd_vm_exec_context_t const * ctx );
    Security note: Watch out for pointer aliasing when translating
                   multiple user-specified data types. */
 
-ulong
+/* fd_vm_context_region_init (re)builds the region table of ctx from its
+   memory region fields (read_only, stack, heap_sz, input).  Must be
+   called after changing any of them and before translating addresses.
+   The interpreter and the JIT do this when starting execution. */
+
+void
+fd_vm_context_region_init( fd_vm_exec_context_t * ctx );
+
+/* fd_vm_translate_vm_to_host_private looks up the region of vm_addr in
+   the region table and bounds checks the access without branching.
+   Inlined such that the checks are specialized for constant sz and
+   write at each call site (e.g. the interpreter's loads and stores). */
+
+FD_FN_PURE static inline ulong
 fd_vm_translate_vm_to_host_private( fd_vm_exec_context_t * ctx,
                                     ulong                  vm_addr,
                                     ulong                  sz,
-                                    int                    write );
+                                    int                    write ) {
+  ulong region_idx = vm_addr >> FD_VM_MEM_MAP_REGION_VIRT_ADDR_BITS;
+  ulong start_addr = vm_addr & FD_VM_MEM_MAP_REGION_SZ;
+  ulong end_addr   = start_addr + sz;
+
+  /* Addresses beyond the last region resolve to unmapped region 0.  So
+     do writes to the read-only program region, such that they fail even
+     for sz==0 (where end_addr<=wr_sz alone would pass). */
+  region_idx = fd_ulong_if( region_idx<FD_VM_MEM_MAP_REGION_CNT, region_idx, 0UL );
+  region_idx = fd_ulong_if( write && region_idx==(FD_VM_MEM_MAP_PROGRAM_REGION_START>>FD_VM_MEM_MAP_REGION_VIRT_ADDR_BITS), 0UL, region_idx );
+
+  fd_vm_mem_region_t const * region = &ctx->region[ region_idx ];
+  ulong region_sz = write ? region->wr_sz : region->rd_sz;
+  return fd_ulong_if( end_addr<=region_sz, region->haddr + start_addr, 0UL );
+}
 
 static inline void *
 fd_vm_translate_vm_to_host( fd_vm_exec_context_t * ctx,
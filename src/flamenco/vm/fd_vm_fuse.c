@@ -0,0 +1,114 @@
+#include "fd_vm_fuse.h"
+
+#include "../../ballet/sbpf/fd_sbpf_opcodes.h"
+
+/* fd_vm_fuse_pair maps a pair of opcodes to its fused opcode.  The
+   selection covers the most frequent adjacent pairs observed in
+   on-chain programs. */
+
+struct fd_vm_fuse_pair {
+  uchar head;
+  uchar next;
+  uchar fused;
+};
+
+typedef struct fd_vm_fuse_pair fd_vm_fuse_pair_t;
+
+static fd_vm_fuse_pair_t const fd_vm_fuse_pairs[] = {
+  { 0x79, 0x07, FD_VM_FUSED_OP_LDXQ_ADD64_IMM      },
+  { 0x79, 0x0f, FD_VM_FUSED_OP_LDXQ_ADD64_REG      },
+  { 0x79, 0x7b, FD_VM_FUSED_OP_LDXQ_STXQ           },
+  { 0x7b, 0x79, FD_VM_FUSED_OP_STXQ_LDXQ           },
+  { 0x79, 0x15, FD_VM_FUSED_OP_LDXQ_JEQ_IMM        },
+  { 0x79, 0x55, FD_VM_FUSED_OP_LDXQ_JNE_IMM        },
+  { 0x71, 0x15, FD_VM_FUSED_OP_LDXB_JEQ_IMM        },
+  { 0x71, 0x55, FD_VM_FUSED_OP_LDXB_JNE_IMM        },
+  { 0x07, 0x55, FD_VM_FUSED_OP_ADD64_IMM_JNE_IMM   },
+  { 0x07, 0x5d, FD_VM_FUSED_OP_ADD64_IMM_JNE_REG   },
+  { 0x07, 0x2d, FD_VM_FUSED_OP_ADD64_IMM_JGT_REG   },
+  { 0xbf, 0x07, FD_VM_FUSED_OP_MOV64_REG_ADD64_IMM },
+  { 0xbf, 0xbf, FD_VM_FUSED_OP_MOV64_REG_MOV64_REG },
+  { 0xb7, 0xb7, FD_VM_FUSED_OP_MOV64_IMM_MOV64_IMM },
+  { 0xbf, 0x85, FD_VM_FUSED_OP_MOV64_REG_CALL_IMM  },
+  { 0xb7, 0x85, FD_VM_FUSED_OP_MOV64_IMM_CALL_IMM  },
+  { 0xb7, 0x95, FD_VM_FUSED_OP_MOV64_IMM_EXIT      },
+};
+
+#define FD_VM_FUSE_PAIR_CNT (sizeof(fd_vm_fuse_pairs)/sizeof(fd_vm_fuse_pair_t))
+
+/* Fused heads must not look like branches or LDQs to the interpreter's
+   compute unit metering.  Every branch handler charges the instructions
+   executed since the previous branch (pc-start_pc+1, less the LDQ
+   second slots counted in skipped_insns) and checks the budget inline
+   before dispatching. */
+
+#define FD_VM_FUSE_CHECK_OPCODE(op) \
+  FD_STATIC_ASSERT( ((op)&0x7)!=FD_SBPF_OPCODE_CLASS_JMP && (op)!=0x18, fused_opcode )
+
+FD_VM_FUSE_CHECK_OPCODE( FD_VM_FUSED_OP_LDXQ_ADD64_IMM      );
+FD_VM_FUSE_CHECK_OPCODE( FD_VM_FUSED_OP_LDXQ_ADD64_REG      );
+FD_VM_FUSE_CHECK_OPCODE( FD_VM_FUSED_OP_LDXQ_STXQ           );
+FD_VM_FUSE_CHECK_OPCODE( FD_VM_FUSED_OP_STXQ_LDXQ           );
+FD_VM_FUSE_CHECK_OPCODE( FD_VM_FUSED_OP_LDXQ_JEQ_IMM        );
+FD_VM_FUSE_CHECK_OPCODE( FD_VM_FUSED_OP_LDXQ_JNE_IMM        );
+FD_VM_FUSE_CHECK_OPCODE( FD_VM_FUSED_OP_LDXB_JEQ_IMM        );
+FD_VM_FUSE_CHECK_OPCODE( FD_VM_FUSED_OP_LDXB_JNE_IMM        );
+FD_VM_FUSE_CHECK_OPCODE( FD_VM_FUSED_OP_ADD64_IMM_JNE_IMM   );
+FD_VM_FUSE_CHECK_OPCODE( FD_VM_FUSED_OP_ADD64_IMM_JNE_REG   );
+FD_VM_FUSE_CHECK_OPCODE( FD_VM_FUSED_OP_ADD64_IMM_JGT_REG   );
+FD_VM_FUSE_CHECK_OPCODE( FD_VM_FUSED_OP_MOV64_REG_ADD64_IMM );
+FD_VM_FUSE_CHECK_OPCODE( FD_VM_FUSED_OP_MOV64_REG_MOV64_REG );
+FD_VM_FUSE_CHECK_OPCODE( FD_VM_FUSED_OP_MOV64_IMM_MOV64_IMM );
+FD_VM_FUSE_CHECK_OPCODE( FD_VM_FUSED_OP_MOV64_REG_CALL_IMM  );
+FD_VM_FUSE_CHECK_OPCODE( FD_VM_FUSED_OP_MOV64_IMM_CALL_IMM  );
+FD_VM_FUSE_CHECK_OPCODE( FD_VM_FUSED_OP_MOV64_IMM_EXIT      );
+
+#undef FD_VM_FUSE_CHECK_OPCODE
+
+static uchar
+fd_vm_fuse_lookup( uchar head,
+                   uchar next ) {
+  for( ulong i=0UL; i<FD_VM_FUSE_PAIR_CNT; i++ ) {
+    if( fd_vm_fuse_pairs[i].head==head && fd_vm_fuse_pairs[i].next==next ) return fd_vm_fuse_pairs[i].fused;
+  }
+  return 0;
+}
+
+int
+fd_vm_fuse_is_fused( uchar opcode ) {
+  for( ulong i=0UL; i<FD_VM_FUSE_PAIR_CNT; i++ ) {
+    if( fd_vm_fuse_pairs[i].fused==opcode ) return 1;
+  }
+  return 0;
+}
+
+ulong
+fd_vm_fuse_instrs( fd_sbpf_instr_t *       out,
+                   fd_sbpf_instr_t const * in,
+                   ulong                   instrs_cnt ) {
+  ulong sz = instrs_cnt*sizeof(fd_sbpf_instr_t);
+  if( FD_UNLIKELY( instrs_cnt && (ulong)out<(ulong)in+sz && (ulong)in<(ulong)out+sz ) ) {
+    FD_LOG_WARNING(( "out overlaps in" ));
+    return 0UL;
+  }
+  fd_memcpy( out, in, sz );
+
+  ulong fused_cnt = 0UL;
+  ulong i = 0UL;
+  while( i+1UL<instrs_cnt ) {
+    uchar head = in[i].opcode.raw;
+    if( head==FD_SBPF_OP_LDDW ) {
+      i += 2UL; /* skip the LDQ tail slot */
+      continue;
+    }
+    uchar fused = fd_vm_fuse_lookup( head, in[i+1UL].opcode.raw );
+    if( fused ) {
+      out[i].opcode.raw = fused;
+      fused_cnt++;
+      i += 2UL;
+    } else {
+      i++;
+    }
+  }
+  return fused_cnt;
+}
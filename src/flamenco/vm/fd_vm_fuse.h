@@ -0,0 +1,77 @@
+#ifndef HEADER_fd_src_flamenco_vm_fd_vm_fuse_h
+#define HEADER_fd_src_flamenco_vm_fd_vm_fuse_h
+
+/* fd_vm_fuse is an optional peephole pass that rewrites frequent pairs
+   of adjacent sBPF instructions into interpreter-only superinstructions
+   to cut the number of indirect dispatches the interpreter performs.
+
+   A fused pair keeps its two slots.  Only the opcode of the first
+   instruction (the head) is replaced by a fused opcode; its operands
+   and the second instruction are left untouched.  The interpreter
+   handler of a fused opcode executes the head and then jumps directly
+   (instead of via the dispatch table) into the regular handler of the
+   second instruction.  Consequently, jumps into the middle of a pair
+   still land on a valid instruction, and program counter, instruction
+   counter, compute unit accounting, faults and traces are identical to
+   the unfused program.
+
+   Fused opcodes (FD_VM_FUSED_OP_*) live in the range of opcodes that
+   fail fd_vm_context_validate.  Hence, fusion must run after
+   validation, and fused instructions are only understood by
+   fd_vm_interp_instrs{,_trace}.  The JIT, the disassembler and
+   fd_vm_context_validate must be given the original program.
+   LDQ is not a fusion candidate: it already executes as a single
+   dispatch. */
+
+#include "../../ballet/sbpf/fd_sbpf_instr.h"
+
+/* FD_VM_FUSED_OP_{HEAD}_{SECOND} are the opcodes of the supported
+   pairs.  Values never use the JMP op class (low 3 bits 5) such that
+   fused heads are never mistaken for compute unit charge points. */
+
+#define FD_VM_FUSED_OP_LDXQ_ADD64_IMM    (0xe0) /* 0x79 0x07: load, advance */
+#define FD_VM_FUSED_OP_LDXQ_ADD64_REG    (0xe1) /* 0x79 0x0f: load, accumulate */
+#define FD_VM_FUSED_OP_LDXQ_STXQ         (0xe2) /* 0x79 0x7b: copy */
+#define FD_VM_FUSED_OP_STXQ_LDXQ         (0xe3) /* 0x7b 0x79: spill, reload */
+#define FD_VM_FUSED_OP_LDXQ_JEQ_IMM      (0xe4) /* 0x79 0x15: load, test */
+#define FD_VM_FUSED_OP_LDXQ_JNE_IMM      (0xe6) /* 0x79 0x55: load, test */
+#define FD_VM_FUSED_OP_LDXB_JEQ_IMM      (0xe7) /* 0x71 0x15: load, test */
+#define FD_VM_FUSED_OP_LDXB_JNE_IMM      (0xe8) /* 0x71 0x55: load, test */
+#define FD_VM_FUSED_OP_ADD64_IMM_JNE_IMM (0xe9) /* 0x07 0x55: loop step */
+#define FD_VM_FUSED_OP_ADD64_IMM_JNE_REG (0xea) /* 0x07 0x5d: loop step */
+#define FD_VM_FUSED_OP_ADD64_IMM_JGT_REG (0xeb) /* 0x07 0x2d: loop step */
+#define FD_VM_FUSED_OP_MOV64_REG_ADD64_IMM (0xec) /* 0xbf 0x07: address computation */
+#define FD_VM_FUSED_OP_MOV64_REG_MOV64_REG (0xee) /* 0xbf 0xbf: argument setup */
+#define FD_VM_FUSED_OP_MOV64_IMM_MOV64_IMM (0xef) /* 0xb7 0xb7: argument setup */
+#define FD_VM_FUSED_OP_MOV64_REG_CALL_IMM  (0xf0) /* 0xbf 0x85: argument setup, call */
+#define FD_VM_FUSED_OP_MOV64_IMM_CALL_IMM  (0xf1) /* 0xb7 0x85: argument setup, call */
+#define FD_VM_FUSED_OP_MOV64_IMM_EXIT      (0xf2) /* 0xb7 0x95: return constant */
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_vm_fuse_instrs writes the fused version of the validated program
+   [in,in+instrs_cnt) to [out,out+instrs_cnt).  Pairs are matched
+   greedily from the start of the program; a second instruction is
+   never the head of another pair.  Returns the number of fused pairs.
+
+   out must be an interpreter-private buffer that does not overlap in.
+   In particular, never fuse prog->text in place: the text is part of
+   the program region that sBPF programs can load from, so rewriting it
+   would change observable bytes and diverge from other validators.
+   Overlapping buffers are rejected (logs details, returns 0 without
+   writing to out). */
+
+ulong
+fd_vm_fuse_instrs( fd_sbpf_instr_t *       out,
+                   fd_sbpf_instr_t const * in,
+                   ulong                   instrs_cnt );
+
+/* fd_vm_fuse_is_fused returns 1 if opcode is an FD_VM_FUSED_OP_* and 0
+   otherwise. */
+
+FD_FN_CONST int
+fd_vm_fuse_is_fused( uchar opcode );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_flamenco_vm_fd_vm_fuse_h */
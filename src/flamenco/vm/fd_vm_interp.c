@@ -157,6 +157,8 @@ fd_vm_interp_instrs( fd_vm_exec_context_t * ctx ) {
 #define JMP_TAB_POST_CASE_CODE
 #include "fd_jump_tab.c"
 
+  fd_vm_context_region_init( ctx );
+
   ulong heap_cus_consumed = fd_ulong_sat_mul(fd_ulong_sat_sub(ctx->heap_sz / (32*1024), 1), vm_compute_budget.heap_cost);
   cond_fault = fd_vm_consume_compute_meter(ctx, heap_cus_consumed);
   compute_meter = ctx->compute_meter;
@@ -166,7 +168,7 @@ fd_vm_interp_instrs( fd_vm_exec_context_t * ctx ) {
 
   fd_sbpf_instr_t instr;
 
-  static const void * locs[222] = {
+  static const void * locs[256] = {
 #include "fd_vm_interp_locs.c"
   };
 
@@ -226,6 +228,8 @@ fd_vm_interp_instrs_trace( fd_vm_exec_context_t * ctx ) {
 #define JMP_TAB_POST_CASE_CODE
 #include "fd_jump_tab.c"
 
+  fd_vm_context_region_init( ctx );
+
   ulong heap_cus_consumed = fd_ulong_sat_mul(fd_ulong_sat_sub(ctx->heap_sz / (32*1024), 1), vm_compute_budget.heap_cost);
   cond_fault = fd_vm_consume_compute_meter(ctx, heap_cus_consumed);
   compute_meter = ctx->compute_meter;
@@ -235,7 +239,7 @@ fd_vm_interp_instrs_trace( fd_vm_exec_context_t * ctx ) {
 
   fd_sbpf_instr_t instr;
 
-  static const void * locs[222] = {
+  static const void * locs[256] = {
 #include "fd_vm_interp_locs.c"
   };
 
@@ -7,7 +7,8 @@ FD_PROTOTYPES_BEGIN
 
 /* fd_vm_interp_instrs runs the sBPF program from the context until
    completion or a fault occurs.  Returns 0UL success or an error/fault
-   code. */
+   code.  ctx->instrs may have been fused with fd_vm_fuse_instrs (see
+   fd_vm_fuse.h). */
 
 ulong
 fd_vm_interp_instrs( fd_vm_exec_context_t * ctx );
@@ -29,6 +29,14 @@ do { \
   instr = ctx->instrs[++pc]; \
   goto *(locs[instr.opcode.raw]);
 
+/* FUSED_POST_CODE ends the head of a fused pair (see fd_vm_fuse.h).
+   The second instruction is known statically, so its handler is
+   entered directly instead of through the dispatch table. */
+
+#define FUSED_POST_CODE(next) \
+  instr = ctx->instrs[++pc]; \
+  goto JT_CASE_LOC(next);
+
 /* 0x00 - 0x0f */
 /* 0x00 */ JT_CASE(0x00); // FD_BPF_OP_ADDL_IMM
 /* 0x04 */ JT_CASE(0x04) // FD_BPF_OP_ADD_IMM
@@ -549,8 +557,99 @@ BRANCH_PRE_CODE
 BRANCH_POST_CODE
 JT_CASE_END
 
+/* 0xe0 - 0xff: fused pairs (see fd_vm_fuse.h) */
+/* 0xe0 */ JT_CASE(0xe0) // FD_VM_FUSED_OP_LDXQ_ADD64_IMM
+  cond_fault = fd_vm_mem_map_read_ulong( ctx, (ulong)((long)register_file[instr.src_reg] + instr.offset), (ulong *)&register_file[instr.dst_reg] );
+  goto *((cond_fault == 0) ? &&fallthrough_0xe0 : &&JT_RET_LOC);
+fallthrough_0xe0:
+FUSED_POST_CODE(0x07)
+JT_CASE_END
+/* 0xe1 */ JT_CASE(0xe1) // FD_VM_FUSED_OP_LDXQ_ADD64_REG
+  cond_fault = fd_vm_mem_map_read_ulong( ctx, (ulong)((long)register_file[instr.src_reg] + instr.offset), (ulong *)&register_file[instr.dst_reg] );
+  goto *((cond_fault == 0) ? &&fallthrough_0xe1 : &&JT_RET_LOC);
+fallthrough_0xe1:
+FUSED_POST_CODE(0x0f)
+JT_CASE_END
+/* 0xe2 */ JT_CASE(0xe2) // FD_VM_FUSED_OP_LDXQ_STXQ
+  cond_fault = fd_vm_mem_map_read_ulong( ctx, (ulong)((long)register_file[instr.src_reg] + instr.offset), (ulong *)&register_file[instr.dst_reg] );
+  goto *((cond_fault == 0) ? &&fallthrough_0xe2 : &&JT_RET_LOC);
+fallthrough_0xe2:
+FUSED_POST_CODE(0x7b)
+JT_CASE_END
+/* 0xe3 */ JT_CASE(0xe3) // FD_VM_FUSED_OP_STXQ_LDXQ
+  cond_fault = fd_vm_mem_map_write_ulong( ctx, (ulong)((long)register_file[instr.dst_reg] + instr.offset), (ulong)register_file[instr.src_reg] );
+  goto *((cond_fault == 0) ? &&fallthrough_0xe3 : &&JT_RET_LOC);
+fallthrough_0xe3:
+FUSED_POST_CODE(0x79)
+JT_CASE_END
+/* 0xe4 */ JT_CASE(0xe4) // FD_VM_FUSED_OP_LDXQ_JEQ_IMM
+  cond_fault = fd_vm_mem_map_read_ulong( ctx, (ulong)((long)register_file[instr.src_reg] + instr.offset), (ulong *)&register_file[instr.dst_reg] );
+  goto *((cond_fault == 0) ? &&fallthrough_0xe4 : &&JT_RET_LOC);
+fallthrough_0xe4:
+FUSED_POST_CODE(0x15)
+JT_CASE_END
+/* 0xe6 */ JT_CASE(0xe6) // FD_VM_FUSED_OP_LDXQ_JNE_IMM
+  cond_fault = fd_vm_mem_map_read_ulong( ctx, (ulong)((long)register_file[instr.src_reg] + instr.offset), (ulong *)&register_file[instr.dst_reg] );
+  goto *((cond_fault == 0) ? &&fallthrough_0xe6 : &&JT_RET_LOC);
+fallthrough_0xe6:
+FUSED_POST_CODE(0x55)
+JT_CASE_END
+/* 0xe7 */ JT_CASE(0xe7) // FD_VM_FUSED_OP_LDXB_JEQ_IMM
+  cond_fault = fd_vm_mem_map_read_uchar( ctx, (ulong)((long)register_file[instr.src_reg] + instr.offset), &register_file[instr.dst_reg] );
+  goto *((cond_fault == 0) ? &&fallthrough_0xe7 : &&JT_RET_LOC);
+fallthrough_0xe7:
+FUSED_POST_CODE(0x15)
+JT_CASE_END
+/* 0xe8 */ JT_CASE(0xe8) // FD_VM_FUSED_OP_LDXB_JNE_IMM
+  cond_fault = fd_vm_mem_map_read_uchar( ctx, (ulong)((long)register_file[instr.src_reg] + instr.offset), &register_file[instr.dst_reg] );
+  goto *((cond_fault == 0) ? &&fallthrough_0xe8 : &&JT_RET_LOC);
+fallthrough_0xe8:
+FUSED_POST_CODE(0x55)
+JT_CASE_END
+/* 0xe9 */ JT_CASE(0xe9) // FD_VM_FUSED_OP_ADD64_IMM_JNE_IMM
+  register_file[instr.dst_reg] = (ulong)((long)register_file[instr.dst_reg] + (int)instr.imm);
+FUSED_POST_CODE(0x55)
+JT_CASE_END
+/* 0xea */ JT_CASE(0xea) // FD_VM_FUSED_OP_ADD64_IMM_JNE_REG
+  register_file[instr.dst_reg] = (ulong)((long)register_file[instr.dst_reg] + (int)instr.imm);
+FUSED_POST_CODE(0x5d)
+JT_CASE_END
+/* 0xeb */ JT_CASE(0xeb) // FD_VM_FUSED_OP_ADD64_IMM_JGT_REG
+  register_file[instr.dst_reg] = (ulong)((long)register_file[instr.dst_reg] + (int)instr.imm);
+FUSED_POST_CODE(0x2d)
+JT_CASE_END
+/* 0xec */ JT_CASE(0xec) // FD_VM_FUSED_OP_MOV64_REG_ADD64_IMM
+  register_file[instr.dst_reg] = register_file[instr.src_reg];
+FUSED_POST_CODE(0x07)
+JT_CASE_END
+/* 0xee */ JT_CASE(0xee) // FD_VM_FUSED_OP_MOV64_REG_MOV64_REG
+  register_file[instr.dst_reg] = register_file[instr.src_reg];
+FUSED_POST_CODE(0xbf)
+JT_CASE_END
+/* 0xef */ JT_CASE(0xef) // FD_VM_FUSED_OP_MOV64_IMM_MOV64_IMM
+  *(long *)&register_file[instr.dst_reg] = (int)instr.imm;
+FUSED_POST_CODE(0xb7)
+JT_CASE_END
+/* 0xf0 */ JT_CASE(0xf0) // FD_VM_FUSED_OP_MOV64_REG_CALL_IMM
+  register_file[instr.dst_reg] = register_file[instr.src_reg];
+FUSED_POST_CODE(0x85)
+JT_CASE_END
+/* 0xf1 */ JT_CASE(0xf1) // FD_VM_FUSED_OP_MOV64_IMM_CALL_IMM
+  *(long *)&register_file[instr.dst_reg] = (int)instr.imm;
+FUSED_POST_CODE(0x85)
+JT_CASE_END
+/* 0xf2 */ JT_CASE(0xf2) // FD_VM_FUSED_OP_MOV64_IMM_EXIT
+  *(long *)&register_file[instr.dst_reg] = (int)instr.imm;
+FUSED_POST_CODE(0x95)
+JT_CASE_END
+
+#undef BRANCH_PRE_CODE
+#undef BRANCH_POST_CODE
+#undef INSTR_POST_CODE
+#undef FUSED_POST_CODE
+
 #ifdef __GNUC__
 #ifndef __clang__
 #pragma GCC diagnostic pop
 #endif
-#endif
\ No newline at end of file
+#endif
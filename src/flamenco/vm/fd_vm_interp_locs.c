@@ -226,3 +226,37 @@
 /* 0xdb */ NULL,
 /* 0xdc */ &&JT_CASE_LOC(0xdc),
 /* 0xdd */ &&JT_CASE_LOC(0xdd),
+/* 0xde */ NULL,
+/* 0xdf */ NULL,
+/* 0xe0 */ &&JT_CASE_LOC(0xe0),
+/* 0xe1 */ &&JT_CASE_LOC(0xe1),
+/* 0xe2 */ &&JT_CASE_LOC(0xe2),
+/* 0xe3 */ &&JT_CASE_LOC(0xe3),
+/* 0xe4 */ &&JT_CASE_LOC(0xe4),
+/* 0xe5 */ NULL,
+/* 0xe6 */ &&JT_CASE_LOC(0xe6),
+/* 0xe7 */ &&JT_CASE_LOC(0xe7),
+/* 0xe8 */ &&JT_CASE_LOC(0xe8),
+/* 0xe9 */ &&JT_CASE_LOC(0xe9),
+/* 0xea */ &&JT_CASE_LOC(0xea),
+/* 0xeb */ &&JT_CASE_LOC(0xeb),
+/* 0xec */ &&JT_CASE_LOC(0xec),
+/* 0xed */ NULL,
+/* 0xee */ &&JT_CASE_LOC(0xee),
+/* 0xef */ &&JT_CASE_LOC(0xef),
+/* 0xf0 */ &&JT_CASE_LOC(0xf0),
+/* 0xf1 */ &&JT_CASE_LOC(0xf1),
+/* 0xf2 */ &&JT_CASE_LOC(0xf2),
+/* 0xf3 */ NULL,
+/* 0xf4 */ NULL,
+/* 0xf5 */ NULL,
+/* 0xf6 */ NULL,
+/* 0xf7 */ NULL,
+/* 0xf8 */ NULL,
+/* 0xf9 */ NULL,
+/* 0xfa */ NULL,
+/* 0xfb */ NULL,
+/* 0xfc */ NULL,
+/* 0xfd */ NULL,
+/* 0xfe */ NULL,
+/* 0xff */ NULL,
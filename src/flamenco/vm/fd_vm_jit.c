@@ -0,0 +1,1266 @@
+#define _DEFAULT_SOURCE
+#include "fd_vm_jit.h"
+
+#include "../../util/bits/fd_sat.h"
+
+#if FD_HAS_X86 && FD_HAS_HOSTED
+
+#include "../../ballet/murmur3/fd_murmur3.h"
+#include "../../ballet/sbpf/fd_sbpf_opcodes.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <sys/mman.h>
+
+/* fd_vm_jit_frame_t is the run time state shared between
+   fd_vm_jit_instrs and generated code.  Generated code keeps a pointer
+   to it pinned in r12 and addresses fields by offset.  Mirrors the
+   local variables of fd_vm_interp_instrs. */
+
+struct fd_vm_jit_frame {
+  fd_vm_exec_context_t * ctx;
+  void const * const *   pc_tab;
+  ulong                  ic;          /* instruction_counter as of last branch */
+  ulong                  due;         /* due_insn_cnt */
+  ulong                  prev;        /* previous_instruction_meter */
+  ulong                  compute;     /* compute_meter */
+  ulong                  start_pc;    /* first pc executed since last branch */
+  ulong                  skipped;     /* LDQ instructions executed since last branch */
+  ulong                  pc;          /* program counter on exit */
+  ulong                  cond_fault;  /* fault code on exit */
+  fd_vm_mem_region_t     region[ FD_VM_MEM_MAP_REGION_CNT ]; /* copy of ctx->region */
+};
+
+typedef struct fd_vm_jit_frame fd_vm_jit_frame_t;
+
+/* Upper bounds on generated code size used to size the code buffer.
+   INSTR_MAX bounds the inline code of any single sBPF instruction,
+   STUB_MAX bounds an out-of-line fault stub, FIXUP_MAX bounds the
+   number of fixups recorded per sBPF instruction. */
+
+#define FD_VM_JIT_INSTR_MAX (512UL)
+#define FD_VM_JIT_STUB_MAX  (16UL)
+#define FD_VM_JIT_FIXUP_MAX (4UL)
+#define FD_VM_JIT_SLACK     (4096UL)
+
+/* x86-64 register numbers */
+
+#define RAX (0)
+#define RCX (1)
+#define RDX (2)
+#define RBX (3)
+#define RSP (4)
+#define RBP (5)
+#define RSI (6)
+#define RDI (7)
+#define R8  (8)
+#define R9  (9)
+#define R10 (10)
+#define R11 (11)
+#define R12 (12)
+#define R13 (13)
+#define R14 (14)
+#define R15 (15)
+#define NOREG (-1)
+
+/* x86-64 condition codes */
+
+#define CC_B  (0x2)
+#define CC_AE (0x3)
+#define CC_E  (0x4)
+#define CC_NE (0x5)
+#define CC_BE (0x6)
+#define CC_A  (0x7)
+#define CC_L  (0xc)
+#define CC_GE (0xd)
+#define CC_LE (0xe)
+#define CC_G  (0xf)
+
+/* Group 1 ALU opcode extensions (0x81 /ext) */
+
+#define ALU_ADD (0)
+#define ALU_OR  (1)
+#define ALU_AND (4)
+#define ALU_SUB (5)
+#define ALU_XOR (6)
+#define ALU_CMP (7)
+
+/* Group 2 shift opcode extensions (0xc1 /ext) */
+
+#define SHIFT_SHL (4)
+#define SHIFT_SHR (5)
+#define SHIFT_SAR (7)
+
+/* Host register holding each sBPF register.  r0-r5 live in caller
+   saved registers (rcx, r10 and r11 are left as scratch), r6-r10 in
+   callee saved registers.  The frame pointer lives in r12. */
+
+static int const fd_vm_jit_reg[ 11 ] = { RAX, RDI, RSI, RDX, R9, R8, RBX, R13, R14, R15, RBP };
+
+#define FRAME (R12)
+#define FRAME_OFF(field) ((int)offsetof( fd_vm_jit_frame_t, field ))
+
+/* Fixups *************************************************************/
+
+#define FD_VM_JIT_FIXUP_PC       (0) /* rel32 to code of pc arg */
+#define FD_VM_JIT_FIXUP_EXIT     (1) /* rel32 to stub exiting with pc=arg, cond_fault=cond */
+#define FD_VM_JIT_FIXUP_EXIT_R11 (2) /* rel32 to stub exiting with pc=arg, cond_fault=r11 */
+#define FD_VM_JIT_FIXUP_BUDGET   (3) /* rel32 to stub failing the instruction meter check with pc=arg */
+
+struct fd_vm_jit_fixup {
+  uint  at;    /* offset of rel32 field from start of code */
+  uint  kind;
+  ulong arg;
+  ulong cond;
+};
+
+typedef struct fd_vm_jit_fixup fd_vm_jit_fixup_t;
+
+struct fd_vm_jit_asm {
+  uchar *             code;       /* first byte of code buffer */
+  uchar *             cur;        /* next byte to emit */
+  uchar *             end;        /* one past last byte of code buffer */
+  fd_vm_jit_fixup_t * fixup;
+  ulong               fixup_cnt;
+  ulong               fixup_max;
+  int                 err;        /* non-zero if buffer space was exhausted */
+
+  /* Shared exit paths (emitted before program code) */
+  uchar *             exit_common;    /* rcx=pc, r11=cond_fault */
+  uchar *             budget_common;  /* rcx=pc */
+  uchar *             budget_dyn;     /* r11=pc */
+  uchar *             badcall_dyn;    /* r11=pc */
+  uchar *             overflow_dyn;   /* r11=pc+1 */
+};
+
+typedef struct fd_vm_jit_asm fd_vm_jit_asm_t;
+
+/* Encoder ************************************************************/
+
+static inline void
+emit1( fd_vm_jit_asm_t * a,
+       uint              b ) {
+  *a->cur++ = (uchar)b;
+}
+
+static inline void
+emit4( fd_vm_jit_asm_t * a,
+       uint              x ) {
+  FD_STORE( uint, a->cur, x );
+  a->cur += 4;
+}
+
+static inline void
+emit8( fd_vm_jit_asm_t * a,
+       ulong             x ) {
+  FD_STORE( ulong, a->cur, x );
+  a->cur += 8;
+}
+
+/* emit_rex emits a REX prefix if required (or force is set). */
+
+static inline void
+emit_rex( fd_vm_jit_asm_t * a,
+          int               w,
+          int               reg,
+          int               idx,
+          int               rm,
+          int               force ) {
+  uint rex = 0x40U | ((uint)!!w<<3);
+  if( reg>=0 ) rex |= (uint)((reg>>3)&1)<<2;
+  if( idx>=0 ) rex |= (uint)((idx>>3)&1)<<1;
+  if( rm >=0 ) rex |= (uint)((rm >>3)&1);
+  if( rex!=0x40U || force ) emit1( a, rex );
+}
+
+/* emit_modrm_mem emits the ModRM (plus SIB and disp32) bytes for the
+   memory operand [base + idx*(1<<scale) + disp]. */
+
+static void
+emit_modrm_mem( fd_vm_jit_asm_t * a,
+                int               reg,
+                int               base,
+                int               idx,
+                int               scale,
+                int               disp ) {
+  if( idx<0 && (base&7)!=RSP ) {
+    emit1( a, 0x80U | ((uint)(reg&7)<<3) | (uint)(base&7) );
+  } else {
+    emit1( a, 0x84U | ((uint)(reg&7)<<3) );
+    uint sib_idx = idx<0 ? 4U : (uint)(idx&7);
+    emit1( a, ((uint)scale<<6) | (sib_idx<<3) | (uint)(base&7) );
+  }
+  emit4( a, (uint)disp );
+}
+
+/* emit_op_rr emits "opc rm, reg" (register direct) with a one or two
+   byte opcode (opc>0xff encodes 0x0f-prefixed opcodes). */
+
+static void
+emit_op_rr( fd_vm_jit_asm_t * a,
+            int               w,
+            uint              opc,
+            int               reg,
+            int               rm ) {
+  emit_rex( a, w, reg, NOREG, rm, 0 );
+  if( opc>0xffU ) emit1( a, opc>>8 );
+  emit1( a, opc&0xffU );
+  emit1( a, 0xc0U | ((uint)(reg&7)<<3) | (uint)(rm&7) );
+}
+
+/* emit_op_rm emits "opc reg, [base + idx*scale + disp]" */
+
+static void
+emit_op_rm( fd_vm_jit_asm_t * a,
+            int               w,
+            uint              opc,
+            int               reg,
+            int               base,
+            int               idx,
+            int               scale,
+            int               disp ) {
+  emit_rex( a, w, reg, idx, base, 0 );
+  if( opc>0xffU ) emit1( a, opc>>8 );
+  emit1( a, opc&0xffU );
+  emit_modrm_mem( a, reg, base, idx, scale, disp );
+}
+
+static void
+emit_alu_ri( fd_vm_jit_asm_t * a,
+             int               w,
+             int               ext,
+             int               rm,
+             uint              imm ) {
+  emit_rex( a, w, NOREG, NOREG, rm, 0 );
+  if( (int)imm>=-128 && (int)imm<=127 ) {
+    emit1( a, 0x83U );
+    emit1( a, 0xc0U | ((uint)ext<<3) | (uint)(rm&7) );
+    emit1( a, imm&0xffU );
+  } else {
+    emit1( a, 0x81U );
+    emit1( a, 0xc0U | ((uint)ext<<3) | (uint)(rm&7) );
+    emit4( a, imm );
+  }
+}
+
+/* emit_alu_mi emits "op qword [FRAME+disp], simm32" */
+
+static void
+emit_alu_mi( fd_vm_jit_asm_t * a,
+             int               ext,
+             int               base,
+             int               disp,
+             uint              imm ) {
+  emit_rex( a, 1, NOREG, NOREG, base, 0 );
+  emit1( a, 0x81U );
+  emit_modrm_mem( a, ext, base, NOREG, 0, disp );
+  emit4( a, imm );
+}
+
+/* emit_mov_mi emits "mov qword [base+disp], simm32" */
+
+static void
+emit_mov_mi( fd_vm_jit_asm_t * a,
+             int               base,
+             int               idx,
+             int               scale,
+             int               disp,
+             uint              imm ) {
+  emit_rex( a, 1, NOREG, idx, base, 0 );
+  emit1( a, 0xc7U );
+  emit_modrm_mem( a, 0, base, idx, scale, disp );
+  emit4( a, imm );
+}
+
+static void
+emit_shift_ri( fd_vm_jit_asm_t * a,
+               int               w,
+               int               ext,
+               int               rm,
+               uint              imm ) {
+  emit_rex( a, w, NOREG, NOREG, rm, 0 );
+  emit1( a, 0xc1U );
+  emit1( a, 0xc0U | ((uint)ext<<3) | (uint)(rm&7) );
+  emit1( a, imm&0xffU );
+}
+
+static void
+emit_shift_rcl( fd_vm_jit_asm_t * a,
+                int               w,
+                int               ext,
+                int               rm ) {
+  emit_rex( a, w, NOREG, NOREG, rm, 0 );
+  emit1( a, 0xd3U );
+  emit1( a, 0xc0U | ((uint)ext<<3) | (uint)(rm&7) );
+}
+
+/* emit_grp3 emits "F7 /ext rm" (neg, div, ...) */
+
+static void
+emit_grp3( fd_vm_jit_asm_t * a,
+           int               w,
+           int               ext,
+           int               rm ) {
+  emit_rex( a, w, NOREG, NOREG, rm, 0 );
+  emit1( a, 0xf7U );
+  emit1( a, 0xc0U | ((uint)ext<<3) | (uint)(rm&7) );
+}
+
+/* emit_mov_r32i loads a zero-extended 32-bit immediate */
+
+static void
+emit_mov_r32i( fd_vm_jit_asm_t * a,
+               int               r,
+               uint              imm ) {
+  emit_rex( a, 0, NOREG, NOREG, r, 0 );
+  emit1( a, 0xb8U + (uint)(r&7) );
+  emit4( a, imm );
+}
+
+/* emit_mov_ri loads an arbitrary 64-bit immediate using the shortest
+   encoding. */
+
+static void
+emit_mov_ri( fd_vm_jit_asm_t * a,
+             int               r,
+             ulong             imm ) {
+  if( imm<=(ulong)UINT_MAX ) {
+    emit_mov_r32i( a, r, (uint)imm );
+  } else if( (long)imm>=(long)INT_MIN && (long)imm<=(long)INT_MAX ) {
+    emit_rex( a, 1, NOREG, NOREG, r, 0 );
+    emit1( a, 0xc7U );
+    emit1( a, 0xc0U | (uint)(r&7) );
+    emit4( a, (uint)imm );
+  } else {
+    emit_rex( a, 1, NOREG, NOREG, r, 0 );
+    emit1( a, 0xb8U + (uint)(r&7) );
+    emit8( a, imm );
+  }
+}
+
+/* emit_jcc_fwd/emit_jmp_fwd emit a jump with a rel32 to be patched
+   with emit_patch_here.  Returns location of rel32. */
+
+static uchar *
+emit_jcc_fwd( fd_vm_jit_asm_t * a,
+              uint              cc ) {
+  emit1( a, 0x0fU );
+  emit1( a, 0x80U | cc );
+  uchar * at = a->cur;
+  emit4( a, 0U );
+  return at;
+}
+
+static uchar *
+emit_jmp_fwd( fd_vm_jit_asm_t * a ) {
+  emit1( a, 0xe9U );
+  uchar * at = a->cur;
+  emit4( a, 0U );
+  return at;
+}
+
+static inline void
+patch_rel32( uchar *       at,
+             uchar const * target ) {
+  FD_STORE( uint, at, (uint)(int)(target - (at+4)) );
+}
+
+static inline void
+emit_patch_here( fd_vm_jit_asm_t * a,
+                 uchar *           at ) {
+  patch_rel32( at, a->cur );
+}
+
+static void
+emit_jcc_to( fd_vm_jit_asm_t * a,
+             uint              cc,
+             uchar const *     target ) {
+  patch_rel32( emit_jcc_fwd( a, cc ), target );
+}
+
+static void
+emit_jmp_to( fd_vm_jit_asm_t * a,
+             uchar const *     target ) {
+  patch_rel32( emit_jmp_fwd( a ), target );
+}
+
+static void
+add_fixup( fd_vm_jit_asm_t * a,
+           uchar *           at,
+           uint              kind,
+           ulong             arg,
+           ulong             cond ) {
+  if( FD_UNLIKELY( a->fixup_cnt>=a->fixup_max ) ) { a->err = 1; return; }
+  fd_vm_jit_fixup_t * f = a->fixup + a->fixup_cnt++;
+  f->at   = (uint)(at - a->code);
+  f->kind = kind;
+  f->arg  = arg;
+  f->cond = cond;
+}
+
+static void
+emit_jmp_pc( fd_vm_jit_asm_t * a,
+             ulong             pc ) {
+  add_fixup( a, emit_jmp_fwd( a ), FD_VM_JIT_FIXUP_PC, pc, 0UL );
+}
+
+static void
+emit_jcc_exit( fd_vm_jit_asm_t * a,
+               uint              cc,
+               ulong             pc,
+               ulong             cond ) {
+  add_fixup( a, emit_jcc_fwd( a, cc ), FD_VM_JIT_FIXUP_EXIT, pc, cond );
+}
+
+static void
+emit_jmp_exit( fd_vm_jit_asm_t * a,
+               ulong             pc,
+               ulong             cond ) {
+  add_fixup( a, emit_jmp_fwd( a ), FD_VM_JIT_FIXUP_EXIT, pc, cond );
+}
+
+/* Code generation helpers ********************************************/
+
+/* emit_regs_load/store move the sBPF register file between the
+   execution context and host registers.  Clobbers r10. */
+
+static void
+emit_regs_load( fd_vm_jit_asm_t * a ) {
+  emit_op_rm( a, 1, 0x8bU, R10, FRAME, NOREG, 0, FRAME_OFF( ctx ) );
+  for( int i=0; i<11; i++ )
+    emit_op_rm( a, 1, 0x8bU, fd_vm_jit_reg[i], R10, NOREG, 0,
+                (int)offsetof( fd_vm_exec_context_t, register_file ) + 8*i );
+}
+
+static void
+emit_regs_store( fd_vm_jit_asm_t * a ) {
+  emit_op_rm( a, 1, 0x8bU, R10, FRAME, NOREG, 0, FRAME_OFF( ctx ) );
+  for( int i=0; i<11; i++ )
+    emit_op_rm( a, 1, 0x89U, fd_vm_jit_reg[i], R10, NOREG, 0,
+                (int)offsetof( fd_vm_exec_context_t, register_file ) + 8*i );
+}
+
+/* emit_branch_acct reproduces BRANCH_POST_CODE's instruction
+   accounting for a branch at pc:
+
+     insns       = pc - start_pc + 1
+     ic         += insns
+     due_insn_cnt += insns - skipped_insns
+     skipped_insns = 0
+
+   Leaves the new due_insn_cnt in rcx. */
+
+static void
+emit_branch_acct( fd_vm_jit_asm_t * a,
+                  ulong             pc,
+                  int               has_ldq ) {
+  emit_mov_r32i( a, RCX, (uint)(pc+1UL) );
+  emit_op_rm   ( a, 1, 0x2bU, RCX, FRAME, NOREG, 0, FRAME_OFF( start_pc ) ); /* sub rcx, [start_pc] */
+  emit_op_rm   ( a, 1, 0x01U, RCX, FRAME, NOREG, 0, FRAME_OFF( ic       ) ); /* add [ic], rcx */
+  if( has_ldq ) {
+    emit_op_rm ( a, 1, 0x2bU, RCX, FRAME, NOREG, 0, FRAME_OFF( skipped  ) ); /* sub rcx, [skipped] */
+    emit_mov_mi( a, FRAME, NOREG, 0, FRAME_OFF( skipped ), 0U );
+  }
+  emit_op_rm   ( a, 1, 0x03U, RCX, FRAME, NOREG, 0, FRAME_OFF( due      ) ); /* add rcx, [due] */
+  emit_op_rm   ( a, 1, 0x89U, RCX, FRAME, NOREG, 0, FRAME_OFF( due      ) ); /* mov [due], rcx */
+}
+
+/* emit_edge enters a new straight line run at a statically known
+   target pc after emit_branch_acct.  Fails the instruction meter
+   check (interp_fault) if due_insn_cnt>=previous_instruction_meter. */
+
+static void
+emit_edge( fd_vm_jit_asm_t * a,
+           ulong             target ) {
+  emit_mov_mi( a, FRAME, NOREG, 0, FRAME_OFF( start_pc ), (uint)target );
+  emit_op_rm ( a, 1, 0x3bU, RCX, FRAME, NOREG, 0, FRAME_OFF( prev ) );      /* cmp rcx, [prev] */
+  add_fixup  ( a, emit_jcc_fwd( a, CC_AE ), FD_VM_JIT_FIXUP_BUDGET, target, 0UL );
+}
+
+/* emit_edge_dyn is emit_edge for a target pc held in r11 (returns and
+   indirect calls).  Jumps to the target through the pc table. */
+
+static void
+emit_edge_dyn( fd_vm_jit_asm_t * a,
+               ulong             instrs_cnt ) {
+  emit_op_rm ( a, 1, 0x89U, R11, FRAME, NOREG, 0, FRAME_OFF( start_pc ) ); /* mov [start_pc], r11 */
+  emit_op_rm ( a, 1, 0x3bU, RCX, FRAME, NOREG, 0, FRAME_OFF( prev ) );     /* cmp rcx, [prev] */
+  emit_jcc_to( a, CC_AE, a->budget_dyn );
+  emit_alu_ri( a, 1, ALU_CMP, R11, (uint)instrs_cnt );
+  emit_jcc_to( a, CC_A, a->badcall_dyn );
+  emit_op_rm ( a, 1, 0x8bU, R10, FRAME, NOREG, 0, FRAME_OFF( pc_tab ) );
+  emit_op_rm ( a, 0, 0xffU, 4, R10, R11, 3, 0 );                           /* jmp [r10+r11*8] */
+}
+
+/* emit_meter_flush reproduces the compute meter update done by the
+   interpreter before a non-relative call:
+
+     compute_meter = sat_sub( compute_meter, due_insn_cnt )
+     due_insn_cnt  = 0
+     previous_instruction_meter = compute_meter */
+
+static void
+emit_meter_flush( fd_vm_jit_asm_t * a ) {
+  emit_op_rm ( a, 1, 0x8bU, RCX, FRAME, NOREG, 0, FRAME_OFF( compute ) );
+  emit_op_rm ( a, 1, 0x2bU, RCX, FRAME, NOREG, 0, FRAME_OFF( due     ) );
+  uchar * no_borrow = emit_jcc_fwd( a, CC_AE );
+  emit_op_rr ( a, 0, 0x31U, RCX, RCX );
+  emit_patch_here( a, no_borrow );
+  emit_op_rm ( a, 1, 0x89U, RCX, FRAME, NOREG, 0, FRAME_OFF( compute ) );
+  emit_op_rm ( a, 1, 0x89U, RCX, FRAME, NOREG, 0, FRAME_OFF( prev    ) );
+  emit_mov_mi( a, FRAME, NOREG, 0, FRAME_OFF( due ), 0U );
+}
+
+/* emit_stack_push reproduces fd_vm_stack_push( &ctx->stack, pc,
+   &register_file[6] ) inline.  Returns location of a rel32 taken on
+   stack overflow (frame not pushed).  Clobbers rcx and r10. */
+
+static uchar *
+emit_stack_push( fd_vm_jit_asm_t * a,
+                 ulong             pc ) {
+  int used_off  = (int)( offsetof( fd_vm_exec_context_t, stack ) + offsetof( fd_vm_stack_t, frames_used ) );
+  int frame_off = (int)( offsetof( fd_vm_exec_context_t, stack ) + offsetof( fd_vm_stack_t, frames ) );
+  FD_STATIC_ASSERT( sizeof(fd_vm_shadow_stack_frame_t)==40UL, jit_layout );
+
+  emit_op_rm ( a, 1, 0x8bU, R10, FRAME, NOREG, 0, FRAME_OFF( ctx ) );
+  emit_op_rm ( a, 1, 0x8bU, RCX, R10, NOREG, 0, used_off );
+  emit_alu_ri( a, 1, ALU_CMP, RCX, FD_VM_STACK_MAX_DEPTH );
+  uchar * overflow = emit_jcc_fwd( a, CC_AE );
+  emit_op_rm ( a, 1, 0x8dU, RCX, RCX, RCX, 2, 0 );                          /* lea rcx, [rcx+rcx*4] */
+  emit_mov_mi( a, R10, RCX, 3, frame_off, (uint)pc );
+  for( int i=0; i<4; i++ )
+    emit_op_rm( a, 1, 0x89U, fd_vm_jit_reg[6+i], R10, RCX, 3, frame_off + 8 + 8*i );
+  emit_alu_mi( a, ALU_ADD, R10, used_off, 1U );
+  return overflow;
+}
+
+/* emit_mem_xlat reproduces fd_vm_translate_vm_to_host_private for the
+   address base+off using the region table in the frame.  Exits with
+   FD_VM_MEM_MAP_ERR_ACC_VIO at pc on access violation.  Leaves the host
+   address in rcx.  Clobbers r10 and r11. */
+
+FD_STATIC_ASSERT( sizeof(fd_vm_mem_region_t)==24UL, region_stride ); /* see lea below */
+
+static void
+emit_mem_xlat( fd_vm_jit_asm_t * a,
+               int               base,
+               int               off,
+               uint              sz,
+               int               write,
+               ulong             pc ) {
+  int sz_off = FRAME_OFF( region ) + (write ? (int)offsetof( fd_vm_mem_region_t, wr_sz ) : (int)offsetof( fd_vm_mem_region_t, rd_sz ));
+
+  emit_op_rm   ( a, 1, 0x8dU, R10, base, NOREG, 0, off );               /* lea r10, [base+off] */
+  emit_op_rr   ( a, 1, 0x89U, R10, R11 );                               /* mov r11, r10 */
+  emit_shift_ri( a, 1, SHIFT_SHR, R11, FD_VM_MEM_MAP_REGION_VIRT_ADDR_BITS );
+  emit_alu_ri  ( a, 1, ALU_CMP, R11, FD_VM_MEM_MAP_REGION_CNT-1UL );
+  emit_jcc_exit( a, CC_A, pc, FD_VM_MEM_MAP_ERR_ACC_VIO );
+  emit_op_rr   ( a, 0, 0x89U, R10, RCX );                               /* mov ecx, r10d */
+  emit_op_rm   ( a, 1, 0x8dU, R10, RCX, NOREG, 0, (int)sz );            /* lea r10, [rcx+sz] */
+  emit_op_rm   ( a, 1, 0x8dU, R11, R11, R11, 1, 0 );                    /* lea r11, [r11+r11*2] */
+  emit_op_rm   ( a, 1, 0x3bU, R10, FRAME, R11, 3, sz_off );             /* cmp r10, [sz] */
+  emit_jcc_exit( a, CC_A, pc, FD_VM_MEM_MAP_ERR_ACC_VIO );
+  emit_op_rm   ( a, 1, 0x03U, RCX, FRAME, R11, 3, FRAME_OFF( region ) ); /* add rcx, [haddr] */
+}
+
+/* emit_div emits unsigned division/modulo of dst by r11 (nonzero
+   divisor checked by caller).  Preserves all sBPF registers but dst.
+   Clobbers rcx and r10. */
+
+static void
+emit_div( fd_vm_jit_asm_t * a,
+          int               w,
+          int               is_mod,
+          int               dst ) {
+  emit_op_rr( a, 1, 0x89U, RAX, R10 );            /* mov r10, rax */
+  emit_op_rr( a, 1, 0x89U, RDX, RCX );            /* mov rcx, rdx */
+  if( dst!=RAX ) emit_op_rr( a, 1, 0x89U, dst, RAX );
+  emit_op_rr( a, 0, 0x31U, RDX, RDX );            /* xor edx, edx */
+  emit_grp3 ( a, w, 6, R11 );                     /* div r11 */
+  emit_op_rr( a, 1, 0x89U, is_mod ? RDX : RAX, R11 );
+  emit_op_rr( a, 1, 0x89U, R10, RAX );
+  emit_op_rr( a, 1, 0x89U, RCX, RDX );
+  emit_op_rr( a, 1, 0x89U, R11, dst );
+}
+
+/* emit_div_reg emits DIV/MOD with a register divisor, including the
+   interpreter's divide by zero behavior (quotient zero, remainder
+   unchanged dividend). */
+
+static void
+emit_div_reg( fd_vm_jit_asm_t * a,
+              int               w,
+              int               is_mod,
+              int               dst,
+              int               src ) {
+  emit_op_rr( a, 1, 0x89U, src, R11 );
+  emit_op_rr( a, w, 0x85U, R11, R11 );            /* test r11, r11 */
+  uchar * zero = emit_jcc_fwd( a, CC_E );
+  emit_div( a, w, is_mod, dst );
+  uchar * done = emit_jmp_fwd( a );
+  emit_patch_here( a, zero );
+  if( !is_mod )  emit_op_rr( a, 0, 0x31U, dst, dst ); /* dst = 0 */
+  else if( !w )  emit_op_rr( a, 0, 0x89U, dst, dst ); /* dst = (uint)dst */
+  emit_patch_here( a, done );
+}
+
+/* emit_cmp_zext compares dst against a zero-extended immediate (the
+   interpreter promotes instr.imm as unsigned in these cases). */
+
+static void
+emit_cmp_zext( fd_vm_jit_asm_t * a,
+               int               dst,
+               uint              imm,
+               int               is_test ) {
+  if( imm<=(uint)INT_MAX ) {
+    if( is_test ) {
+      emit_rex( a, 1, NOREG, NOREG, dst, 0 );
+      emit1( a, 0xf7U );
+      emit1( a, 0xc0U | (uint)(dst&7) );
+      emit4( a, imm );
+    } else {
+      emit_alu_ri( a, 1, ALU_CMP, dst, imm );
+    }
+  } else {
+    emit_mov_r32i( a, R11, imm );
+    emit_op_rr( a, 1, is_test ? 0x85U : 0x39U, R11, dst );
+  }
+}
+
+/* C helpers called from generated code *******************************/
+
+/* fd_vm_jit_syscall reproduces the syscall path of CALL_IMM. */
+
+static ulong
+fd_vm_jit_syscall( fd_vm_jit_frame_t *    f,
+                   fd_vm_syscall_fn_ptr_t fn ) {
+  fd_vm_exec_context_t * ctx = f->ctx;
+  ulong * register_file = ctx->register_file;
+
+  f->compute = fd_ulong_sat_sub( f->compute, f->due );
+  ctx->compute_meter = f->compute;
+  f->due = 0UL;
+  ctx->due_insn_cnt = 0UL;
+
+  ulong cond_fault = fn( ctx, register_file[1], register_file[2], register_file[3], register_file[4], register_file[5], &register_file[0] );
+
+  f->compute = ctx->compute_meter;
+  f->prev    = f->compute;
+  ctx->previous_instruction_meter = f->prev;
+  return cond_fault;
+}
+
+/* Compiler ***********************************************************/
+
+/* fd_vm_jit_emit_prologue emits the entry point and the shared exit
+   paths. */
+
+static void
+fd_vm_jit_emit_prologue( fd_vm_jit_asm_t * a ) {
+
+  /* Entry: save callee saved registers (keeping the stack 16 byte
+     aligned for helper calls), load registers, jump to start_pc */
+
+  emit1( a, 0x53U );                           /* push rbx */
+  emit1( a, 0x55U );                           /* push rbp */
+  emit1( a, 0x41U ); emit1( a, 0x54U );        /* push r12 */
+  emit1( a, 0x41U ); emit1( a, 0x55U );        /* push r13 */
+  emit1( a, 0x41U ); emit1( a, 0x56U );        /* push r14 */
+  emit1( a, 0x41U ); emit1( a, 0x57U );        /* push r15 */
+  emit_alu_ri( a, 1, ALU_SUB, RSP, 8U );
+  emit_op_rr ( a, 1, 0x89U, RDI, FRAME );      /* mov r12, rdi */
+  emit_regs_load( a );
+  emit_op_rm ( a, 1, 0x8bU, R11, FRAME, NOREG, 0, FRAME_OFF( start_pc ) );
+  emit_op_rm ( a, 1, 0x8bU, R10, FRAME, NOREG, 0, FRAME_OFF( pc_tab   ) );
+  emit_op_rm ( a, 0, 0xffU, 4, R10, R11, 3, 0 ); /* jmp [r10+r11*8] */
+
+  /* exit_common: rcx=pc, r11=cond_fault */
+
+  a->exit_common = a->cur;
+  emit_op_rm( a, 1, 0x89U, RCX, FRAME, NOREG, 0, FRAME_OFF( pc         ) );
+  emit_op_rm( a, 1, 0x89U, R11, FRAME, NOREG, 0, FRAME_OFF( cond_fault ) );
+  emit_regs_store( a );
+  emit_alu_ri( a, 1, ALU_ADD, RSP, 8U );
+  emit1( a, 0x41U ); emit1( a, 0x5fU );        /* pop r15 */
+  emit1( a, 0x41U ); emit1( a, 0x5eU );        /* pop r14 */
+  emit1( a, 0x41U ); emit1( a, 0x5dU );        /* pop r13 */
+  emit1( a, 0x41U ); emit1( a, 0x5cU );        /* pop r12 */
+  emit1( a, 0x5dU );                           /* pop rbp */
+  emit1( a, 0x5bU );                           /* pop rbx */
+  emit1( a, 0xc3U );                           /* ret */
+
+  /* budget_common (interp_fault): rcx=pc */
+
+  a->budget_common = a->cur;
+  emit_op_rr( a, 0, 0x31U, R11, R11 );
+  emit_op_rm( a, 1, 0x89U, R11, FRAME, NOREG, 0, FRAME_OFF( compute ) );
+  emit_op_rm( a, 1, 0x89U, R11, FRAME, NOREG, 0, FRAME_OFF( due     ) );
+  emit_op_rm( a, 1, 0x89U, R11, FRAME, NOREG, 0, FRAME_OFF( prev    ) );
+  emit_mov_r32i( a, R11, 1U );
+  emit_jmp_to( a, a->exit_common );
+
+  /* budget_dyn: r11=pc */
+
+  a->budget_dyn = a->cur;
+  emit_op_rr ( a, 1, 0x89U, R11, RCX );
+  emit_jmp_to( a, a->budget_common );
+
+  /* badcall_dyn: r11=pc */
+
+  a->badcall_dyn = a->cur;
+  emit_op_rr   ( a, 1, 0x89U, R11, RCX );
+  emit_mov_r32i( a, R11, FD_VM_COND_FAULT_FLAG_BAD_CALL );
+  emit_jmp_to  ( a, a->exit_common );
+
+  /* overflow_dyn: r11=pc+1 */
+
+  a->overflow_dyn = a->cur;
+  emit_op_rm   ( a, 1, 0x8dU, RCX, R11, NOREG, 0, -1 );  /* lea rcx, [r11-1] */
+  emit_mov_r32i( a, R11, FD_VM_STACK_OP_ERR_PUSH_OVERFLOW );
+  emit_jmp_to  ( a, a->exit_common );
+}
+
+/* fd_vm_jit_emit_instr emits the translation of the instruction at pc.
+   Returns 0 on success or -1 if the instruction cannot be
+   translated. */
+
+static int
+fd_vm_jit_emit_instr( fd_vm_jit_asm_t *            a,
+                      fd_vm_exec_context_t const * ctx,
+                      ulong                        pc,
+                      int                          has_ldq ) {
+
+  fd_sbpf_instr_t const * instrs     = ctx->instrs;
+  ulong                   instrs_cnt = ctx->instrs_sz;
+  fd_sbpf_instr_t         instr      = instrs[ pc ];
+
+  if( FD_UNLIKELY( instr.dst_reg>10 || instr.src_reg>10 ) ) return -1;
+  int  dst = fd_vm_jit_reg[ instr.dst_reg ];
+  int  src = fd_vm_jit_reg[ instr.src_reg ];
+  uint imm = instr.imm;
+  int  off = (int)instr.offset;
+
+  /* Branch target for jumps */
+  long  jmp_dst   = (long)pc + (long)off + 1L;
+  ulong target    = (ulong)jmp_dst;
+  uint  cc        = 0U;
+  int   cmp_kind  = 0;  /* 1: reg, 2: simm, 3: zext imm, 4: test reg, 5: test zext imm */
+
+  switch( instr.opcode.raw ) {
+
+  /* ALU ***************************************************************/
+
+  case 0x00: /* FD_SBPF_OP_ADDL_IMM (executes as ADD_IMM when jumped to) */
+  case 0x04: emit_alu_ri( a, 0, ALU_ADD, dst, imm ); break; /* FD_SBPF_OP_ADD_IMM */
+  case 0x07: emit_alu_ri( a, 1, ALU_ADD, dst, imm ); break; /* FD_SBPF_OP_ADD64_IMM */
+  case 0x0c: emit_op_rr ( a, 0, 0x01U, src, dst   ); break; /* FD_SBPF_OP_ADD_REG */
+  case 0x0f: emit_op_rr ( a, 1, 0x01U, src, dst   ); break; /* FD_SBPF_OP_ADD64_REG */
+  case 0x14: emit_alu_ri( a, 0, ALU_SUB, dst, imm ); break; /* FD_SBPF_OP_SUB_IMM */
+  case 0x17: emit_alu_ri( a, 1, ALU_SUB, dst, imm ); break; /* FD_SBPF_OP_SUB64_IMM */
+  case 0x1c: emit_op_rr ( a, 0, 0x29U, src, dst   ); break; /* FD_SBPF_OP_SUB_REG */
+  case 0x1f: emit_op_rr ( a, 1, 0x29U, src, dst   ); break; /* FD_SBPF_OP_SUB64_REG */
+  case 0x24:                                                /* FD_SBPF_OP_MUL_IMM */
+  case 0x27:                                                /* FD_SBPF_OP_MUL64_IMM */
+    emit_rex( a, instr.opcode.raw==0x27, dst, NOREG, dst, 0 );
+    emit1( a, 0x69U );
+    emit1( a, 0xc0U | ((uint)(dst&7)<<3) | (uint)(dst&7) );
+    emit4( a, imm );
+    break;
+  case 0x2c: emit_op_rr ( a, 0, 0x0fafU, dst, src ); break; /* FD_SBPF_OP_MUL_REG */
+  case 0x2f: emit_op_rr ( a, 1, 0x0fafU, dst, src ); break; /* FD_SBPF_OP_MUL64_REG */
+  case 0x34:                                                /* FD_SBPF_OP_DIV_IMM */
+  case 0x37:                                                /* FD_SBPF_OP_DIV64_IMM */
+    if( !imm ) { emit_op_rr( a, 0, 0x31U, dst, dst ); break; }
+    emit_mov_r32i( a, R11, imm );
+    emit_div( a, instr.opcode.raw==0x37, 0, dst );
+    break;
+  case 0x3c: emit_div_reg( a, 0, 0, dst, src ); break;     /* FD_SBPF_OP_DIV_REG */
+  case 0x3f: emit_div_reg( a, 1, 0, dst, src ); break;     /* FD_SBPF_OP_DIV64_REG */
+  case 0x44: emit_alu_ri( a, 0, ALU_OR,  dst, imm ); break; /* FD_SBPF_OP_OR_IMM */
+  case 0x47: emit_alu_ri( a, 1, ALU_OR,  dst, imm ); break; /* FD_SBPF_OP_OR64_IMM */
+  case 0x4c: emit_op_rr ( a, 0, 0x09U, src, dst   ); break; /* FD_SBPF_OP_OR_REG */
+  case 0x4f: emit_op_rr ( a, 1, 0x09U, src, dst   ); break; /* FD_SBPF_OP_OR64_REG */
+  case 0x54: emit_alu_ri( a, 0, ALU_AND, dst, imm ); break; /* FD_SBPF_OP_AND_IMM */
+  case 0x57: emit_alu_ri( a, 1, ALU_AND, dst, imm ); break; /* FD_SBPF_OP_AND64_IMM */
+  case 0x5c: emit_op_rr ( a, 0, 0x21U, src, dst   ); break; /* FD_SBPF_OP_AND_REG */
+  case 0x5f: emit_op_rr ( a, 1, 0x21U, src, dst   ); break; /* FD_SBPF_OP_AND64_REG */
+  case 0x64: emit_shift_ri( a, 0, SHIFT_SHL, dst, imm ); break; /* FD_SBPF_OP_LSH_IMM */
+  case 0x67: emit_shift_ri( a, 1, SHIFT_SHL, dst, imm ); break; /* FD_SBPF_OP_LSH64_IMM */
+  case 0x6c:                                                    /* FD_SBPF_OP_LSH_REG */
+  case 0x6f:                                                    /* FD_SBPF_OP_LSH64_REG */
+    emit_op_rr( a, 1, 0x89U, src, RCX );
+    emit_shift_rcl( a, instr.opcode.raw==0x6f, SHIFT_SHL, dst );
+    break;
+  case 0x74: emit_shift_ri( a, 0, SHIFT_SHR, dst, imm ); break; /* FD_SBPF_OP_RSH_IMM */
+  case 0x77: emit_shift_ri( a, 1, SHIFT_SHR, dst, imm ); break; /* FD_SBPF_OP_RSH64_IMM */
+  case 0x7c:                                                    /* FD_SBPF_OP_RSH_REG */
+  case 0x7f:                                                    /* FD_SBPF_OP_RSH64_REG */
+    emit_op_rr( a, 1, 0x89U, src, RCX );
+    emit_shift_rcl( a, instr.opcode.raw==0x7f, SHIFT_SHR, dst );
+    break;
+  case 0x84: emit_grp3( a, 0, 3, dst ); break;              /* FD_SBPF_OP_NEG */
+  case 0x87: emit_grp3( a, 1, 3, dst ); break;              /* FD_SBPF_OP_NEG64 */
+  case 0x94:                                                /* FD_SBPF_OP_MOD_IMM */
+    if( !imm ) { emit_op_rr( a, 0, 0x89U, dst, dst ); break; }
+    emit_mov_r32i( a, R11, imm );
+    emit_div( a, 0, 1, dst );
+    break;
+  case 0x97:                                                /* FD_SBPF_OP_MOD64_IMM */
+    if( !imm ) break;
+    emit_mov_r32i( a, R11, imm );
+    emit_div( a, 1, 1, dst );
+    break;
+  case 0x9c: emit_div_reg( a, 0, 1, dst, src ); break;     /* FD_SBPF_OP_MOD_REG */
+  case 0x9f: emit_div_reg( a, 1, 1, dst, src ); break;     /* FD_SBPF_OP_MOD64_REG */
+  case 0xa4: emit_alu_ri( a, 0, ALU_XOR, dst, imm ); break; /* FD_SBPF_OP_XOR_IMM */
+  case 0xa7: emit_alu_ri( a, 1, ALU_XOR, dst, imm ); break; /* FD_SBPF_OP_XOR64_IMM */
+  case 0xac: emit_op_rr ( a, 0, 0x31U, src, dst   ); break; /* FD_SBPF_OP_XOR_REG */
+  case 0xaf: emit_op_rr ( a, 1, 0x31U, src, dst   ); break; /* FD_SBPF_OP_XOR64_REG */
+  case 0xb4: emit_mov_r32i( a, dst, imm ); break;           /* FD_SBPF_OP_MOV_IMM */
+  case 0xb7: emit_mov_ri( a, dst, (ulong)(long)(int)imm ); break; /* FD_SBPF_OP_MOV64_IMM */
+  case 0xbc: emit_op_rr ( a, 0, 0x89U, src, dst   ); break; /* FD_SBPF_OP_MOV_REG */
+  case 0xbf: emit_op_rr ( a, 1, 0x89U, src, dst   ); break; /* FD_SBPF_OP_MOV64_REG */
+  case 0xc4: emit_shift_ri( a, 0, SHIFT_SAR, dst, imm ); break; /* FD_SBPF_OP_ARSH_IMM */
+  case 0xc7: emit_shift_ri( a, 1, SHIFT_SAR, dst, imm ); break; /* FD_SBPF_OP_ARSH64_IMM */
+  case 0xcc:                                                    /* FD_SBPF_OP_ARSH_REG */
+  case 0xcf:                                                    /* FD_SBPF_OP_ARSH64_REG */
+    emit_op_rr( a, 1, 0x89U, src, RCX );
+    emit_shift_rcl( a, instr.opcode.raw==0xcf, SHIFT_SAR, dst );
+    break;
+  case 0xd4: break;                                         /* FD_SBPF_OP_END_LE (host is LE) */
+  case 0xdc:                                                /* FD_SBPF_OP_END_BE */
+    if( imm!=16U && imm!=32U && imm!=64U ) return -1;
+    emit_rex( a, imm==64U, NOREG, NOREG, dst, 0 );
+    emit1( a, 0x0fU );
+    emit1( a, 0xc8U + (uint)(dst&7) );
+    if( imm==16U ) emit_shift_ri( a, 0, SHIFT_SHR, dst, 16U );
+    break;
+
+  case 0x18: { /* FD_SBPF_OP_LDQ */
+    if( FD_UNLIKELY( pc+1UL>=instrs_cnt ) ) return -1;
+    emit_mov_ri( a, dst, (ulong)imm | ((ulong)instrs[ pc+1UL ].imm << 32) );
+    emit_alu_mi( a, ALU_ADD, FRAME, FRAME_OFF( skipped ), 1U );
+    emit_jmp_pc( a, pc+2UL );
+    break;
+  }
+
+  /* Memory ************************************************************/
+
+  case 0x61: case 0x69: case 0x71: case 0x79: { /* FD_SBPF_OP_LDX{W,H,B,DW} */
+    uint sz = instr.opcode.raw==0x61 ? 4U : instr.opcode.raw==0x69 ? 2U : instr.opcode.raw==0x71 ? 1U : 8U;
+    emit_mem_xlat( a, src, off, sz, 0, pc );
+    switch( sz ) {
+    case 1U: emit_op_rm( a, 0, 0x0fb6U, dst, RCX, NOREG, 0, 0 ); break;
+    case 2U: emit_op_rm( a, 0, 0x0fb7U, dst, RCX, NOREG, 0, 0 ); break;
+    case 4U: emit_op_rm( a, 0, 0x8bU,   dst, RCX, NOREG, 0, 0 ); break;
+    case 8U: emit_op_rm( a, 1, 0x8bU,   dst, RCX, NOREG, 0, 0 ); break;
+    }
+    break;
+  }
+
+  case 0x62: case 0x6a: case 0x72: case 0x7a: { /* FD_SBPF_OP_ST{W,H,B,DW} */
+    uint sz = instr.opcode.raw==0x62 ? 4U : instr.opcode.raw==0x6a ? 2U : instr.opcode.raw==0x72 ? 1U : 8U;
+    emit_mem_xlat( a, dst, off, sz, 1, pc );
+    switch( sz ) {
+    case 1U:
+      emit1( a, 0xc6U ); emit_modrm_mem( a, 0, RCX, NOREG, 0, 0 ); emit1( a, imm&0xffU );
+      break;
+    case 2U:
+      emit1( a, 0x66U ); emit1( a, 0xc7U ); emit_modrm_mem( a, 0, RCX, NOREG, 0, 0 );
+      emit1( a, imm&0xffU ); emit1( a, (imm>>8)&0xffU );
+      break;
+    case 4U:
+      emit1( a, 0xc7U ); emit_modrm_mem( a, 0, RCX, NOREG, 0, 0 ); emit4( a, imm );
+      break;
+    case 8U:
+      /* Immediate is zero-extended */
+      if( imm<=(uint)INT_MAX ) {
+        emit_mov_mi( a, RCX, NOREG, 0, 0, imm );
+      } else {
+        emit_mov_r32i( a, R11, imm );
+        emit_op_rm( a, 1, 0x89U, R11, RCX, NOREG, 0, 0 );
+      }
+      break;
+    }
+    break;
+  }
+
+  case 0x63: case 0x6b: case 0x73: case 0x7b: { /* FD_SBPF_OP_STX{W,H,B,DW} */
+    uint sz = instr.opcode.raw==0x63 ? 4U : instr.opcode.raw==0x6b ? 2U : instr.opcode.raw==0x73 ? 1U : 8U;
+    emit_mem_xlat( a, dst, off, sz, 1, pc );
+    switch( sz ) {
+    case 1U:
+      emit_rex( a, 0, src, NOREG, RCX, 1 ); /* REX required to address sil/dil/bpl */
+      emit1( a, 0x88U ); emit_modrm_mem( a, src, RCX, NOREG, 0, 0 );
+      break;
+    case 2U:
+      emit1( a, 0x66U ); emit_op_rm( a, 0, 0x89U, src, RCX, NOREG, 0, 0 );
+      break;
+    case 4U: emit_op_rm( a, 0, 0x89U, src, RCX, NOREG, 0, 0 ); break;
+    case 8U: emit_op_rm( a, 1, 0x89U, src, RCX, NOREG, 0, 0 ); break;
+    }
+    break;
+  }
+
+  /* Branches **********************************************************/
+
+  case 0x05: /* FD_SBPF_OP_JA */
+    if( FD_UNLIKELY( jmp_dst<0L || target>=instrs_cnt ) ) return -1;
+    emit_branch_acct( a, pc, has_ldq );
+    emit_edge( a, target );
+    emit_jmp_pc( a, target );
+    break;
+
+  case 0x15: cc = CC_E;  cmp_kind = 2; break; /* FD_SBPF_OP_JEQ_IMM */
+  case 0x1d: cc = CC_E;  cmp_kind = 1; break; /* FD_SBPF_OP_JEQ_REG */
+  case 0x25: cc = CC_A;  cmp_kind = 2; break; /* FD_SBPF_OP_JGT_IMM */
+  case 0x2d: cc = CC_A;  cmp_kind = 1; break; /* FD_SBPF_OP_JGT_REG */
+  case 0x35: cc = CC_AE; cmp_kind = 3; break; /* FD_SBPF_OP_JGE_IMM */
+  case 0x3d: cc = CC_AE; cmp_kind = 1; break; /* FD_SBPF_OP_JGE_REG */
+  case 0x45: cc = CC_NE; cmp_kind = 5; break; /* FD_SBPF_OP_JSET_IMM */
+  case 0x4d: cc = CC_NE; cmp_kind = 4; break; /* FD_SBPF_OP_JSET_REG */
+  case 0x55: cc = CC_NE; cmp_kind = 2; break; /* FD_SBPF_OP_JNE_IMM */
+  case 0x5d: cc = CC_NE; cmp_kind = 1; break; /* FD_SBPF_OP_JNE_REG */
+  case 0x65: cc = CC_G;  cmp_kind = 2; break; /* FD_SBPF_OP_JSGT_IMM */
+  case 0x6d: cc = CC_G;  cmp_kind = 1; break; /* FD_SBPF_OP_JSGT_REG */
+  case 0x75: cc = CC_GE; cmp_kind = 3; break; /* FD_SBPF_OP_JSGE_IMM */
+  case 0x7d: cc = CC_GE; cmp_kind = 1; break; /* FD_SBPF_OP_JSGE_REG */
+  case 0xa5: cc = CC_B;  cmp_kind = 3; break; /* FD_SBPF_OP_JLT_IMM */
+  case 0xad: cc = CC_B;  cmp_kind = 1; break; /* FD_SBPF_OP_JLT_REG */
+  case 0xb5: cc = CC_BE; cmp_kind = 3; break; /* FD_SBPF_OP_JLE_IMM */
+  case 0xbd: cc = CC_BE; cmp_kind = 1; break; /* FD_SBPF_OP_JLE_REG */
+  case 0xc5: cc = CC_L;  cmp_kind = 3; break; /* FD_SBPF_OP_JSLT_IMM */
+  case 0xcd: cc = CC_L;  cmp_kind = 1; break; /* FD_SBPF_OP_JSLT_REG */
+  case 0xd5: cc = CC_LE; cmp_kind = 3; break; /* FD_SBPF_OP_JSLE_IMM */
+  case 0xdd: cc = CC_LE; cmp_kind = 1; break; /* FD_SBPF_OP_JSLE_REG */
+
+  /* Calls *************************************************************/
+
+  case 0x85: { /* FD_SBPF_OP_CALL_IMM */
+    ulong rel_dst = (ulong)( (long)pc + (long)(int)imm + 1L );
+    if( rel_dst<instrs_cnt ) {
+      /* Relative call */
+      emit_alu_ri( a, 1, ALU_ADD, fd_vm_jit_reg[10], 0x2000U );
+      emit_patch_here( a, emit_stack_push( a, pc ) );
+      emit_branch_acct( a, pc, has_ldq );
+      emit_edge( a, rel_dst );
+      emit_jmp_pc( a, rel_dst );
+      break;
+    }
+
+    fd_sbpf_syscalls_t * syscall = fd_sbpf_syscalls_query( ctx->syscall_map, imm, NULL );
+    if( syscall ) {
+      emit_regs_store( a );
+      emit_op_rr( a, 1, 0x89U, FRAME, RDI );
+      emit_mov_ri( a, RSI, (ulong)syscall->func_ptr );
+      emit_mov_ri( a, RAX, (ulong)fd_vm_jit_syscall );
+      emit1( a, 0xffU ); emit1( a, 0xd0U );          /* call rax */
+      emit_op_rr( a, 1, 0x89U, RAX, R11 );
+      emit_regs_load( a );
+      emit_op_rr( a, 1, 0x85U, R11, R11 );
+      add_fixup( a, emit_jcc_fwd( a, CC_NE ), FD_VM_JIT_FIXUP_EXIT_R11, pc, 0UL );
+      emit_branch_acct( a, pc, has_ldq );
+      emit_edge( a, pc+1UL );
+      break;
+    }
+
+    ulong call_dst = ULONG_MAX;
+    if( ctx->calldests && imm<fd_sbpf_calldests_max( ctx->calldests ) &&
+        fd_sbpf_calldests_test( ctx->calldests, imm ) ) {
+      call_dst = fd_pchash_inverse( imm );
+    } else if( imm==0x71e3cf81U ) {
+      call_dst = (ulong)ctx->entrypoint + 1UL;
+    }
+
+    emit_meter_flush( a );
+    emit_alu_ri( a, 1, ALU_ADD, fd_vm_jit_reg[10], 0x2000U );
+    emit_patch_here( a, emit_stack_push( a, pc ) );
+    if( call_dst==ULONG_MAX ) {
+      emit_jmp_exit( a, pc, 1UL );
+      break;
+    }
+    emit_branch_acct( a, pc, has_ldq );
+    emit_edge( a, call_dst );
+    if( call_dst<instrs_cnt ) emit_jmp_pc  ( a, call_dst );
+    else                      emit_jmp_exit( a, call_dst, FD_VM_COND_FAULT_FLAG_BAD_CALL );
+    break;
+  }
+
+  case 0x8d: { /* FD_SBPF_OP_CALL_REG */
+    if( FD_UNLIKELY( imm>10U ) ) return -1;
+    emit_op_rr   ( a, 1, 0x89U, fd_vm_jit_reg[ imm ], R11 );
+    emit_op_rr   ( a, 0, 0x89U, R11, R11 );                        /* mov r11d, r11d */
+    emit_shift_ri( a, 1, SHIFT_SHR, R11, 3U );
+    emit_op_rm   ( a, 1, 0x8bU, R10, FRAME, NOREG, 0, FRAME_OFF( ctx ) );
+    emit_op_rm   ( a, 1, 0x2bU, R11, R10, NOREG, 0, (int)offsetof( fd_vm_exec_context_t, instrs_offset ) );
+    emit_alu_ri  ( a, 1, ALU_ADD, fd_vm_jit_reg[10], 0x2000U );
+    patch_rel32( emit_stack_push( a, pc ), a->overflow_dyn );
+    emit_branch_acct( a, pc, has_ldq );
+    emit_edge_dyn( a, instrs_cnt-1UL );
+    break;
+  }
+
+  case 0x95: { /* FD_SBPF_OP_EXIT */
+    int used_off  = (int)( offsetof( fd_vm_exec_context_t, stack ) + offsetof( fd_vm_stack_t, frames_used ) );
+    int frame_off = (int)( offsetof( fd_vm_exec_context_t, stack ) + offsetof( fd_vm_stack_t, frames ) );
+    emit_alu_ri( a, 1, ALU_SUB, fd_vm_jit_reg[10], 0x2000U );
+    emit_op_rm ( a, 1, 0x8bU, R10, FRAME, NOREG, 0, FRAME_OFF( ctx ) );
+    emit_op_rm ( a, 1, 0x8bU, RCX, R10, NOREG, 0, used_off );
+    emit_op_rr ( a, 1, 0x85U, RCX, RCX );
+    uchar * root = emit_jcc_fwd( a, CC_E );
+    emit_alu_ri( a, 1, ALU_SUB, RCX, 1U );
+    emit_op_rm ( a, 1, 0x89U, RCX, R10, NOREG, 0, used_off );
+    emit_op_rm ( a, 1, 0x8dU, RCX, RCX, RCX, 2, 0 );               /* lea rcx, [rcx+rcx*4] */
+    emit_op_rm ( a, 1, 0x8bU, R11, R10, RCX, 3, frame_off );
+    for( int i=0; i<4; i++ )
+      emit_op_rm( a, 1, 0x8bU, fd_vm_jit_reg[6+i], R10, RCX, 3, frame_off + 8 + 8*i );
+    emit_alu_ri( a, 1, ALU_ADD, R11, 1U );
+    emit_branch_acct( a, pc, has_ldq );
+    emit_edge_dyn( a, instrs_cnt );
+
+    /* Return from entrypoint */
+    emit_patch_here( a, root );
+    emit_op_rm   ( a, 1, 0x8bU, RCX, FRAME, NOREG, 0, FRAME_OFF( due  ) );
+    emit_op_rm   ( a, 1, 0x3bU, RCX, FRAME, NOREG, 0, FRAME_OFF( prev ) );
+    add_fixup    ( a, emit_jcc_fwd( a, CC_A ), FD_VM_JIT_FIXUP_BUDGET, pc, 0UL );
+    emit_jmp_exit( a, pc, 0UL );
+    break;
+  }
+
+  default:
+    return -1;
+  }
+
+  if( cmp_kind ) {
+    if( FD_UNLIKELY( jmp_dst<0L || target>=instrs_cnt ) ) return -1;
+    emit_branch_acct( a, pc, has_ldq );
+    switch( cmp_kind ) {
+    case 1: emit_op_rr   ( a, 1, 0x39U, src, dst ); break;
+    case 2: emit_alu_ri  ( a, 1, ALU_CMP, dst, imm ); break;
+    case 3: emit_cmp_zext( a, dst, imm, 0 ); break;
+    case 4: emit_op_rr   ( a, 1, 0x85U, src, dst ); break;
+    case 5: emit_cmp_zext( a, dst, imm, 1 ); break;
+    }
+    uchar * not_taken = emit_jcc_fwd( a, cc^1U );
+    emit_edge( a, target );
+    emit_jmp_pc( a, target );
+    emit_patch_here( a, not_taken );
+    emit_edge( a, pc+1UL );
+  }
+
+  return 0;
+}
+
+fd_vm_jit_prog_t *
+fd_vm_jit_prog_new( fd_vm_jit_prog_t *           prog,
+                    fd_vm_exec_context_t const * ctx ) {
+
+  if( FD_UNLIKELY( !prog ) ) {
+    FD_LOG_WARNING(( "NULL prog" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !ctx || !ctx->instrs ) ) {
+    FD_LOG_WARNING(( "NULL ctx" ));
+    return NULL;
+  }
+
+  ulong instrs_cnt = ctx->instrs_sz;
+  if( FD_UNLIKELY( !instrs_cnt || instrs_cnt>(ulong)INT_MAX/FD_VM_JIT_INSTR_MAX ) ) {
+    FD_LOG_WARNING(( "unsupported program size (%lu instructions)", instrs_cnt ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( ctx->entrypoint<0L || (ulong)ctx->entrypoint>=instrs_cnt ) ) {
+    FD_LOG_WARNING(( "entrypoint %ld out of bounds", ctx->entrypoint ));
+    return NULL;
+  }
+
+  int has_ldq = 0;
+  for( ulong i=0UL; i<instrs_cnt; i++ ) has_ldq |= ctx->instrs[i].opcode.raw==FD_SBPF_OP_LDDW;
+
+  /* Allocate pc table, code and scratch fixups */
+
+  ulong page_sz   = FD_SHMEM_NORMAL_PAGE_SZ;
+  ulong tab_sz    = fd_ulong_align_up( (instrs_cnt+1UL)*sizeof(void *), page_sz );
+  ulong code_max  = instrs_cnt*(FD_VM_JIT_INSTR_MAX + FD_VM_JIT_FIXUP_MAX*FD_VM_JIT_STUB_MAX) + FD_VM_JIT_SLACK;
+  ulong mem_sz    = fd_ulong_align_up( tab_sz + code_max, page_sz );
+  ulong fixup_max = FD_VM_JIT_FIXUP_MAX*instrs_cnt + 16UL;
+  ulong fixup_sz  = fd_ulong_align_up( fixup_max*sizeof(fd_vm_jit_fixup_t), page_sz );
+
+  uchar * mem = mmap( NULL, mem_sz, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0 );
+  if( FD_UNLIKELY( mem==MAP_FAILED ) ) {
+    FD_LOG_WARNING(( "mmap(%lu KiB) failed (%i-%s)", mem_sz>>10, errno, fd_io_strerror( errno ) ));
+    return NULL;
+  }
+  fd_vm_jit_fixup_t * fixup = mmap( NULL, fixup_sz, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0 );
+  if( FD_UNLIKELY( fixup==MAP_FAILED ) ) {
+    FD_LOG_WARNING(( "mmap(%lu KiB) failed (%i-%s)", fixup_sz>>10, errno, fd_io_strerror( errno ) ));
+    munmap( mem, mem_sz );
+    return NULL;
+  }
+
+  uchar const ** pc_tab = (uchar const **)fd_type_pun( mem );
+
+  fd_vm_jit_asm_t a[1] = {{
+    .code      = mem + tab_sz,
+    .cur       = mem + tab_sz,
+    .end       = mem + mem_sz,
+    .fixup     = fixup,
+    .fixup_cnt = 0UL,
+    .fixup_max = fixup_max,
+    .err       = 0
+  }};
+
+  fd_vm_jit_emit_prologue( a );
+
+  /* Translate instructions */
+
+  int err = 0;
+  for( ulong pc=0UL; pc<instrs_cnt; pc++ ) {
+    if( FD_UNLIKELY( (ulong)(a->end - a->cur) < FD_VM_JIT_INSTR_MAX+FD_VM_JIT_SLACK ) ) { err = 1; break; }
+    pc_tab[ pc ] = a->cur;
+    uchar const * instr_start = a->cur;
+    if( FD_UNLIKELY( fd_vm_jit_emit_instr( a, ctx, pc, has_ldq ) ) ) {
+      FD_LOG_DEBUG(( "cannot translate opcode %#02x at pc %lu", (uint)ctx->instrs[pc].opcode.raw, pc ));
+      err = 1;
+      break;
+    }
+    if( FD_UNLIKELY( (ulong)(a->cur - instr_start) > FD_VM_JIT_INSTR_MAX ) ) FD_LOG_CRIT(( "instruction too large" ));
+  }
+
+  if( !err ) {
+    /* Falling off the end of the program */
+    pc_tab[ instrs_cnt ] = a->cur;
+    emit_mov_r32i( a, RCX, (uint)instrs_cnt );
+    emit_mov_r32i( a, R11, 1U );
+    emit_jmp_to  ( a, a->exit_common );
+
+    /* Resolve fixups, emitting out-of-line stubs */
+    for( ulong i=0UL; i<a->fixup_cnt; i++ ) {
+      fd_vm_jit_fixup_t const * f = a->fixup + i;
+      uchar * at = a->code + f->at;
+      if( f->kind==FD_VM_JIT_FIXUP_PC ) {
+        patch_rel32( at, pc_tab[ f->arg ] );
+        continue;
+      }
+      if( FD_UNLIKELY( (ulong)(a->end - a->cur) < FD_VM_JIT_STUB_MAX ) ) { err = 1; break; }
+      patch_rel32( at, a->cur );
+      emit_mov_r32i( a, RCX, (uint)f->arg );
+      switch( f->kind ) {
+      case FD_VM_JIT_FIXUP_EXIT:
+        emit_mov_r32i( a, R11, (uint)f->cond );
+        emit_jmp_to( a, a->exit_common );
+        break;
+      case FD_VM_JIT_FIXUP_EXIT_R11:
+        emit_jmp_to( a, a->exit_common );
+        break;
+      case FD_VM_JIT_FIXUP_BUDGET:
+        emit_jmp_to( a, a->budget_common );
+        break;
+      }
+    }
+  }
+
+  err |= a->err;
+  munmap( fixup, fixup_sz );
+
+  if( FD_UNLIKELY( err ) ) {
+    munmap( mem, mem_sz );
+    return NULL;
+  }
+
+  /* Release unused tail of code buffer and seal */
+
+  ulong used_sz = fd_ulong_align_up( (ulong)(a->cur - mem), page_sz );
+  if( used_sz<mem_sz ) {
+    munmap( mem+used_sz, mem_sz-used_sz );
+    mem_sz = used_sz;
+  }
+  if( FD_UNLIKELY( mprotect( mem, mem_sz, PROT_READ|PROT_EXEC ) ) ) {
+    FD_LOG_WARNING(( "mprotect failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+    munmap( mem, mem_sz );
+    return NULL;
+  }
+
+  prog->mem        = mem;
+  prog->mem_sz     = mem_sz;
+  prog->pc_tab     = (void const * const *)pc_tab;
+  prog->entry      = (void (*)( void * ))(ulong)a->code;
+  prog->code_sz    = (ulong)(a->cur - a->code);
+  prog->instrs     = ctx->instrs;
+  prog->instrs_cnt = instrs_cnt;
+  prog->entrypoint = ctx->entrypoint;
+  return prog;
+}
+
+void *
+fd_vm_jit_prog_delete( fd_vm_jit_prog_t * prog ) {
+  if( FD_UNLIKELY( !prog ) ) return NULL;
+  if( prog->mem ) munmap( prog->mem, prog->mem_sz );
+  prog->mem = NULL;
+  return prog;
+}
+
+ulong
+fd_vm_jit_instrs( fd_vm_exec_context_t * ctx ) {
+  fd_vm_jit_prog_t const * prog = ctx->jit;
+  if( FD_UNLIKELY( prog->instrs!=ctx->instrs || prog->instrs_cnt!=ctx->instrs_sz || prog->entrypoint!=ctx->entrypoint ) ) {
+    FD_LOG_WARNING(( "JIT translation does not match program; using interpreter" ));
+    return fd_vm_interp_instrs( ctx );
+  }
+
+  fd_vm_jit_frame_t f[1];
+  f->ctx        = ctx;
+  f->pc_tab     = prog->pc_tab;
+  f->ic         = ctx->instruction_counter;
+  f->due        = ctx->due_insn_cnt;
+  f->prev       = ctx->previous_instruction_meter;
+  f->start_pc   = (ulong)ctx->entrypoint;
+  f->skipped    = 0UL;
+  f->pc         = (ulong)ctx->entrypoint;
+  f->cond_fault = 0UL;
+
+  ulong heap_cus_consumed = fd_ulong_sat_mul(fd_ulong_sat_sub(ctx->heap_sz / (32*1024), 1), vm_compute_budget.heap_cost);
+  f->cond_fault = fd_vm_consume_compute_meter( ctx, heap_cus_consumed );
+  f->compute    = ctx->compute_meter;
+
+  if( FD_LIKELY( !f->cond_fault ) ) {
+    fd_vm_context_region_init( ctx );
+    fd_memcpy( f->region, ctx->region, sizeof(f->region) );
+    prog->entry( f );
+  }
+
+  ctx->compute_meter = f->compute;
+  ctx->due_insn_cnt = f->due;
+  ctx->previous_instruction_meter = f->prev;
+
+  ctx->compute_meter = fd_ulong_sat_sub(ctx->compute_meter, ctx->due_insn_cnt);
+  ctx->due_insn_cnt = 0;
+  ctx->previous_instruction_meter = ctx->compute_meter;
+  ctx->program_counter = f->pc;
+  ctx->instruction_counter = f->ic;
+  ctx->cond_fault = f->cond_fault;
+
+  return 0UL;
+}
+
+#else /* !(FD_HAS_X86 && FD_HAS_HOSTED) */
+
+fd_vm_jit_prog_t *
+fd_vm_jit_prog_new( fd_vm_jit_prog_t *           prog,
+                    fd_vm_exec_context_t const * ctx ) {
+  (void)prog; (void)ctx;
+  FD_LOG_DEBUG(( "JIT not supported on this target" ));
+  return NULL;
+}
+
+void *
+fd_vm_jit_prog_delete( fd_vm_jit_prog_t * prog ) {
+  return prog;
+}
+
+ulong
+fd_vm_jit_instrs( fd_vm_exec_context_t * ctx ) {
+  return fd_vm_interp_instrs( ctx );
+}
+
+#endif
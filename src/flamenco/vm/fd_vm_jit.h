@@ -0,0 +1,88 @@
+#ifndef HEADER_fd_src_flamenco_vm_fd_vm_jit_h
+#define HEADER_fd_src_flamenco_vm_fd_vm_jit_h
+
+/* fd_vm_jit translates a validated sBPF program into native x86-64
+   machine code and executes it in place of the interpreter.
+
+   The interpreter (fd_vm_interp.c) remains the reference
+   implementation.  Translated code reproduces its behavior exactly:
+   register results, memory map, stack frames, compute unit accounting
+   (charged at branches and calls, checked against
+   previous_instruction_meter) and the exit state left in the execution
+   context (program_counter, instruction_counter, compute_meter,
+   cond_fault).  test_vm_interp.c runs both engines side by side and
+   compares their results.
+
+   Generated code pins sBPF registers r0-r10 to host registers, inlines
+   the memory region translation as a bounds checked table lookup and
+   only calls back into C for syscalls.  Programs using opcodes the JIT
+   does not translate (e.g. the unimplemented JMP32 class) are rejected
+   at compile time; callers are expected to fall back to the
+   interpreter in that case.
+
+   The JIT is only available on x86_64 hosted targets.  On other targets
+   fd_vm_jit_prog_new always fails. */
+
+#include "fd_vm_interp.h"
+
+/* fd_vm_jit_prog_t holds the translation of an sBPF program.  The
+   translation is tied to the instruction buffer, syscall map, calldests
+   and entrypoint of the execution context it was compiled from.
+   Memory regions (input, heap size, etc.) are read from the execution
+   context at run time and may differ between executions. */
+
+struct fd_vm_jit_prog {
+  void *                  mem;        /* mmap'ed region holding pc_tab and code */
+  ulong                   mem_sz;     /* size of region in bytes */
+  void const * const *    pc_tab;     /* pc_tab[pc] is host address of instruction pc, indexed [0,instrs_cnt] */
+  void (*                 entry)( void * frame );
+  ulong                   code_sz;    /* bytes of machine code generated */
+
+  fd_sbpf_instr_t const * instrs;     /* Program this was compiled from */
+  ulong                   instrs_cnt;
+  long                    entrypoint;
+};
+
+typedef struct fd_vm_jit_prog fd_vm_jit_prog_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_vm_jit_prog_new compiles the program referenced by ctx (instrs,
+   instrs_sz, syscall_map, calldests, entrypoint) into prog.  The
+   program must have passed fd_vm_context_validate.  Returns prog on
+   success.  On failure (unsupported opcode or target, out of memory)
+   returns NULL and logs details at debug/warning level; prog is left in
+   an unspecified state that does not need to be deleted. */
+
+fd_vm_jit_prog_t *
+fd_vm_jit_prog_new( fd_vm_jit_prog_t *           prog,
+                    fd_vm_exec_context_t const * ctx );
+
+/* fd_vm_jit_prog_delete releases the executable memory held by prog.
+   Returns prog's memory (ownership passed to caller). */
+
+void *
+fd_vm_jit_prog_delete( fd_vm_jit_prog_t * prog );
+
+/* fd_vm_jit_instrs runs the sBPF program of ctx using the compiled
+   translation ctx->jit until completion or a fault occurs.  ctx->jit
+   must have been compiled from ctx->instrs.  Leaves ctx in the same
+   state fd_vm_interp_instrs would.  Returns 0UL (matching
+   fd_vm_interp_instrs, faults are reported via ctx->cond_fault). */
+
+ulong
+fd_vm_jit_instrs( fd_vm_exec_context_t * ctx );
+
+/* fd_vm_exec_instrs runs the sBPF program of ctx with the engine
+   selected by ctx: the JIT if ctx->jit is set, the interpreter
+   otherwise. */
+
+static inline ulong
+fd_vm_exec_instrs( fd_vm_exec_context_t * ctx ) {
+  if( ctx->jit ) return fd_vm_jit_instrs( ctx );
+  return fd_vm_interp_instrs( ctx );
+}
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_flamenco_vm_fd_vm_jit_h */
@@ -1,6 +1,7 @@
 #include "../fd_flamenco_base.h"
 #include "../../ballet/sbpf/fd_sbpf_loader.h"
 #include "fd_vm_interp.h"
+#include "fd_vm_jit.h"
 #include "fd_vm_disasm.h"
 #include "fd_vm_syscalls.h"
 
@@ -222,7 +223,7 @@ int cmd_trace( char const * bin_path, char const * input_path ) {
   return 0;
 }
 
-int cmd_run( char const * bin_path, char const * input_path ) {
+int cmd_run( char const * bin_path, char const * input_path, int use_jit ) {
 
   fd_vm_tool_prog_t tool_prog;
   fd_vm_tool_prog_create( &tool_prog, bin_path );
@@ -249,10 +250,21 @@ int cmd_run( char const * bin_path, char const * input_path ) {
   ctx.register_file[1] = FD_VM_MEM_MAP_INPUT_REGION_START;
   ctx.register_file[10] = FD_VM_MEM_MAP_STACK_REGION_START + 0x1000;
 
+  fd_vm_jit_prog_t jit_prog[1];
+  if( use_jit ) {
+    long dt_jit = -fd_log_wallclock();
+    ctx.jit = fd_vm_jit_prog_new( jit_prog, &ctx );
+    dt_jit += fd_log_wallclock();
+    if( FD_UNLIKELY( !ctx.jit ) ) FD_LOG_WARNING(( "JIT compilation failed, using interpreter" ));
+    else FD_LOG_NOTICE(( "JIT compiled %lu bytes in %ld ns", jit_prog->code_sz, dt_jit ));
+  }
+
   long  dt = -fd_log_wallclock();
-  ulong interp_res = fd_vm_interp_instrs( &ctx );
+  ulong interp_res = fd_vm_exec_instrs( &ctx );
   dt += fd_log_wallclock();
 
+  if( ctx.jit ) fd_vm_jit_prog_delete( jit_prog );
+
   if( interp_res != 0 ) {
     return 1;
   }
@@ -305,6 +317,7 @@ main( int     argc,
   } else if( !strcmp( cmd, "run" ) ) {
     char const * program_file = fd_env_strip_cmdline_cstr( &argc, &argv, "--program-file", NULL, NULL );
     char const * input_file = fd_env_strip_cmdline_cstr( &argc, &argv, "--input-file", NULL, NULL );
+    int          use_jit = fd_env_strip_cmdline_int( &argc, &argv, "--jit", NULL, 0 );
 
     if( FD_UNLIKELY( program_file==NULL ) ) {
       FD_LOG_ERR(( "Please specify a --program-file" ));
@@ -314,7 +327,7 @@ main( int     argc,
       FD_LOG_ERR(( "Please specify a --input-file" ));
     }
 
-    if( FD_UNLIKELY( cmd_run( program_file, input_file ) ) ) {
+    if( FD_UNLIKELY( cmd_run( program_file, input_file, use_jit ) ) ) {
       FD_LOG_ERR(( "error during run" ));
     }
   } else {
@@ -1,9 +1,12 @@
 #include "../fd_flamenco_base.h"
+#include "fd_vm_fuse.h"
 #include "fd_vm_interp.h"
+#include "fd_vm_jit.h"
 #include "fd_vm_syscalls.h"
 #include "../../ballet/base58/fd_base58.h"
 #include "../../ballet/sbpf/fd_sbpf_opcodes.h"
 
+#include <stdio.h>
 #include <stdlib.h>
 
 static ulong accumulator_syscall(FD_FN_UNUSED void * _ctx, ulong arg0, ulong arg1, ulong arg2, ulong arg3, ulong arg4, ulong * ret) {
@@ -11,6 +14,211 @@ static ulong accumulator_syscall(FD_FN_UNUSED void * _ctx, ulong arg0, ulong arg
   return 0;
 }
 
+/* Differential testing **********************************************/
+
+static fd_vm_exec_context_t jit_ref_ctx[1];
+static fd_vm_exec_context_t jit_ctx    [1];
+
+#define JIT_INPUT_SZ (1024UL)
+static uchar jit_input    [ JIT_INPUT_SZ ];
+static uchar jit_ref_input[ JIT_INPUT_SZ ];
+
+/* test_diff_prepare copies init into jit_ref_ctx and jit_ctx, giving
+   each a private copy of the input region. */
+
+static void
+test_diff_prepare( fd_vm_exec_context_t const * init ) {
+  *jit_ref_ctx = *init;
+  *jit_ctx     = *init;
+  if( init->input ) {
+    FD_TEST( init->input_sz<=JIT_INPUT_SZ );
+    fd_memcpy( jit_ref_input, init->input, init->input_sz );
+    fd_memcpy( jit_input,     init->input, init->input_sz );
+    jit_ref_ctx->input = jit_ref_input;
+    jit_ctx->input     = jit_input;
+  }
+}
+
+/* test_diff_check checks that jit_ref_ctx and jit_ctx were left in
+   identical VM state.  name identifies the engine under test. */
+
+static void
+test_diff_check( char const *                 name,
+                 fd_vm_exec_context_t const * init ) {
+  fd_vm_exec_context_t const * ref = jit_ref_ctx;
+  fd_vm_exec_context_t const * jit = jit_ctx;
+  for( ulong i=0UL; i<11UL; i++ ) {
+    if( FD_UNLIKELY( ref->register_file[i]!=jit->register_file[i] ) )
+      FD_LOG_ERR(( "r%lu mismatch (interp %#lx, %s %#lx, pc %lu/%lu ic %lu/%lu fault %lu/%lu)", i, ref->register_file[i], name, jit->register_file[i], ref->program_counter, jit->program_counter, ref->instruction_counter, jit->instruction_counter, ref->cond_fault, jit->cond_fault ));
+  }
+  if( FD_UNLIKELY( ref->program_counter           !=jit->program_counter            ||
+                   ref->instruction_counter       !=jit->instruction_counter        ||
+                   ref->compute_meter             !=jit->compute_meter              ||
+                   ref->due_insn_cnt              !=jit->due_insn_cnt               ||
+                   ref->previous_instruction_meter!=jit->previous_instruction_meter ||
+                   ref->cond_fault                !=jit->cond_fault                 ||
+                   ref->stack.frames_used         !=jit->stack.frames_used ) )
+    FD_LOG_ERR(( "exit state mismatch: interp (pc %lu ic %lu cu %lu fault %lu frames %lu) %s (pc %lu ic %lu cu %lu fault %lu frames %lu)",
+                 ref->program_counter, ref->instruction_counter, ref->compute_meter, ref->cond_fault, ref->stack.frames_used, name,
+                 jit->program_counter, jit->instruction_counter, jit->compute_meter, jit->cond_fault, jit->stack.frames_used ));
+  FD_TEST( !memcmp( ref->stack.frames, jit->stack.frames, ref->stack.frames_used*sizeof(fd_vm_shadow_stack_frame_t) ) );
+  FD_TEST( !memcmp( ref->stack.data,   jit->stack.data,   sizeof(ref->stack.data) ) );
+  FD_TEST( !memcmp( ref->heap,         jit->heap,         sizeof(ref->heap)       ) );
+  if( init->input ) FD_TEST( !memcmp( jit_ref_input, jit_input, init->input_sz ) );
+}
+
+/* test_jit_diff runs the program described by init on both the
+   interpreter and the JIT and checks that they leave identical VM
+   state behind.  Returns 0 if the program could not be compiled (e.g.
+   too large or unsupported target), 1 otherwise. */
+
+static int
+test_jit_diff( fd_vm_exec_context_t const * init ) {
+  fd_vm_jit_prog_t prog[1];
+  if( FD_UNLIKELY( !fd_vm_jit_prog_new( prog, init ) ) ) return 0;
+
+  test_diff_prepare( init );
+  jit_ctx->jit = prog;
+
+  long dt_interp = -fd_log_wallclock();
+  fd_vm_interp_instrs( jit_ref_ctx );
+  dt_interp += fd_log_wallclock();
+
+  long dt_jit = -fd_log_wallclock();
+  fd_vm_exec_instrs( jit_ctx );
+  dt_jit += fd_log_wallclock();
+
+  test_diff_check( "jit", init );
+
+  if( jit_ref_ctx->instruction_counter>=1024UL*1024UL ) {
+    FD_LOG_NOTICE(( "JIT: %lu bytes of code, interp %ldns, jit %ldns (%.2fx)",
+                    prog->code_sz, dt_interp, dt_jit, (double)dt_interp / (double)fd_long_max( dt_jit, 1L ) ));
+  }
+
+  fd_vm_jit_prog_delete( prog );
+  return 1;
+}
+
+/* test_fuse_diff runs the program described by init on the
+   interpreter before and after fd_vm_fuse_instrs and checks that they
+   leave identical VM state behind.  Both versions are then re-run on
+   the tracing interpreter (over at most trace_max instructions) to
+   check that traces match and to count the dispatches performed by
+   each.  Instructions entered through a fused head do not go through
+   the dispatch table, every other instruction executed does.  Counts
+   are logged for long running programs unless quiet is set. */
+
+static void
+test_fuse_diff( fd_vm_exec_context_t const * init,
+                ulong                        trace_max,
+                int                          quiet ) {
+  fd_sbpf_instr_t * fused = malloc( init->instrs_sz*sizeof(fd_sbpf_instr_t) );
+  FD_TEST( fused );
+  ulong pair_cnt = fd_vm_fuse_instrs( fused, init->instrs, init->instrs_sz );
+
+  test_diff_prepare( init );
+  jit_ctx->instrs = fused;
+
+  long dt_interp = -fd_log_wallclock();
+  fd_vm_interp_instrs( jit_ref_ctx );
+  dt_interp += fd_log_wallclock();
+
+  long dt_fused = -fd_log_wallclock();
+  fd_vm_interp_instrs( jit_ctx );
+  dt_fused += fd_log_wallclock();
+
+  test_diff_check( "fused", init );
+
+  /* The trace limit is only checked against the instruction counter,
+     which advances at branches.  Leave room for one more block. */
+
+  ulong trace_sz = trace_max + init->instrs_sz + 1UL;
+  fd_vm_trace_entry_t * ref_trace = malloc( trace_sz*sizeof(fd_vm_trace_entry_t) );
+  fd_vm_trace_entry_t * trace     = malloc( trace_sz*sizeof(fd_vm_trace_entry_t) );
+  FD_TEST( ref_trace && trace );
+  fd_vm_trace_context_t ref_trace_ctx = { .trace_entries_sz = trace_max, .trace_entries = ref_trace, .valloc = fd_libc_alloc_virtual() };
+  fd_vm_trace_context_t trace_ctx     = { .trace_entries_sz = trace_max, .trace_entries = trace,     .valloc = fd_libc_alloc_virtual() };
+
+  test_diff_prepare( init );
+  jit_ctx->instrs        = fused;
+  jit_ref_ctx->trace_ctx = &ref_trace_ctx;
+  jit_ctx->trace_ctx     = &trace_ctx;
+  fd_vm_interp_instrs_trace( jit_ref_ctx );
+  fd_vm_interp_instrs_trace( jit_ctx );
+  test_diff_check( "fused trace", init );
+
+  FD_TEST( ref_trace_ctx.trace_entries_used==trace_ctx.trace_entries_used );
+  FD_TEST( trace_ctx.trace_entries_used<=trace_sz );
+  ulong exec_cnt     = trace_ctx.trace_entries_used;
+  ulong dispatch_cnt = exec_cnt;
+  for( ulong i=0UL; i<exec_cnt; i++ ) {
+    fd_vm_trace_entry_t const * ref = &ref_trace[i];
+    fd_vm_trace_entry_t const * ent = &trace    [i];
+    FD_TEST( ref->pc==ent->pc && ref->ic==ent->ic && ref->cus==ent->cus );
+    FD_TEST( !memcmp( ref->register_file, ent->register_file, sizeof(ref->register_file) ) );
+    if( i && fd_vm_fuse_is_fused( fused[ trace[i-1UL].pc ].opcode.raw ) ) dispatch_cnt--;
+  }
+
+  if( !quiet && exec_cnt>=trace_max ) {
+    FD_LOG_NOTICE(( "Fusion: %lu pairs in %lu instrs, dispatches %lu -> %lu over %lu traced instrs, interp %ldns, fused %ldns (%.2fx)",
+                    pair_cnt, init->instrs_sz, exec_cnt, dispatch_cnt, exec_cnt,
+                    dt_interp, dt_fused, (double)dt_interp / (double)fd_long_max( dt_fused, 1L ) ));
+  }
+
+  free( trace );
+  free( ref_trace );
+  free( fused );
+}
+
+/* test_fuse_elf reports how many instructions of the sBPF program at
+   path fd_vm_fuse_instrs folds into a preceding fused head, i.e. the
+   share of static dispatches saved on real programs.  Accumulates
+   totals into *instr_cnt and *pair_cnt. */
+
+static void
+test_fuse_elf( fd_sbpf_syscalls_t * syscalls,
+               char const *         path,
+               ulong *              instr_cnt,
+               ulong *              pair_cnt ) {
+  FILE * file = fopen( path, "rb" );
+  if( FD_UNLIKELY( !file ) ) {
+    FD_LOG_WARNING(( "fopen(%s) failed, skipping", path ));
+    return;
+  }
+  static uchar elf[ 1UL<<22 ];
+  ulong elf_sz = fread( elf, 1UL, sizeof(elf), file );
+  fclose( file );
+
+  fd_sbpf_elf_info_t info[1];
+  if( FD_UNLIKELY( !fd_sbpf_elf_peek( info, elf, elf_sz ) ) ) {
+    FD_LOG_NOTICE(( "%s: not loadable, skipping", path ));
+    return;
+  }
+  void * rodata   = malloc( (ulong)info->rodata_footprint );
+  void * prog_mem = aligned_alloc( fd_sbpf_program_align(), fd_ulong_align_up( fd_sbpf_program_footprint( info ), fd_sbpf_program_align() ) );
+  FD_TEST( rodata && prog_mem );
+  fd_sbpf_program_t * prog = fd_sbpf_program_new( prog_mem, info, rodata );
+  if( FD_UNLIKELY( !prog || 0!=fd_sbpf_program_load( prog, elf, elf_sz, syscalls ) ) ) {
+    FD_LOG_NOTICE(( "%s: not loadable (%s), skipping", path, fd_sbpf_strerror() ));
+    free( prog_mem );
+    free( rodata );
+    return;
+  }
+
+  fd_sbpf_instr_t const * instrs = (fd_sbpf_instr_t const *)fd_type_pun_const( prog->text );
+  fd_sbpf_instr_t * fused = malloc( prog->text_cnt*sizeof(fd_sbpf_instr_t) );
+  FD_TEST( fused );
+  ulong cnt = fd_vm_fuse_instrs( fused, instrs, prog->text_cnt );
+  FD_LOG_NOTICE(( "%s: %lu pairs in %lu instrs (%.1f%% fewer static dispatches)",
+                  path, cnt, prog->text_cnt, 100.0 * (double)cnt / (double)fd_ulong_max( prog->text_cnt, 1UL ) ));
+  free( fused );
+
+  *instr_cnt += prog->text_cnt;
+  *pair_cnt  += cnt;
+  free( fd_sbpf_program_delete( prog ) );
+  free( rodata );
+}
+
 static void
 test_program_success( char *                test_case_name,
                       ulong                 expected_result,
@@ -18,7 +226,9 @@ test_program_success( char *                test_case_name,
                       fd_sbpf_instr_t *     instrs ) {
   FD_LOG_NOTICE(( "Test program: %s", test_case_name ));
 
-  fd_sbpf_syscalls_t syscalls;
+  static fd_sbpf_syscalls_t _syscalls[ 1UL<<12 ];
+  FD_TEST( sizeof(_syscalls)>=fd_sbpf_syscalls_footprint() );
+  fd_sbpf_syscalls_t * syscalls = fd_sbpf_syscalls_new( _syscalls );
 
   fd_vm_exec_context_t ctx = {
     .entrypoint = 0,
@@ -26,7 +236,10 @@ test_program_success( char *                test_case_name,
     .instruction_counter = 0,
     .instrs = instrs,
     .instrs_sz = instrs_sz,
-    .syscall_map = &syscalls,
+    .syscall_map = syscalls,
+    .compute_meter = ULONG_MAX>>1,
+    .previous_instruction_meter = ULONG_MAX>>1,
+    .heap_sz = FD_VM_DEFAULT_HEAP_SZ,
   };
 
   fd_vm_register_syscall( ctx.syscall_map, "accumulator", accumulator_syscall );
@@ -37,6 +250,11 @@ test_program_success( char *                test_case_name,
   }
   FD_TEST( validation_res==FD_VM_SBPF_VALIDATE_SUCCESS );
 
+  test_jit_diff( &ctx );
+  if( instrs_sz<=(1UL<<20) ) {
+    test_fuse_diff( &ctx, 1UL<<16, 0 );
+  }
+
   long dt = -fd_log_wallclock();
   fd_vm_interp_instrs( &ctx );
   dt += fd_log_wallclock();
@@ -138,6 +356,216 @@ generate_random_alu64_instrs( fd_rng_t * rng, fd_sbpf_instr_t * instrs, ulong in
   instrs[instrs_sz-1].opcode.raw = FD_SBPF_OP_EXIT;
 }
 
+/* generate_random_jit_instrs generates a random valid program mixing
+   ALU, memory, branch, call and exit instructions.  Registers r1, r6
+   and r10 are expected to hold input, heap and stack addresses such
+   that a fair share of memory accesses succeed. */
+
+static void
+generate_random_jit_instrs( fd_rng_t * rng, fd_sbpf_instr_t * instrs, ulong instrs_sz ) {
+  static uchar const alu_ops[] = {
+    0x04, 0x07, 0x0c, 0x0f, 0x14, 0x17, 0x1c, 0x1f, 0x24, 0x27, 0x2c, 0x2f, 0x34, 0x37, 0x3c, 0x3f,
+    0x44, 0x47, 0x4c, 0x4f, 0x54, 0x57, 0x5c, 0x5f, 0x64, 0x67, 0x6c, 0x6f, 0x74, 0x77, 0x7c, 0x7f,
+    0x84, 0x87, 0x94, 0x97, 0x9c, 0x9f, 0xa4, 0xa7, 0xac, 0xaf, 0xb4, 0xb7, 0xbc, 0xbf, 0xc4, 0xc7,
+    0xcc, 0xcf, 0xd4, 0xdc
+  };
+  static uchar const jmp_ops[] = {
+    0x05, 0x15, 0x1d, 0x25, 0x2d, 0x35, 0x3d, 0x45, 0x4d, 0x55, 0x5d, 0x65, 0x6d, 0x75, 0x7d,
+    0xa5, 0xad, 0xb5, 0xbd, 0xc5, 0xcd, 0xd5, 0xdd
+  };
+  static uchar const mem_ops[] = {
+    0x61, 0x69, 0x71, 0x79, 0x62, 0x6a, 0x72, 0x7a, 0x63, 0x6b, 0x73, 0x7b
+  };
+  static uchar const base_regs[] = { 1, 6, 10, 10, 2 };
+
+  ulong jmp_cnt = sizeof(jmp_ops);
+  ulong i = 0UL;
+  while( i<instrs_sz-1UL ) {
+    fd_sbpf_instr_t * instr = &instrs[i];
+    *instr = (fd_sbpf_instr_t){0};
+    uint roll = fd_rng_uint_roll( rng, 100U );
+    uint imm;
+    switch( fd_rng_uint_roll( rng, 4U ) ) {
+    case 0:  imm = 0U;                                      break;
+    case 1:  imm = fd_rng_uint_roll( rng, 64U );            break;
+    case 2:  imm = (uint)-(int)fd_rng_uint_roll( rng, 64U ); break;
+    default: imm = fd_rng_uint( rng );                      break;
+    }
+    if( roll<50U ) {
+      instr->opcode.raw = alu_ops[ fd_rng_ulong_roll( rng, sizeof(alu_ops) ) ];
+      instr->dst_reg    = fd_rng_uchar_roll( rng, 10 ) & 0xFU;
+      instr->src_reg    = fd_rng_uchar_roll( rng, 11 ) & 0xFU;
+      instr->imm        = imm;
+      if( instr->opcode.raw==0xd4 || instr->opcode.raw==0xdc ) instr->imm = 16U << fd_rng_uint_roll( rng, 3U );
+      if( instr->opcode.raw==0xd4 ) instr->imm = fd_uint_min( instr->imm, 64U );
+    } else if( roll<68U ) {
+      instr->opcode.raw = jmp_ops[ fd_rng_ulong_roll( rng, jmp_cnt ) ];
+      instr->dst_reg    = fd_rng_uchar_roll( rng, 10 ) & 0xFU;
+      instr->src_reg    = fd_rng_uchar_roll( rng, 11 ) & 0xFU;
+      instr->imm        = imm;
+    } else if( roll<84U ) {
+      instr->opcode.raw = mem_ops[ fd_rng_ulong_roll( rng, sizeof(mem_ops) ) ];
+      uchar base = base_regs[ fd_rng_ulong_roll( rng, sizeof(base_regs) ) ];
+      uchar val  = fd_rng_uchar_roll( rng, 11 );
+      if( instr->opcode.raw & 0x2 ) { instr->dst_reg = base & 0xFU; instr->src_reg = val & 0xFU;  }
+      else                          { instr->dst_reg = fd_rng_uchar_roll( rng, 10 ) & 0xFU; instr->src_reg = base & 0xFU; }
+      instr->offset     = (short)( (int)fd_rng_uint_roll( rng, 512U ) - 64 );
+      instr->imm        = imm;
+    } else if( roll<88U && i+2UL<instrs_sz ) {
+      static ulong const region[] = { 0x100000000UL, 0x200000000UL, 0x300000000UL, 0x400000000UL, 0UL };
+      ulong val = region[ fd_rng_ulong_roll( rng, 5UL ) ] + fd_rng_ulong_roll( rng, 0x1000UL );
+      if( fd_rng_uint_roll( rng, 4U )==0U ) val = fd_rng_ulong( rng );
+      instr->opcode.raw = FD_SBPF_OP_LDDW;
+      instr->dst_reg    = fd_rng_uchar_roll( rng, 10 ) & 0xFU;
+      instr->imm        = (uint)val;
+      instrs[i+1UL]     = (fd_sbpf_instr_t){0};
+      instrs[i+1UL].opcode.raw = FD_SBPF_OP_ADDL_IMM;
+      instrs[i+1UL].imm = (uint)(val>>32);
+      i++;
+    } else if( roll<94U ) {
+      instr->opcode.raw = FD_SBPF_OP_CALL_IMM;
+      /* relative call, resolved below, or accumulator syscall */
+      instr->imm        = fd_rng_uint_roll( rng, 3U ) ? UINT_MAX : 0x7e6bb1fbU;
+    } else {
+      instr->opcode.raw = FD_SBPF_OP_EXIT;
+    }
+    i++;
+  }
+  instrs[instrs_sz-1UL] = (fd_sbpf_instr_t){0};
+  instrs[instrs_sz-1UL].opcode.raw = FD_SBPF_OP_EXIT;
+
+  /* Resolve branch and call targets (anywhere in the program except
+     LDQ tails and the branch itself).  Calls only go forward, as
+     fd_vm_context_validate consults calldests for negative offsets. */
+
+  for( i=0UL; i<instrs_sz; i++ ) {
+    fd_sbpf_instr_t * instr = &instrs[i];
+    int is_jmp  = (instr->opcode.raw & 0x7)==0x5 && instr->opcode.raw!=FD_SBPF_OP_EXIT && instr->opcode.raw!=FD_SBPF_OP_CALL_IMM;
+    int is_call = instr->opcode.raw==FD_SBPF_OP_CALL_IMM && instr->imm==UINT_MAX;
+    if( !is_jmp && !is_call ) continue;
+    ulong dst = fd_rng_ulong_roll( rng, instrs_sz );
+    if( is_call ) dst = i+1UL + fd_rng_ulong_roll( rng, instrs_sz-i-1UL );
+    if( instrs[dst].opcode.raw==FD_SBPF_OP_ADDL_IMM ) dst--;
+    if( dst==i ) dst++;
+    long rel = (long)dst - (long)i - 1L;
+    if( is_jmp ) instr->offset = (short)rel;
+    else         instr->imm    = (uint)(int)rel;
+  }
+}
+
+/* test_jit_random runs iter_cnt random programs through
+   test_jit_diff and test_fuse_diff. */
+
+static void
+test_jit_random( fd_rng_t * rng,
+                 ulong      iter_cnt ) {
+  static fd_sbpf_syscalls_t _syscalls[ 1UL<<12 ];
+  fd_sbpf_syscalls_t * syscalls = fd_sbpf_syscalls_new( _syscalls );
+  fd_vm_register_syscall( syscalls, "accumulator", accumulator_syscall );
+
+  static fd_vm_exec_context_t ctx[1];
+  static fd_sbpf_instr_t      instrs[ 256 ];
+  static uchar                input [ 256 ];
+  static uchar                rodata[ 64  ];
+
+  ulong compiled_cnt = 0UL;
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    ulong instrs_sz = 2UL + fd_rng_ulong_roll( rng, 255UL );
+    generate_random_jit_instrs( rng, instrs, instrs_sz );
+    for( ulong j=0UL; j<sizeof(input);  j++ ) input [j] = fd_rng_uchar( rng );
+    for( ulong j=0UL; j<sizeof(rodata); j++ ) rodata[j] = fd_rng_uchar( rng );
+
+    memset( ctx, 0, sizeof(fd_vm_exec_context_t) );
+    ctx->entrypoint   = (long)fd_rng_ulong_roll( rng, instrs_sz );
+    if( instrs[ ctx->entrypoint ].opcode.raw==FD_SBPF_OP_ADDL_IMM ) ctx->entrypoint--;
+    ctx->syscall_map  = syscalls;
+    ctx->instrs       = instrs;
+    ctx->instrs_sz    = instrs_sz;
+    ctx->read_only    = rodata;
+    ctx->read_only_sz = sizeof(rodata);
+    ctx->input        = input;
+    ctx->input_sz     = sizeof(input);
+    ctx->heap_sz      = FD_VM_DEFAULT_HEAP_SZ << fd_rng_uint_roll( rng, 2U );
+    ctx->compute_meter              = fd_rng_uint_roll( rng, 2U ) ? fd_rng_ulong_roll( rng, 64UL ) : 100000UL;
+    ctx->previous_instruction_meter = ctx->compute_meter;
+    for( ulong j=0UL; j<10UL; j++ ) ctx->register_file[j] = fd_rng_ulong( rng );
+    ctx->register_file[ 1] = FD_VM_MEM_MAP_INPUT_REGION_START + fd_rng_ulong_roll( rng, 128UL );
+    ctx->register_file[ 6] = FD_VM_MEM_MAP_HEAP_REGION_START  + fd_rng_ulong_roll( rng, 128UL );
+    ctx->register_file[10] = FD_VM_MEM_MAP_STACK_REGION_START + 0x1000UL;
+
+    FD_TEST( fd_vm_context_validate( ctx )==FD_VM_SBPF_VALIDATE_SUCCESS );
+    compiled_cnt += (ulong)test_jit_diff( ctx );
+    test_fuse_diff( ctx, 1024UL, 1 );
+  }
+  FD_LOG_NOTICE(( "JIT: %lu/%lu random programs compared", compiled_cnt, iter_cnt ));
+}
+
+/* test_translate checks fd_vm_translate_vm_to_host{_const} at region
+   boundaries, including zero sized accesses. */
+
+static void
+test_translate( void ) {
+  static fd_vm_exec_context_t ctx[1];
+  static uchar                rodata[ 64  ];
+  static uchar                input [ 128 ];
+
+  memset( ctx, 0, sizeof(fd_vm_exec_context_t) );
+  ctx->read_only    = rodata;
+  ctx->read_only_sz = sizeof(rodata);
+  ctx->input        = input;
+  ctx->input_sz     = sizeof(input);
+  fd_vm_context_region_init( ctx );
+
+  ulong prog = FD_VM_MEM_MAP_PROGRAM_REGION_START;
+  ulong inp  = FD_VM_MEM_MAP_INPUT_REGION_START;
+
+  FD_TEST( fd_vm_translate_vm_to_host_const( ctx, prog,           8UL, 1UL )==rodata    );
+  FD_TEST( fd_vm_translate_vm_to_host_const( ctx, prog,           0UL, 1UL )==rodata    );
+  FD_TEST( fd_vm_translate_vm_to_host_const( ctx, prog+56UL,      8UL, 1UL )==rodata+56 );
+  FD_TEST( fd_vm_translate_vm_to_host_const( ctx, prog+64UL,      0UL, 1UL )==rodata+64 );
+  FD_TEST( !fd_vm_translate_vm_to_host_const( ctx, prog+57UL,     8UL, 1UL ) );
+
+  /* The program region is never writable, not even for sz==0 */
+  FD_TEST( !fd_vm_translate_vm_to_host( ctx, prog,      0UL, 1UL ) );
+  FD_TEST( !fd_vm_translate_vm_to_host( ctx, prog,      8UL, 1UL ) );
+  FD_TEST( !fd_vm_translate_vm_to_host( ctx, prog+8UL,  0UL, 1UL ) );
+
+  FD_TEST( fd_vm_translate_vm_to_host( ctx, inp,        0UL, 1UL )==input     );
+  FD_TEST( fd_vm_translate_vm_to_host( ctx, inp+120UL,  8UL, 1UL )==input+120 );
+  FD_TEST( !fd_vm_translate_vm_to_host( ctx, inp+121UL, 8UL, 1UL ) );
+
+  /* Unmapped addresses */
+  FD_TEST( !fd_vm_translate_vm_to_host_const( ctx, 0UL,      0UL, 1UL ) );
+  FD_TEST( !fd_vm_translate_vm_to_host_const( ctx, 8UL,      0UL, 1UL ) );
+  FD_TEST( !fd_vm_translate_vm_to_host_const( ctx, 5UL<<32,  0UL, 1UL ) );
+  FD_TEST( !fd_vm_translate_vm_to_host      ( ctx, 5UL<<32,  8UL, 1UL ) );
+}
+
+/* test_fuse_overlap checks that fd_vm_fuse_instrs refuses to rewrite
+   program text in place. */
+
+static void
+test_fuse_overlap( void ) {
+  fd_sbpf_instr_t text[4] = {
+    FD_SBPF_INSTR(FD_SBPF_OP_MOV64_REG, FD_SBPF_R1, FD_SBPF_R10, 0, 0),
+    FD_SBPF_INSTR(FD_SBPF_OP_ADD64_IMM, FD_SBPF_R1, 0,           0, 8),
+    FD_SBPF_INSTR(FD_SBPF_OP_MOV64_IMM, FD_SBPF_R0, 0,           0, 0),
+    FD_SBPF_INSTR(FD_SBPF_OP_EXIT,      0,          0,           0, 0),
+  };
+  fd_sbpf_instr_t orig[4]; memcpy( orig, text, sizeof(text) );
+  fd_sbpf_instr_t out [4];
+
+  FD_TEST( !fd_vm_fuse_instrs( text,     text,     4UL ) );
+  FD_TEST( !fd_vm_fuse_instrs( text+1UL, text,     3UL ) );
+  FD_TEST( !fd_vm_fuse_instrs( text,     text+1UL, 3UL ) );
+  FD_TEST( !memcmp( text, orig, sizeof(text) ) );
+
+  FD_TEST( fd_vm_fuse_instrs( out, text, 4UL )==2UL );
+  FD_TEST( !memcmp( text, orig, sizeof(text) ) );
+  FD_TEST( out[0].opcode.raw==FD_VM_FUSED_OP_MOV64_REG_ADD64_IMM );
+  FD_TEST( out[2].opcode.raw==FD_VM_FUSED_OP_MOV64_IMM_EXIT      );
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -145,6 +573,11 @@ main( int     argc,
 
   fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
 
+  test_translate();
+  test_fuse_overlap();
+
+  test_jit_random( rng, 20000UL );
+
   TEST_PROGRAM_SUCCESS("add", 0x3, 5,
     FD_SBPF_INSTR(FD_SBPF_OP_MOV_IMM,   FD_SBPF_R0,  0,      0, 0),
     FD_SBPF_INSTR(FD_SBPF_OP_MOV_IMM,   FD_SBPF_R1,  0,      0, 2),
@@ -819,6 +1252,54 @@ main( int     argc,
     FD_SBPF_INSTR(FD_SBPF_OP_EXIT,      0,      0,      0, 0),
   );
 
+  TEST_PROGRAM_SUCCESS("call-reg", 42, 8,
+    FD_SBPF_INSTR(FD_SBPF_OP_MOV64_IMM, FD_SBPF_R0,  0,      0, 0),
+    FD_SBPF_INSTR(FD_SBPF_OP_MOV64_IMM, FD_SBPF_R2,  0,      0, 5*8),
+    FD_SBPF_INSTR(FD_SBPF_OP_CALL_REG,      0,      0,      0, FD_SBPF_R2),
+    FD_SBPF_INSTR(FD_SBPF_OP_ADD64_IMM, FD_SBPF_R0,  0,      0, 2),
+    FD_SBPF_INSTR(FD_SBPF_OP_EXIT,      0,      0,      0, 0),
+
+    FD_SBPF_INSTR(FD_SBPF_OP_MOV64_IMM, FD_SBPF_R0,  0,      0, 40),
+    FD_SBPF_INSTR(FD_SBPF_OP_EXIT,      0,      0,      0, 0),
+    FD_SBPF_INSTR(FD_SBPF_OP_EXIT,      0,      0,      0, 0),
+  );
+
+  /* Copy loop resembling compiler output.  Two of the six loop
+     instructions are entered through fused heads (load+store,
+     add+jne). */
+
+  TEST_PROGRAM_SUCCESS("fuse-copy-loop", 0x0, 13,
+    FD_SBPF_INSTR(FD_SBPF_OP_LDDW,      FD_SBPF_R1,  0,      0, 0x800),
+    FD_SBPF_INSTR(FD_SBPF_OP_ADDL_IMM,  0,      0,      0, 0x2),
+    FD_SBPF_INSTR(FD_SBPF_OP_MOV64_REG, FD_SBPF_R2,  FD_SBPF_R1,  0, 0),
+    FD_SBPF_INSTR(FD_SBPF_OP_ADD64_IMM, FD_SBPF_R2,  0,      0, 0x100),
+    FD_SBPF_INSTR(FD_SBPF_OP_MOV64_IMM, FD_SBPF_R3,  0,      0, 0),
+    FD_SBPF_INSTR(FD_SBPF_OP_LDXDW,     FD_SBPF_R4,  FD_SBPF_R1,  0, 0),
+    FD_SBPF_INSTR(FD_SBPF_OP_STXDW,     FD_SBPF_R2,  FD_SBPF_R4,  8, 0),
+    FD_SBPF_INSTR(FD_SBPF_OP_ADD64_IMM, FD_SBPF_R4,  0,      0, 1),
+    FD_SBPF_INSTR(FD_SBPF_OP_STXDW,     FD_SBPF_R1,  FD_SBPF_R4,  0, 0),
+    FD_SBPF_INSTR(FD_SBPF_OP_ADD64_IMM, FD_SBPF_R3,  0,      0, 1),
+    FD_SBPF_INSTR(FD_SBPF_OP_JNE_IMM,   FD_SBPF_R3,  0,     -6, 1024*1024),
+    FD_SBPF_INSTR(FD_SBPF_OP_MOV64_IMM, FD_SBPF_R0,  0,      0, 0),
+    FD_SBPF_INSTR(FD_SBPF_OP_EXIT,      0,      0,      0, 0),
+  );
+
+  /* Static fusion statistics on real programs (sBPF ELF files given
+     on the command line, e.g. the ones in corpus/fuzz_sbpf_loader) */
+
+  if( argc>1 ) {
+    static fd_sbpf_syscalls_t _elf_syscalls[ 1UL<<12 ];
+    FD_TEST( sizeof(_elf_syscalls)>=fd_sbpf_syscalls_footprint() );
+    fd_sbpf_syscalls_t * elf_syscalls = fd_sbpf_syscalls_join( fd_sbpf_syscalls_new( _elf_syscalls ) );
+    fd_vm_syscall_register_all( elf_syscalls );
+    ulong instr_cnt = 0UL;
+    ulong pair_cnt  = 0UL;
+    for( int i=1; i<argc; i++ ) test_fuse_elf( elf_syscalls, argv[i], &instr_cnt, &pair_cnt );
+    FD_LOG_NOTICE(( "Fusion corpus: %lu pairs in %lu instrs (%.1f%% fewer static dispatches)",
+                    pair_cnt, instr_cnt, 100.0 * (double)pair_cnt / (double)fd_ulong_max( instr_cnt, 1UL ) ));
+    fd_sbpf_syscalls_delete( fd_sbpf_syscalls_leave( elf_syscalls ) );
+  }
+
   ulong instrs_sz = 128*1024*1024;
   fd_sbpf_instr_t * instrs = malloc( sizeof(fd_sbpf_instr_t) * instrs_sz );
 
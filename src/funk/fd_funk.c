@@ -139,6 +139,10 @@ fd_funk_new( void * shmem,
 
   funk->alloc_gaddr = fd_wksp_gaddr_fast( wksp, alloc ); /* Note that this persists the join until delete */
 
+  funk->cold_fd   = -1;
+  funk->cold_off  = 0UL;
+  funk->cold_slot = 0UL;
+
   ulong tmp_max;
   fd_funk_partvec_t * partvec = (fd_funk_partvec_t *)fd_alloc_malloc_at_least( alloc, fd_funk_partvec_align(), fd_funk_partvec_footprint(0U), &tmp_max );
   if( FD_UNLIKELY( !partvec ) ) {
@@ -23,7 +23,10 @@
    maximum number of records that can be held by a funk instance is set
    when that it was created (given the persistent and relocatable
    properties described below though, it is straightforward to resize
-   this).
+   this).  The values of published records that have not been used for
+   a while can optionally be evicted to a cold file such that only the
+   record metadata of the full state needs to be in workspace memory
+   (see fd_funk_cold.h).
 
    The transaction model is richer than what is found in a regular
    database.  A transaction is a xid-"updates to parent transaction"
@@ -107,7 +110,8 @@
    small O(1) space (e.g. in complex transaction tree operations, there
    is no use of dynamic allocation to hold temporaries and no use of
    recursion to bound stack utilization at trivial levels).  Further,
-   there are no explicit operating system calls and, given a well
+   outside of the optional cold tier, there are no explicit operating
+   system calls and, given a well
    optimized workspace (i.e. the wksp pages fit within a core's TLBs) no
    implicit operating system calls.  Critical operations (e.g. those
    that actually might impact transaction history) are fortified against
@@ -144,6 +148,7 @@
 //#include "fd_funk_rec.h"  /* Includes fd_funk_txn.h */
 #include "fd_funk_val.h"    /* Includes fd_funk_rec.h */
 #include "fd_funk_part.h"
+#include "fd_funk_cold.h"
 
 /* FD_FUNK_{ALIGN,FOOTPRINT} describe the alignment and footprint needed
    for a funk.  ALIGN should be a positive integer power of 2.
@@ -156,7 +161,7 @@
 /* The details of a fd_funk_private are exposed here to facilitate
    inlining various operations. */
 
-#define FD_FUNK_MAGIC (0xf17eda2ce7fc2c00UL) /* firedancer funk version 0 */
+#define FD_FUNK_MAGIC (0xf17eda2ce7fc2c01UL) /* firedancer funk version 1 */
 
 struct __attribute__((aligned(FD_FUNK_ALIGN))) fd_funk_private {
 
@@ -256,6 +261,23 @@ struct __attribute__((aligned(FD_FUNK_ALIGN))) fd_funk_private {
 
   ulong alloc_gaddr; /* Non-zero wksp gaddr with tag wksp tag */
 
+  /* The funk cold tier holds the values of published records that were
+     evicted from the wksp.  More details are given in fd_funk_cold.h.
+
+     cold_fd is the file descriptor of the cold file in the process that
+     attached it, -1 if no cold file is attached.  Like a local join, it
+     is only meaningful to the process that attached the file.
+
+     cold_off is the number of bytes appended to the cold file so far.
+     The cold values of all records are in [0,cold_off).
+
+     cold_slot is the slot of the most recent eviction.  Records are
+     stamped with it when they are inserted, queried or modified. */
+
+  int   cold_fd;
+  ulong cold_off;
+  ulong cold_slot;
+
   /* Padding to FD_FUNK_ALIGN here */
 };
 
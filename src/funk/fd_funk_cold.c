@@ -0,0 +1,351 @@
+#include "fd_funk.h"
+
+#if FD_HAS_HOSTED
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/* fd_funk_cold_private_{write,read} {write,read} sz bytes at file
+   offset off of fd, retrying on partial transfers and interrupts.
+   Return 0 on success and an errno compatible error code on failure
+   (EPROTO for a read past the end of file). */
+
+static int
+fd_funk_cold_private_write( int          fd,
+                            void const * buf,
+                            ulong        sz,
+                            ulong        off ) {
+  uchar const * p = (uchar const *)buf;
+  while( sz ) {
+    long wsz = (long)pwrite( fd, p, sz, (off_t)off );
+    if( FD_UNLIKELY( wsz<0L ) ) {
+      if( errno==EINTR ) continue;
+      return errno;
+    }
+    p += wsz; sz -= (ulong)wsz; off += (ulong)wsz;
+  }
+  return 0;
+}
+
+static int
+fd_funk_cold_private_read( int    fd,
+                           void * buf,
+                           ulong  sz,
+                           ulong  off ) {
+  uchar * p = (uchar *)buf;
+  while( sz ) {
+    long rsz = (long)pread( fd, p, sz, (off_t)off );
+    if( FD_UNLIKELY( rsz<=0L ) ) {
+      if( !rsz ) return EPROTO; /* Truncated cold file */
+      if( errno==EINTR ) continue;
+      return errno;
+    }
+    p += rsz; sz -= (ulong)rsz; off += (ulong)rsz;
+  }
+  return 0;
+}
+
+#endif
+
+int
+fd_funk_cold_attach( fd_funk_t * funk,
+                     int         fd ) {
+
+  if( FD_UNLIKELY( !funk ) ) {
+    FD_LOG_WARNING(( "NULL funk" ));
+    return FD_FUNK_ERR_INVAL;
+  }
+
+  if( FD_UNLIKELY( fd<0 ) ) {
+    FD_LOG_WARNING(( "bad fd" ));
+    return FD_FUNK_ERR_INVAL;
+  }
+
+  if( FD_UNLIKELY( funk->cold_fd>=0 ) ) {
+    FD_LOG_WARNING(( "a cold file is already attached" ));
+    return FD_FUNK_ERR_INVAL;
+  }
+
+# if FD_HAS_HOSTED
+  struct stat st[1];
+  if( FD_UNLIKELY( fstat( fd, st ) ) ) {
+    FD_LOG_WARNING(( "fstat failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+    return FD_FUNK_ERR_SYS;
+  }
+
+  if( FD_UNLIKELY( (ulong)st->st_size < funk->cold_off ) ) {
+    FD_LOG_WARNING(( "cold file too small (%lu bytes, expected at least %lu bytes)", (ulong)st->st_size, funk->cold_off ));
+    return FD_FUNK_ERR_SYS;
+  }
+
+  funk->cold_fd = fd;
+  return FD_FUNK_SUCCESS;
+# else
+  FD_LOG_WARNING(( "cold tier requires FD_HAS_HOSTED capabilities" ));
+  return FD_FUNK_ERR_SYS;
+# endif
+}
+
+int
+fd_funk_cold_detach( fd_funk_t * funk ) {
+  if( FD_UNLIKELY( !funk ) ) return -1;
+  int fd = funk->cold_fd;
+  funk->cold_fd = -1;
+  return fd;
+}
+
+int   fd_funk_cold_fd  ( fd_funk_t const * funk ) { return funk->cold_fd;   }
+ulong fd_funk_cold_sz  ( fd_funk_t const * funk ) { return funk->cold_off;  }
+ulong fd_funk_cold_slot( fd_funk_t const * funk ) { return funk->cold_slot; }
+
+void
+fd_funk_cold_touch( fd_funk_t *           funk,
+                    fd_funk_rec_t const * rec ) {
+  ((fd_funk_rec_t *)rec)->touch_slot = funk->cold_slot;
+}
+
+ulong
+fd_funk_cold_evict( fd_funk_t * funk,
+                    ulong       slot,
+                    ulong       age,
+                    ulong       max_cnt,
+                    int *       opt_err ) {
+
+  if( FD_UNLIKELY( !funk ) ) {
+    fd_int_store_if( !!opt_err, opt_err, FD_FUNK_ERR_INVAL );
+    return 0UL;
+  }
+
+  int fd = funk->cold_fd;
+  if( FD_UNLIKELY( fd<0 ) ) {
+    fd_int_store_if( !!opt_err, opt_err, FD_FUNK_ERR_INVAL );
+    return 0UL;
+  }
+
+  funk->cold_slot = slot;
+
+# if FD_HAS_HOSTED
+  fd_wksp_t *     wksp    = fd_funk_wksp( funk );
+  fd_funk_rec_t * rec_map = fd_funk_rec_map( funk, wksp );
+  fd_alloc_t *    alloc   = fd_funk_alloc( funk, wksp );
+  ulong           rec_max = funk->rec_max;
+
+  ulong cold_off  = funk->cold_off;
+  ulong evict_cnt = 0UL;
+  int   err       = FD_FUNK_SUCCESS;
+
+  /* Iterate over the records of the last published transaction from
+     oldest to youngest */
+
+  ulong rec_idx = funk->rec_head_idx;
+  while( !fd_funk_rec_idx_is_null( rec_idx ) && evict_cnt<max_cnt ) {
+
+    if( FD_UNLIKELY( rec_idx>=rec_max ) ) FD_LOG_CRIT(( "memory corruption detected (bad idx)" ));
+    fd_funk_rec_t * rec = rec_map + rec_idx;
+    rec_idx = rec->next_idx;
+
+    ulong val_sz = (ulong)rec->val_sz;
+
+    if( (!val_sz) | (!!(rec->flags & (FD_FUNK_REC_FLAG_ERASE | FD_FUNK_REC_FLAG_COLD))) ) continue; /* Nothing to evict */
+    if( (slot<rec->touch_slot) || ((slot-rec->touch_slot)<age) ) continue; /* Used recently */
+
+    /* Append the value to the cold file.  We write the value before the
+       header such that a torn append never looks like a valid value. */
+
+    fd_funk_cold_hdr_t hdr[1];
+    hdr->magic  = FD_FUNK_COLD_MAGIC;
+    hdr->val_sz = val_sz;
+    fd_funk_rec_key_copy( hdr->key, rec->pair.key );
+
+    uchar pad[ FD_FUNK_COLD_ALIGN ] = {0};
+    ulong blob_sz = fd_funk_cold_blob_sz( val_sz );
+    ulong pad_sz  = blob_sz - sizeof(fd_funk_cold_hdr_t) - val_sz;
+
+    int ioerr = fd_funk_cold_private_write( fd, fd_wksp_laddr_fast( wksp, rec->val_gaddr ), val_sz, cold_off + sizeof(fd_funk_cold_hdr_t) );
+    if( FD_LIKELY( !ioerr ) && pad_sz ) ioerr = fd_funk_cold_private_write( fd, pad, pad_sz, cold_off + blob_sz - pad_sz );
+    if( FD_LIKELY( !ioerr ) ) ioerr = fd_funk_cold_private_write( fd, hdr, sizeof(fd_funk_cold_hdr_t), cold_off );
+    if( FD_UNLIKELY( ioerr ) ) {
+      FD_LOG_WARNING(( "cold file write failed (%i-%s)", ioerr, fd_io_strerror( ioerr ) ));
+      err = FD_FUNK_ERR_SYS;
+      break;
+    }
+
+    /* Release the wksp value and turn the record into a stub */
+
+    fd_funk_val_flush( rec, alloc, wksp );
+    rec->val_sz    = (uint)val_sz;
+    rec->cold_off  = cold_off;
+    rec->flags    |= FD_FUNK_REC_FLAG_COLD;
+
+    cold_off += blob_sz;
+    evict_cnt++;
+  }
+
+  funk->cold_off = cold_off;
+
+  fd_int_store_if( !!opt_err, opt_err, err );
+  return evict_cnt;
+# else
+  (void)age; (void)max_cnt;
+  fd_int_store_if( !!opt_err, opt_err, FD_FUNK_ERR_SYS );
+  return 0UL;
+# endif
+}
+
+int
+fd_funk_cold_load( fd_funk_t *           funk,
+                   fd_funk_rec_t const * _rec ) {
+
+  if( FD_UNLIKELY( (!funk) | (!_rec) ) ) return FD_FUNK_ERR_INVAL;
+
+  fd_wksp_t * wksp = fd_funk_wksp( funk );
+
+  fd_funk_rec_t * rec_map = fd_funk_rec_map( funk, wksp );
+
+  ulong rec_max = funk->rec_max;
+
+  ulong rec_idx = (ulong)(_rec - rec_map);
+
+  if( FD_UNLIKELY( (rec_idx>=rec_max) /* Out of map (incl NULL) */ | (_rec!=(rec_map+rec_idx)) /* Bad alignment */ ) )
+    return FD_FUNK_ERR_INVAL;
+
+  fd_funk_rec_t * rec = rec_map + rec_idx;
+
+  if( FD_LIKELY( !(rec->flags & FD_FUNK_REC_FLAG_COLD) ) ) return FD_FUNK_SUCCESS;
+
+# if FD_HAS_HOSTED
+  int fd = funk->cold_fd;
+  if( FD_UNLIKELY( fd<0 ) ) {
+    FD_LOG_WARNING(( "no cold file attached" ));
+    return FD_FUNK_ERR_SYS;
+  }
+
+  ulong val_sz   = (ulong)rec->val_sz;
+  ulong cold_off = rec->cold_off;
+
+  /* Allocate first such that we haven't affected the state if it
+     fails */
+
+  fd_alloc_t * alloc = fd_funk_alloc( funk, wksp );
+
+  ulong   val_max;
+  uchar * val = (uchar *)fd_alloc_malloc_at_least( alloc, 1UL, val_sz, &val_max );
+  if( FD_UNLIKELY( !val ) ) return FD_FUNK_ERR_MEM;
+
+  fd_funk_cold_hdr_t hdr[1];
+  int ioerr = fd_funk_cold_private_read( fd, hdr, sizeof(fd_funk_cold_hdr_t), cold_off );
+  if( FD_LIKELY( !ioerr ) ) ioerr = fd_funk_cold_private_read( fd, val, val_sz, cold_off + sizeof(fd_funk_cold_hdr_t) );
+  if( FD_UNLIKELY( ioerr ) ) {
+    FD_LOG_WARNING(( "cold file read failed (%i-%s)", ioerr, fd_io_strerror( ioerr ) ));
+    fd_alloc_free( alloc, val );
+    return FD_FUNK_ERR_SYS;
+  }
+
+  if( FD_UNLIKELY( (hdr->magic!=FD_FUNK_COLD_MAGIC) | (hdr->val_sz!=val_sz) | (!fd_funk_rec_key_eq( hdr->key, rec->pair.key )) ) ) {
+    FD_LOG_WARNING(( "cold file corrupt at offset %lu", cold_off ));
+    fd_alloc_free( alloc, val );
+    return FD_FUNK_ERR_SYS;
+  }
+
+  fd_memset( val + val_sz, 0, val_max - val_sz );
+
+  rec->val_max   = (uint)fd_ulong_min( val_max, FD_FUNK_REC_VAL_MAX );
+  rec->val_gaddr = fd_wksp_gaddr_fast( wksp, val );
+  rec->cold_off  = 0UL;
+  rec->flags    &= ~FD_FUNK_REC_FLAG_COLD;
+
+  fd_funk_cold_touch( funk, rec );
+
+  return FD_FUNK_SUCCESS;
+# else
+  return FD_FUNK_ERR_SYS;
+# endif
+}
+
+int
+fd_funk_cold_read( fd_funk_t *           funk,
+                   fd_funk_rec_t const * rec,
+                   ulong                 off,
+                   void *                buf,
+                   ulong                 sz ) {
+
+  if( FD_UNLIKELY( (!funk) | (!rec) | (!buf) ) ) return FD_FUNK_ERR_INVAL;
+
+  fd_wksp_t * wksp = fd_funk_wksp( funk );
+
+  fd_funk_rec_t const * rec_map = fd_funk_rec_map( funk, wksp );
+
+  ulong rec_max = funk->rec_max;
+
+  ulong rec_idx = (ulong)(rec - rec_map);
+
+  if( FD_UNLIKELY( (rec_idx>=rec_max) /* Out of map (incl NULL) */ | (rec!=(rec_map+rec_idx)) /* Bad alignment */ ) )
+    return FD_FUNK_ERR_INVAL;
+
+  ulong val_sz = (ulong)rec->val_sz;
+  if( FD_UNLIKELY( (!(rec->flags & FD_FUNK_REC_FLAG_COLD)) | (off>val_sz) | (sz>val_sz-off) ) ) return FD_FUNK_ERR_INVAL;
+
+# if FD_HAS_HOSTED
+  int fd = funk->cold_fd;
+  if( FD_UNLIKELY( fd<0 ) ) {
+    FD_LOG_WARNING(( "no cold file attached" ));
+    return FD_FUNK_ERR_SYS;
+  }
+
+  ulong cold_off = rec->cold_off;
+
+  int ioerr = 0;
+  if( !off ) {
+    fd_funk_cold_hdr_t hdr[1];
+    ioerr = fd_funk_cold_private_read( fd, hdr, sizeof(fd_funk_cold_hdr_t), cold_off );
+    if( FD_UNLIKELY( (!ioerr) &&
+                     ((hdr->magic!=FD_FUNK_COLD_MAGIC) | (hdr->val_sz!=val_sz) | (!fd_funk_rec_key_eq( hdr->key, rec->pair.key ))) ) ) {
+      FD_LOG_WARNING(( "cold file corrupt at offset %lu", cold_off ));
+      return FD_FUNK_ERR_SYS;
+    }
+  }
+  if( FD_LIKELY( !ioerr ) ) ioerr = fd_funk_cold_private_read( fd, buf, sz, cold_off + sizeof(fd_funk_cold_hdr_t) + off );
+  if( FD_UNLIKELY( ioerr ) ) {
+    FD_LOG_WARNING(( "cold file read failed (%i-%s)", ioerr, fd_io_strerror( ioerr ) ));
+    return FD_FUNK_ERR_SYS;
+  }
+
+  return FD_FUNK_SUCCESS;
+# else
+  return FD_FUNK_ERR_SYS;
+# endif
+}
+
+ulong
+fd_funk_cold_prefetch( fd_funk_t *               funk,
+                       fd_funk_txn_t const *     txn,
+                       fd_funk_rec_key_t const * keys,
+                       ulong                     key_cnt ) {
+
+  if( FD_UNLIKELY( (!funk) | (!keys) ) ) return 0UL;
+
+# if FD_HAS_HOSTED
+  int fd = funk->cold_fd;
+  if( FD_UNLIKELY( fd<0 ) ) return 0UL;
+
+  ulong prefetch_cnt = 0UL;
+  for( ulong key_idx=0UL; key_idx<key_cnt; key_idx++ ) {
+    fd_funk_rec_t const * rec = fd_funk_rec_query_global_const( funk, txn, keys + key_idx );
+    if( FD_LIKELY( (!rec) || !(rec->flags & FD_FUNK_REC_FLAG_COLD) ) ) continue;
+
+    /* Ask the kernel to start reading the value into the page cache.
+       This returns immediately.  Failures here are harmless (the
+       subsequent load will just do a synchronous read). */
+
+    (void)posix_fadvise( fd, (off_t)rec->cold_off, (off_t)fd_funk_cold_blob_sz( (ulong)rec->val_sz ), POSIX_FADV_WILLNEED );
+    prefetch_cnt++;
+  }
+
+  return prefetch_cnt;
+# else
+  (void)txn; (void)key_cnt;
+  return 0UL;
+# endif
+}
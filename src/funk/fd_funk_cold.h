@@ -0,0 +1,206 @@
+#ifndef HEADER_fd_src_funk_fd_funk_cold_h
+#define HEADER_fd_src_funk_fd_funk_cold_h
+
+/* This provides APIs for managing the funk cold tier.  It is generally
+   not meant to be included directly.  Use fd_funk.h instead.
+
+   The cold tier lets a funk hold a state much larger than the memory
+   backing its wksp.  The values of published records that have not
+   been used for a while are evicted to a cold file and their wksp
+   allocations are freed.  The record metadata stays in the wksp such
+   that records of a cold value are still indexed, iterated, published
+   over, erased, etc exactly as before (only the value is missing).
+
+   The cold file is append-only.  Each evicted value is stored as a
+   fd_funk_cold_hdr_t followed by the value bytes, padded to
+   FD_FUNK_COLD_ALIGN.  Thus the file is self-describing, can be mmaped
+   and scanned by offline tools and values are never overwritten in
+   place.  When a cold value is superseded (e.g. a record is updated by
+   a publish or removed), its bytes are left in the file as dead space.
+   Reclaiming dead space requires recreating the file (e.g. on restart,
+   load all cold values and start a new file).
+
+   Cold values are loaded back into the wksp by fd_funk_rec_query_warm,
+   fd_funk_rec_modify and fd_funk_rec_write_prepare.  The other queries
+   never modify funk or do file I/O and may return records whose value
+   is cold (fd_funk_val returns NULL for these but fd_funk_val_sz still
+   gives the value size).  fd_funk_cold_prefetch can be used before a
+   batch of transactions to start reading the cold values they will
+   touch in the background.
+
+   Records are loaded explicitly with fd_funk_cold_load.  Readers that
+   only need a cold value once (e.g. snapshot creation) can read it
+   straight from the cold file with fd_funk_cold_read instead.
+
+   Recency is tracked in slots.  The funk remembers the slot of the most
+   recent eviction and records are stamped with it when they are
+   inserted, modified or queried with fd_funk_rec_query_warm.
+   fd_funk_cold_evict evicts the published values that have not been
+   stamped in the last age slots.
+
+   The cold file descriptor is owned by the caller and is only valid in
+   the process that attached it.  A process resuming a funk from a
+   persistent wksp should reattach the same cold file before using the
+   funk. */
+
+#include "fd_funk_rec.h" /* Includes fd_funk_txn.h, fd_funk_base.h */
+
+/* FD_FUNK_COLD_ALIGN gives the alignment of values in the cold file. */
+
+#define FD_FUNK_COLD_ALIGN (8UL)
+
+/* FD_FUNK_COLD_MAGIC is the magic number at the start of each value in
+   the cold file. */
+
+#define FD_FUNK_COLD_MAGIC (0xf17eda2cec01d000UL) /* firedancer funk cold version 0 */
+
+/* A fd_funk_cold_hdr_t precedes each value in the cold file. */
+
+struct fd_funk_cold_hdr {
+  ulong             magic;  /* ==FD_FUNK_COLD_MAGIC */
+  ulong             val_sz; /* Number of value bytes after the header, in [1,FD_FUNK_REC_VAL_MAX] */
+  fd_funk_rec_key_t key[1]; /* Key of the record the value was evicted from */
+};
+
+typedef struct fd_funk_cold_hdr fd_funk_cold_hdr_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_funk_rec_is_cold returns 1 if the value of the record pointed to
+   by rec is cold and 0 otherwise.  Assumes rec is a pointer in the
+   caller's address space to a live funk record. */
+
+FD_FN_PURE static inline int
+fd_funk_rec_is_cold( fd_funk_rec_t const * rec ) {
+  return !!(rec->flags & FD_FUNK_REC_FLAG_COLD);
+}
+
+/* fd_funk_cold_blob_sz returns the number of cold file bytes used by a
+   value of val_sz bytes. */
+
+FD_FN_CONST static inline ulong
+fd_funk_cold_blob_sz( ulong val_sz ) {
+  return fd_ulong_align_up( sizeof(fd_funk_cold_hdr_t) + val_sz, FD_FUNK_COLD_ALIGN );
+}
+
+/* fd_funk_cold_attach attaches the cold file open for reading and
+   writing at fd to funk.  If the funk has never evicted anything, the
+   cold file will be written from its beginning.  Otherwise, fd should
+   be the cold file previously attached to this funk (the file should
+   be at least fd_funk_cold_sz bytes).  Returns FD_FUNK_SUCCESS on
+   success and a FD_FUNK_ERR_* code on failure (logs details).  Reasons
+   for failure include FD_FUNK_ERR_INVAL (NULL funk, negative fd, a cold
+   file is already attached) and FD_FUNK_ERR_SYS (fd is not a usable
+   file or is too small).  Retains an interest in fd until detached.
+
+   fd_funk_cold_detach detaches the cold file from funk.  Returns the
+   file descriptor of the detached cold file (caller is responsible for
+   closing it) or -1 if no cold file was attached.  Cold values remain
+   cold but cannot be loaded until the cold file is reattached.
+
+   fd_funk_cold_fd returns the file descriptor of the cold file attached
+   to funk or -1 if none.  fd_funk_cold_sz returns the number of bytes
+   appended to the cold file (including dead space).  fd_funk_cold_slot
+   returns the slot of the most recent eviction.  These assume funk is
+   a current local join. */
+
+int
+fd_funk_cold_attach( fd_funk_t * funk,
+                     int         fd );
+
+int
+fd_funk_cold_detach( fd_funk_t * funk );
+
+FD_FN_PURE int   fd_funk_cold_fd  ( fd_funk_t const * funk );
+FD_FN_PURE ulong fd_funk_cold_sz  ( fd_funk_t const * funk );
+FD_FN_PURE ulong fd_funk_cold_slot( fd_funk_t const * funk );
+
+/* fd_funk_cold_touch stamps the record pointed to by rec as used in
+   the current cold slot.  Meant for internal use. */
+
+void
+fd_funk_cold_touch( fd_funk_t *           funk,
+                    fd_funk_rec_t const * rec );
+
+/* fd_funk_cold_evict evicts the values of the records of the last
+   published transaction that have not been used since slot-age to the
+   cold file.  Records with an empty value, marked ERASE or that are
+   already cold are skipped.  At most max_cnt values are evicted (use
+   ULONG_MAX for no limit).  slot becomes the current cold slot (slot
+   should be monotonically non-decreasing over calls).
+
+   Returns the number of values evicted.  If opt_err is non-NULL, on
+   return, *opt_err will hold FD_FUNK_SUCCESS if successful or a
+   FD_FUNK_ERR_* code on failure.  Reasons for failure include
+   FD_FUNK_ERR_INVAL (NULL funk, no cold file attached) and
+   FD_FUNK_ERR_SYS (cold file write failed, logs details).  On failure,
+   the values evicted before the failure remain evicted and all others
+   are unchanged.
+
+   This is O(number of published records) and does file I/O.  It is
+   meant to be called periodically (e.g. once per rooted slot) by the
+   thread that publishes.  Evicting the records of a frozen last
+   published transaction is fine (this does not change the record
+   contents). */
+
+ulong
+fd_funk_cold_evict( fd_funk_t * funk,
+                    ulong       slot,
+                    ulong       age,
+                    ulong       max_cnt,
+                    int *       opt_err );
+
+/* fd_funk_cold_load loads the cold value of the record pointed to by
+   rec back into the funk's wksp.  On success, the record is no longer
+   cold and is stamped as used in the current cold slot.  It is fine to
+   call this on a record that is not cold (it is a no-op).  Returns
+   FD_FUNK_SUCCESS on success and a FD_FUNK_ERR_* code on failure.
+   Reasons for failure include FD_FUNK_ERR_INVAL (NULL funk, rec is not
+   a live funk record), FD_FUNK_ERR_MEM (allocation failure, need a
+   larger wksp) and FD_FUNK_ERR_SYS (no cold file attached, cold file
+   read failed or cold file corrupt, logs details).  On failure, rec is
+   unchanged.  Assumes no concurrent operations on rec. */
+
+int
+fd_funk_cold_load( fd_funk_t *           funk,
+                   fd_funk_rec_t const * rec );
+
+/* fd_funk_cold_read copies the sz bytes at offset off of the cold
+   value of the record pointed to by rec into buf, without loading the
+   value into the wksp or otherwise changing funk.  If off is zero, also
+   checks the header of the value in the cold file.  Returns
+   FD_FUNK_SUCCESS on success and a FD_FUNK_ERR_* code on failure.
+   Reasons for failure include FD_FUNK_ERR_INVAL (NULL funk or buf, rec
+   is not a live funk record, rec is not cold, [off,off+sz) is not
+   within the value) and FD_FUNK_ERR_SYS (no cold file attached, cold
+   file read failed or cold file corrupt, logs details).  On failure,
+   the contents of buf are undefined.  This does file I/O and may be
+   called concurrently from multiple threads, provided rec is not
+   modified concurrently. */
+
+int
+fd_funk_cold_read( fd_funk_t *           funk,
+                   fd_funk_rec_t const * rec,
+                   ulong                 off,
+                   void *                buf,
+                   ulong                 sz );
+
+/* fd_funk_cold_prefetch starts reading in the background the cold
+   values of the records that a global query of each of the key_cnt
+   keys pointed to by keys from txn would return (NULL txn means the
+   last published transaction).  This does not block on I/O and does
+   not change funk.  A subsequent load of these values is then served
+   from the operating system's page cache.  Returns the number of cold
+   values for which a read was started.  Assumes funk is a current
+   local join and keys points to key_cnt keys in the caller's address
+   space. */
+
+ulong
+fd_funk_cold_prefetch( fd_funk_t *               funk,
+                       fd_funk_txn_t const *     txn,
+                       fd_funk_rec_key_t const * keys,
+                       ulong                     key_cnt );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_funk_fd_funk_cold_h */
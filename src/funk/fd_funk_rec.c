@@ -7,10 +7,10 @@
 #define MAP_KEY_T             fd_funk_xid_key_pair_t
 #define MAP_KEY               pair
 #define MAP_KEY_EQ(k0,k1)     fd_funk_xid_key_pair_eq((k0),(k1))
-#define MAP_KEY_HASH(k0,seed) fd_funk_xid_key_pair_hash((k0),(seed))
+#define MAP_KEY_HASH(k0,seed) fd_funk_rec_key_hash((k0)->key,(seed))
 #define MAP_KEY_COPY(kd,ks)   fd_funk_xid_key_pair_copy((kd),(ks))
 #define MAP_NEXT              map_next
-#define MAP_MAGIC             (0xf173da2ce77ecdb0UL) /* Firedancer rec db version 0 */
+#define MAP_MAGIC             (0xf173da2ce77ecdb1UL) /* Firedancer rec db version 1 */
 #define MAP_IMPL_STYLE        2
 #include "../util/tmpl/fd_map_giant.c"
 
@@ -18,7 +18,7 @@ FD_FN_PURE ulong
 fd_funk_rec_map_list_idx( fd_funk_rec_t const * join,
                           fd_funk_xid_key_pair_t const * key ) {
     fd_funk_rec_map_private_t const * map = fd_funk_rec_map_private_const( join );
-    return (fd_funk_xid_key_pair_hash( key, map->seed )) & (map->list_cnt-1UL);
+    return fd_funk_rec_map_private_list_idx( key, map->seed, map->list_cnt );
 }
 
 void
@@ -50,80 +50,154 @@ fd_funk_rec_query_const( fd_funk_t *               funk,
   return fd_funk_rec_map_query_const( fd_funk_rec_map( funk, fd_funk_wksp( funk ) ), pair, NULL );
 }
 
-fd_funk_rec_t const *
-fd_funk_rec_query_global( fd_funk_t *               funk,
-                          fd_funk_txn_t const *     txn,
-                          fd_funk_rec_key_t const * key ) {
+/* FD_FUNK_REC_QUERY_GLOBAL_VER_MAX is the maximum number of
+   in-preparation versions of a key fd_funk_rec_query_global_private
+   will track while walking the key's record map chain.  If a key has
+   more versions than this across all forks (only in pathological
+   cases), the query falls back to probing each ancestor. */
+
+#define FD_FUNK_REC_QUERY_GLOBAL_VER_MAX (32UL)
+
+/* fd_funk_rec_query_global_private implements fd_funk_rec_query_global,
+   fd_funk_rec_query_global_const and fd_funk_rec_query_warm.  As the
+   record map hashes only the record key, the versions of key for the
+   last published transaction and for all in-preparation transactions
+   are on the same chain.  We walk that chain once (without reordering it such that
+   this is safe for concurrent queries) and remember the in-preparation
+   versions.  We then walk txn's ancestors and return the version of the
+   youngest ancestor that has one, falling back to the published
+   version.  The common cases (key only published or txn has its own
+   version) need no ancestor walk at all. */
+
+static fd_funk_rec_t const *
+fd_funk_rec_query_global_private( fd_funk_t *               funk,
+                                  fd_funk_txn_t const *     txn,
+                                  fd_funk_rec_key_t const * key ) {
 
   if( FD_UNLIKELY( (!funk) | (!key) ) ) return NULL;
 
   fd_wksp_t * wksp = fd_funk_wksp( funk );
 
   fd_funk_rec_t * rec_map = fd_funk_rec_map( funk, wksp );
+  fd_funk_txn_t * txn_map = fd_funk_txn_map( funk, wksp );
 
-  if( txn ) { /* Query txn and its in-prep ancestors */
-
-    fd_funk_txn_t * txn_map = fd_funk_txn_map( funk, wksp );
+  ulong txn_idx = FD_FUNK_TXN_IDX_NULL;
 
+  if( txn ) {
     ulong txn_max = funk->txn_max;
 
-    ulong txn_idx = (ulong)(txn - txn_map);
+    txn_idx = (ulong)(txn - txn_map);
 
     if( FD_UNLIKELY( (txn_idx>=txn_max) /* Out of map (incl NULL) */ | (txn!=(txn_map+txn_idx)) /* Bad alignment */ ) )
       return NULL;
-
-    /* TODO: const correct and/or fortify? */
-    do {
-      fd_funk_xid_key_pair_t pair[1]; fd_funk_xid_key_pair_init( pair, fd_funk_txn_xid( txn ), key );
-      fd_funk_rec_t const * rec = fd_funk_rec_map_query( rec_map, pair, NULL );
-      if( FD_LIKELY( rec ) ) return rec;
-      txn = fd_funk_txn_parent( (fd_funk_txn_t *)txn, txn_map );
-    } while( FD_UNLIKELY( txn ) );
-
   }
 
-  /* Query the last published transaction */
+  /* Walk the chain holding all versions of key */
+
+  fd_funk_rec_map_private_t const * map = fd_funk_rec_map_private_const( rec_map );
 
   fd_funk_xid_key_pair_t pair[1]; fd_funk_xid_key_pair_init( pair, fd_funk_root( funk ), key );
-  return fd_funk_rec_map_query( rec_map, pair, NULL );
-}
 
-fd_funk_rec_t const *
-fd_funk_rec_query_global_const( fd_funk_t *               funk,
-                                fd_funk_txn_t const *     txn,
-                                fd_funk_rec_key_t const * key ) {
+  ulong const * head = fd_funk_rec_map_private_list_const( map )
+                     + fd_funk_rec_map_private_list_idx( pair, map->seed, map->list_cnt );
 
-  if( FD_UNLIKELY( (!funk) | (!key) ) ) return NULL;
+  fd_funk_rec_t const * root_rec = NULL;
 
-  fd_wksp_t * wksp = fd_funk_wksp( funk );
+  fd_funk_rec_t const * ver_rec    [ FD_FUNK_REC_QUERY_GLOBAL_VER_MAX ];
+  ulong                 ver_txn_idx[ FD_FUNK_REC_QUERY_GLOBAL_VER_MAX ];
+  ulong                 ver_cnt = 0UL;
 
-  fd_funk_rec_t * rec_map = fd_funk_rec_map( funk, wksp );
+  for( ulong rec_idx = fd_funk_rec_map_private_unbox_idx( *head );
+       !fd_funk_rec_map_private_is_null( rec_idx );
+       rec_idx = fd_funk_rec_map_private_unbox_idx( rec_map[ rec_idx ].map_next ) ) {
+    fd_funk_rec_t const * rec = rec_map + rec_idx;
+    if( FD_UNLIKELY( !fd_funk_rec_key_eq( rec->pair.key, key ) ) ) continue; /* Hash collision */
 
-  if( txn ) { /* Query txn and its in-prep ancestors */
+    ulong rec_txn_idx = fd_funk_txn_idx( rec->txn_cidx );
+    if( rec_txn_idx==txn_idx ) return rec; /* txn's own version (or the published one if txn is NULL) */
 
-    fd_funk_txn_t * txn_map = fd_funk_txn_map( funk, wksp );
+    if( fd_funk_txn_idx_is_null( rec_txn_idx ) ) root_rec = rec;
+    else {
+      if( FD_LIKELY( ver_cnt<FD_FUNK_REC_QUERY_GLOBAL_VER_MAX ) ) {
+        ver_rec    [ ver_cnt ] = rec;
+        ver_txn_idx[ ver_cnt ] = rec_txn_idx;
+      }
+      ver_cnt++;
+    }
+  }
 
-    ulong txn_max = funk->txn_max;
+  if( FD_LIKELY( (!txn) | (!ver_cnt) ) ) return root_rec;
 
-    ulong txn_idx = (ulong)(txn - txn_map);
+  if( FD_UNLIKELY( ver_cnt>FD_FUNK_REC_QUERY_GLOBAL_VER_MAX ) ) {
 
-    if( FD_UNLIKELY( (txn_idx>=txn_max) /* Out of map (incl NULL) */ | (txn!=(txn_map+txn_idx)) /* Bad alignment */ ) )
-      return NULL;
+    /* Too many versions to track, probe each ancestor */
 
-    /* TODO: const correct and/or fortify? */
-    do {
-      fd_funk_xid_key_pair_t pair[1]; fd_funk_xid_key_pair_init( pair, fd_funk_txn_xid( txn ), key );
+    for( txn = fd_funk_txn_parent( (fd_funk_txn_t *)txn, txn_map ); txn; txn = fd_funk_txn_parent( (fd_funk_txn_t *)txn, txn_map ) ) {
+      fd_funk_xid_key_pair_init( pair, fd_funk_txn_xid( txn ), key );
       fd_funk_rec_t const * rec = fd_funk_rec_map_query_const( rec_map, pair, NULL );
       if( FD_LIKELY( rec ) ) return rec;
-      txn = fd_funk_txn_parent( (fd_funk_txn_t *)txn, txn_map );
-    } while( FD_UNLIKELY( txn ) );
+    }
 
+    return root_rec;
   }
 
-  /* Query the last published transaction */
+  /* Find the youngest in-prep ancestor of txn with a version of key */
 
-  fd_funk_xid_key_pair_t pair[1]; fd_funk_xid_key_pair_init( pair, fd_funk_root( funk ), key );
-  return fd_funk_rec_map_query_const( rec_map, pair, NULL );
+  ulong anc_idx = fd_funk_txn_idx( txn_map[ txn_idx ].parent_cidx );
+  while( !fd_funk_txn_idx_is_null( anc_idx ) ) {
+    for( ulong ver_idx=0UL; ver_idx<ver_cnt; ver_idx++ )
+      if( FD_UNLIKELY( ver_txn_idx[ ver_idx ]==anc_idx ) ) return ver_rec[ ver_idx ];
+    anc_idx = fd_funk_txn_idx( txn_map[ anc_idx ].parent_cidx );
+  }
+
+  return root_rec;
+}
+
+fd_funk_rec_t const *
+fd_funk_rec_query_global( fd_funk_t *               funk,
+                          fd_funk_txn_t const *     txn,
+                          fd_funk_rec_key_t const * key ) {
+  return fd_funk_rec_query_global_private( funk, txn, key );
+}
+
+fd_funk_rec_t const *
+fd_funk_rec_query_global_const( fd_funk_t *               funk,
+                                fd_funk_txn_t const *     txn,
+                                fd_funk_rec_key_t const * key ) {
+  return fd_funk_rec_query_global_private( funk, txn, key );
+}
+
+fd_funk_rec_t const *
+fd_funk_rec_query_warm( fd_funk_t *               funk,
+                        fd_funk_txn_t const *     txn,
+                        fd_funk_rec_key_t const * key,
+                        int *                     opt_err ) {
+  if( FD_UNLIKELY( (!funk) | (!key) ) ) {
+    fd_int_store_if( !!opt_err, opt_err, FD_FUNK_ERR_INVAL );
+    return NULL;
+  }
+
+  fd_funk_rec_t const * rec = fd_funk_rec_query_global_private( funk, txn, key );
+  if( FD_UNLIKELY( !rec ) ) {
+    fd_int_store_if( !!opt_err, opt_err, FD_FUNK_ERR_KEY );
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( fd_funk_rec_is_cold( rec ) ) ) {
+    int err = fd_funk_cold_load( funk, rec ); /* Stamps rec on success */
+    if( FD_UNLIKELY( err ) ) {
+      FD_LOG_WARNING(( "fd_funk_cold_load failed (%i-%s)", err, fd_funk_strerror( err ) ));
+      fd_int_store_if( !!opt_err, opt_err, err );
+      return NULL;
+    }
+  } else if( FD_UNLIKELY( rec->touch_slot!=fd_funk_cold_slot( funk ) ) ) {
+    /* Only store the stamp if it changes such that repeated queries of
+       a warm record in the same cold slot don't write. */
+    fd_funk_cold_touch( funk, rec );
+  }
+
+  fd_int_store_if( !!opt_err, opt_err, FD_FUNK_SUCCESS );
+  return rec;
 }
 
 int
@@ -203,10 +277,20 @@ fd_funk_rec_modify( fd_funk_t *           funk,
       return NULL;
   }
 
+  fd_funk_cold_touch( funk, rec );
+
+  if( FD_UNLIKELY( fd_funk_rec_is_cold( rec ) ) ) {
+    int err = fd_funk_cold_load( funk, rec );
+    if( FD_UNLIKELY( err ) ) {
+      FD_LOG_WARNING(( "fd_funk_cold_load failed (%i-%s)", err, fd_funk_strerror( err ) ));
+      return NULL;
+    }
+  }
+
   return (fd_funk_rec_t *)rec;
 }
 
-FD_FN_PURE int
+int
 fd_funk_rec_is_modified( fd_funk_t *           funk,
                          fd_funk_rec_t const * rec ) {
 
@@ -247,6 +331,8 @@ fd_funk_rec_is_modified( fd_funk_t *           funk,
     if ( rec2 ) {
       if ( rec->val_sz != rec2->val_sz )
         return 1;
+      if ( FD_UNLIKELY( fd_funk_cold_load( funk, rec2 ) ) )
+        return 1; /* Conservatively treat an unreadable prior incarnation as modified */
       void * val2 = fd_funk_val( rec2, wksp );
       return memcmp(val, val2, rec->val_sz) != 0;
     }
@@ -389,6 +475,7 @@ fd_funk_rec_insert( fd_funk_t *               funk,
 
   fd_funk_val_init( rec );
   fd_funk_part_init( rec );
+  fd_funk_cold_touch( funk, rec );
 
   fd_int_store_if( !!opt_err, opt_err, FD_FUNK_SUCCESS );
   return rec;
@@ -503,6 +590,7 @@ fd_funk_rec_insert_prealloc( fd_funk_t *               funk,
 
   fd_funk_val_init( rec );
   fd_funk_part_init( rec );
+  fd_funk_cold_touch( funk, rec );
 
   fd_int_store_if( !!opt_err, opt_err, FD_FUNK_SUCCESS );
   return rec;
@@ -646,7 +734,7 @@ fd_funk_rec_remove( fd_funk_t *     funk,
         ulong parent_idx = fd_funk_txn_idx( txn_map[ cur_idx ].parent_cidx );
         if( FD_LIKELY( fd_funk_txn_idx_is_null( parent_idx ) ) ) { /* Parent txn is last published, opt for shallow */
 
-          fd_funk_rec_t const * erase_rec = fd_funk_rec_query( funk, NULL, fd_funk_rec_key( rec ) );
+          fd_funk_rec_t const * erase_rec = fd_funk_rec_query_const( funk, NULL, fd_funk_rec_key( rec ) );
           if( FD_UNLIKELY( !erase_rec ) ) break; /* No ancestor has this record, can free immediately, opt no flicker */
 
           /* Record is available in last published ... this remove
@@ -668,7 +756,7 @@ fd_funk_rec_remove( fd_funk_t *     funk,
         if( FD_UNLIKELY( parent_idx>=txn_max            ) ) FD_LOG_CRIT(( "memory corruption detected (bad idx)" ));
         if( FD_UNLIKELY( txn_map[ parent_idx ].tag==tag ) ) FD_LOG_CRIT(( "memory corruption detected (cycle)" ));
 
-        fd_funk_rec_t const * erase_rec = fd_funk_rec_query( funk, &txn_map[ parent_idx ], fd_funk_rec_key( rec ) );
+        fd_funk_rec_t const * erase_rec = fd_funk_rec_query_const( funk, &txn_map[ parent_idx ], fd_funk_rec_key( rec ) );
         if( FD_LIKELY( erase_rec ) ) { /* Opt for shallow */
 
           /* Record is available in an in-prep ancestor ... this remove
@@ -763,6 +851,14 @@ fd_funk_rec_write_prepare( fd_funk_t *               funk,
   else
     rec_con = irec;
 
+  if( rec_con && FD_UNLIKELY( fd_funk_rec_is_cold( rec_con ) ) ) {
+    int err = fd_funk_cold_load( funk, rec_con );
+    if( FD_UNLIKELY( err ) ) {
+      fd_int_store_if( !!opt_err, opt_err, err );
+      return NULL;
+    }
+  }
+
   if ( rec_con ) {
     /* We have an incarnation of the record */
     if ( txn == fd_funk_rec_txn( rec_con,  fd_funk_txn_map( funk, wksp ) ) ) {
@@ -823,6 +919,14 @@ fd_funk_rec_write_prepare_prealloc( fd_funk_t *               funk,
   else
     rec_con = irec;
 
+  if( rec_con && FD_UNLIKELY( fd_funk_rec_is_cold( rec_con ) ) ) {
+    int err = fd_funk_cold_load( funk, rec_con );
+    if( FD_UNLIKELY( err ) ) {
+      fd_int_store_if( !!opt_err, opt_err, err );
+      return NULL;
+    }
+  }
+
   if ( rec_con ) {
 
     /* We have an incarnation of the record */
@@ -27,6 +27,16 @@
 
 #define FD_FUNK_REC_FLAG_ERASE (1UL<<0)
 
+/* - COLD indicates the value of a record of the last published
+   transaction has been evicted to the funk's cold file (see
+   fd_funk_cold.h).  If set, the record will have no value resources in
+   the wksp (val_max and val_gaddr are zero), val_sz gives the size of
+   the evicted value and cold_off gives its location in the cold file.
+   Will not be set on a record with erase set or on a record of an
+   in-preparation transaction. */
+
+#define FD_FUNK_REC_FLAG_COLD (1UL<<1)
+
 /* FD_FUNK_REC_IDX_NULL gives the map record idx value used to represent
    NULL.  This value also set a limit on how large rec_max can be. */
 
@@ -57,19 +67,22 @@ struct fd_funk_rec {
   /* Note: use of uint here requires FD_FUNK_REC_VAL_MAX to be at most
      UINT_MAX. */
 
-  uint  val_sz;    /* Num bytes in record value, in [0,val_max] */
-  uint  val_max;   /* Max byte  in record value, in [0,FD_FUNK_REC_VAL_MAX], 0 if erase flag set or val_gaddr is 0 */
-  ulong val_gaddr; /* Wksp gaddr on record value if any, 0 if erase flag set or val_max is 0
+  uint  val_sz;    /* Num bytes in record value, in [0,val_max] (in [1,FD_FUNK_REC_VAL_MAX] if cold flag set) */
+  uint  val_max;   /* Max byte  in record value, in [0,FD_FUNK_REC_VAL_MAX], 0 if erase or cold flag set or val_gaddr is 0 */
+  ulong val_gaddr; /* Wksp gaddr on record value if any, 0 if erase or cold flag set or val_max is 0
                       If non-zero, the region [val_gaddr,val_gaddr+val_max) will be a current fd_alloc allocation (such that it is
                       has tag wksp_tag) and the owner of the region will be the record.  IMPORTANT! HAS NO GUARANTEED ALIGNMENT! */
 
+  ulong cold_off;   /* Cold file offset of the evicted value if cold flag set, 0 otherwise */
+  ulong touch_slot; /* Funk cold slot when the record was last inserted, modified or warm queried (see fd_funk_cold.h) */
+
   ulong prev_part_idx;  /* Record map index of previous record in partition chain */
   ulong next_part_idx;  /* Record map index of next record in partition chain */
   uint  part;           /* Partition number, FD_FUNK_PART_NULL if none */
 
   /* Padding to FD_FUNK_REC_ALIGN here (TODO: consider using self index
      in the structures to accelerate indexing computations if padding
-     permits as this structure is currently has 8 bytes of padding) */
+     permits as this structure is currently has 4 bytes of padding) */
 };
 
 typedef struct fd_funk_rec fd_funk_rec_t;
@@ -80,17 +93,21 @@ typedef struct fd_funk_rec fd_funk_rec_t;
    Published records are stored under the pair (root,key).  (This is
    done so that publishing a transaction doesn't require updating all
    transaction id of all the records that were not updated by the
-   publish.) */
+   publish.)  Only the key part of the pair is hashed.  Thus all the
+   versions of a record (the published one and those of in-preparation
+   transactions on any fork) are on the same map chain and a query that
+   needs to resolve a key against a transaction's ancestors can find all
+   candidate versions with a single chain walk. */
 
 #define MAP_NAME              fd_funk_rec_map
 #define MAP_T                 fd_funk_rec_t
 #define MAP_KEY_T             fd_funk_xid_key_pair_t
 #define MAP_KEY               pair
 #define MAP_KEY_EQ(k0,k1)     fd_funk_xid_key_pair_eq((k0),(k1))
-#define MAP_KEY_HASH(k0,seed) fd_funk_xid_key_pair_hash((k0),(seed))
+#define MAP_KEY_HASH(k0,seed) fd_funk_rec_key_hash((k0)->key,(seed))
 #define MAP_KEY_COPY(kd,ks)   fd_funk_xid_key_pair_copy((kd),(ks))
 #define MAP_NEXT              map_next
-#define MAP_MAGIC             (0xf173da2ce77ecdb0UL) /* Firedancer rec db version 0 */
+#define MAP_MAGIC             (0xf173da2ce77ecdb1UL) /* Firedancer rec db version 1 */
 #define MAP_IMPL_STYLE        1
 #include "../util/tmpl/fd_map_giant.c"
 
@@ -162,9 +179,18 @@ FD_FN_PURE static inline int fd_funk_rec_is_full( fd_funk_rec_t const * map ) {
    discard an erase for an unfrozen in-preparation transaction.)  In
    such cases, the record will have no value resources in use.
 
-   These are a reasonably fast O(in_prep_ancestor_cnt). */
+   None of these modify funk.  They can return records whose value was
+   evicted to the cold file (see fd_funk_cold.h), for which fd_funk_val
+   returns NULL.  Use fd_funk_rec_query_warm to get a record with its
+   value in the wksp.
 
-FD_FN_PURE fd_funk_rec_t const *
+   These do a single record map chain walk (which visits every version
+   of key on any fork) followed by a walk of txn's ancestors that only
+   touches the transaction map.  As such, these are a reasonably fast
+   O(1) in the number of hash probes and O(in_prep_ancestor_cnt) in the
+   number of transaction map accesses. */
+
+fd_funk_rec_t const *
 fd_funk_rec_query( fd_funk_t *               funk,
                    fd_funk_txn_t const *     txn,
                    fd_funk_rec_key_t const * key );
@@ -174,7 +200,7 @@ fd_funk_rec_query_const( fd_funk_t *               funk,
                          fd_funk_txn_t const *     txn,
                          fd_funk_rec_key_t const * key );
 
-FD_FN_PURE fd_funk_rec_t const *
+fd_funk_rec_t const *
 fd_funk_rec_query_global( fd_funk_t *               funk,
                           fd_funk_txn_t const *     txn,
                           fd_funk_rec_key_t const * key );
@@ -184,6 +210,27 @@ fd_funk_rec_query_global_const( fd_funk_t *               funk,
                                 fd_funk_txn_t const *     txn,
                                 fd_funk_rec_key_t const * key );
 
+/* fd_funk_rec_query_warm is fd_funk_rec_query_global for callers that
+   need the value.  It also stamps the returned record as used in the
+   current cold slot and loads its value back into the wksp if it was
+   evicted to the cold file (this might do file I/O, see
+   fd_funk_cold.h).  Unlike the other queries, this modifies the
+   returned record, so it must not run concurrently with other
+   operations on it.
+
+   Returns the record on success.  Returns NULL on bad inputs (*opt_err
+   is FD_FUNK_ERR_INVAL), if key was not found (*opt_err is
+   FD_FUNK_ERR_KEY) or if the cold value could not be
+   loaded (*opt_err is the fd_funk_cold_load error, logs details, the
+   record is unchanged).  On success, *opt_err is FD_FUNK_SUCCESS.
+   opt_err may be NULL. */
+
+fd_funk_rec_t const *
+fd_funk_rec_query_warm( fd_funk_t *               funk,
+                        fd_funk_txn_t const *     txn,
+                        fd_funk_rec_key_t const * key,
+                        int *                     opt_err );
+
 /* fd_funk_rec_test tests the record pointed to by rec.  Returns
    FD_FUNK_SUCCESS (0) if rec appears to be a live unfrozen record in
    funk and a FD_FUNK_ERR_* (negative) otherwise.  Specifically:
@@ -281,8 +328,10 @@ fd_funk_txn_rec_tail( fd_funk_txn_t const * txn,        /* Assumes an in-prepara
    safe to modify the val / discard a change to the record for an
    in-preparation transaction (incl discard an erase) / erase a
    published record / etc.  Reasons for NULL include NULL funk, NULL
-   rec, rec does not appear to be a live record, or the transaction to
-   which rec belongs is frozen.
+   rec, rec does not appear to be a live record, the transaction to
+   which rec belongs is frozen, or rec's value is cold and could not be
+   loaded back into the wksp (see fd_funk_cold.h).  On success, rec is
+   stamped as used in the current cold slot.
 
    The returned pointer is in the caller's address space and, if the
    return value is non-NULL, the lifetime of the returned pointer is the
@@ -299,18 +348,20 @@ fd_funk_txn_rec_tail( fd_funk_txn_t const * txn,        /* Assumes an in-prepara
    retains ownership of rec.  The record value metadata will be updated
    whenever the record value modified.
 
-   This is a reasonably fast O(1). */
+   This is a reasonably fast O(1) (plus file I/O if rec's value is
+   cold). */
 
-FD_FN_PURE fd_funk_rec_t *
+fd_funk_rec_t *
 fd_funk_rec_modify( fd_funk_t *           funk,
                     fd_funk_rec_t const * rec );
 
 /* Returns 1 if the record has been modified in its transaction
    compared to the prior incarnation of the record with the same
    key (or there is no prior incarnation). Returns -1 if rec is part
-   of a published transaction. Return 0 otherwise. */
+   of a published transaction. Return 0 otherwise.  The value of the
+   prior incarnation is loaded back into the wksp if it was cold. */
 
-FD_FN_PURE int
+int
 fd_funk_rec_is_modified( fd_funk_t *           funk,
                          fd_funk_rec_t const * rec );
 
@@ -620,6 +620,7 @@ fd_funk_txn_update( ulong *                   _dst_rec_head_idx, /* Pointer to t
       ulong val_sz    = (ulong)rec_map[ rec_idx ].val_sz;
       ulong val_max   = (ulong)rec_map[ rec_idx ].val_max;
       ulong val_gaddr = rec_map[ rec_idx ].val_gaddr;
+      ulong touch     = rec_map[ rec_idx ].touch_slot;
       uint part       = rec_map[ rec_idx ].part;
 
       fd_funk_part_set_intern( partvec, rec_map, &rec_map[ rec_idx ], FD_FUNK_PART_NULL );
@@ -652,10 +653,12 @@ fd_funk_txn_update( ulong *                   _dst_rec_head_idx, /* Pointer to t
 
       /* Unstash value metadata from stack temporaries into dst_rec */
 
-      dst_rec->val_sz    = (uint)val_sz;
-      dst_rec->val_max   = (uint)val_max;
-      dst_rec->val_gaddr = val_gaddr;
-      dst_rec->flags    &= ~FD_FUNK_REC_FLAG_ERASE;
+      dst_rec->val_sz     = (uint)val_sz;
+      dst_rec->val_max    = (uint)val_max;
+      dst_rec->val_gaddr  = val_gaddr;
+      dst_rec->cold_off   = 0UL;
+      dst_rec->touch_slot = touch;
+      dst_rec->flags     &= ~(FD_FUNK_REC_FLAG_ERASE | FD_FUNK_REC_FLAG_COLD);
 
       /* Use the new partition */
 
@@ -671,6 +674,214 @@ fd_funk_txn_update( ulong *                   _dst_rec_head_idx, /* Pointer to t
   txn_map[ txn_idx ].rec_tail_idx = FD_FUNK_REC_IDX_NULL;
 }
 
+/* fd_funk_txn_update_par is fd_funk_txn_update specialized for merging
+   the records of txn_idx into the last published transaction using
+   tpool threads [t0,t1).  The result, including the order of the
+   published records, is identical to fd_funk_txn_update.
+
+   The slow parts of a merge are the destination record lookups (a
+   record map chain walk per update, typically a handful of cache
+   misses) and freeing the destination values that get replaced or
+   erased.  Record map chains are selected by key alone, so the lookups
+   and any in-place record changes for an update only touch the update's
+   chain, and fd_alloc is safe to use concurrently.  Thus, the updates
+   are partitioned by chain over the threads and these are done in
+   parallel.  What remains (the record map free list, the published
+   record list and the partition lists) is shared and is done serially
+   afterward in the original update order.
+
+   An update that creates a new published record relabels the update
+   record in place (the relabeled record stays on the same chain)
+   instead of doing a map remove / insert.  Since the txn's record list
+   is consumed by the merge, the prev_idx of its records is repurposed
+   to thread state between the phases without scratch memory: first to
+   link the per thread work lists and then to hold the index of the
+   destination record (or the record itself if it was relabeled). */
+
+struct fd_funk_txn_update_par_args {
+  fd_funk_rec_t *           rec_map;   /* ==fd_funk_rec_map( funk, wksp ) */
+  ulong const *             part_head; /* Indexed [0,t1-t0), head of each thread's work list */
+  fd_funk_txn_xid_t const * dst_xid;   /* ==fd_funk_root( funk ) */
+  fd_alloc_t *              alloc;     /* ==fd_funk_alloc( funk, wksp ) */
+  fd_wksp_t *               wksp;      /* ==fd_funk_wksp( funk ) */
+};
+
+typedef struct fd_funk_txn_update_par_args fd_funk_txn_update_par_args_t;
+
+static void
+fd_funk_txn_update_par_task( void * tpool,
+                             ulong  t0,      ulong t1,
+                             void * _args,
+                             void * reduce,  ulong stride,
+                             ulong  l0,      ulong l1,
+                             ulong  m0,      ulong m1,
+                             ulong  n0,      ulong n1 ) {
+  (void)tpool; (void)t1; (void)reduce; (void)stride; (void)l0; (void)l1; (void)m0; (void)m1; (void)n1;
+
+  fd_funk_txn_update_par_args_t const * args = (fd_funk_txn_update_par_args_t const *)_args;
+
+  fd_funk_rec_t *           rec_map = args->rec_map;
+  fd_funk_txn_xid_t const * dst_xid = args->dst_xid;
+  fd_alloc_t *              alloc   = fd_alloc_join_cgroup_hint_set( args->alloc, n0 );
+  fd_wksp_t *               wksp    = args->wksp;
+
+  ulong rec_idx = args->part_head[ n0-t0 ];
+  while( !fd_funk_rec_idx_is_null( rec_idx ) ) {
+    fd_funk_rec_t * rec = &rec_map[ rec_idx ];
+
+    ulong next_idx = rec->prev_idx;
+
+    fd_funk_xid_key_pair_t dst_pair[1];
+    fd_funk_xid_key_pair_init( dst_pair, dst_xid, fd_funk_rec_key( rec ) );
+
+    fd_funk_rec_t * dst_rec = fd_funk_rec_map_query( rec_map, dst_pair, NULL );
+
+    if( FD_UNLIKELY( rec->flags & FD_FUNK_REC_FLAG_ERASE ) ) { /* Erase a published key */
+
+      /* See fd_funk_txn_update about why this is corruption */
+
+      if( FD_UNLIKELY( !dst_rec ) ) FD_LOG_CRIT(( "memory corruption detected (bad ancestor)" ));
+
+      fd_funk_val_flush( dst_rec, alloc, wksp );
+
+      rec->prev_idx = (ulong)(dst_rec - rec_map);
+
+    } else if( FD_UNLIKELY( !dst_rec ) ) { /* Create a published key */
+
+      fd_funk_txn_xid_copy( rec->pair.xid, dst_xid );
+
+      rec->prev_idx = rec_idx;
+
+    } else { /* Update a published key */
+
+      fd_funk_val_flush( dst_rec, alloc, wksp ); /* Free up any preexisting value resources */
+
+      dst_rec->val_sz     = rec->val_sz;
+      dst_rec->val_max    = rec->val_max;
+      dst_rec->val_gaddr  = rec->val_gaddr;
+      dst_rec->cold_off   = 0UL;
+      dst_rec->touch_slot = rec->touch_slot;
+      dst_rec->flags     &= ~(FD_FUNK_REC_FLAG_ERASE | FD_FUNK_REC_FLAG_COLD);
+
+      fd_funk_val_init( rec ); /* Value now owned by dst_rec */
+
+      rec->prev_idx = (ulong)(dst_rec - rec_map);
+
+    }
+
+    rec_idx = next_idx;
+  }
+}
+
+static void
+fd_funk_txn_update_par( ulong *                   _dst_rec_head_idx, /* Pointer to the dst list head */
+                        ulong *                   _dst_rec_tail_idx, /* Pointer to the dst list tail */
+                        fd_funk_txn_xid_t const * dst_xid,           /* ==fd_funk_root( funk ) */
+                        ulong                     txn_idx,           /* Transaction index of the records to merge */
+                        ulong                     rec_max,           /* ==funk->rec_max */
+                        fd_funk_txn_t *           txn_map,           /* ==fd_funk_rec_map( funk, wksp ) */
+                        fd_funk_rec_t *           rec_map,           /* ==fd_funk_rec_map( funk, wksp ) */
+                        fd_funk_partvec_t *       partvec,           /* ==fd_funk_get_partvec( funk, wksp ) */
+                        fd_alloc_t *              alloc,             /* ==fd_funk_alloc( funk, wksp ) */
+                        fd_wksp_t *               wksp,              /* ==fd_funk_wksp( funk ) */
+                        fd_tpool_t *              tpool,             /* Valid tpool */
+                        ulong                     t0,                /* Use tpool threads [t0,t1), assumes 1<t1-t0<=FD_TILE_MAX */
+                        ulong                     t1 ) {
+
+  /* Validate the records to merge (as fd_funk_txn_update does) and
+     deal them out to the threads by record map chain. */
+
+  ulong part_cnt = t1 - t0;
+  ulong part_head[ FD_TILE_MAX ];
+  for( ulong part_idx=0UL; part_idx<part_cnt; part_idx++ ) part_head[ part_idx ] = FD_FUNK_REC_IDX_NULL;
+
+  ulong rec_idx = txn_map[ txn_idx ].rec_head_idx;
+  while( !fd_funk_rec_idx_is_null( rec_idx ) ) {
+
+    if( FD_UNLIKELY( rec_idx>=rec_max ) ) FD_LOG_CRIT(( "memory corruption detected (bad idx)" ));
+    if( FD_UNLIKELY( fd_funk_txn_idx( rec_map[ rec_idx ].txn_cidx )!=txn_idx ) )
+      FD_LOG_CRIT(( "memory corruption detected (cycle or bad idx)" ));
+    rec_map[ rec_idx ].txn_cidx = fd_funk_txn_cidx( FD_FUNK_TXN_IDX_NULL );
+
+    ulong part_idx = fd_funk_rec_map_list_idx( rec_map, fd_funk_rec_pair( &rec_map[ rec_idx ] ) ) % part_cnt;
+    rec_map[ rec_idx ].prev_idx = part_head[ part_idx ];
+    part_head[ part_idx ]       = rec_idx;
+
+    rec_idx = rec_map[ rec_idx ].next_idx;
+  }
+
+  /* Do the lookups and value updates in parallel */
+
+  fd_funk_txn_update_par_args_t args[1];
+  args->rec_map   = rec_map;
+  args->part_head = part_head;
+  args->dst_xid   = dst_xid;
+  args->alloc     = alloc;
+  args->wksp      = wksp;
+
+  fd_tpool_exec_all_raw( tpool, t0, t1, fd_funk_txn_update_par_task, tpool, args, NULL, 0UL, 0UL, 0UL );
+
+  /* Finish up the shared bookkeeping in update order */
+
+  rec_idx = txn_map[ txn_idx ].rec_head_idx;
+  while( !fd_funk_rec_idx_is_null( rec_idx ) ) {
+    fd_funk_rec_t * rec = &rec_map[ rec_idx ];
+
+    ulong next_idx    = rec->next_idx;
+    ulong dst_rec_idx = rec->prev_idx;
+
+    if( FD_UNLIKELY( dst_rec_idx==rec_idx ) ) { /* Created, append to the published records */
+
+      ulong dst_prev_idx = *_dst_rec_tail_idx;
+
+      rec->prev_idx = dst_prev_idx;
+      rec->next_idx = FD_FUNK_REC_IDX_NULL;
+      rec->tag      = 0U;
+
+      if( fd_funk_rec_idx_is_null( dst_prev_idx ) ) *_dst_rec_head_idx               = rec_idx;
+      else                                          rec_map[ dst_prev_idx ].next_idx = rec_idx;
+
+      *_dst_rec_tail_idx = rec_idx;
+
+    } else {
+
+      fd_funk_rec_t * dst_rec = &rec_map[ dst_rec_idx ];
+
+      int  erase = !!(rec->flags & FD_FUNK_REC_FLAG_ERASE);
+      uint part  = rec->part;
+
+      fd_funk_part_set_intern( partvec, rec_map, rec, FD_FUNK_PART_NULL );
+      fd_funk_rec_map_remove( rec_map, fd_funk_rec_pair( rec ) );
+
+      if( FD_UNLIKELY( erase ) ) { /* Erased, remove dst from the published records */
+
+        fd_funk_part_set_intern( partvec, rec_map, dst_rec, FD_FUNK_PART_NULL );
+
+        ulong prev_idx = dst_rec->prev_idx;
+        ulong next_idx = dst_rec->next_idx;
+
+        if( FD_UNLIKELY( fd_funk_rec_idx_is_null( prev_idx ) ) ) *_dst_rec_head_idx           = next_idx;
+        else                                                     rec_map[ prev_idx ].next_idx = next_idx;
+
+        if( FD_UNLIKELY( fd_funk_rec_idx_is_null( next_idx ) ) ) *_dst_rec_tail_idx           = prev_idx;
+        else                                                     rec_map[ next_idx ].prev_idx = prev_idx;
+
+        fd_funk_rec_map_remove( rec_map, fd_funk_rec_pair( dst_rec ) );
+
+      } else { /* Updated, use the new partition */
+
+        fd_funk_part_set_intern( partvec, rec_map, dst_rec, part );
+
+      }
+    }
+
+    rec_idx = next_idx;
+  }
+
+  txn_map[ txn_idx ].rec_head_idx = FD_FUNK_REC_IDX_NULL;
+  txn_map[ txn_idx ].rec_tail_idx = FD_FUNK_REC_IDX_NULL;
+}
+
 /* fd_funk_txn_publish_funk_child publishes a transaction that is known
    to be a child of funk.  Callers have already validated our input
    arguments.  Returns FD_FUNK_SUCCESS on success and an FD_FUNK_ERR_*
@@ -682,14 +893,22 @@ fd_funk_txn_publish_funk_child( fd_funk_t *     funk,
                                 fd_funk_txn_t * map,
                                 ulong           txn_max,
                                 ulong           tag,
-                                ulong           txn_idx ) {
+                                ulong           txn_idx,
+                                fd_tpool_t *    tpool,
+                                ulong           t0,
+                                ulong           t1 ) {
 
   /* Apply the updates in txn to the last published transactions */
 
   fd_wksp_t * wksp = fd_funk_wksp( funk );
-  fd_funk_txn_update( &funk->rec_head_idx, &funk->rec_tail_idx, FD_FUNK_TXN_IDX_NULL, fd_funk_root( funk ),
-                      txn_idx, funk->rec_max, map, fd_funk_rec_map( funk, wksp ), fd_funk_get_partvec( funk, wksp ),
-                      fd_funk_alloc( funk, wksp ), wksp );
+  if( FD_LIKELY( !tpool ) )
+    fd_funk_txn_update    ( &funk->rec_head_idx, &funk->rec_tail_idx, FD_FUNK_TXN_IDX_NULL, fd_funk_root( funk ),
+                            txn_idx, funk->rec_max, map, fd_funk_rec_map( funk, wksp ), fd_funk_get_partvec( funk, wksp ),
+                            fd_funk_alloc( funk, wksp ), wksp );
+  else
+    fd_funk_txn_update_par( &funk->rec_head_idx, &funk->rec_tail_idx, fd_funk_root( funk ),
+                            txn_idx, funk->rec_max, map, fd_funk_rec_map( funk, wksp ), fd_funk_get_partvec( funk, wksp ),
+                            fd_funk_alloc( funk, wksp ), wksp, tpool, t0, t1 );
 
   /* Cancel all competing transaction histories */
 
@@ -725,10 +944,13 @@ fd_funk_txn_publish_funk_child( fd_funk_t *     funk,
   return FD_FUNK_SUCCESS;
 }
 
-ulong
-fd_funk_txn_publish( fd_funk_t *     funk,
-                     fd_funk_txn_t * txn,
-                     int             verbose ) {
+static ulong
+fd_funk_txn_publish_private( fd_funk_t *     funk,
+                             fd_funk_txn_t * txn,
+                             fd_tpool_t *    tpool, /* NULL for a single threaded publish */
+                             ulong           t0,
+                             ulong           t1,
+                             int             verbose ) {
 
   if( FD_UNLIKELY( !funk ) ) {
     if( FD_UNLIKELY( verbose ) ) FD_LOG_WARNING(( "NULL funk" ));
@@ -789,7 +1011,7 @@ fd_funk_txn_publish( fd_funk_t *     funk,
        each publish as txn and its siblings we potentially visited in a
        previous iteration of this loop. */
 
-    if( FD_UNLIKELY( fd_funk_txn_publish_funk_child( funk, map, txn_max, funk->cycle_tag++, txn_idx ) ) ) break;
+    if( FD_UNLIKELY( fd_funk_txn_publish_funk_child( funk, map, txn_max, funk->cycle_tag++, txn_idx, tpool, t0, t1 ) ) ) break;
     publish_cnt++;
 
     txn_idx = publish_stack_idx;
@@ -800,6 +1022,28 @@ fd_funk_txn_publish( fd_funk_t *     funk,
   return publish_cnt;
 }
 
+ulong
+fd_funk_txn_publish( fd_funk_t *     funk,
+                     fd_funk_txn_t * txn,
+                     int             verbose ) {
+  return fd_funk_txn_publish_private( funk, txn, NULL, 0UL, 0UL, verbose );
+}
+
+ulong
+fd_funk_txn_publish_par( fd_funk_t *     funk,
+                         fd_funk_txn_t * txn,
+                         fd_tpool_t *    tpool,
+                         ulong           t0,
+                         ulong           t1,
+                         int             verbose ) {
+  if( FD_UNLIKELY( tpool && ((t0>=t1) | (t1>fd_tpool_worker_cnt( tpool ))) ) ) {
+    if( FD_UNLIKELY( verbose ) ) FD_LOG_WARNING(( "bad tpool threads [%lu,%lu)", t0, t1 ));
+    return 0UL;
+  }
+  if( FD_UNLIKELY( (t1-t0)<2UL ) ) tpool = NULL; /* Single threaded */
+  return fd_funk_txn_publish_private( funk, txn, tpool, t0, t1, verbose );
+}
+
 int
 fd_funk_txn_publish_into_parent( fd_funk_t *     funk,
                                  fd_funk_txn_t * txn,
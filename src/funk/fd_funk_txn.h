@@ -413,6 +413,35 @@ fd_funk_txn_publish( fd_funk_t *     funk,
                      fd_funk_txn_t * txn,
                      int             verbose );
 
+/* fd_funk_txn_publish_par is fd_funk_txn_publish but merges the records
+   of each transaction published into the last published transaction
+   using tpool threads [t0,t1).  The result is identical to
+   fd_funk_txn_publish (including the order of the published records).
+   This is meant for rooting transactions that updated a large number of
+   records (e.g. a slot that modified millions of accounts).
+
+   The record map lookups and value frees of the merge are done in
+   parallel (records are partitioned over the threads by record map
+   chain) and the remaining record list and partition bookkeeping is
+   done serially by the caller.  As such, the time to publish a
+   transaction with n updated records is roughly O(n) cheap serial
+   operations plus O(n/(t1-t0)) expensive ones.
+
+   The caller masquerades as thread t0 (it should not be one of the
+   threads (t0,t1)) and threads (t0,t1) should be idle on entry and not
+   be dispatched to while this is running.  If tpool is NULL or t1-t0 is
+   1, this is equivalent to fd_funk_txn_publish.  Otherwise, t0<t1 and
+   t1<=fd_tpool_worker_cnt( tpool ) (returns 0 if not, logs details if
+   verbose). */
+
+ulong
+fd_funk_txn_publish_par( fd_funk_t *     funk,
+                         fd_funk_txn_t * txn,
+                         fd_tpool_t *    tpool,
+                         ulong           t0,
+                         ulong           t1,
+                         int             verbose );
+
 /* This version of publish just combines the transaction with its
    immediate parent. Ancestors will remain unpublished. Any competing
    histories (siblings of the given transaction) are still cancelled.
@@ -28,8 +28,8 @@ fd_funk_val_copy( fd_funk_rec_t * rec,
   ulong v0 = val_max ? (ulong)fd_wksp_laddr_fast( wksp, val_gaddr ) : 0UL; /* Technically don't need trinary */
   ulong v1 = v0 + val_max;
 
-  if( FD_UNLIKELY( ((!!sz) & (!!val_max) & (!((d1<=v0) | (d0>=v1)))) |     /* data overlaps val alloc */
-                   (!!(rec->flags & FD_FUNK_REC_FLAG_ERASE))         ) ) { /* marked erase */
+  if( FD_UNLIKELY( ((!!sz) & (!!val_max) & (!((d1<=v0) | (d0>=v1))))                 |     /* data overlaps val alloc */
+                   (!!(rec->flags & (FD_FUNK_REC_FLAG_ERASE | FD_FUNK_REC_FLAG_COLD))) ) ) { /* marked erase, cold */
     fd_int_store_if( !!opt_err, opt_err, FD_FUNK_ERR_INVAL );
     return NULL;
   }
@@ -119,8 +119,8 @@ fd_funk_val_append( fd_funk_rec_t * rec,
   ulong v1 = v0 + val_max;
 
   if( FD_UNLIKELY( (new_val_sz<val_sz) | (new_val_sz>FD_FUNK_REC_VAL_MAX) |     /* too large sz */
-                   ((!!val_max) & (!((d1<=v0) | (d0>=v1))))               |     /* data overlaps with val alloc */
-                   (!!(rec->flags & FD_FUNK_REC_FLAG_ERASE))              ) ) { /* marked erase */
+                   ((!!val_max) & (!((d1<=v0) | (d0>=v1))))                                  |     /* data overlaps with val alloc */
+                   (!!(rec->flags & (FD_FUNK_REC_FLAG_ERASE | FD_FUNK_REC_FLAG_COLD)))       ) ) { /* marked erase, cold */
     fd_int_store_if( !!opt_err, opt_err, FD_FUNK_ERR_INVAL );
     return NULL;
   }
@@ -179,7 +179,7 @@ fd_funk_val_truncate( fd_funk_rec_t * rec,
   /* Check input args */
 
   if( FD_UNLIKELY( (!rec) | (new_val_sz>FD_FUNK_REC_VAL_MAX) | (!alloc) | (!wksp) ) ||  /* NULL rec,too big,NULL alloc,NULL wksp */
-      FD_UNLIKELY( rec->flags & FD_FUNK_REC_FLAG_ERASE                            ) ) { /* Marked erase */
+      FD_UNLIKELY( rec->flags & (FD_FUNK_REC_FLAG_ERASE | FD_FUNK_REC_FLAG_COLD)  ) ) { /* Marked erase, cold */
     fd_int_store_if( !!opt_err, opt_err, FD_FUNK_ERR_INVAL );
     return NULL;
   }
@@ -265,6 +265,7 @@ fd_funk_val_verify( fd_funk_t * funk ) {
   fd_wksp_t *     wksp     = fd_funk_wksp( funk );          /* Previously verified */
   fd_funk_rec_t * rec_map  = fd_funk_rec_map( funk, wksp ); /* Previously verified */
   ulong           wksp_tag = funk->wksp_tag;                /* Previously verified */
+  ulong           cold_off = funk->cold_off;
 
   /* At this point, rec_map has been extensively verified */
 
@@ -287,6 +288,18 @@ fd_funk_val_verify( fd_funk_t * funk ) {
     ulong val_max   = (ulong)rec->val_max;
     ulong val_gaddr = rec->val_gaddr;
 
+    if( rec->flags & FD_FUNK_REC_FLAG_COLD ) {
+      TEST( !(rec->flags & FD_FUNK_REC_FLAG_ERASE) );
+      TEST( fd_funk_txn_idx_is_null( fd_funk_txn_idx( rec->txn_cidx ) ) );
+      TEST( (0UL<val_sz) & (val_sz<=FD_FUNK_REC_VAL_MAX) );
+      TEST( !val_max   );
+      TEST( !val_gaddr );
+      TEST( fd_funk_cold_blob_sz( val_sz ) <= cold_off     );
+      TEST( rec->cold_off <= cold_off - fd_funk_cold_blob_sz( val_sz ) );
+      continue;
+    }
+
+    TEST( !rec->cold_off );
     TEST( val_sz<=val_max );
 
     if( rec->flags & FD_FUNK_REC_FLAG_ERASE ) {
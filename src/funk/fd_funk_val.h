@@ -35,8 +35,10 @@ fd_funk_val_max( fd_funk_rec_t const * rec ) { /* Assumes pointer in caller's ad
    const-correct version.  There are sz bytes at the returned pointer.
    IMPORTANT SAFETY TIP!  There are _no_ alignment guarantees on the
    returned value.  Returns NULL if the record has a zero sz (which also
-   covers the case where rec has been marked ERASE).  max 0 implies val
-   NULL and vice versa.  Assumes no concurrent operations on rec. */
+   covers the case where rec has been marked ERASE).  Also returns NULL
+   if the record value is cold (in which case sz is non-zero, see
+   fd_funk_cold_load).  max 0 implies val NULL and vice versa.  Assumes
+   no concurrent operations on rec. */
 
 FD_FN_PURE static inline void *         /* Lifetime is the lesser of rec or the value size is modified */
 fd_funk_val( fd_funk_rec_t const * rec,     /* Assumes pointer in caller's address space to a live funk record */
@@ -57,8 +59,8 @@ fd_funk_val_const( fd_funk_rec_t const * rec,     /* Assumes pointer in caller's
 /* fd_funk_rec_read reads bytes [off,off+sz) and returns a pointer to
    the requested data on success and NULL on failure.  Reasons for
    failure include NULL rec, 0 sz, [off,off+sz) does not overlap
-   completely val, NULL wksp, marked ERASE.  Assumes no concurrent
-   operations on rec.
+   completely val, NULL wksp, marked ERASE, value is cold.  Assumes no
+   concurrent operations on rec.
 
    The returned pointer is in the caller's address space and, if
    non-NULL, the value at the pointer is stable for its lifetime or
@@ -83,8 +85,8 @@ fd_funk_val_read( fd_funk_rec_t const * rec,     /* Assumes pointer in caller's
 
   ulong end = off + sz;
 
-  if( FD_UNLIKELY( (!rec) | (end<=off) | (!wksp) ) ||             /* NULL rec, sz==0 or off+sz wrapped, NULL wksp */
-      FD_UNLIKELY( (end>(ulong)rec->val_sz)      ) ) return NULL; /* Read past end (covers marked ERASE case too) */
+  if( FD_UNLIKELY( (!rec) | (end<=off) | (!wksp) ) ||                         /* NULL rec, sz==0 or off+sz wrapped, NULL wksp */
+      FD_UNLIKELY( (end>(ulong)rec->val_sz) | (!rec->val_gaddr) ) ) return NULL; /* Read past end (covers marked ERASE case too), cold */
 
   return fd_wksp_laddr_fast( wksp, rec->val_gaddr + off );
 }
@@ -157,7 +159,8 @@ fd_funk_val_write( fd_funk_rec_t *   rec,     /* Assumed in caller's address spa
    FD_FUNK_ERR_* code on failure.  Reasons for failure include
    FD_FUNK_ERR_INVAL (NULL rec, NULL data with non-zero sz, NULL alloc,
    NULL wksp, data region wraps, sz>sz_est, sz_est too large, rec is
-   marked as ERASE, data region overlaps the existing val allocation)
+   marked as ERASE, rec value is cold, data region overlaps the existing
+   val allocation)
    and FD_FUNK_ERR_MEM (allocation failure, need a larger wksp).  On
    failure, the current value is unchanged.
 
@@ -187,8 +190,9 @@ fd_funk_val_copy( fd_funk_rec_t * rec,       /* Assumed in caller's address spac
    on return, *opt_err will hold FD_FUNK_SUCCESS if successful or a
    FD_FUNK_ERR_* code on failure.  Reasons for failure include
    FD_FUNK_ERR_INVAL (NULL rec, NULL data with non-zero sz,
-   [data,data+sz) wraps, NULL alloc, NULL wksp, rec marked ERASE, sz too
-   large, data region overlaps with existing record value allocation)
+   [data,data+sz) wraps, NULL alloc, NULL wksp, rec marked ERASE, rec
+   value is cold, sz too large, data region overlaps with existing
+   record value allocation)
    and FD_FUNK_ERR_MEM (allocation failure, need a larger wksp).  On
    failure, the current value is unchanged.
 
@@ -221,7 +225,8 @@ fd_funk_val_append( fd_funk_rec_t * rec,       /* Assumed in caller's address sp
    on return, *opt_err will hold FD_FUNK_SUCCESS if successful or a
    FD_FUNK_ERR_* code on failure.  Reasons for failure include
    FD_FUNK_ERR_INVAL (NULL rec, too large new_val_sz, rec is marked
-   ERASE) and FD_FUNK_ERR_MEM (allocation failure, need a larger wksp).
+   ERASE, rec value is cold) and FD_FUNK_ERR_MEM (allocation failure,
+   need a larger wksp).
    On failure, the current value is unchanged.
 
    Assumes no concurrent operations on rec. */
@@ -236,18 +241,22 @@ fd_funk_val_truncate( fd_funk_rec_t * rec,        /* Assumed in caller's address
 /* Misc */
 
 /* fd_funk_val_init sets a record with uninitialized value metadata to
-   the NULL value.  Meant for internal use. */
+   the NULL value (this includes clearing the cold flag).  Meant for
+   internal use. */
 
 static inline fd_funk_rec_t *             /* Returns rec */
 fd_funk_val_init( fd_funk_rec_t * rec ) { /* Assumed record in caller's address space with uninitialized value metadata */
   rec->val_sz    = 0U;
   rec->val_max   = 0U;
   rec->val_gaddr = 0UL;
+  rec->cold_off  = 0UL;
+  rec->flags    &= ~FD_FUNK_REC_FLAG_COLD;
   return rec;
 }
 
 /* fd_funk_val_flush sets a record to the NULL value, discarding the
-   current value if any.  Meant for internal use. */
+   current value if any.  If the value was cold, it is left in the cold
+   file as dead space.  Meant for internal use. */
 
 static inline fd_funk_rec_t *               /* Returns rec */
 fd_funk_val_flush( fd_funk_rec_t * rec,     /* Assumed live funk record in caller's address space */
@@ -0,0 +1,291 @@
+#include "fd_funk.h"
+
+#if FD_HAS_HOSTED
+
+#include <errno.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+FD_STATIC_ASSERT( FD_FUNK_REC_FLAG_COLD==2UL, unit_test );
+FD_STATIC_ASSERT( FD_FUNK_COLD_ALIGN==8UL,    unit_test );
+
+FD_STATIC_ASSERT( sizeof(fd_funk_cold_hdr_t)==96UL, unit_test );
+
+static fd_funk_rec_key_t *
+key_set( fd_funk_rec_key_t * key,
+         ulong               _key ) {
+  fd_memset( key, 0, sizeof(fd_funk_rec_key_t) );
+  key->ul[0] = _key;
+  key->ul[7] = ~_key;
+  return key;
+}
+
+static fd_funk_txn_xid_t *
+xid_set( fd_funk_txn_xid_t * xid,
+         ulong               _xid ) {
+  fd_memset( xid, 0, sizeof(fd_funk_txn_xid_t) );
+  xid->ul[0] = _xid;
+  return xid;
+}
+
+/* val_sz returns the size of the value of record key in generation gen
+   and val_byte the byte at off of that value. */
+
+static ulong val_sz  ( ulong key, ulong gen            ) { return 1UL + (fd_ulong_hash( key ^ (gen<<32) ) & 1023UL); }
+static uchar val_byte( ulong key, ulong gen, ulong off ) { return (uchar)fd_ulong_hash( (key<<20) ^ (gen<<48) ^ off ); }
+
+static void
+val_fill( uchar * val,
+          ulong   key,
+          ulong   gen ) {
+  ulong sz = val_sz( key, gen );
+  for( ulong off=0UL; off<sz; off++ ) val[ off ] = val_byte( key, gen, off );
+}
+
+static int
+val_check( fd_funk_rec_t const * rec,
+           fd_wksp_t *           wksp,
+           ulong                 key,
+           ulong                 gen ) {
+  ulong sz = val_sz( key, gen );
+  if( fd_funk_val_sz( rec )!=sz ) return 0;
+  uchar const * val = (uchar const *)fd_funk_val_const( rec, wksp );
+  if( !val ) return 0;
+  for( ulong off=0UL; off<sz; off++ ) if( val[ off ]!=val_byte( key, gen, off ) ) return 0;
+  return 1;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL,      "gigantic" );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL,             1UL );
+  ulong        near_cpu = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu", NULL, fd_log_cpu_id() );
+  ulong        wksp_tag = fd_env_strip_cmdline_ulong( &argc, &argv, "--wksp-tag", NULL,          1234UL );
+  ulong        seed     = fd_env_strip_cmdline_ulong( &argc, &argv, "--seed",     NULL,          5678UL );
+  ulong        rec_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--rec-cnt",  NULL,          1024UL );
+
+  FD_LOG_NOTICE(( "Testing with --page-sz %s --page-cnt %lu --near-cpu %lu --wksp-tag %lu --seed %lu --rec-cnt %lu",
+                  _page_sz, page_cnt, near_cpu, wksp_tag, seed, rec_cnt ));
+
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  if( FD_UNLIKELY( !wksp ) ) FD_LOG_ERR(( "Unable to attach to wksp" ));
+
+  fd_funk_t * funk = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), wksp_tag ),
+                                                wksp_tag, seed, 4UL, 2UL*rec_cnt ) );
+  if( FD_UNLIKELY( !funk ) ) FD_LOG_ERR(( "Unable to create funk" ));
+
+  fd_alloc_t * alloc = fd_funk_alloc( funk, wksp );
+
+  char path[] = "/tmp/test_funk_cold.XXXXXX";
+  int fd = mkstemp( path );
+  if( FD_UNLIKELY( fd<0 ) ) FD_LOG_ERR(( "mkstemp failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  FD_TEST( !unlink( path ) );
+
+  fd_funk_rec_key_t key[1];
+  fd_funk_rec_key_t keys[8];
+  fd_funk_txn_xid_t xid[1];
+  uchar             buf[ 1024 ];
+
+  /* Populate the last published transaction */
+
+  for( ulong k=0UL; k<rec_cnt; k++ ) {
+    fd_funk_rec_t * rec = fd_funk_rec_modify( funk, fd_funk_rec_insert( funk, NULL, key_set( key, k ), NULL ) );
+    FD_TEST( rec );
+    val_fill( buf, k, 0UL );
+    FD_TEST( fd_funk_val_copy( rec, buf, val_sz( k, 0UL ), 0UL, alloc, wksp, NULL )==rec );
+  }
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  /* Test attach / detach */
+
+  int err;
+
+  FD_TEST( fd_funk_cold_fd  ( funk )==-1  );
+  FD_TEST( fd_funk_cold_sz  ( funk )==0UL );
+  FD_TEST( fd_funk_cold_slot( funk )==0UL );
+
+  FD_TEST( fd_funk_cold_evict( funk, 10UL, 0UL, ULONG_MAX, &err )==0UL ); FD_TEST( err==FD_FUNK_ERR_INVAL );
+  FD_TEST( fd_funk_cold_attach( NULL, fd )==FD_FUNK_ERR_INVAL );
+  FD_TEST( fd_funk_cold_attach( funk, -1 )==FD_FUNK_ERR_INVAL );
+  FD_TEST( fd_funk_cold_attach( funk, fd )==FD_FUNK_SUCCESS   );
+  FD_TEST( fd_funk_cold_attach( funk, fd )==FD_FUNK_ERR_INVAL );
+  FD_TEST( fd_funk_cold_fd( funk )==fd );
+
+  /* All records were stamped at slot 0 */
+
+  FD_TEST( fd_funk_cold_evict( funk, 0UL, 0UL, 0UL, &err )==0UL ); FD_TEST( err==FD_FUNK_SUCCESS );
+  FD_TEST( fd_funk_cold_sz( funk )==0UL );
+
+  /* Touch even keys at slot 5, all odd keys are older than 8 slots at slot 10 */
+
+  FD_TEST( fd_funk_cold_evict( funk, 5UL, ULONG_MAX, ULONG_MAX, &err )==0UL ); FD_TEST( err==FD_FUNK_SUCCESS );
+  for( ulong k=0UL; k<rec_cnt; k+=2UL ) FD_TEST( fd_funk_rec_query_warm( funk, NULL, key_set( key, k ), NULL ) );
+
+  ulong expect_sz = 0UL;
+  for( ulong k=1UL; k<rec_cnt; k+=2UL ) expect_sz += fd_funk_cold_blob_sz( val_sz( k, 0UL ) );
+
+  FD_TEST( fd_funk_cold_evict( funk, 10UL, 8UL, ULONG_MAX, &err )==rec_cnt/2UL ); FD_TEST( err==FD_FUNK_SUCCESS );
+  FD_TEST( fd_funk_cold_sz  ( funk )==expect_sz );
+  FD_TEST( fd_funk_cold_slot( funk )==10UL      );
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  for( ulong k=0UL; k<rec_cnt; k++ ) {
+    fd_funk_rec_t const * rec = fd_funk_rec_query_const( funk, NULL, key_set( key, k ) );
+    FD_TEST( rec );
+    FD_TEST( fd_funk_rec_is_cold( rec )==(int)(k & 1UL) );
+    FD_TEST( fd_funk_val_sz( rec )==val_sz( k, 0UL ) );
+    if( k & 1UL ) {
+      FD_TEST( !fd_funk_val_max  ( rec )                );
+      FD_TEST( !fd_funk_val_const( rec, wksp )          );
+      FD_TEST( !fd_funk_val_read ( rec, 0UL, 1UL, wksp ) );
+      FD_TEST( !fd_funk_val_truncate( (fd_funk_rec_t *)rec, 1UL, alloc, wksp, &err ) ); FD_TEST( err==FD_FUNK_ERR_INVAL );
+    } else {
+      FD_TEST( val_check( rec, wksp, k, 0UL ) );
+      FD_TEST( fd_funk_cold_read( funk, rec, 0UL, buf, 1UL )==FD_FUNK_ERR_INVAL ); /* Not cold */
+    }
+  }
+
+  /* Nothing left to evict */
+
+  FD_TEST( fd_funk_cold_evict( funk, 20UL, 0UL, ULONG_MAX, &err )==rec_cnt/2UL ); FD_TEST( err==FD_FUNK_SUCCESS );
+  FD_TEST( fd_funk_cold_evict( funk, 30UL, 0UL, ULONG_MAX, &err )==0UL         ); FD_TEST( err==FD_FUNK_SUCCESS );
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  /* Plain queries don't load or stamp */
+
+  fd_funk_rec_t const * cold = fd_funk_rec_query_global( funk, NULL, key_set( key, 0UL ) );
+  FD_TEST( cold && fd_funk_rec_is_cold( cold ) );
+  FD_TEST( fd_funk_rec_query( funk, NULL, key )==cold );
+  FD_TEST( fd_funk_rec_is_cold( cold ) );
+  FD_TEST( cold->touch_slot==5UL );
+
+  FD_TEST( !fd_funk_rec_query_warm( NULL, NULL, key,                         &err ) ); FD_TEST( err==FD_FUNK_ERR_INVAL );
+  FD_TEST( !fd_funk_rec_query_warm( funk, NULL, key_set( key, rec_cnt ), &err ) ); FD_TEST( err==FD_FUNK_ERR_KEY   );
+
+  /* Cold values can be read in place in pieces */
+
+  for( ulong k=0UL; k<rec_cnt; k+=64UL ) {
+    fd_funk_rec_t const * rec = fd_funk_rec_query_const( funk, NULL, key_set( key, k ) );
+    ulong sz  = val_sz( k, 0UL );
+    ulong mid = sz/2UL;
+    FD_TEST( fd_funk_cold_read( funk, rec, 0UL, buf,     mid    )==FD_FUNK_SUCCESS );
+    FD_TEST( fd_funk_cold_read( funk, rec, mid, buf+mid, sz-mid )==FD_FUNK_SUCCESS );
+    for( ulong off=0UL; off<sz; off++ ) FD_TEST( buf[ off ]==val_byte( k, 0UL, off ) );
+    FD_TEST( fd_funk_cold_read( funk, rec, sz,  buf, 0UL )==FD_FUNK_SUCCESS   );
+    FD_TEST( fd_funk_cold_read( funk, rec, sz,  buf, 1UL )==FD_FUNK_ERR_INVAL );
+    FD_TEST( fd_funk_cold_read( funk, rec, 0UL, NULL, 1UL )==FD_FUNK_ERR_INVAL );
+    FD_TEST( fd_funk_cold_read( NULL, rec, 0UL, buf, 1UL )==FD_FUNK_ERR_INVAL );
+    FD_TEST( fd_funk_rec_is_cold( rec ) );
+    FD_TEST( rec->touch_slot==(k & 1UL ? 0UL : 5UL) );
+  }
+
+  /* Prefetch, then load the first quarter back by a warm query */
+
+  for( ulong k=0UL; k<8UL; k++ ) key_set( keys + k, 8UL*k );
+  FD_TEST( fd_funk_cold_prefetch( funk, NULL, keys, 8UL )==8UL );
+
+  for( ulong k=0UL; k<rec_cnt/4UL; k++ ) {
+    fd_funk_rec_t const * rec = fd_funk_rec_query_warm( funk, NULL, key_set( key, k ), &err );
+    FD_TEST( rec ); FD_TEST( err==FD_FUNK_SUCCESS );
+    FD_TEST( !fd_funk_rec_is_cold( rec ) );
+    FD_TEST( rec->touch_slot==30UL );
+    FD_TEST( val_check( rec, wksp, k, 0UL ) );
+  }
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  /* Load the second quarter back by a modify and rewrite it */
+
+  for( ulong k=rec_cnt/4UL; k<rec_cnt/2UL; k++ ) {
+    fd_funk_rec_t * rec = fd_funk_rec_modify( funk, fd_funk_rec_query_const( funk, NULL, key_set( key, k ) ) );
+    FD_TEST( rec );
+    FD_TEST( !fd_funk_rec_is_cold( rec ) );
+    FD_TEST( val_check( rec, wksp, k, 0UL ) );
+    val_fill( buf, k, 1UL );
+    FD_TEST( fd_funk_val_copy( rec, buf, val_sz( k, 1UL ), 0UL, alloc, wksp, NULL )==rec );
+  }
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  /* Detached cold values cannot be loaded */
+
+  FD_TEST( fd_funk_cold_detach( funk )==fd );
+  FD_TEST( fd_funk_cold_detach( funk )==-1 );
+  FD_TEST( !fd_funk_cold_prefetch( funk, NULL, key_set( key, rec_cnt/2UL ), 1UL ) );
+  FD_TEST( fd_funk_cold_load( funk, fd_funk_rec_query_const( funk, NULL, key ) )==FD_FUNK_ERR_SYS );
+  FD_TEST( fd_funk_cold_read( funk, fd_funk_rec_query_const( funk, NULL, key ), 0UL, buf, 1UL )==FD_FUNK_ERR_SYS );
+  FD_TEST( !fd_funk_rec_query_warm( funk, NULL, key, &err ) ); FD_TEST( err==FD_FUNK_ERR_SYS );
+  FD_TEST( fd_funk_rec_is_cold( fd_funk_rec_query_const( funk, NULL, key ) ) );
+  FD_TEST( fd_funk_cold_attach( funk, fd )==FD_FUNK_SUCCESS );
+
+  /* Update the third quarter from an in-preparation transaction and
+     erase the fourth quarter, then publish */
+
+  fd_funk_txn_t * txn = fd_funk_txn_prepare( funk, NULL, xid_set( xid, 1UL ), 0 );
+  FD_TEST( txn );
+
+  for( ulong k=rec_cnt/2UL; k<3UL*rec_cnt/4UL; k++ ) {
+    FD_TEST( fd_funk_rec_is_cold( fd_funk_rec_query_global_const( funk, txn, key_set( key, k ) ) ) );
+    fd_funk_rec_t * rec = fd_funk_rec_write_prepare( funk, txn, key, val_sz( k, 2UL ), 0, NULL, &err );
+    FD_TEST( rec ); FD_TEST( err==FD_FUNK_SUCCESS );
+    FD_TEST( !fd_funk_rec_is_cold( fd_funk_rec_query_const( funk, NULL, key ) ) ); /* Ancestor was loaded to copy it */
+    val_fill( buf, k, 2UL );
+    FD_TEST( fd_funk_val_copy( rec, buf, val_sz( k, 2UL ), 0UL, alloc, wksp, NULL )==rec );
+  }
+
+  for( ulong k=3UL*rec_cnt/4UL; k<rec_cnt; k++ ) {
+    fd_funk_rec_t const * rec = fd_funk_rec_query_const( funk, NULL, key_set( key, k ) );
+    FD_TEST( fd_funk_rec_is_cold( rec ) );
+    fd_funk_rec_t * erase = fd_funk_rec_modify( funk, fd_funk_rec_insert( funk, txn, key, NULL ) );
+    FD_TEST( erase );
+    FD_TEST( !fd_funk_rec_remove( funk, erase, 1 ) );
+    FD_TEST( fd_funk_rec_is_cold( rec ) ); /* Erasing from a txn does not need the value */
+  }
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  FD_TEST( fd_funk_cold_evict( funk, 40UL, 0UL, ULONG_MAX, &err )==3UL*rec_cnt/4UL ); FD_TEST( err==FD_FUNK_SUCCESS );
+  FD_TEST( fd_funk_txn_publish( funk, txn, 0 )==1UL );
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  for( ulong k=0UL; k<rec_cnt; k++ ) {
+    fd_funk_rec_t const * rec = fd_funk_rec_query_warm( funk, NULL, key_set( key, k ), NULL );
+    if( k<rec_cnt/4UL          ) FD_TEST( rec && val_check( rec, wksp, k, 0UL ) );
+    else if( k<rec_cnt/2UL     ) FD_TEST( rec && val_check( rec, wksp, k, 1UL ) );
+    else if( k<3UL*rec_cnt/4UL ) FD_TEST( rec && val_check( rec, wksp, k, 2UL ) );
+    else                         FD_TEST( !rec );
+  }
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  /* Evict everything and check the file accounting */
+
+  expect_sz = fd_funk_cold_sz( funk );
+  for( ulong k=0UL; k<3UL*rec_cnt/4UL; k++ ) expect_sz += fd_funk_cold_blob_sz( val_sz( k, k/(rec_cnt/4UL) ) );
+  FD_TEST( fd_funk_cold_evict( funk, 50UL, 0UL, ULONG_MAX, &err )==3UL*rec_cnt/4UL ); FD_TEST( err==FD_FUNK_SUCCESS );
+  FD_TEST( fd_funk_cold_sz( funk )==expect_sz );
+  FD_TEST( fd_funk_rec_global_cnt( funk, wksp )==3UL*rec_cnt/4UL );
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  FD_TEST( fd_funk_cold_detach( funk )==fd );
+  FD_TEST( !close( fd ) );
+
+  fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( funk ) ) );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
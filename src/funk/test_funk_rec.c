@@ -11,6 +11,8 @@ FD_STATIC_ASSERT( FD_FUNK_REC_IDX_NULL==ULONG_MAX, unit_test );
 
 #include "test_funk_common.h"
 
+static uchar tpool_mem[ FD_TPOOL_FOOTPRINT( FD_TILE_MAX ) ] __attribute__((aligned(FD_TPOOL_ALIGN)));
+
 int
 main( int     argc,
       char ** argv ) {
@@ -57,6 +59,10 @@ main( int     argc,
   FD_TEST( !fd_funk_rec_cnt    ( rec_map ) );
   FD_TEST( !fd_funk_rec_is_full( rec_map ) );
 
+  ulong        tile_cnt = fd_tile_cnt();
+  fd_tpool_t * tpool    = fd_tpool_init( tpool_mem, tile_cnt ); FD_TEST( tpool );
+  for( ulong tile_idx=1UL; tile_idx<tile_cnt; tile_idx++ ) FD_TEST( fd_tpool_worker_push( tpool, tile_idx, NULL, 0UL ) );
+
   funk_t * ref = funk_new();
 
   for( ulong iter=0UL; iter<iter_max; iter++ ) {
@@ -502,7 +508,9 @@ main( int     argc,
       fd_funk_txn_t * ttxn = fd_funk_txn_query( xid_set( txid, rtxn->xid ), txn_map );
 
       ulong cnt = txn_publish( ref, rtxn, 0UL );
-      FD_TEST( fd_funk_txn_publish( tst, ttxn, verbose )==cnt );
+      if( fd_rng_uint( rng ) & 1U ) FD_TEST( fd_funk_txn_publish    ( tst, ttxn, verbose )==cnt );
+      else                          FD_TEST( fd_funk_txn_publish_par( tst, ttxn, tpool, 0UL, 1UL+fd_rng_ulong_roll( rng, tile_cnt ),
+                                                                      verbose )==cnt );
     }
 
   }
@@ -510,6 +518,121 @@ main( int     argc,
   funk_delete( ref );
 
   fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( tst ) ) );
+
+  /* Benchmark fd_funk_rec_query_global against fork depth.  The last
+     published transaction holds bench_key_cnt keys and each level of a
+     linear chain of depth in-preparation transactions updates one of
+     them.  Queries are done from the youngest transaction of the chain
+     for random keys such that most resolve to the published version
+     (the case that used to probe the record map once per ancestor). */
+
+  do {
+    ulong bench_key_cnt   = 1024UL;
+    ulong bench_depth_max = 64UL;
+    ulong bench_iter_cnt  = 1UL<<20;
+
+    fd_funk_t * bench = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), wksp_tag ),
+                                                   wksp_tag, seed, bench_depth_max, bench_key_cnt+bench_depth_max ) );
+    if( FD_UNLIKELY( !bench ) ) FD_LOG_ERR(( "Unable to create bench" ));
+
+    fd_funk_rec_key_t bkey[1];
+    fd_funk_txn_xid_t bxid[1];
+
+    for( ulong key_idx=0UL; key_idx<bench_key_cnt; key_idx++ )
+      FD_TEST( fd_funk_rec_insert( bench, NULL, key_set( bkey, key_idx ), NULL ) );
+
+    fd_funk_txn_t * chain[ 64 ];
+
+    for( ulong depth=1UL; depth<=bench_depth_max; depth<<=1 ) {
+
+      fd_funk_txn_t * tip = NULL;
+      for( ulong lvl=0UL; lvl<depth; lvl++ ) {
+        tip = fd_funk_txn_prepare( bench, tip, xid_set( bxid, xid_unique() ), verbose );
+        FD_TEST( tip );
+        FD_TEST( fd_funk_rec_insert( bench, tip, key_set( bkey, lvl ), NULL ) );
+        chain[ lvl ] = tip;
+      }
+
+      for( ulong key_idx=0UL; key_idx<bench_key_cnt; key_idx++ ) {
+        fd_funk_rec_t const * rec = fd_funk_rec_query_global( bench, tip, key_set( bkey, key_idx ) );
+        FD_TEST( rec );
+        FD_TEST( rec==fd_funk_rec_query_global_const( bench, tip, bkey ) );
+        if( key_idx<depth ) FD_TEST( fd_funk_txn_xid_eq( fd_funk_rec_xid( rec ), fd_funk_txn_xid( chain[ key_idx ] ) ) );
+        else                FD_TEST( fd_funk_txn_xid_eq_root( fd_funk_rec_xid( rec ) ) );
+      }
+
+      ulong hit_cnt = 0UL;
+      long  tic     = fd_log_wallclock();
+      for( ulong iter=0UL; iter<bench_iter_cnt; iter++ )
+        hit_cnt += !!fd_funk_rec_query_global( bench, tip, key_set( bkey, fd_rng_ulong( rng ) & (bench_key_cnt-1UL) ) );
+      long  toc     = fd_log_wallclock();
+      FD_TEST( hit_cnt==bench_iter_cnt );
+
+      FD_LOG_NOTICE(( "fork depth %2lu: %.3f ns/query_global", depth, (double)(toc-tic)/(double)bench_iter_cnt ));
+
+      FD_TEST( fd_funk_txn_cancel_all( bench, verbose )==depth );
+    }
+
+    fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( bench ) ) );
+  } while(0);
+
+  /* Benchmark fd_funk_txn_publish_par against thread count.  The last
+     published transaction holds bench_rec_cnt records and the published
+     transaction erases 1/4 of them, updates 1/2 of them and creates
+     bench_rec_cnt/2 new ones. */
+
+  do {
+    ulong bench_rec_cnt = 1UL<<17;
+    ulong bench_val_sz  = 64UL;
+
+    fd_funk_rec_key_t bkey[1];
+    fd_funk_txn_xid_t bxid[1];
+    uchar             bval[ 64 ];
+    int               err;
+
+    fd_memset( bval, 0xa5, bench_val_sz );
+
+    FD_TEST( !fd_funk_txn_publish_par( tst, NULL, tpool, 0UL, 0UL,          verbose ) ); /* bad thread range */
+    FD_TEST( !fd_funk_txn_publish_par( tst, NULL, tpool, 0UL, tile_cnt+1UL, verbose ) ); /* bad thread range */
+
+    for( ulong thread_cnt=1UL; thread_cnt<=tile_cnt; thread_cnt<<=1 ) {
+
+      fd_funk_t * bench = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), wksp_tag ),
+                                                     wksp_tag, seed, 2UL, 3UL*bench_rec_cnt ) );
+      if( FD_UNLIKELY( !bench ) ) FD_LOG_ERR(( "Unable to create bench" ));
+      fd_alloc_t * balloc = fd_funk_alloc( bench, wksp );
+
+      for( ulong key_idx=0UL; key_idx<bench_rec_cnt; key_idx++ ) {
+        fd_funk_rec_t * rec = fd_funk_rec_modify( bench, fd_funk_rec_insert( bench, NULL, key_set( bkey, key_idx ), NULL ) );
+        FD_TEST( fd_funk_val_copy( rec, bval, bench_val_sz, 0UL, balloc, wksp, NULL ) );
+      }
+
+      fd_funk_txn_t * txn = fd_funk_txn_prepare( bench, NULL, xid_set( bxid, xid_unique() ), verbose );
+      FD_TEST( txn );
+
+      for( ulong key_idx=0UL; key_idx<bench_rec_cnt+bench_rec_cnt/2UL; key_idx++ ) {
+        fd_funk_rec_t * rec = fd_funk_rec_write_prepare( bench, txn, key_set( bkey, key_idx ), bench_val_sz, 1, NULL, &err );
+        FD_TEST( rec );
+        if( (key_idx<bench_rec_cnt) && !(key_idx & 3UL) ) FD_TEST( !fd_funk_rec_remove( bench, rec, 1 ) );
+        else FD_TEST( fd_funk_val_copy( rec, bval, bench_val_sz, 0UL, balloc, wksp, NULL ) );
+      }
+
+      long tic = fd_log_wallclock();
+      FD_TEST( fd_funk_txn_publish_par( bench, txn, tpool, 0UL, thread_cnt, verbose )==1UL );
+      long toc = fd_log_wallclock();
+
+      FD_LOG_NOTICE(( "%2lu threads: %.3f ms/publish (%lu updates)", thread_cnt, 1e-6*(double)(toc-tic),
+                      bench_rec_cnt+bench_rec_cnt/2UL ));
+
+      FD_TEST( fd_funk_rec_global_cnt( bench, wksp )==bench_rec_cnt - bench_rec_cnt/4UL + bench_rec_cnt/2UL );
+      FD_TEST( !fd_funk_verify( bench ) );
+
+      fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( bench ) ) );
+    }
+  } while(0);
+
+  fd_tpool_fini( tpool );
+
   if( name ) fd_wksp_detach( wksp );
   else       fd_wksp_delete_anonymous( wksp );
 
@@ -8,7 +8,8 @@
 #include "fctl/fd_fctl.h"     /* Includes fd_tango_base.h */
 #include "mcache/fd_mcache.h" /* Includes fd_tango_base.h */
 #include "dcache/fd_dcache.h" /* Includes fd_tango_base.h */
-#include "tcache/fd_tcache.h" /* Includes fd_tango_base.h */
+#include "tcache/fd_tcache.h"   /* Includes fd_tango_base.h */
+#include "tcache/fd_sigcache.h" /* Includes fd_tango_base.h */
 #include "aio/fd_aio.h"       /* Includes fd_tango_base.h */
 
 #endif /* HEADER_fd_src_tango_fd_tango_h */
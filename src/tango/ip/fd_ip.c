@@ -2,6 +2,57 @@
 
 #include <arpa/inet.h>
 
+/* node of the path-compressed routing trie
+
+   the node matches addresses whose first len bits equal those of key
+   route is the index of the route entry with exactly this prefix, or
+   UINT_MAX if none
+   child[b] is the index of the subtrie of addresses whose bit len is b,
+   or UINT_MAX if none */
+struct fd_ip_route_node {
+  uint key;
+  uint len;
+  uint route;
+  uint child[2];
+};
+typedef struct fd_ip_route_node fd_ip_route_node_t;
+
+/* next hop cache entry
+
+   valid if gen matches the gen of the fd_ip_t */
+struct fd_ip_nh_cache_entry {
+  uint  ip_addr;
+  uint  gen;
+  uint  next_ip_addr;
+  uint  ifindex;
+  uchar mac_addr[6];
+};
+typedef struct fd_ip_nh_cache_entry fd_ip_nh_cache_entry_t;
+
+/* trie needs at most two nodes per route entry */
+static inline ulong
+fd_ip_route_node_cnt( ulong route_entries ) {
+  return 2UL * route_entries;
+}
+
+/* arp map slots, with a load factor of at most 0.5 */
+static inline ulong
+fd_ip_arp_map_cnt( ulong arp_entries ) {
+  return fd_ulong_pow2_up( 2UL * arp_entries );
+}
+
+/* netmask of a prefix of len bits, len in [0,32] */
+static inline uint
+fd_ip_netmask( uint len ) {
+  return (uint)( 0xffffffff00000000UL >> (ulong)len );
+}
+
+/* bit idx of an address, counting from the most significant bit */
+static inline uint
+fd_ip_addr_bit( uint ip_addr, uint idx ) {
+  return ( ip_addr >> ( 31U - idx ) ) & 1U;
+}
+
 ulong
 fd_ip_align( void ) {
   return FD_IP_ALIGN;
@@ -23,6 +74,9 @@ fd_ip_footprint( ulong arp_entries,
   l = FD_LAYOUT_APPEND( l, FD_IP_ALIGN, sizeof(fd_nl_t)                             );
   l = FD_LAYOUT_APPEND( l, FD_IP_ALIGN, arp_entries   * sizeof(fd_nl_arp_entry_t)   );
   l = FD_LAYOUT_APPEND( l, FD_IP_ALIGN, route_entries * sizeof(fd_nl_route_entry_t) );
+  l = FD_LAYOUT_APPEND( l, FD_IP_ALIGN, fd_ip_route_node_cnt( route_entries ) * sizeof(fd_ip_route_node_t) );
+  l = FD_LAYOUT_APPEND( l, FD_IP_ALIGN, fd_ip_arp_map_cnt( arp_entries ) * sizeof(uint) );
+  l = FD_LAYOUT_APPEND( l, FD_IP_ALIGN, FD_IP_NH_CACHE_CNT * sizeof(fd_ip_nh_cache_entry_t) );
 
   return FD_LAYOUT_FINI( l, FD_IP_ALIGN );
 }
@@ -58,6 +112,16 @@ fd_ip_new( void * shmem,
   ulong ofs_route_table = FD_ULONG_ALIGN_UP( l, FD_IP_ALIGN );
   l = FD_LAYOUT_APPEND( l, FD_IP_ALIGN, route_entries * sizeof(fd_nl_route_entry_t) );
 
+  ulong ofs_route_trie  = FD_ULONG_ALIGN_UP( l, FD_IP_ALIGN );
+  l = FD_LAYOUT_APPEND( l, FD_IP_ALIGN, fd_ip_route_node_cnt( route_entries ) * sizeof(fd_ip_route_node_t) );
+
+  ulong arp_map_cnt     = fd_ip_arp_map_cnt( arp_entries );
+  ulong ofs_arp_map     = FD_ULONG_ALIGN_UP( l, FD_IP_ALIGN );
+  l = FD_LAYOUT_APPEND( l, FD_IP_ALIGN, arp_map_cnt * sizeof(uint) );
+
+  ulong ofs_nh_cache    = FD_ULONG_ALIGN_UP( l, FD_IP_ALIGN );
+  l = FD_LAYOUT_APPEND( l, FD_IP_ALIGN, FD_IP_NH_CACHE_CNT * sizeof(fd_ip_nh_cache_entry_t) );
+
   ulong mem_sz = FD_LAYOUT_FINI( l, FD_IP_ALIGN );
 
   /* clear all to zero */
@@ -69,6 +133,12 @@ fd_ip_new( void * shmem,
   ip->ofs_netlink          = ofs_netlink;
   ip->ofs_arp_table        = ofs_arp_table;
   ip->ofs_route_table      = ofs_route_table;
+  ip->ofs_route_trie       = ofs_route_trie;
+  ip->ofs_arp_map          = ofs_arp_map;
+  ip->ofs_nh_cache         = ofs_nh_cache;
+  ip->arp_map_cnt          = arp_map_cnt;
+  ip->route_trie_root      = UINT_MAX;
+  ip->gen                  = 1U; /* zeroed cache entries are invalid */
 
   /* set magic last, after a fence */
   FD_COMPILER_MFENCE();
@@ -157,6 +227,35 @@ fd_ip_arp_table_get( fd_ip_t * ip ) {
 }
 
 
+/* get pointers to the lookup structures */
+static inline fd_ip_route_node_t *
+fd_ip_route_trie_get( fd_ip_t * ip ) {
+  return (fd_ip_route_node_t*)( (ulong)ip + ip->ofs_route_trie );
+}
+
+static inline uint *
+fd_ip_arp_map_get( fd_ip_t * ip ) {
+  return (uint*)( (ulong)ip + ip->ofs_arp_map );
+}
+
+static inline fd_ip_nh_cache_entry_t *
+fd_ip_nh_cache_get( fd_ip_t * ip ) {
+  return (fd_ip_nh_cache_entry_t*)( (ulong)ip + ip->ofs_nh_cache );
+}
+
+
+/* invalidate all next hop cache entries */
+static void
+fd_ip_nh_cache_invalidate( fd_ip_t * ip ) {
+  ip->gen++;
+  if( FD_UNLIKELY( ip->gen == 0U ) ) {
+    /* wrapped around, so clear out the entries */
+    fd_memset( fd_ip_nh_cache_get( ip ), 0, FD_IP_NH_CACHE_CNT * sizeof(fd_ip_nh_cache_entry_t) );
+    ip->gen = 1U;
+  }
+}
+
+
 void
 fd_ip_arp_fetch( fd_ip_t * ip ) {
   fd_ip_arp_entry_t * arp_table     = fd_ip_arp_table_get( ip );
@@ -170,6 +269,35 @@ fd_ip_arp_fetch( fd_ip_t * ip ) {
   }
 
   ip->cur_num_arp_entries = (ulong)num_entries;
+
+  fd_ip_arp_table_update( ip );
+}
+
+
+void
+fd_ip_arp_table_update( fd_ip_t * ip ) {
+  fd_ip_arp_entry_t * arp_table    = fd_ip_arp_table_get( ip );
+  ulong               arp_table_sz = ip->cur_num_arp_entries;
+  uint *              arp_map      = fd_ip_arp_map_get( ip );
+  ulong               arp_map_mask = ip->arp_map_cnt - 1UL;
+
+  /* slots hold the index of the entry plus one, zero if empty */
+  fd_memset( arp_map, 0, ip->arp_map_cnt * sizeof(uint) );
+
+  for( ulong j = 0UL; j < arp_table_sz; ++j ) {
+    fd_ip_arp_entry_t * entry = arp_table + j;
+    if( ( entry->flags & FD_NL_ARP_FLAGS_USED ) == 0 ) break;
+
+    ulong slot = (ulong)fd_uint_hash( entry->dst_ip_addr ) & arp_map_mask;
+    while( arp_map[ slot ] ) {
+      /* keep the first entry for an address, like a scan of the table */
+      if( arp_table[ arp_map[ slot ] - 1U ].dst_ip_addr == entry->dst_ip_addr ) break;
+      slot = ( slot + 1UL ) & arp_map_mask;
+    }
+    if( !arp_map[ slot ] ) arp_map[ slot ] = (uint)( j + 1UL );
+  }
+
+  fd_ip_nh_cache_invalidate( ip );
 }
 
 
@@ -187,14 +315,22 @@ fd_ip_arp_query( fd_ip_t *            ip,
                  fd_ip_arp_entry_t ** arp,
                  uint                 ip_addr ) {
   fd_ip_arp_entry_t * arp_table     = fd_ip_arp_table_get( ip );
-  ulong               arp_table_sz  = ip->cur_num_arp_entries;
+  uint const *        arp_map       = fd_ip_arp_map_get( ip );
+  ulong               arp_map_mask  = ip->arp_map_cnt - 1UL;
 
-  fd_ip_arp_entry_t * entry = fd_nl_arp_query( arp_table, arp_table_sz, ip_addr );
-  if( FD_UNLIKELY( !entry ) ) return FD_IP_ERROR;
+  ulong slot = (ulong)fd_uint_hash( ip_addr ) & arp_map_mask;
+  for(;;) {
+    uint idx = arp_map[ slot ];
+    if( FD_UNLIKELY( !idx ) ) return FD_IP_ERROR;
 
-  *arp = entry;
+    fd_ip_arp_entry_t * entry = arp_table + ( idx - 1U );
+    if( FD_LIKELY( entry->dst_ip_addr == ip_addr ) ) {
+      *arp = entry;
+      return FD_IP_SUCCESS;
+    }
 
-  return FD_IP_SUCCESS;
+    slot = ( slot + 1UL ) & arp_map_mask;
+  }
 }
 
 
@@ -267,6 +403,77 @@ fd_ip_route_fetch( fd_ip_t * ip ) {
   }
 
   ip->cur_num_route_entries = (ulong)num_entries;
+
+  fd_ip_route_table_update( ip );
+}
+
+
+void
+fd_ip_route_table_update( fd_ip_t * ip ) {
+  fd_ip_route_entry_t * route_table     = fd_ip_route_table_get( ip );
+  ulong                 route_table_cap = ip->num_route_entries;
+  fd_ip_route_node_t *  node            = fd_ip_route_trie_get( ip );
+
+  uint root     = UINT_MAX;
+  uint node_cnt = 0U;
+
+  for( ulong j = 0UL; j < route_table_cap; ++j ) {
+    fd_ip_route_entry_t * entry = route_table + j;
+
+    /* the used entries are always contiguous */
+    if( ( entry->flags & FD_NL_RT_FLAGS_USED ) == 0 ) break;
+
+    uint len = entry->dst_netmask_sz;
+    uint key = entry->dst_ip_addr;
+
+    /* skip entries that can never match: the netmask must be a prefix
+       and the destination must not have bits outside of it */
+    if( FD_UNLIKELY( len > 32U || entry->dst_netmask != fd_ip_netmask( len ) || ( key & ~fd_ip_netmask( len ) ) ) ) continue;
+
+    uint * cur = &root;
+    for(;;) {
+      if( *cur == UINT_MAX ) {
+        /* new leaf */
+        node[ node_cnt ] = (fd_ip_route_node_t){ .key = key, .len = len, .route = (uint)j, .child = { UINT_MAX, UINT_MAX } };
+        *cur = node_cnt++;
+        break;
+      }
+
+      fd_ip_route_node_t * n = node + *cur;
+
+      uint diff   = key ^ n->key;
+      uint common = diff ? ( 31U - (uint)fd_uint_find_msb( diff ) ) : 32U;
+      common = fd_uint_min( common, fd_uint_min( len, n->len ) );
+
+      if( common == n->len ) {
+        if( len == n->len ) {
+          /* same prefix, the first entry wins as with a scan of the table */
+          if( n->route == UINT_MAX ) n->route = (uint)j;
+          break;
+        }
+        cur = &n->child[ fd_ip_addr_bit( key, n->len ) ];
+        continue;
+      }
+
+      /* the prefixes diverge before the end of n, so split n */
+      uint mid = node_cnt++;
+      node[ mid ] = (fd_ip_route_node_t){ .key = key & fd_ip_netmask( common ), .len = common, .route = UINT_MAX, .child = { UINT_MAX, UINT_MAX } };
+      node[ mid ].child[ fd_ip_addr_bit( n->key, common ) ] = *cur;
+      if( common == len ) {
+        node[ mid ].route = (uint)j;
+      } else {
+        uint leaf = node_cnt++;
+        node[ leaf ] = (fd_ip_route_node_t){ .key = key, .len = len, .route = (uint)j, .child = { UINT_MAX, UINT_MAX } };
+        node[ mid ].child[ fd_ip_addr_bit( key, common ) ] = leaf;
+      }
+      *cur = mid;
+      break;
+    }
+  }
+
+  ip->route_trie_root = root;
+
+  fd_ip_nh_cache_invalidate( ip );
 }
 
 /* query the routing table
@@ -284,14 +491,26 @@ fd_ip_route_query( fd_ip_t *              ip,
                    uint                   ip_addr ) {
   fd_ip_route_entry_t * route_table     = fd_ip_route_table_get( ip );
   ulong                 route_table_cap = ip->num_route_entries;
+  fd_ip_route_node_t *  node            = fd_ip_route_trie_get( ip );
 
   if( FD_UNLIKELY( route_table_cap == 0 ) ) return FD_IP_RETRY;
 
-  fd_ip_route_entry_t * entry = fd_nl_route_query( route_table, route_table_cap, ip_addr );
+  /* walk down the trie, remembering the longest matching prefix */
+  uint best = UINT_MAX;
+  uint idx  = ip->route_trie_root;
+  while( idx != UINT_MAX ) {
+    fd_ip_route_node_t * n = node + idx;
 
-  if( FD_UNLIKELY( !entry ) ) return FD_IP_NO_ROUTE;
+    if( ( ip_addr ^ n->key ) & fd_ip_netmask( n->len ) ) break;
+    if( n->route != UINT_MAX ) best = n->route;
+    if( n->len == 32U ) break;
 
-  *route = entry;
+    idx = n->child[ fd_ip_addr_bit( ip_addr, n->len ) ];
+  }
+
+  if( FD_UNLIKELY( best == UINT_MAX ) ) return FD_IP_NO_ROUTE;
+
+  *route = route_table + best;
 
   return FD_IP_SUCCESS;
 }
@@ -332,6 +551,15 @@ fd_ip_route_ip_addr( uchar *   out_dst_mac,
     return FD_IP_BROADCAST;
   }
 
+  /* check the next hop cache */
+  fd_ip_nh_cache_entry_t * cache = fd_ip_nh_cache_get( ip ) + ( fd_uint_hash( ip_addr ) & ( FD_IP_NH_CACHE_CNT - 1UL ) );
+  if( FD_LIKELY( cache->gen == ip->gen && cache->ip_addr == ip_addr ) ) {
+    *out_next_ip_addr = cache->next_ip_addr;
+    *out_ifindex      = cache->ifindex;
+    fd_memcpy( out_dst_mac, cache->mac_addr, 6 );
+    return FD_IP_SUCCESS;
+  }
+
   /* query routing table */
   fd_ip_route_entry_t * route_entry = NULL;
   int route_rtn = fd_ip_route_query( ip, &route_entry, ip_addr );
@@ -368,7 +596,15 @@ fd_ip_route_ip_addr( uchar *   out_dst_mac,
   fd_memcpy( out_dst_mac, arp_entry->mac_addr, 6 );
 
   /* check the status */
-  if( arp_entry->state == NUD_REACHABLE ) return FD_IP_SUCCESS;
+  if( arp_entry->state == NUD_REACHABLE ) {
+    /* remember the result until the tables change */
+    cache->ip_addr      = ip_addr;
+    cache->gen          = ip->gen;
+    cache->next_ip_addr = next_ip_addr;
+    cache->ifindex      = route_entry->oif;
+    fd_memcpy( cache->mac_addr, arp_entry->mac_addr, 6 );
+    return FD_IP_SUCCESS;
+  }
 
   /* all other statutes, try probing */
   return FD_IP_PROBE_RQD;
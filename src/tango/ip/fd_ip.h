@@ -26,6 +26,23 @@
 
    */
 
+/* Lookup structures
+
+   The tables fetched via netlink are indexed for fast per-packet
+   lookups:
+     - a path-compressed binary trie over the route prefixes
+       (longest prefix match)
+     - an open-addressed hash map from IP address to ARP entry
+     - a direct-mapped cache of recent fd_ip_route_ip_addr results,
+       keyed by destination IP address
+
+   The indexes are rebuilt by fd_ip_route_table_update and
+   fd_ip_arp_table_update, which are called by the fetch functions.
+   Rebuilding either one invalidates the next hop cache. */
+
+/* number of entries in the next hop cache (power of 2) */
+#define FD_IP_NH_CACHE_CNT (4096UL)
+
 /* magic */
 #define FD_IP_MAGIC (0x37ad94a6ec098fc1UL)
 
@@ -51,6 +68,15 @@ struct fd_ip {
   ulong ofs_netlink;
   ulong ofs_arp_table;
   ulong ofs_route_table;
+
+  /* lookup structures */
+  ulong ofs_route_trie;
+  ulong ofs_arp_map;
+  ulong ofs_nh_cache;
+
+  ulong arp_map_cnt;     /* number of slots in arp map (power of 2) */
+  uint  route_trie_root; /* index of trie root node, UINT_MAX if empty */
+  uint  gen;             /* incremented on every index rebuild */
 };
 typedef struct fd_ip fd_ip_t;
 
@@ -163,6 +189,15 @@ void
 fd_ip_arp_fetch( fd_ip_t * ip );
 
 
+/* rebuild the ARP lookup map
+
+   must be called after the ARP table is modified
+   (fd_ip_arp_fetch calls this) */
+
+void
+fd_ip_arp_table_update( fd_ip_t * ip );
+
+
 /* query an arp entry
 
    searches for an IP address in the table
@@ -217,6 +252,15 @@ void
 fd_ip_route_fetch( fd_ip_t * ip );
 
 
+/* rebuild the routing trie
+
+   must be called after the routing table is modified
+   (fd_ip_route_fetch calls this) */
+
+void
+fd_ip_route_table_update( fd_ip_t * ip );
+
+
 /* query the routing table
 
    the provided IP address is looked up in the routing table
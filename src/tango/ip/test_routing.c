@@ -353,6 +353,83 @@ test_routes_3( fd_ip_t * ip ) {
 }
 
 
+/* check route and arp lookups against linear scans of random tables */
+void
+test_random_tables( fd_ip_t * ip ) {
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 1234U, 0UL ) );
+
+  fd_ip_route_entry_t * route_table     = fd_ip_route_table_get( ip );
+  ulong                 route_table_cap = ip->num_route_entries;
+  fd_ip_arp_entry_t *   arp_table       = fd_ip_arp_table_get( ip );
+  ulong                 arp_table_cap   = ip->num_arp_entries;
+
+  ulong hit_cnt = 0UL;
+  for( ulong iter = 0UL; iter < 1000UL; ++iter ) {
+    /* prefixes are drawn from a few base addresses, so they nest */
+    uint base[4] = { TEST_IP( 10, 0, 0, 0 ), TEST_IP( 10, 128, 0, 0 ), TEST_IP( 192, 168, 1, 0 ), fd_rng_uint( rng ) };
+
+    fd_memset( route_table, 0, route_table_cap * sizeof( route_table[0] ) );
+    ulong route_cnt = fd_rng_ulong_roll( rng, route_table_cap + 1UL );
+    for( ulong j = 0UL; j < route_cnt; ++j ) {
+      uint sz = fd_rng_uint_roll( rng, 33U );
+      uint netmask = (uint)( 0xffffffff00000000LU >> (ulong)sz );
+      route_table[j].dst_ip_addr    = ( base[ fd_rng_uint_roll( rng, 4U ) ] ^ ( fd_rng_uint( rng ) >> fd_rng_uint_roll( rng, 32U ) ) ) & netmask;
+      route_table[j].dst_netmask    = netmask;
+      route_table[j].dst_netmask_sz = sz;
+      route_table[j].nh_ip_addr     = fd_rng_uint_roll( rng, 2U ) ? 0U : base[ fd_rng_uint_roll( rng, 4U ) ] + fd_rng_uint_roll( rng, 16U );
+      route_table[j].oif            = (uint)j;
+      route_table[j].flags          = FD_NL_RT_FLAGS_USED;
+    }
+    ip->cur_num_route_entries = route_cnt;
+    fd_ip_route_table_update( ip );
+
+    fd_memset( arp_table, 0, arp_table_cap * sizeof( arp_table[0] ) );
+    ulong arp_cnt = fd_rng_ulong_roll( rng, arp_table_cap + 1UL );
+    for( ulong j = 0UL; j < arp_cnt; ++j ) {
+      arp_table[j].dst_ip_addr = base[ fd_rng_uint_roll( rng, 4U ) ] + fd_rng_uint_roll( rng, 16U );
+      arp_table[j].ifindex     = (uint)j;
+      arp_table[j].mac_addr[5] = (uchar)j;
+      arp_table[j].state       = NUD_REACHABLE;
+      arp_table[j].flags       = FD_NL_ARP_FLAGS_USED;
+    }
+    ip->cur_num_arp_entries = arp_cnt;
+    fd_ip_arp_table_update( ip );
+
+    for( ulong k = 0UL; k < 100UL; ++k ) {
+      uint ip_addr = ( base[ fd_rng_uint_roll( rng, 4U ) ] ^ ( fd_rng_uint( rng ) >> fd_rng_uint_roll( rng, 32U ) ) );
+      if( k & 1UL ) ip_addr = base[ fd_rng_uint_roll( rng, 4U ) ] + fd_rng_uint_roll( rng, 16U );
+
+      fd_ip_route_entry_t * exp_route = fd_nl_route_query( route_table, route_table_cap, ip_addr );
+      fd_ip_route_entry_t * route     = NULL;
+      int rtn = fd_ip_route_query( ip, &route, ip_addr );
+      FD_TEST( rtn == ( exp_route ? FD_IP_SUCCESS : FD_IP_NO_ROUTE ) );
+      if( exp_route ) FD_TEST( route == exp_route );
+
+      fd_ip_arp_entry_t * exp_arp = fd_nl_arp_query( arp_table, arp_cnt, ip_addr );
+      fd_ip_arp_entry_t * arp     = NULL;
+      rtn = fd_ip_arp_query( ip, &arp, ip_addr );
+      FD_TEST( rtn == ( exp_arp ? FD_IP_SUCCESS : FD_IP_ERROR ) );
+      if( exp_arp ) FD_TEST( arp == exp_arp );
+
+      /* the next hop cache must not outlive a table update */
+      uchar dst_mac[6]; uint next_ip_addr; uint ifindex;
+      for( ulong r = 0UL; r < 2UL; ++r ) {
+        rtn = fd_ip_route_ip_addr( dst_mac, &next_ip_addr, &ifindex, ip, ip_addr );
+        if( rtn != FD_IP_SUCCESS ) continue;
+        FD_TEST( exp_route && next_ip_addr == ( exp_route->nh_ip_addr ? exp_route->nh_ip_addr : ip_addr ) );
+        FD_TEST( ifindex == exp_route->oif );
+        FD_TEST( dst_mac[5] == fd_nl_arp_query( arp_table, arp_cnt, next_ip_addr )->mac_addr[5] );
+        hit_cnt++;
+      }
+    }
+  }
+
+  FD_TEST( hit_cnt );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+}
+
+
 int
 main( int argc, char **argv ) {
   fd_boot( &argc, &argv );
@@ -379,6 +456,7 @@ main( int argc, char **argv ) {
 
   /* construct a custom table */
   ulong arp_table_sz = ip->cur_num_arp_entries = build_arp_table( arp_table, num_arp_entries );
+  fd_ip_arp_table_update( ip );
 
   FD_LOG_NOTICE(( "ARP table:" ));
   for( ulong j = 0L; j < arp_table_sz; ++j ) {
@@ -411,6 +489,7 @@ main( int argc, char **argv ) {
   /* construct a custom table */
   ulong route_table_sz = ip->cur_num_route_entries
                        = build_route_table( route_table, num_route_entries );
+  fd_ip_route_table_update( ip );
 
   FD_LOG_NOTICE(( "Routing table:" ));
   for( ulong j = 0L; j < route_table_sz; ++j ) {
@@ -436,12 +515,17 @@ main( int argc, char **argv ) {
   /* construct another routing table */
 
   route_table_sz = build_route_table_1( route_table, route_table_sz );
+  fd_ip_route_table_update( ip );
 
   /* test the new routing */
 
   test_routes_2( ip );
   test_routes_3( ip );
 
+  /* compare the lookup structures against table scans */
+
+  test_random_tables( ip );
+
   /* clean up */
 
   fd_ip_leave( ip );
@@ -295,6 +295,10 @@ fd_quic_gen_keys(
   }
   keys->iv_sz = iv_sz;
 
+  /* expand ciphers once per key */
+  fd_aes_gcm_init_key( keys->pkt_gcm, keys->pkt_key, key_sz );
+  fd_aes_set_encrypt_key( keys->hp_key, key_sz<<3, keys->hp_ecb );
+
   return FD_QUIC_SUCCESS;
 }
 
@@ -342,6 +346,9 @@ fd_quic_gen_new_keys(
   }
   keys->iv_sz = iv_sz;
 
+  /* expand cipher once per key */
+  fd_aes_gcm_init_key( keys->pkt_gcm, keys->pkt_key, key_sz );
+
   return FD_QUIC_SUCCESS;
 }
 
@@ -431,8 +438,8 @@ fd_quic_crypto_encrypt(
   // Initial packets cipher uses AEAD_AES_128_GCM with keys derived from the Destination Connection ID field of the
   // first Initial packet sent by the client; see rfc9001 Section 5.2.
 
-  fd_aes_gcm_t pkt_cipher[1];
-  fd_aes_128_gcm_init( pkt_cipher, pkt_keys->pkt_key, nonce );
+  fd_aes_gcm_t * pkt_cipher = pkt_keys->pkt_gcm;
+  fd_aes_gcm_init_iv( pkt_cipher, nonce );
 
   /* cipher_text is start of encrypted packet bytes, which starts after the header */
   uchar * cipher_text = out + hdr_sz;
@@ -449,10 +456,8 @@ fd_quic_crypto_encrypt(
      so shorter packet numbers means sample starts later in the cipher text */
   uchar const * sample = pkt_number + 4;
 
-  fd_aes_key_t ecb[1];
-  fd_aes_set_encrypt_key( hp_keys->hp_key, 128, ecb );
   uchar hp_cipher[16];
-  fd_aes_encrypt( sample, hp_cipher, ecb );
+  fd_aes_encrypt( sample, hp_cipher, hp_keys->hp_ecb );
 
   /* hp_cipher is mask */
   uchar const * mask = hp_cipher;
@@ -478,7 +483,7 @@ fd_quic_crypto_decrypt(
     ulong                    const pkt_number_off,
     ulong                    const pkt_number,
     fd_quic_crypto_suite_t const * const suite,
-    fd_quic_crypto_keys_t  const * const keys ) {
+    fd_quic_crypto_keys_t  *       const keys ) {
 
   (void)suite;
 
@@ -533,8 +538,8 @@ fd_quic_crypto_decrypt(
   assert( gcm_tag       >=in            );
   assert( gcm_tag+FD_QUIC_CRYPTO_TAG_SZ<=in+in_sz );
 
-  fd_aes_gcm_t pkt_cipher[1];
-  fd_aes_128_gcm_init( pkt_cipher, keys->pkt_key, nonce );
+  fd_aes_gcm_t * pkt_cipher = keys->pkt_gcm;
+  fd_aes_gcm_init_iv( pkt_cipher, nonce );
 
   int decrypt_ok =
     fd_aes_gcm_aead_decrypt( pkt_cipher, gcm_c, gcm_p, gcm_sz, gcm_a, gcm_asz, gcm_tag );
@@ -556,7 +561,7 @@ fd_quic_crypto_decrypt_hdr(
     ulong                    cipher_text_sz,
     ulong                    pkt_number_off,
     fd_quic_crypto_suite_t const * suite,
-    fd_quic_crypto_keys_t const *  keys ) {
+    fd_quic_crypto_keys_t *        keys ) {
 
   (void)suite;
 
@@ -583,11 +588,8 @@ fd_quic_crypto_decrypt_hdr(
 
   uchar const * sample = cipher_text + sample_off;
 
-  /* TODO this is hardcoded to AES-128 */
   uchar hp_cipher[16];
-  fd_aes_key_t ecb[1];
-  fd_aes_set_encrypt_key( keys->hp_key, 128, ecb );
-  fd_aes_encrypt( sample, hp_cipher, ecb );
+  fd_aes_encrypt( sample, hp_cipher, keys->hp_ecb );
 
   /* copy header, up to packet number, into output */
   fd_memcpy( plain_text, cipher_text, sample_off );
@@ -4,6 +4,7 @@
 #include "../fd_quic_common.h"
 #include "../fd_quic_conn_id.h"
 #include "../../../ballet/hmac/fd_hmac.h"
+#include "../../../ballet/aes/fd_aes_gcm.h"
 
 /* Defines the crypto suites used by QUIC v1.
 
@@ -81,6 +82,13 @@ struct fd_quic_crypto_keys {
   /* header protection */
   uchar hp_key[FD_QUIC_KEY_MAX_SZ];
   ulong hp_key_sz;
+
+  /* expanded ciphers, derived from pkt_key and hp_key by
+     fd_quic_gen_keys and fd_quic_gen_new_keys, such that packets don't
+     pay for the key schedule.  pkt_gcm also holds the per-packet
+     AES-GCM state, so a set of keys may not be used concurrently. */
+  fd_aes_gcm_t pkt_gcm[1];
+  fd_aes_key_t hp_ecb[1];
 };
 
 /* crypto context */
@@ -346,6 +354,7 @@ fd_quic_gen_keys(
 
 /* generates packet key and iv key
    used by key update
+   (the header protection key is left unchanged)
 
    TODO this overlaps with fd_quic_gen_keys, split into gen_hp_keys and gen_pkt_keys */
 int
@@ -422,7 +431,7 @@ fd_quic_crypto_decrypt(
     ulong                    pkt_number_off,
     ulong                    pkt_number,
     fd_quic_crypto_suite_t const * suite,
-    fd_quic_crypto_keys_t const *  keys );
+    fd_quic_crypto_keys_t *        keys );
 
 
 /* decrypt a quic protected packet header
@@ -456,7 +465,7 @@ fd_quic_crypto_decrypt_hdr(
     ulong                    cipher_text_sz,
     ulong                    pkt_number_off,
     fd_quic_crypto_suite_t const * suite,
-    fd_quic_crypto_keys_t const *  keys );
+    fd_quic_crypto_keys_t *        keys );
 
 
 /* look up crypto suite by major/minor
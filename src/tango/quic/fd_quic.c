@@ -23,10 +23,13 @@
 #define CONN_ID(CONN_ID) (CONN_ID)->conn_id[0], (CONN_ID)->conn_id[1], (CONN_ID)->conn_id[2], (CONN_ID)->conn_id[3],  \
                          (CONN_ID)->conn_id[4], (CONN_ID)->conn_id[5], (CONN_ID)->conn_id[6], (CONN_ID)->conn_id[7]
 
-/* Declare priority queue for time based processing */
+/* Declare priority queue for time based processing.  Each conn tracks
+   the location of its event in the queue, so it can be rescheduled or
+   removed in O(lg n) without searching the queue. */
 #define PRQ_NAME      service_queue
 #define PRQ_T         fd_quic_event_t
 #define PRQ_TIMEOUT_T ulong
+#define PRQ_TMP_IDX_SET(t,idx) ((t).conn->sched_idx = (idx))
 #include "../../util/tmpl/fd_prq.c"
 
 /* Declare map type for stream_id -> stream* */
@@ -2198,36 +2201,25 @@ fd_quic_schedule_conn( fd_quic_conn_t * conn ) {
 
   ulong             timeout = conn->next_service_time;
 
-  /* scheduled? */
-  if( conn->in_service ) {
-    /* find conn in events, then remove, update, insert */
-    fd_quic_event_t * event     = NULL;
-    ulong             event_idx = 0;
-    ulong             cnt   = service_queue_cnt( state->service_queue );
-    for( ulong j = 0; j < cnt; ++j ) {
-      fd_quic_event_t * cur_event = state->service_queue + j;
-      if( cur_event->conn == conn ) {
-        event     = cur_event;
-        event_idx = j;
-        break;
-      }
-    }
+  timeout = fd_ulong_max( timeout, fd_quic_now(quic) + 1UL );
 
-    if( FD_LIKELY( event ) ) {
-      /* remove key */
-      service_queue_remove( state->service_queue, event_idx );
+  fd_quic_event_t event[1] = {{ .timeout = timeout, .conn = conn }};
 
-      /* TODO can use a priority queue key-reduce operation, which may be done more
-         quickly than remove, insert */
+  /* scheduled? */
+  if( conn->in_service ) {
+    if( timeout <= conn->sched_service_time ) {
+      /* sooner than before, reduce key in place */
+      service_queue_reduce( state->service_queue, conn->sched_idx, event );
+    } else {
+      /* later than before, remove and reinsert */
+      service_queue_remove( state->service_queue, conn->sched_idx );
+      service_queue_insert( state->service_queue, event );
     }
+  } else {
+    /* insert key */
+    service_queue_insert( state->service_queue, event );
   }
 
-  timeout = fd_ulong_max( timeout, fd_quic_now(quic) + 1UL );
-
-  /* insert key */
-  fd_quic_event_t event[1] = {{ .timeout = timeout, .conn = conn }};
-  service_queue_insert( state->service_queue, event );
-
   conn->sched_service_time = timeout;
   conn->next_service_time  = timeout;
   conn->in_service         = 1;
@@ -2248,8 +2240,7 @@ fd_quic_get_service_interval( fd_quic_t * quic ) {
 void
 fd_quic_reschedule_conn( fd_quic_conn_t * conn,
                          ulong            timeout ) {
-  fd_quic_t *       quic  = conn->quic;
-  fd_quic_state_t * state = fd_quic_get_state( quic );
+  fd_quic_t * quic = conn->quic;
 
   ulong now = fd_quic_now(quic);
 
@@ -2267,27 +2258,7 @@ fd_quic_reschedule_conn( fd_quic_conn_t * conn,
       return;
     }
 
-    /* find conn in events, then remove, update, insert */
-    fd_quic_event_t * event     = NULL;
-    ulong             event_idx = 0;
-    ulong             cnt   = service_queue_cnt( state->service_queue );
-    for( ulong j = 0; j < cnt; ++j ) {
-      fd_quic_event_t * cur_event = state->service_queue + j;
-      if( cur_event->conn == conn ) {
-        event     = cur_event;
-        event_idx = j;
-        break;
-      }
-    }
-
-    if( FD_LIKELY( event ) ) {
-      /* remove key */
-      service_queue_remove( state->service_queue, event_idx );
-
-      /* TODO can use a priority queue key-reduce operation, which may be done more
-         quickly than remove, insert */
-    }
-
+    /* fd_quic_schedule_conn reduces the key in place */
     conn->next_service_time = timeout;
     fd_quic_schedule_conn( conn );
 
@@ -4636,16 +4607,10 @@ fd_quic_conn_free( fd_quic_t *      quic,
     }
   }
 
-  /* find conn in events, then remove */
-  /* FIXME O(n) scales badly with number of conns (#266) */
-  ulong             event_idx = 0;
-  ulong             cnt   = service_queue_cnt( state->service_queue );
-  for( ulong j = 0; j < cnt; ++j ) {
-    fd_quic_event_t * cur_event = state->service_queue + j;
-    if( cur_event->conn == conn ) {
-      /* remove */
-      service_queue_remove( state->service_queue, event_idx );
-    }
+  /* remove conn from events */
+  if( conn->in_service ) {
+    service_queue_remove( state->service_queue, conn->sched_idx );
+    conn->in_service = 0;
   }
 
   /* remove all stream ids from map, and free stream */
@@ -4726,25 +4691,10 @@ fd_quic_conn_free( fd_quic_t *      quic,
 
   quic->metrics.conn_active_cnt--;
 
-  /* clear keys */
-  for( ulong j = 0U; j < 4U; ++j ) {
-    for( ulong k = 0U; k < 2U; ++k ) {
-      fd_memset( conn->keys[j][k].pkt_key, 0x42, sizeof( conn->keys[0][0].pkt_key ) );
-      fd_memset( conn->keys[j][k].hp_key,  0x43, sizeof( conn->keys[0][0].hp_key  ) );
-      fd_memset( conn->keys[j][k].iv,      0x45, sizeof( conn->keys[0][0].iv      ) );
-      conn->keys[j][k].pkt_key_sz = 0;
-      conn->keys[j][k].hp_key_sz  = 0;
-      conn->keys[j][k].iv_sz      = 0;
-    }
-  }
-  for( ulong k = 0U; k < 2U; ++k ) {
-    fd_memset( conn->new_keys[k].pkt_key, 0x42, sizeof( conn->new_keys[0].pkt_key ) );
-    fd_memset( conn->new_keys[k].hp_key,  0x43, sizeof( conn->new_keys[0].hp_key  ) );
-    fd_memset( conn->new_keys[k].iv,      0x45, sizeof( conn->new_keys[0].iv      ) );
-    conn->new_keys[k].pkt_key_sz = 0;
-    conn->new_keys[k].hp_key_sz  = 0;
-    conn->new_keys[k].iv_sz      = 0;
-  }
+  /* clear keys, including the expanded AES-GCM and AES-ECB key
+     schedules, which are as sensitive as the raw keys */
+  fd_memset( conn->keys,     0, sizeof( conn->keys     ) );
+  fd_memset( conn->new_keys, 0, sizeof( conn->new_keys ) );
 }
 
 fd_quic_conn_id_t
@@ -5453,8 +5403,10 @@ fd_quic_reclaim_pkt_meta( fd_quic_conn_t *     conn,
                    sizeof( conn->keys[enc_level][0].KEY ) )
       COPY_KEY(0,pkt_key);
       COPY_KEY(0,iv);
+      COPY_KEY(0,pkt_gcm);
       COPY_KEY(1,pkt_key);
       COPY_KEY(1,iv);
+      COPY_KEY(1,pkt_gcm);
 #     undef COPY_KEY
 
       /* finally zero out new_keys */
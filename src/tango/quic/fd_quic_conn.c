@@ -101,7 +101,7 @@ fd_quic_conn_footprint_ext( fd_quic_limits_t const * limits,
 
   /* align total footprint */
 
-  return off;
+  return fd_ulong_align_up( off, fd_quic_conn_align() );
 }
 
 FD_FN_PURE ulong
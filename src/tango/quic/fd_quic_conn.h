@@ -82,6 +82,7 @@ struct fd_quic_conn {
 
   ulong              next_service_time;   /* time service should be called next */
   ulong              sched_service_time;  /* time service is scheduled for, if in_service=1 */
+  ulong              sched_idx;           /* index of the conn's event in the service queue, if in_service=1 */
   int                in_service;          /* whether the conn is in the service queue */
   uchar              called_conn_new;     /* whether we need to call conn_final on teardown */
 
@@ -254,7 +254,7 @@ main( int argc,
   fd_boot( &argc, &argv );
 
   fd_wksp_t * wksp = fd_wksp_new_anonymous( FD_SHMEM_NORMAL_PAGE_SZ,
-                                            1UL << 15,
+                                            1UL << 16,
                                             fd_shmem_cpu_idx( 0 ),
                                             "wksp",
                                             0UL );
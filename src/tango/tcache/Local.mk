@@ -1,4 +1,6 @@
-$(call add-hdrs,fd_tcache.h)
-$(call add-objs,fd_tcache,fd_tango)
+$(call add-hdrs,fd_tcache.h fd_sigcache.h)
+$(call add-objs,fd_tcache fd_sigcache,fd_tango)
 $(call make-unit-test,test_tcache,test_tcache,fd_tango fd_util)
+$(call make-unit-test,test_sigcache,test_sigcache,fd_tango fd_util)
 $(call run-unit-test,test_tcache)
+$(call run-unit-test,test_sigcache)
@@ -0,0 +1,326 @@
+#include "fd_sigcache.h"
+
+#if FD_HAS_AVX512
+#include "../../util/simd/fd_avx512.h"
+#endif
+
+#define WAYS   FD_SIGCACHE_BUCKET_WAYS
+#define KEY_SZ FD_SIGCACHE_KEY_SZ
+
+FD_STATIC_ASSERT( WAYS*sizeof(ulong)==64UL, bucket_is_a_cache_line );
+
+/* Private accessors.  The ring follows the header, the tags follow the
+   ring (aligned 64) and the keys follow the tags. */
+
+FD_FN_CONST static inline ulong
+fd_sigcache_private_tag_off( ulong depth ) {
+  return sizeof(fd_sigcache_t) + fd_ulong_align_up( depth*sizeof(ulong), 64UL );
+}
+
+FD_FN_CONST static inline ulong *
+fd_sigcache_private_ring( fd_sigcache_t * sigcache ) {
+  return (ulong *)(sigcache+1);
+}
+
+FD_FN_PURE static inline ulong *
+fd_sigcache_private_tag( fd_sigcache_t * sigcache ) {
+  return (ulong *)((ulong)sigcache + fd_sigcache_private_tag_off( sigcache->depth ));
+}
+
+FD_FN_PURE static inline uchar *
+fd_sigcache_private_key( fd_sigcache_t * sigcache ) {
+  return (uchar *)(fd_sigcache_private_tag( sigcache ) + sigcache->bucket_cnt*WAYS);
+}
+
+/* fd_sigcache_private_tag_of returns the non-null tag of key.  The
+   home bucket of a tag is given by its low bits. */
+
+FD_FN_PURE static inline ulong
+fd_sigcache_private_tag_of( void const * key,
+                            ulong        seed ) {
+  uchar const * k = (uchar const *)key;
+  ulong tag = seed;
+  tag = fd_ulong_hash( tag ^ fd_ulong_load_8( k      ) );
+  tag = fd_ulong_hash( tag ^ fd_ulong_load_8( k +  8 ) );
+  tag = fd_ulong_hash( tag ^ fd_ulong_load_8( k + 16 ) );
+  tag = fd_ulong_hash( tag ^ fd_ulong_load_8( k + 24 ) );
+  return fd_ulong_if( tag==FD_SIGCACHE_TAG_NULL, 1UL, tag );
+}
+
+/* fd_sigcache_private_match returns a bit mask of the slots of bucket
+   (WAYS tags, aligned 64) that hold tag. */
+
+FD_FN_PURE static inline uint
+fd_sigcache_private_match( ulong const * bucket,
+                           ulong         tag ) {
+# if FD_HAS_AVX512
+  return (uint)wwl_eq( wwl_ld( (long const *)bucket ), wwl_bcast( (long)tag ) );
+# else
+  uint mask = 0U;
+  for( ulong w=0UL; w<WAYS; w++ ) mask |= ((uint)(bucket[w]==tag)) << w;
+  return mask;
+# endif
+}
+
+ulong
+fd_sigcache_bucket_cnt_default( ulong depth ) {
+  if( FD_UNLIKELY( (!depth) | (depth>(1UL<<60)) ) ) return 0UL;
+  ulong slot_cnt = depth + depth/3UL + 2UL; /* At least depth+2 and ~4/3 depth, no overflow */
+  return fd_ulong_pow2_up( (slot_cnt+WAYS-1UL)/WAYS );
+}
+
+ulong
+fd_sigcache_align( void ) {
+  return FD_SIGCACHE_ALIGN;
+}
+
+ulong
+fd_sigcache_footprint( ulong depth,
+                       ulong bucket_cnt ) {
+  if( !bucket_cnt ) bucket_cnt = fd_sigcache_bucket_cnt_default( depth ); /* use default */
+
+  if( FD_UNLIKELY( (!depth) | (depth>(1UL<<60)) | (!fd_ulong_is_pow2( bucket_cnt )) | (bucket_cnt>(1UL<<54)) ) ) return 0UL;
+  if( FD_UNLIKELY( bucket_cnt*WAYS<depth+2UL ) ) return 0UL; /* no overflow given above */
+
+  /* No overflow given the above */
+  ulong footprint = fd_sigcache_private_tag_off( depth ) + bucket_cnt*WAYS*(sizeof(ulong)+KEY_SZ);
+  return fd_ulong_align_up( footprint, FD_SIGCACHE_ALIGN );
+}
+
+void *
+fd_sigcache_new( void * shmem,
+                 ulong  depth,
+                 ulong  bucket_cnt,
+                 ulong  seed ) {
+  if( !bucket_cnt ) bucket_cnt = fd_sigcache_bucket_cnt_default( depth ); /* use default */
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_sigcache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_sigcache_footprint( depth, bucket_cnt );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad depth (%lu) and/or bucket_cnt (%lu)", depth, bucket_cnt ));
+    return NULL;
+  }
+
+  fd_sigcache_t * sigcache = (fd_sigcache_t *)shmem;
+
+  /* Only the header, ring and tags need to be initialized */
+
+  fd_memset( shmem, 0, fd_sigcache_private_tag_off( depth ) + bucket_cnt*WAYS*sizeof(ulong) );
+
+  sigcache->depth      = depth;
+  sigcache->bucket_cnt = bucket_cnt;
+  sigcache->seed       = seed;
+  sigcache->oldest     = 0UL;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( sigcache->magic ) = FD_SIGCACHE_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_sigcache_t *
+fd_sigcache_join( void * _sigcache ) {
+
+  if( FD_UNLIKELY( !_sigcache ) ) {
+    FD_LOG_WARNING(( "NULL _sigcache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)_sigcache, fd_sigcache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned _sigcache" ));
+    return NULL;
+  }
+
+  fd_sigcache_t * sigcache = (fd_sigcache_t *)_sigcache;
+  if( FD_UNLIKELY( sigcache->magic!=FD_SIGCACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return sigcache;
+}
+
+void *
+fd_sigcache_leave( fd_sigcache_t * sigcache ) {
+
+  if( FD_UNLIKELY( !sigcache ) ) {
+    FD_LOG_WARNING(( "NULL sigcache" ));
+    return NULL;
+  }
+
+  return (void *)sigcache;
+}
+
+void *
+fd_sigcache_delete( void * _sigcache ) {
+
+  if( FD_UNLIKELY( !_sigcache ) ) {
+    FD_LOG_WARNING(( "NULL _sigcache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)_sigcache, fd_sigcache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned _sigcache" ));
+    return NULL;
+  }
+
+  fd_sigcache_t * sigcache = (fd_sigcache_t *)_sigcache;
+  if( FD_UNLIKELY( sigcache->magic!=FD_SIGCACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( sigcache->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return _sigcache;
+}
+
+fd_sigcache_t *
+fd_sigcache_reset( fd_sigcache_t * sigcache ) {
+  fd_memset( fd_sigcache_private_ring( sigcache ), 0,
+             fd_sigcache_private_tag_off( sigcache->depth ) - sizeof(fd_sigcache_t) + sigcache->bucket_cnt*WAYS*sizeof(ulong) );
+  sigcache->oldest = 0UL;
+  return sigcache;
+}
+
+/* fd_sigcache_private_find returns the slot holding key and ULONG_MAX
+   if key is not in the map.  If not found, *_empty holds the first
+   empty slot in the probe sequence of key. */
+
+static inline ulong
+fd_sigcache_private_find( fd_sigcache_t const * sigcache,
+                          void const *          key,
+                          ulong                 tag,
+                          ulong *               _empty ) {
+  ulong const * tags = fd_sigcache_private_tag( (fd_sigcache_t *)sigcache );
+  uchar const * keys = fd_sigcache_private_key( (fd_sigcache_t *)sigcache );
+  ulong         mask = sigcache->bucket_cnt - 1UL;
+
+  ulong b = tag & mask;
+  for(;;) {
+    ulong const * bucket = tags + b*WAYS;
+
+    uint hit = fd_sigcache_private_match( bucket, tag );
+    while( FD_UNLIKELY( hit ) ) { /* tags match, compare keys */
+      ulong slot = b*WAYS + (ulong)fd_uint_find_lsb( hit );
+      if( FD_LIKELY( !memcmp( keys + slot*KEY_SZ, key, KEY_SZ ) ) ) return slot;
+      hit = fd_uint_pop_lsb( hit );
+    }
+
+    uint empty = fd_sigcache_private_match( bucket, FD_SIGCACHE_TAG_NULL );
+    if( FD_LIKELY( empty ) ) {
+      *_empty = b*WAYS + (ulong)fd_uint_find_lsb( empty );
+      return ULONG_MAX;
+    }
+
+    b = (b+1UL) & mask;
+  }
+}
+
+/* fd_sigcache_private_remove removes one key with the given tag from
+   the map, if any.  The hole left behind is filled by moving keys from
+   later buckets back (the bucket analog of the backward shift deletion
+   used by fd_tcache_remove) such that probe sequences stay unbroken. */
+
+static void
+fd_sigcache_private_remove( fd_sigcache_t * sigcache,
+                            ulong           tag ) {
+  ulong * tags = fd_sigcache_private_tag( sigcache );
+  uchar * keys = fd_sigcache_private_key( sigcache );
+  ulong   mask = sigcache->bucket_cnt - 1UL;
+
+  /* Find the tag */
+
+  ulong b = tag & mask;
+  ulong hole;
+  for(;;) {
+    ulong const * bucket = tags + b*WAYS;
+    uint hit = fd_sigcache_private_match( bucket, tag );
+    if( FD_LIKELY( hit ) ) { hole = b*WAYS + (ulong)fd_uint_find_lsb( hit ); break; }
+    if( FD_UNLIKELY( fd_sigcache_private_match( bucket, FD_SIGCACHE_TAG_NULL ) ) ) return; /* not found */
+    b = (b+1UL) & mask;
+  }
+
+  int was_full = !fd_sigcache_private_match( tags + b*WAYS, FD_SIGCACHE_TAG_NULL );
+  tags[ hole ] = FD_SIGCACHE_TAG_NULL;
+  if( !was_full ) return; /* no probe sequence passes through b */
+
+  /* Scan the buckets after the hole.  A key at bucket c can move into
+     the hole at bucket h if its home bucket is not in (h,c] (cyclic).
+     Buckets that weren't full end the probe sequences that could pass
+     through the hole. */
+
+  ulong c = hole / WAYS;
+  for(;;) {
+    ulong h = hole / WAYS;
+    c = (c+1UL) & mask;
+    if( FD_UNLIKELY( c==h ) ) return; /* wrapped around (can't happen if the map has an empty slot) */
+
+    ulong * bucket   = tags + c*WAYS;
+    int     was_full = !fd_sigcache_private_match( bucket, FD_SIGCACHE_TAG_NULL );
+    ulong   dist_h   = (c-h) & mask;
+
+    for( ulong w=0UL; w<WAYS; w++ ) {
+      ulong t = bucket[ w ];
+      if( t==FD_SIGCACHE_TAG_NULL ) continue;
+      if( ((c-(t & mask)) & mask)<dist_h ) continue; /* home in (h,c], must stay */
+      ulong slot = c*WAYS + w;
+      tags[ hole ] = t;
+      memcpy( keys + hole*KEY_SZ, keys + slot*KEY_SZ, KEY_SZ );
+      bucket[ w ] = FD_SIGCACHE_TAG_NULL;
+      hole = slot;
+      break;
+    }
+
+    if( !was_full ) return;
+  }
+}
+
+int
+fd_sigcache_query( fd_sigcache_t const * sigcache,
+                   void const *          key ) {
+  ulong empty = 0UL;
+  ulong tag = fd_sigcache_private_tag_of( key, sigcache->seed );
+  return fd_sigcache_private_find( sigcache, key, tag, &empty )!=ULONG_MAX;
+}
+
+int
+fd_sigcache_insert( fd_sigcache_t * sigcache,
+                    void const *    key ) {
+  ulong empty = 0UL;
+  ulong tag = fd_sigcache_private_tag_of( key, sigcache->seed );
+  if( FD_UNLIKELY( fd_sigcache_private_find( sigcache, key, tag, &empty )!=ULONG_MAX ) ) return 1;
+
+  /* Insert key into the map (the map has at most depth entries here and
+     at least depth+2 slots) */
+
+  fd_sigcache_private_tag( sigcache )[ empty ] = tag;
+  memcpy( fd_sigcache_private_key( sigcache ) + empty*KEY_SZ, key, KEY_SZ );
+
+  /* Evict the oldest key / insert tag into the ring */
+
+  ulong * ring       = fd_sigcache_private_ring( sigcache );
+  ulong   oldest     = sigcache->oldest;
+  ulong   tag_oldest = ring[ oldest ];
+  ring[ oldest ] = tag;
+  oldest++;
+  sigcache->oldest = fd_ulong_if( oldest>=sigcache->depth, 0UL, oldest );
+
+  if( FD_LIKELY( tag_oldest!=FD_SIGCACHE_TAG_NULL ) ) fd_sigcache_private_remove( sigcache, tag_oldest );
+  return 0;
+}
+
+#undef KEY_SZ
+#undef WAYS
@@ -0,0 +1,155 @@
+#ifndef HEADER_fd_src_tango_tcache_fd_sigcache_h
+#define HEADER_fd_src_tango_tcache_fd_sigcache_h
+
+/* A fd_sigcache_t is a cache of the most recently observed unique
+   32-byte keys.  It is a variant of fd_tcache_t for deduplication of
+   traffic where a 64-bit tag is not enough.  Keys are compared in full,
+   so the cache never reports a false duplicate, which allows history
+   depths of tens of millions of keys (e.g. all transaction signatures
+   seen over a blockhash lifetime) without a growing risk of dropping
+   unique traffic.
+
+   Like fd_tcache_t, keys are evicted in insertion order once depth
+   unique keys have been inserted and inserting a duplicate does not
+   refresh its age.  Keys are assumed to be adversarial: they are mixed
+   with a seed before being used to pick a location in the map.
+
+   The map is an array of buckets with FD_SIGCACHE_BUCKET_WAYS slots.
+   The slot tags of a bucket fill exactly one cache line and a lookup
+   typically compares all tags of a bucket in a single vector
+   operation.  Buckets are linear probed.  The full keys are stored in a
+   separate array and only touched when a tag matches.  A sigcache is
+   not safe for concurrent use: it is meant to be owned by a single
+   tile, like fd_tcache_t.
+
+   As for fd_tcache_t, it is strongly recommended to back a large
+   sigcache by gigantic pages. */
+
+#include "../fd_tango_base.h"
+
+/* FD_SIGCACHE_ALIGN is the alignment of a sigcache.
+   FD_SIGCACHE_BUCKET_WAYS is the number of slots in a bucket.
+   FD_SIGCACHE_KEY_SZ is the size of a key in bytes. */
+
+#define FD_SIGCACHE_ALIGN       (128UL)
+#define FD_SIGCACHE_BUCKET_WAYS (8UL)
+#define FD_SIGCACHE_KEY_SZ      (32UL)
+
+/* FD_SIGCACHE_TAG_NULL marks an empty slot. */
+
+#define FD_SIGCACHE_TAG_NULL (0UL)
+
+#define FD_SIGCACHE_MAGIC (0xf17eda2c3751ca00UL) /* firedancer sigca ver 0 */
+
+struct __attribute__((aligned(FD_SIGCACHE_ALIGN))) fd_sigcache_private {
+  ulong magic;      /* ==FD_SIGCACHE_MAGIC */
+  ulong depth;      /* The sigcache will maintain a history of the most recent depth keys */
+  ulong bucket_cnt; /* Number of buckets, an integer power of 2 */
+  ulong seed;       /* Seed used to mix keys into tags */
+  ulong oldest;     /* In [0,depth) */
+
+  /* depth ulong (ring):
+
+     Tags of the keys in the sigcache in insertion order, with the same
+     semantics as the fd_tcache_t ring.  The tag of the oldest key is
+     used to find it in the map when it is evicted.  If two keys in the
+     cache share a tag (astronomically rare for a 64-bit tag), one of
+     them might be evicted in place of the other. */
+
+  /* bucket_cnt*FD_SIGCACHE_BUCKET_WAYS ulong (tag), aligned 64:
+
+     Tags of the keys in each slot, FD_SIGCACHE_TAG_NULL if the slot is
+     empty.  For any key in the map at bucket b with home bucket h, all
+     buckets in [h,b) (cyclic) are full. */
+
+  /* bucket_cnt*FD_SIGCACHE_BUCKET_WAYS*FD_SIGCACHE_KEY_SZ uchar (key):
+
+     Keys of each slot.  Undefined if the slot is empty. */
+
+  /* Padding to FD_SIGCACHE_ALIGN */
+};
+
+typedef struct fd_sigcache_private fd_sigcache_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_sigcache_bucket_cnt_default returns the default bucket_cnt to use
+   for the given depth.  The resulting map fill ratio will be at most
+   3/4 and, for non-trivial depths, more than ~3/8.  Returns 0 if depth
+   is invalid or too large. */
+
+FD_FN_CONST ulong
+fd_sigcache_bucket_cnt_default( ulong depth );
+
+/* fd_sigcache_{align,footprint} return the required alignment and
+   footprint of a memory region suitable for use as a sigcache.  For
+   fd_sigcache_footprint, a bucket_cnt of 0 indicates to use
+   fd_sigcache_bucket_cnt_default.  If depth is not positive,
+   bucket_cnt is not a power of 2 with at least depth+2 slots in total
+   and/or the footprint would be larger than ULONG_MAX, returns 0. */
+
+FD_FN_CONST ulong
+fd_sigcache_align( void );
+
+FD_FN_CONST ulong
+fd_sigcache_footprint( ulong depth,
+                       ulong bucket_cnt );
+
+/* fd_sigcache_new formats an unused memory region for use as a
+   sigcache.  depth is the number of unique keys that can be stored
+   and bucket_cnt the number of buckets to use (0 for the default, see
+   above).  seed is an arbitrary value used to mix keys, which should
+   be unpredictable to anybody who controls the keys.  Returns shmem on
+   success and NULL on failure (logs details). */
+
+void *
+fd_sigcache_new( void * shmem,
+                 ulong  depth,
+                 ulong  bucket_cnt,
+                 ulong  seed );
+
+/* fd_sigcache_{join,leave,delete} have the usual semantics (see
+   fd_tcache_{join,leave,delete}). */
+
+fd_sigcache_t *
+fd_sigcache_join( void * _sigcache );
+
+void *
+fd_sigcache_leave( fd_sigcache_t * sigcache );
+
+void *
+fd_sigcache_delete( void * _sigcache );
+
+/* fd_sigcache_{depth,bucket_cnt,seed} return the corresponding
+   properties of a current local join. */
+
+FD_FN_PURE static inline ulong fd_sigcache_depth     ( fd_sigcache_t const * sigcache ) { return sigcache->depth;      }
+FD_FN_PURE static inline ulong fd_sigcache_bucket_cnt( fd_sigcache_t const * sigcache ) { return sigcache->bucket_cnt; }
+FD_FN_PURE static inline ulong fd_sigcache_seed      ( fd_sigcache_t const * sigcache ) { return sigcache->seed;       }
+
+/* fd_sigcache_reset empties the sigcache.  Returns sigcache. */
+
+fd_sigcache_t *
+fd_sigcache_reset( fd_sigcache_t * sigcache );
+
+/* fd_sigcache_query returns 1 if the 32-byte key is in the sigcache
+   and 0 otherwise.  The sigcache is unchanged.  For properly sized
+   sigcaches, this is a fast O(1). */
+
+FD_FN_PURE int
+fd_sigcache_query( fd_sigcache_t const * sigcache,
+                   void const *          key );
+
+/* fd_sigcache_insert inserts the 32-byte key into the sigcache.
+   Returns 1 if key was already in the sigcache (the sigcache is
+   unchanged) and 0 if it was inserted (if depth unique keys had
+   already been inserted, the oldest one was evicted).  For properly
+   sized sigcaches, this is a fast O(1). */
+
+int
+fd_sigcache_insert( fd_sigcache_t * sigcache,
+                    void const *    key );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_tango_tcache_fd_sigcache_h */
@@ -0,0 +1,234 @@
+#include "../fd_tango.h"
+
+#if FD_HAS_HOSTED
+
+FD_STATIC_ASSERT( FD_SIGCACHE_ALIGN==128UL,      unit_test );
+FD_STATIC_ASSERT( FD_SIGCACHE_BUCKET_WAYS==8UL,  unit_test );
+FD_STATIC_ASSERT( FD_SIGCACHE_KEY_SZ==32UL,      unit_test );
+FD_STATIC_ASSERT( FD_SIGCACHE_TAG_NULL==0UL,     unit_test );
+
+#define KEY_SZ FD_SIGCACHE_KEY_SZ
+
+static void
+rand_key( fd_rng_t * rng,
+          uchar *    key ) {
+  for( ulong i=0UL; i<KEY_SZ; i+=8UL ) FD_STORE( ulong, key+i, fd_rng_ulong( rng ) );
+}
+
+/* test_model inserts a mix of unique and duplicate keys into sigcache
+   and checks the results against the key history in ring (depth*KEY_SZ
+   bytes).  Every check_interval inserts, all keys in the history are
+   queried and some evicted ones are checked to be gone. */
+
+static void
+test_model( fd_sigcache_t * sigcache,
+            uchar *         ring,
+            fd_rng_t *      rng,
+            ulong           insert_cnt,
+            uint            dup_thresh,
+            float           dup_avg_age,
+            ulong           check_interval ) {
+  ulong depth  = fd_sigcache_depth( sigcache );
+  ulong oldest = 0UL;
+  ulong cnt    = 0UL; /* Number of keys in the history, in [0,depth] */
+
+  uchar key[ KEY_SZ ];
+  uchar evicted[ KEY_SZ ];
+
+  fd_sigcache_reset( sigcache );
+
+  for( ulong rem=insert_cnt; rem; rem-- ) {
+
+    int is_dup = cnt && (fd_rng_uint( rng ) < dup_thresh);
+    if( is_dup ) {
+      ulong age; do age = (ulong)(uint)(int)(1.0f + dup_avg_age*fd_rng_float_exp( rng )); while( FD_UNLIKELY( age>cnt ) );
+      ulong dup_idx = oldest + depth - age;
+      dup_idx = fd_ulong_if( dup_idx<depth, dup_idx, dup_idx-depth );
+      memcpy( key, ring + dup_idx*KEY_SZ, KEY_SZ );
+    } else if( cnt && (fd_rng_uint( rng ) & 1U) ) {
+      /* Unique key that shares all but the last byte with a recent one
+         (so shares a prefix, but not the tag) */
+      ulong idx = oldest + depth - 1UL;
+      idx = fd_ulong_if( idx<depth, idx, idx-depth );
+      memcpy( key, ring + idx*KEY_SZ, KEY_SZ );
+      key[ KEY_SZ-1UL ] = (uchar)(key[ KEY_SZ-1UL ] ^ (uchar)(1U + (fd_rng_uint( rng ) % 255U)));
+      if( FD_UNLIKELY( fd_sigcache_query( sigcache, key ) ) ) rand_key( rng, key ); /* paranoia */
+    } else {
+      rand_key( rng, key );
+    }
+
+    FD_TEST( fd_sigcache_query( sigcache, key )==is_dup );
+
+    int evict = !is_dup && cnt==depth;
+    if( evict ) memcpy( evicted, ring + oldest*KEY_SZ, KEY_SZ );
+
+    FD_TEST( fd_sigcache_insert( sigcache, key )==is_dup );
+    FD_TEST( fd_sigcache_query ( sigcache, key ) );
+
+    if( !is_dup ) {
+      memcpy( ring + oldest*KEY_SZ, key, KEY_SZ );
+      oldest++; if( oldest==depth ) oldest = 0UL;
+      cnt = fd_ulong_min( cnt+1UL, depth );
+    }
+
+    if( evict ) FD_TEST( !fd_sigcache_query( sigcache, evicted ) );
+
+    if( FD_UNLIKELY( !(rem % check_interval) ) ) {
+      for( ulong i=0UL; i<cnt; i++ ) FD_TEST( fd_sigcache_query( sigcache, ring + i*KEY_SZ ) );
+    }
+  }
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  FD_TEST( fd_sigcache_align()==FD_SIGCACHE_ALIGN );
+  FD_TEST( !fd_sigcache_footprint( 0UL,       0UL ) );
+  FD_TEST( !fd_sigcache_footprint( ULONG_MAX, 0UL ) );
+  FD_TEST( !fd_sigcache_footprint( 1UL, ULONG_MAX ) );
+  FD_TEST(  fd_sigcache_footprint( 6UL,       1UL ) ); /* 8 slots, need 8 */
+  FD_TEST( !fd_sigcache_footprint( 7UL,       1UL ) );
+  FD_TEST(  fd_sigcache_footprint( 7UL,       2UL ) );
+  FD_TEST( !fd_sigcache_footprint( 7UL,       3UL ) );
+  FD_TEST( fd_sigcache_bucket_cnt_default( 0UL )==0UL );
+  FD_TEST( fd_sigcache_bucket_cnt_default( 1UL )==1UL );
+  FD_TEST( fd_sigcache_bucket_cnt_default( 4UL )==1UL );
+  FD_TEST( fd_sigcache_bucket_cnt_default( 5UL )==1UL );
+  FD_TEST( fd_sigcache_bucket_cnt_default( 6UL )==2UL );
+  for( ulong depth=1UL; depth<100000UL; depth+=1UL+(depth>>4) ) {
+    ulong bucket_cnt = fd_sigcache_bucket_cnt_default( depth );
+    ulong slot_cnt   = bucket_cnt*FD_SIGCACHE_BUCKET_WAYS;
+    FD_TEST( fd_ulong_is_pow2( bucket_cnt ) );
+    FD_TEST( slot_cnt>=depth+2UL );
+    FD_TEST( 8UL*depth+64UL>3UL*slot_cnt );           /* fill ratio > ~3/8 */
+    FD_TEST( 4UL*depth<=3UL*slot_cnt );               /* fill ratio <= 3/4 */
+    FD_TEST( fd_sigcache_footprint( depth, 0UL )==fd_sigcache_footprint( depth, bucket_cnt ) );
+  }
+
+  ulong cpu_idx = fd_tile_cpu_id( fd_tile_idx() );
+  if( cpu_idx>fd_shmem_cpu_cnt() ) cpu_idx = 0UL;
+
+  char const * _page_sz    = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",     NULL, "gigantic"                   );
+  ulong        page_cnt    = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",    NULL, 1UL                          );
+  ulong        numa_idx    = fd_env_strip_cmdline_ulong( &argc, &argv, "--numa-idx",    NULL, fd_shmem_numa_idx( cpu_idx ) );
+  ulong        depth       = fd_env_strip_cmdline_ulong( &argc, &argv, "--depth",       NULL, (1UL<<22)-1UL );
+  ulong        bucket_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--bucket-cnt",  NULL, 0UL           ); /* 0 <> use def */
+  float        dup_frac    = fd_env_strip_cmdline_float( &argc, &argv, "--dup-frac",    NULL, 0.5f          );
+  float        dup_avg_age = fd_env_strip_cmdline_float( &argc, &argv, "--dup-avg-age", NULL, 1.f           );
+
+  FD_LOG_NOTICE(( "Creating workspace (--page-cnt %lu, --page-sz %s, --numa-idx %lu)", page_cnt, _page_sz, numa_idx ));
+  fd_wksp_t * wksp =
+    fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  uint dup_thresh = (uint)(0.5f + dup_frac*(float)(1UL<<32));
+
+  /* Small, maximally full sigcaches to exercise probing across buckets
+     and the backward shift on eviction */
+
+  FD_LOG_NOTICE(( "Testing against model" ));
+
+  for( ulong small_depth=1UL; small_depth<=4096UL; small_depth<<=2 ) {
+    ulong small_bucket_cnt = fd_ulong_pow2_up( (small_depth+2UL+FD_SIGCACHE_BUCKET_WAYS-1UL)/FD_SIGCACHE_BUCKET_WAYS );
+    ulong footprint        = fd_sigcache_footprint( small_depth, small_bucket_cnt ); FD_TEST( footprint );
+    void *  mem  = fd_wksp_alloc_laddr( wksp, fd_sigcache_align(), footprint, 1UL ); FD_TEST( mem  );
+    uchar * ring = fd_wksp_alloc_laddr( wksp, 1UL, small_depth*KEY_SZ, 1UL );         FD_TEST( ring );
+    fd_sigcache_t * sigcache = fd_sigcache_join( fd_sigcache_new( mem, small_depth, small_bucket_cnt, fd_rng_ulong( rng ) ) );
+    FD_TEST( sigcache );
+    FD_TEST( fd_sigcache_bucket_cnt( sigcache )==small_bucket_cnt );
+
+    test_model( sigcache, ring, rng, 16UL*small_depth+64UL, dup_thresh, dup_avg_age,     1UL+small_depth/8UL );
+    test_model( sigcache, ring, rng, 16UL*small_depth+64UL, dup_thresh, (float)small_depth, 1UL+small_depth/8UL );
+
+    FD_TEST( fd_sigcache_delete( fd_sigcache_leave( sigcache ) )==mem );
+    FD_TEST( !fd_sigcache_join( mem ) ); /* bad magic */
+    fd_wksp_free_laddr( ring );
+    fd_wksp_free_laddr( mem  );
+  }
+
+  ulong align     = fd_sigcache_align();
+  ulong footprint = fd_sigcache_footprint( depth, bucket_cnt );
+  if( FD_UNLIKELY( !footprint ) ) FD_LOG_ERR(( "bad depth / bucket_cnt" ));
+  FD_LOG_NOTICE(( "Creating sigcache (--depth %lu, --bucket-cnt %lu, align %lu, footprint %lu)", depth, bucket_cnt, align, footprint ));
+  void *          mem       = fd_wksp_alloc_laddr( wksp, align, footprint, 1UL );              FD_TEST( mem       );
+  void *          _sigcache = fd_sigcache_new( mem, depth, bucket_cnt, fd_rng_ulong( rng ) ); FD_TEST( _sigcache );
+  fd_sigcache_t * sigcache  = fd_sigcache_join( _sigcache );                                  FD_TEST( sigcache  );
+
+  if( !bucket_cnt ) {
+    bucket_cnt = fd_sigcache_bucket_cnt_default( depth );
+    FD_LOG_NOTICE(( "default bucket_cnt %lu used", bucket_cnt ));
+  }
+
+  FD_TEST( fd_sigcache_depth     ( sigcache )==depth      );
+  FD_TEST( fd_sigcache_bucket_cnt( sigcache )==bucket_cnt );
+
+  FD_LOG_NOTICE(( "Running (--dup-frac %e, --dup-avg-age %e)", (double)dup_frac, (double)dup_avg_age ));
+
+  uchar * ring = fd_wksp_alloc_laddr( wksp, 1UL, depth*KEY_SZ, 1UL ); FD_TEST( ring );
+  test_model( sigcache, ring, rng, 3UL*depth, dup_thresh, dup_avg_age, depth );
+  fd_wksp_free_laddr( ring );
+
+  FD_LOG_NOTICE(( "Benchmarking" ));
+
+  ulong   bench_cnt = 1UL<<20;
+  uchar * bench_key = (uchar *)fd_wksp_alloc_laddr( wksp, 0UL, bench_cnt*KEY_SZ, 1UL ); FD_TEST( bench_key );
+
+  for( ulong iter=0UL; iter<10UL; iter++ ) {
+
+    /* Make a longish test vector */
+    for( ulong bench_idx=0UL; bench_idx<bench_cnt; bench_idx++ ) {
+      int is_dup = (fd_rng_uint( rng ) < dup_thresh);
+      if( is_dup ) { /* Next key should be a duplicate */
+        ulong age = (ulong)(uint)(int)(1.0f + dup_avg_age*fd_rng_float_exp( rng )); /* note that age is at least 1 */
+        if( FD_UNLIKELY( age>=bench_idx ) ) is_dup = 0; /* Duplicate of a "pre-benchmark" key ... just use random */
+        else memcpy( bench_key + bench_idx*KEY_SZ, bench_key + (bench_idx-age)*KEY_SZ, KEY_SZ );
+      }
+      if( !is_dup ) rand_key( rng, bench_key + bench_idx*KEY_SZ );
+    }
+
+    /* Benchmark it */
+    long tic = fd_log_wallclock();
+    for( ulong bench_idx=0UL; bench_idx<bench_cnt; bench_idx++ ) {
+      int dup = fd_sigcache_insert( sigcache, bench_key + bench_idx*KEY_SZ );
+      (void)dup;
+    }
+    long toc = fd_log_wallclock();
+
+    float avg = ((float)(toc-tic))/((float)bench_cnt);
+    FD_LOG_NOTICE(( "iter %lu: %.3f ns/dedup", iter, (double)avg ));
+  }
+
+  FD_LOG_NOTICE(( "Cleaning up" ));
+
+  fd_wksp_free_laddr( bench_key );
+
+  FD_TEST( fd_sigcache_leave ( sigcache  )==_sigcache );
+  FD_TEST( fd_sigcache_delete( _sigcache )==mem       );
+  fd_wksp_free_laddr( mem );
+  fd_wksp_delete_anonymous( wksp );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#undef KEY_SZ
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
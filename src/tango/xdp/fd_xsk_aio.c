@@ -294,6 +294,41 @@ fd_xsk_aio_tx_complete( fd_xsk_aio_t * xsk_aio ) {
 }
 
 
+ulong
+fd_xsk_aio_tx_frame_sz( fd_xsk_aio_t const * xsk_aio ) {
+  return xsk_aio->frame_sz;
+}
+
+uchar *
+fd_xsk_aio_tx_reserve( fd_xsk_aio_t * xsk_aio ) {
+  /* The reserved frame is the top of the free stack.  It is only popped
+     by fd_xsk_aio_tx_commit, so an abandoned reservation needs no
+     cleanup. */
+  if( FD_UNLIKELY( !xsk_aio->tx_top ) ) {
+    fd_xsk_aio_tx_complete( xsk_aio );
+    if( FD_UNLIKELY( !xsk_aio->tx_top ) ) return NULL;
+  }
+  return (uchar *)xsk_aio->frame_mem + xsk_aio->tx_stack[ xsk_aio->tx_top-1UL ];
+}
+
+int
+fd_xsk_aio_tx_commit( fd_xsk_aio_t * xsk_aio,
+                      ulong          sz,
+                      int            flush ) {
+  if( FD_UNLIKELY( !xsk_aio->tx_top || sz>xsk_aio->frame_sz ) ) return FD_AIO_ERR_INVAL;
+
+  fd_xsk_frame_meta_t meta[1] = {{
+    .off   = xsk_aio->tx_stack[ xsk_aio->tx_top-1UL ],
+    .sz    = (uint)sz,
+    .flags = 0U
+  }};
+  if( FD_UNLIKELY( !fd_xsk_tx_enqueue( xsk_aio->xsk, meta, 1UL, flush ) ) ) return FD_AIO_ERR_AGAIN;
+
+  xsk_aio->tx_top--;
+  return FD_AIO_SUCCESS;
+}
+
+
 /* fd_xsk_aio_send is an aio callback that transmits the given batch of
    packets through the XSK. */
 static int
@@ -94,6 +94,37 @@ fd_xsk_aio_set_rx( fd_xsk_aio_t *   xsk_aio,
 FD_FN_CONST fd_aio_t const *
 fd_xsk_aio_get_tx( fd_xsk_aio_t const * xsk_aio );
 
+/* fd_xsk_aio_tx_{reserve,commit} allow the caller to build a packet
+   directly in a UMEM TX frame, avoiding the copy done by the aio send
+   path.
+
+   fd_xsk_aio_tx_reserve returns a pointer in the caller's address
+   space to a free TX frame of fd_xsk_aio_tx_frame_sz() bytes, or NULL
+   if all TX frames are in flight (after reclaiming completed ones).
+   The frame stays owned by xsk_aio until committed: repeated calls to
+   reserve without an intervening commit return the same frame, so a
+   reservation is simply abandoned by not committing it.  Any other TX
+   operation on xsk_aio (e.g. a send via fd_xsk_aio_get_tx) may reuse
+   the reserved frame and invalidates its contents.
+
+   fd_xsk_aio_tx_commit hands the currently reserved frame holding sz
+   bytes of packet data to the XSK TX ring.  flush has the same meaning
+   as for fd_aio_send.  Returns FD_AIO_SUCCESS on success.  Returns
+   FD_AIO_ERR_INVAL if no frame is reserved or sz exceeds the frame
+   size, and FD_AIO_ERR_AGAIN if the TX ring is full, in which case the
+   frame remains reserved. */
+
+FD_FN_PURE ulong
+fd_xsk_aio_tx_frame_sz( fd_xsk_aio_t const * xsk_aio );
+
+uchar *
+fd_xsk_aio_tx_reserve( fd_xsk_aio_t * xsk_aio );
+
+int
+fd_xsk_aio_tx_commit( fd_xsk_aio_t * xsk_aio,
+                      ulong          sz,
+                      int            flush );
+
 /* fd_xsk_aio_service services aio callbacks for incoming packets and
    handles completions for tx requests. */
 
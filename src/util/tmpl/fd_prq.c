@@ -73,11 +73,18 @@
     //
     // remove_all removes all events from heap.  Fast O(1).  Returns
     // heap.
+    //
+    // reduce replaces the event_t currently at heap[idx] with the
+    // event_t pointed to by event.  Caller promises event is not
+    // strictly after heap[idx] (e.g. the event's timeout was moved
+    // earlier).  This is a key-reduce operation, cheaper than a remove
+    // followed by an insert.  Fast O(lg cnt).  Returns heap.
 
     event_t * eventq_insert    ( event_t * heap, event_t const * event );
     event_t * eventq_remove_min( event_t * heap );
     event_t * eventq_remove    ( event_t * heap, ulong idx );
     event_t * eventq_remove_all( event_t * heap );
+    event_t * eventq_reduce    ( event_t * heap, ulong idx, event_t const * event );
 
     // Note none of this APIs do any input argument checking as they are
     // meant to be used in ultra high performance contexts.  Thus they
@@ -85,6 +92,11 @@
     // here though to trivially wrap this in variants that test user
     // arguments for sanity.
 
+    // Events move around the heap as other events are inserted and
+    // removed.  Users that need to find a specific event on the heap
+    // (e.g. to remove or reduce it) can define PRQ_TMP_IDX_SET (see
+    // below) to be told the new index of an event whenever it moves.
+
     // Really large event_t are not recommended due to excess implied
     // data motion under the hood.  Cases with
     // sizeof(event_t)==alignof(event_t)==32 are particular good
@@ -201,6 +213,16 @@
 #define PRQ_TMP_CMOV(c,x,y) if( (c) ) (x) = (y)
 #endif
 
+/* PRQ_TMP_IDX_SET is called with the PRQ_T in temporaries t whenever
+   it is stored to heap[idx] by an operation.  This allows users to
+   keep track of where each event is located on the heap (e.g. by
+   storing idx in an object referenced by the event) for O(lg cnt)
+   remove and reduce of arbitrary events.  The default is a no-op. */
+
+#ifndef PRQ_TMP_IDX_SET
+#define PRQ_TMP_IDX_SET(t,idx) (void)(idx)
+#endif
+
 /* Implementation *****************************************************/
 
 #define PRQ_(n) FD_EXPAND_THEN_CONCAT3(PRQ_NAME,_,n)
@@ -263,10 +285,12 @@ PRQ_(private_fill_hole_up)( PRQ_T *       heap,     /* Heap, indexed 0:hole+1 */
 #endif
       break;                                                      /*   If the parent at least as old as the event, ... */
     PRQ_TMP_ST( heap + hole, tmp_parent );                        /*   Otherwise, fill the hole with the hole's parent */
+    PRQ_TMP_IDX_SET( tmp_parent, hole );
     hole = parent;                                                /*   and recurse on the created hole at parent */
   }
 
   PRQ_TMP_ST( heap + hole, tmp_event );                           /* ... fill the hole with the event to schedule */
+  PRQ_TMP_IDX_SET( tmp_event, hole );
 }
 
 /* fill_hole_dn fills the hole in heap with the last event on the heap
@@ -342,6 +366,7 @@ PRQ_(private_fill_hole_dn)( PRQ_T * heap,   /* Heap, half cache line aligned for
     ulong use_reinsert = ((ulong)(child>=cnt)) | PRQ_TMP_AFTER( tmp_child, tmp_reinsert );
     PRQ_TMP_CMOV( use_reinsert, tmp_child, tmp_reinsert );
     PRQ_TMP_ST( heap+hole, tmp_child );
+    PRQ_TMP_IDX_SET( tmp_child, hole );
     if( use_reinsert ) break; /* Unclear branch prob */
     hole = child;
   }
@@ -439,12 +464,23 @@ PRQ_(remove_all)( PRQ_T * heap ) {
   return heap;
 }
 
+static inline PRQ_T *
+PRQ_(reduce)( PRQ_T *       heap,
+              ulong         idx,
+              PRQ_T const * event ) {
+  /* event is not after heap[idx], which is not after any of its
+     descendents, so the hole at idx can be filled by bubbling up. */
+  PRQ_(private_fill_hole_up)( heap, idx, event );
+  return heap;
+}
+
 FD_PROTOTYPES_END
 
 #undef PRQ_
 
 /* End implementation *************************************************/
 
+#undef PRQ_TMP_IDX_SET
 #undef PRQ_TMP_CMOV
 #undef PRQ_TMP_AFTER
 #undef PRQ_TMP_TIMEOUT
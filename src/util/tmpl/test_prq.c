@@ -25,6 +25,14 @@ typedef struct event event_t;
 #define PRQ_AFTER(x,y) (((x).timeout*(y).timeout2)<((y).timeout*(x).timeout2))
 #include "fd_prq.c"
 
+/* Track the heap index of each event by id (val[0]) */
+static ulong idxq_pos[ 1024 ];
+
+#define PRQ_NAME idxq
+#define PRQ_T    event_t
+#define PRQ_TMP_IDX_SET(t,idx) (idxq_pos[ (t).val[0] ] = (idx))
+#include "fd_prq.c"
+
 static int
 test_heap( event_t * heap,
            ulong     cnt,
@@ -302,6 +310,59 @@ main( int     argc,
   FD_TEST( implq_leave ( heap     )==sheventq );
   FD_TEST( implq_delete( sheventq )==mem      );
 
+  FD_LOG_NOTICE(( "Testing indexed queue" ));
+  sheventq = idxq_new ( mem, max ); FD_TEST( sheventq==mem );
+  heap     = idxq_join( sheventq ); FD_TEST( heap );
+
+  /* Insert events with ids [0,max) at random times */
+
+  int in_heap[ 1024 ]; /* FIXME: THIS IS 1024 CENTRIC */
+  for( ulong i=0UL; i<max; i++ ) {
+    event_t event[1];
+    event->timeout  = (long)fd_rng_uint_roll( rng, 1U<<20 );
+    event->timeout2 = 1L;
+    event->val[0]   = (long)i;
+    event->val[1]   = 0L;
+    event->val[2]   = 0L;
+    FD_TEST( idxq_insert( heap, event )==heap );
+    in_heap[i] = 1;
+  }
+
+  /* Randomly reduce and remove events found by id */
+
+  ulong cnt = max;
+  for( ulong iter=0UL; iter<4UL*max; iter++ ) {
+    ulong id = (ulong)fd_rng_uint_roll( rng, (uint)max );
+    if( !in_heap[id] ) continue;
+    ulong idx = idxq_pos[id];
+    FD_TEST( idx<cnt && heap[idx].val[0]==(long)id );
+    if( fd_rng_uint_roll( rng, 4U ) ) {
+      event_t event[1] = { heap[idx] };
+      event->timeout -= (long)fd_rng_uint_roll( rng, 1U<<16 );
+      FD_TEST( idxq_reduce( heap, idx, event )==heap );
+    } else {
+      FD_TEST( idxq_remove( heap, idx )==heap );
+      in_heap[id] = 0;
+      cnt--;
+    }
+    FD_TEST( idxq_cnt( heap )==cnt );
+    for( ulong child=1UL; child<cnt; child++ ) FD_TEST( heap[ (child-1UL)>>1 ].timeout<=heap[ child ].timeout );
+    for( ulong j=0UL; j<cnt; j++ ) FD_TEST( idxq_pos[ heap[j].val[0] ]==j );
+  }
+
+  /* Make sure remaining events are retrieved in a valid order */
+
+  last = LONG_MIN;
+  while( idxq_cnt( heap ) ) {
+    FD_TEST( heap->timeout>=last );
+    last = heap->timeout;
+    FD_TEST( idxq_remove_min( heap )==heap );
+    cnt--;
+    for( ulong j=0UL; j<cnt; j++ ) FD_TEST( idxq_pos[ heap[j].val[0] ]==j );
+  }
+  FD_TEST( idxq_leave ( heap     )==sheventq );
+  FD_TEST( idxq_delete( sheventq )==mem      );
+
   fd_rng_delete( fd_rng_leave( rng ) );
 
   FD_LOG_NOTICE(( "pass" ));